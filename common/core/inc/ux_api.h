@@ -25,7 +25,7 @@
 /*  APPLICATION INTERFACE DEFINITION                       RELEASE        */
 /*                                                                        */
 /*    ux_api.h                                            PORTABLE C      */
-/*                                                           6.4.1        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -147,6 +147,33 @@
 /*  02-19-2025     Frédéric Desbiens        Modified comment(s),          */
 /*                                            update version number,      */
 /*                                            resulting in version 6.4.2  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            added TLSF byte pool        */
+/*                                            support, added per device   */
+/*                                            memory arena support,       */
+/*                                            added byte pool mutex,      */
+/*                                            added memory profiler,      */
+/*                                            added memory steady state   */
+/*                                            check,                      */
+/*                                            added data cache            */
+/*                                            maintenance,                */
+/*                                            added descriptor field      */
+/*                                            lists,                      */
+/*                                            added memory fragmentation  */
+/*                                            report,                     */
+/*                                            added trace ring,           */
+/*                                            added binary debug log,     */
+/*                                            added endpoint statistics,  */
+/*                                            added enumeration timeline, */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            added endpoint scan         */
+/*                                            statistics,                 */
+/*                                            added bandwidth map,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -251,6 +278,21 @@ typedef signed char               SCHAR;
 #define UX_DATA_MEMORY_BARRIER
 #endif
 
+/* If the port file did not define the data cache maintenance operations, define
+   them to nothing. With UX_ENABLE_DATA_CACHE_MAINTENANCE the stack cleans a transfer
+   buffer before it is handed to the controller and invalidates it after the controller
+   has written it, so the buffer can be allocated from cached memory. The port defines
+   the line size of the data cache, transfer buffers are aligned on it.  */
+#ifndef UX_DATA_CACHE_CLEAN
+#define UX_DATA_CACHE_CLEAN(address,length)
+#endif
+#ifndef UX_DATA_CACHE_INVALIDATE
+#define UX_DATA_CACHE_INVALIDATE(address,length)
+#endif
+#ifndef UX_DATA_CACHE_LINE_SIZE
+#define UX_DATA_CACHE_LINE_SIZE                             32
+#endif
+
 
 /* This defines the ASSERT and process on ASSERT fail. */
 #ifdef UX_ENABLE_ASSERT
@@ -437,15 +479,53 @@ typedef signed char               SCHAR;
 #define UX_DEBUG_LOG_SIZE                                   (1024 * 32)
 #endif
 
+/* Define the maximum length of location and message strings exported by the log dump.  */
+
+#ifndef UX_DEBUG_LOG_STRING_LENGTH_MAX
+#define UX_DEBUG_LOG_STRING_LENGTH_MAX                      64
+#endif
+
+/* Define the log timestamp, the USBX tick by default.  */
+
+#ifndef UX_DEBUG_LOG_TIMESTAMP_GET
+#define UX_DEBUG_LOG_TIMESTAMP_GET()                        _ux_utility_time_get()
+#define UX_DEBUG_LOG_TIMESTAMP_FREQUENCY                    UX_PERIODIC_RATE
+#endif
+
+/* Define the log dump format. All values are little endian. Records reference location
+   and message strings by index in the string table that follows them.  */
+
+#define UX_DEBUG_LOG_DUMP_MAGIC                             0x4C445855UL
+#define UX_DEBUG_LOG_DUMP_VERSION                           1
+#define UX_DEBUG_LOG_DUMP_HEADER_LENGTH                     32
+#define UX_DEBUG_LOG_DUMP_RECORD_LENGTH                     24
+
+/* Define the log record, written with a single reserve/commit, strings are kept as
+   pointers and formatted off target.  */
+
+typedef struct UX_DEBUG_LOG_RECORD_STRUCT
+{
+
+    volatile ULONG  ux_debug_log_record_sequence;
+    ULONG           ux_debug_log_record_timestamp;
+    UCHAR           *ux_debug_log_record_location;
+    UCHAR           *ux_debug_log_record_message;
+    ULONG           ux_debug_log_record_code;
+    ULONG           ux_debug_log_record_parameter_1;
+    ULONG           ux_debug_log_record_parameter_2;
+} UX_DEBUG_LOG_RECORD;
+
 /* Map the error log macros to internal USBX function.  */
 
 #define UX_DEBUG_LOG(debug_location, debug_message, debug_code, debug_parameter_1, debug_parameter_2)  _ux_utility_debug_log((UCHAR *) debug_location, (UCHAR *) debug_message, (ULONG) debug_code, (ULONG) debug_parameter_1, (ULONG) debug_parameter_2);
 
 VOID _ux_utility_debug_log(UCHAR *debug_location, UCHAR *debug_message, ULONG debug_code, ULONG debug_parameter_1, ULONG debug_parameter_2);
+UINT _ux_utility_debug_log_dump(UCHAR *buffer, ULONG buffer_length, ULONG *actual_length);
 
 /* DEBUG LOG MESSAGES SHOULD BE WRITTEN LIKE THIS IN THE CODE :    */
 /* If error log is enabled, insert this error message into the log buffer.  */
 /* UX_DEBUG_LOG("_ux_host_stack_rh_device_insertion", "Device insertion", port_index, port_index, 0) */
+/* Location and message must be constant strings, they are read when the log is dumped.  */
 
 
 #else
@@ -874,6 +954,307 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #endif
 
 
+/* Define the USBX trace ring. Unlike the event trace above, it does not depend on the RTOS
+   trace buffer and takes no lock: each core writes its own ring of binary entries, an
+   entry index is reserved with an atomic increment (UX_TRACE_RING_INDEX_RESERVE, defined by
+   the port) and the entry is committed by writing its sequence number last. When the ring
+   is full the oldest entries are overwritten. Events are filtered by category at run time
+   before any call is made, so the ring can be left on in production builds. The ring is
+   dumped by ux_trace_ring_dump and decoded by utility/trace_ring/ux_trace_ring_decode.  */
+
+#ifdef UX_ENABLE_TRACE_RING
+
+/* Define the number of rings and how to get the core running, one ring by default.  */
+#ifndef UX_TRACE_RING_CORE_NUM
+#define UX_TRACE_RING_CORE_NUM                                          1
+#endif
+#ifndef UX_TRACE_RING_CORE_GET
+#define UX_TRACE_RING_CORE_GET()                                        0
+#endif
+
+/* Define the timestamp source, a cycle counter can be used by the port. The time tick
+   is used by default.  */
+#ifndef UX_TRACE_RING_TIMESTAMP_GET
+#define UX_TRACE_RING_TIMESTAMP_GET()                                   _ux_utility_time_get()
+#endif
+#ifndef UX_TRACE_RING_TIMESTAMP_FREQUENCY
+#define UX_TRACE_RING_TIMESTAMP_FREQUENCY                               UX_PERIODIC_RATE
+#endif
+
+/* Define the trace ring categories, used as the filter.  */
+#define UX_TRACE_RING_TRANSFER                                          0x01u
+#define UX_TRACE_RING_ENUMERATION                                       0x02u
+#define UX_TRACE_RING_CLASS                                             0x04u
+#define UX_TRACE_RING_ERRORS                                            0x08u
+#define UX_TRACE_RING_ALL                                               0xFFu
+
+/* Define the trace ring events, the category is in the high byte.  */
+#define UX_TRACE_RING_EVENT_CATEGORY(e)                                 (((ULONG)(e) >> 8) & 0xFFu)
+
+#define UX_TRACE_RING_HOST_TRANSFER_SUBMIT                              0x0101  /* device << 8 | endpoint, requested length, 0  */
+#define UX_TRACE_RING_HOST_TRANSFER_COMPLETE                            0x0102  /* device << 8 | endpoint, completion code, actual length  */
+#define UX_TRACE_RING_DEVICE_TRANSFER_SUBMIT                            0x0103  /* endpoint, requested length, host length  */
+#define UX_TRACE_RING_DEVICE_TRANSFER_COMPLETE                          0x0104  /* endpoint, completion code, actual length  */
+
+#define UX_TRACE_RING_HOST_DEVICE_CONNECT                               0x0201  /* parent device, port, speed  */
+#define UX_TRACE_RING_HOST_DEVICE_ADDRESS_SET                           0x0202  /* address, 0, 0  */
+#define UX_TRACE_RING_HOST_DEVICE_DESCRIPTOR_READ                       0x0203  /* device, idVendor, idProduct  */
+#define UX_TRACE_RING_HOST_CONFIGURATION_SET                            0x0204  /* device, bConfigurationValue, 0  */
+#define UX_TRACE_RING_HOST_DEVICE_REMOVE                                0x0205  /* device, port, 0  */
+#define UX_TRACE_RING_DEVICE_ADDRESS_SET                                0x0206  /* address, 0, 0  */
+#define UX_TRACE_RING_DEVICE_CONFIGURATION_SET                          0x0207  /* bConfigurationValue, 0, 0  */
+#define UX_TRACE_RING_DEVICE_DISCONNECT                                 0x0208  /* device state, 0, 0  */
+
+#define UX_TRACE_RING_HOST_CLASS_INSTANCE_CREATE                        0x0401  /* class index, instance, 0  */
+#define UX_TRACE_RING_HOST_CLASS_INSTANCE_DESTROY                       0x0402  /* class index, instance, 0  */
+#define UX_TRACE_RING_DEVICE_CLASS_ACTIVATE                             0x0403  /* interface, bInterfaceClass, status  */
+#define UX_TRACE_RING_DEVICE_CLASS_DEACTIVATE                           0x0404  /* interface, bInterfaceClass, 0  */
+
+#define UX_TRACE_RING_ERROR                                             0x0801  /* system level, system context, error code  */
+
+/* Define the trace ring dump format. All values are little endian. The dump starts with
+   a header, followed by the committed entries of each ring, oldest first.  */
+
+#define UX_TRACE_RING_DUMP_MAGIC                                        0x52545855UL /* "UXTR" */
+#define UX_TRACE_RING_DUMP_VERSION                                      1
+#define UX_TRACE_RING_DUMP_HEADER_LENGTH                                32
+#define UX_TRACE_RING_DUMP_ENTRY_LENGTH                                 24
+
+/* Define the trace ring structures. The sequence of an entry is its index plus one once
+   the entry is written, 0 while it is written. The index of a ring is free running.  */
+
+typedef struct UX_TRACE_RING_ENTRY_STRUCT
+{
+
+    volatile ULONG  ux_trace_ring_entry_sequence;
+    ULONG           ux_trace_ring_entry_timestamp;
+    ULONG           ux_trace_ring_entry_event;
+    ULONG           ux_trace_ring_entry_info_1;
+    ULONG           ux_trace_ring_entry_info_2;
+    ULONG           ux_trace_ring_entry_info_3;
+} UX_TRACE_RING_ENTRY;
+
+typedef struct UX_TRACE_RING_CORE_STRUCT
+{
+
+    UX_TRACE_RING_ENTRY
+                    *ux_trace_ring_core_entries;
+    volatile ULONG  ux_trace_ring_core_index;
+} UX_TRACE_RING_CORE;
+
+typedef struct UX_TRACE_RING_STRUCT
+{
+
+    ULONG           ux_trace_ring_filter;
+
+    /* Number of entries of each ring, a power of 2.  */
+    ULONG           ux_trace_ring_entries;
+    UX_TRACE_RING_CORE
+                    ux_trace_ring_cores[UX_TRACE_RING_CORE_NUM];
+} UX_TRACE_RING;
+
+extern UX_TRACE_RING    _ux_trace_ring;
+
+/* Map the trace ring macro, the filter is checked before the call.  */
+
+#define UX_TRACE_RING_INSERT(e,a,b,c)                       do {                                    \
+        if (_ux_trace_ring.ux_trace_ring_filter & UX_TRACE_RING_EVENT_CATEGORY(e))                 \
+            _ux_trace_ring_insert((ULONG)(e), (ULONG)(a), (ULONG)(b), (ULONG)(c));                  \
+    } while(0);
+
+/* Map the trace ring macro for host transfers, the device address and the endpoint address
+   are in the first information field.  */
+
+#define UX_TRACE_RING_HOST_TRANSFER_INSERT(e,tr,b,c)                                                \
+        UX_TRACE_RING_INSERT(e, (((ULONG)(tr)->ux_transfer_request_endpoint->ux_endpoint_device->ux_device_address << 8) | \
+                             (tr)->ux_transfer_request_endpoint->ux_endpoint_descriptor.bEndpointAddress), b, c)
+
+
+/* Define USBX trace ring prototypes.  */
+
+UINT    _ux_trace_ring_enable(VOID *buffer, ULONG buffer_size, ULONG filter);
+UINT    _ux_trace_ring_filter_set(ULONG filter);
+VOID    _ux_trace_ring_insert(ULONG event_id, ULONG info_1, ULONG info_2, ULONG info_3);
+UINT    _ux_trace_ring_dump(UCHAR *buffer, ULONG buffer_length, ULONG *actual_length);
+
+#define ux_trace_ring_enable                                _ux_trace_ring_enable
+#define ux_trace_ring_filter_set                            _ux_trace_ring_filter_set
+#define ux_trace_ring_dump                                  _ux_trace_ring_dump
+
+#else
+#define UX_TRACE_RING_INSERT(e,a,b,c)
+#define UX_TRACE_RING_HOST_TRANSFER_INSERT(e,tr,b,c)
+#endif
+
+
+/* Define the endpoint statistics. When enabled, each host and device endpoint counts its
+   transfers, bytes, errors by completion code, timeouts and aborts, and keeps a log2
+   histogram of the latency from the submission of a transfer to its completion. The
+   submission costs an increment and a timestamp read, the completion a call. Timeouts
+   are detected by the classes after they abort the transfer, so they are also counted
+   as aborts. The host controller drivers count the scans of the endpoint for completed
+   transfers, the work done on interrupts is the scans compared to the completions.  */
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+
+/* Define the latency timestamp source, a cycle counter can be used by the port. The time
+   tick is used by default.  */
+#ifndef UX_ENDPOINT_STATISTICS_TIMESTAMP_GET
+#define UX_ENDPOINT_STATISTICS_TIMESTAMP_GET()                          _ux_utility_time_get()
+#endif
+#ifndef UX_ENDPOINT_STATISTICS_TIMESTAMP_FREQUENCY
+#define UX_ENDPOINT_STATISTICS_TIMESTAMP_FREQUENCY                      UX_PERIODIC_RATE
+#endif
+
+/* Define the number of error codes and latency bins. Error codes 0x21 to 0x2F are counted
+   at their low nibble, others at 0. A latency of bit length n is counted in bin n, the
+   last bin holds all latencies from 2^14 timestamp units.  */
+#define UX_ENDPOINT_STATISTICS_ERROR_CODES                              16
+#define UX_ENDPOINT_STATISTICS_LATENCY_BINS                             16
+
+typedef struct UX_ENDPOINT_STATISTICS_STRUCT
+{
+
+    ULONG           ux_endpoint_statistics_requests;
+    ULONG           ux_endpoint_statistics_completed;
+    ULONG           ux_endpoint_statistics_bytes;
+    ULONG           ux_endpoint_statistics_errors;
+    ULONG           ux_endpoint_statistics_timeouts;
+    ULONG           ux_endpoint_statistics_aborts;
+    ULONG           ux_endpoint_statistics_scans;
+    ULONG           ux_endpoint_statistics_latency_max;
+    ULONG           ux_endpoint_statistics_error_codes[UX_ENDPOINT_STATISTICS_ERROR_CODES];
+    ULONG           ux_endpoint_statistics_latency[UX_ENDPOINT_STATISTICS_LATENCY_BINS];
+} UX_ENDPOINT_STATISTICS;
+
+/* Map the endpoint statistics macros. The submission is counted in line, the completion
+   is counted by a call.  */
+
+#define UX_TRANSFER_STATISTICS_SUBMIT(tr)       do {                                                \
+        (tr)->ux_transfer_request_endpoint->ux_endpoint_statistics.ux_endpoint_statistics_requests ++; \
+        (tr)->ux_transfer_request_statistics_start =  UX_ENDPOINT_STATISTICS_TIMESTAMP_GET();      \
+    } while(0)
+#define UX_TRANSFER_STATISTICS_COMPLETE(tr)                                                         \
+        _ux_utility_endpoint_statistics_update(&(tr)->ux_transfer_request_endpoint->ux_endpoint_statistics, \
+                                               (tr)->ux_transfer_request_completion_code,           \
+                                               (tr)->ux_transfer_request_actual_length,             \
+                                               (tr)->ux_transfer_request_statistics_start)
+#define UX_TRANSFER_STATISTICS_TIMEOUT(tr)                                                          \
+        (tr)->ux_transfer_request_endpoint->ux_endpoint_statistics.ux_endpoint_statistics_timeouts ++
+#define UX_ENDPOINT_STATISTICS_SCAN(ep)                                                             \
+        (ep)->ux_endpoint_statistics.ux_endpoint_statistics_scans ++
+
+#define UX_SLAVE_TRANSFER_STATISTICS_SUBMIT(tr) do {                                                \
+        (tr)->ux_slave_transfer_request_endpoint->ux_slave_endpoint_statistics.ux_endpoint_statistics_requests ++; \
+        (tr)->ux_slave_transfer_request_statistics_start =  UX_ENDPOINT_STATISTICS_TIMESTAMP_GET(); \
+    } while(0)
+#define UX_SLAVE_TRANSFER_STATISTICS_COMPLETE(tr)                                                   \
+        _ux_utility_endpoint_statistics_update(&(tr)->ux_slave_transfer_request_endpoint->ux_slave_endpoint_statistics, \
+                                               (tr)->ux_slave_transfer_request_completion_code,     \
+                                               (tr)->ux_slave_transfer_request_actual_length,       \
+                                               (tr)->ux_slave_transfer_request_statistics_start)
+
+
+/* Define USBX endpoint statistics prototypes.  */
+
+VOID    _ux_utility_endpoint_statistics_update(UX_ENDPOINT_STATISTICS *statistics, ULONG completion_code,
+                                               ULONG length, ULONG start);
+
+#else
+#define UX_TRANSFER_STATISTICS_SUBMIT(tr)       do { } while(0)
+#define UX_TRANSFER_STATISTICS_COMPLETE(tr)     do { } while(0)
+#define UX_TRANSFER_STATISTICS_TIMEOUT(tr)      do { } while(0)
+#define UX_ENDPOINT_STATISTICS_SCAN(ep)         do { } while(0)
+#define UX_SLAVE_TRANSFER_STATISTICS_SUBMIT(tr) do { } while(0)
+#define UX_SLAVE_TRANSFER_STATISTICS_COMPLETE(tr) do { } while(0)
+#endif
+
+
+/* Define the enumeration timeline. When enabled, the host stack records for each device the
+   time each enumeration phase is reached from the connection, and the number of enumeration
+   attempts. When an attempt fails, the failure is counted at the first phase it did not
+   reach. The timeline is kept in the device and can be read once the device connection is
+   notified.  */
+
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+
+/* Define the timeline timestamp source. The time tick is used by default.  */
+#ifndef UX_ENUMERATION_TIMELINE_TIMESTAMP_GET
+#define UX_ENUMERATION_TIMELINE_TIMESTAMP_GET()                         _ux_utility_time_get()
+#endif
+#ifndef UX_ENUMERATION_TIMELINE_TIMESTAMP_FREQUENCY
+#define UX_ENUMERATION_TIMELINE_TIMESTAMP_FREQUENCY                     UX_PERIODIC_RATE
+#endif
+
+/* Define the enumeration phases, in the order they are reached, and the timeline events.  */
+#define UX_ENUMERATION_PHASE_DEBOUNCE                                   0
+#define UX_ENUMERATION_PHASE_RESET                                      1
+#define UX_ENUMERATION_PHASE_ADDRESS_SET                                2
+#define UX_ENUMERATION_PHASE_DEVICE_DESCRIPTOR                          3
+#define UX_ENUMERATION_PHASE_CONFIGURATION_DESCRIPTOR                   4
+#define UX_ENUMERATION_PHASE_CONFIGURATION_SET                          5
+#define UX_ENUMERATION_PHASE_CLASS_ACTIVATE                             6
+#define UX_ENUMERATION_PHASES                                           7
+
+#define UX_ENUMERATION_EVENT_CONNECT                                    0x100
+#define UX_ENUMERATION_EVENT_ATTEMPT                                    0x101
+
+typedef struct UX_ENUMERATION_TIMELINE_STRUCT
+{
+
+    ULONG           ux_enumeration_timeline_start;
+    ULONG           ux_enumeration_timeline_attempts;
+    ULONG           ux_enumeration_timeline_phases;
+    ULONG           ux_enumeration_timeline_time[UX_ENUMERATION_PHASES];
+    ULONG           ux_enumeration_timeline_failures[UX_ENUMERATION_PHASES];
+} UX_ENUMERATION_TIMELINE;
+
+#define UX_ENUMERATION_TIMELINE_RECORD(timeline, event)                 \
+        _ux_host_stack_enumeration_timeline_record((timeline), (event))
+#else
+#define UX_ENUMERATION_TIMELINE_RECORD(timeline, event) do { } while(0)
+#endif
+
+
+/* Define the bandwidth map. When enabled, the host stack budgets the periodic endpoints for
+   each micro-frame of a 32 frames schedule, and for each frame on the transaction translators
+   of high speed hubs, instead of a single budget for the controller. The controller budget
+   ux_hcd_available_bandwidth is then the budget of each micro-frame (of each frame on a full
+   speed bus). The bandwidth check places the endpoint in the least loaded phase of its
+   interval, the controller links it to the periodic list of that phase and the claim
+   reserves it.  */
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+#if UX_MAX_DEVICES == 1
+#error "UX_ENABLE_BANDWIDTH_MAP requires UX_MAX_DEVICES > 1"
+#endif
+
+#define UX_BANDWIDTH_MAP_FRAMES                                         32u
+#define UX_BANDWIDTH_MAP_MICROFRAMES                                    8u
+#define UX_BANDWIDTH_MAP_SLOTS                                          (UX_BANDWIDTH_MAP_FRAMES * UX_BANDWIDTH_MAP_MICROFRAMES)
+
+/* Define the split transaction budget. The full speed bytes of a frame are budgeted in
+   micro-frames of 188 bytes, the start-split is not issued after Y5.  */
+#define UX_BANDWIDTH_MAP_SPLIT_BYTES                                    188u
+#define UX_BANDWIDTH_MAP_SPLIT_LAST                                     5u
+
+/* Define the endpoint slot: the first micro-frame used in the map, and the claim flag.  */
+#define UX_BANDWIDTH_MAP_SLOT_MASK                                      0xFFu
+#define UX_BANDWIDTH_MAP_CLAIMED                                        0x100u
+#define UX_BANDWIDTH_MAP_FULL                                           0xFFFFFFFFu
+
+#define UX_BANDWIDTH_MAP_CHECK                                          0
+#define UX_BANDWIDTH_MAP_CLAIM                                          1
+#define UX_BANDWIDTH_MAP_RELEASE                                        2
+
+#define UX_BANDWIDTH_MAP_FRAME(endpoint)                                \
+        (((endpoint) -> ux_endpoint_bandwidth_slot & UX_BANDWIDTH_MAP_SLOT_MASK) / UX_BANDWIDTH_MAP_MICROFRAMES)
+#define UX_BANDWIDTH_MAP_MICROFRAME(endpoint)                           \
+        ((endpoint) -> ux_endpoint_bandwidth_slot % UX_BANDWIDTH_MAP_MICROFRAMES)
+#endif
+
+
 /* Define the system level for error trapping. */
 #define UX_SYSTEM_LEVEL_INTERRUPT                                       1
 #define UX_SYSTEM_LEVEL_THREAD                                          2
@@ -1175,6 +1556,7 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #ifndef UX_ALIGN_MIN
 #define UX_ALIGN_MIN                                                    UX_ALIGN_8
 #endif
+#define UX_CACHE_LINE_ALIGN                                             ((ULONG)UX_DATA_CACHE_LINE_SIZE - 1u)
 
 #define UX_MAX_USB_DEVICES                                              127
 
@@ -1485,6 +1867,7 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #define UX_MEMORY_ARRAY_FULL                                            0x1a
 #define UX_FATAL_ERROR                                                  0x1b
 #define UX_ALREADY_ACTIVATED                                            0x1c
+#define UX_MEMORY_STEADY_STATE_ALLOCATION                               0x1d
 
 #define UX_TRANSFER_STALLED                                             0x21
 #define UX_TRANSFER_NO_ANSWER                                           0x22
@@ -1730,6 +2113,9 @@ typedef struct UX_HUB_TT_STRUCT
 
     ULONG           ux_hub_tt_port_mapping;
     ULONG           ux_hub_tt_max_bandwidth;
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+    USHORT          ux_hub_tt_frame_load[UX_BANDWIDTH_MAP_FRAMES];
+#endif
 } UX_HUB_TT;
 
 
@@ -1783,6 +2169,17 @@ typedef struct UX_HOST_CLASS_STRUCT
 
 /* Define USBX transfer request structure.  */
 
+/* Define USBX transfer segment structure. A scatter-gather transfer request describes its
+   data as an array of segments, sent or received back to back.  */
+
+typedef struct UX_TRANSFER_SEGMENT_STRUCT
+{
+
+    UCHAR *         ux_transfer_segment_data_pointer;
+    ULONG           ux_transfer_segment_length;
+} UX_TRANSFER_SEGMENT;
+
+
 typedef struct UX_TRANSFER_STRUCT
 {
 
@@ -1815,6 +2212,14 @@ typedef struct UX_TRANSFER_STRUCT
     struct UX_TRANSFER_STRUCT
                     *ux_transfer_request_next_pending;
 #endif
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+    ULONG           ux_transfer_request_statistics_start;
+#endif
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+    UX_TRANSFER_SEGMENT
+                    *ux_transfer_request_segments;
+    ULONG           ux_transfer_request_segment_count;
+#endif
 } UX_TRANSFER;
 
 #if defined(UX_HOST_STANDALONE)
@@ -1829,6 +2234,75 @@ typedef struct UX_TRANSFER_STRUCT
 #define UX_TRANSFER_FLAG_AUTO_DEVICE_UNLOCK     (0x1u << 2) /* In wait case, unlock device after transfer done.  */
 #endif
 
+/* Define host transfer buffer cache maintenance. The buffer is cleaned before the transfer
+   is handed to the controller and invalidated by the controller driver once the data of
+   an IN transfer is written. For control transfers the direction is the one of the request.  */
+#if defined(UX_ENABLE_DATA_CACHE_MAINTENANCE)
+#define UX_TRANSFER_DATA_CACHE_IS_IN(tr)                                                            \
+    ((((tr)->ux_transfer_request_endpoint->ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_CONTROL_ENDPOINT) ? \
+     (((tr)->ux_transfer_request_type & UX_REQUEST_DIRECTION) == UX_REQUEST_IN) :                   \
+     (((tr)->ux_transfer_request_endpoint->ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) == UX_ENDPOINT_IN))
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+#define UX_TRANSFER_DATA_CACHE_SEGMENTS(tr, op, length) do {                                        \
+        ULONG _seg_index;                                                                           \
+        ULONG _seg_left = (length);                                                                 \
+        ULONG _seg_length;                                                                          \
+        for (_seg_index = 0; (_seg_index < (tr)->ux_transfer_request_segment_count) && (_seg_left != 0); _seg_index++) \
+        {                                                                                           \
+            _seg_length = UX_MIN(_seg_left, (tr)->ux_transfer_request_segments[_seg_index].ux_transfer_segment_length); \
+            op((tr)->ux_transfer_request_segments[_seg_index].ux_transfer_segment_data_pointer, _seg_length); \
+            _seg_left -= _seg_length;                                                               \
+        }                                                                                           \
+    } while(0)
+#define UX_TRANSFER_DATA_CACHE_IS_SEGMENTED(tr) ((tr)->ux_transfer_request_segment_count != 0)
+#else
+#define UX_TRANSFER_DATA_CACHE_SEGMENTS(tr, op, length) do { } while(0)
+#define UX_TRANSFER_DATA_CACHE_IS_SEGMENTED(tr) (0)
+#endif
+#define UX_TRANSFER_DATA_CACHE_CLEAN(tr)        do {                                                \
+        if (UX_TRANSFER_DATA_CACHE_IS_SEGMENTED(tr))                                                \
+            UX_TRANSFER_DATA_CACHE_SEGMENTS(tr, UX_DATA_CACHE_CLEAN,                                \
+                                            (tr)->ux_transfer_request_requested_length);            \
+        else if ((tr)->ux_transfer_request_requested_length != 0)                                   \
+            UX_DATA_CACHE_CLEAN((tr)->ux_transfer_request_data_pointer,                             \
+                                (tr)->ux_transfer_request_requested_length);                        \
+    } while(0)
+#define UX_TRANSFER_DATA_CACHE_INVALIDATE(tr)   do {                                                \
+        if (((tr)->ux_transfer_request_actual_length != 0) && UX_TRANSFER_DATA_CACHE_IS_IN(tr))     \
+        {                                                                                           \
+            if (UX_TRANSFER_DATA_CACHE_IS_SEGMENTED(tr))                                            \
+                UX_TRANSFER_DATA_CACHE_SEGMENTS(tr, UX_DATA_CACHE_INVALIDATE,                       \
+                                                (tr)->ux_transfer_request_actual_length);           \
+            else                                                                                    \
+                UX_DATA_CACHE_INVALIDATE((tr)->ux_transfer_request_data_pointer,                    \
+                                         (tr)->ux_transfer_request_actual_length);                  \
+        }                                                                                           \
+    } while(0)
+#else
+#define UX_TRANSFER_DATA_CACHE_CLEAN(tr)        do { } while(0)
+#define UX_TRANSFER_DATA_CACHE_INVALIDATE(tr)   do { } while(0)
+#endif
+
+/* Define host endpoint transfer queue. Bulk and interrupt transfer requests submitted while
+   the endpoint is busy wait in the endpoint queue, linked by their next transfer request.
+   The first one is with the controller, when it completes the controller driver starts the
+   next one before notifying the class, so the endpoint stays armed.  */
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+#define UX_TRANSFER_QUEUE_NEXT(tr)              _ux_host_stack_transfer_queue_next(tr)
+VOID    _ux_host_stack_transfer_queue_next(UX_TRANSFER *transfer_request);
+#else
+#define UX_TRANSFER_QUEUE_NEXT(tr)              do { } while(0)
+#endif
+
+/* Define host transfer scatter-gather. With segments, the data of a bulk transfer request
+   is described by its segment array instead of its data pointer. Classes reusing a transfer
+   request for a contiguous buffer reset the segments first.  */
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+#define UX_TRANSFER_SEGMENTS_RESET(tr)          ((tr)->ux_transfer_request_segment_count = 0)
+#else
+#define UX_TRANSFER_SEGMENTS_RESET(tr)          do { } while(0)
+#endif
+
 
 /* Define USBX Endpoint Descriptor structure.  */
 
@@ -1847,6 +2321,16 @@ typedef struct UX_ENDPOINT_DESCRIPTOR_STRUCT
 #define UX_ENDPOINT_DESCRIPTOR_ENTRIES                                  6
 #define UX_ENDPOINT_DESCRIPTOR_LENGTH                                   7
 
+/* Define USBX Endpoint Descriptor fields as (name, size, offset in raw descriptor).  */
+
+#define UX_ENDPOINT_DESCRIPTOR_FIELDS(F)                                    \
+    F(bLength, 1, 0)                                                        \
+    F(bDescriptorType, 1, 1)                                                \
+    F(bEndpointAddress, 1, 2)                                               \
+    F(bmAttributes, 1, 3)                                                   \
+    F(wMaxPacketSize, 2, 4)                                                 \
+    F(bInterval, 1, 6)
+
 
 /* Define USBX Endpoint Container structure.  */
 
@@ -1866,6 +2350,19 @@ typedef struct UX_ENDPOINT_STRUCT
                     *ux_endpoint_device;
     struct UX_TRANSFER_STRUCT
                     ux_endpoint_transfer_request;
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+    UX_ENDPOINT_STATISTICS
+                    ux_endpoint_statistics;
+#endif
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+    struct UX_TRANSFER_STRUCT
+                    *ux_endpoint_transfer_queue_head;
+    struct UX_TRANSFER_STRUCT
+                    *ux_endpoint_transfer_queue_tail;
+#endif
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+    ULONG           ux_endpoint_bandwidth_slot;
+#endif
 } UX_ENDPOINT;
 
 
@@ -1894,6 +2391,24 @@ typedef struct UX_DEVICE_DESCRIPTOR_STRUCT
 #define UX_DEVICE_DESCRIPTOR_ENTRIES                                    14
 #define UX_DEVICE_DESCRIPTOR_LENGTH                                     18
 
+/* Define USBX Device Descriptor fields as (name, size, offset in raw descriptor).  */
+
+#define UX_DEVICE_DESCRIPTOR_FIELDS(F)                                      \
+    F(bLength, 1, 0)                                                        \
+    F(bDescriptorType, 1, 1)                                                \
+    F(bcdUSB, 2, 2)                                                         \
+    F(bDeviceClass, 1, 4)                                                   \
+    F(bDeviceSubClass, 1, 5)                                                \
+    F(bDeviceProtocol, 1, 6)                                                \
+    F(bMaxPacketSize0, 1, 7)                                                \
+    F(idVendor, 2, 8)                                                       \
+    F(idProduct, 2, 10)                                                     \
+    F(bcdDevice, 2, 12)                                                     \
+    F(iManufacturer, 1, 14)                                                 \
+    F(iProduct, 1, 15)                                                      \
+    F(iSerialNumber, 1, 16)                                                 \
+    F(bNumConfigurations, 1, 17)
+
 
 /* Define USBX Device Qualifier Descriptor structure.  */
 
@@ -1970,6 +2485,18 @@ typedef struct UX_INTERFACE_ASSOCIATION_DESCRIPTOR_STRUCT
 #define UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES         8
 #define UX_INTERFACE_ASSOCIATION_DESCRIPTOR_LENGTH          8
 
+/* Define USBX Interface Association Descriptor fields as (name, size, offset in raw descriptor).  */
+
+#define UX_INTERFACE_ASSOCIATION_DESCRIPTOR_FIELDS(F)                       \
+    F(bLength, 1, 0)                                                        \
+    F(bDescriptorType, 1, 1)                                                \
+    F(bFirstInterface, 1, 2)                                                \
+    F(bInterfaceCount, 1, 3)                                                \
+    F(bFunctionClass, 1, 4)                                                 \
+    F(bFunctionSubClass, 1, 5)                                              \
+    F(bFunctionProtocol, 1, 6)                                              \
+    F(iFunction, 1, 7)
+
 
 /* Define USBX Device Container structure.  */
 
@@ -2010,6 +2537,10 @@ typedef struct UX_DEVICE_STRUCT
     struct UX_HUB_TT_STRUCT
                     ux_device_hub_tt[UX_MAX_TT];
 #endif
+#if defined(UX_ENABLE_MEMORY_ARENA) && !defined(UX_HOST_STANDALONE)
+    struct UX_MEMORY_ARENA_STRUCT
+                    *ux_device_memory_arena;
+#endif
 
 #if defined(UX_HOST_STANDALONE)
     ULONG           ux_device_flags;
@@ -2041,6 +2572,11 @@ typedef struct UX_DEVICE_STRUCT
     ULONG           ux_device_dbg_state_count;
 #endif
 
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+    UX_ENUMERATION_TIMELINE
+                    ux_device_enumeration_timeline;
+#endif
+
 } UX_DEVICE;
 
 #if defined(UX_HOST_STANDALONE)
@@ -2102,6 +2638,18 @@ typedef struct UX_CONFIGURATION_DESCRIPTOR_STRUCT
 #define UX_CONFIGURATION_DESCRIPTOR_ENTRIES                             8
 #define UX_CONFIGURATION_DESCRIPTOR_LENGTH                              9
 
+/* Define USBX Configuration Descriptor fields as (name, size, offset in raw descriptor).  */
+
+#define UX_CONFIGURATION_DESCRIPTOR_FIELDS(F)                               \
+    F(bLength, 1, 0)                                                        \
+    F(bDescriptorType, 1, 1)                                                \
+    F(wTotalLength, 2, 2)                                                   \
+    F(bNumInterfaces, 1, 4)                                                 \
+    F(bConfigurationValue, 1, 5)                                            \
+    F(iConfiguration, 1, 6)                                                 \
+    F(bmAttributes, 1, 7)                                                   \
+    F(MaxPower, 1, 8)
+
 
 /* Define USBX Configuration Container structure.  */
 
@@ -2151,6 +2699,19 @@ typedef struct UX_INTERFACE_DESCRIPTOR_STRUCT
 #define UX_INTERFACE_DESCRIPTOR_ENTRIES                                 9
 #define UX_INTERFACE_DESCRIPTOR_LENGTH                                  9
 
+/* Define USBX Interface Descriptor fields as (name, size, offset in raw descriptor).  */
+
+#define UX_INTERFACE_DESCRIPTOR_FIELDS(F)                                   \
+    F(bLength, 1, 0)                                                        \
+    F(bDescriptorType, 1, 1)                                                \
+    F(bInterfaceNumber, 1, 2)                                               \
+    F(bAlternateSetting, 1, 3)                                              \
+    F(bNumEndpoints, 1, 4)                                                  \
+    F(bInterfaceClass, 1, 5)                                                \
+    F(bInterfaceSubClass, 1, 6)                                             \
+    F(bInterfaceProtocol, 1, 7)                                             \
+    F(iInterface, 1, 8)
+
 
 /* Define USBX Interface Container structure.  */
 
@@ -2288,6 +2849,9 @@ typedef struct UX_HCD_STRUCT
     UINT            ux_hcd_power_switch;
     ULONG           ux_hcd_available_bandwidth;
     ULONG           ux_hcd_version;
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+    USHORT          ux_hcd_bandwidth_map[UX_BANDWIDTH_MAP_SLOTS];
+#endif
 #endif
 
 #if defined(UX_HOST_STANDALONE)
@@ -2323,12 +2887,35 @@ typedef struct UX_SLAVE_TRANSFER_STRUCT
     ULONG           ux_slave_transfer_request_force_zlp;
     UCHAR           ux_slave_transfer_request_setup[UX_SETUP_SIZE];
     ULONG           ux_slave_transfer_request_status_phase_ignore;
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+    ULONG           ux_slave_transfer_request_statistics_start;
+#endif
 } UX_SLAVE_TRANSFER;
 
 #if defined(UX_DEVICE_STANDALONE)
 #define UX_SLAVE_TRANSFER_STATE_RESET(tr) ((tr)->ux_slave_transfer_request_state = UX_STATE_RESET)
 #endif
 
+/* Define device transfer buffer cache maintenance. The buffer is cleaned before the transfer
+   is handed to the controller and invalidated once the data received from the host
+   (DATA IN phase) is written.  */
+#if defined(UX_ENABLE_DATA_CACHE_MAINTENANCE)
+#define UX_SLAVE_TRANSFER_DATA_CACHE_CLEAN(tr)        do {                                          \
+        if ((tr)->ux_slave_transfer_request_requested_length != 0)                                  \
+            UX_DATA_CACHE_CLEAN((tr)->ux_slave_transfer_request_data_pointer,                       \
+                                (tr)->ux_slave_transfer_request_requested_length);                  \
+    } while(0)
+#define UX_SLAVE_TRANSFER_DATA_CACHE_INVALIDATE(tr)   do {                                          \
+        if (((tr)->ux_slave_transfer_request_actual_length != 0) &&                                 \
+            ((tr)->ux_slave_transfer_request_phase == UX_TRANSFER_PHASE_DATA_IN))                   \
+            UX_DATA_CACHE_INVALIDATE((tr)->ux_slave_transfer_request_data_pointer,                  \
+                                     (tr)->ux_slave_transfer_request_actual_length);                \
+    } while(0)
+#else
+#define UX_SLAVE_TRANSFER_DATA_CACHE_CLEAN(tr)        do { } while(0)
+#define UX_SLAVE_TRANSFER_DATA_CACHE_INVALIDATE(tr)   do { } while(0)
+#endif
+
 
 /* Define USBX Device Controller Endpoint structure.  */
 
@@ -2348,6 +2935,10 @@ typedef struct UX_SLAVE_ENDPOINT_STRUCT
                     *ux_slave_endpoint_device;
     struct UX_SLAVE_TRANSFER_STRUCT
                     ux_slave_endpoint_transfer_request;
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+    UX_ENDPOINT_STATISTICS
+                    ux_slave_endpoint_statistics;
+#endif
 } UX_SLAVE_ENDPOINT;
 
 
@@ -2486,7 +3077,13 @@ typedef struct UX_SLAVE_CLASS_STRUCT
 #define UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(a)       ((ALIGN_TYPE *) ((VOID *) (a)))
 #endif
 #define UX_UCHAR_TO_INDIRECT_BYTE_POOL_POINTER(a)       ((UX_MEMORY_BYTE_POOL **) ((VOID *) (a)))
-#define UX_MEMORY_BLOCK_HEADER_SIZE                     (sizeof(UCHAR *) + sizeof(ALIGN_TYPE))
+
+/* A third pointer in block header links to the previous physical block, so that
+   adjacent free blocks are merged on free without walking the pool. The header size
+   is rounded up to the minimum alignment, so that the buffer after an aligned block
+   is aligned too.  */
+#define UX_MEMORY_BLOCK_HEADER_SIZE                     ((sizeof(UCHAR *) + sizeof(ALIGN_TYPE) + sizeof(UCHAR *) + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN))
+#define UX_MEMORY_BLOCK_PREVIOUS(b)                     (*UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT((b) + sizeof(UCHAR *) + sizeof(ALIGN_TYPE)))
 
 #ifndef UX_BYTE_BLOCK_FREE
 #define UX_BYTE_BLOCK_FREE                              ((ULONG) 0xFFFFEEEEUL)
@@ -2496,7 +3093,119 @@ typedef struct UX_SLAVE_CLASS_STRUCT
 #define UX_BYTE_BLOCK_MIN                               ((ULONG) 20)
 #endif
 
-/* Define USBX Memory Management structure.  */
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+/* Define USBX Memory Slab constants. Objects of class N have payload size of
+   (UX_MEMORY_SLAB_SIZE_MIN << N).  */
+
+#ifndef UX_MEMORY_SLAB_CLASS_NUM
+#define UX_MEMORY_SLAB_CLASS_NUM                        7
+#endif
+
+#ifndef UX_MEMORY_SLAB_SIZE_MIN
+#define UX_MEMORY_SLAB_SIZE_MIN                         32
+#endif
+
+#ifndef UX_MEMORY_SLAB_PAGE_SIZE
+#define UX_MEMORY_SLAB_PAGE_SIZE                        4096
+#endif
+
+#ifndef UX_MEMORY_SLAB_EMPTY_PAGES_MAX
+#define UX_MEMORY_SLAB_EMPTY_PAGES_MAX                  1
+#endif
+
+#ifndef UX_BYTE_BLOCK_SLAB
+#define UX_BYTE_BLOCK_SLAB                              ((ULONG) 0xFFFFEEEDUL)
+#endif
+
+#define UX_MEMORY_SLAB_PAGE_HEADER_SIZE                 ((sizeof(UX_MEMORY_SLAB_PAGE) + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN))
+
+/* Define USBX Memory Slab structures. A slab page is a block of the byte pool
+   split in objects of the same size. Each object has a block header, in which
+   the first pointer links to the owner page (next free object if it's free),
+   and the second field is UX_BYTE_BLOCK_SLAB (UX_BYTE_BLOCK_FREE if free).  */
+
+typedef struct UX_MEMORY_SLAB_PAGE_STRUCT
+{
+
+    struct UX_MEMORY_SLAB_PAGE_STRUCT
+                    *ux_memory_slab_page_next;
+    struct UX_MEMORY_SLAB_PAGE_STRUCT
+                    *ux_memory_slab_page_previous;
+    struct UX_MEMORY_SLAB_STRUCT
+                    *ux_memory_slab_page_slab;
+    UCHAR           *ux_memory_slab_page_free;
+    ULONG           ux_memory_slab_page_used;
+} UX_MEMORY_SLAB_PAGE;
+
+typedef struct UX_MEMORY_SLAB_STRUCT
+{
+
+    /* Pages that have free objects, empty pages are kept there too.  */
+    UX_MEMORY_SLAB_PAGE
+                    *ux_memory_slab_pages;
+    struct UX_MEMORY_BYTE_POOL_STRUCT
+                    *ux_memory_slab_pool;
+    ULONG           ux_memory_slab_object_size;
+    ULONG           ux_memory_slab_page_objects;
+    ULONG           ux_memory_slab_pages_empty;
+} UX_MEMORY_SLAB;
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+/* Define USBX Memory TLSF (Two-Level Segregated Fit) constants. Free blocks are
+   kept in lists indexed by the power of 2 range of their size (first level),
+   each range being split in (1 << UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2) sub ranges
+   (second level). Blocks of (1 << UX_MEMORY_TLSF_FL_INDEX_MAX) bytes and larger
+   are all kept in the last list.  */
+
+#ifndef UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2
+#define UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2              4
+#endif
+
+#ifndef UX_MEMORY_TLSF_FL_INDEX_MAX
+#define UX_MEMORY_TLSF_FL_INDEX_MAX                     24
+#endif
+
+#if UX_ALIGN_MIN >= 0x3F
+#define UX_MEMORY_TLSF_ALIGN_SIZE_LOG2                  6
+#elif UX_ALIGN_MIN >= 0x1F
+#define UX_MEMORY_TLSF_ALIGN_SIZE_LOG2                  5
+#elif UX_ALIGN_MIN >= 0x0F
+#define UX_MEMORY_TLSF_ALIGN_SIZE_LOG2                  4
+#else
+#define UX_MEMORY_TLSF_ALIGN_SIZE_LOG2                  3
+#endif
+
+#define UX_MEMORY_TLSF_SL_INDEX_COUNT                   (1u << UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2)
+#define UX_MEMORY_TLSF_FL_INDEX_SHIFT                   (UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2 + UX_MEMORY_TLSF_ALIGN_SIZE_LOG2)
+#define UX_MEMORY_TLSF_FL_INDEX_COUNT                   (UX_MEMORY_TLSF_FL_INDEX_MAX - UX_MEMORY_TLSF_FL_INDEX_SHIFT + 1)
+#define UX_MEMORY_TLSF_SMALL_BLOCK_SIZE                 (1u << UX_MEMORY_TLSF_FL_INDEX_SHIFT)
+
+/* Free blocks keep next/previous free block pointers after block header.  */
+#define UX_MEMORY_TLSF_BLOCK_SIZE_MIN                   ((UX_MEMORY_BLOCK_HEADER_SIZE + sizeof(UCHAR *) * 2 + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN))
+
+#define UX_MEMORY_TLSF_BLOCK_NEXT(b)                    (*UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(b))
+#define UX_MEMORY_TLSF_BLOCK_OWNER(b)                   (*UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT((b) + sizeof(UCHAR *)))
+#define UX_MEMORY_TLSF_BLOCK_PREVIOUS(b)                UX_MEMORY_BLOCK_PREVIOUS(b)
+#define UX_MEMORY_TLSF_BLOCK_FREE_NEXT(b)               (*UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT((b) + UX_MEMORY_BLOCK_HEADER_SIZE))
+#define UX_MEMORY_TLSF_BLOCK_FREE_PREVIOUS(b)           (*UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT((b) + UX_MEMORY_BLOCK_HEADER_SIZE + sizeof(UCHAR *)))
+
+#if (UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2 > 5) || (UX_MEMORY_TLSF_FL_INDEX_MAX > 31) || (UX_MEMORY_TLSF_FL_INDEX_COUNT < 1)
+#error "UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2 or UX_MEMORY_TLSF_FL_INDEX_MAX out of range"
+#endif
+#endif
+
+/* Define USBX Memory Management structure. Each pool is protected by its own
+   mutex, which also protects the slabs and arenas taken from the pool and the
+   selection of the arena. Locks are taken in the following order, a thread holding
+   a lock may only take the ones after it:
+     1. ux_system_mutex,
+     2. HCD descriptor pool mutex (e.g. ux_hcd_sim_host_td_mutex),
+     3. byte pool mutex (regular pool first, then cache safe pool).
+   _ux_utility_memory_allocate and _ux_utility_memory_free must not be called
+   with a byte pool mutex held.  */
 
 typedef struct UX_MEMORY_BYTE_POOL_STRUCT
 {
@@ -2516,6 +3225,13 @@ typedef struct UX_MEMORY_BYTE_POOL_STRUCT
     /* Save the byte pool's size in bytes.  */
     ULONG           ux_byte_pool_size;
 
+#if !defined(UX_STANDALONE)
+
+    /* Define the pool protection and the number of times a thread had to wait for it.  */
+    UX_MUTEX        ux_byte_pool_mutex;
+    ULONG           ux_byte_pool_mutex_contentions;
+#endif
+
 #ifdef UX_ENABLE_MEMORY_STATISTICS
     ALIGN_TYPE      ux_byte_pool_min_free;
     ULONG           ux_byte_pool_alloc_count;
@@ -2523,15 +3239,228 @@ typedef struct UX_MEMORY_BYTE_POOL_STRUCT
     ULONG           ux_byte_pool_alloc_max_count;
     ULONG           ux_byte_pool_alloc_max_total;
 #endif
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+    UX_MEMORY_SLAB  ux_byte_pool_slab[UX_MEMORY_SLAB_CLASS_NUM];
+#endif
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+    struct UX_MEMORY_PROFILER_STRUCT
+                    *ux_byte_pool_profiler;
+#endif
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+    ULONG           ux_byte_pool_tlsf_fl_bitmap;
+    ULONG           ux_byte_pool_tlsf_sl_bitmap[UX_MEMORY_TLSF_FL_INDEX_COUNT];
+    UCHAR           *ux_byte_pool_tlsf_blocks[UX_MEMORY_TLSF_FL_INDEX_COUNT][UX_MEMORY_TLSF_SL_INDEX_COUNT];
+#endif
 } UX_MEMORY_BYTE_POOL;
 
 #define UX_MEMORY_BYTE_POOL_REGULAR 0
 #define UX_MEMORY_BYTE_POOL_CACHE_SAFE 1
 #define UX_MEMORY_BYTE_POOL_NUM 2
 
+/* Define USBX Memory Fragmentation report of a byte pool. Free blocks are counted by
+   payload size in histogram bins, bin N holds blocks smaller than
+   (UX_MEMORY_FRAGMENTATION_BIN_SIZE_MIN << N) bytes that are not in bin N-1, the last
+   bin holds all the larger blocks. Fragmentation is the percentage of free bytes that
+   are not in the largest free block.  */
+
+#ifndef UX_MEMORY_FRAGMENTATION_BIN_NUM
+#define UX_MEMORY_FRAGMENTATION_BIN_NUM                 12
+#endif
+
+#ifndef UX_MEMORY_FRAGMENTATION_BIN_SIZE_MIN
+#define UX_MEMORY_FRAGMENTATION_BIN_SIZE_MIN            32
+#endif
+
+typedef struct UX_MEMORY_FRAGMENTATION_STRUCT
+{
+
+    ULONG           ux_memory_fragmentation_available;
+    ULONG           ux_memory_fragmentation_largest;
+    ULONG           ux_memory_fragmentation_free_blocks;
+    ULONG           ux_memory_fragmentation_blocks;
+    ULONG           ux_memory_fragmentation_percent;
+    ULONG           ux_memory_fragmentation_histogram[UX_MEMORY_FRAGMENTATION_BIN_NUM];
+} UX_MEMORY_FRAGMENTATION;
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+
+/* Define USBX Memory Arena constants.  */
+
+#ifndef UX_MEMORY_ARENA_CHUNK_SIZE
+#define UX_MEMORY_ARENA_CHUNK_SIZE                      2048
+#endif
+
+#ifndef UX_BYTE_BLOCK_ARENA
+#define UX_BYTE_BLOCK_ARENA                             ((ULONG) 0xFFFFEEECUL)
+#endif
+
+#define UX_MEMORY_ARENA_CHUNK_HEADER_SIZE               ((sizeof(UX_MEMORY_ARENA_CHUNK) + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN))
+#define UX_MEMORY_ARENA_HEADER_SIZE                     ((sizeof(UX_MEMORY_ARENA) + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN))
+
+/* Define USBX Memory Arena structures. An arena is a list of chunks carved from
+   a byte pool, objects are allocated by moving the top of the current chunk.
+   Each object has a block header, in which the first pointer links to the end
+   of the object and the second field is UX_BYTE_BLOCK_ARENA (UX_BYTE_BLOCK_FREE
+   if freed), the arena pointer is kept just before the header. Freed objects
+   are not reused, all chunks are returned to the pool when the arena is deleted
+   and all its objects are freed. The arena control block is in the first chunk.  */
+
+typedef struct UX_MEMORY_ARENA_CHUNK_STRUCT
+{
+
+    struct UX_MEMORY_ARENA_CHUNK_STRUCT
+                    *ux_memory_arena_chunk_next;
+    UCHAR           *ux_memory_arena_chunk_top;
+    UCHAR           *ux_memory_arena_chunk_end;
+} UX_MEMORY_ARENA_CHUNK;
+
+typedef struct UX_MEMORY_ARENA_STRUCT
+{
+
+    UX_MEMORY_BYTE_POOL
+                    *ux_memory_arena_pool;
+
+    /* Chunks, the first one is the one objects are allocated from.  */
+    UX_MEMORY_ARENA_CHUNK
+                    *ux_memory_arena_chunks;
+    ULONG           ux_memory_arena_objects;
+    ULONG           ux_memory_arena_deleted;
+#if !defined(UX_STANDALONE)
+
+    /* Only allocations of the thread that selected the arena are taken from it.  */
+    UX_THREAD       *ux_memory_arena_thread;
+#endif
+} UX_MEMORY_ARENA;
+#endif
+
+/* Define the caller address of _ux_utility_memory_allocate, saved by the memory
+   profiler and reported by the steady state check. Can be defined in port for
+   other compilers.  */
+#if defined(UX_ENABLE_MEMORY_PROFILER) || defined(UX_ENABLE_MEMORY_STEADY_STATE_CHECK)
+#ifndef UX_MEMORY_CALLER
+#if defined(__GNUC__)
+#define UX_MEMORY_CALLER()                              ((ALIGN_TYPE)__builtin_return_address(0))
+#else
+#define UX_MEMORY_CALLER()                              ((ALIGN_TYPE)0)
+#endif
+#endif
+#endif
+
+/* Define USBX memory steady state owners. The host stack is in steady state once a
+   device is enumerated and its classes are activated, the device stack once a
+   configuration is set. No allocation is expected while any owner is in steady state.  */
+
+#define UX_MEMORY_STEADY_STATE_HOST                     1u
+#define UX_MEMORY_STEADY_STATE_DEVICE                   2u
+#define UX_MEMORY_STEADY_STATE_APPLICATION              4u
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+
+/* Define USBX Memory Profiler constants.  */
+
+#ifndef UX_MEMORY_PROFILER_BLOCK_NUM
+#define UX_MEMORY_PROFILER_BLOCK_NUM                    256
+#endif
+
+#ifndef UX_MEMORY_PROFILER_TAG_NUM
+#define UX_MEMORY_PROFILER_TAG_NUM                      32
+#endif
+
+#define UX_MEMORY_PROFILER_TAG_NAME_LENGTH              32
+
+/* Define USBX Memory Profiler snapshot format. All values are little endian.
+   The snapshot starts with a header, followed by each pool: a pool header, its
+   tag records, then its live block records.  */
+
+#define UX_MEMORY_PROFILER_SNAPSHOT_MAGIC               0x504D5855UL /* "UXMP" */
+#define UX_MEMORY_PROFILER_SNAPSHOT_VERSION             1
+#define UX_MEMORY_PROFILER_SNAPSHOT_HEADER_LENGTH       8
+#define UX_MEMORY_PROFILER_SNAPSHOT_POOL_LENGTH         32
+#define UX_MEMORY_PROFILER_SNAPSHOT_TAG_LENGTH          (UX_MEMORY_PROFILER_TAG_NAME_LENGTH + 20)
+#define UX_MEMORY_PROFILER_SNAPSHOT_BLOCK_LENGTH        32
+
+/* Define USBX Memory Profiler structures. The profiler of each pool records the
+   live blocks of the pool with their size, caller address and tag. The tag is the
+   owner (class or stack name and device address) set by the thread that allocates
+   the block. For each tag, live blocks and bytes, peak bytes and number of
+   allocations are kept. Tag 0 is for blocks allocated with no owner, or when the
+   tag table is full. The profiler is protected by the pool mutex.  */
+
+typedef struct UX_MEMORY_PROFILER_OWNER_STRUCT
+{
+
+    const UCHAR     *ux_memory_profiler_owner_name;
+
+    /* Device address on host side, interface number on device side.  */
+    ULONG           ux_memory_profiler_owner_address;
+#if !defined(UX_STANDALONE)
+
+    /* Only allocations of the thread that set the owner are tagged.  */
+    UX_THREAD       *ux_memory_profiler_owner_thread;
+#endif
+} UX_MEMORY_PROFILER_OWNER;
+
+typedef struct UX_MEMORY_PROFILER_TAG_STRUCT
+{
+
+    const UCHAR     *ux_memory_profiler_tag_name;
+    ULONG           ux_memory_profiler_tag_address;
+    ULONG           ux_memory_profiler_tag_blocks;
+    ULONG           ux_memory_profiler_tag_bytes;
+    ULONG           ux_memory_profiler_tag_max_bytes;
+    ULONG           ux_memory_profiler_tag_alloc_count;
+} UX_MEMORY_PROFILER_TAG;
+
+typedef struct UX_MEMORY_PROFILER_BLOCK_STRUCT
+{
+
+    /* UX_NULL if the entry is not used.  */
+    VOID            *ux_memory_profiler_block_memory;
+    ALIGN_TYPE      ux_memory_profiler_block_caller;
+    ULONG           ux_memory_profiler_block_size_requested;
+    ULONG           ux_memory_profiler_block_size;
+    ULONG           ux_memory_profiler_block_tag;
+} UX_MEMORY_PROFILER_BLOCK;
+
+typedef struct UX_MEMORY_PROFILER_STRUCT
+{
+
+    ULONG           ux_memory_profiler_tags_count;
+    ULONG           ux_memory_profiler_blocks_count;
+
+    /* Blocks not recorded because the block table is full.  */
+    ULONG           ux_memory_profiler_blocks_lost;
+
+    /* Bytes of recorded live blocks, with headers.  */
+    ULONG           ux_memory_profiler_bytes;
+    ULONG           ux_memory_profiler_max_bytes;
+    UX_MEMORY_PROFILER_TAG
+                    ux_memory_profiler_tags[UX_MEMORY_PROFILER_TAG_NUM];
+    UX_MEMORY_PROFILER_BLOCK
+                    ux_memory_profiler_blocks[UX_MEMORY_PROFILER_BLOCK_NUM];
+} UX_MEMORY_PROFILER;
+#endif
+
 typedef struct UX_SYSTEM_STRUCT
 {
     UX_MEMORY_BYTE_POOL *ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_NUM];
+#ifdef UX_ENABLE_MEMORY_ARENA
+    UX_MEMORY_ARENA *ux_system_memory_arena;
+#endif
+#ifdef UX_ENABLE_MEMORY_PROFILER
+    UX_MEMORY_PROFILER_OWNER
+                    ux_system_memory_profiler_owner;
+#endif
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+    ULONG           ux_system_memory_steady_state;
+    ULONG           ux_system_memory_steady_state_allocations;
+    ALIGN_TYPE      ux_system_memory_steady_state_caller;
+    ULONG           ux_system_memory_steady_state_holds;
+    ULONG           ux_system_memory_steady_state_pending;
+#endif
 
     UINT            ux_system_thread_lowest_priority;
 #if !defined(UX_STANDALONE)
@@ -2546,10 +3475,10 @@ typedef struct UX_SYSTEM_STRUCT
 
 #ifdef UX_ENABLE_DEBUG_LOG
     ULONG           ux_system_debug_code;
-    ULONG           ux_system_debug_count;
-    UCHAR           *ux_system_debug_log_buffer;
-    UCHAR           *ux_system_debug_log_head;
-    UCHAR           *ux_system_debug_log_tail;
+    volatile ULONG  ux_system_debug_count;
+    UX_DEBUG_LOG_RECORD
+                    *ux_system_debug_log_buffer;
+    ULONG           ux_system_debug_log_records;
     ULONG           ux_system_debug_log_size;
     VOID            (*ux_system_debug_callback_function) (UCHAR *debug_message, ULONG debug_value);
 #endif
@@ -2587,6 +3516,11 @@ typedef struct UX_SYSTEM_HOST_STRUCT
     UX_SEMAPHORE    ux_system_host_enum_semaphore;
 #endif
 
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE) && !defined(UX_HOST_STANDALONE)
+    UX_ENUMERATION_TIMELINE
+                    ux_system_host_enumeration_timeline;
+#endif
+
 #if UX_MAX_DEVICES > 1
     VOID            (*ux_system_host_enum_hub_function) (VOID);
 #endif
@@ -2811,6 +3745,27 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_host_stack_tasks_run                                 _ux_host_stack_tasks_run
 #define ux_host_stack_transfer_run                              _ux_host_stack_transfer_run
 
+#define ux_host_stack_endpoint_statistics_get                   _ux_host_stack_endpoint_statistics_get
+#define ux_host_stack_endpoint_statistics_reset                 _ux_host_stack_endpoint_statistics_reset
+#define ux_host_stack_endpoint_statistics_walk                  _ux_host_stack_endpoint_statistics_walk
+#define ux_host_stack_device_enumeration_timeline_get           _ux_host_stack_device_enumeration_timeline_get
+#define ux_host_stack_bandwidth_map_get                         _ux_host_stack_bandwidth_map_get
+#define ux_host_stack_bandwidth_tt_map_get                      _ux_host_stack_bandwidth_tt_map_get
+
+#define ux_utility_debug_log_dump                               _ux_utility_debug_log_dump
+
+#define ux_utility_memory_fragmentation_get                     _ux_utility_memory_fragmentation_get
+#define ux_utility_memory_slab_trim                             _ux_utility_memory_slab_trim
+
+#define ux_utility_memory_profiler_owner_set                    _ux_utility_memory_profiler_owner_set
+#define ux_utility_memory_profiler_owner_restore                _ux_utility_memory_profiler_owner_restore
+#define ux_utility_memory_profiler_snapshot                     _ux_utility_memory_profiler_snapshot
+
+#define ux_utility_memory_steady_state_enter                    _ux_utility_memory_steady_state_enter
+#define ux_utility_memory_steady_state_exit                     _ux_utility_memory_steady_state_exit
+#define ux_utility_memory_steady_state_hold                     _ux_utility_memory_steady_state_hold
+#define ux_utility_memory_steady_state_release                  _ux_utility_memory_steady_state_release
+
 #define ux_utility_pci_class_scan                               _ux_utility_pci_class_scan
 #define ux_utility_pci_read                                     _ux_utility_pci_read
 #define ux_utility_pci_write                                    _ux_utility_pci_write
@@ -2850,6 +3805,10 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_device_stack_tasks_run                               _ux_device_stack_tasks_run
 #define ux_device_stack_transfer_run                            _ux_device_stack_transfer_run
 
+#define ux_device_stack_endpoint_statistics_get                 _ux_device_stack_endpoint_statistics_get
+#define ux_device_stack_endpoint_statistics_reset               _ux_device_stack_endpoint_statistics_reset
+#define ux_device_stack_endpoint_statistics_walk                _ux_device_stack_endpoint_statistics_walk
+
 #define ux_hcd_ehci_initialize                                  _ux_hcd_ehci_initialize
 #define ux_hcd_isp1161_initialize                               _ux_hcd_isp1161_initialize
 #define ux_hcd_ohci_initialize                                  _ux_hcd_ohci_initialize
@@ -24,7 +24,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_device_stack.h                                   PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added endpoint statistics,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -111,6 +114,13 @@ UINT    _ux_device_stack_uninitialize(VOID);
 UINT    _ux_device_stack_tasks_run(VOID);
 UINT    _ux_device_stack_transfer_run(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length);
 
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+UINT    _ux_device_stack_endpoint_statistics_get(UX_SLAVE_ENDPOINT *endpoint, UX_ENDPOINT_STATISTICS *statistics);
+UINT    _ux_device_stack_endpoint_statistics_reset(UX_SLAVE_ENDPOINT *endpoint);
+UINT    _ux_device_stack_endpoint_statistics_walk(UINT (*walk_function)(UX_SLAVE_ENDPOINT *endpoint, VOID *parameter),
+                                                  VOID *parameter);
+#endif
+
 UINT    _uxe_device_stack_class_register(UCHAR *class_name,
                                     UINT (*class_entry_function)(struct UX_SLAVE_CLASS_COMMAND_STRUCT *),
                                     ULONG configuration_number,
@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_hcd_sim_host.h                                   PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,12 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added TD list mutex,        */
+/*                                            added setup buffer in ED,   */
+/*                                            added event driven mode,    */
+/*                                            added bus timing model,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -87,6 +93,81 @@ extern   "C" {
 #define UX_HCD_SIM_HOST_AVAILABLE_BANDWIDTH                     6000
 
 
+/* Define simulator host event driven scheduling. When enabled, the simulator
+   is kicked as soon as a transfer is queued on either side instead of waiting
+   for the timer tick, the frame number is virtual and advances only when
+   periodic endpoints are served.  */
+
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+#define UX_HCD_SIM_HOST_SCHEDULE_SIGNAL(hcd)                    _ux_hcd_sim_host_schedule_signal(hcd)
+#else
+#define UX_HCD_SIM_HOST_SCHEDULE_SIGNAL(hcd)
+#endif
+
+
+/* Define simulator host bus timing model. When enabled, transactions consume
+   bus time in the frame (full/low speed) or microframe (high speed), the
+   scheduling stops when the frame budget is used and resumes on next frame.
+   Times are in nanoseconds, bit times in picoseconds and overheads in bytes.  */
+
+#define UX_HCD_SIM_HOST_TIMING_FS_FRAME_PERIOD                  1000000
+#define UX_HCD_SIM_HOST_TIMING_HS_FRAME_PERIOD                  125000
+#define UX_HCD_SIM_HOST_TIMING_LS_BIT_TIME                      666667
+#define UX_HCD_SIM_HOST_TIMING_FS_BIT_TIME                      83333
+#define UX_HCD_SIM_HOST_TIMING_HS_BIT_TIME                      2083
+#define UX_HCD_SIM_HOST_TIMING_FS_PERIODIC_LIMIT                90
+#define UX_HCD_SIM_HOST_TIMING_HS_PERIODIC_LIMIT                80
+#define UX_HCD_SIM_HOST_TIMING_FS_TRANSACTION_OVERHEAD          13
+#define UX_HCD_SIM_HOST_TIMING_HS_TRANSACTION_OVERHEAD          55
+#define UX_HCD_SIM_HOST_TIMING_FS_HANDSHAKE_OVERHEAD            10
+#define UX_HCD_SIM_HOST_TIMING_HS_HANDSHAKE_OVERHEAD            38
+#define UX_HCD_SIM_HOST_TIMING_NAK_RETRIES                      1
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+#define UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, length)        \
+            _ux_hcd_sim_host_timing_transaction(hcd_sim_host, ed, length)
+#define UX_HCD_SIM_HOST_TIMING_NAK(hcd_sim_host, ed)                        \
+            _ux_hcd_sim_host_timing_nak(hcd_sim_host, ed)
+#define UX_HCD_SIM_HOST_TIMING_BUDGET_GET(hcd_sim_host, periodic)           \
+            _ux_hcd_sim_host_timing_budget_get(hcd_sim_host, periodic)
+#else
+#define UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, length)
+#define UX_HCD_SIM_HOST_TIMING_NAK(hcd_sim_host, ed)
+#define UX_HCD_SIM_HOST_TIMING_BUDGET_GET(hcd_sim_host, periodic)   (0xFFFFFFFFu)
+#endif
+
+
+/* Define simulator host bus timing model parameters.  */
+
+typedef struct UX_HCD_SIM_HOST_TIMING_STRUCT
+{
+
+    ULONG           ux_hcd_sim_host_timing_frame_period;
+    ULONG           ux_hcd_sim_host_timing_bit_time;
+    ULONG           ux_hcd_sim_host_timing_periodic_limit;
+    ULONG           ux_hcd_sim_host_timing_transaction_overhead;
+    ULONG           ux_hcd_sim_host_timing_handshake_overhead;
+    ULONG           ux_hcd_sim_host_timing_nak_retries;
+    ULONG           ux_hcd_sim_host_timing_device_latency;
+} UX_HCD_SIM_HOST_TIMING;
+
+
+/* Define simulator host bus timing model statistics. The bus time elapsed is
+   frames * frame period + frame time.  */
+
+typedef struct UX_HCD_SIM_HOST_TIMING_STATISTICS_STRUCT
+{
+
+    ULONG           ux_hcd_sim_host_timing_frames;
+    ULONG           ux_hcd_sim_host_timing_frame_time;
+    ULONG           ux_hcd_sim_host_timing_bytes;
+    ULONG           ux_hcd_sim_host_timing_transactions;
+    ULONG           ux_hcd_sim_host_timing_naks;
+    ULONG           ux_hcd_sim_host_timing_deferred;
+    ULONG           ux_hcd_sim_host_timing_periodic_time_max;
+} UX_HCD_SIM_HOST_TIMING_STATISTICS;
+
+
 
 /* Define simulator host completion code errors.  */
 
@@ -136,6 +217,21 @@ typedef struct UX_HCD_SIM_HOST_STRUCT
     ULONG           ux_hcd_sim_host_interrupt_count;
 #if !defined(UX_HOST_STANDALONE)
     UX_TIMER        ux_hcd_sim_host_timer;
+    UX_MUTEX        ux_hcd_sim_host_td_mutex;
+    ULONG           ux_hcd_sim_host_td_mutex_contentions;
+#endif
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+    ULONG           ux_hcd_sim_host_frame_number;
+#endif
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+    UX_HCD_SIM_HOST_TIMING
+                    ux_hcd_sim_host_timing;
+    UX_HCD_SIM_HOST_TIMING_STATISTICS
+                    ux_hcd_sim_host_timing_statistics;
+    ULONG           ux_hcd_sim_host_timing_frame_number;
+    ULONG           ux_hcd_sim_host_timing_frame_start;
+    ULONG           ux_hcd_sim_host_timing_periodic_time;
+    UINT            ux_hcd_sim_host_timing_waiting;
 #endif
 } UX_HCD_SIM_HOST;
 
@@ -158,6 +254,12 @@ typedef struct UX_HCD_SIM_HOST_ED_STRUCT
                     *ux_sim_host_ed_endpoint;
     ULONG           ux_sim_host_ed_toggle;   
     ULONG           ux_sim_host_ed_frame;    
+    UCHAR           ux_sim_host_ed_setup[UX_SETUP_SIZE];
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+    ULONG           ux_sim_host_ed_timing_ready_time;
+    ULONG           ux_sim_host_ed_timing_nak_frame;
+    UINT            ux_sim_host_ed_timing_armed;
+#endif
 } UX_HCD_SIM_HOST_ED;
 
 
@@ -257,7 +359,16 @@ UINT    _ux_hcd_sim_host_request_control_transfer(UX_HCD_SIM_HOST *hcd_sim_host,
 UINT    _ux_hcd_sim_host_request_interrupt_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_sim_host_request_isochronous_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_sim_host_request_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request);
+VOID    _ux_hcd_sim_host_schedule_signal(UX_HCD *hcd);
 VOID    _ux_hcd_sim_host_timer_function(ULONG hcd_sim_host_addr);
+ULONG   _ux_hcd_sim_host_timing_budget_get(UX_HCD_SIM_HOST *hcd_sim_host, UINT periodic);
+UINT    _ux_hcd_sim_host_timing_device_ready(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed);
+VOID    _ux_hcd_sim_host_timing_frame_update(UX_HCD_SIM_HOST *hcd_sim_host);
+VOID    _ux_hcd_sim_host_timing_model_default_get(ULONG speed, UX_HCD_SIM_HOST_TIMING *timing);
+UINT    _ux_hcd_sim_host_timing_model_set(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_TIMING *timing);
+VOID    _ux_hcd_sim_host_timing_nak(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed);
+UINT    _ux_hcd_sim_host_timing_statistics_get(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_TIMING_STATISTICS *statistics);
+VOID    _ux_hcd_sim_host_timing_transaction(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed, ULONG length);
 UINT    _ux_hcd_sim_host_transaction_schedule(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed);
 UINT    _ux_hcd_sim_host_transfer_abort(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_sim_host_port_reset(UX_HCD_SIM_HOST *hcd_sim_host, ULONG port_index);
@@ -267,6 +378,9 @@ UINT    _ux_hcd_sim_host_transfer_run(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER
 /* Define Device Simulator Class API prototypes.  */
 
 #define ux_hcd_sim_host_initialize                 _ux_hcd_sim_host_initialize
+#define ux_hcd_sim_host_timing_model_default_get   _ux_hcd_sim_host_timing_model_default_get
+#define ux_hcd_sim_host_timing_model_set           _ux_hcd_sim_host_timing_model_set
+#define ux_hcd_sim_host_timing_statistics_get      _ux_hcd_sim_host_timing_statistics_get
 /* Determine if a C++ compiler is being used.  If so, complete the standard 
    C conditional started above.  */   
 #ifdef __cplusplus
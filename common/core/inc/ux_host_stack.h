@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_stack.h                                     PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,15 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added endpoint statistics,  */
+/*                                            added enumeration timeline, */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            added bandwidth map,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -203,6 +212,35 @@ VOID    _ux_host_stack_hnp_polling_thread_entry(ULONG id);
 UINT    _ux_host_stack_tasks_run(VOID);
 UINT    _ux_host_stack_transfer_run(UX_TRANSFER *transfer_request);
 
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+UINT    _ux_host_stack_transfer_queue_add(UX_TRANSFER *transfer_request);
+UINT    _ux_host_stack_transfer_queue_remove(UX_TRANSFER *transfer_request);
+#endif
+
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+UINT    _ux_host_stack_transfer_segments_check(UX_TRANSFER *transfer_request);
+#endif
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+UINT    _ux_host_stack_endpoint_statistics_get(UX_ENDPOINT *endpoint, UX_ENDPOINT_STATISTICS *statistics);
+UINT    _ux_host_stack_endpoint_statistics_reset(UX_ENDPOINT *endpoint);
+UINT    _ux_host_stack_endpoint_statistics_walk(UINT (*walk_function)(UX_DEVICE *device, UX_ENDPOINT *endpoint, VOID *parameter),
+                                                VOID *parameter);
+#endif
+
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+UINT    _ux_host_stack_device_enumeration_timeline_get(UX_DEVICE *device, UX_ENUMERATION_TIMELINE *timeline);
+VOID    _ux_host_stack_enumeration_timeline_record(UX_ENUMERATION_TIMELINE *timeline, UINT event);
+#endif
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+UX_HUB_TT *_ux_host_stack_bandwidth_map_cost_get(UX_HCD *hcd, UX_ENDPOINT *endpoint, ULONG *hcd_cost, ULONG *tt_cost, ULONG *period);
+UINT    _ux_host_stack_bandwidth_map_get(UX_HCD *hcd, USHORT *map);
+ULONG   _ux_host_stack_bandwidth_map_search(UX_HCD *hcd, UX_ENDPOINT *endpoint);
+ULONG   _ux_host_stack_bandwidth_map_update(UX_HCD *hcd, UX_ENDPOINT *endpoint, ULONG slot, UINT operation);
+UINT    _ux_host_stack_bandwidth_tt_map_get(UX_DEVICE *hub_device, UINT tt_index, USHORT *map);
+#endif
+
 
 UINT    _uxe_host_stack_class_get(UCHAR *class_name, UX_HOST_CLASS **ux_class);
 UINT    _uxe_host_stack_class_instance_get(UX_HOST_CLASS *class, UINT class_index, VOID **class_instance);
@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_system.h                                         PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added host stack name for   */
+/*                                            memory profiler,            */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -125,6 +129,9 @@ extern UCHAR _ux_system_host_class_gser_name[];
 extern UCHAR _ux_system_host_class_hid_client_remote_control_name[];
 extern UCHAR _ux_system_host_class_hid_client_mouse_name[]; 
 extern UCHAR _ux_system_host_class_hid_client_keyboard_name[]; 
+#ifdef UX_ENABLE_MEMORY_PROFILER
+extern UCHAR _ux_system_host_stack_name[];
+#endif
 
 extern UCHAR _ux_system_host_hcd_ohci_name[]; 
 extern UCHAR _ux_system_host_hcd_ehci_name[]; 
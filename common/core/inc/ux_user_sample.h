@@ -25,7 +25,7 @@
 /*  PORT SPECIFIC C INFORMATION                            RELEASE        */ 
 /*                                                                        */ 
 /*    ux_user.h                                           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*                                                                        */
 /*  AUTHOR                                                                */
 /*                                                                        */
@@ -107,6 +107,32 @@
 /*                                            added option for get string */
 /*                                            requests with zero wIndex,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory slab options,  */
+/*                                            added TLSF byte pool        */
+/*                                            options, added memory arena */
+/*                                            options,                    */
+/*                                            added data cache            */
+/*                                            maintenance option,         */
+/*                                            added descriptor unpack     */
+/*                                            option,                     */
+/*                                            added endpoint statistics   */
+/*                                            option,                     */
+/*                                            added enumeration timeline  */
+/*                                            option,                     */
+/*                                            added simulator event       */
+/*                                            driven option,              */
+/*                                            added simulator direct      */
+/*                                            transfer option,            */
+/*                                            added simulator bus timing option,*/
+/*                                            added endpoint transfer     */
+/*                                            queue option,               */
+/*                                            added transfer scatter-gather*/
+/*                                            option,                     */
+/*                                            added endpoint scan         */
+/*                                            statistics,                 */
+/*                                            added bandwidth map option, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -371,6 +397,200 @@
 
 /* #define UX_ENFORCE_SAFE_ALIGNMENT   */
 
+/* Defined, this value enables size class slabs in front of the memory byte pools.
+   Small allocations with no special alignment are taken from pages carved from the
+   byte pool and shared by objects of the same size class, which reduces search time
+   and fragmentation. Empty pages are returned to the byte pool, except the first
+   UX_MEMORY_SLAB_EMPTY_PAGES_MAX ones of each size class (default 1), which are kept so
+   that an allocate/free cycle does not carve and release a page each time. Kept pages
+   are released by ux_utility_memory_slab_trim, or when the byte pool is exhausted.
+   The size classes are (UX_MEMORY_SLAB_SIZE_MIN << N), N from 0 to UX_MEMORY_SLAB_CLASS_NUM - 1,
+   the defaults are 32 and 7 (32 to 2048 bytes). UX_MEMORY_SLAB_PAGE_SIZE defines the page
+   size in bytes, the default is 4096.
+*/
+
+/* #define UX_ENABLE_MEMORY_SLAB   */
+/* #define UX_MEMORY_SLAB_SIZE_MIN                             32   */
+/* #define UX_MEMORY_SLAB_CLASS_NUM                            7    */
+/* #define UX_MEMORY_SLAB_PAGE_SIZE                            4096 */
+/* #define UX_MEMORY_SLAB_EMPTY_PAGES_MAX                      1    */
+
+/* Defined, this value selects the TLSF (two-level segregated fit) engine for the memory
+   byte pools instead of the first-fit search. Free blocks are kept in size class lists
+   indexed by two bitmaps, so allocation and free take bounded time whatever the pool
+   fragmentation is, and adjacent free blocks are merged on free.
+   UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2 defines the number of second level lists (log2) per
+   power of two, the default is 4 (16 lists). UX_MEMORY_TLSF_FL_INDEX_MAX defines the log2
+   of the largest block size, the default is 24 (16MB), larger requests fail.
+   Note each block header takes one more pointer when this engine is selected.
+*/
+
+/* #define UX_ENABLE_MEMORY_TLSF   */
+/* #define UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2                  4    */
+/* #define UX_MEMORY_TLSF_FL_INDEX_MAX                         24   */
+
+/* Defined, this value enables per device memory arenas in host stack. An arena is opened
+   when a new device is created, the allocations done for the device enumeration and class
+   activation are taken from it. Objects freed are not reused, the whole arena is returned
+   to the regular memory pool at once when the device is removed, so connecting and
+   disconnecting devices does not fragment the pool. UX_MEMORY_ARENA_CHUNK_SIZE defines the
+   size in bytes of each piece of memory the arena takes from the pool, the default is 2048.
+   Not used in host standalone mode.
+*/
+
+/* #define UX_ENABLE_MEMORY_ARENA   */
+/* #define UX_MEMORY_ARENA_CHUNK_SIZE                          2048 */
+
+/* Defined, this value enables the memory profiler. Each live block of the memory pools is
+   recorded with its size, the address of the caller of _ux_utility_memory_allocate and a tag.
+   The tag is the owner set by the stack around class and device activation (class or stack
+   name and device address or interface number), so the memory used by each class instance
+   and its peak are known. ux_utility_memory_profiler_snapshot copies the profiler in a
+   buffer which can be decoded by utility/memory_profiler/ux_memory_profiler_dump.c.
+   UX_MEMORY_PROFILER_BLOCK_NUM is the number of live blocks recorded per pool, the default
+   is 256. UX_MEMORY_PROFILER_TAG_NUM is the number of tags per pool, the default is 32.
+*/
+
+/* #define UX_ENABLE_MEMORY_PROFILER   */
+/* #define UX_MEMORY_PROFILER_BLOCK_NUM                        256 */
+/* #define UX_MEMORY_PROFILER_TAG_NUM                          32 */
+
+/* Defined, this value enables the memory steady state check. Once the device is configured
+   or the host has enumerated a device, the stack is in steady state and its data path is not
+   expected to allocate memory. An allocation done in steady state is still served, but it's
+   counted, its caller address is kept in _ux_system and UX_MEMORY_STEADY_STATE_ALLOCATION is
+   reported to the error callback. The application can mark its own steady state with
+   ux_utility_memory_steady_state_enter/exit and UX_MEMORY_STEADY_STATE_APPLICATION.
+   Classes that still allocate after activation (e.g. storage media mount, CDC-ECM buffers)
+   take ux_utility_memory_steady_state_hold and release it once done, steady state is entered
+   on the last release.
+*/
+
+/* #define UX_ENABLE_MEMORY_STEADY_STATE_CHECK   */
+
+/* Defined, this enables data cache maintenance on transfer buffers, so they can be allocated
+   from cached regular memory instead of cache safe memory. Transfer buffers are cleaned before
+   they are handed to the controller and invalidated after the controller has written them,
+   with UX_DATA_CACHE_CLEAN and UX_DATA_CACHE_INVALIDATE defined by the port. Stack buffers are
+   then aligned and padded to UX_DATA_CACHE_LINE_SIZE, buffers passed by the application must
+   be too.
+*/
+
+/* #define UX_ENABLE_DATA_CACHE_MAINTENANCE   */
+
+/* Defined, this disables the specialized unpackers of standard USB descriptors (device,
+   configuration, interface, interface association and endpoint), they are then unpacked by
+   the generic descriptor structure interpreter _ux_utility_descriptor_parse to save code size.
+*/
+
+/* #define UX_DISABLE_DESCRIPTOR_UNPACK   */
+
+/* Defined, this enables the trace ring: a lock-free binary ring of USB events (transfers,
+   enumeration, class activation and errors) recorded per core with a timestamp. The ring is
+   attached with ux_trace_ring_enable, filtered by category with ux_trace_ring_filter_set and
+   exported with ux_trace_ring_dump, the dump is decoded by utility/trace_ring.
+   UX_TRACE_RING_CORE_NUM and UX_TRACE_RING_CORE_GET select the ring of the running core,
+   UX_TRACE_RING_TIMESTAMP_GET and UX_TRACE_RING_TIMESTAMP_FREQUENCY define a cycle counter
+   as timestamp and UX_TRACE_RING_INDEX_RESERVE(index_ptr) an atomic fetch and increment,
+   the defaults are single core, the USBX tick and an interrupt lock.  */
+
+/* #define UX_ENABLE_TRACE_RING   */
+
+/* Defined, this enables the endpoint statistics: each host and device endpoint counts its
+   transfers, bytes, errors by completion code, timeouts and aborts, with a log2 histogram
+   of the latency from submission to completion, and the scans of the endpoint by the
+   host controller driver for completed transfers. They are read and cleared with
+   ux_host_stack_endpoint_statistics_get/reset and ux_device_stack_endpoint_statistics_get/reset,
+   all endpoints are visited with ux_host_stack_endpoint_statistics_walk and
+   ux_device_stack_endpoint_statistics_walk. UX_ENDPOINT_STATISTICS_TIMESTAMP_GET and
+   UX_ENDPOINT_STATISTICS_TIMESTAMP_FREQUENCY define a cycle counter as timestamp, the
+   default is the USBX tick.  */
+
+/* #define UX_ENABLE_ENDPOINT_STATISTICS   */
+
+/* Defined, this enables the enumeration timeline: the host stack records for each device
+   the time each enumeration phase (debounce, reset, address set, device descriptor,
+   configuration descriptor, configuration set and class activation) is reached from the
+   connection, the number of attempts and the phases where attempts failed. The timeline
+   is read with ux_host_stack_device_enumeration_timeline_get once the device connection
+   is notified. UX_ENUMERATION_TIMELINE_TIMESTAMP_GET and
+   UX_ENUMERATION_TIMELINE_TIMESTAMP_FREQUENCY define a cycle counter as timestamp, the
+   default is the USBX tick.  */
+
+/* #define UX_ENABLE_ENUMERATION_TIMELINE   */
+
+/* Defined, this enables the event driven mode of the host simulator (RTOS host only): the
+   simulator schedules transactions as soon as a transfer is queued by the host or the
+   device instead of on the timer tick, so control and bulk transfers run as fast as the
+   CPU allows. The frame number becomes virtual, it advances only when periodic endpoints
+   are served. The timer is kept to recover events that could be missed.  */
+
+/* #define UX_HCD_SIM_HOST_EVENT_DRIVEN   */
+
+/* Defined, this enables the direct transfer mode of the host simulator: except for control
+   transfers, all the data TDs of a host transfer are moved to or from the device transfer
+   request with a single copy in one scheduler pass, instead of one TD (up to
+   UX_HCD_SIM_HOST_MAX_PAYLOAD bytes) per pass. Short packet and ZLP handling is unchanged.  */
+
+/* #define UX_HCD_SIM_HOST_DIRECT_TRANSFER   */
+
+/* Defined, this enables the bus timing model of the host simulator (RTOS host only). Once
+   set with ux_hcd_sim_host_timing_model_set, transactions take bus time in full speed
+   frames or high speed microframes: data and protocol overhead at the bus bit time, NAK
+   retries and a device service latency. Scheduling stops when the frame is full and
+   resumes on next frame. With UX_HCD_SIM_HOST_EVENT_DRIVEN, frames advance with the bus
+   time instead of the timer tick, so ux_hcd_sim_host_timing_statistics_get predicts the
+   throughput on a real bus and the periodic (interrupt) headroom left in each frame.  */
+
+/* #define UX_HCD_SIM_HOST_TIMING_MODEL   */
+
+/* Defined, this enables the host endpoint transfer queue (RTOS host only). Bulk and
+   interrupt transfer requests submitted on an endpoint that already has a transfer in
+   progress are queued instead of being given to the controller. When a transfer completes,
+   the controller driver starts the next queued one before notifying the class, so the
+   endpoint is kept armed between transfers. Each transfer request is still completed with
+   its own semaphore or completion function.  */
+
+/* #define UX_HOST_ENDPOINT_TRANSFER_QUEUE   */
+
+/* Defined, this enables scatter-gather host transfer requests. A bulk transfer request
+   can describe its data with an array of segments instead of a contiguous buffer, and the
+   controller drivers build their TDs from the segments directly. Each segment but the last
+   must be a whole number of packets. CDC-ECM and ASIX then send chained NetX packets
+   without copying them when the chain fits in UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS or
+   UX_HOST_CLASS_ASIX_XMIT_SEGMENTS (default 4) segments.  */
+
+/* #define UX_HOST_TRANSFER_SCATTER_GATHER   */
+
+/* Defined, this enables the software EHCI controller model (RTOS host only). The EHCI
+   driver registers are then held in memory by the model, whose thread executes the
+   periodic and asynchronous schedules the driver builds and moves the qTD data to and
+   from the device simulator. Register the controller with
+   ux_host_stack_hcd_register(name, _ux_hcd_ehci_model_initialize, 0, 0) to run the
+   EHCI driver without EHCI hardware. Isochronous transfers are not modeled.  */
+
+/* #define UX_HCD_EHCI_MODEL_ENABLE   */
+
+/* Defined, this enables the software OHCI controller model (RTOS host only). The OHCI
+   driver registers are then held in memory by the model, whose thread executes the
+   periodic, control and bulk ED lists the driver builds frame by frame, moves the TD
+   data to and from the device simulator and writes the done queue back to the HCCA.
+   Register the controller with
+   ux_host_stack_hcd_register(name, _ux_hcd_ohci_model_initialize, 0, 0) to run the
+   OHCI driver without OHCI hardware. Isochronous transfers are not modeled.  */
+
+/* #define UX_HCD_OHCI_MODEL_ENABLE   */
+
+/* Defined, this enables the host stack bandwidth map. The periodic bandwidth is then
+   budgeted per micro-frame over the 32 frames of the periodic schedule, and the periodic
+   bandwidth of full/low speed devices behind a high speed hub is budgeted per frame in
+   the Transaction Translator of the hub. Each periodic endpoint is placed in the least
+   loaded frame and micro-frame, which the controller drivers then use to link it in the
+   periodic list. This costs 32 USHORT loads per TT of each device (UX_MAX_TT TTs) and 256
+   USHORT loads per controller. UX_MAX_DEVICES must be greater than 1.  */
+
+/* #define UX_ENABLE_BANDWIDTH_MAP   */
+
 /* Defined, this value represents the number of packets in the CDC_ECM device class.
    The default is 16.
 */
@@ -593,6 +813,10 @@
 #define UX_HOST_CLASS_STORAGE_MAX_TRANSFER_SIZE             (1024 * 1)
 
 /* Defined, this value represents the size of the log pool.
+   When UX_ENABLE_DEBUG_LOG is defined, UX_DEBUG_LOG messages are kept in this pool as binary
+   records, without lock if UX_DEBUG_LOG_INDEX_RESERVE is defined by the port. The log is
+   exported with ux_utility_debug_log_dump and formatted by utility/debug_log, strings longer
+   than UX_DEBUG_LOG_STRING_LENGTH_MAX (64 by default) are truncated.
 */
 #define UX_DEBUG_LOG_SIZE                                   (1024 * 16)
 
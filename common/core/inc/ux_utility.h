@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */
 /*                                                                        */
 /*    ux_utility.h                                        PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,28 @@
 /*                                            added new function to check */
 /*                                            parsed size of descriptor,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            added byte pool allocate    */
+/*                                            and free functions,         */
+/*                                            added TLSF byte pool        */
+/*                                            support, added memory arena */
+/*                                            functions,                  */
+/*                                            added memory word size      */
+/*                                            definitions,                */
+/*                                            added mutex get with        */
+/*                                            contention count,           */
+/*                                            added memory profiler       */
+/*                                            functions,                  */
+/*                                            added memory steady state   */
+/*                                            functions,                  */
+/*                                            added data buffer           */
+/*                                            allocation,                 */
+/*                                            added specialized           */
+/*                                            descriptor unpackers,       */
+/*                                            added memory fragmentation  */
+/*                                            report,                     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -76,6 +98,40 @@ VOID             _ux_utility_descriptor_pack(UCHAR * descriptor, UCHAR * descrip
                              UINT descriptor_entries, UCHAR * raw_descriptor);
 ULONG            _ux_utility_descriptor_parse_size(UCHAR * descriptor_structure, UINT descriptor_entries, UINT size_align_mask);
 
+/* Define the raw descriptor field access used by the specialized unpackers.  */
+
+#define UX_DESCRIPTOR_FIELD_GET_1(p)            ((UCHAR)(p)[0])
+#define UX_DESCRIPTOR_FIELD_GET_2(p)            ((USHORT)((USHORT)(p)[0] | (USHORT)((USHORT)(p)[1] << 8)))
+#define UX_DESCRIPTOR_FIELD_GET_4(p)            ((ULONG)(p)[0] | ((ULONG)(p)[1] << 8) | ((ULONG)(p)[2] << 16) | ((ULONG)(p)[3] << 24))
+#define UX_DESCRIPTOR_FIELD_UNPACK(name, size, offset)                          \
+    descriptor -> name =  UX_DESCRIPTOR_FIELD_GET_##size(raw_descriptor + (offset));
+
+#if !defined(UX_DISABLE_DESCRIPTOR_UNPACK)
+VOID             _ux_utility_descriptor_unpack_device(UCHAR * raw_descriptor, UX_DEVICE_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_configuration(UCHAR * raw_descriptor, UX_CONFIGURATION_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_interface(UCHAR * raw_descriptor, UX_INTERFACE_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_interface_association(UCHAR * raw_descriptor, UX_INTERFACE_ASSOCIATION_DESCRIPTOR * descriptor);
+VOID             _ux_utility_descriptor_unpack_endpoint(UCHAR * raw_descriptor, UX_ENDPOINT_DESCRIPTOR * descriptor);
+#else
+
+/* Unpack through the descriptor structure interpreter.  */
+#define _ux_utility_descriptor_unpack_device(r, d)                                              \
+    _ux_utility_descriptor_parse((r), _ux_system_device_descriptor_structure,                   \
+                        UX_DEVICE_DESCRIPTOR_ENTRIES, (UCHAR *)(d))
+#define _ux_utility_descriptor_unpack_configuration(r, d)                                       \
+    _ux_utility_descriptor_parse((r), _ux_system_configuration_descriptor_structure,            \
+                        UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *)(d))
+#define _ux_utility_descriptor_unpack_interface(r, d)                                           \
+    _ux_utility_descriptor_parse((r), _ux_system_interface_descriptor_structure,                \
+                        UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *)(d))
+#define _ux_utility_descriptor_unpack_interface_association(r, d)                               \
+    _ux_utility_descriptor_parse((r), _ux_system_interface_association_descriptor_structure,    \
+                        UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES, (UCHAR *)(d))
+#define _ux_utility_descriptor_unpack_endpoint(r, d)                                            \
+    _ux_utility_descriptor_parse((r), _ux_system_endpoint_descriptor_structure,                 \
+                        UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *)(d))
+#endif
+
 ULONG            _ux_utility_long_get(UCHAR * address);
 VOID             _ux_utility_long_put(UCHAR * address, ULONG value);
 VOID             _ux_utility_long_put_big_endian(UCHAR * address, ULONG value);
@@ -88,6 +144,48 @@ ULONG            _ux_utility_string_length_get(UCHAR *string);
 UINT             _ux_utility_string_length_check(UCHAR *input_string, UINT *string_length_ptr, UINT max_string_length);
 UCHAR           *_ux_utility_memory_byte_pool_search(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_size);
 UINT             _ux_utility_memory_byte_pool_create(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *pool_start, ULONG pool_size);
+UCHAR           *_ux_utility_memory_byte_pool_allocate(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_alignment, ULONG memory_size_requested);
+VOID             _ux_utility_memory_byte_pool_free(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory);
+UINT             _ux_utility_memory_fragmentation_get(ULONG memory_cache_flag, UX_MEMORY_FRAGMENTATION *fragmentation);
+UINT             _ux_utility_memory_slab_trim(ULONG memory_cache_flag);
+#ifdef UX_ENABLE_MEMORY_SLAB
+UCHAR           *_ux_utility_memory_slab_allocate(UX_MEMORY_SLAB *slab_ptr);
+ULONG            _ux_utility_memory_slab_free(VOID *memory);
+ULONG            _ux_utility_memory_slab_release(UX_MEMORY_BYTE_POOL *pool_ptr);
+#endif
+#ifdef UX_ENABLE_MEMORY_TLSF
+UINT             _ux_utility_memory_tlsf_fls(ULONG value);
+VOID             _ux_utility_memory_tlsf_mapping(ULONG block_size, UINT *fl_index, UINT *sl_index);
+VOID             _ux_utility_memory_tlsf_block_insert(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr);
+VOID             _ux_utility_memory_tlsf_block_remove(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr);
+UCHAR           *_ux_utility_memory_tlsf_block_find(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG block_size);
+VOID             _ux_utility_memory_tlsf_create(UX_MEMORY_BYTE_POOL *pool_ptr);
+UCHAR           *_ux_utility_memory_tlsf_allocate(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_alignment, ULONG memory_size_requested);
+VOID             _ux_utility_memory_tlsf_free(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory);
+#endif
+#ifdef UX_ENABLE_MEMORY_ARENA
+UX_MEMORY_ARENA *_ux_utility_memory_arena_create(VOID);
+UX_MEMORY_ARENA *_ux_utility_memory_arena_select(UX_MEMORY_ARENA *arena_ptr);
+VOID             _ux_utility_memory_arena_delete(UX_MEMORY_ARENA *arena_ptr);
+UCHAR           *_ux_utility_memory_arena_allocate(UX_MEMORY_ARENA *arena_ptr, ULONG memory_alignment, ULONG memory_size_requested);
+ULONG            _ux_utility_memory_arena_free(VOID *memory);
+VOID             _ux_utility_memory_arena_chunks_free(UX_MEMORY_ARENA *arena_ptr);
+#endif
+#ifdef UX_ENABLE_MEMORY_PROFILER
+VOID             _ux_utility_memory_profiler_allocate(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory, ULONG memory_size_requested,
+                                    ULONG memory_size, ALIGN_TYPE caller);
+VOID             _ux_utility_memory_profiler_free(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory);
+VOID             _ux_utility_memory_profiler_owner_set(const UCHAR *owner_name, ULONG owner_address,
+                                    UX_MEMORY_PROFILER_OWNER *previous_owner);
+VOID             _ux_utility_memory_profiler_owner_restore(UX_MEMORY_PROFILER_OWNER *previous_owner);
+UINT             _ux_utility_memory_profiler_snapshot(UCHAR *buffer, ULONG buffer_length, ULONG *actual_length);
+#endif
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+VOID             _ux_utility_memory_steady_state_enter(ULONG steady_state_owner);
+VOID             _ux_utility_memory_steady_state_exit(ULONG steady_state_owner);
+VOID             _ux_utility_memory_steady_state_hold(VOID);
+VOID             _ux_utility_memory_steady_state_release(VOID);
+#endif
 VOID             _ux_utility_memory_set(VOID *destination, UCHAR value, ULONG length);
 ULONG            _ux_utility_pci_class_scan(ULONG pci_class, ULONG bus_number, ULONG device_number,
                             ULONG function_number, ULONG *current_bus_number,
@@ -113,6 +211,7 @@ UINT             _ux_utility_mutex_create(UX_MUTEX *mutex, CHAR *mutex_name);
 UINT             _ux_utility_mutex_delete(UX_MUTEX *mutex);
 VOID             _ux_utility_mutex_off(UX_MUTEX *mutex);
 VOID             _ux_utility_mutex_on(UX_MUTEX *mutex);
+VOID             _ux_utility_mutex_on_count(UX_MUTEX *mutex, ULONG *contention_count);
 UINT             _ux_utility_semaphore_create(UX_SEMAPHORE *semaphore, CHAR *semaphore_name, UINT initial_count);
 UINT             _ux_utility_semaphore_delete(UX_SEMAPHORE *semaphore);
 UINT             _ux_utility_semaphore_get(UX_SEMAPHORE *semaphore, ULONG semaphore_signal);
@@ -194,6 +293,7 @@ extern  ALIGN_TYPE  _ux_utility_time_elapsed(ALIGN_TYPE, ALIGN_TYPE);
 #define _ux_system_mutex_delete                                 _ux_utility_mutex_delete
 #define _ux_system_mutex_off                                    _ux_utility_mutex_off
 #define _ux_system_mutex_on                                     _ux_utility_mutex_on
+#define _ux_system_mutex_on_count                               _ux_utility_mutex_on_count
 #define _ux_system_event_flags_create                           _ux_utility_event_flags_create
 #define _ux_system_event_flags_created(e)                       ((e)->tx_event_flags_group_id != UX_EMPTY)
 #define _ux_system_event_flags_delete                           _ux_utility_event_flags_delete
@@ -217,6 +317,7 @@ extern  ALIGN_TYPE  _ux_utility_time_elapsed(ALIGN_TYPE, ALIGN_TYPE);
 #define _ux_system_mutex_delete(mutex)                          do{}while(0)
 #define _ux_system_mutex_off(mutex)                             do{}while(0)
 #define _ux_system_mutex_on(mutex)                              do{}while(0)
+#define _ux_system_mutex_on_count(mutex,count)                  do{}while(0)
 #define _ux_system_event_flags_create(g,name)                   (UX_SUCCESS)
 #define _ux_system_event_flags_created(e)                       (UX_FALSE)
 #define _ux_system_event_flags_delete(g)                        do{}while(0)
@@ -290,6 +391,7 @@ extern  ALIGN_TYPE  _ux_utility_time_elapsed(ALIGN_TYPE, ALIGN_TYPE);
 #define _ux_host_mutex_delete                                   _ux_utility_mutex_delete
 #define _ux_host_mutex_off                                      _ux_utility_mutex_off
 #define _ux_host_mutex_on                                       _ux_utility_mutex_on
+#define _ux_host_mutex_on_count                                 _ux_utility_mutex_on_count
 #define _ux_host_event_flags_create                             _ux_utility_event_flags_create
 #define _ux_host_event_flags_delete                             _ux_utility_event_flags_delete
 #define _ux_host_event_flags_get                                _ux_utility_event_flags_get
@@ -316,6 +418,7 @@ extern  ALIGN_TYPE  _ux_utility_time_elapsed(ALIGN_TYPE, ALIGN_TYPE);
 #define _ux_host_mutex_delete(mutex)                            do{}while(0)
 #define _ux_host_mutex_off(mutex)                               do{}while(0)
 #define _ux_host_mutex_on(mutex)                                do{}while(0)
+#define _ux_host_mutex_on_count(mutex,count)                    do{}while(0)
 #define _ux_host_event_flags_create(g,name)                     (UX_SUCCESS)
 #define _ux_host_event_flags_delete(g)                          (UX_SUCCESS)
 #define _ux_host_event_flags_get(g,req,gopt,actual,wopt)        (UX_SUCCESS)
@@ -354,6 +457,36 @@ VOID             _ux_utility_error_callback_register(VOID (*error_callback)(UINT
             result = (mul_v0) * (mul_v1);                                   \
     } while(0)
 
+/* Define memory profiler owner tagging, the previous owner is saved in a
+   UX_MEMORY_PROFILER_OWNER local declared under UX_ENABLE_MEMORY_PROFILER.  */
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+#define UX_MEMORY_PROFILER_OWNER_SET(name,address,previous)        _ux_utility_memory_profiler_owner_set(name,address,previous)
+#define UX_MEMORY_PROFILER_OWNER_RESTORE(previous)                 _ux_utility_memory_profiler_owner_restore(previous)
+#else
+#define UX_MEMORY_PROFILER_OWNER_SET(name,address,previous)
+#define UX_MEMORY_PROFILER_OWNER_RESTORE(previous)
+#endif
+
+/* Define memory steady state switching by the stacks.  */
+
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+#define UX_MEMORY_STEADY_STATE_ENTER(owner)                        _ux_utility_memory_steady_state_enter(owner)
+#define UX_MEMORY_STEADY_STATE_EXIT(owner)                         _ux_utility_memory_steady_state_exit(owner)
+#define UX_MEMORY_STEADY_STATE_HOLD()                              _ux_utility_memory_steady_state_hold()
+#define UX_MEMORY_STEADY_STATE_RELEASE()                           _ux_utility_memory_steady_state_release()
+#else
+#define UX_MEMORY_STEADY_STATE_ENTER(owner)
+#define UX_MEMORY_STEADY_STATE_EXIT(owner)
+#define UX_MEMORY_STEADY_STATE_HOLD()
+#define UX_MEMORY_STEADY_STATE_RELEASE()
+#endif
+
+/* Define the word used by memory copy, set and compare.  */
+
+#define          UX_UTILITY_MEMORY_WORD_SIZE                    ((ULONG)sizeof(ALIGN_TYPE))
+#define          UX_UTILITY_MEMORY_WORD_MASK                    ((ALIGN_TYPE)sizeof(ALIGN_TYPE) - 1u)
+
 #define          UX_UTILITY_MEMORY_ALLOCATE_MULC_SAFE(align,cache,size_mul_v,size_mul_c)       \
     (UX_OVERFLOW_CHECK_MULC_ULONG(size_mul_v, size_mul_c) ? UX_NULL : _ux_utility_memory_allocate((align), (cache), (size_mul_v)*(size_mul_c)))
 #define          UX_UTILITY_MEMORY_ALLOCATE_MULV_SAFE(align,cache,size_mul_v0,size_mul_v1)     \
@@ -392,6 +525,20 @@ VOID*            _ux_utility_memory_allocate_add_safe(ULONG align,ULONG cache,UL
 #endif /* UX_DISABLE_ARITHMETIC_CHECK */
 
 
+/* Define transfer data buffer allocation. With data cache maintenance the buffer is
+   allocated from regular memory and covers whole cache lines, so that no other data
+   shares a line with it while it is cleaned or invalidated. Otherwise it is allocated
+   from cache safe memory.  */
+
+#if defined(UX_ENABLE_DATA_CACHE_MAINTENANCE)
+#define          _ux_utility_memory_data_buffer_allocate(size)                                 \
+    _ux_utility_memory_allocate_add_safe(UX_CACHE_LINE_ALIGN, UX_REGULAR_MEMORY, (size), UX_CACHE_LINE_ALIGN)
+#else
+#define          _ux_utility_memory_data_buffer_allocate(size)                                 \
+    _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, (size))
+#endif
+
+
 #if defined(UX_NAME_REFERENCED_BY_POINTER)
 #define ux_utility_name_match(n0,n1,l) ((n0) == (n1))
 #else
@@ -409,6 +556,11 @@ VOID*            _ux_utility_memory_allocate_add_safe(ULONG align,ULONG cache,UL
 
 #define ux_utility_descriptor_parse                    _ux_utility_descriptor_parse
 #define ux_utility_descriptor_pack                     _ux_utility_descriptor_pack
+#define ux_utility_descriptor_unpack_device            _ux_utility_descriptor_unpack_device
+#define ux_utility_descriptor_unpack_configuration     _ux_utility_descriptor_unpack_configuration
+#define ux_utility_descriptor_unpack_interface         _ux_utility_descriptor_unpack_interface
+#define ux_utility_descriptor_unpack_interface_association _ux_utility_descriptor_unpack_interface_association
+#define ux_utility_descriptor_unpack_endpoint          _ux_utility_descriptor_unpack_endpoint
 #define ux_utility_long_get                            _ux_utility_long_get
 #define ux_utility_long_put                            _ux_utility_long_put
 #define ux_utility_long_put_big_endian                 _ux_utility_long_put_big_endian
@@ -416,7 +568,16 @@ VOID*            _ux_utility_memory_allocate_add_safe(ULONG align,ULONG cache,UL
 #define ux_utility_memory_allocate                     _ux_utility_memory_allocate
 #define ux_utility_memory_compare                      _ux_utility_memory_compare
 #define ux_utility_memory_copy                         _ux_utility_memory_copy
+#define ux_utility_memory_fragmentation_get            _ux_utility_memory_fragmentation_get
+#define ux_utility_memory_slab_trim                    _ux_utility_memory_slab_trim
 #define ux_utility_memory_free                         _ux_utility_memory_free
+#define ux_utility_memory_profiler_owner_set           _ux_utility_memory_profiler_owner_set
+#define ux_utility_memory_profiler_owner_restore       _ux_utility_memory_profiler_owner_restore
+#define ux_utility_memory_profiler_snapshot            _ux_utility_memory_profiler_snapshot
+#define ux_utility_memory_steady_state_enter           _ux_utility_memory_steady_state_enter
+#define ux_utility_memory_steady_state_exit            _ux_utility_memory_steady_state_exit
+#define ux_utility_memory_steady_state_hold            _ux_utility_memory_steady_state_hold
+#define ux_utility_memory_steady_state_release         _ux_utility_memory_steady_state_release
 #define ux_utility_string_length_get                   _ux_utility_string_length_get
 #define ux_utility_string_length_check                 _ux_utility_string_length_check
 #define ux_utility_memory_set                          _ux_utility_memory_set
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_dcd_sim_slave_initialize_complete               PORTABLE C      */
-/*                                                           6.1.9        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,7 +54,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    (ux_slave_dcd_function)               DCD dispatch function         */ 
-/*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_device  Unpack descriptor             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -74,6 +74,10 @@
 /*  10-15-2021     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            filled payload size,        */
 /*                                            resulting in version 6.1.9  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_dcd_sim_slave_initialize_complete(VOID)
@@ -112,10 +116,7 @@ UX_SLAVE_TRANSFER       *transfer_request;
     device_framework =  _ux_system_slave -> ux_system_slave_device_framework;
 
     /* And create the decompressed device descriptor structure.  */
-    _ux_utility_descriptor_parse(device_framework,
-                                _ux_system_device_descriptor_structure,
-                                UX_DEVICE_DESCRIPTOR_ENTRIES,
-                                (UCHAR *) &device -> ux_slave_device_descriptor);
+    _ux_utility_descriptor_unpack_device(device_framework, &device -> ux_slave_device_descriptor);
         
     /* Now we create a transfer request to accept the first SETUP packet
        and get the ball running. First get the address of the endpoint
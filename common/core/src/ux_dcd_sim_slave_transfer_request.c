@@ -26,6 +26,7 @@
 
 #include "ux_api.h"
 #include "ux_dcd_sim_slave.h"
+#include "ux_hcd_sim_host.h"
 
 
 /**************************************************************************/
@@ -33,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_dcd_sim_slave_transfer_request                  PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -78,6 +79,10 @@
 /*                                            before semaphore wakeup to  */
 /*                                            avoid a race condition,     */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven host     */
+/*                                            simulator kick,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_dcd_sim_slave_transfer_request(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request)
@@ -103,6 +108,9 @@ UINT                    status;
         /* Set the ED to TRANSFER status.  */
         ed -> ux_sim_slave_ed_status |= UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
 
+        /* In event driven mode, kick the host simulator now.  */
+        UX_HCD_SIM_HOST_SCHEDULE_SIGNAL((UX_HCD *)dcd_sim_slave -> ux_dcd_sim_slave_hcd);
+
         /* We should wait for the semaphore to wake us up.  */
         status =  _ux_device_semaphore_get(&transfer_request -> ux_slave_transfer_request_semaphore,
                                             transfer_request -> ux_slave_transfer_request_timeout);
@@ -26,6 +26,7 @@
 
 #include "ux_api.h"
 #include "ux_dcd_sim_slave.h"
+#include "ux_hcd_sim_host.h"
 
 
 #if defined(UX_DEVICE_STANDALONE)
@@ -34,7 +35,7 @@
 /*  FUNCTION                                                RELEASE       */
 /*                                                                        */
 /*    _ux_dcd_sim_slave_transfer_run                       PORTABLE C     */
-/*                                                            6.1.10      */
+/*                                                            6.x         */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -76,6 +77,10 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  01-31-2022     Chaoqiong Xiao           Initial Version 6.1.10        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven host     */
+/*                                            simulator kick,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_dcd_sim_slave_transfer_run(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request)
@@ -141,6 +146,10 @@ ULONG                   ed_status;
     /* Start transfer.  */
     ed->ux_sim_slave_ed_status |= UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
     UX_RESTORE
+
+    /* In event driven mode, kick the host simulator now.  */
+    UX_HCD_SIM_HOST_SCHEDULE_SIGNAL((UX_HCD *)dcd_sim_slave -> ux_dcd_sim_slave_hcd);
+
     return(UX_STATE_WAIT);
 
 }
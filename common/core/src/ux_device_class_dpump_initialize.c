@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_dpump_initialize                   PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -73,6 +73,10 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used data buffer            */
+/*                                            allocation,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_dpump_initialize(UX_SLAVE_CLASS_COMMAND *command)
@@ -97,8 +101,7 @@ UX_SLAVE_CLASS_DPUMP_PARAMETER          *dpump_parameter;
 
 #if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
     UX_ASSERT(!UX_DEVICE_CLASS_DPUMP_ENDPOINT_BUFFER_SIZE_CALC_OVERFLOW);
-    dpump -> ux_device_class_dpump_endpoint_buffer = _ux_utility_memory_allocate(
-                                UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY,
+    dpump -> ux_device_class_dpump_endpoint_buffer = _ux_utility_memory_data_buffer_allocate(
                                 UX_DEVICE_CLASS_DPUMP_ENDPOINT_BUFFER_SIZE);
     if (dpump -> ux_device_class_dpump_endpoint_buffer == UX_NULL)
     {
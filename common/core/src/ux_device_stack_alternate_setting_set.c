@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_alternate_setting_set              PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,7 +57,12 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    (ux_slave_dcd_function)               DCD dispatch function         */ 
-/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_descriptor_unpack_endpoint                              */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*    _ux_device_stack_transfer_all_request_abort                         */
 /*                                          Abort transfer                */
 /*    _ux_utility_memory_copy               Copy memory                   */
@@ -84,6 +89,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_alternate_setting_set(ULONG interface_value, ULONG alternate_setting_value)
@@ -190,10 +199,7 @@ ULONG                           max_transfer_length, n_trans;
         {
 
             /* Parse the descriptor in something more readable. */
-            _ux_utility_descriptor_parse(device_framework,
-                        _ux_system_configuration_descriptor_structure,
-                        UX_CONFIGURATION_DESCRIPTOR_ENTRIES,
-                        (UCHAR *) &configuration_descriptor);
+            _ux_utility_descriptor_unpack_configuration(device_framework, &configuration_descriptor);
 
             /* Now we need to check the configuration value.  */
             if (configuration_descriptor.bConfigurationValue == device -> ux_slave_device_configuration_selected)
@@ -220,10 +226,7 @@ ULONG                           max_transfer_length, n_trans;
                     {
 
                         /* Parse the descriptor in something more readable. */
-                        _ux_utility_descriptor_parse(device_framework,
-                                    _ux_system_interface_descriptor_structure,
-                                    UX_INTERFACE_DESCRIPTOR_ENTRIES,
-                                    (UCHAR *) &interface_descriptor);
+                        _ux_utility_descriptor_unpack_interface(device_framework, &interface_descriptor);
 
                         /* Check if this is the interface we are searching. */
                         if (interface_descriptor.bInterfaceNumber == interface_value &&
@@ -308,10 +311,8 @@ ULONG                           max_transfer_length, n_trans;
                                         return(UX_MEMORY_INSUFFICIENT);
 
                                     /* Parse the descriptor in something more readable.  */
-                                    _ux_utility_descriptor_parse(device_framework,
-                                                    _ux_system_endpoint_descriptor_structure,
-                                                    UX_ENDPOINT_DESCRIPTOR_ENTRIES,
-                                                    (UCHAR *) &endpoint -> ux_slave_endpoint_descriptor);
+                                    _ux_utility_descriptor_unpack_endpoint(device_framework,
+                                                    &endpoint -> ux_slave_endpoint_descriptor);
 
                                     /* Now we create a transfer request to accept transfer on this endpoint.  */
                                     transfer_request =  &endpoint -> ux_slave_endpoint_transfer_request;
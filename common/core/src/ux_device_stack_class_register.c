@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_class_register                     PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,6 +63,9 @@
 /*    _ux_utility_string_length_check       Check C string and return     */
 /*                                          its length if null-terminated */
 /*    _ux_utility_memory_copy               Memory copy                   */ 
+/*    _ux_utility_memory_profiler_owner_set Set memory owner              */ 
+/*    _ux_utility_memory_profiler_owner_restore                           */ 
+/*                                          Restore memory owner          */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -78,6 +81,10 @@
 /*                                            definitions, verified       */
 /*                                            memset and memcpy cases,    */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            tagged class memory in      */
+/*                                            profiler,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_class_register(UCHAR *class_name,
@@ -90,6 +97,9 @@ UINT  _ux_device_stack_class_register(UCHAR *class_name,
 UX_SLAVE_CLASS              *class_inst;
 UINT                        status;
 UX_SLAVE_CLASS_COMMAND      command;
+#if defined(UX_ENABLE_MEMORY_PROFILER)
+UX_MEMORY_PROFILER_OWNER    previous_owner;
+#endif
 UINT                        class_name_length =  0;
 #if UX_MAX_SLAVE_CLASS_DRIVER > 1
 ULONG                       class_index;
@@ -141,8 +151,11 @@ ULONG                       class_index;
             command.ux_slave_class_command_parameter  =  parameter;
             command.ux_slave_class_command_class_ptr  =  class_inst;
 
-            /* Call the class initialization routine.  */
+            /* Call the class initialization routine, its allocations are tagged
+               with the class and interface in profiler.  */
+            UX_MEMORY_PROFILER_OWNER_SET(class_inst -> ux_slave_class_name, interface_number, &previous_owner);
             status = class_entry_function(&command);
+            UX_MEMORY_PROFILER_OWNER_RESTORE(&previous_owner);
             
             /* Check the status.  */
             if (status != UX_SUCCESS)
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_configuration_set                  PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,7 +59,12 @@
 /*    (ux_slave_dcd_function)               DCD dispatch function         */ 
 /*    _ux_device_stack_interface_delete     Delete interface              */
 /*    _ux_device_stack_interface_set        Set interface                 */ 
-/*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_memory_steady_state_enter Enter memory steady state     */
+/*    _ux_utility_memory_steady_state_exit  Exit memory steady state      */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -79,6 +84,13 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            entered memory steady state */
+/*                                            when configured,            */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            added trace ring events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_configuration_set(ULONG configuration_value)
@@ -110,6 +122,9 @@ ULONG                           class_index;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_STACK_CONFIGURATION_SET, configuration_value, 0, 0, 0, UX_TRACE_DEVICE_STACK_EVENTS, 0, 0)
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_CONFIGURATION_SET, configuration_value, 0, 0)
+
     /* Get the pointer to the DCD.  */
     dcd =  &_ux_system_slave -> ux_system_slave_dcd;
 
@@ -141,10 +156,7 @@ ULONG                           class_index;
         if (descriptor_type == UX_CONFIGURATION_DESCRIPTOR_ITEM)
         {
             /* Parse the descriptor in something more readable.  */
-            _ux_utility_descriptor_parse(device_framework,
-                        _ux_system_configuration_descriptor_structure,
-                        UX_CONFIGURATION_DESCRIPTOR_ENTRIES,
-                        (UCHAR *) &configuration_descriptor);
+            _ux_utility_descriptor_unpack_configuration(device_framework, &configuration_descriptor);
 
             /* Now we need to check the configuration value. It has
                to be the same as the one specified in the setup function.  */
@@ -187,9 +199,15 @@ ULONG                           class_index;
 
             /* If there is a class container for this instance, deactivate it.  */
             if (class_inst != UX_NULL)
+            {
+
+                /* If trace ring is enabled, insert this event into the ring.  */
+                UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_CLASS_DEACTIVATE, interface_ptr -> ux_slave_interface_descriptor.bInterfaceNumber,
+                                     interface_ptr -> ux_slave_interface_descriptor.bInterfaceClass, 0)
 
                 /* Call the class with the DEACTIVATE signal.  */
                 class_inst -> ux_slave_class_entry_function(&class_command);
+            }
 
 #if !defined(UX_DEVICE_INITIALIZE_FRAMEWORK_SCAN_DISABLE) || UX_MAX_DEVICE_INTERFACES > 1
             /* Get the next interface.  */
@@ -210,6 +228,9 @@ ULONG                           class_index;
     /* No configuration is selected.  */
     device -> ux_slave_device_configuration_selected =  0;
 
+    /* Device stack is no longer in steady state, allocations are expected.  */
+    UX_MEMORY_STEADY_STATE_EXIT(UX_MEMORY_STEADY_STATE_DEVICE);
+
     /* Mark the device as attached now. */
     device -> ux_slave_device_state =  UX_DEVICE_ATTACHED;
 
@@ -225,10 +246,8 @@ ULONG                           class_index;
 
     /* We have found the configuration value requested by the host.
        Create the configuration descriptor and attach it to the device.  */
-    _ux_utility_descriptor_parse(device_framework,
-                _ux_system_configuration_descriptor_structure,
-                UX_CONFIGURATION_DESCRIPTOR_ENTRIES,
-                (UCHAR *) &device -> ux_slave_device_configuration_descriptor);
+    _ux_utility_descriptor_unpack_configuration(device_framework,
+                &device -> ux_slave_device_configuration_descriptor);
 
     /* Configuration character D6 is for Self-powered */
     _ux_system_slave -> ux_system_slave_power_state = (configuration_descriptor.bmAttributes & 0x40) ? UX_DEVICE_SELF_POWERED : UX_DEVICE_BUS_POWERED;
@@ -270,10 +289,7 @@ ULONG                           class_index;
         {
 
             /* Parse the descriptor in something more readable.  */
-            _ux_utility_descriptor_parse(device_framework,
-                        _ux_system_interface_descriptor_structure,
-                        UX_INTERFACE_DESCRIPTOR_ENTRIES,
-                        (UCHAR *) &interface_descriptor);
+            _ux_utility_descriptor_unpack_interface(device_framework, &interface_descriptor);
 
             /* If the alternate setting is 0 for this interface, we need to
                memorize its class association and start it.  */
@@ -397,6 +413,9 @@ ULONG                           class_index;
     /* The DCD needs to update the device state too.  */
     dcd -> ux_slave_dcd_function(dcd, UX_DCD_CHANGE_STATE, (VOID *) UX_DEVICE_CONFIGURED);
 
+    /* Classes are activated, device stack is in steady state.  */
+    UX_MEMORY_STEADY_STATE_ENTER(UX_MEMORY_STEADY_STATE_DEVICE);
+
     /* Configuration mounted. */
     return(UX_SUCCESS);
 }
@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_control_request_process            PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -97,6 +97,9 @@
 /*                                            improved interface request  */
 /*                                            process with print class,   */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_control_request_process(UX_SLAVE_TRANSFER *transfer_request)
@@ -292,6 +295,9 @@ ULONG                       application_data_length;
             /* Memorize the address. Some controllers memorize the address here. Some don't.  */
             dcd -> ux_slave_dcd_device_address =  request_value;
 
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_ADDRESS_SET, request_value, 0, 0)
+
             /* Force the new address.  */
             status =  dcd -> ux_slave_dcd_function(dcd, UX_DCD_SET_DEVICE_ADDRESS, (VOID *) (ALIGN_TYPE) request_value);
             break;
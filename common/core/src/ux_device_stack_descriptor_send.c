@@ -40,7 +40,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_descriptor_send                    PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,8 @@
 /*    (ux_slave_dcd_function)               DCD dispatch function         */
 /*    _ux_device_stack_transfer_request     Process transfer request      */
 /*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
 /*    _ux_utility_memory_copy               Memory copy                   */
 /*    _ux_utility_short_get                 Get short value               */
 /*                                                                        */
@@ -93,6 +95,10 @@
 /*                                            added support for get string*/
 /*                                            requests with zero wIndex,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_descriptor_send(ULONG descriptor_type, ULONG request_index, ULONG host_length)
@@ -289,10 +295,8 @@ ULONG                           string_length;
                     {
 
                         /* Parse the configuration descriptor. */
-                        _ux_utility_descriptor_parse(device_framework,
-                                    _ux_system_configuration_descriptor_structure,
-                                    UX_CONFIGURATION_DESCRIPTOR_ENTRIES,
-                                    (UCHAR *) &configuration_descriptor);
+                        _ux_utility_descriptor_unpack_configuration(device_framework,
+                                    &configuration_descriptor);
 
                         /* Get the length of entire configuration descriptor.  */
                         target_descriptor_length = configuration_descriptor.wTotalLength;
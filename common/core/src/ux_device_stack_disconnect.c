@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_disconnect                         PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,7 @@
 /*    (ux_slave_class_entry_function)       Device class entry function   */ 
 /*    (ux_slave_dcd_function)               DCD dispatch function         */ 
 /*    _ux_device_stack_interface_delete     Delete interface              */
+/*    _ux_utility_memory_steady_state_exit  Exit memory steady state      */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -76,6 +77,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            exited memory steady state, */
+/*                                            added trace ring events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_disconnect(VOID)
@@ -100,6 +105,9 @@ UINT                        status = UX_ERROR;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_STACK_DISCONNECT, device, 0, 0, 0, UX_TRACE_DEVICE_STACK_EVENTS, 0, 0)
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_DISCONNECT, device -> ux_slave_device_state, 0, 0)
+
     /* If trace is enabled, register this object.  */
     UX_TRACE_OBJECT_UNREGISTER(device);
 
@@ -128,9 +136,15 @@ UINT                        status = UX_ERROR;
 
             /* If there is a class container for this instance, deactivate it.  */
             if (class_ptr != UX_NULL)
-            
+            {
+
+                /* If trace ring is enabled, insert this event into the ring.  */
+                UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_CLASS_DEACTIVATE, interface_ptr -> ux_slave_interface_descriptor.bInterfaceNumber,
+                                     interface_ptr -> ux_slave_interface_descriptor.bInterfaceClass, 0)
+
                 /* Call the class with the DEACTIVATE signal.  */
                 class_ptr -> ux_slave_class_entry_function(&class_command);
+            }
 
 #if !defined(UX_DEVICE_INITIALIZE_FRAMEWORK_SCAN_DISABLE) || UX_MAX_DEVICE_INTERFACES > 1
             /* Get the next interface.  */
@@ -160,6 +174,9 @@ UINT                        status = UX_ERROR;
     /* We are reverting to configuration 0.  */
     device -> ux_slave_device_configuration_selected =  0;
 
+    /* Device stack is no longer in steady state, allocations are expected.  */
+    UX_MEMORY_STEADY_STATE_EXIT(UX_MEMORY_STEADY_STATE_DEVICE);
+
     /* Set the device to be non attached.  */
     device -> ux_slave_device_state =  UX_DEVICE_RESET;
 
@@ -0,0 +1,90 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Stack                                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_stack_endpoint_statistics_get            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies the transfer statistics of an endpoint. The    */
+/*    copy is consistent, transfers completing meanwhile are counted      */
+/*    before or after it.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    endpoint                              Pointer to endpoint           */
+/*    statistics                            Pointer to statistics copy    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_device_stack_endpoint_statistics_get(UX_SLAVE_ENDPOINT *endpoint, UX_ENDPOINT_STATISTICS *statistics)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Sanity check.  */
+    if ((endpoint == UX_NULL) || (statistics == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Transfers complete in the controller interrupt.  */
+    UX_DISABLE
+    _ux_utility_memory_copy(statistics, &endpoint -> ux_slave_endpoint_statistics, sizeof(UX_ENDPOINT_STATISTICS)); /* Use case of memcpy is verified. */
+    UX_RESTORE
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,89 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Stack                                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_stack_endpoint_statistics_reset          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function clears the transfer statistics of an endpoint. A      */
+/*    transfer pending while the statistics are cleared is counted when   */
+/*    it completes.                                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    endpoint                              Pointer to endpoint           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_device_stack_endpoint_statistics_reset(UX_SLAVE_ENDPOINT *endpoint)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Sanity check.  */
+    if (endpoint == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Transfers complete in the controller interrupt.  */
+    UX_DISABLE
+    _ux_utility_memory_set(&endpoint -> ux_slave_endpoint_statistics, 0, sizeof(UX_ENDPOINT_STATISTICS)); /* Use case of memset is verified. */
+    UX_RESTORE
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,119 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Stack                                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_stack_endpoint_statistics_walk           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function calls the application for each endpoint of the        */
+/*    device: the default control endpoint, then the endpoints of the     */
+/*    interfaces set. The statistics of an endpoint are read with         */
+/*    ux_device_stack_endpoint_statistics_get.                            */
+/*                                                                        */
+/*    The walk stops at the first status returned other than UX_SUCCESS,  */
+/*    this status is returned. The application must not change the        */
+/*    interfaces during the walk, it is called from thread context only.  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    walk_function                         Function called per endpoint  */
+/*    parameter                             Parameter of the function     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    (walk_function)                       Application function          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_device_stack_endpoint_statistics_walk(UINT (*walk_function)(UX_SLAVE_ENDPOINT *endpoint, VOID *parameter),
+                                                VOID *parameter)
+{
+
+UX_SLAVE_DEVICE     *device;
+UX_SLAVE_INTERFACE  *interface_ptr;
+UX_SLAVE_ENDPOINT   *endpoint;
+UINT                status;
+
+
+    /* Sanity check.  */
+    if (walk_function == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Check if the device stack is initialized.  */
+    if (_ux_system_slave == UX_NULL)
+        return(UX_SUCCESS);
+
+    /* The default control endpoint first.  */
+    device =  &_ux_system_slave -> ux_system_slave_device;
+    status =  walk_function(&device -> ux_slave_device_control_endpoint, parameter);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Then the endpoints of all the interfaces.  */
+    interface_ptr =  device -> ux_slave_device_first_interface;
+    while (interface_ptr != UX_NULL)
+    {
+        endpoint =  interface_ptr -> ux_slave_interface_first_endpoint;
+        while (endpoint != UX_NULL)
+        {
+            status =  walk_function(endpoint, parameter);
+            if (status != UX_SUCCESS)
+                return(status);
+            endpoint =  endpoint -> ux_slave_endpoint_next_endpoint;
+        }
+        interface_ptr =  interface_ptr -> ux_slave_interface_next_interface;
+    }
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -53,7 +53,7 @@ UX_SYSTEM_SLAVE *_ux_system_slave;
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_initialize                         PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -112,6 +112,10 @@ UX_SYSTEM_SLAVE *_ux_system_slave;
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used data buffer            */
+/*                                            allocation,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_initialize(UCHAR * device_framework_high_speed, ULONG device_framework_length_high_speed,
@@ -184,7 +188,7 @@ UCHAR                           *memory;
 
     /* Acquire a buffer for the size of the endpoint.  */
     transfer_request -> ux_slave_transfer_request_data_pointer =
-          _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH);
+          _ux_utility_memory_data_buffer_allocate(UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH);
 
     /* Ensure we have enough memory.  */
     if (transfer_request -> ux_slave_transfer_request_data_pointer == UX_NULL)
@@ -390,7 +394,7 @@ UCHAR                           *memory;
 
                 /* Obtain some memory.  */
                 endpoints_pool -> ux_slave_endpoint_transfer_request.ux_slave_transfer_request_data_pointer = 
-                                _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_SLAVE_REQUEST_DATA_MAX_LENGTH);
+                                _ux_utility_memory_data_buffer_allocate(UX_SLAVE_REQUEST_DATA_MAX_LENGTH);
 
                 /* Ensure we could allocate memory.  */
                 if (endpoints_pool -> ux_slave_endpoint_transfer_request.ux_slave_transfer_request_data_pointer == UX_NULL)
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_interface_set                      PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,7 +59,10 @@
 /*                                                                        */
 /*    (ux_slave_dcd_function)               DCD dispatch function         */ 
 /*    _ux_device_stack_interface_start      Start interface               */ 
-/*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_endpoint                              */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -82,6 +85,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_interface_set(UCHAR * device_framework, ULONG device_framework_length,
@@ -152,10 +159,8 @@ ULONG                   max_transfer_length, n_trans;
     UX_TRACE_OBJECT_REGISTER(UX_TRACE_DEVICE_OBJECT_TYPE_INTERFACE, interface_ptr, 0, 0, 0)
 
     /* Parse the descriptor in something more readable.  */
-    _ux_utility_descriptor_parse(device_framework,
-                _ux_system_interface_descriptor_structure,
-                UX_INTERFACE_DESCRIPTOR_ENTRIES,
-                (UCHAR *) &interface_ptr -> ux_slave_interface_descriptor);
+    _ux_utility_descriptor_unpack_interface(device_framework,
+                &interface_ptr -> ux_slave_interface_descriptor);
 
 #if !defined(UX_DEVICE_INITIALIZE_FRAMEWORK_SCAN_DISABLE) || UX_MAX_DEVICE_INTERFACES > 1
 
@@ -225,10 +230,8 @@ ULONG                   max_transfer_length, n_trans;
                 return(UX_MEMORY_INSUFFICIENT);
 
             /* Parse the descriptor in something more readable.  */
-            _ux_utility_descriptor_parse(device_framework,
-                            _ux_system_endpoint_descriptor_structure,
-                            UX_ENDPOINT_DESCRIPTOR_ENTRIES,
-                            (UCHAR *) &endpoint -> ux_slave_endpoint_descriptor);
+            _ux_utility_descriptor_unpack_endpoint(device_framework,
+                            &endpoint -> ux_slave_endpoint_descriptor);
 
             /* Now we create a transfer request to accept transfer on this endpoint.  */
             transfer_request =  &endpoint -> ux_slave_endpoint_transfer_request;
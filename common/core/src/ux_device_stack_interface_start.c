@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_interface_start                    PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,6 +53,9 @@
 /*                                                                        */
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_utility_memory_profiler_owner_set Set memory owner              */ 
+/*    _ux_utility_memory_profiler_owner_restore                           */ 
+/*                                          Restore memory owner          */ 
 /*    (ux_slave_class_entry_function)       Device class entry function   */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -71,6 +74,11 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            tagged class memory in      */
+/*                                            profiler,                   */
+/*                                            added trace ring events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_interface_start(UX_SLAVE_INTERFACE *interface_ptr)
@@ -80,6 +88,9 @@ UX_SLAVE_DEVICE             *device;
 UX_SLAVE_CLASS              *class_ptr;
 UINT                        status;
 UX_SLAVE_CLASS_COMMAND      class_command;
+#if defined(UX_ENABLE_MEMORY_PROFILER)
+UX_MEMORY_PROFILER_OWNER    previous_owner;
+#endif
 
 
     /* Get the class for the interface.  */
@@ -119,8 +130,17 @@ UX_SLAVE_CLASS_COMMAND      class_command;
         /* Store the command.  */
         class_command.ux_slave_class_command_request =  UX_SLAVE_CLASS_COMMAND_ACTIVATE;
         
-        /* Activate the class.  */
+        /* Activate the class, its allocations are tagged with the class and
+           interface in profiler.  */
+        UX_MEMORY_PROFILER_OWNER_SET(class_ptr -> ux_slave_class_name,
+                                     interface_ptr -> ux_slave_interface_descriptor.bInterfaceNumber,
+                                     &previous_owner);
         status = class_ptr -> ux_slave_class_entry_function(&class_command);
+        UX_MEMORY_PROFILER_OWNER_RESTORE(&previous_owner);
+
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_CLASS_ACTIVATE, interface_ptr -> ux_slave_interface_descriptor.bInterfaceNumber,
+                             interface_ptr -> ux_slave_interface_descriptor.bInterfaceClass, status)
 
         /* If the class was successfully activated, set the class for the interface.  */
         if(status == UX_SUCCESS)
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_transfer_request                   PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -78,6 +78,12 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            maintenance,                */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_transfer_request(UX_SLAVE_TRANSFER *transfer_request, 
@@ -193,9 +199,30 @@ ULONG                   device_state;
     transfer_request -> ux_slave_transfer_request_current_data_pointer =  
                             transfer_request -> ux_slave_transfer_request_data_pointer;
 
+    /* Write back the data buffer before the controller accesses it.  */
+    UX_SLAVE_TRANSFER_DATA_CACHE_CLEAN(transfer_request);
+
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_TRANSFER_SUBMIT, endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress,
+                         slave_length, host_length)
+
+    /* Count the transfer submission in the endpoint statistics.  */
+    UX_SLAVE_TRANSFER_STATISTICS_SUBMIT(transfer_request);
+
     /* Call the DCD driver transfer function.   */
     status =  dcd -> ux_slave_dcd_function(dcd, UX_DCD_TRANSFER_REQUEST, transfer_request);
 
+    /* The transfer is done, discard cached lines of the data received.  */
+    UX_SLAVE_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
+
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_TRANSFER_COMPLETE, endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress,
+                         transfer_request -> ux_slave_transfer_request_completion_code,
+                         transfer_request -> ux_slave_transfer_request_actual_length)
+
+    /* Count the transfer completion in the endpoint statistics.  */
+    UX_SLAVE_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
     /* And return the status.  */
     return(status);
 
@@ -38,7 +38,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_transfer_run                       PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -79,6 +79,12 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  01-31-2022     Chaoqiong Xiao           Initial Version 6.1.10        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            maintenance,                */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_transfer_run(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length)
@@ -168,6 +174,9 @@ ULONG                   device_state;
         transfer_request -> ux_slave_transfer_request_current_data_pointer =
                                 transfer_request -> ux_slave_transfer_request_data_pointer;
 
+        /* Write back the data buffer before the controller accesses it.  */
+        UX_SLAVE_TRANSFER_DATA_CACHE_CLEAN(transfer_request);
+
         /* Set the transfer to pending.  */
         transfer_request -> ux_slave_transfer_request_status = UX_TRANSFER_STATUS_PENDING;
 
@@ -177,6 +186,13 @@ ULONG                   device_state;
         /* If trace is enabled, insert this event into the trace buffer.  */
         UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_STACK_TRANSFER_REQUEST, transfer_request, 0, 0, 0, UX_TRACE_DEVICE_STACK_EVENTS, 0, 0)
 
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_TRANSFER_SUBMIT, endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress,
+                             slave_length, host_length)
+
+        /* Count the transfer submission in the endpoint statistics.  */
+        UX_SLAVE_TRANSFER_STATISTICS_SUBMIT(transfer_request);
+
         /* Fall through.  */
     case UX_DEVICE_STACK_TRANSFER_STATE_HALT_WAIT:
 
@@ -204,7 +220,18 @@ ULONG                   device_state;
         /* Any error case or normal end: reset state for next transfer.  */
         if (status < UX_STATE_WAIT)
         {
+
+            /* The transfer is done, discard cached lines of the data received.  */
+            UX_SLAVE_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
             UX_SLAVE_TRANSFER_STATE_RESET(transfer_request);
+
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_INSERT(UX_TRACE_RING_DEVICE_TRANSFER_COMPLETE, endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress,
+                                 transfer_request -> ux_slave_transfer_request_completion_code,
+                                 transfer_request -> ux_slave_transfer_request_actual_length)
+
+            /* Count the transfer completion in the endpoint statistics.  */
+            UX_SLAVE_TRANSFER_STATISTICS_COMPLETE(transfer_request);
         }
         break;
 
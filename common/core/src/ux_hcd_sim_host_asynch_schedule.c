@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_asynch_schedule                    PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,6 +53,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_transaction_schedule Schedule simulator transaction*/ 
+/*    _ux_hcd_sim_host_schedule_signal      Signal simulator scheduler    */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -65,6 +66,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven mode,    */
+/*                                            added bus timing model,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_sim_host_asynch_schedule(UX_HCD_SIM_HOST *hcd_sim_host)
@@ -73,6 +78,12 @@ VOID  _ux_hcd_sim_host_asynch_schedule(UX_HCD_SIM_HOST *hcd_sim_host)
 UX_HCD_SIM_HOST_ED      *ed;
 UX_HCD_SIM_HOST_ED      *first_ed;
 UINT                    status;
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+UINT                    scheduled =  UX_FALSE;
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL)
+ULONG                   frame_number;
+#endif
+#endif
                         
 
     /* Get the pointer to the current ED in the asynchronous list.  */
@@ -100,6 +111,11 @@ UINT                    status;
         if (ed -> ux_sim_host_ed_tail_td != ed -> ux_sim_host_ed_head_td)
         {
 
+            /* With bus timing, the frame may be full. Scheduling resumes from
+               this ED on next frame.  */
+            if (UX_HCD_SIM_HOST_TIMING_BUDGET_GET(hcd_sim_host, UX_FALSE) == 0)
+                break;
+
             /* Schedule this transaction with the device simulator.  */
             status =  _ux_hcd_sim_host_transaction_schedule(hcd_sim_host, ed);
 
@@ -109,6 +125,9 @@ UINT                    status;
             if (status == UX_SUCCESS)
             {
 
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+                scheduled =  UX_TRUE;
+#endif
                 if (ed -> ux_sim_host_ed_next_ed == UX_NULL)
                     hcd_sim_host -> ux_hcd_sim_host_asynch_current_ed =  hcd_sim_host -> ux_hcd_sim_host_asynch_head_ed;
                 else            
@@ -123,5 +142,25 @@ UINT                    status;
             ed =  ed -> ux_sim_host_ed_next_ed;
 
     } while ((ed) && (ed != first_ed));
+
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+
+    /* Transactions are moved one at a time, run again while they progress.  */
+    if (scheduled)
+        _ux_hcd_sim_host_schedule_signal(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL)
+
+    /* Nothing moves until bus time passes, go to next frame if still in this one.  */
+    else if (hcd_sim_host -> ux_hcd_sim_host_timing_waiting)
+    {
+        _ux_hcd_sim_host_frame_number_get(hcd_sim_host, &frame_number);
+        if (frame_number == hcd_sim_host -> ux_hcd_sim_host_timing_frame_number)
+        {
+            hcd_sim_host -> ux_hcd_sim_host_frame_number =  frame_number + 1;
+            _ux_hcd_sim_host_schedule_signal(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+        }
+    }
+#endif
+#endif
 }
 
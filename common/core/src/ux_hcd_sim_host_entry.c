@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_entry                              PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -90,6 +90,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added bus timing model,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_entry(UX_HCD *hcd, UINT function, VOID *parameter)
@@ -263,6 +266,11 @@ UX_HCD_SIM_HOST     *hcd_sim_host;
 
     case UX_HCD_PROCESS_DONE_QUEUE:
 
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+
+        /* Move the bus time to the current frame.  */
+        _ux_hcd_sim_host_timing_frame_update(hcd_sim_host);
+#endif
         _ux_hcd_sim_host_iso_queue_process(hcd_sim_host);
         _ux_hcd_sim_host_asynch_queue_process(hcd_sim_host);
         _ux_hcd_sim_host_iso_schedule(hcd_sim_host);
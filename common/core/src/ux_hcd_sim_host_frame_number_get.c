@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_frame_number_get                   PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,13 +67,23 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven mode,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_frame_number_get(UX_HCD_SIM_HOST *hcd_sim_host, ULONG *frame_number)
 {
 
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+
+    /* Pickup the virtual frame number, it advances when periodic endpoints are served.  */
+    *frame_number =  hcd_sim_host -> ux_hcd_sim_host_frame_number;
+#else
+
     /* Pickup the frame number.  */
     *frame_number =  hcd_sim_host -> ux_hcd_sim_host_interrupt_count;
+#endif
     return(UX_SUCCESS);
 }
 
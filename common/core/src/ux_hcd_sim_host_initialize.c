@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_sim_host_initialize                         PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,8 @@
 /*    _ux_hcd_sim_host_periodic_tree_create Create periodic tree          */
 /*    _ux_utility_memory_allocate           Allocate memory block         */
 /*    _ux_utility_semaphore_put             Semaphore put                 */
+/*    _ux_utility_mutex_create              Create mutex                  */
+/*    _ux_utility_mutex_delete              Delete mutex                  */
 /*    _ux_utility_timer_create              Create timer                  */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -83,6 +85,9 @@
 /*  10-31-2023     Yajun Xia                Modified comment(s),          */
 /*                                            refined memory management,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            created TD list mutex,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_initialize(UX_HCD *hcd)
@@ -146,6 +151,14 @@ UINT                status = UX_ERROR;
             status = UX_MEMORY_INSUFFICIENT;
     }
 
+    /* Create the mutex protecting the TD list.  */
+    if (status == UX_SUCCESS)
+    {
+        status =  _ux_host_mutex_create(&hcd_sim_host -> ux_hcd_sim_host_td_mutex, "ux_hcd_sim_host_td_mutex");
+        if (status != UX_SUCCESS)
+            status = UX_MUTEX_ERROR;
+    }
+
     /* Initialize the periodic tree.  */
     if (status == UX_SUCCESS)
         status =  _ux_hcd_sim_host_periodic_tree_create(hcd_sim_host);
@@ -179,6 +192,10 @@ UINT                status = UX_ERROR;
         /* The last resource, timer is not created or created error,
          * no need to delete.  */
 
+#if !defined(UX_HOST_STANDALONE)
+        if (hcd_sim_host -> ux_hcd_sim_host_td_mutex.tx_mutex_id != 0)
+            _ux_host_mutex_delete(&hcd_sim_host -> ux_hcd_sim_host_td_mutex);
+#endif
         if (hcd_sim_host -> ux_hcd_sim_host_iso_td_list)
             _ux_utility_memory_free(hcd_sim_host -> ux_hcd_sim_host_iso_td_list);
         if (hcd_sim_host -> ux_hcd_sim_host_td_list)
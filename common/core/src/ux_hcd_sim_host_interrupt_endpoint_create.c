@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_interrupt_endpoint_create          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -87,6 +87,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used bandwidth map list,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_interrupt_endpoint_create(UX_HCD_SIM_HOST *hcd_sim_host, UX_ENDPOINT *endpoint)
@@ -126,8 +129,15 @@ UINT                    interval_sim_host;
     ed -> ux_sim_host_ed_tail_td =  td;
     ed -> ux_sim_host_ed_head_td =  td;
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+    /* Get the list of the frame the host stack placed the endpoint in.  */
+    ed_list =  hcd_sim_host -> ux_hcd_sim_host_interrupt_ed_list[UX_BANDWIDTH_MAP_FRAME(endpoint)];
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list =  _ux_hcd_sim_host_least_traffic_list_get(hcd_sim_host);
+#endif
     
     /* Get the interval for the endpoint and match it to a host simulator list. We match anything 
        that is > 32ms to the 32ms interval list, the 32ms list is list 0, 16ms list is 1...
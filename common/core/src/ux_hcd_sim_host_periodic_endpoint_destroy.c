@@ -66,6 +66,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            fixed isochronous list head */
+/*                                            removal,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_periodic_endpoint_destroy(UX_HCD_SIM_HOST *hcd_sim_host, UX_ENDPOINT *endpoint)
@@ -90,6 +94,10 @@ UX_HCD_SIM_HOST_TD      *td;
     if (previous_ed)
         previous_ed -> ux_sim_host_ed_next_ed =  next_ed;
 
+    /* The isochronous list has no static head ED, move the head if it is removed.  */
+    else if (hcd_sim_host -> ux_hcd_sim_host_iso_head_ed == ed)
+        hcd_sim_host -> ux_hcd_sim_host_iso_head_ed =  next_ed;
+
     /* Update the previous ED pointer in the next ED.  */
     if (next_ed)
         next_ed -> ux_sim_host_ed_previous_ed =  previous_ed;
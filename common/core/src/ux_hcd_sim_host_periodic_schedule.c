@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_periodic_schedule                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -43,6 +43,10 @@
 /*     This function schedules new transfers from the periodic interrupt  */ 
 /*     list.                                                              */ 
 /*                                                                        */ 
+/*     In event driven mode the frame number is virtual: frames with no   */
+/*     transaction accepted by the device are skipped, the frame number   */
+/*     advances past the first frame served.                              */
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    hcd_sim_host                          Pointer to host controller    */ 
@@ -55,6 +59,7 @@
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_frame_number_get     Get frame number              */ 
 /*    _ux_hcd_sim_host_transaction_schedule Schedule the transaction      */
+/*    _ux_hcd_sim_host_schedule_signal      Signal simulator scheduler    */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -67,6 +72,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven mode,    */
+/*                                            added bus timing model,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_sim_host_periodic_schedule(UX_HCD_SIM_HOST *hcd_sim_host)
@@ -74,10 +83,79 @@ VOID  _ux_hcd_sim_host_periodic_schedule(UX_HCD_SIM_HOST *hcd_sim_host)
 
 UX_HCD_SIM_HOST_ED      *ed;
 ULONG                   frame_number;
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+ULONG                   frame_index;
+UINT                    scheduled;
+UINT                    status;
+#endif
 
     /* Get the current frame number.  */
     _ux_hcd_sim_host_frame_number_get(hcd_sim_host, &frame_number);
-    
+
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+
+    /* Scan the frames from the current one, until one has work done.  */
+    for (frame_index = 0; frame_index < UX_HCD_SIM_HOST_PERIODIC_ENTRY_NB; frame_index++)
+    {
+
+        /* Get the first ED in the periodic list of this frame.  */
+        ed =  hcd_sim_host -> ux_hcd_sim_host_interrupt_ed_list[(frame_number + frame_index) & UX_HCD_SIM_HOST_PERIODIC_ENTRY_MASK];
+        scheduled =  UX_FALSE;
+
+        /* Search for an entry in the periodic tree.  */
+        while (ed != UX_NULL)
+        {
+
+            /* The ED has to be a real ED (not static) and has to have a different tail and head TD.  */
+            if ((ed -> ux_sim_host_ed_status != UX_HCD_SIM_HOST_ED_STATIC) && (ed -> ux_sim_host_ed_tail_td != ed -> ux_sim_host_ed_head_td))
+            {
+
+                /* Ensure this ED does not have the SKIP bit set and no TD are in progress. */
+                if ((ed -> ux_sim_host_ed_head_td -> ux_sim_host_td_status & UX_HCD_SIM_HOST_TD_ACK_PENDING) == 0)
+                {
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL)
+
+                    /* With bus timing, a later frame has to be the current one before its bus time is used.  */
+                    if ((frame_index != 0) && (hcd_sim_host -> ux_hcd_sim_host_timing.ux_hcd_sim_host_timing_frame_period != 0))
+                    {
+                        hcd_sim_host -> ux_hcd_sim_host_frame_number =  frame_number + frame_index;
+                        _ux_hcd_sim_host_schedule_signal(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+                        return;
+                    }
+
+                    /* The periodic part of the frame is used, this ED misses its frame.  */
+                    if (_ux_hcd_sim_host_timing_budget_get(hcd_sim_host, UX_TRUE) == 0)
+                    {
+                        ed =  ed -> ux_sim_host_ed_next_ed;
+                        continue;
+                    }
+#endif
+
+                    /* Insert this transfer in the list of scheduled TDs if possible.  */
+                    status =  _ux_hcd_sim_host_transaction_schedule(hcd_sim_host, ed);
+                    if (status == UX_SUCCESS)
+                        scheduled =  UX_TRUE;
+                }
+            }
+
+            /* Point to the next ED in the list.  */
+            ed =  ed -> ux_sim_host_ed_next_ed;
+        }
+
+        /* The frame is served, the next scan starts after it and is done now.  */
+        if (scheduled)
+        {
+            hcd_sim_host -> ux_hcd_sim_host_frame_number =  frame_number + frame_index + 1;
+            _ux_hcd_sim_host_schedule_signal(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+            return;
+        }
+    }
+
+    /* Nothing to be done, the frame number does not move.  */
+    return;
+#else
+
     /* Isolate the low bits to match an entry in the upper periodic entry list.  */
     frame_number &=  UX_HCD_SIM_HOST_PERIODIC_ENTRY_MASK;
 
@@ -92,8 +170,10 @@ ULONG                   frame_number;
         if ((ed -> ux_sim_host_ed_status != UX_HCD_SIM_HOST_ED_STATIC) && (ed -> ux_sim_host_ed_tail_td != ed -> ux_sim_host_ed_head_td))
         {
 
-            /* Ensure this ED does not have the SKIP bit set and no TD are in progress. */
-            if ((ed -> ux_sim_host_ed_head_td -> ux_sim_host_td_status & UX_HCD_SIM_HOST_TD_ACK_PENDING) == 0)
+            /* Ensure this ED does not have the SKIP bit set and no TD are in progress,
+               the periodic part of the frame must have bus time left.  */
+            if (((ed -> ux_sim_host_ed_head_td -> ux_sim_host_td_status & UX_HCD_SIM_HOST_TD_ACK_PENDING) == 0) &&
+                (UX_HCD_SIM_HOST_TIMING_BUDGET_GET(hcd_sim_host, UX_TRUE) != 0))
 
                 /* Insert this transfer in the list of scheduled TDs if possible.  */
                 _ux_hcd_sim_host_transaction_schedule(hcd_sim_host, ed);
@@ -106,5 +186,6 @@ ULONG                   frame_number;
 
     /* Return to caller.  */
     return;
+#endif
 }
 
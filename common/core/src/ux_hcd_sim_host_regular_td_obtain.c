@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_regular_td_obtain                  PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,7 +53,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_set                Set memory block              */ 
-/*    _ux_utility_mutex_on                  Get mutex protection          */ 
+/*    _ux_utility_mutex_on_count            Get mutex protection          */ 
 /*    _ux_utility_mutex_off                 Release mutex protection      */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -72,6 +72,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used TD list mutex,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_HCD_SIM_HOST_TD  *_ux_hcd_sim_host_regular_td_obtain(UX_HCD_SIM_HOST *hcd_sim_host)
@@ -81,8 +84,8 @@ UX_HCD_SIM_HOST_TD      *td;
 ULONG                   td_index;
 
 
-    /* Get the mutex as this is a critical section.  */
-    _ux_host_mutex_on(&_ux_system -> ux_system_mutex);
+    /* Get the TD list mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_sim_host -> ux_hcd_sim_host_td_mutex, &hcd_sim_host -> ux_hcd_sim_host_td_mutex_contentions);
 
     /* Start the search from the beginning of the list.  */
     td =  hcd_sim_host -> ux_hcd_sim_host_td_list;
@@ -101,7 +104,7 @@ ULONG                   td_index;
             td -> ux_sim_host_td_status =  UX_USED;
 
             /* Release the mutex protection.  */
-            _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
+            _ux_host_mutex_off(&hcd_sim_host -> ux_hcd_sim_host_td_mutex);
 
             /* Return the TD pointer.  */
             return(td);
@@ -114,7 +117,7 @@ ULONG                   td_index;
     /* There is no available TD in the TD list. */
 
     /* Release the mutex protection.  */
-    _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_host_mutex_off(&hcd_sim_host -> ux_hcd_sim_host_td_mutex);
 
     /* Return a NULL pointer.  */
     return(UX_NULL);
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_request_bulk_transfer              PORTABLE C      */ 
-/*                                                           6.1.3        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -73,6 +73,11 @@
 /*  12-31-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed ZLP sending,          */
 /*                                            resulting in version 6.1.3  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven mode,    */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_request_bulk_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request)
@@ -88,6 +93,10 @@ UX_HCD_SIM_HOST_ED      *ed;
 ULONG                   transfer_request_payload_length;
 ULONG                   bulk_packet_payload_length;
 UCHAR *                 data_pointer;
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+UX_TRANSFER_SEGMENT     *segment;
+ULONG                   segment_count;
+#endif
     
 
     /* Get the pointer to the Endpoint.  */
@@ -110,6 +119,15 @@ UCHAR *                 data_pointer;
        in the endpoint descriptor). Host simulator data payload has a maximum size of 4K.  */
     transfer_request_payload_length =  transfer_request -> ux_transfer_request_requested_length;
     data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+    /* A scatter-gather transfer starts with its first segment.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_count =  transfer_request -> ux_transfer_request_segment_count;
+    if (segment_count != 0)
+        transfer_request_payload_length =  segment -> ux_transfer_segment_length;
+#endif
     
     do
     {
@@ -135,6 +153,18 @@ UCHAR *                 data_pointer;
         transfer_request_payload_length -=  bulk_packet_payload_length;
         data_pointer +=  bulk_packet_payload_length;
 
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+        /* At the end of a segment, go on with the next one.  */
+        if ((transfer_request_payload_length == 0) && (segment_count > 1))
+        {
+            segment++;
+            segment_count--;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            transfer_request_payload_length =  segment -> ux_transfer_segment_length;
+        }
+#endif
+
         /* The direction of the transaction is set in the TD.  */
         if ((transfer_request -> ux_transfer_request_type & UX_REQUEST_DIRECTION) == UX_REQUEST_IN)
 
@@ -217,6 +247,9 @@ UCHAR *                 data_pointer;
     /* Now we can tell the scheduler to wake up.  */
     hcd_sim_host -> ux_hcd_sim_host_queue_empty =  UX_FALSE;
 
+    /* In event driven mode, kick the simulator now.  */
+    UX_HCD_SIM_HOST_SCHEDULE_SIGNAL(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+
     /* Return successful completion.  */
     return(UX_SUCCESS);           
 }
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_request_control_transfer           PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,8 +59,6 @@
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_regular_td_obtain    Obtain regular TD             */ 
 /*    _ux_host_stack_transfer_request_abort Abort transfer request        */ 
-/*    _ux_utility_memory_allocate           Allocate memory block         */ 
-/*    _ux_utility_memory_free               Release memory block          */ 
 /*    _ux_utility_semaphore_get             Get semaphore                 */ 
 /*    _ux_utility_short_put                 Write 16-bit value            */ 
 /*                                                                        */ 
@@ -79,6 +77,13 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used setup buffer in ED     */
+/*                                            instead of allocating,      */
+/*                                            counted timeouts in         */
+/*                                            endpoint statistics,        */
+/*                                            added event driven mode,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_request_control_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request)
@@ -108,11 +113,9 @@ UINT                    status;
     /* Now get the physical ED attached to this endpoint.  */
     ed =  endpoint -> ux_endpoint_ed;
 
-    /* Build the SETUP packet (phase 1 of the control transfer).  */
-    setup_request =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_SETUP_SIZE);
-    if (setup_request == UX_NULL)
-        return(UX_MEMORY_INSUFFICIENT);
-
+    /* Build the SETUP packet (phase 1 of the control transfer), in the ED buffer
+       since there is only one control transfer on the endpoint at a time.  */
+    setup_request =  ed -> ux_sim_host_ed_setup;
     *setup_request =                            (UCHAR)transfer_request -> ux_transfer_request_function;
     *(setup_request + UX_SETUP_REQUEST_TYPE) =  (UCHAR)transfer_request -> ux_transfer_request_type;
     *(setup_request + UX_SETUP_REQUEST) =       (UCHAR)transfer_request -> ux_transfer_request_function;
@@ -159,9 +162,6 @@ UINT                    status;
         if (data_td == UX_NULL)
         {
 
-            /* Free the Setup packet resources.  */
-            _ux_utility_memory_free(setup_request);
-
             /* If there was already a TD chain in progress, free it.  */
             if (start_data_td != UX_NULL)
             {
@@ -231,7 +231,6 @@ UINT                    status;
     if (status_td == UX_NULL)
     {
 
-        _ux_utility_memory_free(setup_request);
         if (data_td != UX_NULL)
         {
 
@@ -280,7 +279,6 @@ UINT                    status;
     if (tail_td == UX_NULL)
     {
 
-        _ux_utility_memory_free(setup_request);
         if (data_td != UX_NULL)
             data_td -> ux_sim_host_td_status =  UX_UNUSED;
         status_td -> ux_sim_host_td_status =  UX_UNUSED;
@@ -298,6 +296,9 @@ UINT                    status;
     /* Now we can tell the scheduler to wake up.  */
     hcd_sim_host -> ux_hcd_sim_host_queue_empty =  UX_FALSE;
 
+    /* In event driven mode, kick the simulator now.  */
+    UX_HCD_SIM_HOST_SCHEDULE_SIGNAL(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+
 #if defined(UX_HOST_STANDALONE)
     /* Transfer started in background, fine.  */
     return(UX_SUCCESS);
@@ -314,6 +315,7 @@ UINT                    status;
         
         /* There was an error, return to the caller.  */
         transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+        UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
         
         /* Error trap. */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_TRANSFER_TIMEOUT);
@@ -323,9 +325,6 @@ UINT                    status;
         
     }            
 
-    /* Free the resources.  */
-    _ux_utility_memory_free(setup_request);
-
     /* Return completion to caller.  */
     return(transfer_request -> ux_transfer_request_completion_code);           
 #endif
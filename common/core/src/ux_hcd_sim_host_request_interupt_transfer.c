@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_sim_host_request_interrupt_transfer         PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -69,6 +69,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added event driven mode,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_request_interrupt_transfer(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request)
@@ -130,7 +133,10 @@ UX_HCD_SIM_HOST_TD      *tail_td;
 
     /* There is no need to wake up the sim_host controller on this transfer
        since periodic transactions will be picked up when the interrupt
-       tree is scanned.  */
+       tree is scanned. In event driven mode the tree is scanned on events,
+       so kick the simulator now.  */
+    UX_HCD_SIM_HOST_SCHEDULE_SIGNAL(hcd_sim_host -> ux_hcd_sim_host_hcd_owner);
+
     return(UX_SUCCESS);           
 }
 
@@ -0,0 +1,95 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_EVENT_DRIVEN) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_schedule_signal                    PORTABLE C      */ 
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*     This function wakes up the HCD thread to run the simulator         */
+/*     schedulers without waiting for the next timer tick. It is invoked  */
+/*     when a transfer is queued on either side of the simulated bus and  */
+/*     while the schedulers make progress.                                */
+/*                                                                        */
+/*     It's for RTOS mode with UX_HCD_SIM_HOST_EVENT_DRIVEN.              */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to HCD                */ 
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */ 
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_host_semaphore_put                Put semaphore                 */ 
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Simulator Controller Driver                                    */
+/*    Slave Simulator Controller Driver                                   */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_sim_host_schedule_signal(UX_HCD *hcd)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* The device simulator may run without host.  */
+    if (hcd == UX_NULL)
+        return;
+
+    /* Check if the controller is operational, if not, the timer does the job.  */
+    if (hcd -> ux_hcd_status != UX_HCD_STATUS_OPERATIONAL)
+        return;
+
+    /* Wake up the thread for the controller transaction processing.  */
+    UX_DISABLE
+    hcd -> ux_hcd_thread_signal++;
+    UX_RESTORE
+    _ux_host_semaphore_put(&_ux_system_host -> ux_system_host_hcd_semaphore);
+}
+#endif
@@ -0,0 +1,113 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_budget_get                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function returns the bus time left in the current frame, for   */
+/*    periodic transactions it's limited to the periodic part of the      */
+/*    frame. When there is no time left, the transaction is deferred to   */
+/*    the next frame and the simulator waits for bus time to pass.        */
+/*                                                                        */
+/*    Without model, the budget is unlimited.                             */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*    periodic                              Budget of periodic transfers  */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Bus time left, in ns                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Simulator Controller Driver                                    */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_sim_host_timing_budget_get(UX_HCD_SIM_HOST *hcd_sim_host, UINT periodic)
+{
+
+UX_HCD_SIM_HOST_TIMING  *timing;
+ULONG                   frame_time;
+ULONG                   budget;
+ULONG                   periodic_budget;
+
+
+    /* Without model, the bus is never full.  */
+    timing =  &hcd_sim_host -> ux_hcd_sim_host_timing;
+    if (timing -> ux_hcd_sim_host_timing_frame_period == 0)
+        return(0xFFFFFFFFu);
+
+    /* Get the time left in the frame.  */
+    frame_time =  hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_frame_time;
+    budget =  (frame_time < timing -> ux_hcd_sim_host_timing_frame_period) ?
+                    timing -> ux_hcd_sim_host_timing_frame_period - frame_time : 0;
+
+    /* Periodic transactions are limited to a part of the frame.  */
+    if (periodic)
+    {
+        periodic_budget =  timing -> ux_hcd_sim_host_timing_frame_period / 100 * timing -> ux_hcd_sim_host_timing_periodic_limit;
+        periodic_budget =  (hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time < periodic_budget) ?
+                                periodic_budget - hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time : 0;
+        budget =  UX_MIN(budget, periodic_budget);
+    }
+
+    /* The transaction waits for next frame.  */
+    if (budget == 0)
+    {
+        hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_deferred++;
+        hcd_sim_host -> ux_hcd_sim_host_timing_waiting =  UX_TRUE;
+    }
+
+    /* Return the bus time left.  */
+    return(budget);
+}
+#endif
@@ -0,0 +1,106 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_device_ready                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function checks if the device has served its transfer request, */
+/*    the device service latency starts when the request is first seen by */
+/*    the host. Until the latency has elapsed, the transactions are NAKed */
+/*    and the simulator waits for bus time to pass.                       */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_nak           Account NAKs                  */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Simulator Controller Driver                                    */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_sim_host_timing_device_ready(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed)
+{
+
+UX_HCD_SIM_HOST_TIMING  *timing;
+ULONG                   bus_time;
+
+
+    /* Without model or latency, the device is ready.  */
+    timing =  &hcd_sim_host -> ux_hcd_sim_host_timing;
+    if ((timing -> ux_hcd_sim_host_timing_frame_period == 0) ||
+        (timing -> ux_hcd_sim_host_timing_device_latency == 0))
+        return(UX_SUCCESS);
+
+    /* Get the current bus time.  */
+    bus_time =  hcd_sim_host -> ux_hcd_sim_host_timing_frame_start +
+                hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_frame_time;
+
+    /* The latency starts with a new device request.  */
+    if (ed -> ux_sim_host_ed_timing_armed == UX_FALSE)
+    {
+        ed -> ux_sim_host_ed_timing_armed =  UX_TRUE;
+        ed -> ux_sim_host_ed_timing_ready_time =  bus_time + timing -> ux_hcd_sim_host_timing_device_latency;
+    }
+
+    /* Check if the latency has elapsed, bus time may wrap.  */
+    if ((SLONG)(bus_time - ed -> ux_sim_host_ed_timing_ready_time) >= 0)
+        return(UX_SUCCESS);
+
+    /* The device NAKs until then.  */
+    hcd_sim_host -> ux_hcd_sim_host_timing_waiting =  UX_TRUE;
+    _ux_hcd_sim_host_timing_nak(hcd_sim_host, ed);
+    return(UX_ERROR);
+}
+#endif
@@ -0,0 +1,133 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_frame_update                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function moves the bus time of the timing model to the current */
+/*    frame number. Each frame elapsed frees the bus time of a frame, a   */
+/*    transaction that overran its frame takes time from the next one.    */
+/*                                                                        */
+/*    It's invoked each time the simulator schedulers run.                */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_frame_number_get     Get frame number              */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Simulator Controller Driver                                    */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_sim_host_timing_frame_update(UX_HCD_SIM_HOST *hcd_sim_host)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG                   frame_number;
+ULONG                   frames;
+ULONG                   frame_period;
+UX_HCD_SIM_HOST_TIMING_STATISTICS
+                        *statistics;
+
+
+    /* Nothing to do if the model is disabled.  */
+    frame_period =  hcd_sim_host -> ux_hcd_sim_host_timing.ux_hcd_sim_host_timing_frame_period;
+    if (frame_period == 0)
+        return;
+
+    /* Nothing waits for bus time until the schedulers say so.  */
+    hcd_sim_host -> ux_hcd_sim_host_timing_waiting =  UX_FALSE;
+
+    /* Get the number of frames elapsed.  */
+    _ux_hcd_sim_host_frame_number_get(hcd_sim_host, &frame_number);
+    frames =  frame_number - hcd_sim_host -> ux_hcd_sim_host_timing_frame_number;
+    if (frames == 0)
+        return;
+
+    statistics =  &hcd_sim_host -> ux_hcd_sim_host_timing_statistics;
+
+    UX_DISABLE
+
+    hcd_sim_host -> ux_hcd_sim_host_timing_frame_number =  frame_number;
+    statistics -> ux_hcd_sim_host_timing_frames +=  frames;
+
+    /* Keep the periodic peak of the frame that ended.  */
+    if (hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time > statistics -> ux_hcd_sim_host_timing_periodic_time_max)
+        statistics -> ux_hcd_sim_host_timing_periodic_time_max =  hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time;
+    hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time =  0;
+
+    /* Move to the frames elapsed.  */
+    while (frames != 0)
+    {
+
+        hcd_sim_host -> ux_hcd_sim_host_timing_frame_start +=  frame_period;
+        frames--;
+
+        /* Bus time used over the frame is taken from the next one.  */
+        if (statistics -> ux_hcd_sim_host_timing_frame_time > frame_period)
+            statistics -> ux_hcd_sim_host_timing_frame_time -=  frame_period;
+        else
+        {
+
+            /* The bus is idle for the remaining frames.  */
+            statistics -> ux_hcd_sim_host_timing_frame_time =  0;
+            hcd_sim_host -> ux_hcd_sim_host_timing_frame_start +=  frames * frame_period;
+            break;
+        }
+    }
+
+    UX_RESTORE
+}
+#endif
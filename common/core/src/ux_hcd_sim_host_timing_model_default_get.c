@@ -0,0 +1,103 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_model_default_get           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function fills the default bus timing model parameters for     */
+/*    a bus speed: full speed frames or high speed microframes, with the  */
+/*    protocol overhead of the USB 2.0 specification, one NAK retry per   */
+/*    frame and no device service latency.                                */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    speed                                 Bus speed                     */
+/*    timing                                Pointer to model parameters   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Application                                                         */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_sim_host_timing_model_default_get(ULONG speed, UX_HCD_SIM_HOST_TIMING *timing)
+{
+
+    /* Set the parameters depending on the speed.  */
+    if (speed == UX_HIGH_SPEED_DEVICE)
+    {
+
+        /* High speed transactions run in 125us microframes.  */
+        timing -> ux_hcd_sim_host_timing_frame_period =  UX_HCD_SIM_HOST_TIMING_HS_FRAME_PERIOD;
+        timing -> ux_hcd_sim_host_timing_bit_time =  UX_HCD_SIM_HOST_TIMING_HS_BIT_TIME;
+        timing -> ux_hcd_sim_host_timing_periodic_limit =  UX_HCD_SIM_HOST_TIMING_HS_PERIODIC_LIMIT;
+        timing -> ux_hcd_sim_host_timing_transaction_overhead =  UX_HCD_SIM_HOST_TIMING_HS_TRANSACTION_OVERHEAD;
+        timing -> ux_hcd_sim_host_timing_handshake_overhead =  UX_HCD_SIM_HOST_TIMING_HS_HANDSHAKE_OVERHEAD;
+    }
+    else
+    {
+
+        /* Full and low speed transactions run in 1ms frames.  */
+        timing -> ux_hcd_sim_host_timing_frame_period =  UX_HCD_SIM_HOST_TIMING_FS_FRAME_PERIOD;
+        timing -> ux_hcd_sim_host_timing_bit_time =  (speed == UX_LOW_SPEED_DEVICE) ?
+                                                        UX_HCD_SIM_HOST_TIMING_LS_BIT_TIME : UX_HCD_SIM_HOST_TIMING_FS_BIT_TIME;
+        timing -> ux_hcd_sim_host_timing_periodic_limit =  UX_HCD_SIM_HOST_TIMING_FS_PERIODIC_LIMIT;
+        timing -> ux_hcd_sim_host_timing_transaction_overhead =  UX_HCD_SIM_HOST_TIMING_FS_TRANSACTION_OVERHEAD;
+        timing -> ux_hcd_sim_host_timing_handshake_overhead =  UX_HCD_SIM_HOST_TIMING_FS_HANDSHAKE_OVERHEAD;
+    }
+
+    /* The device answers immediately.  */
+    timing -> ux_hcd_sim_host_timing_nak_retries =  UX_HCD_SIM_HOST_TIMING_NAK_RETRIES;
+    timing -> ux_hcd_sim_host_timing_device_latency =  0;
+}
+#endif
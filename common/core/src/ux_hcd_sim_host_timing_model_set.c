@@ -0,0 +1,112 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_model_set                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function sets the bus timing model of the simulator and        */
+/*    clears its statistics. With a NULL pointer the model is disabled    */
+/*    and transactions complete with no bus time.                         */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*    timing                                Pointer to model parameters   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_frame_number_get     Get frame number              */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Application                                                         */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_sim_host_timing_model_set(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_TIMING *timing)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG                   frame_number;
+
+
+    /* Sanity check the parameters.  */
+    if ((timing != UX_NULL) &&
+        ((timing -> ux_hcd_sim_host_timing_frame_period == 0) ||
+         (timing -> ux_hcd_sim_host_timing_bit_time == 0) ||
+         (timing -> ux_hcd_sim_host_timing_periodic_limit > 100)))
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the current frame number, bus time starts from there.  */
+    _ux_hcd_sim_host_frame_number_get(hcd_sim_host, &frame_number);
+
+    UX_DISABLE
+
+    /* A zero frame period disables the model.  */
+    if (timing == UX_NULL)
+        hcd_sim_host -> ux_hcd_sim_host_timing.ux_hcd_sim_host_timing_frame_period =  0;
+    else
+        _ux_utility_memory_copy(&hcd_sim_host -> ux_hcd_sim_host_timing, timing, sizeof(UX_HCD_SIM_HOST_TIMING)); /* Use case of memcpy is verified. */
+
+    /* Reset the bus time and statistics.  */
+    _ux_utility_memory_set(&hcd_sim_host -> ux_hcd_sim_host_timing_statistics, 0, sizeof(UX_HCD_SIM_HOST_TIMING_STATISTICS)); /* Use case of memset is verified. */
+    hcd_sim_host -> ux_hcd_sim_host_timing_frame_number =  frame_number;
+    hcd_sim_host -> ux_hcd_sim_host_timing_frame_start =  0;
+    hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time =  0;
+    hcd_sim_host -> ux_hcd_sim_host_timing_waiting =  UX_FALSE;
+
+    UX_RESTORE
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
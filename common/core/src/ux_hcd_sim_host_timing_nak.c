@@ -0,0 +1,102 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_nak                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function accounts the bus time of the transactions NAKed by the*/
+/*    device. A bulk or control endpoint is retried the configured number */
+/*    of times per frame, an interrupt endpoint is polled once per frame. */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Simulator Controller Driver                                    */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_sim_host_timing_nak(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed)
+{
+
+UX_HCD_SIM_HOST_TIMING  *timing;
+UX_ENDPOINT             *endpoint;
+ULONG                   retries;
+
+
+    /* Nothing to do if the model is disabled.  */
+    timing =  &hcd_sim_host -> ux_hcd_sim_host_timing;
+    if (timing -> ux_hcd_sim_host_timing_frame_period == 0)
+        return;
+
+    /* NAKs of this endpoint are already accounted in this frame.  */
+    if (ed -> ux_sim_host_ed_timing_nak_frame == hcd_sim_host -> ux_hcd_sim_host_timing_frame_number)
+        return;
+    ed -> ux_sim_host_ed_timing_nak_frame =  hcd_sim_host -> ux_hcd_sim_host_timing_frame_number;
+
+    /* Periodic endpoints are polled once.  */
+    endpoint =  ed -> ux_sim_host_ed_endpoint;
+    if ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_INTERRUPT_ENDPOINT)
+        retries =  1;
+    else
+        retries =  timing -> ux_hcd_sim_host_timing_nak_retries;
+
+    /* Take the time of the token and handshake on the bus.  */
+    hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_frame_time +=
+                retries * (timing -> ux_hcd_sim_host_timing_handshake_overhead * 8 * timing -> ux_hcd_sim_host_timing_bit_time / 1000);
+    hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_naks +=  retries;
+}
+#endif
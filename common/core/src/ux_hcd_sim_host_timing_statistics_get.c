@@ -0,0 +1,97 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_statistics_get              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function returns the statistics of the bus timing model: the   */
+/*    frames and bus time elapsed, the bytes, transactions and NAKs on the*/
+/*    bus, the transactions deferred to the next frame and the highest    */
+/*    periodic time in a frame. The throughput predicted is bytes over    */
+/*    bus time, the periodic headroom is the periodic limit minus the     */
+/*    highest periodic time.                                              */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*    statistics                            Pointer to statistics         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Application                                                         */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_sim_host_timing_statistics_get(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_TIMING_STATISTICS *statistics)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Sanity check.  */
+    if (statistics == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Copy the statistics, consistent with the scheduler.  */
+    UX_DISABLE
+    _ux_utility_memory_copy(statistics, &hcd_sim_host -> ux_hcd_sim_host_timing_statistics, sizeof(UX_HCD_SIM_HOST_TIMING_STATISTICS)); /* Use case of memcpy is verified. */
+
+    /* The frame in progress counts for the periodic peak.  */
+    if (hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time > statistics -> ux_hcd_sim_host_timing_periodic_time_max)
+        statistics -> ux_hcd_sim_host_timing_periodic_time_max =  hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time;
+    UX_RESTORE
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
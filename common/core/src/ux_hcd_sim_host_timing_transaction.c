@@ -0,0 +1,122 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Simulator Controller Driver                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_sim_host.h"
+
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_sim_host_timing_transaction                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function accounts the bus time of a transfer moved by the      */
+/*    simulator: the data is split in max packet size transactions, each  */
+/*    one takes the data and the protocol overhead at the bus bit time.   */
+/*    A zero length transfer takes one transaction.                       */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_sim_host                          Pointer to host controller    */
+/*    ed                                    Pointer to ED                 */
+/*    length                                Data length                   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Simulator Controller Driver                                    */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_sim_host_timing_transaction(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed, ULONG length)
+{
+
+UX_HCD_SIM_HOST_TIMING  *timing;
+UX_ENDPOINT             *endpoint;
+ULONG                   max_packet_size;
+ULONG                   packets;
+ULONG                   last_packet_size;
+ULONG                   bus_time;
+
+
+    /* Nothing to do if the model is disabled.  */
+    timing =  &hcd_sim_host -> ux_hcd_sim_host_timing;
+    if (timing -> ux_hcd_sim_host_timing_frame_period == 0)
+        return;
+
+    /* Get the max packet size, without the high bandwidth bits.  */
+    endpoint =  ed -> ux_sim_host_ed_endpoint;
+    max_packet_size =  endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+
+    /* Split the data in transactions.  */
+    if ((max_packet_size == 0) || (length <= max_packet_size))
+    {
+        packets =  1;
+        last_packet_size =  length;
+    }
+    else
+    {
+        packets =  (length + max_packet_size - 1) / max_packet_size;
+        last_packet_size =  length - (packets - 1) * max_packet_size;
+    }
+
+    /* Bus time of the full packets, then of the last one. Bit time is in ps.  */
+    bus_time =  (packets - 1) * ((max_packet_size + timing -> ux_hcd_sim_host_timing_transaction_overhead) * 8 *
+                                 timing -> ux_hcd_sim_host_timing_bit_time / 1000);
+    bus_time +=  (last_packet_size + timing -> ux_hcd_sim_host_timing_transaction_overhead) * 8 *
+                 timing -> ux_hcd_sim_host_timing_bit_time / 1000;
+
+    /* Take the time on the bus.  */
+    hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_frame_time +=  bus_time;
+    if ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_INTERRUPT_ENDPOINT ||
+        (endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_ISOCHRONOUS_ENDPOINT)
+        hcd_sim_host -> ux_hcd_sim_host_timing_periodic_time +=  bus_time;
+
+    /* Update statistics.  */
+    hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_bytes +=  length;
+    hcd_sim_host -> ux_hcd_sim_host_timing_statistics.ux_hcd_sim_host_timing_transactions +=  packets;
+}
+#endif
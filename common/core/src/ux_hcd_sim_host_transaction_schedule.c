@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_sim_host_transaction_schedule               PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -45,6 +45,10 @@
 /*     This function bridges a transaction from the host to the slave     */
 /*     simulation controller.                                             */
 /*                                                                        */
+/*     With UX_HCD_SIM_HOST_DIRECT_TRANSFER, the data TDs of a bulk or    */
+/*     interrupt transfer are handed over at once with a single copy,     */
+/*     instead of one TD per call.                                        */
+/*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    hcd_sim_host                          Pointer to host controller    */
@@ -95,6 +99,18 @@
 /*                                            adjusted control request    */
 /*                                            data length handling,       */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used setup buffer in ED     */
+/*                                            instead of allocating,      */
+/*                                            added data cache            */
+/*                                            invalidation,               */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            added direct transfer mode, */
+/*                                            added bus timing model,     */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_transaction_schedule(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed)
@@ -109,6 +125,7 @@ UX_ENDPOINT             *endpoint;
 UX_SLAVE_ENDPOINT       *slave_endpoint;
 UX_DCD_SIM_SLAVE_ED     *slave_ed;
 ULONG                   slave_transfer_remaining;
+ULONG                   host_transfer_remaining;
 UCHAR                   wake_host;
 UCHAR                   wake_slave;
 ULONG                   transaction_length;
@@ -159,7 +176,22 @@ UX_SLAVE_DCD            *dcd;
 
     /* Is this ED ready for transaction or stalled ?  */
     if ((slave_ed -> ux_sim_slave_ed_status & (UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER | UX_DCD_SIM_SLAVE_ED_STATUS_STALLED)) == 0)
+    {
+
+        /* The device NAKs, this takes bus time.  */
+        UX_HCD_SIM_HOST_TIMING_NAK(hcd_sim_host, ed);
         return(UX_ERROR);
+    }
+
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+
+    /* With bus timing, the device may take time to serve a data transfer.  */
+    if (((td -> ux_sim_host_td_status & UX_HCD_SIM_HOST_TD_SETUP_PHASE) == 0) &&
+        ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_STALLED) == 0) &&
+        ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) != UX_CONTROL_ENDPOINT) &&
+        (_ux_hcd_sim_host_timing_device_ready(hcd_sim_host, ed) != UX_SUCCESS))
+        return(UX_ERROR);
+#endif
 
     /* Get the logical endpoint from the physical endpoint.  */
     slave_endpoint =  slave_ed -> ux_sim_slave_ed_endpoint;
@@ -189,12 +221,8 @@ UX_SLAVE_DCD            *dcd;
                                 td -> ux_sim_host_td_buffer,
                                 td -> ux_sim_host_td_length); /* Use case of memcpy is verified. */
 
-#if defined(UX_HOST_STANDALONE)
-
-        /* The setup buffer is allocated, release it since it's used.  */
-        _ux_utility_memory_free(td -> ux_sim_host_td_buffer);
-        td -> ux_sim_host_td_buffer = UX_NULL;
-#endif
+        /* The setup transaction takes bus time.  */
+        UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, td -> ux_sim_host_td_length);
 
         /* The setup phase never fails. We acknowledge the transfer code here by taking the TD out of the endpoint.  */
         ed -> ux_sim_host_ed_head_td =  td -> ux_sim_host_td_next_td;
@@ -271,6 +299,9 @@ UX_SLAVE_DCD            *dcd;
 
             /* Make the head TD point to the STATUS TD.  */
             ed -> ux_sim_host_ed_head_td =  ed -> ux_sim_host_ed_head_td -> ux_sim_host_td_next_td;
+
+            /* The data transactions take bus time.  */
+            UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, slave_transfer_request -> ux_slave_transfer_request_actual_length);
         }
 
         /* Is there no hub?  */
@@ -344,12 +375,25 @@ UX_SLAVE_DCD            *dcd;
             /* In this case the transfer is completed! We take out the status TD.  */
             td = ed -> ux_sim_host_ed_head_td;
 
+            /* The status transaction takes bus time.  */
+            UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, 0);
+
             /* Adjust the ED.  */
             ed -> ux_sim_host_ed_head_td =  td -> ux_sim_host_td_next_td;
 
             /* Free the TD that was used here.  */
             td -> ux_sim_host_td_status =  UX_UNUSED;
 
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                        transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+            /* Count the transfer completion in the endpoint statistics.  */
+            UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+            /* Start the next transfer queued on the endpoint.  */
+            UX_TRANSFER_QUEUE_NEXT(transfer_request);
+
             /* Then, we wake up the host.  */
             _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
         }
@@ -361,19 +405,11 @@ UX_SLAVE_DCD            *dcd;
         if (slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_STALLED)
         {
 
+            /* The STALL handshake takes bus time.  */
+            UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, 0);
+
             /* Stall the transaction.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_STALLED;
-            if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
-                transfer_request -> ux_transfer_request_completion_function(transfer_request);
-
-            /* Error trap. */
-            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_TRANSFER_STALLED);
-
-            /* If trace is enabled, insert this event into the trace buffer.  */
-            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_STALLED, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
-
-            /* Wake up the host side.  */
-            _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
 
             /* Clean up this ED.  */
             head_td =  ed -> ux_sim_host_ed_head_td;
@@ -392,6 +428,29 @@ UX_SLAVE_DCD            *dcd;
                 /* Now the new head_td is the next TD in the chain.  */
                 head_td =  ed -> ux_sim_host_ed_head_td;
             }
+
+            /* The ED is clean, start the next transfer queued on the endpoint. This is done
+               before the class is notified, a transfer it submits again is queued after.  */
+            UX_TRANSFER_QUEUE_NEXT(transfer_request);
+
+            if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
+                transfer_request -> ux_transfer_request_completion_function(transfer_request);
+
+            /* Error trap. */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_TRANSFER_STALLED);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_STALLED, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                        transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+            /* Count the transfer completion in the endpoint statistics.  */
+            UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+            /* Wake up the host side.  */
+            _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
         }
         else
         {
@@ -402,11 +461,31 @@ UX_SLAVE_DCD            *dcd;
             if (slave_transfer_request -> ux_slave_transfer_request_requested_length != 0)
                 slave_transfer_remaining = slave_transfer_request -> ux_slave_transfer_request_requested_length - slave_transfer_request -> ux_slave_transfer_request_actual_length;
 
+            /* Get the host data length of this TD.  */
+            host_transfer_remaining =  td -> ux_sim_host_td_length;
+
+#if defined(UX_HCD_SIM_HOST_DIRECT_TRANSFER)
+
+            /* Except for control transfers, the data TDs of a transfer cover its contiguous
+               buffer, hand over all of them at once.  */
+            if ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) != UX_CONTROL_ENDPOINT)
+            {
+                data_td =  td;
+                while ((data_td -> ux_sim_host_td_next_td != ed -> ux_sim_host_ed_tail_td) &&
+                       (data_td -> ux_sim_host_td_next_td -> ux_sim_host_td_transfer_request == transfer_request) &&
+                       (data_td -> ux_sim_host_td_next_td -> ux_sim_host_td_buffer == data_td -> ux_sim_host_td_buffer + data_td -> ux_sim_host_td_length))
+                {
+                    data_td =  data_td -> ux_sim_host_td_next_td;
+                    host_transfer_remaining +=  data_td -> ux_sim_host_td_length;
+                }
+            }
+#endif
+
             /* Get the transaction length to be transferred.  It could be a ZLP condition.  */
-            if (slave_transfer_remaining <= td -> ux_sim_host_td_length)
+            if (slave_transfer_remaining <= host_transfer_remaining)
                 transaction_length =  slave_transfer_remaining;
             else
-                transaction_length =  td -> ux_sim_host_td_length;
+                transaction_length =  host_transfer_remaining;
 
             if (transaction_length)
             {
@@ -425,28 +504,47 @@ UX_SLAVE_DCD            *dcd;
                                             transaction_length); /* Use case of memcpy is verified. */
             }
 
+            /* The data transactions take bus time.  */
+            UX_HCD_SIM_HOST_TIMING_TRANSACTION(hcd_sim_host, ed, transaction_length);
+
             /* Update buffers.  */
-            td -> ux_sim_host_td_buffer +=  transaction_length;
             slave_transfer_request -> ux_slave_transfer_request_current_data_pointer +=  transaction_length;
 
             /* Update actual length values.  */
-            td -> ux_sim_host_td_actual_length +=  transaction_length;
             transfer_request -> ux_transfer_request_actual_length +=  transaction_length;
             slave_transfer_request -> ux_slave_transfer_request_actual_length +=  transaction_length;
 
-            /* Update requested length values.  */
-            td -> ux_sim_host_td_length -=  transaction_length;
-
-            /* Are we done with this TD (It's possible for the TD to expect more data; for example, the slave
-               sent/received a smaller amount)?  */
-            if (td -> ux_sim_host_td_length == 0)
+            /* Consume the data from the TDs.  */
+            host_transfer_remaining =  transaction_length;
+            while (1)
             {
 
+                /* Get the data length taken from this TD.  */
+                td_length =  UX_MIN(td -> ux_sim_host_td_length, host_transfer_remaining);
+                host_transfer_remaining -=  td_length;
+
+                /* Update TD buffer, actual and requested length values.  */
+                td -> ux_sim_host_td_buffer +=  td_length;
+                td -> ux_sim_host_td_actual_length +=  td_length;
+                td -> ux_sim_host_td_length -=  td_length;
+
+                /* Are we done with this TD (It's possible for the TD to expect more data; for example, the slave
+                   sent/received a smaller amount)?  */
+                if (td -> ux_sim_host_td_length != 0)
+                    break;
+
                 /* Free the TD that was used here.  */
                 td -> ux_sim_host_td_status =  UX_UNUSED;
 
                 /* Adjust the ED.  */
                 ed -> ux_sim_host_ed_head_td =  td -> ux_sim_host_td_next_td;
+
+                /* Is all the data consumed?  */
+                if (host_transfer_remaining == 0)
+                    break;
+
+                /* Next TD of the transfer.  */
+                td =  td -> ux_sim_host_td_next_td;
             }
 
             /* Reset wake booleans. */
@@ -493,6 +591,12 @@ UX_SLAVE_DCD            *dcd;
             if (wake_slave == UX_TRUE)
             {
 
+#if defined(UX_HCD_SIM_HOST_TIMING_MODEL) && !defined(UX_HOST_STANDALONE)
+
+                /* Next device request starts a new service latency.  */
+                ed -> ux_sim_host_ed_timing_armed =  UX_FALSE;
+#endif
+
                 /* Set the completion code to no error.  */
                 slave_transfer_request -> ux_slave_transfer_request_completion_code =  UX_SUCCESS;
 
@@ -551,6 +655,20 @@ UX_SLAVE_DCD            *dcd;
                 /* Set the transfer status to COMPLETED.  */
                 transfer_request -> ux_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
 
+                /* Discard cached lines of the data received.  */
+                UX_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
+
+                /* If trace ring is enabled, insert this event into the ring.  */
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+                /* Count the transfer completion in the endpoint statistics.  */
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+                /* Start the next transfer queued on the endpoint. This is done before the
+                   class is notified, a transfer it submits again is queued after.  */
+                UX_TRANSFER_QUEUE_NEXT(transfer_request);
+
                 /* Is there a callback on the host? */
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
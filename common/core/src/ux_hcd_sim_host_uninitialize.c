@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_sim_host_uninitialize                       PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_utility_mutex_delete              Delete mutex                  */
 /*    _ux_utility_timer_delete              Delete timer                  */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -72,16 +73,17 @@
 /*  10-31-2023     Yajun Xia                Modified comment(s),          */
 /*                                            refined memory management,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            deleted TD list mutex,      */
+/*                                            used setup buffer in ED     */
+/*                                            instead of allocating,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_uninitialize(UX_HCD_SIM_HOST *hcd_sim_host)
 {
 
 UX_HCD                  *hcd = hcd_sim_host -> ux_hcd_sim_host_hcd_owner;
-#if defined(UX_HOST_STANDALONE)
-UX_HCD_SIM_HOST_TD      *td;
-UINT                    td_index;
-#endif
 
     /* Set the state of the controller to HALTED first.  */
     hcd -> ux_hcd_status =  UX_HCD_STATUS_HALTED;
@@ -92,29 +94,8 @@ UINT                    td_index;
     /* Delete timer.  */
     _ux_host_timer_delete(&hcd_sim_host -> ux_hcd_sim_host_timer);
 
-#if defined(UX_HOST_STANDALONE)
-
-    /* Check if there is pending SETUP TD, free buffers of them.  */
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_td; td_index++)
-    {
-        td = &hcd_sim_host -> ux_hcd_sim_host_td_list[td_index];
-
-        /* Skip free TDs.  */
-        if (td -> ux_sim_host_td_status == UX_UNUSED)
-            continue;
-
-        /* Skip TDs not for setup.  */
-        if ((td -> ux_sim_host_td_status &  UX_HCD_SIM_HOST_TD_SETUP_PHASE) == 0)
-            continue;
-
-        /* Skip TDs already freed.  */
-        if (td -> ux_sim_host_td_buffer == UX_NULL)
-            continue;
-
-        /* Free the TD buffer.  */
-        _ux_utility_memory_free(td -> ux_sim_host_td_buffer);
-    }
-#endif
+    /* Delete TD list mutex.  */
+    _ux_host_mutex_delete(&hcd_sim_host -> ux_hcd_sim_host_td_mutex);
 
     /* Free TD/ED memories.  */
     if (hcd_sim_host -> ux_hcd_sim_host_iso_td_list)
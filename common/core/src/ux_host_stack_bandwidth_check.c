@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_bandwidth_check                      PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -52,6 +52,10 @@
 /*    bandwidth. The TTs are attached to the device structure and not     */ 
 /*    the hub structure in order to make the stack agnostic of the hub    */ 
 /*    class.                                                              */ 
+/*                                                                        */
+/*    With the bandwidth map, the endpoint is placed in the map instead and*/
+/*    the slot found is kept in the endpoint for the controller and the   */
+/*    claim.                                                              */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -64,7 +68,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    None                                                                */ 
+/*    _ux_host_stack_bandwidth_map_search   Search bandwidth map          */
+/*    _ux_system_error_handler              Log system error              */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -79,11 +84,37 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added bandwidth map,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_bandwidth_check(UX_HCD *hcd, UX_ENDPOINT *endpoint)
 {
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+ULONG           slot;
+
+
+    /* Search the map for the slot of the endpoint.  */
+    slot =  _ux_host_stack_bandwidth_map_search(hcd, endpoint);
+    if (slot == UX_BANDWIDTH_MAP_FULL)
+    {
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_NO_BANDWIDTH_AVAILABLE, endpoint, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_ENUMERATOR, UX_NO_BANDWIDTH_AVAILABLE);
+
+        return(UX_NO_BANDWIDTH_AVAILABLE);
+    }
+
+    /* Keep the slot, the endpoint is not claimed yet.  */
+    endpoint -> ux_endpoint_bandwidth_slot =  slot;
+    return(UX_SUCCESS);
+#else
 UX_DEVICE       *device;
 UX_DEVICE       *parent_device;
 USHORT          hcd_bandwidth_claimed;
@@ -270,5 +301,6 @@ const UCHAR     overheads[4][3] = {
 
     /* We get here when we have not found a 2.0 hub in the list and we got to the root port.  */
     return(UX_SUCCESS);
+#endif
 }
 #endif /* #if UX_MAX_DEVICES > 1 */
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_bandwidth_claim                      PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -51,6 +51,9 @@
 /*    bandwidth. The TTs are attached to the device structure and not     */ 
 /*    the hub structure in order to make the stack agnostic of the hub    */ 
 /*    class.                                                              */ 
+/*                                                                        */
+/*    With the bandwidth map, the bandwidth is reserved in the map at the */
+/*    slot found by _ux_host_stack_bandwidth_check.                       */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -63,7 +66,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    None                                                                */ 
+/*    _ux_host_stack_bandwidth_map_update   Update bandwidth map          */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -78,11 +81,22 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added bandwidth map,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_stack_bandwidth_claim(UX_HCD *hcd, UX_ENDPOINT *endpoint)
 {
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+    /* Reserve the bandwidth at the slot found by the check.  */
+    _ux_host_stack_bandwidth_map_update(hcd, endpoint, endpoint -> ux_endpoint_bandwidth_slot, UX_BANDWIDTH_MAP_CLAIM);
+
+    /* The endpoint bandwidth is claimed.  */
+    endpoint -> ux_endpoint_bandwidth_slot |=  UX_BANDWIDTH_MAP_CLAIMED;
+#else
 UX_DEVICE       *device;
 UX_DEVICE       *parent_device;
 USHORT          hcd_bandwidth_claimed;
@@ -245,5 +259,6 @@ const UCHAR     overheads[4][3] = {
     /* We get here when we have not found a 2.0 hub in the list and we got
        to the root port.  */
     return;
+#endif
 }
 #endif /* #if UX_MAX_DEVICES > 1 */
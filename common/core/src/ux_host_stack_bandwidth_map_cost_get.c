@@ -0,0 +1,210 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_map_cost_get               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function calculates the bandwidth a periodic endpoint uses in  */
+/*    the bandwidth map: its time on the bus, its time on the transaction */
+/*    translator and its period in micro-frames. The time is calculated as*/
+/*    in _ux_host_stack_bandwidth_check. It returns the transaction       */
+/*    translator of a full or low speed endpoint behind a high speed hub. */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to HCD                */
+/*    endpoint                              Pointer to endpoint           */
+/*    hcd_cost                              Pointer to bus bandwidth      */
+/*    tt_cost                               Pointer to TT bandwidth       */
+/*    period                                Pointer to period             */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Pointer to TT, UX_NULL if none                                      */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UX_HUB_TT  *_ux_host_stack_bandwidth_map_cost_get(UX_HCD *hcd, UX_ENDPOINT *endpoint,
+                                        ULONG *hcd_cost, ULONG *tt_cost, ULONG *period)
+{
+
+UX_DEVICE       *device;
+UX_DEVICE       *parent_device;
+ULONG           packet_size;
+ULONG           interval;
+ULONG           port_index;
+ULONG           port_map;
+ULONG           tt_index;
+const UCHAR     overheads[4][3] = {
+/*   LS  FS   HS   */
+    {63, 45, 173}, /* Control */
+    { 0,  9,  38}, /* Isochronous */
+    { 0, 13,  55}, /* Bulk */
+    {19, 13,  55}  /* Interrupt */
+};
+
+    /* Get the pointer to the device.  */
+    device =  endpoint -> ux_endpoint_device;
+
+    /* Get maximum packet size, with rough time for possible bit stuffing.  */
+    packet_size =  endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_PACKET_SIZE_MASK;
+    packet_size =  (packet_size * 7 + 5) / 6;
+
+    /* Add overhead.  */
+    packet_size += overheads[endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE][device -> ux_device_speed];
+
+    /* Get the interval, 0 is not valid for periodic endpoints.  */
+    interval =  endpoint -> ux_endpoint_descriptor.bInterval;
+    if (interval == 0)
+        interval =  1;
+
+    /* Check for high-speed endpoint.  */
+    if (device -> ux_device_speed == UX_HIGH_SPEED_DEVICE)
+    {
+
+        /* Get number of transactions.  */
+        packet_size *=  ((endpoint -> ux_endpoint_descriptor.wMaxPacketSize & UX_MAX_NUMBER_OF_TRANSACTIONS_MASK) >>
+                            UX_MAX_NUMBER_OF_TRANSACTIONS_SHIFT) + 1;
+
+        /* The period is 2^(bInterval - 1) micro-frames, the map holds 2^8.  */
+        if (interval > 9)
+            interval =  9;
+        *period =  1u << (interval - 1);
+    }
+    else
+    {
+
+        /* The isochronous period is 2^(bInterval - 1) frames.  */
+        if ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_ISOCHRONOUS_ENDPOINT)
+        {
+            if (interval > 6)
+                interval =  6;
+            interval =  1u << (interval - 1);
+        }
+
+        /* The interrupt period is bInterval frames, the frames are placed in the
+           periodic tree so the period is rounded down to a power of 2.  */
+        *period =  UX_BANDWIDTH_MAP_MICROFRAMES;
+        while ((*period < UX_BANDWIDTH_MAP_SLOTS) && ((*period << 1) <= interval * UX_BANDWIDTH_MAP_MICROFRAMES))
+            *period <<=  1;
+    }
+
+    /* Calculate the bandwidth claimed by this endpoint for the main bus.  */
+    if (hcd -> ux_hcd_version != 0x200)
+    {
+
+        if (device -> ux_device_speed == UX_LOW_SPEED_DEVICE)
+            /* Low speed transfer takes 40x more units than high speed. */
+            *hcd_cost =  packet_size * 8 * 5;
+        else
+        {
+
+            if (device -> ux_device_speed == UX_FULL_SPEED_DEVICE)
+                /* Full speed transfer takes 5x more units than high speed. */
+                *hcd_cost =  packet_size * 5;
+            else
+                /* Use high speed timing as base for bus bandwidth calculation. */
+                *hcd_cost =  packet_size;
+        }
+    }
+    else
+        *hcd_cost =  packet_size;
+
+    /* The device is high speed or the bus is 1.1, therefore no need for TT.  */
+    *tt_cost =  0;
+    if ((device -> ux_device_speed == UX_HIGH_SPEED_DEVICE) || (hcd -> ux_hcd_version != 0x200))
+        return(UX_NULL);
+
+    if (device -> ux_device_speed == UX_LOW_SPEED_DEVICE)
+        /* Low speed transfer takes 8x more units than full speed. */
+        *tt_cost =  packet_size * 8;
+    else
+        /* Use full speed timing as base for TT bandwidth calculation. */
+        *tt_cost =  packet_size;
+
+    /* Scan the chain of hubs upward for the first 2.0 hub, remember the port
+       on which the chain is hooked to it.  */
+    port_index =  device -> ux_device_port_location - 1;
+    parent_device =  device -> ux_device_parent;
+    while (parent_device != UX_NULL)
+    {
+
+        /* Is the device high speed?  */
+        if (parent_device -> ux_device_speed == UX_HIGH_SPEED_DEVICE)
+        {
+
+            /* Find the TT that manages the port.  */
+            port_map =  (ULONG)(1 << port_index);
+            for (tt_index = 0; tt_index < UX_MAX_TT; tt_index++)
+            {
+
+                /* Check if this TT owns the port.  */
+                if ((parent_device -> ux_device_hub_tt[tt_index].ux_hub_tt_port_mapping & port_map) != 0)
+                    return(&parent_device -> ux_device_hub_tt[tt_index]);
+            }
+
+            /* No TT owns the port.  */
+            return(UX_NULL);
+        }
+
+        /* We now remember where this hub is located on the parent.  */
+        port_index =  parent_device -> ux_device_port_location - 1;
+
+        /* We go up one level in the hub chain.  */
+        parent_device =  parent_device -> ux_device_parent;
+    }
+
+    /* We are at the root port.  */
+    return(UX_NULL);
+}
+#endif
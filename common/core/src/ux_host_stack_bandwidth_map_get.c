@@ -0,0 +1,87 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_map_get                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function copies the bandwidth map of a host controller: the    */
+/*    periodic bandwidth claimed in each micro-frame of the 32 frames     */
+/*    schedule, UX_BANDWIDTH_MAP_SLOTS values. On a full speed bus only   */
+/*    the first micro-frame of each frame is used. The budget of a slot is*/
+/*    ux_hcd_available_bandwidth.                                         */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to HCD                */
+/*    map                                   Pointer to map copy           */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Application                                                         */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_bandwidth_map_get(UX_HCD *hcd, USHORT *map)
+{
+
+    /* Sanity check.  */
+    if ((hcd == UX_NULL) || (map == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Copy the map.  */
+    _ux_utility_memory_copy(map, hcd -> ux_hcd_bandwidth_map, sizeof(hcd -> ux_hcd_bandwidth_map)); /* Use case of memcpy is verified. */
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,151 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_map_search                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function searches the bandwidth map for the slot of a periodic */
+/*    endpoint. High speed endpoints may start in any micro-frame of their*/
+/*    period, full and low speed endpoints in any frame. Behind a         */
+/*    transaction translator, the start-split micro-frame follows the full*/
+/*    speed bytes already budgeted in the busiest frame of the endpoint.  */
+/*                                                                        */
+/*    The slot where the busiest frame of the TT, or the busiest          */
+/*    micro-frame of the bus, is the least loaded is chosen.              */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to HCD                */
+/*    endpoint                              Pointer to endpoint           */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Slot, UX_BANDWIDTH_MAP_FULL if no slot fits                         */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_map_cost_get Get endpoint bandwidth        */
+/*    _ux_host_stack_bandwidth_map_update   Check endpoint bandwidth      */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_host_stack_bandwidth_map_search(UX_HCD *hcd, UX_ENDPOINT *endpoint)
+{
+
+UX_HUB_TT       *tt;
+ULONG           hcd_cost;
+ULONG           tt_cost;
+ULONG           period;
+ULONG           step;
+ULONG           phase;
+ULONG           slot;
+ULONG           frame;
+ULONG           microframe;
+ULONG           tt_load;
+ULONG           load;
+ULONG           best_load;
+ULONG           best_slot;
+
+
+    /* Get the bandwidth and the period of the endpoint.  */
+    tt =  _ux_host_stack_bandwidth_map_cost_get(hcd, endpoint, &hcd_cost, &tt_cost, &period);
+
+    /* Frame based endpoints are placed on frames, high speed ones on micro-frames.  */
+    if (endpoint -> ux_endpoint_device -> ux_device_speed == UX_HIGH_SPEED_DEVICE)
+        step =  1;
+    else
+        step =  UX_BANDWIDTH_MAP_MICROFRAMES;
+
+    /* Try each phase of the period.  */
+    best_load =  UX_BANDWIDTH_MAP_FULL;
+    best_slot =  UX_BANDWIDTH_MAP_FULL;
+    for (phase = 0; phase < period; phase += step)
+    {
+
+        slot =  phase;
+        tt_load =  0;
+        if (tt != UX_NULL)
+        {
+
+            /* Find the busiest TT frame of the phase.  */
+            for (frame = phase / UX_BANDWIDTH_MAP_MICROFRAMES; frame < UX_BANDWIDTH_MAP_FRAMES;
+                 frame += period / UX_BANDWIDTH_MAP_MICROFRAMES)
+            {
+                if (tt -> ux_hub_tt_frame_load[frame] > tt_load)
+                    tt_load =  tt -> ux_hub_tt_frame_load[frame];
+            }
+
+            /* The transaction follows the bytes already budgeted.  */
+            microframe =  tt_load / UX_BANDWIDTH_MAP_SPLIT_BYTES;
+            if (microframe > UX_BANDWIDTH_MAP_SPLIT_LAST)
+                microframe =  UX_BANDWIDTH_MAP_SPLIT_LAST;
+            slot +=  microframe;
+        }
+
+        /* Check the endpoint fits in the slot.  */
+        load =  _ux_host_stack_bandwidth_map_update(hcd, endpoint, slot, UX_BANDWIDTH_MAP_CHECK);
+        if (load == UX_BANDWIDTH_MAP_FULL)
+            continue;
+
+        /* Behind a TT, the TT frames are the scarce resource.  */
+        if (tt != UX_NULL)
+            load =  tt_load + tt_cost;
+
+        /* Keep the least loaded slot.  */
+        if (load < best_load)
+        {
+            best_load =  load;
+            best_slot =  slot;
+        }
+    }
+
+    /* Return the slot found.  */
+    return(best_slot);
+}
+#endif
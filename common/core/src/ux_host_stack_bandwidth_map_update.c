@@ -0,0 +1,181 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_map_update                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function checks, claims or releases the bandwidth of a         */
+/*    periodic endpoint placed at a slot of the bandwidth map. The        */
+/*    endpoint uses the slot micro-frame in each period of the map, and   */
+/*    its TT frames when it is behind a transaction translator. The data  */
+/*    of a split IN transaction are budgeted in its complete-split        */
+/*    micro-frames, as the EHCI controller schedules them.                */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to HCD                */
+/*    endpoint                              Pointer to endpoint           */
+/*    slot                                  First micro-frame in map      */
+/*    operation                             UX_BANDWIDTH_MAP_CHECK,       */
+/*                                          UX_BANDWIDTH_MAP_CLAIM or     */
+/*                                          UX_BANDWIDTH_MAP_RELEASE      */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Busiest bus slot load after the check, UX_BANDWIDTH_MAP_FULL if it  */
+/*    does not fit                                                        */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_map_cost_get Get endpoint bandwidth        */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_host_stack_bandwidth_map_update(UX_HCD *hcd, UX_ENDPOINT *endpoint, ULONG slot, UINT operation)
+{
+
+UX_HUB_TT       *tt;
+ULONG           hcd_cost;
+ULONG           tt_cost;
+ULONG           period;
+ULONG           offsets[3];
+ULONG           offset_count;
+ULONG           frame;
+ULONG           index;
+ULONG           map_index;
+ULONG           offset_index;
+ULONG           load;
+ULONG           load_max;
+
+
+    /* Get the bandwidth and the period of the endpoint.  */
+    tt =  _ux_host_stack_bandwidth_map_cost_get(hcd, endpoint, &hcd_cost, &tt_cost, &period);
+
+    /* The data use the slot micro-frame, except for split IN transactions: they come
+       back in the complete-splits of the 2 micro-frames after the next one, and of the
+       third one unless the start-split is in the last micro-frame.  */
+    offsets[0] =  0;
+    offset_count =  1;
+    if ((tt != UX_NULL) && (endpoint -> ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION))
+    {
+        offsets[0] =  2;
+        offsets[1] =  3;
+        offsets[2] =  4;
+        offset_count =  ((slot % UX_BANDWIDTH_MAP_MICROFRAMES) == UX_BANDWIDTH_MAP_SPLIT_LAST) ? 2 : 3;
+    }
+
+    /* The TT budget is kept for each frame.  */
+    if (tt != UX_NULL)
+    {
+
+        for (frame = slot / UX_BANDWIDTH_MAP_MICROFRAMES; frame < UX_BANDWIDTH_MAP_FRAMES;
+             frame += period / UX_BANDWIDTH_MAP_MICROFRAMES)
+        {
+
+            switch (operation)
+            {
+
+            case UX_BANDWIDTH_MAP_CLAIM:
+                tt -> ux_hub_tt_frame_load[frame] =  (USHORT)(tt -> ux_hub_tt_frame_load[frame] + tt_cost);
+                break;
+
+            case UX_BANDWIDTH_MAP_RELEASE:
+                tt -> ux_hub_tt_frame_load[frame] =  (USHORT)(tt -> ux_hub_tt_frame_load[frame] - tt_cost);
+                break;
+
+            default:
+
+                /* Check the full speed bytes left in the frame.  */
+                if (tt -> ux_hub_tt_frame_load[frame] + tt_cost > UX_MAX_BYTES_PER_FRAME_FS)
+                    return(UX_BANDWIDTH_MAP_FULL);
+                break;
+            }
+        }
+    }
+
+    /* The bus budget is kept for each micro-frame.  */
+    load_max =  0;
+    for (index = slot; index < UX_BANDWIDTH_MAP_SLOTS; index += period)
+    {
+
+        for (offset_index = 0; offset_index < offset_count; offset_index++)
+        {
+
+            /* Stay in the frame of the slot, as the EHCI masks do.  */
+            map_index =  (index & ~(UX_BANDWIDTH_MAP_MICROFRAMES - 1)) +
+                         ((index + offsets[offset_index]) & (UX_BANDWIDTH_MAP_MICROFRAMES - 1));
+
+            switch (operation)
+            {
+
+            case UX_BANDWIDTH_MAP_CLAIM:
+                hcd -> ux_hcd_bandwidth_map[map_index] =  (USHORT)(hcd -> ux_hcd_bandwidth_map[map_index] + hcd_cost);
+                break;
+
+            case UX_BANDWIDTH_MAP_RELEASE:
+                hcd -> ux_hcd_bandwidth_map[map_index] =  (USHORT)(hcd -> ux_hcd_bandwidth_map[map_index] - hcd_cost);
+                break;
+
+            default:
+
+                /* Check the bandwidth left in the micro-frame.  */
+                load =  hcd -> ux_hcd_bandwidth_map[map_index] + hcd_cost;
+                if (load > hcd -> ux_hcd_available_bandwidth)
+                    return(UX_BANDWIDTH_MAP_FULL);
+                if (load > load_max)
+                    load_max =  load;
+                break;
+            }
+        }
+    }
+
+    /* Return the busiest slot load.  */
+    return(load_max);
+}
+#endif
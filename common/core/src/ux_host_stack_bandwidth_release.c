@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_bandwidth_release                    PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -50,6 +50,9 @@
 /*    This algorithm takes into account both TT bandwidth and HCD         */ 
 /*    bandwidth. The TTs are attached to the device structure and not the */ 
 /*    hub structure in order to make the stack agnostic of the hub class. */ 
+/*                                                                        */
+/*    With the bandwidth map, the bandwidth is freed in the map if the    */
+/*    endpoint claimed it.                                                */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -62,7 +65,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    None                                                                */ 
+/*    _ux_host_stack_bandwidth_map_update   Update bandwidth map          */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -77,11 +80,24 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added bandwidth map,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_stack_bandwidth_release(UX_HCD *hcd, UX_ENDPOINT *endpoint)
 {
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+    /* Nothing to free if the endpoint was not created.  */
+    if ((endpoint -> ux_endpoint_bandwidth_slot & UX_BANDWIDTH_MAP_CLAIMED) == 0)
+        return;
+
+    /* Free the bandwidth at the endpoint slot.  */
+    endpoint -> ux_endpoint_bandwidth_slot &=  UX_BANDWIDTH_MAP_SLOT_MASK;
+    _ux_host_stack_bandwidth_map_update(hcd, endpoint, endpoint -> ux_endpoint_bandwidth_slot, UX_BANDWIDTH_MAP_RELEASE);
+#else
 UX_DEVICE       *device;
 UX_DEVICE       *parent_device;
 USHORT          hcd_bandwidth_claimed;
@@ -240,5 +256,6 @@ const UCHAR     overheads[4][3] = {
     /* We get here when we have not found a 2.0 hub in the list and we got
        to the root port.  */
     return;
+#endif
 }
 #endif /* #if UX_MAX_DEVICES > 1 */
@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_bandwidth_tt_map_get                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function copies the bandwidth map of a transaction translator  */
+/*    of a high speed hub: the full speed bytes claimed in each frame of  */
+/*    the 32 frames schedule, UX_BANDWIDTH_MAP_FRAMES values. The budget  */
+/*    of a frame is UX_MAX_BYTES_PER_FRAME_FS.                            */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hub_device                            Pointer to hub device         */
+/*    tt_index                              Index of TT in the hub        */
+/*    map                                   Pointer to map copy           */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Application                                                         */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_bandwidth_tt_map_get(UX_DEVICE *hub_device, UINT tt_index, USHORT *map)
+{
+
+UX_HUB_TT       *tt;
+
+
+    /* Sanity check.  */
+    if ((hub_device == UX_NULL) || (map == UX_NULL) || (tt_index >= UX_MAX_TT))
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the TT.  */
+    tt =  &hub_device -> ux_device_hub_tt[tt_index];
+
+    /* Copy the map.  */
+    _ux_utility_memory_copy(map, tt -> ux_hub_tt_frame_load, sizeof(tt -> ux_hub_tt_frame_load)); /* Use case of memcpy is verified. */
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -40,7 +40,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_class_device_scan                    PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -62,6 +62,9 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_class_call             Call host stack class         */ 
+/*    _ux_utility_memory_profiler_owner_set Set memory owner              */ 
+/*    _ux_utility_memory_profiler_owner_restore                           */ 
+/*                                          Restore memory owner          */ 
 /*    (ux_host_class_entry_function)        Class entry function          */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -83,6 +86,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            tagged class activation     */
+/*                                            memory in profiler,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_class_device_scan(UX_DEVICE *device)
@@ -92,6 +99,9 @@ UINT  _ux_host_stack_class_device_scan(UX_DEVICE *device)
 UINT                        status;
 UX_HOST_CLASS               *class_inst = UX_NULL;
 UX_HOST_CLASS_COMMAND       class_command;
+#if defined(UX_ENABLE_MEMORY_PROFILER) && !defined(UX_HOST_STANDALONE)
+UX_MEMORY_PROFILER_OWNER    previous_owner;
+#endif
 
     /* Perform the command initialization.  */
     class_command.ux_host_class_command_request      =   UX_HOST_CLASS_COMMAND_QUERY;
@@ -137,7 +147,11 @@ UX_HOST_CLASS_COMMAND       class_command;
 #else
         class_command.ux_host_class_command_class_ptr =  class_inst;
         class_command.ux_host_class_command_request =  UX_HOST_CLASS_COMMAND_ACTIVATE;
+
+        /* Tag class allocations with the class and device, in profiler.  */
+        UX_MEMORY_PROFILER_OWNER_SET(class_inst -> ux_host_class_name, device -> ux_device_address, &previous_owner);
         status =  device -> ux_device_class ->  ux_host_class_entry_function(&class_command);
+        UX_MEMORY_PROFILER_OWNER_RESTORE(&previous_owner);
 
         /* Return result of activation.  */
         return(status);
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_class_instance_destroy               PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_class_instance_destroy(UX_HOST_CLASS *host_class, VOID *class_instance)
@@ -78,6 +81,10 @@ VOID    **next_class_instance;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_CLASS_INSTANCE_DESTROY, host_class, class_instance, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_HOST_CLASS_INSTANCE_DESTROY, host_class - _ux_system_host -> ux_system_host_class_array,
+                         (ALIGN_TYPE)class_instance, 0)
+
     /* If trace is enabled, register this object.  */
     UX_TRACE_OBJECT_UNREGISTER(class_instance);
 
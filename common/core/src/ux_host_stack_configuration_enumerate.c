@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_configuration_enumerate              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -65,7 +65,8 @@
 /*    _ux_host_stack_new_configuration_create                             */ 
 /*                                          Create new configuration      */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
-/*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate block of memory      */
 /*    _ux_utility_memory_free               Free block of memory          */ 
 /*                                                                        */ 
@@ -80,6 +81,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_configuration_enumerate(UX_DEVICE *device)
@@ -141,8 +146,8 @@ ULONG               configuration_index;
                 _ux_host_stack_new_configuration_create(device, configuration);
                 
                 /* The descriptor is in a packed format, parse it locally.  */      
-                _ux_utility_descriptor_parse(descriptor, _ux_system_configuration_descriptor_structure,
-                                    UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *) &configuration -> ux_configuration_descriptor);
+                _ux_utility_descriptor_unpack_configuration(descriptor,
+                        &configuration -> ux_configuration_descriptor);
 
                 /* Parse the device descriptor so that we can retrieve the length 
                     of the entire configuration.  */
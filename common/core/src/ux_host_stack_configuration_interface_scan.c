@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_configuration_interface_scan         PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,6 +58,9 @@
 /*    _ux_host_stack_device_configuration_select                          */
 /*                                          Select configuration          */
 /*    _ux_host_stack_class_call             Call class from host stack    */
+/*    _ux_utility_memory_profiler_owner_set Set memory owner              */
+/*    _ux_utility_memory_profiler_owner_restore                           */
+/*                                          Restore memory owner          */
 /*    (ux_host_class_entry_function)        Class entry function          */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -76,6 +79,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            tagged class activation     */
+/*                                            memory in profiler,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_configuration_interface_scan(UX_CONFIGURATION *configuration)
@@ -86,6 +93,10 @@ UINT                    nb_class_owners;
 UX_HOST_CLASS           *class_ptr;
 UX_HOST_CLASS_COMMAND   class_command;
 UINT                    status;
+#if defined(UX_ENABLE_MEMORY_PROFILER) && !defined(UX_HOST_STANDALONE)
+UX_MEMORY_PROFILER_OWNER
+                        previous_owner;
+#endif
 
 
     /* Initialize class owners to 0.  */
@@ -174,8 +185,13 @@ UINT                    status;
                         /* Save the class in the command container */
                         class_command.ux_host_class_command_class_ptr =  interface_ptr -> ux_interface_class;
 
-                        /* Send the ACTIVATE command to the class */
+                        /* Send the ACTIVATE command to the class, its allocations are tagged
+                           with the class and device in profiler.  */
+                        UX_MEMORY_PROFILER_OWNER_SET(interface_ptr -> ux_interface_class -> ux_host_class_name,
+                                                     configuration -> ux_configuration_device -> ux_device_address,
+                                                     &previous_owner);
                         status =  interface_ptr -> ux_interface_class -> ux_host_class_entry_function(&class_command);
+                        UX_MEMORY_PROFILER_OWNER_RESTORE(&previous_owner);
 
                     }
                 }
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_configuration_set                    PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -84,6 +84,10 @@
 /*                                            added standalone support,   */
 /*                                            set device power source,    */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring events,    */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_configuration_set(UX_CONFIGURATION *configuration)
@@ -146,6 +150,10 @@ UX_HCD          *hcd;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_CONFIGURATION_SET, configuration, 0, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_HOST_CONFIGURATION_SET, device -> ux_device_address,
+                         configuration -> ux_configuration_descriptor.bConfigurationValue, 0)
+
     /* Create a transfer_request for the SET_CONFIGURATION request. No data for this request.  */
     transfer_request -> ux_transfer_request_requested_length =  0;
     transfer_request -> ux_transfer_request_function =          UX_SET_CONFIGURATION;
@@ -175,6 +183,9 @@ UX_HCD          *hcd;
 
         /* Change the device state to configured.  */
         device -> ux_device_state =  UX_DEVICE_CONFIGURED;
+#if !defined(UX_HOST_STANDALONE)
+        UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_CONFIGURATION_SET);
+#endif
     
         /* Store the new configuration value in the device container.  */
         device -> ux_device_current_configuration =  configuration;
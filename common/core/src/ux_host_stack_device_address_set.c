@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_device_address_set                   PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -71,6 +71,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring events,    */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_address_set(UX_DEVICE *device)
@@ -146,6 +150,9 @@ UCHAR           device_address_byte;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_DEVICE_ADDRESS_SET, device, device_address, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_HOST_DEVICE_ADDRESS_SET, device_address, 0, 0)
+
     /* Create a transfer request for the SET_ADDRESS request.  */
     transfer_request -> ux_transfer_request_data_pointer =      UX_NULL;
     transfer_request -> ux_transfer_request_requested_length =  0;
@@ -176,6 +183,7 @@ UCHAR           device_address_byte;
 
         /* Some devices need some time to accept this address.  */
         _ux_utility_delay_ms(UX_DEVICE_ADDRESS_SET_WAIT);
+        UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_ADDRESS_SET);
 
         /* Return successful status.  */
         return(status);
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_device_descriptor_read               PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,7 +53,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
-/*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_device  Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*    _ux_utility_memory_free               Free memory block             */ 
 /*                                                                        */ 
@@ -75,6 +75,11 @@
 /*                                            added standalone support,   */
 /*                                            added class code checking,  */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            added trace ring events,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_descriptor_read(UX_DEVICE *device)
@@ -121,8 +126,7 @@ UX_ENDPOINT     *control_endpoint;
     {
 
         /* Parse the device descriptor and create the local descriptor.  */
-        _ux_utility_descriptor_parse(descriptor, _ux_system_device_descriptor_structure, UX_DEVICE_DESCRIPTOR_ENTRIES,
-                                                                                (UCHAR *) &device -> ux_device_descriptor);
+        _ux_utility_descriptor_unpack_device(descriptor, &device -> ux_device_descriptor);
     }
     else
     {
@@ -185,8 +189,11 @@ UX_ENDPOINT     *control_endpoint;
     {
 
         /* Parse the device descriptor and create the local descriptor.  */
-        _ux_utility_descriptor_parse(descriptor, _ux_system_device_descriptor_structure, UX_DEVICE_DESCRIPTOR_ENTRIES,
-                                                                    (UCHAR *) &device -> ux_device_descriptor);
+        _ux_utility_descriptor_unpack_device(descriptor, &device -> ux_device_descriptor);
+
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_INSERT(UX_TRACE_RING_HOST_DEVICE_DESCRIPTOR_READ, device -> ux_device_address,
+                             device -> ux_device_descriptor.idVendor, device -> ux_device_descriptor.idProduct)
     }
     else
     {
@@ -0,0 +1,89 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_device_enumeration_timeline_get      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies the enumeration timeline of a device. The      */
+/*    timeline is complete once the device connection is notified to the  */
+/*    application.                                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    device                                Pointer to device             */
+/*    timeline                              Pointer to timeline copy      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_device_enumeration_timeline_get(UX_DEVICE *device, UX_ENUMERATION_TIMELINE *timeline)
+{
+
+    /* Sanity check.  */
+    if ((device == UX_NULL) || (timeline == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Check if the device is used.  */
+    if (device -> ux_device_handle == UX_UNUSED)
+        return(UX_DEVICE_HANDLE_UNKNOWN);
+
+    /* Copy the timeline.  */
+    _ux_utility_memory_copy(timeline, &device -> ux_device_enumeration_timeline, sizeof(UX_ENUMERATION_TIMELINE)); /* Use case of memcpy is verified. */
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
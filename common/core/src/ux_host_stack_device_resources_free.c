@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_device_resources_free                PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,7 @@
 /*                                          Abort transfer                */
 /*    _ux_host_stack_endpoint_instance_delete                             */
 /*                                          Delete endpoint instance      */ 
+/*    _ux_utility_memory_arena_delete       Delete memory arena           */
 /*    _ux_utility_memory_free               Free memory block             */ 
 /*    _ux_utility_memory_set                Set memory with a value       */ 
 /*    _ux_utility_semaphore_delete          Semaphore delete              */ 
@@ -87,6 +88,10 @@
 /*                                            freed shared device config  */
 /*                                            descriptor for enum scan,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            released device memory      */
+/*                                            arena,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_device_resources_free(UX_DEVICE *device)
@@ -266,6 +271,13 @@ UX_DEVICE               *enum_next;
     /* The semaphore for endpoint 0 protection must be destroyed.  */
     _ux_host_semaphore_delete(&device -> ux_device_protection_semaphore);
 
+#if defined(UX_ENABLE_MEMORY_ARENA) && !defined(UX_HOST_STANDALONE)
+
+    /* All device resources are freed, release the device arena in one shot.  */
+    if (device -> ux_device_memory_arena != UX_NULL)
+        _ux_utility_memory_arena_delete(device -> ux_device_memory_arena);
+#endif
+
     /* Now this device can be free and its container return to the pool.  */
 #if defined(UX_HOST_STANDALONE)
     enum_next = device -> ux_device_enum_next;
@@ -0,0 +1,135 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_statistics_walk             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function calls the application for each endpoint of the        */
+/*    devices attached: the default control endpoint, then the endpoints  */
+/*    of each interface of each configuration. The statistics of an       */
+/*    endpoint are read with ux_host_stack_endpoint_statistics_get.       */
+/*                                                                        */
+/*    The walk stops at the first status returned other than UX_SUCCESS,  */
+/*    this status is returned. The application must not remove a device   */
+/*    during the walk, it is called from thread context only.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    walk_function                         Function called per endpoint  */
+/*    parameter                             Parameter of the function     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    (walk_function)                       Application function          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_endpoint_statistics_walk(UINT (*walk_function)(UX_DEVICE *device, UX_ENDPOINT *endpoint, VOID *parameter),
+                                              VOID *parameter)
+{
+
+UX_DEVICE           *device;
+UX_CONFIGURATION    *configuration;
+UX_INTERFACE        *interface_ptr;
+UX_ENDPOINT         *endpoint;
+ULONG               device_index;
+UINT                status;
+
+
+    /* Sanity check.  */
+    if (walk_function == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Check if the host stack is initialized.  */
+    if (_ux_system_host == UX_NULL)
+        return(UX_SUCCESS);
+
+    /* Walk all the devices attached.  */
+    device =  _ux_system_host -> ux_system_host_device_array;
+    for (device_index = 0; device_index < UX_SYSTEM_HOST_MAX_DEVICES_GET(); device_index ++, device ++)
+    {
+
+        /* Check if the device is used.  */
+        if (device -> ux_device_handle == UX_UNUSED)
+            continue;
+
+        /* The default control endpoint first.  */
+        status =  walk_function(device, &device -> ux_device_control_endpoint, parameter);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        /* Then the endpoints of all the interfaces.  */
+        configuration =  device -> ux_device_first_configuration;
+        while (configuration != UX_NULL)
+        {
+            interface_ptr =  configuration -> ux_configuration_first_interface;
+            while (interface_ptr != UX_NULL)
+            {
+                endpoint =  interface_ptr -> ux_interface_first_endpoint;
+                while (endpoint != UX_NULL)
+                {
+                    status =  walk_function(device, endpoint, parameter);
+                    if (status != UX_SUCCESS)
+                        return(status);
+                    endpoint =  endpoint -> ux_endpoint_next_endpoint;
+                }
+                interface_ptr =  interface_ptr -> ux_interface_next_interface;
+            }
+            configuration =  configuration -> ux_configuration_next_configuration;
+        }
+    }
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_endpoint_transfer_abort              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -44,10 +44,10 @@
 /*    endpoint. The endpoint is not reset and its toggle state is left    */ 
 /*    the same.                                                           */
 /*                                                                        */
-/*    In this version of USBX, there can only be one transfer request     */ 
-/*    pending for an endpoint. It is not known at this stage if having    */ 
-/*    multiple transfer request is a benefit for USBX but this function   */ 
-/*    may be changed one day to add such functionality.                   */
+/*    Without endpoint transfer queue, there can only be one transfer     */
+/*    request pending for an endpoint. With the queue, the transfer       */
+/*    requests waiting in the queue are aborted first, then the one that  */
+/*    is with the controller.                                             */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -73,18 +73,48 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_endpoint_transfer_abort(UX_ENDPOINT *endpoint)
 {
 
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+UX_INTERRUPT_SAVE_AREA
+
+UX_TRANSFER     *transfer_request;
+#endif
 UINT    status;
     
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_ENDPOINT_TRANSFER_ABORT, endpoint, 0, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
-    /* Since we only have one transfer_request per endpoint, use the regular 
-       abort transfer request function.  */
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+
+    /* Abort the transfer requests waiting in the endpoint queue.  */
+    do
+    {
+        UX_DISABLE
+        transfer_request =  endpoint -> ux_endpoint_transfer_queue_head;
+        if (transfer_request != UX_NULL)
+            transfer_request =  transfer_request -> ux_transfer_request_next_transfer_request;
+        UX_RESTORE
+
+        if (transfer_request != UX_NULL)
+            _ux_host_stack_transfer_request_abort(transfer_request);
+    } while (transfer_request != UX_NULL);
+
+    /* Abort the one with the controller, if it's not the endpoint one.  */
+    transfer_request =  endpoint -> ux_endpoint_transfer_queue_head;
+    if ((transfer_request != UX_NULL) && (transfer_request != &endpoint -> ux_endpoint_transfer_request))
+        _ux_host_stack_transfer_request_abort(transfer_request);
+#endif
+
+    /* Abort the transfer request of the endpoint with the regular abort
+       transfer request function.  */
     status =  _ux_host_stack_transfer_request_abort(&endpoint -> ux_endpoint_transfer_request);
 
     /* Return completion status.  */
@@ -0,0 +1,123 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_enumeration_timeline_record          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function records an enumeration event in a timeline. A         */
+/*    connection restarts the timeline. An attempt after the first one    */
+/*    counts a failure at the first phase not reached and restarts the    */
+/*    phases from the port reset. A phase is timestamped the first time   */
+/*    it is reached in an attempt.                                        */
+/*                                                                        */
+/*    Enumeration is serialized, the timeline is not protected.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    timeline                              Pointer to timeline           */
+/*    event                                 Enumeration phase or event    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_set                Set memory with a value       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_enumeration_timeline_record(UX_ENUMERATION_TIMELINE *timeline, UINT event)
+{
+
+UINT        phase;
+
+
+    switch(event)
+    {
+
+    case UX_ENUMERATION_EVENT_CONNECT:
+
+        /* Restart the timeline.  */
+        _ux_utility_memory_set(timeline, 0, sizeof(UX_ENUMERATION_TIMELINE)); /* Use case of memset is verified. */
+        timeline -> ux_enumeration_timeline_start =  UX_ENUMERATION_TIMELINE_TIMESTAMP_GET();
+        return;
+
+    case UX_ENUMERATION_EVENT_ATTEMPT:
+
+        /* Count the attempt, the first one has nothing to restart.  */
+        timeline -> ux_enumeration_timeline_attempts ++;
+        if (timeline -> ux_enumeration_timeline_attempts == 1)
+            return;
+
+        /* The previous attempt failed at the first phase it did not reach.  */
+        for (phase = UX_ENUMERATION_PHASE_RESET; phase < UX_ENUMERATION_PHASES - 1; phase ++)
+        {
+            if ((timeline -> ux_enumeration_timeline_phases & (1u << phase)) == 0)
+                break;
+        }
+        timeline -> ux_enumeration_timeline_failures[phase] ++;
+
+        /* Restart the phases from the port reset.  */
+        timeline -> ux_enumeration_timeline_phases &=  (1u << UX_ENUMERATION_PHASE_RESET) - 1;
+        return;
+
+    default:
+
+        /* Timestamp the phase if it is not reached yet, timestamps wrap around.  */
+        if ((event >= UX_ENUMERATION_PHASES) ||
+            (timeline -> ux_enumeration_timeline_phases & (1u << event)))
+            return;
+        timeline -> ux_enumeration_timeline_phases |=  (ULONG)(1u << event);
+        timeline -> ux_enumeration_timeline_time[event] =
+                (UX_ENUMERATION_TIMELINE_TIMESTAMP_GET() - timeline -> ux_enumeration_timeline_start) & 0xFFFFFFFFu;
+        return;
+    }
+}
+#endif
@@ -67,6 +67,13 @@ UCHAR _ux_system_host_class_hid_client_remote_control_name[] =              "ux_
 UCHAR _ux_system_host_class_hid_client_mouse_name[] =                       "ux_host_class_hid_client_mouse";
 UCHAR _ux_system_host_class_hid_client_keyboard_name[] =                    "ux_host_class_hid_client_keyboard";
 
+#ifdef UX_ENABLE_MEMORY_PROFILER
+
+/* Define the name of the host stack, to tag its memory in profiler.  */
+
+UCHAR _ux_system_host_stack_name[] =                                        "ux_host_stack";
+#endif
+
 /* Define the name of all the USB Host Controllers of USBX.  */
 
 UCHAR _ux_system_host_hcd_ohci_name[] =                                     "ux_hcd_ohci";
@@ -86,7 +93,7 @@ UCHAR _ux_system_host_hcd_simulator_name[] =                                "ux_
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_initialize                           PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -133,6 +140,10 @@ UCHAR _ux_system_host_hcd_simulator_name[] =                                "ux_
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added host stack name for   */
+/*                                            memory profiler,            */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_initialize(UINT (*ux_system_host_change_function)(ULONG, UX_HOST_CLASS *, VOID *))
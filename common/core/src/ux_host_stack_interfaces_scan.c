@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_interfaces_scan                      PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,7 +56,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    _ux_utility_descriptor_parse          Parse interface descriptor    */
+/*    _ux_utility_descriptor_unpack_interface_association                 */
+/*                                          Unpack descriptor             */
 /*    _ux_host_stack_new_interface_create   Create new interface          */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -70,6 +71,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_interfaces_scan(UX_CONFIGURATION *configuration, UCHAR * descriptor)
@@ -119,10 +124,7 @@ UX_INTERFACE_ASSOCIATION_DESCRIPTOR interface_association;
         {
 
             /* Parse the interface association descriptor and make it machine independent.  */
-            _ux_utility_descriptor_parse(descriptor,
-                            _ux_system_interface_association_descriptor_structure,
-                            UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES,
-                            (UCHAR *) &interface_association);
+            _ux_utility_descriptor_unpack_interface_association(descriptor, &interface_association);
 
             /* Retrieve the CLASS/SUBCLASS from descriptor and store it in the configuration instance.  */
             configuration -> ux_configuration_iad_class    = interface_association.bFunctionClass;
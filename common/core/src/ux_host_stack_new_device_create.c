@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_new_device_create                    PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -81,6 +81,14 @@
 /*    _ux_host_stack_configuration_enumerate                              */
 /*                                          Enumerate device config       */
 /*    _ux_host_stack_new_device_get         Get new device                */
+/*    _ux_utility_memory_arena_create       Create memory arena           */
+/*    _ux_utility_memory_arena_select       Select memory arena           */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_memory_profiler_owner_set Set memory owner              */
+/*    _ux_utility_memory_profiler_owner_restore                           */
+/*                                          Restore memory owner          */
+/*    _ux_utility_memory_steady_state_enter Enter memory steady state     */
+/*    _ux_utility_memory_steady_state_exit  Exit memory steady state      */
 /*    _ux_utility_semaphore_create          Create a semaphore            */
 /*    (ux_hcd_entry_function)               HCD entry function            */
 /*                                                                        */
@@ -109,6 +117,16 @@
 /*                                            freed shared device config  */
 /*                                            descriptor after enum scan, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added device memory arena   */
+/*                                            support,                    */
+/*                                            tagged enumeration memory   */
+/*                                            in profiler,                */
+/*                                            entered memory steady state */
+/*                                            after enumeration,          */
+/*                                            added trace ring events,    */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_new_device_create(UX_HCD *hcd, UX_DEVICE *device_owner,
@@ -120,7 +138,16 @@ UINT  _ux_host_stack_new_device_create(UX_HCD *hcd, UX_DEVICE *device_owner,
 UX_DEVICE           *device;
 UINT                status;
 UX_ENDPOINT         *control_endpoint;
+#if defined(UX_ENABLE_MEMORY_ARENA) && !defined(UX_HOST_STANDALONE)
+UX_MEMORY_ARENA     *previous_arena;
+#endif
+#if defined(UX_ENABLE_MEMORY_PROFILER) && !defined(UX_HOST_STANDALONE)
+UX_MEMORY_PROFILER_OWNER
+                    previous_owner;
+#endif
 
+    /* Allocations are expected while a device is enumerated.  */
+    UX_MEMORY_STEADY_STATE_EXIT(UX_MEMORY_STEADY_STATE_HOST);
 
 #if UX_MAX_DEVICES > 1
     /* Verify the number of devices attached to the HCD already. Normally a HCD
@@ -161,6 +188,10 @@ UX_ENDPOINT         *control_endpoint;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_NEW_DEVICE_CREATE, hcd, device_owner, port_index, device, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_HOST_DEVICE_CONNECT, (device_owner != UX_NULL) ? device_owner -> ux_device_address : 0,
+                         port_index, device_speed)
+
     /* At this stage the device is attached but not configured.
        we don't have to worry about power consumption yet.
        Initialize the device structure.  */
@@ -238,6 +269,18 @@ UX_ENDPOINT         *control_endpoint;
 
 #else
 
+#if defined(UX_ENABLE_MEMORY_ARENA)
+
+    /* Open the device arena, enumeration and class activation allocations
+       of this thread are taken from it. It's deleted when device resources
+       are freed. If there is no memory for it, the memory pool is used.  */
+    device -> ux_device_memory_arena = _ux_utility_memory_arena_create();
+    previous_arena = _ux_utility_memory_arena_select(device -> ux_device_memory_arena);
+#endif
+
+    /* Tag enumeration allocations of this thread with the device, in profiler.  */
+    UX_MEMORY_PROFILER_OWNER_SET(_ux_system_host_stack_name, 0, &previous_owner);
+
     /* Going on to do enumeration (requests).  */
     if (status == UX_SUCCESS)
     {
@@ -252,14 +295,20 @@ UX_ENDPOINT         *control_endpoint;
         if (status == UX_SUCCESS)
         {
 
+            /* The device address is known now.  */
+            UX_MEMORY_PROFILER_OWNER_SET(_ux_system_host_stack_name, device -> ux_device_address, UX_NULL);
+
             /* Get the device descriptor.  */
             status =  _ux_host_stack_device_descriptor_read(device);
             if (status == UX_SUCCESS)
             {
+                UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_DEVICE_DESCRIPTOR);
 
                 /* Get the configuration descriptor(s) for the device
                    and parse all the configuration, interface, endpoints...  */
                 status =  _ux_host_stack_configuration_enumerate(device);
+                if (status == UX_SUCCESS)
+                    UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_CONFIGURATION_DESCRIPTOR);
             }
         }
     }
@@ -281,6 +330,8 @@ UX_ENDPOINT         *control_endpoint;
             status =  _ux_host_stack_class_interface_scan(device);
 
         }
+        if (status == UX_SUCCESS)
+            UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_CLASS_ACTIVATE);
 
         /* Check if there is unnecessary resource to free.  */
         if (device -> ux_device_packed_configuration &&
@@ -293,6 +344,30 @@ UX_ENDPOINT         *control_endpoint;
         /* If trace is enabled, register this object.  */
         UX_TRACE_OBJECT_REGISTER(UX_TRACE_HOST_OBJECT_TYPE_DEVICE, hcd, device_owner, port_index, 0);
     }
+
+#if defined(UX_ENABLE_MEMORY_ARENA)
+
+    /* Enumeration is done, allocations are from the memory pool again.  */
+    _ux_utility_memory_arena_select(previous_arena);
+#endif
+    UX_MEMORY_PROFILER_OWNER_RESTORE(&previous_owner);
+
+    /* Enumeration is done, allocations are not expected any more once the
+       classes are activated. Classes that still allocate from their threads
+       hold steady state off until they are done.  */
+    if (status == UX_SUCCESS)
+    {
+        UX_MEMORY_STEADY_STATE_ENTER(UX_MEMORY_STEADY_STATE_HOST);
+    }
+
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+
+    /* Keep the enumeration timeline in the device, the application reads
+       it when the device connection is notified.  */
+    _ux_utility_memory_copy(&device -> ux_device_enumeration_timeline,
+                            &_ux_system_host -> ux_system_host_enumeration_timeline,
+                            sizeof(UX_ENUMERATION_TIMELINE)); /* Use case of memcpy is verified. */
+#endif
 #endif
 
     /* Return status. If there's an error, device resources that have been 
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_new_endpoint_create                  PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,7 +59,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    _ux_utility_descriptor_parse          Parse the descriptor          */ 
+/*    _ux_utility_descriptor_unpack_endpoint                              */
+/*                                          Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -80,6 +81,10 @@
 /*                                            internal clean up,          */
 /*                                            fixed size calculation,     */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_new_endpoint_create(UX_INTERFACE *interface_ptr,
@@ -112,10 +117,7 @@ ULONG           n_tran;
     endpoint -> ux_endpoint_device =  interface_ptr -> ux_interface_configuration -> ux_configuration_device;
 
     /* Parse the interface descriptor and make it machine independent.  */
-    _ux_utility_descriptor_parse(interface_endpoint,
-                            _ux_system_endpoint_descriptor_structure,
-                            UX_ENDPOINT_DESCRIPTOR_ENTRIES,
-                            (UCHAR *) &endpoint -> ux_endpoint_descriptor);
+    _ux_utility_descriptor_unpack_endpoint(interface_endpoint, &endpoint -> ux_endpoint_descriptor);
 
     /* Check endpoint size and interval to see if they are valid.  */
     endpoint_type = endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE;
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_new_interface_create                 PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -65,7 +65,8 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_new_endpoint_create    Create new endpoint           */ 
-/*    _ux_utility_descriptor_parse          Parse the descriptor          */ 
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -83,6 +84,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_new_interface_create(UX_CONFIGURATION *configuration,
@@ -109,10 +114,7 @@ UCHAR               *this_interface_descriptor;
     interface_ptr -> ux_interface_handle =  (ULONG) (ALIGN_TYPE) interface_ptr;
 
     /* Parse the interface descriptor and make it machine independent.  */
-    _ux_utility_descriptor_parse(descriptor,
-                            _ux_system_interface_descriptor_structure,
-                            UX_INTERFACE_DESCRIPTOR_ENTRIES,
-                            (UCHAR *) &interface_ptr -> ux_interface_descriptor);
+    _ux_utility_descriptor_unpack_interface(descriptor, &interface_ptr -> ux_interface_descriptor);
 
     /* The configuration that owns this interface is memorized in the 
        interface container itself, easier for back chaining.  */
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_rh_device_insertion                  PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -86,6 +86,9 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            internal clean up,          */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_rh_device_insertion(UX_HCD *hcd, UINT port_index)
@@ -113,6 +116,9 @@ UINT        status;
         /* Set enumeration flag to process enumeration sequence.  */
         device -> ux_device_flags |= UX_DEVICE_FLAG_ENUM;
 
+        /* Start the enumeration timeline of the device.  */
+        UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_EVENT_CONNECT);
+
         /* Done success.  */
         return(UX_SUCCESS);
     }
@@ -134,8 +140,12 @@ UINT        status;
     if (port_status == UX_PORT_INDEX_UNKNOWN)
         return(port_status);
 
+    /* Start the enumeration timeline.  */
+    UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_EVENT_CONNECT);
+
     /* A debounce interval with a minimum duration of 100 ms on attach.  */
     _ux_utility_delay_ms(100);
+    UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_DEBOUNCE);
 
     /* The first attempts to do a device enumeration may fail.
        Typically, after the port is reset and the first command is sent to
@@ -144,10 +154,14 @@ UINT        status;
     for (index_loop = 0; index_loop < UX_RH_ENUMERATION_RETRY; index_loop++)
     {
 
+        /* Record the enumeration attempt.  */
+        UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_EVENT_ATTEMPT);
+
         /* Now we have to do a PORT_RESET command.  */
         port_status =  hcd -> ux_hcd_entry_function(hcd, UX_HCD_RESET_PORT, (VOID *)((ALIGN_TYPE)port_index));
         if (port_status == UX_SUCCESS)
         {
+            UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_RESET);
 
             /* The port reset phase was successful. Before we invoke the device enumeration function,
                we need to know the speed of the device.  */
@@ -43,7 +43,7 @@ static inline VOID _ux_host_stack_pending_transfers_run(VOID);
 /*  FUNCTION                                                 RELEASE      */
 /*                                                                        */
 /*    _ux_host_stack_tasks_run                              PORTABLE C    */
-/*                                                             6.3.0      */
+/*                                                             6.x        */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -84,9 +84,12 @@ static inline VOID _ux_host_stack_pending_transfers_run(VOID);
 /*    _ux_host_stack_interfaces_scan        Parse interfaces in a         */
 /*                                          configuration                 */
 /*    _ux_host_stack_device_remove          Remove a device               */
-/*    _ux_utility_descriptor_parse          Parse a descriptor            */
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_descriptor_unpack_device  Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate memory               */
 /*    _ux_utility_memory_free               Free memory                   */
+/*    _ux_utility_memory_steady_state_enter Enter memory steady state     */
 /*    _ux_utility_time_get                  Get current time tick         */
 /*    _ux_system_error_handler              Error trap                    */
 /*                                                                        */
@@ -112,6 +115,14 @@ static inline VOID _ux_host_stack_pending_transfers_run(VOID);
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved enum transfer,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            entered memory steady state */
+/*                                            after enumeration,          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            added trace ring events,    */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_host_stack_tasks_run(VOID)
@@ -227,10 +238,7 @@ static inline VOID _ux_host_stack_enum_configuration_descriptor_parse0(
     _ux_host_stack_new_configuration_create(device, configuration);
 
     /* The descriptor is in a packed format, parse it locally.  */
-    _ux_utility_descriptor_parse(descriptor,
-        _ux_system_configuration_descriptor_structure,
-        UX_CONFIGURATION_DESCRIPTOR_ENTRIES,
-        (UCHAR *) &configuration -> ux_configuration_descriptor);
+    _ux_utility_descriptor_unpack_configuration(descriptor, &configuration -> ux_configuration_descriptor);
 }
 static inline UINT _ux_host_stack_enum_configuration_read(UX_DEVICE *device)
 {
@@ -483,6 +491,9 @@ INT                     immediate_state = UX_TRUE;
             device -> ux_device_enum_next_state = UX_HOST_STACK_ENUM_PORT_ENABLE;
             device -> ux_device_enum_port_status = UX_PS_CCS;
 
+            /* Record the first enumeration attempt.  */
+            UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_EVENT_ATTEMPT);
+
             /* Fall through.  */
         case UX_HOST_STACK_ENUM_PORT_ENABLE:
 
@@ -494,6 +505,7 @@ INT                     immediate_state = UX_TRUE;
             {
 
                 /* Issue a port reset on hub side.  */
+                UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_DEBOUNCE);
                 device -> ux_device_flags |= UX_DEVICE_FLAG_RESET;
                 device -> ux_device_enum_state = UX_HOST_STACK_ENUM_HUB_OPERATION_WAIT;
                 return;
@@ -527,6 +539,9 @@ INT                     immediate_state = UX_TRUE;
 
         case UX_HOST_STACK_ENUM_PORT_RESET:
 
+            /* Connection is stable after the first wait.  */
+            UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_DEBOUNCE);
+
             /* Reset may blocking, wait the reset done.  */
             /* Fall through.  */
         case UX_HOST_STACK_ENUM_PORT_RESET_WAIT:
@@ -555,6 +570,7 @@ INT                     immediate_state = UX_TRUE;
             /* Ready for next state.  */
             if (status == UX_STATE_NEXT)
             {
+                UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_RESET);
 
                 /* Return device address to 0.  */
 #if UX_MAX_DEVICES > 1
@@ -646,6 +662,9 @@ INT                     immediate_state = UX_TRUE;
 
         case UX_HOST_STACK_ENUM_DEVICE_DESCR_READ:
 
+            /* Address is accepted after the wait.  */
+            UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_ADDRESS_SET);
+
             /* Start GetDescriptor(Device).  */
             status = _ux_host_stack_device_descriptor_read(device);
             if (status != UX_SUCCESS)
@@ -717,12 +736,15 @@ INT                     immediate_state = UX_TRUE;
             }
 
             /* Parse the device descriptor.  */
-            _ux_utility_descriptor_parse(buffer,
-                _ux_system_device_descriptor_structure, UX_DEVICE_DESCRIPTOR_ENTRIES,
-                (UCHAR *) &device -> ux_device_descriptor);
+            _ux_utility_descriptor_unpack_device(buffer, &device -> ux_device_descriptor);
             _ux_utility_memory_free(buffer);
             trans -> ux_transfer_request_data_pointer = UX_NULL;
 
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_INSERT(UX_TRACE_RING_HOST_DEVICE_DESCRIPTOR_READ, device -> ux_device_address,
+                                 device -> ux_device_descriptor.idVendor, device -> ux_device_descriptor.idProduct)
+            UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_DEVICE_DESCRIPTOR);
+
             /* Start configuration enumeration, from index 0.  */
             device -> ux_device_enum_index = 0;
 
@@ -831,6 +853,7 @@ INT                     immediate_state = UX_TRUE;
             }
 
             /* All configurations are enumerated.  */
+            UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_CONFIGURATION_DESCRIPTOR);
             _ux_host_stack_configuration_parsed(device);
 
             /* Roll back to next state.  */
@@ -881,6 +904,7 @@ INT                     immediate_state = UX_TRUE;
             configuration = device -> ux_device_enum_inst.configuration;
             device -> ux_device_state = UX_DEVICE_CONFIGURED;
             device -> ux_device_current_configuration = configuration;
+            UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_CONFIGURATION_SET);
 
             /* Create the configuration instance.  */
             status =  _ux_host_stack_configuration_instance_create(configuration);
@@ -1049,6 +1073,9 @@ INT                     immediate_state = UX_TRUE;
             {
                 device -> ux_device_enum_retry --;
 
+                /* Record the next enumeration attempt.  */
+                UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_EVENT_ATTEMPT);
+
                 /* Check if there is unnecessary resource to free.  */
                 if (device -> ux_device_packed_configuration &&
                     device -> ux_device_packed_configuration_keep_count == 0)
@@ -1086,6 +1113,17 @@ INT                     immediate_state = UX_TRUE;
 
             /* Fall through.  */
         case UX_HOST_STACK_ENUM_DONE:
+
+            /* Classes are activated if enumeration did not fail.  */
+            if (device -> ux_device_enum_state == UX_HOST_STACK_ENUM_DONE)
+            {
+                UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_CLASS_ACTIVATE);
+
+                /* Enumeration is done, allocations are not expected any more once
+                   the classes are activated. Classes that still allocate from their
+                   tasks hold steady state off until they are done.  */
+                UX_MEMORY_STEADY_STATE_ENTER(UX_MEMORY_STEADY_STATE_HOST);
+            }
             _ux_host_stack_device_enumerated(device);
 
             /* We are done now.  */
@@ -0,0 +1,107 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_transfer_queue_add                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function adds a bulk or interrupt transfer request to the      */
+/*    transfer queue of its endpoint. If the queue was empty, the transfer*/
+/*    request is the first one and must be started with the controller,   */
+/*    otherwise it waits for the transfer requests before it to complete. */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if first of the queue                                       */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_transfer_queue_add(UX_TRANSFER *transfer_request)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_ENDPOINT     *endpoint;
+UINT            first;
+
+
+    /* Get the endpoint of the transfer request.  */
+    endpoint =  transfer_request -> ux_transfer_request_endpoint;
+
+    /* This is the last transfer request of the queue.  */
+    transfer_request -> ux_transfer_request_next_transfer_request =  UX_NULL;
+
+    UX_DISABLE
+
+    /* Link the transfer request at the end of the queue.  */
+    if (endpoint -> ux_endpoint_transfer_queue_tail == UX_NULL)
+    {
+        endpoint -> ux_endpoint_transfer_queue_head =  transfer_request;
+        first =  UX_TRUE;
+    }
+    else
+    {
+        endpoint -> ux_endpoint_transfer_queue_tail -> ux_transfer_request_next_transfer_request =  transfer_request;
+        first =  UX_FALSE;
+    }
+    endpoint -> ux_endpoint_transfer_queue_tail =  transfer_request;
+
+    UX_RESTORE
+
+    /* Return if the transfer request must be started.  */
+    return(first);
+}
+#endif
@@ -0,0 +1,155 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_transfer_queue_next                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function is called by the controller drivers when a transfer   */
+/*    request completes, before the class is notified. If the transfer    */
+/*    request is the first one of its endpoint queue, it is removed and   */
+/*    the next transfer request of the queue is started with the          */
+/*    controller, so the endpoint has no idle time between completions.   */
+/*                                                                        */
+/*    A transfer request the controller refuses completes with the error  */
+/*    and the one after it is started.                                    */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    HCD Entry Function                                                  */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_stack_transfer_queue_next(UX_TRANSFER *transfer_request)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_ENDPOINT     *endpoint;
+UX_TRANSFER     *next_transfer_request;
+UX_HCD          *hcd;
+UINT            status;
+
+
+    /* Get the endpoint of the transfer request.  */
+    endpoint =  transfer_request -> ux_transfer_request_endpoint;
+
+    UX_DISABLE
+
+    /* Only the first transfer request of the queue is with the controller.  */
+    if (endpoint -> ux_endpoint_transfer_queue_head != transfer_request)
+    {
+        UX_RESTORE
+        return;
+    }
+
+    /* Remove it, the next one is the first now.  */
+    next_transfer_request =  transfer_request -> ux_transfer_request_next_transfer_request;
+    transfer_request -> ux_transfer_request_next_transfer_request =  UX_NULL;
+    endpoint -> ux_endpoint_transfer_queue_head =  next_transfer_request;
+    if (next_transfer_request == UX_NULL)
+        endpoint -> ux_endpoint_transfer_queue_tail =  UX_NULL;
+
+    UX_RESTORE
+
+    /* With the device we have the pointer to the HCD.  */
+    hcd = UX_DEVICE_HCD_GET(endpoint -> ux_endpoint_device);
+
+    /* Start the next transfer request.  */
+    while (next_transfer_request != UX_NULL)
+    {
+
+        /* Write back the data buffer before the controller accesses it.  */
+        UX_TRANSFER_DATA_CACHE_CLEAN(next_transfer_request);
+
+        /* Send the command to the controller.  */
+        status =  hcd -> ux_hcd_entry_function(hcd, UX_HCD_TRANSFER_REQUEST, next_transfer_request);
+        if (status == UX_SUCCESS)
+            return;
+
+        /* The controller refused it, remove it from the queue.  */
+        transfer_request =  next_transfer_request;
+        UX_DISABLE
+        if (endpoint -> ux_endpoint_transfer_queue_head == transfer_request)
+        {
+            endpoint -> ux_endpoint_transfer_queue_head =  transfer_request -> ux_transfer_request_next_transfer_request;
+            if (endpoint -> ux_endpoint_transfer_queue_head == UX_NULL)
+                endpoint -> ux_endpoint_transfer_queue_tail =  UX_NULL;
+        }
+        transfer_request -> ux_transfer_request_next_transfer_request =  UX_NULL;
+        next_transfer_request =  endpoint -> ux_endpoint_transfer_queue_head;
+        UX_RESTORE
+
+        /* And complete it with the error.  */
+        transfer_request -> ux_transfer_request_completion_code =  status;
+
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                    transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+        /* Count the transfer completion in the endpoint statistics.  */
+        UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+        /* We may do a call back.  */
+        if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
+            transfer_request -> ux_transfer_request_completion_function(transfer_request);
+
+        /* Wake up the semaphore for this request.  */
+        _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+    }
+}
+#endif
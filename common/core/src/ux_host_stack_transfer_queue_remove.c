@@ -0,0 +1,116 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_transfer_queue_remove                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function removes a transfer request waiting in the transfer    */
+/*    queue of its endpoint. The first transfer request of the queue is   */
+/*    with the controller and is not removed.                             */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if removed                                                  */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_transfer_queue_remove(UX_TRANSFER *transfer_request)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_ENDPOINT     *endpoint;
+UX_TRANSFER     *previous_transfer_request;
+
+
+    /* Get the endpoint of the transfer request.  */
+    endpoint =  transfer_request -> ux_transfer_request_endpoint;
+
+    UX_DISABLE
+
+    /* The first transfer request is not waiting.  */
+    previous_transfer_request =  endpoint -> ux_endpoint_transfer_queue_head;
+    if ((previous_transfer_request == UX_NULL) || (previous_transfer_request == transfer_request))
+    {
+        UX_RESTORE
+        return(UX_FALSE);
+    }
+
+    /* Find the transfer request before it.  */
+    while ((previous_transfer_request -> ux_transfer_request_next_transfer_request != UX_NULL) &&
+           (previous_transfer_request -> ux_transfer_request_next_transfer_request != transfer_request))
+        previous_transfer_request =  previous_transfer_request -> ux_transfer_request_next_transfer_request;
+
+    /* Not in the queue.  */
+    if (previous_transfer_request -> ux_transfer_request_next_transfer_request == UX_NULL)
+    {
+        UX_RESTORE
+        return(UX_FALSE);
+    }
+
+    /* Unlink it.  */
+    previous_transfer_request -> ux_transfer_request_next_transfer_request =  transfer_request -> ux_transfer_request_next_transfer_request;
+    if (endpoint -> ux_endpoint_transfer_queue_tail == transfer_request)
+        endpoint -> ux_endpoint_transfer_queue_tail =  previous_transfer_request;
+    transfer_request -> ux_transfer_request_next_transfer_request =  UX_NULL;
+
+    UX_RESTORE
+
+    /* The transfer request is removed.  */
+    return(UX_TRUE);
+}
+#endif
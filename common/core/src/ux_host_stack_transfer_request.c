@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request                     PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,10 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    HCD Entry Function                                                  */ 
+/*    _ux_host_stack_transfer_queue_add     Add to endpoint queue         */
+/*    _ux_host_stack_transfer_queue_next    Start next queued transfer    */
+/*    _ux_host_stack_transfer_segments_check                              */
+/*                                          Check transfer segments       */
 /*    _ux_utility_semaphore_put             Put semaphore                 */
 /*    _ux_utility_semaphore_get             Get semaphore                 */
 /*                                                                        */ 
@@ -87,6 +91,16 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            maintenance,                */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_transfer_request(UX_TRANSFER *transfer_request)
@@ -94,6 +108,14 @@ UINT  _ux_host_stack_transfer_request(UX_TRANSFER *transfer_request)
 #if defined(UX_HOST_STANDALONE)
 UINT        status;
 
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+    /* Check the segments of a scatter-gather transfer.  */
+    status =  _ux_host_stack_transfer_segments_check(transfer_request);
+    if (status != UX_SUCCESS)
+        return(status);
+#endif
+
     UX_TRANSFER_STATE_RESET(transfer_request);
     _ux_host_stack_transfer_run(transfer_request);
     if ((transfer_request -> ux_transfer_request_flags & UX_TRANSFER_FLAG_AUTO_WAIT))
@@ -130,6 +152,14 @@ UX_HCD          *hcd;
 UINT            status;
     
 
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+    /* Check the segments of a scatter-gather transfer.  */
+    status =  _ux_host_stack_transfer_segments_check(transfer_request);
+    if (status != UX_SUCCESS)
+        return(status);
+#endif
+
     /* Get the endpoint container from the transfer_request */
     endpoint =  transfer_request -> ux_transfer_request_endpoint;
 
@@ -180,10 +210,26 @@ UINT            status;
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_TRANSFER_REQUEST, device, endpoint, transfer_request, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
+
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_SUBMIT, transfer_request, transfer_request -> ux_transfer_request_requested_length, 0)
+
+    /* Count the transfer submission in the endpoint statistics.  */
+    UX_TRANSFER_STATISTICS_SUBMIT(transfer_request);
     
     /* With the device we have the pointer to the HCD.  */
     hcd = UX_DEVICE_HCD_GET(device);
 
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+
+    /* Bulk and interrupt transfers are queued on the endpoint. If the endpoint is busy,
+       the transfer is started when the ones before it complete.  */
+    if ((((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_BULK_ENDPOINT) ||
+         ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_INTERRUPT_ENDPOINT)) &&
+        (_ux_host_stack_transfer_queue_add(transfer_request) == UX_FALSE))
+        return(UX_SUCCESS);
+#endif
+
     /* If this is endpoint 0, we protect the endpoint from a possible re-entry.  */
     if ((endpoint -> ux_endpoint_descriptor.bEndpointAddress & (UINT)~UX_ENDPOINT_DIRECTION) == 0)
     {
@@ -203,9 +249,19 @@ UINT            status;
         }        
     }             
     
+    /* Write back the data buffer before the controller accesses it.  */
+    UX_TRANSFER_DATA_CACHE_CLEAN(transfer_request);
+
     /* Send the command to the controller.  */    
     status =  hcd -> ux_hcd_entry_function(hcd, UX_HCD_TRANSFER_REQUEST, transfer_request);
 
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+
+    /* If the controller refused it, the transfer leaves the endpoint queue.  */
+    if (status != UX_SUCCESS)
+        _ux_host_stack_transfer_queue_next(transfer_request);
+#endif
+
     /* If this is endpoint 0, we unprotect the endpoint. */
     if ((endpoint -> ux_endpoint_descriptor.bEndpointAddress & (UINT)~UX_ENDPOINT_DIRECTION) == 0)
 
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request_abort               PORTABLE C      */ 
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,8 @@
 /*                                                                        */ 
 /*    HCD Entry Function                                                  */ 
 /*    Transfer Completion Function                                        */ 
+/*    _ux_host_stack_transfer_queue_next    Start next queued transfer    */
+/*    _ux_host_stack_transfer_queue_remove  Remove from endpoint queue    */
 /*    _ux_utility_semaphore_put             Put semaphore                 */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -84,6 +86,12 @@
 /*                                            resulting in version 6.1.10 */
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_transfer_request_abort(UX_TRANSFER *transfer_request)
@@ -106,6 +114,12 @@ ULONG           completion_code;
     if (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_STATUS_PENDING)
     {
 
+#if defined(UX_HOST_ENDPOINT_TRANSFER_QUEUE) && !defined(UX_HOST_STANDALONE)
+
+        /* A transfer waiting in the endpoint queue is not with the controller.  */
+        if (_ux_host_stack_transfer_queue_remove(transfer_request) == UX_FALSE)
+#endif
+
         /* Send the abort command to the controller.  */    
         hcd -> ux_hcd_entry_function(hcd, UX_HCD_TRANSFER_ABORT, transfer_request);
 
@@ -123,6 +137,16 @@ ULONG           completion_code;
         /* Set the transfer_request status to abort.  */
         transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_STATUS_ABORT;
 
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                    UX_TRANSFER_STATUS_ABORT, transfer_request -> ux_transfer_request_actual_length)
+
+        /* Count the transfer completion in the endpoint statistics.  */
+        UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+        /* Start the next transfer queued on the endpoint.  */
+        UX_TRANSFER_QUEUE_NEXT(transfer_request);
+
         /* We need to inform the class that owns this transfer_request of the 
            abort if there is a call back mechanism.  */
         if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
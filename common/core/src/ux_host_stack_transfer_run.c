@@ -43,7 +43,7 @@ static inline void _ux_host_stack_transfer_retire(UX_TRANSFER *transfer);
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_stack_transfer_run                         PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -85,6 +85,12 @@ static inline void _ux_host_stack_transfer_retire(UX_TRANSFER *transfer);
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  01-31-2022     Chaoqiong Xiao           Initial Version 6.1.10        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            maintenance,                */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_transfer_run(UX_TRANSFER *transfer_request)
@@ -155,6 +161,15 @@ UINT            status;
         transfer_request -> ux_transfer_request_state = UX_STATE_WAIT;
         transfer_request -> ux_transfer_request_time_start = _ux_utility_time_get();
 
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_SUBMIT, transfer_request, transfer_request -> ux_transfer_request_requested_length, 0)
+
+        /* Count the transfer submission in the endpoint statistics.  */
+        UX_TRANSFER_STATISTICS_SUBMIT(transfer_request);
+
+        /* Write back the data buffer before the controller accesses it.  */
+        UX_TRANSFER_DATA_CACHE_CLEAN(transfer_request);
+
         /* Add request to system pending request list. Note request may be kept
            if transfer callback is used.  */
         if (_ux_host_stack_transfer_locate(transfer_request, UX_NULL) <
@@ -199,6 +214,7 @@ UINT            status;
                 
                 /* Set the completion code.  */
                 transfer_request -> ux_transfer_request_completion_code = UX_TRANSFER_TIMEOUT;
+                UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
         
                 /* There was an error: simplify to idle.  */
                 UX_DISABLE
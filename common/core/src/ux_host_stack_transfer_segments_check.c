@@ -0,0 +1,138 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_stack_transfer_segments_check              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function checks the segments of a scatter-gather transfer      */
+/*    request. Only bulk endpoints take segments. Each segment but the    */
+/*    last must be a whole number of packets, so that the controller never*/
+/*    sends or expects a short packet between two segments. The requested */
+/*    length is set to the total length of the segments.                  */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_system_error_handler              Log system error              */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    USBX Components                                                     */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_transfer_segments_check(UX_TRANSFER *transfer_request)
+{
+
+UX_ENDPOINT             *endpoint;
+UX_TRANSFER_SEGMENT     *segment;
+ULONG                   segment_index;
+ULONG                   total_length;
+
+
+    /* Nothing to check for a contiguous buffer.  */
+    if (transfer_request -> ux_transfer_request_segment_count == 0)
+        return(UX_SUCCESS);
+
+    /* Get the endpoint container from the transfer_request.  */
+    endpoint =  transfer_request -> ux_transfer_request_endpoint;
+
+    /* Only bulk transfers are described by segments.  */
+    if (((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) != UX_BULK_ENDPOINT) ||
+        (transfer_request -> ux_transfer_request_segments == UX_NULL) ||
+        (transfer_request -> ux_transfer_request_packet_length == 0))
+    {
+
+        /* Error trap.  */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HOST_STACK, UX_INVALID_PARAMETER);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_INVALID_PARAMETER, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_INVALID_PARAMETER);
+    }
+
+    /* Add up the segments.  */
+    total_length =  0;
+    segment =  transfer_request -> ux_transfer_request_segments;
+    for (segment_index = 0; segment_index < transfer_request -> ux_transfer_request_segment_count; segment_index++)
+    {
+
+        /* Empty segments are not allowed, and all the segments but the last one
+           must end on a packet boundary.  */
+        if ((segment -> ux_transfer_segment_length == 0) ||
+            ((segment_index + 1 < transfer_request -> ux_transfer_request_segment_count) &&
+             (segment -> ux_transfer_segment_length % transfer_request -> ux_transfer_request_packet_length) != 0) ||
+            (UX_OVERFLOW_CHECK_ADD_ULONG(total_length, segment -> ux_transfer_segment_length)))
+        {
+
+            /* Error trap.  */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HOST_STACK, UX_INVALID_PARAMETER);
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_INVALID_PARAMETER, transfer_request, segment_index, 0, UX_TRACE_ERRORS, 0, 0)
+
+            return(UX_INVALID_PARAMETER);
+        }
+
+        total_length +=  segment -> ux_transfer_segment_length;
+        segment++;
+    }
+
+    /* The transfer request covers all the segments, starting with the first one.  */
+    transfer_request -> ux_transfer_request_data_pointer =      transfer_request -> ux_transfer_request_segments -> ux_transfer_segment_data_pointer;
+    transfer_request -> ux_transfer_request_requested_length =  total_length;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_system_error_handler                            PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring event,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID   _ux_system_error_handler(UINT system_level, UINT system_context, UINT error_code)
@@ -78,6 +81,9 @@ VOID   _ux_system_error_handler(UINT system_level, UINT system_context, UINT err
     /* Increment the total number of system errors.  */
     _ux_system -> ux_system_error_count++;
 
+    /* If trace ring is enabled, insert this error into the ring.  */
+    UX_TRACE_RING_INSERT(UX_TRACE_RING_ERROR, system_level, system_context, error_code)
+
     /* Is there an application call back function to call ? */
     if (_ux_system -> ux_system_error_callback_function != UX_NULL)
     {    
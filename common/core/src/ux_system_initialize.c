@@ -68,7 +68,7 @@ UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_system_initialize                               PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -94,6 +94,7 @@ UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1
 /*    _ux_utility_memory_allocate           Allocate memory               */
 /*    _ux_utility_memory_set                Set memory                    */
 /*    _ux_utility_mutex_create              Create mutex                  */
+/*    _ux_utility_mutex_delete              Delete mutex                  */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -119,6 +120,13 @@ UCHAR _ux_system_container_id_descriptor_structure[] =                      {1,1
 /*                                            added UX_ASSERT check for   */
 /*                                            STD descriptor parse size,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            created memory pool         */
+/*                                            mutexes,                    */
+/*                                            allocated memory profilers, */
+/*                                            allocated binary debug log  */
+/*                                            records,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_system_initialize(VOID *regular_memory_pool_start, ULONG regular_memory_size,
@@ -132,6 +140,14 @@ ULONG               memory_pool_offset;
 UINT                status;
 #endif
 ULONG               pool_size;
+#ifdef UX_ENABLE_MEMORY_PROFILER
+UX_MEMORY_PROFILER  *profiler_ptr;
+ULONG               pool_index;
+ULONG               pools;
+#endif
+#ifdef UX_ENABLE_DEBUG_LOG
+ULONG               records;
+#endif
 
     /* Check if the regular memory pool is valid.  */
     if ((regular_memory_pool_start == UX_NULL) || (regular_memory_size == 0))
@@ -252,6 +268,23 @@ ULONG               pool_size;
                                             (UX_MEMORY_BYTE_POOL *)int_memory_pool_start, pool_size);
     }
 
+#if !defined(UX_STANDALONE)
+
+    /* Create the Mutex objects used to protect the memory pools.  */
+    status =  _ux_system_mutex_create(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex, "ux_byte_pool_regular_mutex");
+    if(status != UX_SUCCESS)
+        return(UX_MUTEX_ERROR);
+    if (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+    {
+        status =  _ux_system_mutex_create(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] -> ux_byte_pool_mutex, "ux_byte_pool_cache_safe_mutex");
+        if(status != UX_SUCCESS)
+        {
+            _ux_system_mutex_delete(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex);
+            return(UX_MUTEX_ERROR);
+        }
+    }
+#endif
+
 #ifdef UX_ENABLE_MEMORY_STATISTICS
     _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_min_free =
             _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available;
@@ -261,6 +294,26 @@ ULONG               pool_size;
     /* Other fields are kept zero.  */
 #endif
 
+#ifdef UX_ENABLE_MEMORY_PROFILER
+
+    /* Obtain memory for the profiler of each pool, from the regular pool. The
+       profilers are attached after allocation, their memory is not profiled.  */
+    if (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] == _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+        pools =  1;
+    else
+        pools =  UX_MEMORY_BYTE_POOL_NUM;
+    profiler_ptr =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_MEMORY_PROFILER), pools);
+    if (profiler_ptr == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Tag 0 is for blocks with no owner.  */
+    for (pool_index = 0; pool_index < pools; pool_index ++)
+    {
+        profiler_ptr[pool_index].ux_memory_profiler_tags_count =  1;
+        _ux_system -> ux_system_memory_byte_pool[pool_index] -> ux_byte_pool_profiler =  &profiler_ptr[pool_index];
+    }
+#endif
+
 #ifdef UX_ENABLE_DEBUG_LOG
 
     /* Obtain memory for storing the debug log.  */
@@ -268,13 +321,15 @@ ULONG               pool_size;
     if (_ux_system -> ux_system_debug_log_buffer == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
-    /* Setup the head and tail pointers.  */
-    _ux_system -> ux_system_debug_log_head = _ux_system -> ux_system_debug_log_buffer;
-    _ux_system -> ux_system_debug_log_tail = _ux_system -> ux_system_debug_log_buffer;
-
     /* Keep the size in system structure variable.  */
     _ux_system -> ux_system_debug_log_size = UX_DEBUG_LOG_SIZE;
 
+    /* The number of records is rounded down to a power of 2, the log is a ring.  */
+    records =  (ULONG)(UX_DEBUG_LOG_SIZE / sizeof(UX_DEBUG_LOG_RECORD));
+    while (records & (records - 1))
+        records &= records - 1;
+    _ux_system -> ux_system_debug_log_records = records;
+
 #endif
 
 #if !defined(UX_STANDALONE)
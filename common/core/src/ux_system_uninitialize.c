@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_system_uninitialize                             PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -68,6 +68,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            deleted memory pool         */
+/*                                            mutexes,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_system_uninitialize(VOID)
@@ -76,6 +80,14 @@ UINT  _ux_system_uninitialize(VOID)
     /* Delete the Mutex object used by USBX to control critical sections.  */
     _ux_system_mutex_delete(&_ux_system -> ux_system_mutex);
 
+#if !defined(UX_STANDALONE)
+
+    /* Delete the Mutex objects used to protect the memory pools.  */
+    if (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+        _ux_system_mutex_delete(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] -> ux_byte_pool_mutex);
+    _ux_system_mutex_delete(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex);
+#endif
+
     return(UX_SUCCESS);
 }
 
@@ -0,0 +1,193 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Trace                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_utility.h"
+
+
+#if defined(UX_ENABLE_TRACE_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_trace_ring_dump                                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies the trace ring into a binary image (see        */
+/*    UX_TRACE_RING_DUMP_MAGIC) which can be saved or sent to a host by   */
+/*    the application, and decoded there by                               */
+/*    utility/trace_ring/ux_trace_ring_decode.                            */
+/*                                                                        */
+/*    The image has a header, then the committed entries of each ring,    */
+/*    oldest first. Events keep being inserted while the ring is copied:  */
+/*    an entry is skipped if it is being written or has been overwritten, */
+/*    it is counted as lost with the entries overwritten before the copy. */
+/*                                                                        */
+/*    If the buffer is too small, nothing more is copied and the length   */
+/*    needed is returned. The buffer can be UX_NULL to get the length     */
+/*    needed for full rings.                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer                                Pointer to buffer             */
+/*    buffer_length                         Length of buffer              */
+/*    actual_length                         Pointer to length of image    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_put                  Put 32-bit value              */
+/*    _ux_utility_short_put                 Put 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_trace_ring_dump(UCHAR *buffer, ULONG buffer_length, ULONG *actual_length)
+{
+
+UX_TRACE_RING_CORE      *ring;
+UX_TRACE_RING_ENTRY     *entry;
+UCHAR                   *record_ptr;
+ULONG                   length;
+ULONG                   entries;
+ULONG                   core;
+ULONG                   index;
+ULONG                   first;
+ULONG                   last;
+ULONG                   sequence;
+ULONG                   copied =  0;
+ULONG                   lost =  0;
+ULONG                   timestamp;
+ULONG                   event_id;
+ULONG                   info_1;
+ULONG                   info_2;
+ULONG                   info_3;
+
+
+    /* Sanity check.  */
+    if (actual_length == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Only the length for full rings is returned if there is no buffer.  */
+    entries =  _ux_trace_ring.ux_trace_ring_entries;
+    if (buffer == UX_NULL)
+    {
+        *actual_length =  UX_TRACE_RING_DUMP_HEADER_LENGTH +
+                          entries * UX_TRACE_RING_CORE_NUM * UX_TRACE_RING_DUMP_ENTRY_LENGTH;
+        return(UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* Entries follow the header.  */
+    length =  UX_TRACE_RING_DUMP_HEADER_LENGTH;
+    for (core = 0; (entries != 0) && (core < UX_TRACE_RING_CORE_NUM); core ++)
+    {
+
+        /* Get the entries of the ring, the oldest ones have been overwritten.  */
+        ring =  &_ux_trace_ring.ux_trace_ring_cores[core];
+        last =  ring -> ux_trace_ring_core_index;
+        UX_DATA_MEMORY_BARRIER
+        first =  (last > entries) ? last - entries : 0;
+        lost +=  first;
+
+        for (index = first; index != last; index ++)
+        {
+
+            /* Copy the entry between two reads of its sequence.  */
+            entry =  &ring -> ux_trace_ring_core_entries[index & (entries - 1)];
+            sequence =  entry -> ux_trace_ring_entry_sequence;
+            UX_DATA_MEMORY_BARRIER
+            timestamp =  entry -> ux_trace_ring_entry_timestamp;
+            event_id =  entry -> ux_trace_ring_entry_event;
+            info_1 =  entry -> ux_trace_ring_entry_info_1;
+            info_2 =  entry -> ux_trace_ring_entry_info_2;
+            info_3 =  entry -> ux_trace_ring_entry_info_3;
+            UX_DATA_MEMORY_BARRIER
+
+            /* Skip the entry if it is being written or has been overwritten.  */
+            if ((sequence != index + 1) || (entry -> ux_trace_ring_entry_sequence != sequence))
+            {
+                lost ++;
+                continue;
+            }
+
+            /* Check if the entry fits in buffer.  */
+            if (length + UX_TRACE_RING_DUMP_ENTRY_LENGTH <= buffer_length)
+            {
+                record_ptr =  buffer + length;
+                _ux_utility_long_put(record_ptr, sequence);
+                _ux_utility_long_put(record_ptr + 4, timestamp);
+                _ux_utility_short_put(record_ptr + 8, (USHORT)event_id);
+                record_ptr[10] =  (UCHAR)(event_id >> 16);
+                record_ptr[11] =  0;
+                _ux_utility_long_put(record_ptr + 12, info_1);
+                _ux_utility_long_put(record_ptr + 16, info_2);
+                _ux_utility_long_put(record_ptr + 20, info_3);
+                copied ++;
+            }
+            length +=  UX_TRACE_RING_DUMP_ENTRY_LENGTH;
+        }
+    }
+
+    /* Image header.  */
+    if (UX_TRACE_RING_DUMP_HEADER_LENGTH <= buffer_length)
+    {
+        _ux_utility_long_put(buffer, UX_TRACE_RING_DUMP_MAGIC);
+        _ux_utility_short_put(buffer + 4, UX_TRACE_RING_DUMP_VERSION);
+        _ux_utility_short_put(buffer + 6, UX_TRACE_RING_DUMP_HEADER_LENGTH);
+        _ux_utility_short_put(buffer + 8, UX_TRACE_RING_CORE_NUM);
+        _ux_utility_short_put(buffer + 10, UX_TRACE_RING_DUMP_ENTRY_LENGTH);
+        _ux_utility_long_put(buffer + 12, (ULONG)UX_TRACE_RING_TIMESTAMP_FREQUENCY);
+        _ux_utility_long_put(buffer + 16, _ux_trace_ring.ux_trace_ring_filter);
+        _ux_utility_long_put(buffer + 20, entries);
+        _ux_utility_long_put(buffer + 24, copied);
+        _ux_utility_long_put(buffer + 28, lost);
+    }
+
+    /* Return the image length.  */
+    *actual_length =  length;
+
+    /* Check if everything is copied.  */
+    if (length > buffer_length)
+        return(UX_MEMORY_INSUFFICIENT);
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,140 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Trace                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_utility.h"
+
+
+#if defined(UX_ENABLE_TRACE_RING)
+
+/* Define the trace ring control.  */
+
+UX_TRACE_RING   _ux_trace_ring;
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_trace_ring_enable                               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function enables the trace ring in a buffer provided by the    */
+/*    application, and sets the categories of events inserted (see        */
+/*    UX_TRACE_RING_TRANSFER ...). The buffer is shared by the rings of   */
+/*    all the cores, each ring has the same number of entries, a power of */
+/*    2. A UX_NULL buffer disables the trace ring.                        */
+/*                                                                        */
+/*    The trace ring can be enabled before ux_system_initialize to catch  */
+/*    the initialization events. It must not be enabled again while       */
+/*    events are inserted, use ux_trace_ring_filter_set to change the     */
+/*    categories.                                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer                                Pointer to ring buffer        */
+/*    buffer_size                           Size of ring buffer           */
+/*    filter                                Categories of events          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_trace_ring_enable(VOID *buffer, ULONG buffer_size, ULONG filter)
+{
+
+UX_TRACE_RING_ENTRY     *entry;
+ULONG                   entries;
+ULONG                   core;
+
+
+    /* Stop inserting events while the rings are changed.  */
+    _ux_trace_ring.ux_trace_ring_filter =  0;
+    _ux_trace_ring.ux_trace_ring_entries =  0;
+    UX_DATA_MEMORY_BARRIER
+
+    /* Check if the trace ring is disabled.  */
+    if (buffer == UX_NULL)
+    {
+
+        /* Detach the rings.  */
+        for (core = 0; core < UX_TRACE_RING_CORE_NUM; core ++)
+            _ux_trace_ring.ux_trace_ring_cores[core].ux_trace_ring_core_entries =  UX_NULL;
+        return(UX_SUCCESS);
+    }
+
+    /* The entries are accessed as words.  */
+    if (((ALIGN_TYPE)buffer) & (sizeof(ULONG) - 1))
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the number of entries of each ring, rounded down to a power of 2.  */
+    entries =  buffer_size / (ULONG)(sizeof(UX_TRACE_RING_ENTRY) * UX_TRACE_RING_CORE_NUM);
+    if (entries < 2)
+        return(UX_MEMORY_INSUFFICIENT);
+    while (entries & (entries - 1))
+        entries &=  entries - 1;
+
+    /* Reset the entries, a sequence of 0 marks an entry not written.  */
+    _ux_utility_memory_set(buffer, 0, entries * (ULONG)(sizeof(UX_TRACE_RING_ENTRY) * UX_TRACE_RING_CORE_NUM)); /* Use case of memset is verified. */
+
+    /* Attach the rings.  */
+    entry =  (UX_TRACE_RING_ENTRY *) buffer;
+    for (core = 0; core < UX_TRACE_RING_CORE_NUM; core ++)
+    {
+        _ux_trace_ring.ux_trace_ring_cores[core].ux_trace_ring_core_entries =  entry;
+        _ux_trace_ring.ux_trace_ring_cores[core].ux_trace_ring_core_index =  0;
+        entry +=  entries;
+    }
+    _ux_trace_ring.ux_trace_ring_entries =  entries;
+
+    /* Start inserting events once the rings are ready.  */
+    UX_DATA_MEMORY_BARRIER
+    _ux_trace_ring.ux_trace_ring_filter =  filter;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,83 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Trace                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#if defined(UX_ENABLE_TRACE_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_trace_ring_filter_set                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the categories of events inserted in the trace   */
+/*    ring (see UX_TRACE_RING_TRANSFER ...). It can be called at any time */
+/*    once the trace ring is enabled, 0 stops inserting events.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    filter                                Categories of events          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_trace_ring_filter_set(ULONG filter)
+{
+
+    /* Check if the trace ring is enabled.  */
+    if (_ux_trace_ring.ux_trace_ring_entries == 0)
+        return(UX_FUNCTION_NOT_SUPPORTED);
+
+    /* Set the new filter, it is checked before each event is inserted.  */
+    _ux_trace_ring.ux_trace_ring_filter =  filter;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,127 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Trace                                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_utility.h"
+
+
+#if defined(UX_ENABLE_TRACE_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_trace_ring_insert                               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function inserts an event into the trace ring of the running   */
+/*    core. It is called through UX_TRACE_RING_INSERT once the category   */
+/*    of the event passed the filter.                                     */
+/*                                                                        */
+/*    No lock is taken: the entry index is reserved with                  */
+/*    UX_TRACE_RING_INDEX_RESERVE, an atomic increment provided by the    */
+/*    port (interrupts are only locked around the increment if the port   */
+/*    does not provide it). The sequence of the entry is cleared while    */
+/*    the entry is written and set last, so a reader can discard an entry */
+/*    that is being written. When the ring is full, the oldest entry is   */
+/*    overwritten.                                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    event_id                              Event ID                      */
+/*    info_1                                Information field 1           */
+/*    info_2                                Information field 2           */
+/*    info_3                                Information field 3           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_time_get                  Get time (default timestamp)  */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_trace_ring_insert(ULONG event_id, ULONG info_1, ULONG info_2, ULONG info_3)
+{
+
+#if !defined(UX_TRACE_RING_INDEX_RESERVE)
+UX_INTERRUPT_SAVE_AREA
+#endif
+UX_TRACE_RING_CORE      *ring;
+UX_TRACE_RING_ENTRY     *entry;
+ULONG                   entries;
+ULONG                   core;
+ULONG                   index;
+
+
+    /* Get the ring of the running core.  */
+    core =  (ULONG)UX_TRACE_RING_CORE_GET();
+    entries =  _ux_trace_ring.ux_trace_ring_entries;
+    if ((entries == 0) || (core >= UX_TRACE_RING_CORE_NUM))
+        return;
+    ring =  &_ux_trace_ring.ux_trace_ring_cores[core];
+
+    /* Reserve an entry. An insert interrupted by another one keeps its own entry.  */
+#if defined(UX_TRACE_RING_INDEX_RESERVE)
+    index =  UX_TRACE_RING_INDEX_RESERVE(&ring -> ux_trace_ring_core_index);
+#else
+    UX_DISABLE
+    index =  ring -> ux_trace_ring_core_index ++;
+    UX_RESTORE
+#endif
+    entry =  &ring -> ux_trace_ring_core_entries[index & (entries - 1)];
+
+    /* Mark the entry as being written.  */
+    entry -> ux_trace_ring_entry_sequence =  0;
+    UX_DATA_MEMORY_BARRIER
+
+    /* Fill the entry.  */
+    entry -> ux_trace_ring_entry_timestamp =  (ULONG)UX_TRACE_RING_TIMESTAMP_GET();
+    entry -> ux_trace_ring_entry_event =  (event_id & 0xFFFFu) | (core << 16);
+    entry -> ux_trace_ring_entry_info_1 =  info_1;
+    entry -> ux_trace_ring_entry_info_2 =  info_2;
+    entry -> ux_trace_ring_entry_info_3 =  info_3;
+
+    /* Commit the entry.  */
+    UX_DATA_MEMORY_BARRIER
+    entry -> ux_trace_ring_entry_sequence =  index + 1;
+}
+#endif
@@ -0,0 +1,234 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_utility.h"
+
+
+#ifdef UX_ENABLE_DEBUG_LOG
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_debug_log_dump                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies the debug log into a binary image (see         */
+/*    UX_DEBUG_LOG_DUMP_MAGIC) which can be saved or sent to a host by    */
+/*    the application, and formatted there by                             */
+/*    utility/debug_log/ux_debug_log_decode.                              */
+/*                                                                        */
+/*    The image has a header, then the committed records, oldest first,   */
+/*    then the table of location and message strings they reference by    */
+/*    index. Strings are read from the pointers kept in the records, they */
+/*    are deduplicated by content and truncated to                        */
+/*    UX_DEBUG_LOG_STRING_LENGTH_MAX. Messages keep being logged while    */
+/*    the log is copied: a record is skipped if it is being written or    */
+/*    has been overwritten, it is counted as lost with the records        */
+/*    overwritten before the copy.                                        */
+/*                                                                        */
+/*    If the buffer is too small, nothing is copied and the maximum       */
+/*    length of the image is returned. The buffer can be UX_NULL to get   */
+/*    this length.                                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer                                Pointer to buffer             */
+/*    buffer_length                         Length of buffer              */
+/*    actual_length                         Pointer to length of image    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_put                  Put 32-bit value              */
+/*    _ux_utility_memory_compare            Compare memory                */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*    _ux_utility_short_put                 Put 16-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_debug_log_dump(UCHAR *buffer, ULONG buffer_length, ULONG *actual_length)
+{
+
+UX_DEBUG_LOG_RECORD     *record;
+UCHAR                   *record_ptr;
+UCHAR                   *strings_ptr;
+UCHAR                   *table_ptr;
+UCHAR                   *string[2];
+ULONG                   string_id[2];
+ULONG                   string_length;
+ULONG                   strings_length =  0;
+ULONG                   strings_count =  0;
+ULONG                   maximum_length;
+ULONG                   records;
+ULONG                   index;
+ULONG                   first;
+ULONG                   last;
+ULONG                   sequence;
+ULONG                   copied =  0;
+ULONG                   lost;
+ULONG                   timestamp;
+ULONG                   code;
+ULONG                   parameter_1;
+ULONG                   parameter_2;
+ULONG                   i;
+ULONG                   id;
+
+
+    /* Sanity check.  */
+    if (actual_length == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the records of the log, the oldest ones have been overwritten.  */
+    records =  _ux_system -> ux_system_debug_log_records;
+    last =  _ux_system -> ux_system_debug_count;
+    UX_DATA_MEMORY_BARRIER
+    first =  (last > records) ? last - records : 0;
+    lost =  first;
+
+    /* The image is at most the records with two different strings each.  */
+    maximum_length =  UX_DEBUG_LOG_DUMP_HEADER_LENGTH +
+                      (last - first) * (UX_DEBUG_LOG_DUMP_RECORD_LENGTH + 2 * (2 + UX_DEBUG_LOG_STRING_LENGTH_MAX));
+    if ((buffer == UX_NULL) ||
+        (buffer_length < UX_DEBUG_LOG_DUMP_HEADER_LENGTH + (last - first) * UX_DEBUG_LOG_DUMP_RECORD_LENGTH))
+    {
+        *actual_length =  maximum_length;
+        return(UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* Records follow the header, the string table is built after all of them.  */
+    record_ptr =  buffer + UX_DEBUG_LOG_DUMP_HEADER_LENGTH;
+    strings_ptr =  record_ptr + (last - first) * UX_DEBUG_LOG_DUMP_RECORD_LENGTH;
+    for (index = first; index != last; index ++)
+    {
+
+        /* Copy the record between two reads of its sequence.  */
+        record =  &_ux_system -> ux_system_debug_log_buffer[index & (records - 1)];
+        sequence =  record -> ux_debug_log_record_sequence;
+        UX_DATA_MEMORY_BARRIER
+        timestamp =  record -> ux_debug_log_record_timestamp;
+        string[0] =  record -> ux_debug_log_record_location;
+        string[1] =  record -> ux_debug_log_record_message;
+        code =  record -> ux_debug_log_record_code;
+        parameter_1 =  record -> ux_debug_log_record_parameter_1;
+        parameter_2 =  record -> ux_debug_log_record_parameter_2;
+        UX_DATA_MEMORY_BARRIER
+
+        /* Skip the record if it is being written or has been overwritten.  */
+        if ((sequence != index + 1) || (record -> ux_debug_log_record_sequence != sequence))
+        {
+            lost ++;
+            continue;
+        }
+
+        /* Find the strings in the table, add them if not found.  */
+        for (i = 0; i < 2; i ++)
+        {
+            string_id[i] =  0xFFFF;
+            if (string[i] == UX_NULL)
+                continue;
+
+            string_length =  0;
+            while ((string_length < UX_DEBUG_LOG_STRING_LENGTH_MAX) && (string[i][string_length] != 0))
+                string_length ++;
+
+            table_ptr =  strings_ptr;
+            for (id = 0; id < strings_count; id ++)
+            {
+                if ((_ux_utility_short_get(table_ptr) == string_length) &&
+                    (_ux_utility_memory_compare(table_ptr + 2, string[i], string_length) == UX_SUCCESS))
+                    break;
+                table_ptr +=  2 + _ux_utility_short_get(table_ptr);
+            }
+
+            if (id == strings_count)
+            {
+
+                /* Check if the string fits in buffer.  */
+                if ((ULONG)(table_ptr - buffer) + 2 + string_length > buffer_length)
+                {
+                    *actual_length =  maximum_length;
+                    return(UX_MEMORY_INSUFFICIENT);
+                }
+                _ux_utility_short_put(table_ptr, (USHORT)string_length);
+                _ux_utility_memory_copy(table_ptr + 2, string[i], string_length); /* Use case of memcpy is verified. */
+                strings_length +=  2 + string_length;
+                strings_count ++;
+            }
+            string_id[i] =  id;
+        }
+
+        /* Copy the record.  */
+        _ux_utility_long_put(record_ptr, sequence);
+        _ux_utility_long_put(record_ptr + 4, timestamp);
+        _ux_utility_short_put(record_ptr + 8, (USHORT)string_id[0]);
+        _ux_utility_short_put(record_ptr + 10, (USHORT)string_id[1]);
+        _ux_utility_long_put(record_ptr + 12, code);
+        _ux_utility_long_put(record_ptr + 16, parameter_1);
+        _ux_utility_long_put(record_ptr + 20, parameter_2);
+        record_ptr +=  UX_DEBUG_LOG_DUMP_RECORD_LENGTH;
+        copied ++;
+    }
+
+    /* Move the string table after the records copied.  */
+    for (i = 0; (record_ptr != strings_ptr) && (i < strings_length); i ++)
+        record_ptr[i] =  strings_ptr[i];
+
+    /* Image header.  */
+    _ux_utility_long_put(buffer, UX_DEBUG_LOG_DUMP_MAGIC);
+    _ux_utility_short_put(buffer + 4, UX_DEBUG_LOG_DUMP_VERSION);
+    _ux_utility_short_put(buffer + 6, UX_DEBUG_LOG_DUMP_HEADER_LENGTH);
+    _ux_utility_short_put(buffer + 8, UX_DEBUG_LOG_DUMP_RECORD_LENGTH);
+    _ux_utility_short_put(buffer + 10, (USHORT)strings_count);
+    _ux_utility_long_put(buffer + 12, (ULONG)UX_DEBUG_LOG_TIMESTAMP_FREQUENCY);
+    _ux_utility_long_put(buffer + 16, records);
+    _ux_utility_long_put(buffer + 20, copied);
+    _ux_utility_long_put(buffer + 24, lost);
+    _ux_utility_long_put(buffer + 28, strings_length);
+
+    /* Return the image length.  */
+    *actual_length =  (ULONG)(record_ptr - buffer) + strings_length;
+    return(UX_SUCCESS);
+}
+#endif
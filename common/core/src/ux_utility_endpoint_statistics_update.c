@@ -0,0 +1,121 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_endpoint_statistics_update              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function counts the completion of a transfer in the statistics */
+/*    of its endpoint. The latency from the submission of the transfer is */
+/*    counted in the log2 histogram. A successful transfer takes the      */
+/*    short path.                                                         */
+/*                                                                        */
+/*    It is called by the controller drivers and the device stack, in     */
+/*    interrupt or thread context.                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    statistics                            Pointer to statistics         */
+/*    completion_code                       Completion code               */
+/*    length                                Length transferred            */
+/*    start                                 Timestamp of submission       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_endpoint_statistics_update(UX_ENDPOINT_STATISTICS *statistics, ULONG completion_code,
+                                             ULONG length, ULONG start)
+{
+
+ULONG       latency;
+ULONG       bin;
+
+
+    /* Get the latency, timestamps wrap around.  */
+    latency =  (UX_ENDPOINT_STATISTICS_TIMESTAMP_GET() - start) & 0xFFFFFFFFu;
+    if (latency > statistics -> ux_endpoint_statistics_latency_max)
+        statistics -> ux_endpoint_statistics_latency_max =  latency;
+
+    /* Get the histogram bin, the bit length of the latency.  */
+#if defined(UX_ENDPOINT_STATISTICS_BIT_LENGTH)
+    bin =  UX_ENDPOINT_STATISTICS_BIT_LENGTH(latency);
+#else
+    for (bin = 0; latency != 0; bin ++)
+        latency >>=  1;
+#endif
+    if (bin >= UX_ENDPOINT_STATISTICS_LATENCY_BINS)
+        bin =  UX_ENDPOINT_STATISTICS_LATENCY_BINS - 1;
+    statistics -> ux_endpoint_statistics_latency[bin] ++;
+
+    /* Count the bytes transferred.  */
+    statistics -> ux_endpoint_statistics_completed ++;
+    statistics -> ux_endpoint_statistics_bytes +=  length;
+    if (completion_code == UX_SUCCESS)
+        return;
+
+    /* Aborts are not errors.  */
+    if (completion_code == UX_TRANSFER_STATUS_ABORT)
+    {
+        statistics -> ux_endpoint_statistics_aborts ++;
+        return;
+    }
+
+    /* Count the error, transfer errors are counted by code.  */
+    statistics -> ux_endpoint_statistics_errors ++;
+    if ((completion_code > 0x20) && (completion_code < 0x20 + UX_ENDPOINT_STATISTICS_ERROR_CODES))
+        statistics -> ux_endpoint_statistics_error_codes[completion_code - 0x20] ++;
+    else
+        statistics -> ux_endpoint_statistics_error_codes[0] ++;
+}
+#endif
@@ -31,7 +31,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_allocate                         PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,8 +53,16 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _ux_utility_memory_free_block_best_get Get best fit block of memory */
+/*    _ux_system_error_handler               Log system error             */
+/*    _ux_utility_memory_arena_allocate      Allocate object from arena   */
+/*    _ux_utility_memory_byte_pool_allocate  Allocate block from pool     */
+/*    _ux_utility_memory_profiler_allocate   Record block in profiler     */
+/*    _ux_utility_memory_slab_allocate       Allocate object from slab    */
+/*    _ux_utility_memory_slab_release        Release empty slab pages     */
 /*    _ux_utility_memory_set                 Set block of memory          */
+/*    _ux_utility_mutex_off                  Put pool mutex               */
+/*    _ux_utility_mutex_on_count             Get pool mutex               */
+/*    _ux_utility_thread_identify            Get current thread           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -79,6 +87,19 @@
 /*                                            refined memory management,  */
 /*                                            fixed issue in 64-bit env,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            moved block carving to byte */
+/*                                            pool allocate function,     */
+/*                                            added memory arena support, */
+/*                                            used pool mutex,            */
+/*                                            recorded block in memory    */
+/*                                            profiler,                   */
+/*                                            reported allocations in     */
+/*                                            steady state,               */
+/*                                            released empty slab pages   */
+/*                                            when pool is exhausted,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  *_ux_utility_memory_allocate(ULONG memory_alignment, ULONG memory_cache_flag,
@@ -87,15 +108,16 @@ VOID  *_ux_utility_memory_allocate(ULONG memory_alignment, ULONG memory_cache_fl
 UX_MEMORY_BYTE_POOL *pool_ptr;
 UCHAR               *current_ptr;
 UCHAR               *work_ptr;
-UCHAR               *next_ptr;
-ALIGN_TYPE          *free_ptr;
 UCHAR               **this_block_link_ptr;
-UCHAR               **next_block_link_ptr;
-ULONG               available_bytes;
-
-ALIGN_TYPE          int_memory_buffer;
-#ifdef UX_ENABLE_MEMORY_STATISTICS
+ULONG               available_bytes = 0;
+#if defined(UX_ENABLE_MEMORY_STATISTICS) || defined(UX_ENABLE_MEMORY_SLAB)
 UINT                index;
+#endif
+#ifdef UX_ENABLE_MEMORY_ARENA
+UX_MEMORY_ARENA     *arena_ptr;
+#endif
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+UX_INTERRUPT_SAVE_AREA
 #endif
 
     /* Get the pool ptr */
@@ -124,8 +146,26 @@ UINT                index;
         return(UX_NULL);
     }
 
-    /* Get the mutex as this is a critical section.  */
-    _ux_system_mutex_on(&_ux_system -> ux_system_mutex);
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+
+    /* No allocation is expected in steady state, count it and save its caller.  */
+    if (_ux_system -> ux_system_memory_steady_state)
+    {
+        UX_DISABLE
+        _ux_system -> ux_system_memory_steady_state_allocations ++;
+        _ux_system -> ux_system_memory_steady_state_caller =  UX_MEMORY_CALLER();
+        UX_RESTORE
+
+        /* Error trap, the caller address is in ux_system_memory_steady_state_caller.  */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_STEADY_STATE_ALLOCATION);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_MEMORY_STEADY_STATE_ALLOCATION, memory_size_requested, 0, 0, UX_TRACE_ERRORS, 0, 0)
+    }
+#endif
+
+    /* Get the pool mutex as this is a critical section.  */
+    _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
 
 #ifdef UX_ENFORCE_SAFE_ALIGNMENT
 
@@ -195,132 +235,88 @@ UINT                index;
 
 #endif
 
-    /* Ensure the alignment meats the minimum.  */
-    if (memory_alignment < UX_ALIGN_MIN)
-        memory_alignment =  UX_ALIGN_MIN;
-
-    /* We need to make sure that the next memory block buffer is 8-byte aligned too. We
-       do this by first adjusting the requested memory to be 8-byte aligned. One problem
-       now is that the memory block might not be a size that is a multiple of 8, so we need
-       to add the amount of memory required such that the memory buffer after the block has
-       the correct alignment. For example, if the memory block has a size of 12, then we need
-       to make sure it is placed on an 8-byte alignment that is after a 8-byte alignment so
-       that the memory right after the memory block is 8-byte aligned (16).  */
-    memory_size_requested =  (memory_size_requested + UX_ALIGN_MIN) & (~(ULONG)UX_ALIGN_MIN);
-    memory_size_requested += (((ULONG)(UX_MEMORY_BLOCK_HEADER_SIZE + UX_ALIGN_MIN) & (~(ULONG)UX_ALIGN_MIN)) - (ULONG)UX_MEMORY_BLOCK_HEADER_SIZE);
-
-    if (memory_alignment <= UX_ALIGN_MIN)
-        current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested);
-    else
-        current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested + memory_alignment);
-
-    /* Check if we found a memory block.  */
-    if (current_ptr == UX_NULL)
-    {
-
-        /* We could not find a memory block.  */
-        _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
-        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_MEMORY_INSUFFICIENT, memory_size_requested, 0, 0, UX_TRACE_ERRORS, 0, 0)
-
-        /* Error trap. */
-        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_INSUFFICIENT);
-
-        return(UX_NULL);
-    }
+#if defined(UX_ENABLE_MEMORY_SLAB) || defined(UX_ENABLE_MEMORY_ARENA)
+    current_ptr = UX_NULL;
+#endif
 
-    /* Pickup the next block's pointer.  */
-    this_block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
-    next_ptr =             *this_block_link_ptr;
+#ifdef UX_ENABLE_MEMORY_ARENA
 
-    /* Calculate the number of bytes available in this block.  */
-    available_bytes =   UX_UCHAR_POINTER_DIF(next_ptr, current_ptr);
-    available_bytes =   available_bytes - UX_MEMORY_BLOCK_HEADER_SIZE;
+    /* If the calling thread selected an arena in this pool, take memory from it.
+       Arenas are in regular pool, the selection is protected by its mutex.  */
+    if (pool_ptr == _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+        arena_ptr = _ux_system -> ux_system_memory_arena;
+    else
+        arena_ptr = UX_NULL;
+    if ((arena_ptr != UX_NULL) && (arena_ptr -> ux_memory_arena_pool == pool_ptr)
+#if !defined(UX_STANDALONE)
+        && (arena_ptr -> ux_memory_arena_thread == _ux_utility_thread_identify())
+#endif
+        )
+        current_ptr = _ux_utility_memory_arena_allocate(arena_ptr, memory_alignment, memory_size_requested);
+#endif
 
-    /* Get the memory buffer for this block.  */
-    int_memory_buffer = (ALIGN_TYPE) (UX_UCHAR_POINTER_ADD(current_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+#ifdef UX_ENABLE_MEMORY_SLAB
 
-    /* In case we are not aligned  */
-    if ((int_memory_buffer & memory_alignment) != 0)
+    /* Small blocks with no special alignment are taken from size class slabs.  */
+    if ((current_ptr == UX_NULL) && (memory_alignment <= UX_ALIGN_MIN))
     {
+        for (index = 0; index < UX_MEMORY_SLAB_CLASS_NUM; index ++)
+        {
+            if (memory_size_requested <= pool_ptr -> ux_byte_pool_slab[index].ux_memory_slab_object_size)
+            {
+                current_ptr = _ux_utility_memory_slab_allocate(&pool_ptr -> ux_byte_pool_slab[index]);
+                if (current_ptr != UX_NULL)
+                    available_bytes = pool_ptr -> ux_byte_pool_slab[index].ux_memory_slab_object_size;
+                break;
+            }
+        }
+    }
 
-        /* No, we need to align the memory buffer.  */
-        int_memory_buffer += (ALIGN_TYPE)UX_MEMORY_BLOCK_HEADER_SIZE;
-        int_memory_buffer += memory_alignment;
-        int_memory_buffer &=  ~((ALIGN_TYPE) memory_alignment);
-        int_memory_buffer -= (ALIGN_TYPE)UX_MEMORY_BLOCK_HEADER_SIZE;
-
-        /* Setup the new free block.  */
-        next_ptr = (UCHAR *)int_memory_buffer;
-
-        /* Setup the new free block.  */
-        next_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
-        *next_block_link_ptr =  *this_block_link_ptr;
-        work_ptr =              UX_UCHAR_POINTER_ADD(next_ptr, (sizeof(UCHAR *)));
-        free_ptr =              UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
-        *free_ptr =             UX_BYTE_BLOCK_FREE;
+#endif
 
-        /* Increase the total fragment counter.  */
-        pool_ptr -> ux_byte_pool_fragments++;
+#if defined(UX_ENABLE_MEMORY_SLAB) || defined(UX_ENABLE_MEMORY_ARENA)
 
-        /* Update the current pointer to point at the newly created block.  */
-        *this_block_link_ptr =  next_ptr;
+    /* If no arena or slab fits or they are exhausted, fall back to the byte pool.  */
+    if (current_ptr == UX_NULL)
+#endif
+    current_ptr = _ux_utility_memory_byte_pool_allocate(pool_ptr, memory_alignment, memory_size_requested);
 
-        /* Calculate the available bytes.  */
-        available_bytes -=  UX_UCHAR_POINTER_DIF(next_ptr, current_ptr);
+#ifdef UX_ENABLE_MEMORY_SLAB
 
-        /* Set Current pointer to the aligned memory buffer.  */
-        current_ptr = next_ptr;
-    }
+    /* If the byte pool is exhausted, release the empty slab pages and retry.  */
+    if ((current_ptr == UX_NULL) && (_ux_utility_memory_slab_release(pool_ptr) != 0))
+        current_ptr = _ux_utility_memory_byte_pool_allocate(pool_ptr, memory_alignment, memory_size_requested);
+#endif
 
-    /* Now we are aligned, determine if we need to split this block.  */
-    if ((available_bytes - memory_size_requested) >= ((ULONG) UX_BYTE_BLOCK_MIN))
+    /* Check if we found a memory block.  */
+    if (current_ptr == UX_NULL)
     {
 
-        /* Split the block.  */
-        next_ptr =  UX_UCHAR_POINTER_ADD(current_ptr, (memory_size_requested + UX_MEMORY_BLOCK_HEADER_SIZE));
-
-        /* Setup the new free block.  */
-        next_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
-        this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
-        *next_block_link_ptr =  *this_block_link_ptr;
-        work_ptr =              UX_UCHAR_POINTER_ADD(next_ptr, (sizeof(UCHAR *)));
-        free_ptr =              UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
-        *free_ptr =             UX_BYTE_BLOCK_FREE;
+        /* We could not find a memory block.  */
+        _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
 
-        /* Increase the total fragment counter.  */
-        pool_ptr -> ux_byte_pool_fragments++;
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_MEMORY_INSUFFICIENT, memory_size_requested, 0, 0, UX_TRACE_ERRORS, 0, 0)
 
-        /* Update the current pointer to point at the newly created block.  */
-        *this_block_link_ptr =  next_ptr;
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_INSUFFICIENT);
 
-        /* Set available equal to memory size for subsequent calculation.  */
-        available_bytes =  memory_size_requested;
+        return(UX_NULL);
     }
 
-    /* In any case, mark the current block as allocated.  */
-    work_ptr =              UX_UCHAR_POINTER_ADD(current_ptr, (sizeof(UCHAR *)));
-    this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
-    *this_block_link_ptr =  UX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
-
-    /* Reduce the number of available bytes in the pool.  */
-    pool_ptr -> ux_byte_pool_available =  pool_ptr -> ux_byte_pool_available - (available_bytes + UX_MEMORY_BLOCK_HEADER_SIZE);
-
-    /* Determine if the search pointer needs to be updated. This is only done
-        if the search pointer matches the block to be returned.  */
-    if (current_ptr == pool_ptr -> ux_byte_pool_search)
+#ifdef UX_ENABLE_MEMORY_SLAB
+    if (available_bytes == 0)
+#endif
     {
 
-        /* Yes, update the search pointer to the next block.  */
-        this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
-        pool_ptr -> ux_byte_pool_search =  *this_block_link_ptr;
+        /* Calculate the number of bytes in the block, from its header.  */
+        work_ptr =             UX_UCHAR_POINTER_SUB(current_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+        this_block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+        available_bytes =      UX_UCHAR_POINTER_DIF(*this_block_link_ptr, work_ptr);
+        available_bytes =      available_bytes - UX_MEMORY_BLOCK_HEADER_SIZE;
     }
 
-    /* Adjust the pointer for the application.  */
-    work_ptr =  UX_UCHAR_POINTER_ADD(current_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
-
     /* Clear the memory block.  */
-    _ux_utility_memory_set(work_ptr, 0, available_bytes); /* Use case of memset is verified. */
+    _ux_utility_memory_set(current_ptr, 0, available_bytes); /* Use case of memset is verified. */
 
 #ifdef UX_ENABLE_MEMORY_STATISTICS
 
@@ -345,8 +341,15 @@ UINT                index;
         _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_min_free = _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_available;
 #endif
 
+#ifdef UX_ENABLE_MEMORY_PROFILER
+
+    /* Record the block and its caller in profiler.  */
+    _ux_utility_memory_profiler_allocate(pool_ptr, current_ptr, memory_size_requested,
+                                         available_bytes, UX_MEMORY_CALLER());
+#endif
+
     /* Release the protection.  */
-    _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
 
-    return(work_ptr);
+    return(current_ptr);
 }
@@ -0,0 +1,163 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_arena_allocate                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function takes an object of the specified size and alignment   */
+/*    from a memory arena, by moving the top of the current chunk. If     */
+/*    there is no space in the current chunk, a new chunk is carved from  */
+/*    the byte pool of the arena. Objects larger than a chunk get a chunk */
+/*    of their own.                                                       */
+/*                                                                        */
+/*    The object content is not cleared and no statistics are updated.    */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    arena_ptr                             Pointer to arena              */
+/*    memory_alignment                      Memory alignment required     */
+/*    memory_size_requested                 Number of bytes required      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to object memory                                            */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_allocate Allocate block from pool      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_ux_utility_memory_arena_allocate(UX_MEMORY_ARENA *arena_ptr, ULONG memory_alignment,
+                                          ULONG memory_size_requested)
+{
+
+UX_MEMORY_ARENA_CHUNK   *chunk_ptr;
+UCHAR                   *block_ptr;
+UCHAR                   *memory_ptr;
+UCHAR                   **block_link_ptr;
+ALIGN_TYPE              *block_owner_ptr;
+ALIGN_TYPE              int_memory_buffer;
+ULONG                   chunk_size;
+
+
+    /* Ensure the alignment meats the minimum.  */
+    if (memory_alignment < UX_ALIGN_MIN)
+        memory_alignment =  UX_ALIGN_MIN;
+
+    /* Requests larger than the pool can not be served.  */
+    if (memory_size_requested > arena_ptr -> ux_memory_arena_pool -> ux_byte_pool_size)
+        return(UX_NULL);
+
+    /* Keep the object end aligned.  */
+    memory_size_requested = (memory_size_requested + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN);
+
+    /* Get the aligned memory buffer in current chunk, there is the arena
+       pointer and the block header before it.  */
+    chunk_ptr = arena_ptr -> ux_memory_arena_chunks;
+    int_memory_buffer = (ALIGN_TYPE)UX_UCHAR_POINTER_ADD(chunk_ptr -> ux_memory_arena_chunk_top, sizeof(UCHAR *) + UX_MEMORY_BLOCK_HEADER_SIZE);
+    int_memory_buffer = (int_memory_buffer + memory_alignment) & ~((ALIGN_TYPE)memory_alignment);
+
+    /* Check if there is enough space left in current chunk.  */
+    if (int_memory_buffer + memory_size_requested > (ALIGN_TYPE)chunk_ptr -> ux_memory_arena_chunk_end)
+    {
+
+        /* Carve a new chunk, large enough for the object in worst alignment case.  */
+        chunk_size = UX_MEMORY_ARENA_CHUNK_HEADER_SIZE + sizeof(UCHAR *) + UX_MEMORY_BLOCK_HEADER_SIZE +
+                     memory_alignment + memory_size_requested;
+        if (chunk_size < UX_MEMORY_ARENA_CHUNK_SIZE)
+            chunk_size = UX_MEMORY_ARENA_CHUNK_SIZE;
+        block_ptr = _ux_utility_memory_byte_pool_allocate(arena_ptr -> ux_memory_arena_pool, UX_NO_ALIGN, chunk_size);
+        if (block_ptr == UX_NULL)
+            return(UX_NULL);
+
+        /* Setup the chunk.  */
+        chunk_ptr = (UX_MEMORY_ARENA_CHUNK *)(VOID *)block_ptr;
+        chunk_ptr -> ux_memory_arena_chunk_top = UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_ARENA_CHUNK_HEADER_SIZE);
+        chunk_ptr -> ux_memory_arena_chunk_end = *UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_SUB(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+
+        /* A chunk for a large object is linked after current chunk, so the
+           space left in current chunk is still used. Otherwise the new chunk
+           becomes the current one.  */
+        if (chunk_size > UX_MEMORY_ARENA_CHUNK_SIZE)
+        {
+            chunk_ptr -> ux_memory_arena_chunk_next = arena_ptr -> ux_memory_arena_chunks -> ux_memory_arena_chunk_next;
+            arena_ptr -> ux_memory_arena_chunks -> ux_memory_arena_chunk_next = chunk_ptr;
+        }
+        else
+        {
+            chunk_ptr -> ux_memory_arena_chunk_next = arena_ptr -> ux_memory_arena_chunks;
+            arena_ptr -> ux_memory_arena_chunks = chunk_ptr;
+        }
+
+        /* Get the aligned memory buffer in new chunk.  */
+        int_memory_buffer = (ALIGN_TYPE)UX_UCHAR_POINTER_ADD(chunk_ptr -> ux_memory_arena_chunk_top, sizeof(UCHAR *) + UX_MEMORY_BLOCK_HEADER_SIZE);
+        int_memory_buffer = (int_memory_buffer + memory_alignment) & ~((ALIGN_TYPE)memory_alignment);
+    }
+
+    /* Move the top of the chunk.  */
+    memory_ptr = (UCHAR *)int_memory_buffer;
+    chunk_ptr -> ux_memory_arena_chunk_top = UX_UCHAR_POINTER_ADD(memory_ptr, memory_size_requested);
+
+    /* Setup the object header: arena, end of object and owner mark.  */
+    block_ptr = UX_UCHAR_POINTER_SUB(memory_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+    block_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_SUB(block_ptr, sizeof(UCHAR *)));
+    *block_link_ptr = (UCHAR *)(VOID *)arena_ptr;
+    block_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    *block_link_ptr = chunk_ptr -> ux_memory_arena_chunk_top;
+    block_owner_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+    *block_owner_ptr = UX_BYTE_BLOCK_ARENA;
+
+    /* One more object in the arena.  */
+    arena_ptr -> ux_memory_arena_objects ++;
+
+    /* Return the object memory.  */
+    return(memory_ptr);
+}
+#endif
@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_arena_chunks_free                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns all chunks of a memory arena to its byte      */
+/*    pool. The arena control block is in one of the chunks, so the arena */
+/*    must not be accessed after this function returns.                   */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    arena_ptr                             Pointer to arena              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_free     Free block to pool            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_arena_delete       Delete memory arena           */
+/*    _ux_utility_memory_arena_free         Free object in arena          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_arena_chunks_free(UX_MEMORY_ARENA *arena_ptr)
+{
+
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+UX_MEMORY_ARENA_CHUNK   *chunk_ptr;
+UX_MEMORY_ARENA_CHUNK   *next_chunk_ptr;
+
+
+    /* Save the pool and chunk list before the arena is released.  */
+    pool_ptr = arena_ptr -> ux_memory_arena_pool;
+    chunk_ptr = arena_ptr -> ux_memory_arena_chunks;
+
+    /* Return all chunks to the pool.  */
+    while (chunk_ptr != UX_NULL)
+    {
+        next_chunk_ptr = chunk_ptr -> ux_memory_arena_chunk_next;
+        _ux_utility_memory_byte_pool_free(pool_ptr, chunk_ptr);
+        chunk_ptr = next_chunk_ptr;
+    }
+}
+#endif
@@ -0,0 +1,124 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_arena_create                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function creates a memory arena in the regular memory pool.    */
+/*    The first chunk of the arena is carved from the pool, and the arena */
+/*    control block is kept at its start.                                 */
+/*                                                                        */
+/*    Objects are taken from the arena by _ux_utility_memory_allocate     */
+/*    once the arena is selected by _ux_utility_memory_arena_select.      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to arena created, UX_NULL if there is no memory             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_allocate Allocate block from pool      */
+/*    _ux_system_mutex_on_count             Get pool mutex                */
+/*    _ux_system_mutex_off                  Put pool mutex                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_new_device_create      Create new device             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UX_MEMORY_ARENA  *_ux_utility_memory_arena_create(VOID)
+{
+
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+UX_MEMORY_ARENA_CHUNK   *chunk_ptr;
+UX_MEMORY_ARENA         *arena_ptr;
+UCHAR                   *block_ptr;
+
+
+    /* The arena is in regular memory pool.  */
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    if (pool_ptr == UX_NULL)
+        return(UX_NULL);
+
+    /* Get the pool mutex as this is a critical section.  */
+    _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+
+    /* Carve the first chunk.  */
+    block_ptr = _ux_utility_memory_byte_pool_allocate(pool_ptr, UX_NO_ALIGN, UX_MEMORY_ARENA_CHUNK_SIZE);
+    if (block_ptr == UX_NULL)
+    {
+
+        /* Release the protection.  */
+        _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+        return(UX_NULL);
+    }
+
+    /* Setup the chunk, the arena control block is the first thing in it.  */
+    chunk_ptr = (UX_MEMORY_ARENA_CHUNK *)(VOID *)block_ptr;
+    arena_ptr = (UX_MEMORY_ARENA *)(VOID *)UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_ARENA_CHUNK_HEADER_SIZE);
+    chunk_ptr -> ux_memory_arena_chunk_next = UX_NULL;
+    chunk_ptr -> ux_memory_arena_chunk_top = UX_UCHAR_POINTER_ADD(arena_ptr, UX_MEMORY_ARENA_HEADER_SIZE);
+    chunk_ptr -> ux_memory_arena_chunk_end = *UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_SUB(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+
+    /* Setup the arena.  */
+    arena_ptr -> ux_memory_arena_pool = pool_ptr;
+    arena_ptr -> ux_memory_arena_chunks = chunk_ptr;
+    arena_ptr -> ux_memory_arena_objects = 0;
+    arena_ptr -> ux_memory_arena_deleted = UX_FALSE;
+#if !defined(UX_STANDALONE)
+    arena_ptr -> ux_memory_arena_thread = UX_NULL;
+#endif
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+
+    /* Return the arena created.  */
+    return(arena_ptr);
+}
+#endif
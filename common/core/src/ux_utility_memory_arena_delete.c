@@ -0,0 +1,100 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_arena_delete                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function deletes a memory arena. If the arena is selected, it  */
+/*    is deselected. If all objects of the arena are freed, all its       */
+/*    chunks are returned to the byte pool at once. Otherwise the chunks  */
+/*    are returned when the last object is freed.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    arena_ptr                             Pointer to arena              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_arena_chunks_free  Free arena chunks             */
+/*    _ux_system_mutex_on_count             Get pool mutex                */
+/*    _ux_system_mutex_off                  Put pool mutex                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_device_resources_free  Free device resources         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_arena_delete(UX_MEMORY_ARENA *arena_ptr)
+{
+
+#if !defined(UX_STANDALONE)
+UX_MEMORY_BYTE_POOL *pool_ptr;
+#endif
+
+
+#if !defined(UX_STANDALONE)
+
+    /* Get the mutex of the arena pool as this is a critical section.  */
+    pool_ptr = arena_ptr -> ux_memory_arena_pool;
+#endif
+    _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+
+    /* No more allocation from this arena.  */
+    if (_ux_system -> ux_system_memory_arena == arena_ptr)
+        _ux_system -> ux_system_memory_arena = UX_NULL;
+    arena_ptr -> ux_memory_arena_deleted = UX_TRUE;
+
+    /* Release the arena if there is no object left in it.  */
+    if (arena_ptr -> ux_memory_arena_objects == 0)
+        _ux_utility_memory_arena_chunks_free(arena_ptr);
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+}
+#endif
@@ -0,0 +1,126 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_arena_free                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function marks an object of a memory arena as free. The space  */
+/*    of the object is not reused, except if it is the last object taken  */
+/*    from the current chunk. If the arena is deleted and this is its     */
+/*    last object, all chunks of the arena are returned to the byte pool. */
+/*                                                                        */
+/*    No statistics are updated. Note the caller must hold the protection */
+/*    of the memory pool.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory                                Pointer to object memory      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Number of bytes released (including object header), 0 if the object */
+/*    is not valid.                                                       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_arena_chunks_free  Free arena chunks             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_utility_memory_arena_free(VOID *memory)
+{
+
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+UX_MEMORY_ARENA         *arena_ptr;
+UX_MEMORY_ARENA_CHUNK   *chunk_ptr;
+UCHAR                   *block_ptr;
+UCHAR                   **block_link_ptr;
+ALIGN_TYPE              *block_owner_ptr;
+ULONG                   block_size;
+UINT                    index;
+
+
+    /* Back off the memory pointer to pickup the object header and arena.  */
+    block_ptr = UX_UCHAR_POINTER_SUB(memory, UX_MEMORY_BLOCK_HEADER_SIZE);
+    block_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_SUB(block_ptr, sizeof(UCHAR *)));
+    arena_ptr = (UX_MEMORY_ARENA *)(VOID *)*block_link_ptr;
+
+    /* The arena must be inside one of the pools and owned by that pool.  */
+    for (index = 0; index < UX_MEMORY_BYTE_POOL_NUM; index ++)
+    {
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[index];
+        if (((UCHAR *)(VOID *)arena_ptr >= pool_ptr -> ux_byte_pool_start) &&
+            ((UCHAR *)(VOID *)arena_ptr < pool_ptr -> ux_byte_pool_start + pool_ptr -> ux_byte_pool_size) &&
+            (arena_ptr -> ux_memory_arena_pool == pool_ptr))
+            break;
+    }
+    if ((index >= UX_MEMORY_BYTE_POOL_NUM) || (arena_ptr -> ux_memory_arena_objects == 0))
+        return(0);
+
+    /* Get the object size.  */
+    block_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    block_size = UX_UCHAR_POINTER_DIF(*block_link_ptr, block_ptr);
+
+    /* Mark the object as free.  */
+    block_owner_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, sizeof(UCHAR *)));
+    *block_owner_ptr = UX_BYTE_BLOCK_FREE;
+    arena_ptr -> ux_memory_arena_objects --;
+
+    /* If it's the last object of current chunk, its space is taken back.  */
+    chunk_ptr = arena_ptr -> ux_memory_arena_chunks;
+    if (chunk_ptr -> ux_memory_arena_chunk_top == *block_link_ptr)
+        chunk_ptr -> ux_memory_arena_chunk_top = UX_UCHAR_POINTER_SUB(block_ptr, sizeof(UCHAR *));
+
+    /* If the arena is deleted and empty, release it.  */
+    if ((arena_ptr -> ux_memory_arena_deleted) && (arena_ptr -> ux_memory_arena_objects == 0))
+        _ux_utility_memory_arena_chunks_free(arena_ptr);
+
+    /* Return the size of the object.  */
+    return(block_size);
+}
+#endif
@@ -0,0 +1,111 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_arena_select                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function selects the memory arena that allocations of the      */
+/*    calling thread are taken from. Allocations of other threads still   */
+/*    use the memory pools.                                               */
+/*                                                                        */
+/*    Only one arena is selected at a time, the previous one is returned  */
+/*    so that it can be selected again later.                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    arena_ptr                             Pointer to arena, UX_NULL to  */
+/*                                          deselect                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to arena previously selected                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_thread_identify           Get current thread            */
+/*    _ux_system_mutex_on_count             Get pool mutex                */
+/*    _ux_system_mutex_off                  Put pool mutex                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_host_stack_new_device_create      Create new device             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UX_MEMORY_ARENA  *_ux_utility_memory_arena_select(UX_MEMORY_ARENA *arena_ptr)
+{
+
+#if !defined(UX_STANDALONE)
+UX_MEMORY_BYTE_POOL *pool_ptr;
+#endif
+UX_MEMORY_ARENA     *previous_ptr;
+
+
+#if !defined(UX_STANDALONE)
+
+    /* The selection is protected by the regular pool mutex, where arenas are.  */
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+#endif
+    _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+
+    /* Save the previous arena.  */
+    previous_ptr = _ux_system -> ux_system_memory_arena;
+
+#if !defined(UX_STANDALONE)
+
+    /* The arena is used by current thread only.  */
+    if (arena_ptr != UX_NULL)
+        arena_ptr -> ux_memory_arena_thread = _ux_utility_thread_identify();
+#endif
+
+    /* Select the arena.  */
+    _ux_system -> ux_system_memory_arena = arena_ptr;
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+
+    /* Return the previous arena.  */
+    return(previous_ptr);
+}
+#endif
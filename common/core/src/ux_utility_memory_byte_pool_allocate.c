@@ -0,0 +1,217 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_allocate               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function carves a block of memory for the specified size and   */
+/*    alignment out of a byte pool. The block is marked as owned by the   */
+/*    pool, but its content is not cleared and no statistics are          */
+/*    updated.                                                            */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    memory_alignment                      Memory alignment required     */
+/*    memory_size_requested                 Number of bytes required      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to block of memory                                          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_search   Search free block in pool     */
+/*    _ux_utility_memory_tlsf_allocate      Allocate block from TLSF pool */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_ux_utility_memory_byte_pool_allocate(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_alignment,
+                                              ULONG memory_size_requested)
+{
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+    /* Carve the block from TLSF free lists.  */
+    return(_ux_utility_memory_tlsf_allocate(pool_ptr, memory_alignment, memory_size_requested));
+#else
+UCHAR               *current_ptr;
+UCHAR               *work_ptr;
+UCHAR               *next_ptr;
+ALIGN_TYPE          *free_ptr;
+UCHAR               **this_block_link_ptr;
+UCHAR               **next_block_link_ptr;
+ULONG               available_bytes;
+
+ALIGN_TYPE          int_memory_buffer;
+
+
+    /* Ensure the alignment meats the minimum.  */
+    if (memory_alignment < UX_ALIGN_MIN)
+        memory_alignment =  UX_ALIGN_MIN;
+
+    /* We need to make sure that the next memory block buffer is 8-byte aligned too. We
+       do this by first adjusting the requested memory to be 8-byte aligned. One problem
+       now is that the memory block might not be a size that is a multiple of 8, so we need
+       to add the amount of memory required such that the memory buffer after the block has
+       the correct alignment. For example, if the memory block has a size of 12, then we need
+       to make sure it is placed on an 8-byte alignment that is after a 8-byte alignment so
+       that the memory right after the memory block is 8-byte aligned (16).  */
+    memory_size_requested =  (memory_size_requested + UX_ALIGN_MIN) & (~(ULONG)UX_ALIGN_MIN);
+    memory_size_requested += (((ULONG)(UX_MEMORY_BLOCK_HEADER_SIZE + UX_ALIGN_MIN) & (~(ULONG)UX_ALIGN_MIN)) - (ULONG)UX_MEMORY_BLOCK_HEADER_SIZE);
+
+    /* For extra alignment, a free block is split before the aligned buffer, so
+       space for its header is also needed.  */
+    if (memory_alignment <= UX_ALIGN_MIN)
+        current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested);
+    else
+        current_ptr = _ux_utility_memory_byte_pool_search(pool_ptr, memory_size_requested + memory_alignment + UX_MEMORY_BLOCK_HEADER_SIZE);
+
+    /* Check if we found a memory block.  */
+    if (current_ptr == UX_NULL)
+        return(UX_NULL);
+
+    /* Pickup the next block's pointer.  */
+    this_block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
+    next_ptr =             *this_block_link_ptr;
+
+    /* Calculate the number of bytes available in this block.  */
+    available_bytes =   UX_UCHAR_POINTER_DIF(next_ptr, current_ptr);
+    available_bytes =   available_bytes - UX_MEMORY_BLOCK_HEADER_SIZE;
+
+    /* Get the memory buffer for this block.  */
+    int_memory_buffer = (ALIGN_TYPE) (UX_UCHAR_POINTER_ADD(current_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+
+    /* In case we are not aligned  */
+    if ((int_memory_buffer & memory_alignment) != 0)
+    {
+
+        /* No, we need to align the memory buffer.  */
+        int_memory_buffer += (ALIGN_TYPE)UX_MEMORY_BLOCK_HEADER_SIZE;
+        int_memory_buffer += memory_alignment;
+        int_memory_buffer &=  ~((ALIGN_TYPE) memory_alignment);
+        int_memory_buffer -= (ALIGN_TYPE)UX_MEMORY_BLOCK_HEADER_SIZE;
+
+        /* Setup the new free block.  */
+        next_ptr = (UCHAR *)int_memory_buffer;
+
+        /* Setup the new free block.  */
+        next_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
+        *next_block_link_ptr =  *this_block_link_ptr;
+        work_ptr =              UX_UCHAR_POINTER_ADD(next_ptr, (sizeof(UCHAR *)));
+        free_ptr =              UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
+        *free_ptr =             UX_BYTE_BLOCK_FREE;
+
+        /* Link it back to the blocks around it.  */
+        UX_MEMORY_BLOCK_PREVIOUS(next_ptr) =  current_ptr;
+        UX_MEMORY_BLOCK_PREVIOUS(*next_block_link_ptr) =  next_ptr;
+
+        /* Increase the total fragment counter.  */
+        pool_ptr -> ux_byte_pool_fragments++;
+
+        /* Update the current pointer to point at the newly created block.  */
+        *this_block_link_ptr =  next_ptr;
+
+        /* Calculate the available bytes.  */
+        available_bytes -=  UX_UCHAR_POINTER_DIF(next_ptr, current_ptr);
+
+        /* Set Current pointer to the aligned memory buffer.  */
+        current_ptr = next_ptr;
+    }
+
+    /* Now we are aligned, determine if we need to split this block.  */
+    if ((available_bytes - memory_size_requested) >= ((ULONG) UX_BYTE_BLOCK_MIN))
+    {
+
+        /* Split the block.  */
+        next_ptr =  UX_UCHAR_POINTER_ADD(current_ptr, (memory_size_requested + UX_MEMORY_BLOCK_HEADER_SIZE));
+
+        /* Setup the new free block.  */
+        next_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
+        this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
+        *next_block_link_ptr =  *this_block_link_ptr;
+        work_ptr =              UX_UCHAR_POINTER_ADD(next_ptr, (sizeof(UCHAR *)));
+        free_ptr =              UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(work_ptr);
+        *free_ptr =             UX_BYTE_BLOCK_FREE;
+
+        /* Link it back to the blocks around it.  */
+        UX_MEMORY_BLOCK_PREVIOUS(next_ptr) =  current_ptr;
+        UX_MEMORY_BLOCK_PREVIOUS(*next_block_link_ptr) =  next_ptr;
+
+        /* Increase the total fragment counter.  */
+        pool_ptr -> ux_byte_pool_fragments++;
+
+        /* Update the current pointer to point at the newly created block.  */
+        *this_block_link_ptr =  next_ptr;
+
+        /* Set available equal to memory size for subsequent calculation.  */
+        available_bytes =  memory_size_requested;
+    }
+
+    /* In any case, mark the current block as allocated.  */
+    work_ptr =              UX_UCHAR_POINTER_ADD(current_ptr, (sizeof(UCHAR *)));
+    this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    *this_block_link_ptr =  UX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
+
+    /* Reduce the number of available bytes in the pool.  */
+    pool_ptr -> ux_byte_pool_available =  pool_ptr -> ux_byte_pool_available - (available_bytes + UX_MEMORY_BLOCK_HEADER_SIZE);
+
+    /* Determine if the search pointer needs to be updated. This is only done
+        if the search pointer matches the block to be returned.  */
+    if (current_ptr == pool_ptr -> ux_byte_pool_search)
+    {
+
+        /* Yes, update the search pointer to the next block.  */
+        this_block_link_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
+        pool_ptr -> ux_byte_pool_search =  *this_block_link_ptr;
+    }
+
+    /* Return the memory buffer for the caller.  */
+    return(UX_UCHAR_POINTER_ADD(current_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+#endif
+}
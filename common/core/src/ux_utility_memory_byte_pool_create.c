@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_byte_pool_create                 PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Yajun Xia, Microsoft Corporation                                    */
@@ -54,7 +54,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    _ux_utility_memory_tlsf_create    Create TLSF blocks and lists      */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -65,15 +65,28 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Yajun Xia                Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            added TLSF byte pool        */
+/*                                            support,                    */
+/*                                            linked blocks to the        */
+/*                                            previous block,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_utility_memory_byte_pool_create(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *pool_start, ULONG pool_size)
 {
 
+#ifndef UX_ENABLE_MEMORY_TLSF
 UCHAR               *block_ptr;
 UCHAR               **block_indirect_ptr;
 UCHAR               *temp_ptr;
 ALIGN_TYPE          *free_ptr;
+#endif
+#ifdef UX_ENABLE_MEMORY_SLAB
+UX_MEMORY_SLAB      *slab_ptr;
+UINT                index;
+#endif
 
 
     /* Initialize the byte pool control block to all zeros.  */
@@ -88,42 +101,66 @@ ALIGN_TYPE          *free_ptr;
     pool_ptr -> ux_byte_pool_size =    pool_size;
     pool_ptr -> ux_byte_pool_search =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
 
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+    /* Build the blocks and the free lists of the TLSF pool.  */
+    _ux_utility_memory_tlsf_create(pool_ptr);
+#else
+
     /* Initially, the pool will have two blocks.  One large block at the
        beginning that is available and a small allocated block at the end
        of the pool that is there just for the algorithm.  Be sure to count
        the available block's header in the available bytes count.  */
-    pool_ptr -> ux_byte_pool_available =   pool_size - ((sizeof(VOID *)) + (sizeof(ALIGN_TYPE)));
+    pool_ptr -> ux_byte_pool_available =   pool_size - UX_MEMORY_BLOCK_HEADER_SIZE;
     pool_ptr -> ux_byte_pool_fragments =   ((UINT) 2);
 
     /* Each block contains a "next" pointer that points to the next block in the pool followed by a ALIGN_TYPE
        field that contains either the constant UX_BYTE_BLOCK_FREE (if the block is free) or a pointer to the
-       owning pool (if the block is allocated).  */
+       owning pool (if the block is allocated), then a "previous" pointer to the block before it.  */
 
     /* Calculate the end of the pool's memory area.  */
     block_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     block_ptr =  UX_UCHAR_POINTER_ADD(block_ptr, pool_size);
 
     /* Backup the end of the pool pointer and build the pre-allocated block.  */
-    block_ptr =  UX_UCHAR_POINTER_SUB(block_ptr, (sizeof(ALIGN_TYPE)));
+    block_ptr =  UX_UCHAR_POINTER_SUB(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
 
     /* Cast the pool pointer into a ULONG.  */
     temp_ptr =             UX_BYTE_POOL_TO_UCHAR_POINTER_CONVERT(pool_ptr);
-    block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
+    block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(block_ptr, (sizeof(UCHAR *))));
     *block_indirect_ptr =  temp_ptr;
 
-    block_ptr =            UX_UCHAR_POINTER_SUB(block_ptr, (sizeof(UCHAR *)));
     block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(block_ptr);
     *block_indirect_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
+    UX_MEMORY_BLOCK_PREVIOUS(block_ptr) =  UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
 
-    /* Now setup the large available block in the pool.  */
+    /* Now setup the large available block in the pool, there is no block before it.  */
     temp_ptr =             UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     block_indirect_ptr =   UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(temp_ptr);
     *block_indirect_ptr =  block_ptr;
+    UX_MEMORY_BLOCK_PREVIOUS(temp_ptr) =  UX_NULL;
     block_ptr =            UX_VOID_TO_UCHAR_POINTER_CONVERT(pool_start);
     block_ptr =            UX_UCHAR_POINTER_ADD(block_ptr, (sizeof(UCHAR *)));
     free_ptr =             UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(block_ptr);
     *free_ptr =            UX_BYTE_BLOCK_FREE;
 
+#endif
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+    /* Setup size classes, pages are carved from the pool on demand.  */
+    for (index = 0; index < UX_MEMORY_SLAB_CLASS_NUM; index ++)
+    {
+        slab_ptr = &pool_ptr -> ux_byte_pool_slab[index];
+        slab_ptr -> ux_memory_slab_pool = pool_ptr;
+        slab_ptr -> ux_memory_slab_object_size = (ULONG)UX_MEMORY_SLAB_SIZE_MIN << index;
+        slab_ptr -> ux_memory_slab_page_objects = (UX_MEMORY_SLAB_PAGE_SIZE - UX_MEMORY_SLAB_PAGE_HEADER_SIZE) /
+                                        (slab_ptr -> ux_memory_slab_object_size + UX_MEMORY_BLOCK_HEADER_SIZE);
+        if (slab_ptr -> ux_memory_slab_page_objects == 0)
+            slab_ptr -> ux_memory_slab_page_objects = 1;
+    }
+#endif
+
     /* Return UX_SUCCESS.  */
     return(UX_SUCCESS);
 }
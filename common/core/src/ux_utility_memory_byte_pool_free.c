@@ -0,0 +1,145 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_free                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns a block carved by                             */
+/*    _ux_utility_memory_byte_pool_allocate to its byte pool. No check is */
+/*    done on the block and no statistics are updated.                    */
+/*                                                                        */
+/*    The block is merged with its free neighbours immediately, so there  */
+/*    are never two adjacent free blocks in the pool. The previous block  */
+/*    is linked from the block header, both merges are done in constant   */
+/*    time.                                                               */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    memory                                Pointer to memory block       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_free          Free block to TLSF pool       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_byte_pool_free(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory)
+{
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+    /* Return the block to TLSF free lists.  */
+    _ux_utility_memory_tlsf_free(pool_ptr, memory);
+#else
+UCHAR               *work_ptr;
+UCHAR               *temp_ptr;
+UCHAR               *next_block_ptr;
+UCHAR               *previous_block_ptr;
+ALIGN_TYPE          *free_ptr;
+UCHAR               **block_link_ptr;
+UCHAR               **next_block_link_ptr;
+
+
+    /* Back off the memory pointer to pickup its header.  */
+    work_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(memory);
+    work_ptr =  UX_UCHAR_POINTER_SUB(work_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+
+    /* Release the memory.  */
+    temp_ptr =   UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
+    free_ptr =   UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
+    *free_ptr =  UX_BYTE_BLOCK_FREE;
+
+    /* Update the number of available bytes in the pool.  */
+    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+    next_block_ptr =  *block_link_ptr;
+    pool_ptr -> ux_byte_pool_available =
+        pool_ptr -> ux_byte_pool_available + UX_UCHAR_POINTER_DIF(next_block_ptr, work_ptr);
+
+    /* Merge the next block if it is free (the last block of the pool is never free).
+       The available bytes are not changed since free headers are counted in.  */
+    temp_ptr =  UX_UCHAR_POINTER_ADD(next_block_ptr, (sizeof(UCHAR *)));
+    free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
+    if ((*free_ptr) == UX_BYTE_BLOCK_FREE)
+    {
+        next_block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_block_ptr);
+        *block_link_ptr =  *next_block_link_ptr;
+        UX_MEMORY_BLOCK_PREVIOUS(*block_link_ptr) =  work_ptr;
+        pool_ptr -> ux_byte_pool_fragments--;
+    }
+
+    /* Merge into the previous block if it is free, it is linked from the header.  */
+    previous_block_ptr =  UX_MEMORY_BLOCK_PREVIOUS(work_ptr);
+    if (previous_block_ptr != UX_NULL)
+    {
+        temp_ptr =  UX_UCHAR_POINTER_ADD(previous_block_ptr, (sizeof(UCHAR *)));
+        free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
+        if ((*free_ptr) == UX_BYTE_BLOCK_FREE)
+        {
+            block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(previous_block_ptr);
+            next_block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+            *block_link_ptr =  *next_block_link_ptr;
+            UX_MEMORY_BLOCK_PREVIOUS(*block_link_ptr) =  previous_block_ptr;
+            pool_ptr -> ux_byte_pool_fragments--;
+            work_ptr =  previous_block_ptr;
+        }
+    }
+
+    /* Determine if the free block is prior to current search pointer.  */
+    if (work_ptr < (pool_ptr -> ux_byte_pool_search))
+    {
+
+        /* Yes, update the search pointer to the released block.  */
+        pool_ptr -> ux_byte_pool_search =  work_ptr;
+    }
+#endif
+}
@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_byte_pool_search                 PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Yajun Xia, Microsoft Corporation                                    */
@@ -67,6 +67,10 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Yajun Xia                Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            linked blocks to the        */
+/*                                            previous block,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UCHAR  *_ux_utility_memory_byte_pool_search(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_size)
@@ -159,6 +163,7 @@ ULONG               total_theoretical_available;
                         by updating the current block with the next blocks pointer.  */
                     next_block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(next_ptr);
                     *this_block_link_ptr =  *next_block_link_ptr;
+                    UX_MEMORY_BLOCK_PREVIOUS(*this_block_link_ptr) =  current_ptr;
 
                     /* Reduce the fragment total.  We don't need to increase the bytes
                         available because all free headers are also included in the available
@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_compare                          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -41,6 +41,11 @@
 /*                                                                        */ 
 /*    This function compares two memory blocks.                           */ 
 /*                                                                        */ 
+/*    If the blocks have the same alignment, they are compared by words   */
+/*    after the first bytes before word boundary. A port can define       */
+/*    UX_MEMORY_COMPARE to use its optimized compare, which returns zero  */
+/*    if blocks are equal.                                                */
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    memory_source                         Pointer to source             */ 
@@ -67,19 +72,58 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            optimized with word access, */
+/*                                            added port override,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_utility_memory_compare(VOID *memory_source, VOID *memory_destination, ULONG length)
 {
+#if defined(UX_MEMORY_COMPARE)
+
+    /* Use the port compare.  */
+    return(UX_MEMORY_COMPARE(memory_source, memory_destination, length) ? UX_ERROR : UX_SUCCESS);
+#else
 
 UCHAR *   source;
 UCHAR *   destination;
+ALIGN_TYPE *source_word;
+ALIGN_TYPE *destination_word;
 
 
     /* Setup source and destination byte oriented pointers.  */
     source =  (UCHAR *) memory_source;
     destination =  (UCHAR *) memory_destination;
 
+    /* Check if the blocks can be compared by words.  */
+    if ((length >= UX_UTILITY_MEMORY_WORD_SIZE * 2) &&
+        ((((ALIGN_TYPE)source ^ (ALIGN_TYPE)destination) & UX_UTILITY_MEMORY_WORD_MASK) == 0))
+    {
+
+        /* Compare bytes until word boundary.  */
+        while(((ALIGN_TYPE)source & UX_UTILITY_MEMORY_WORD_MASK) != 0)
+        {
+            if(*destination++ != *source++)
+                return(UX_ERROR);
+            length--;
+        }
+
+        /* Compare words.  */
+        source_word =  (ALIGN_TYPE *)(VOID *)source;
+        destination_word =  (ALIGN_TYPE *)(VOID *)destination;
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE)
+        {
+            if(*destination_word++ != *source_word++)
+                return(UX_ERROR);
+            length -= UX_UTILITY_MEMORY_WORD_SIZE;
+        }
+
+        /* Remaining bytes are compared after.  */
+        source =  (UCHAR *)source_word;
+        destination =  (UCHAR *)destination_word;
+    }
+
     /* Loop to compare blocks.  */
     while(length--)
     {
@@ -95,5 +139,5 @@ UCHAR *   destination;
     
     /* Blocks are equal, return success.  */           
     return(UX_SUCCESS); 
+#endif
 }
-
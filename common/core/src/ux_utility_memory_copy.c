@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_copy                             PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -42,6 +42,13 @@
 /*    This function copies a block of memory from a source to a           */ 
 /*    destination.                                                        */ 
 /*                                                                        */ 
+/*    If source and destination have the same alignment, the memory is   */
+/*    copied by words after the first bytes before word boundary. The     */
+/*    copy is done forward, so destination can overlap source end if it   */
+/*    is before source, as it was with byte copy.                         */
+/*                                                                        */ 
+/*    A port can define UX_MEMORY_COPY to use its optimized copy.         */
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    memory_destination                    Pointer to destination        */ 
@@ -67,18 +74,69 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            optimized with word access, */
+/*                                            added port override,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_memory_copy(VOID *memory_destination, VOID *memory_source, ULONG length)
 {
+#if defined(UX_MEMORY_COPY)
+
+    /* Use the port copy.  */
+    UX_MEMORY_COPY(memory_destination, memory_source, length);
+#else
 
 UCHAR *   source;
 UCHAR *   destination;
+ALIGN_TYPE *source_word;
+ALIGN_TYPE *destination_word;
 
     /* Setup byte oriented source and destination pointers.  */
     source =  (UCHAR *) memory_source;
     destination =  (UCHAR *) memory_destination;
 
+    /* Check if the copy can be done by words.  */
+    if ((length >= UX_UTILITY_MEMORY_WORD_SIZE * 2) &&
+        ((((ALIGN_TYPE)source ^ (ALIGN_TYPE)destination) & UX_UTILITY_MEMORY_WORD_MASK) == 0))
+    {
+
+        /* Copy bytes until word boundary.  */
+        while(((ALIGN_TYPE)source & UX_UTILITY_MEMORY_WORD_MASK) != 0)
+        {
+            *destination++ =  *source++;
+            length--;
+        }
+
+        /* Setup word oriented source and destination pointers.  */
+        source_word =  (ALIGN_TYPE *)(VOID *)source;
+        destination_word =  (ALIGN_TYPE *)(VOID *)destination;
+
+        /* Copy four words in a loop.  */
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE * 4)
+        {
+            destination_word[0] =  source_word[0];
+            destination_word[1] =  source_word[1];
+            destination_word[2] =  source_word[2];
+            destination_word[3] =  source_word[3];
+            destination_word += 4;
+            source_word += 4;
+            length -= UX_UTILITY_MEMORY_WORD_SIZE * 4;
+        }
+
+        /* Copy remaining words.  */
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE)
+        {
+            *destination_word++ =  *source_word++;
+            length -= UX_UTILITY_MEMORY_WORD_SIZE;
+        }
+
+        /* Remaining bytes are copied after.  */
+        source =  (UCHAR *)source_word;
+        destination =  (UCHAR *)destination_word;
+    }
+
     /* Loop to perform the copy.  */
     while(length--)
     {
@@ -86,8 +144,8 @@ UCHAR *   destination;
         /* Copy one byte.  */
         *destination++ =  *source++;
     }
+#endif
 
     /* Return to caller.  */
     return; 
 }
-
@@ -0,0 +1,161 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_fragmentation_get                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reports the fragmentation of a memory pool: the free  */
+/*    bytes, the largest free block, the number of free blocks and of all */
+/*    blocks, the fragmentation percentage and a histogram of free block  */
+/*    sizes (see UX_MEMORY_FRAGMENTATION). It can be polled by the        */
+/*    application to raise an alarm before allocations fail.              */
+/*                                                                        */
+/*    All blocks of the pool are walked from the first one, with the pool */
+/*    protection held.                                                    */
+/*    Slab pages and arena chunks are counted as allocated blocks.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory_cache_flag                     Memory pool source            */
+/*    fragmentation                         Pointer to report             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_system_mutex_on_count             Get pool mutex                */
+/*    _ux_system_mutex_off                  Put pool mutex                */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_fragmentation_get(ULONG memory_cache_flag, UX_MEMORY_FRAGMENTATION *fragmentation)
+{
+
+UX_MEMORY_BYTE_POOL *pool_ptr;
+UCHAR               *current_ptr;
+UCHAR               *next_ptr;
+UCHAR               **block_link_ptr;
+ALIGN_TYPE          *free_ptr;
+ULONG               block_size;
+ULONG               bin_size;
+UINT                bin;
+
+
+    /* Get the pool ptr.  */
+    if (memory_cache_flag == UX_REGULAR_MEMORY)
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    else if (memory_cache_flag == UX_CACHE_SAFE_MEMORY)
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+    else
+        return(UX_INVALID_PARAMETER);
+    if ((pool_ptr == UX_NULL) || (fragmentation == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Reset the report.  */
+    _ux_utility_memory_set(fragmentation, 0, sizeof(UX_MEMORY_FRAGMENTATION)); /* Use case of memset is verified. */
+
+    /* Get the pool mutex as this is a critical section.  */
+    _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+
+    /* Walk the blocks up to the last one, which links back to the start of the pool.  */
+#ifdef UX_ENABLE_MEMORY_TLSF
+
+    /* The first TLSF block is aligned after the pool start, it is kept as search pointer.  */
+    next_ptr =  pool_ptr -> ux_byte_pool_search;
+#else
+    next_ptr =  pool_ptr -> ux_byte_pool_start;
+#endif
+    do
+    {
+        current_ptr =  next_ptr;
+        block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(current_ptr);
+        next_ptr =  *block_link_ptr;
+        fragmentation -> ux_memory_fragmentation_blocks ++;
+
+        /* Count the free block.  */
+        free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(current_ptr, sizeof(UCHAR *)));
+        if ((next_ptr > current_ptr) && ((*free_ptr) == UX_BYTE_BLOCK_FREE))
+        {
+            block_size =  UX_UCHAR_POINTER_DIF(next_ptr, current_ptr) - UX_MEMORY_BLOCK_HEADER_SIZE;
+            fragmentation -> ux_memory_fragmentation_available +=  block_size;
+            fragmentation -> ux_memory_fragmentation_free_blocks ++;
+            if (block_size > fragmentation -> ux_memory_fragmentation_largest)
+                fragmentation -> ux_memory_fragmentation_largest =  block_size;
+
+            /* Find the histogram bin of the block.  */
+            bin_size =  UX_MEMORY_FRAGMENTATION_BIN_SIZE_MIN;
+            for (bin = 0; bin < UX_MEMORY_FRAGMENTATION_BIN_NUM - 1; bin ++)
+            {
+                if (block_size < bin_size)
+                    break;
+                bin_size <<= 1;
+            }
+            fragmentation -> ux_memory_fragmentation_histogram[bin] ++;
+        }
+    } while (next_ptr > current_ptr);
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+
+    /* Free bytes not in the largest block, scaled down so the percentage does not overflow.  */
+    block_size =  fragmentation -> ux_memory_fragmentation_available - fragmentation -> ux_memory_fragmentation_largest;
+    bin_size =  fragmentation -> ux_memory_fragmentation_available;
+    while (block_size > (0xFFFFFFFFUL / 100))
+    {
+        block_size >>= 1;
+        bin_size >>= 1;
+    }
+    if (bin_size != 0)
+        fragmentation -> ux_memory_fragmentation_percent =  (block_size * 100) / bin_size;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_utility_memory_free                             PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -51,8 +51,12 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _ux_utility_mutex_on                  Start system protection       */
-/*    _ux_utility_mutex_off                 End system protection         */
+/*    _ux_utility_mutex_on_count            Start pool protection         */
+/*    _ux_utility_mutex_off                 End pool protection           */
+/*    _ux_utility_memory_arena_free         Free object in arena          */
+/*    _ux_utility_memory_byte_pool_free     Free block to pool            */
+/*    _ux_utility_memory_profiler_free      Remove block from profiler    */
+/*    _ux_utility_memory_slab_free          Free object to slab           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -72,6 +76,15 @@
 /*                                            added some error traps,     */
 /*                                            refined memory management,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory slab support,  */
+/*                                            moved block release to byte */
+/*                                            pool free function,         */
+/*                                            added memory arena support, */
+/*                                            used pool mutex,            */
+/*                                            removed block from memory   */
+/*                                            profiler,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_memory_free(VOID *memory)
@@ -79,22 +92,22 @@ VOID  _ux_utility_memory_free(VOID *memory)
 UX_MEMORY_BYTE_POOL *pool_ptr;
 UCHAR               *work_ptr;
 UCHAR               *temp_ptr;
-UCHAR               *next_block_ptr;
-
+ULONG               block_size;
 ALIGN_TYPE          *free_ptr;
 UX_MEMORY_BYTE_POOL **byte_pool_ptr;
 UCHAR               **block_link_ptr;
+UX_MEMORY_BYTE_POOL *memory_pool_ptr;
 #ifdef UX_ENABLE_MEMORY_POOL_SANITY_CHECK
 UCHAR               *memory_address;
 UCHAR               *regular_start, *regular_end;
 UCHAR               *cache_safe_start, *cache_safe_end;
-#endif
-#ifdef UX_ENABLE_MEMORY_STATISTICS
-UINT                index;
 #endif
 
-    /* Get the mutex as this is a critical section.  */
-    _ux_system_mutex_on(&_ux_system -> ux_system_mutex);
+    /* The pool is found by the memory address, pools do not move.  */
+    memory_pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    if (((UCHAR*)memory < memory_pool_ptr -> ux_byte_pool_start) ||
+        ((UCHAR*)memory >= (memory_pool_ptr -> ux_byte_pool_start + memory_pool_ptr -> ux_byte_pool_size)))
+        memory_pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
 
 #ifdef UX_ENABLE_MEMORY_POOL_SANITY_CHECK
 
@@ -111,9 +124,6 @@ UINT                index;
           (memory_address >= cache_safe_start && memory_address < cache_safe_end)))
     {
 
-        /* Not valid. Release the protection.  */
-        _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
         /* Error trap.  */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
                                 UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
@@ -123,8 +133,11 @@ UINT                index;
     }
 #endif
 
-    /* Set the pool pointer to NULL.  */
-    pool_ptr =  UX_NULL;
+    /* Get the pool mutex as this is a critical section.  */
+    _ux_system_mutex_on_count(&memory_pool_ptr -> ux_byte_pool_mutex, &memory_pool_ptr -> ux_byte_pool_mutex_contentions);
+
+    /* Nothing is released yet.  */
+    block_size =  0;
 
     /* Determine if the memory pointer is valid.  */
     work_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(memory);
@@ -137,92 +150,71 @@ UINT                index;
         /* There is a pointer, pickup the pool pointer address.  */
         temp_ptr =  UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
         free_ptr =  UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
+#ifdef UX_ENABLE_MEMORY_ARENA
+        if ((*free_ptr) == UX_BYTE_BLOCK_ARENA)
+        {
+
+            /* Mark the object free in its arena, the arena is checked there.  */
+            block_size =  _ux_utility_memory_arena_free(memory);
+        }
+        else
+#endif
+#ifdef UX_ENABLE_MEMORY_SLAB
+        if ((*free_ptr) == UX_BYTE_BLOCK_SLAB)
+        {
+
+            /* Return the object to its slab, the object page is checked there.  */
+            block_size =  _ux_utility_memory_slab_free(memory);
+        }
+        else
+#endif
         if ((*free_ptr) != UX_BYTE_BLOCK_FREE)
         {
 
             /* Pickup the pool pointer.  */
-            temp_ptr =  UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
             byte_pool_ptr = UX_UCHAR_TO_INDIRECT_BYTE_POOL_POINTER(temp_ptr);
             pool_ptr = *byte_pool_ptr;
 
-            /* See if we have a valid pool pointer.  */
-            if ((pool_ptr == UX_NULL) ||
-                ((pool_ptr != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR]) &&
-                (pool_ptr != _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE])))
+            /* See if we have a valid pool pointer, the block must be in the pool.  */
+            if (pool_ptr == memory_pool_ptr)
             {
 
-                /* Release the protection.  */
-                _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
-                /* Error trap: maybe double free/memory issue here!  */
-                _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
-                                         UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
-
-                /* Return to caller.  */
-                return;
+                /* Get the block size and release the block.  */
+                block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
+                block_size =      UX_UCHAR_POINTER_DIF(*block_link_ptr, work_ptr);
+                _ux_utility_memory_byte_pool_free(pool_ptr, memory);
             }
         }
-        else
-        {
-            /* Release the protection.  */
-            _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
-
-            /* Error trap: maybe double free/memory issue here!  */
-            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
-                                     UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
-
-            /* Return to caller.  */
-            return;
-        }
     }
-    else
+
+    /* Check if the memory is released.  */
+    if (block_size == 0)
     {
 
         /* Release the protection.  */
-        _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+        _ux_system_mutex_off(&memory_pool_ptr -> ux_byte_pool_mutex);
 
-        /* Error trap: maybe double free/bad flow here!  */
+        /* Error trap: maybe double free/memory issue here!  */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD,
-                                    UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
+                                 UX_SYSTEM_CONTEXT_UTILITY, UX_MEMORY_CORRUPTED);
 
         /* Return to caller.  */
         return;
     }
 
-    /* At this point, we know that the pool pointer is valid.  */
-
-    /* Release the memory.  */
-    temp_ptr =   UX_UCHAR_POINTER_ADD(work_ptr, (sizeof(UCHAR *)));
-    free_ptr =   UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(temp_ptr);
-    *free_ptr =  UX_BYTE_BLOCK_FREE;
-
-    /* Update the number of available bytes in the pool.  */
-    block_link_ptr =  UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(work_ptr);
-    next_block_ptr =  *block_link_ptr;
-    pool_ptr -> ux_byte_pool_available =
-        pool_ptr -> ux_byte_pool_available + UX_UCHAR_POINTER_DIF(next_block_ptr, work_ptr);
-
-    /* Determine if the free block is prior to current search pointer.  */
-    if (work_ptr < (pool_ptr -> ux_byte_pool_search))
-    {
+#ifdef UX_ENABLE_MEMORY_STATISTICS
+    memory_pool_ptr -> ux_byte_pool_alloc_count --;
+    memory_pool_ptr -> ux_byte_pool_alloc_total -= block_size;
+#endif
 
-        /* Yes, update the search pointer to the released block.  */
-        pool_ptr -> ux_byte_pool_search =  work_ptr;
-    }
+#ifdef UX_ENABLE_MEMORY_PROFILER
 
-#ifdef UX_ENABLE_MEMORY_STATISTICS
-    if (((UCHAR*)memory >= _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_start) &&
-        ((UCHAR*)memory < (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_start + _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_size)))
-        index = UX_MEMORY_BYTE_POOL_REGULAR;
-    else
-        index = UX_MEMORY_BYTE_POOL_CACHE_SAFE;
-
-    _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_alloc_count --;
-    _ux_system -> ux_system_memory_byte_pool[index] -> ux_byte_pool_alloc_total -= UX_UCHAR_POINTER_DIF(next_block_ptr, work_ptr);
+    /* Remove the block from profiler.  */
+    _ux_utility_memory_profiler_free(memory_pool_ptr, memory);
 #endif
 
     /* Release the protection.  */
-    _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_off(&memory_pool_ptr -> ux_byte_pool_mutex);
 
     /* Return to caller.  */
     return;
@@ -0,0 +1,173 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_profiler_allocate                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function records a block allocated from a memory pool in the   */
+/*    pool profiler. The block is tagged with the owner set by the        */
+/*    calling thread, if any, and the live and peak usage of the tag are  */
+/*    updated.                                                            */
+/*                                                                        */
+/*    It's called with the pool mutex held.                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to memory pool        */
+/*    memory                                Pointer to memory allocated   */
+/*    memory_size_requested                 Number of bytes requested     */
+/*    memory_size                           Number of bytes of block      */
+/*    caller                                Address of caller             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_thread_identify           Get current thread            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_profiler_allocate(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory, ULONG memory_size_requested,
+                                           ULONG memory_size, ALIGN_TYPE caller)
+{
+
+UX_MEMORY_PROFILER          *profiler_ptr;
+UX_MEMORY_PROFILER_OWNER    *owner_ptr;
+UX_MEMORY_PROFILER_TAG      *tag_ptr;
+UX_MEMORY_PROFILER_BLOCK    *block_ptr;
+const UCHAR                 *owner_name;
+ULONG                       owner_address;
+ULONG                       tag_index;
+ULONG                       block_index;
+
+
+    /* Check if the pool is profiled.  */
+    profiler_ptr =  pool_ptr -> ux_byte_pool_profiler;
+    if (profiler_ptr == UX_NULL)
+        return;
+
+    /* Get the owner, only if it's set by this thread.  */
+    owner_ptr =  &_ux_system -> ux_system_memory_profiler_owner;
+    owner_name =  owner_ptr -> ux_memory_profiler_owner_name;
+    owner_address =  owner_ptr -> ux_memory_profiler_owner_address;
+#if !defined(UX_STANDALONE)
+    if (owner_ptr -> ux_memory_profiler_owner_thread != _ux_utility_thread_identify())
+        owner_name =  UX_NULL;
+#endif
+
+    /* Find the tag of the owner, tag 0 is for blocks with no owner.  */
+    tag_index =  0;
+    if (owner_name != UX_NULL)
+    {
+
+        for (tag_index = 1; tag_index < profiler_ptr -> ux_memory_profiler_tags_count; tag_index ++)
+        {
+            tag_ptr =  &profiler_ptr -> ux_memory_profiler_tags[tag_index];
+            if ((tag_ptr -> ux_memory_profiler_tag_name == owner_name) &&
+                (tag_ptr -> ux_memory_profiler_tag_address == owner_address))
+                break;
+        }
+
+        /* Add a new tag, if the tag table is full, tag 0 is used.  */
+        if (tag_index == profiler_ptr -> ux_memory_profiler_tags_count)
+        {
+            if (tag_index < UX_MEMORY_PROFILER_TAG_NUM)
+            {
+                tag_ptr =  &profiler_ptr -> ux_memory_profiler_tags[tag_index];
+                tag_ptr -> ux_memory_profiler_tag_name =  owner_name;
+                tag_ptr -> ux_memory_profiler_tag_address =  owner_address;
+                profiler_ptr -> ux_memory_profiler_tags_count ++;
+            }
+            else
+                tag_index =  0;
+        }
+    }
+    tag_ptr =  &profiler_ptr -> ux_memory_profiler_tags[tag_index];
+    tag_ptr -> ux_memory_profiler_tag_alloc_count ++;
+
+    /* Find a free entry in block table.  */
+    for (block_index = 0; block_index < UX_MEMORY_PROFILER_BLOCK_NUM; block_index ++)
+    {
+        if (profiler_ptr -> ux_memory_profiler_blocks[block_index].ux_memory_profiler_block_memory == UX_NULL)
+            break;
+    }
+
+    /* If the block table is full, the block is counted but not recorded.  */
+    if (block_index == UX_MEMORY_PROFILER_BLOCK_NUM)
+    {
+        profiler_ptr -> ux_memory_profiler_blocks_lost ++;
+        return;
+    }
+
+    /* Record the block, size includes its header.  */
+    memory_size +=  UX_MEMORY_BLOCK_HEADER_SIZE;
+    block_ptr =  &profiler_ptr -> ux_memory_profiler_blocks[block_index];
+    block_ptr -> ux_memory_profiler_block_memory =  memory;
+    block_ptr -> ux_memory_profiler_block_caller =  caller;
+    block_ptr -> ux_memory_profiler_block_size_requested =  memory_size_requested;
+    block_ptr -> ux_memory_profiler_block_size =  memory_size;
+    block_ptr -> ux_memory_profiler_block_tag =  tag_index;
+    profiler_ptr -> ux_memory_profiler_blocks_count ++;
+
+    /* Update tag usage and peak.  */
+    tag_ptr -> ux_memory_profiler_tag_blocks ++;
+    tag_ptr -> ux_memory_profiler_tag_bytes +=  memory_size;
+    if (tag_ptr -> ux_memory_profiler_tag_max_bytes < tag_ptr -> ux_memory_profiler_tag_bytes)
+        tag_ptr -> ux_memory_profiler_tag_max_bytes =  tag_ptr -> ux_memory_profiler_tag_bytes;
+
+    /* Update pool usage and peak.  */
+    profiler_ptr -> ux_memory_profiler_bytes +=  memory_size;
+    if (profiler_ptr -> ux_memory_profiler_max_bytes < profiler_ptr -> ux_memory_profiler_bytes)
+        profiler_ptr -> ux_memory_profiler_max_bytes =  profiler_ptr -> ux_memory_profiler_bytes;
+
+    /* Return to caller.  */
+    return;
+}
+#endif
@@ -0,0 +1,110 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_profiler_free                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes a block freed to a memory pool from the pool  */
+/*    profiler, and updates the live usage of the block tag. Blocks that  */
+/*    were not recorded are ignored.                                      */
+/*                                                                        */
+/*    It's called with the pool mutex held.                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to memory pool        */
+/*    memory                                Pointer to memory freed       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_profiler_free(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory)
+{
+
+UX_MEMORY_PROFILER          *profiler_ptr;
+UX_MEMORY_PROFILER_TAG      *tag_ptr;
+UX_MEMORY_PROFILER_BLOCK    *block_ptr;
+ULONG                       block_index;
+
+
+    /* Check if the pool is profiled.  */
+    profiler_ptr =  pool_ptr -> ux_byte_pool_profiler;
+    if (profiler_ptr == UX_NULL)
+        return;
+
+    /* Find the block in block table.  */
+    for (block_index = 0; block_index < UX_MEMORY_PROFILER_BLOCK_NUM; block_index ++)
+    {
+        block_ptr =  &profiler_ptr -> ux_memory_profiler_blocks[block_index];
+        if (block_ptr -> ux_memory_profiler_block_memory == memory)
+        {
+
+            /* Update tag and pool usage.  */
+            tag_ptr =  &profiler_ptr -> ux_memory_profiler_tags[block_ptr -> ux_memory_profiler_block_tag];
+            tag_ptr -> ux_memory_profiler_tag_blocks --;
+            tag_ptr -> ux_memory_profiler_tag_bytes -=  block_ptr -> ux_memory_profiler_block_size;
+            profiler_ptr -> ux_memory_profiler_bytes -=  block_ptr -> ux_memory_profiler_block_size;
+
+            /* Free the entry.  */
+            block_ptr -> ux_memory_profiler_block_memory =  UX_NULL;
+            profiler_ptr -> ux_memory_profiler_blocks_count --;
+            return;
+        }
+    }
+
+    /* Return to caller.  */
+    return;
+}
+#endif
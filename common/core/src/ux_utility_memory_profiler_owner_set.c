@@ -0,0 +1,103 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_profiler_owner_set               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the owner of the memory allocated by the calling */
+/*    thread, until the owner is restored. The blocks allocated are       */
+/*    tagged with the owner name and address in the memory profiler.      */
+/*                                                                        */
+/*    The stacks set the owner around their initialization, the device    */
+/*    enumeration and the class activation. The application can set it    */
+/*    around its own allocations. The owner name must stay valid while    */
+/*    the profiler is used, since only its pointer is kept.               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    owner_name                            Name of owner (class or stack)*/
+/*    owner_address                         Device address (host), or     */
+/*                                          interface number (device)     */
+/*    previous_owner                        Pointer to save previous owner*/
+/*                                          or UX_NULL                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_utility_thread_identify           Get current thread            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_profiler_owner_set(const UCHAR *owner_name, ULONG owner_address,
+                                            UX_MEMORY_PROFILER_OWNER *previous_owner)
+{
+
+UX_MEMORY_PROFILER_OWNER    *owner_ptr;
+
+
+    /* Save the previous owner.  */
+    owner_ptr =  &_ux_system -> ux_system_memory_profiler_owner;
+    if (previous_owner != UX_NULL)
+        _ux_utility_memory_copy(previous_owner, owner_ptr, sizeof(UX_MEMORY_PROFILER_OWNER)); /* Use case of memcpy is verified. */
+
+    /* Set the new owner, for the calling thread.  */
+    owner_ptr -> ux_memory_profiler_owner_name =  owner_name;
+    owner_ptr -> ux_memory_profiler_owner_address =  owner_address;
+#if !defined(UX_STANDALONE)
+    owner_ptr -> ux_memory_profiler_owner_thread =  _ux_utility_thread_identify();
+#endif
+
+    /* Return to caller.  */
+    return;
+}
+#endif
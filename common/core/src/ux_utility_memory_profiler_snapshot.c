@@ -0,0 +1,215 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_profiler_snapshot                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function takes a snapshot of the memory profiler of each pool. */
+/*    The snapshot is a binary image (see                                 */
+/*    UX_MEMORY_PROFILER_SNAPSHOT_MAGIC) which can be saved or sent to a  */
+/*    host by the application, and decoded there by                       */
+/*    utility/memory_profiler/ux_memory_profiler_dump.                    */
+/*                                                                        */
+/*    The image has a header, then for each pool a pool header with usage */
+/*    and peak, the tags with their live and peak usage, and the live     */
+/*    blocks with their size, tag and caller address.                     */
+/*                                                                        */
+/*    If the buffer is too small, nothing more is copied and the length   */
+/*    needed is returned. The buffer can be UX_NULL to get the length.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    buffer                                Pointer to buffer             */
+/*    buffer_length                         Length of buffer              */
+/*    actual_length                         Pointer to length of snapshot */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_put                  Put 32-bit value              */
+/*    _ux_utility_short_put                 Put 16-bit value              */
+/*    _ux_utility_memory_set                Set memory                    */
+/*    _ux_system_mutex_on_count             Get pool mutex                */
+/*    _ux_system_mutex_off                  Put pool mutex                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_profiler_snapshot(UCHAR *buffer, ULONG buffer_length, ULONG *actual_length)
+{
+
+UX_MEMORY_BYTE_POOL         *pool_ptr;
+UX_MEMORY_PROFILER          *profiler_ptr;
+UX_MEMORY_PROFILER_TAG      *tag_ptr;
+UX_MEMORY_PROFILER_BLOCK    *block_ptr;
+UCHAR                       *record_ptr;
+const UCHAR                 *name_ptr;
+ULONG                       length;
+ULONG                       pool_length;
+ULONG                       pool_index;
+ULONG                       pools;
+ULONG                       index;
+ALIGN_TYPE                  value;
+
+
+    /* The cache safe pool is the regular pool if there is no cache safe memory.  */
+    if (_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] ==
+        _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR])
+        pools =  1;
+    else
+        pools =  UX_MEMORY_BYTE_POOL_NUM;
+
+    /* Snapshot header.  */
+    length =  UX_MEMORY_PROFILER_SNAPSHOT_HEADER_LENGTH;
+    if ((buffer != UX_NULL) && (length <= buffer_length))
+    {
+        _ux_utility_long_put(buffer, UX_MEMORY_PROFILER_SNAPSHOT_MAGIC);
+        _ux_utility_short_put(buffer + 4, UX_MEMORY_PROFILER_SNAPSHOT_VERSION);
+        _ux_utility_short_put(buffer + 6, (USHORT)pools);
+    }
+
+    for (pool_index = 0; pool_index < pools; pool_index ++)
+    {
+
+        /* Lock the pool while its profiler is copied.  */
+        pool_ptr =  _ux_system -> ux_system_memory_byte_pool[pool_index];
+        profiler_ptr =  pool_ptr -> ux_byte_pool_profiler;
+        _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+
+        /* Check if the pool fits in buffer.  */
+        pool_length =  UX_MEMORY_PROFILER_SNAPSHOT_POOL_LENGTH;
+        if (profiler_ptr != UX_NULL)
+        {
+            pool_length +=  profiler_ptr -> ux_memory_profiler_tags_count * UX_MEMORY_PROFILER_SNAPSHOT_TAG_LENGTH;
+            pool_length +=  profiler_ptr -> ux_memory_profiler_blocks_count * UX_MEMORY_PROFILER_SNAPSHOT_BLOCK_LENGTH;
+        }
+        if ((buffer == UX_NULL) || (length + pool_length > buffer_length))
+        {
+
+            /* Only the length is updated.  */
+            length +=  pool_length;
+            _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+            continue;
+        }
+
+        /* Pool header.  */
+        record_ptr =  buffer + length;
+        _ux_utility_memory_set(record_ptr, 0, UX_MEMORY_PROFILER_SNAPSHOT_POOL_LENGTH); /* Use case of memset is verified. */
+        *record_ptr =  (UCHAR)pool_index;
+        _ux_utility_long_put(record_ptr + 8, pool_ptr -> ux_byte_pool_size);
+        _ux_utility_long_put(record_ptr + 12, pool_ptr -> ux_byte_pool_available);
+        _ux_utility_long_put(record_ptr + 16, pool_ptr -> ux_byte_pool_fragments);
+        if (profiler_ptr != UX_NULL)
+        {
+            _ux_utility_short_put(record_ptr + 2, (USHORT)profiler_ptr -> ux_memory_profiler_tags_count);
+            _ux_utility_long_put(record_ptr + 4, profiler_ptr -> ux_memory_profiler_blocks_count);
+            _ux_utility_long_put(record_ptr + 20, profiler_ptr -> ux_memory_profiler_bytes);
+            _ux_utility_long_put(record_ptr + 24, profiler_ptr -> ux_memory_profiler_max_bytes);
+            _ux_utility_long_put(record_ptr + 28, profiler_ptr -> ux_memory_profiler_blocks_lost);
+        }
+        record_ptr +=  UX_MEMORY_PROFILER_SNAPSHOT_POOL_LENGTH;
+
+        if (profiler_ptr != UX_NULL)
+        {
+
+            /* Tags, the name is truncated and padded with 0.  */
+            for (index = 0; index < profiler_ptr -> ux_memory_profiler_tags_count; index ++)
+            {
+                tag_ptr =  &profiler_ptr -> ux_memory_profiler_tags[index];
+                _ux_utility_memory_set(record_ptr, 0, UX_MEMORY_PROFILER_TAG_NAME_LENGTH); /* Use case of memset is verified. */
+                name_ptr =  tag_ptr -> ux_memory_profiler_tag_name;
+                if (name_ptr != UX_NULL)
+                {
+                    for (value = 0; (value < UX_MEMORY_PROFILER_TAG_NAME_LENGTH - 1) && (name_ptr[value] != 0); value ++)
+                        record_ptr[value] =  name_ptr[value];
+                }
+                record_ptr +=  UX_MEMORY_PROFILER_TAG_NAME_LENGTH;
+                _ux_utility_long_put(record_ptr, tag_ptr -> ux_memory_profiler_tag_address);
+                _ux_utility_long_put(record_ptr + 4, tag_ptr -> ux_memory_profiler_tag_blocks);
+                _ux_utility_long_put(record_ptr + 8, tag_ptr -> ux_memory_profiler_tag_bytes);
+                _ux_utility_long_put(record_ptr + 12, tag_ptr -> ux_memory_profiler_tag_max_bytes);
+                _ux_utility_long_put(record_ptr + 16, tag_ptr -> ux_memory_profiler_tag_alloc_count);
+                record_ptr +=  UX_MEMORY_PROFILER_SNAPSHOT_TAG_LENGTH - UX_MEMORY_PROFILER_TAG_NAME_LENGTH;
+            }
+
+            /* Live blocks, addresses are saved as 64-bit values.  */
+            for (index = 0; index < UX_MEMORY_PROFILER_BLOCK_NUM; index ++)
+            {
+                block_ptr =  &profiler_ptr -> ux_memory_profiler_blocks[index];
+                if (block_ptr -> ux_memory_profiler_block_memory == UX_NULL)
+                    continue;
+                _ux_utility_memory_set(record_ptr, 0, UX_MEMORY_PROFILER_SNAPSHOT_BLOCK_LENGTH); /* Use case of memset is verified. */
+                _ux_utility_short_put(record_ptr, (USHORT)block_ptr -> ux_memory_profiler_block_tag);
+                _ux_utility_long_put(record_ptr + 4, block_ptr -> ux_memory_profiler_block_size_requested);
+                _ux_utility_long_put(record_ptr + 8, block_ptr -> ux_memory_profiler_block_size);
+                value =  (ALIGN_TYPE)block_ptr -> ux_memory_profiler_block_memory;
+                _ux_utility_long_put(record_ptr + 16, (ULONG)value);
+                _ux_utility_long_put(record_ptr + 20, (ULONG)((value >> 16) >> 16));
+                value =  block_ptr -> ux_memory_profiler_block_caller;
+                _ux_utility_long_put(record_ptr + 24, (ULONG)value);
+                _ux_utility_long_put(record_ptr + 28, (ULONG)((value >> 16) >> 16));
+                record_ptr +=  UX_MEMORY_PROFILER_SNAPSHOT_BLOCK_LENGTH;
+            }
+        }
+        length +=  pool_length;
+
+        /* Release the pool.  */
+        _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+    }
+
+    /* Return the snapshot length.  */
+    *actual_length =  length;
+
+    /* Check if everything is copied.  */
+    if ((buffer == UX_NULL) || (length > buffer_length))
+        return(UX_MEMORY_INSUFFICIENT);
+    return(UX_SUCCESS);
+}
+#endif
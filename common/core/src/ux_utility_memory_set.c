@@ -32,7 +32,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_set                              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -41,6 +41,9 @@
 /*                                                                        */ 
 /*    This function sets a memory block with a specific value.            */ 
 /*                                                                        */ 
+/*    The memory is set by words after the first bytes before word        */
+/*    boundary. A port can define UX_MEMORY_SET to use its optimized set. */
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    destination                           Destination address           */ 
@@ -66,17 +69,69 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            optimized with word access, */
+/*                                            added port override,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_utility_memory_set(VOID *destination, UCHAR value, ULONG length)
 {
+#if defined(UX_MEMORY_SET)
+
+    /* Use the port set.  */
+    UX_MEMORY_SET(destination, value, length);
+#else
 
 UCHAR *    work_ptr;
+ALIGN_TYPE *work_word_ptr;
+ALIGN_TYPE value_word;
 
 
     /* Setup the working pointer */
     work_ptr =  (UCHAR *) destination;
 
+    /* Check if the memory can be set by words.  */
+    if (length >= UX_UTILITY_MEMORY_WORD_SIZE * 2)
+    {
+
+        /* Set bytes until word boundary.  */
+        while(((ALIGN_TYPE)work_ptr & UX_UTILITY_MEMORY_WORD_MASK) != 0)
+        {
+            *work_ptr++ =  value;
+            length--;
+        }
+
+        /* Build the word with value in all bytes.  */
+        value_word =  (ALIGN_TYPE)value;
+        value_word |= value_word << 8;
+        value_word |= value_word << 16;
+        if (UX_UTILITY_MEMORY_WORD_SIZE > 4)
+            value_word |= (value_word << 16) << 16;
+
+        /* Set four words in a loop.  */
+        work_word_ptr =  (ALIGN_TYPE *)(VOID *)work_ptr;
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE * 4)
+        {
+            work_word_ptr[0] =  value_word;
+            work_word_ptr[1] =  value_word;
+            work_word_ptr[2] =  value_word;
+            work_word_ptr[3] =  value_word;
+            work_word_ptr += 4;
+            length -= UX_UTILITY_MEMORY_WORD_SIZE * 4;
+        }
+
+        /* Set remaining words.  */
+        while(length >= UX_UTILITY_MEMORY_WORD_SIZE)
+        {
+            *work_word_ptr++ =  value_word;
+            length -= UX_UTILITY_MEMORY_WORD_SIZE;
+        }
+
+        /* Remaining bytes are set after.  */
+        work_ptr =  (UCHAR *)work_word_ptr;
+    }
+
     /* Loop to set the memory.  */
     while(length--)
     {
@@ -84,8 +139,8 @@ UCHAR *    work_ptr;
         /* Set a byte.  */
         *work_ptr++ =  value;
     }
+#endif
 
     /* Return to caller.  */
     return; 
 }
-
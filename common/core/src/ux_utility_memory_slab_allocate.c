@@ -0,0 +1,150 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_allocate                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function takes an object from a size class slab. If there is  */
+/*    no free object in the slab, a new page is carved from the byte pool */
+/*    owning the slab and split into objects. Empty pages kept in the     */
+/*    slab are used before carving new pages.                             */
+/*                                                                        */
+/*    The object content is not cleared and no statistics are updated.    */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    slab_ptr                              Pointer to slab (size class)  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to object memory                                            */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_allocate Allocate block from pool      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_ux_utility_memory_slab_allocate(UX_MEMORY_SLAB *slab_ptr)
+{
+UX_MEMORY_SLAB_PAGE *page_ptr;
+UCHAR               *object_ptr;
+UCHAR               **object_link_ptr;
+ALIGN_TYPE          *free_ptr;
+ULONG               object_stride;
+ULONG               object_index;
+
+
+    /* Get the first page that has free objects.  */
+    page_ptr = slab_ptr -> ux_memory_slab_pages;
+
+    /* If there is no such page, carve a new one from the byte pool.  */
+    if (page_ptr == UX_NULL)
+    {
+
+        object_stride = slab_ptr -> ux_memory_slab_object_size + UX_MEMORY_BLOCK_HEADER_SIZE;
+        object_ptr = _ux_utility_memory_byte_pool_allocate(slab_ptr -> ux_memory_slab_pool, UX_NO_ALIGN,
+                                UX_MEMORY_SLAB_PAGE_HEADER_SIZE + object_stride * slab_ptr -> ux_memory_slab_page_objects);
+        if (object_ptr == UX_NULL)
+            return(UX_NULL);
+
+        /* Setup the page.  */
+        page_ptr = (UX_MEMORY_SLAB_PAGE *)(VOID *)object_ptr;
+        page_ptr -> ux_memory_slab_page_next = UX_NULL;
+        page_ptr -> ux_memory_slab_page_previous = UX_NULL;
+        page_ptr -> ux_memory_slab_page_slab = slab_ptr;
+        page_ptr -> ux_memory_slab_page_free = UX_NULL;
+        page_ptr -> ux_memory_slab_page_used = 0;
+
+        /* Link all objects to the free list of the page, the first object on the head.  */
+        object_ptr = UX_UCHAR_POINTER_ADD(object_ptr, UX_MEMORY_SLAB_PAGE_HEADER_SIZE + object_stride * slab_ptr -> ux_memory_slab_page_objects);
+        for (object_index = 0; object_index < slab_ptr -> ux_memory_slab_page_objects; object_index ++)
+        {
+            object_ptr = UX_UCHAR_POINTER_SUB(object_ptr, object_stride);
+            object_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(object_ptr);
+            *object_link_ptr = page_ptr -> ux_memory_slab_page_free;
+            free_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(object_ptr, sizeof(UCHAR *)));
+            *free_ptr = UX_BYTE_BLOCK_FREE;
+            page_ptr -> ux_memory_slab_page_free = object_ptr;
+        }
+
+        /* The page is now the only one with free objects.  */
+        slab_ptr -> ux_memory_slab_pages = page_ptr;
+    }
+    else if (page_ptr -> ux_memory_slab_page_used == 0)
+    {
+
+        /* The empty page kept in the slab is used again.  */
+        slab_ptr -> ux_memory_slab_pages_empty --;
+    }
+
+    /* Take the first free object of the page.  */
+    object_ptr = page_ptr -> ux_memory_slab_page_free;
+    object_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(object_ptr);
+    page_ptr -> ux_memory_slab_page_free = *object_link_ptr;
+    page_ptr -> ux_memory_slab_page_used ++;
+
+    /* Mark the object as allocated and link it to its page.  */
+    *object_link_ptr = (UCHAR *)(VOID *)page_ptr;
+    free_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(object_ptr, sizeof(UCHAR *)));
+    *free_ptr = UX_BYTE_BLOCK_SLAB;
+
+    /* If the page is full, remove it from the list of pages with free objects.  */
+    if (page_ptr -> ux_memory_slab_page_free == UX_NULL)
+    {
+        slab_ptr -> ux_memory_slab_pages = page_ptr -> ux_memory_slab_page_next;
+        if (page_ptr -> ux_memory_slab_page_next != UX_NULL)
+            page_ptr -> ux_memory_slab_page_next -> ux_memory_slab_page_previous = UX_NULL;
+        page_ptr -> ux_memory_slab_page_next = UX_NULL;
+    }
+
+    /* Return the object memory.  */
+    return(UX_UCHAR_POINTER_ADD(object_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+}
+#endif
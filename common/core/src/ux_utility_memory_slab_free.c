@@ -0,0 +1,150 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_free                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns an object to its size class slab. When all   */
+/*    objects of the page are free, the page is kept in the slab if less  */
+/*    than UX_MEMORY_SLAB_EMPTY_PAGES_MAX empty pages are kept, so that   */
+/*    an allocate/free cycle does not carve and release a page each time. */
+/*    Otherwise the page is released to the byte pool so that memory is   */
+/*    not kept by a single size class.                                    */
+/*                                                                        */
+/*    No statistics are updated.                                          */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory                                Pointer to object memory      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Number of bytes released (including object header), 0 if the       */
+/*    object is not valid.                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_free     Free block to pool            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_utility_memory_slab_free(VOID *memory)
+{
+UX_MEMORY_BYTE_POOL *pool_ptr;
+UX_MEMORY_SLAB      *slab_ptr;
+UX_MEMORY_SLAB_PAGE *page_ptr;
+UCHAR               *object_ptr;
+UCHAR               **object_link_ptr;
+ALIGN_TYPE          *free_ptr;
+UINT                index;
+
+
+    /* Back off the memory pointer to pickup the object header.  */
+    object_ptr = UX_UCHAR_POINTER_SUB(memory, UX_MEMORY_BLOCK_HEADER_SIZE);
+    object_link_ptr = UX_UCHAR_TO_INDIRECT_UCHAR_POINTER_CONVERT(object_ptr);
+    page_ptr = (UX_MEMORY_SLAB_PAGE *)(VOID *)*object_link_ptr;
+
+    /* The page must be inside one of the pools and linked to one slab of that pool.  */
+    slab_ptr = UX_NULL;
+    for (index = 0; index < UX_MEMORY_BYTE_POOL_NUM; index ++)
+    {
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[index];
+        if (((UCHAR *)(VOID *)page_ptr >= pool_ptr -> ux_byte_pool_start) &&
+            ((UCHAR *)(VOID *)page_ptr < pool_ptr -> ux_byte_pool_start + pool_ptr -> ux_byte_pool_size))
+        {
+            slab_ptr = page_ptr -> ux_memory_slab_page_slab;
+            if ((slab_ptr >= &pool_ptr -> ux_byte_pool_slab[0]) &&
+                (slab_ptr < &pool_ptr -> ux_byte_pool_slab[UX_MEMORY_SLAB_CLASS_NUM]))
+                break;
+        }
+    }
+    if (index >= UX_MEMORY_BYTE_POOL_NUM)
+        return(0);
+
+    /* Mark the object as free and put it back to the page.  */
+    free_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(UX_UCHAR_POINTER_ADD(object_ptr, sizeof(UCHAR *)));
+    *free_ptr = UX_BYTE_BLOCK_FREE;
+    *object_link_ptr = page_ptr -> ux_memory_slab_page_free;
+    page_ptr -> ux_memory_slab_page_free = object_ptr;
+
+    /* If the page was full, it has free object now, link it to the slab.  */
+    if (page_ptr -> ux_memory_slab_page_used == slab_ptr -> ux_memory_slab_page_objects)
+    {
+        page_ptr -> ux_memory_slab_page_previous = UX_NULL;
+        page_ptr -> ux_memory_slab_page_next = slab_ptr -> ux_memory_slab_pages;
+        if (slab_ptr -> ux_memory_slab_pages != UX_NULL)
+            slab_ptr -> ux_memory_slab_pages -> ux_memory_slab_page_previous = page_ptr;
+        slab_ptr -> ux_memory_slab_pages = page_ptr;
+    }
+
+    /* If all objects of the page are free, keep the page or release it.  */
+    page_ptr -> ux_memory_slab_page_used --;
+    if ((page_ptr -> ux_memory_slab_page_used == 0) &&
+        (slab_ptr -> ux_memory_slab_pages_empty < UX_MEMORY_SLAB_EMPTY_PAGES_MAX))
+    {
+
+        /* The empty page stays in the list of pages with free objects.  */
+        slab_ptr -> ux_memory_slab_pages_empty ++;
+    }
+    else if (page_ptr -> ux_memory_slab_page_used == 0)
+    {
+        if (page_ptr -> ux_memory_slab_page_previous != UX_NULL)
+            page_ptr -> ux_memory_slab_page_previous -> ux_memory_slab_page_next = page_ptr -> ux_memory_slab_page_next;
+        else
+            slab_ptr -> ux_memory_slab_pages = page_ptr -> ux_memory_slab_page_next;
+        if (page_ptr -> ux_memory_slab_page_next != UX_NULL)
+            page_ptr -> ux_memory_slab_page_next -> ux_memory_slab_page_previous = page_ptr -> ux_memory_slab_page_previous;
+
+        _ux_utility_memory_byte_pool_free(slab_ptr -> ux_memory_slab_pool, page_ptr);
+    }
+
+    /* Return the size of the object.  */
+    return(slab_ptr -> ux_memory_slab_object_size + UX_MEMORY_BLOCK_HEADER_SIZE);
+}
+#endif
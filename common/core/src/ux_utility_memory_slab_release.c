@@ -0,0 +1,114 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_release                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases the empty pages kept in the size class slabs */
+/*    of a byte pool back to the byte pool.                               */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to byte pool          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Number of pages released                                            */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_free     Free block to pool            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*    _ux_utility_memory_slab_trim          Trim slabs                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_utility_memory_slab_release(UX_MEMORY_BYTE_POOL *pool_ptr)
+{
+UX_MEMORY_SLAB      *slab_ptr;
+UX_MEMORY_SLAB_PAGE *page_ptr;
+UX_MEMORY_SLAB_PAGE *next_page_ptr;
+ULONG               pages_released;
+UINT                index;
+
+
+    pages_released = 0;
+    for (index = 0; index < UX_MEMORY_SLAB_CLASS_NUM; index ++)
+    {
+        slab_ptr = &pool_ptr -> ux_byte_pool_slab[index];
+
+        /* Empty pages are in the list of pages with free objects.  */
+        page_ptr = slab_ptr -> ux_memory_slab_pages;
+        while ((page_ptr != UX_NULL) && (slab_ptr -> ux_memory_slab_pages_empty != 0))
+        {
+            next_page_ptr = page_ptr -> ux_memory_slab_page_next;
+            if (page_ptr -> ux_memory_slab_page_used == 0)
+            {
+
+                /* Unlink the page and release it.  */
+                if (page_ptr -> ux_memory_slab_page_previous != UX_NULL)
+                    page_ptr -> ux_memory_slab_page_previous -> ux_memory_slab_page_next = next_page_ptr;
+                else
+                    slab_ptr -> ux_memory_slab_pages = next_page_ptr;
+                if (next_page_ptr != UX_NULL)
+                    next_page_ptr -> ux_memory_slab_page_previous = page_ptr -> ux_memory_slab_page_previous;
+
+                _ux_utility_memory_byte_pool_free(pool_ptr, page_ptr);
+                slab_ptr -> ux_memory_slab_pages_empty --;
+                pages_released ++;
+            }
+            page_ptr = next_page_ptr;
+        }
+    }
+
+    /* Return the number of pages released.  */
+    return(pages_released);
+}
+#endif
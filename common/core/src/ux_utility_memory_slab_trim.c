@@ -0,0 +1,103 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_slab_trim                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases the empty pages kept in the size class slabs */
+/*    of a memory pool back to the byte pool. It can be called by the     */
+/*    application to get back memory after a burst of small allocations. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    memory_cache_flag                     Memory pool source            */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_system_mutex_on_count             Get pool mutex                */
+/*    _ux_system_mutex_off                  Put pool mutex                */
+/*    _ux_utility_memory_slab_release       Release empty slab pages      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_slab_trim(ULONG memory_cache_flag)
+{
+#ifdef UX_ENABLE_MEMORY_SLAB
+UX_MEMORY_BYTE_POOL *pool_ptr;
+
+
+    /* Get the pool ptr.  */
+    if (memory_cache_flag == UX_REGULAR_MEMORY)
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    else if (memory_cache_flag == UX_CACHE_SAFE_MEMORY)
+        pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE];
+    else
+        return(UX_INVALID_PARAMETER);
+    if (pool_ptr == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Get the pool mutex as this is a critical section.  */
+    _ux_system_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+
+    /* Release the empty pages of all size classes.  */
+    _ux_utility_memory_slab_release(pool_ptr);
+
+    /* Release the protection.  */
+    _ux_system_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+#else
+    UX_PARAMETER_NOT_USED(memory_cache_flag);
+#endif
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
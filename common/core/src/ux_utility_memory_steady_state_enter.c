@@ -0,0 +1,92 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_steady_state_enter               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function marks an owner (host stack, device stack or           */
+/*    application) as in steady state. While any owner is in steady       */
+/*    state, each memory allocation is counted and reported to the error  */
+/*    handler, with its caller address saved in the system structure.     */
+/*    While a class holds steady state off, the owner is kept pending and */
+/*    enters steady state on the last release.                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    steady_state_owner                    Steady state owner            */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_steady_state_enter(ULONG steady_state_owner)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Owners are switched from different threads.  */
+    UX_DISABLE
+
+    /* Mark the owner in steady state, or pending if a class is still allocating.  */
+    if (_ux_system -> ux_system_memory_steady_state_holds != 0)
+        _ux_system -> ux_system_memory_steady_state_pending |=  steady_state_owner;
+    else
+        _ux_system -> ux_system_memory_steady_state |=  steady_state_owner;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
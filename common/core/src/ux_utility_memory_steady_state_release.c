@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_steady_state_release             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by a class once it is done allocating, it   */
+/*    releases a hold taken by _ux_utility_memory_steady_state_hold. On   */
+/*    the last release, the pending owners enter steady state.            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_steady_state_release(VOID)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Holds are taken and released from different threads.  */
+    UX_DISABLE
+
+    /* Release the hold, pending owners enter steady state on the last one.  */
+    if (_ux_system -> ux_system_memory_steady_state_holds != 0)
+        _ux_system -> ux_system_memory_steady_state_holds --;
+    if (_ux_system -> ux_system_memory_steady_state_holds == 0)
+    {
+        _ux_system -> ux_system_memory_steady_state |=
+                                        _ux_system -> ux_system_memory_steady_state_pending;
+        _ux_system -> ux_system_memory_steady_state_pending =  0;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
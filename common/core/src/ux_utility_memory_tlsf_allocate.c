@@ -0,0 +1,165 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_allocate                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function carves a block of memory for the specified size and   */
+/*    alignment out of a TLSF byte pool, in bounded time.                 */
+/*                                                                        */
+/*    For alignment larger than minimum, the space before the aligned     */
+/*    memory buffer is returned to the pool as a free block, so no memory */
+/*    is lost for padding. The space after the requested size is also     */
+/*    returned to the pool if it is large enough for a block.             */
+/*                                                                        */
+/*    The block is marked as owned by the pool, but its content is not    */
+/*    cleared and no statistics are updated.                              */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    memory_alignment                      Memory alignment required     */
+/*    memory_size_requested                 Number of bytes required      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to block of memory                                          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_block_find    Find and remove free block    */
+/*    _ux_utility_memory_tlsf_block_insert  Insert block to list          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_allocate Allocate block from pool      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_ux_utility_memory_tlsf_allocate(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG memory_alignment,
+                                         ULONG memory_size_requested)
+{
+
+UCHAR               *block_ptr;
+UCHAR               *split_ptr;
+ULONG               block_size;
+ALIGN_TYPE          int_memory_buffer;
+ALIGN_TYPE          int_aligned_buffer;
+
+
+    /* Ensure the alignment meats the minimum.  */
+    if (memory_alignment < UX_ALIGN_MIN)
+        memory_alignment =  UX_ALIGN_MIN;
+
+    /* Requests that have no size class are rejected.  */
+    if ((memory_size_requested >> UX_MEMORY_TLSF_FL_INDEX_MAX) != 0 ||
+        (memory_alignment >> UX_MEMORY_TLSF_FL_INDEX_MAX) != 0)
+        return(UX_NULL);
+
+    /* Get the block size with header, keep block aligned.  */
+    block_size = (memory_size_requested + UX_MEMORY_BLOCK_HEADER_SIZE + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN);
+    if (block_size < UX_MEMORY_TLSF_BLOCK_SIZE_MIN)
+        block_size = UX_MEMORY_TLSF_BLOCK_SIZE_MIN;
+
+    /* Find a free block, for extra alignment leave space for a free block before the buffer.  */
+    if (memory_alignment <= UX_ALIGN_MIN)
+        block_ptr = _ux_utility_memory_tlsf_block_find(pool_ptr, block_size);
+    else
+        block_ptr = _ux_utility_memory_tlsf_block_find(pool_ptr, block_size + memory_alignment + UX_MEMORY_TLSF_BLOCK_SIZE_MIN);
+    if (block_ptr == UX_NULL)
+        return(UX_NULL);
+
+    /* Check if the memory buffer is aligned.  */
+    int_memory_buffer = (ALIGN_TYPE)UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
+    int_aligned_buffer = (int_memory_buffer + memory_alignment) & ~((ALIGN_TYPE)memory_alignment);
+    if (int_aligned_buffer != int_memory_buffer)
+    {
+
+        /* The space before must be large enough for a free block.  */
+        if ((int_aligned_buffer - int_memory_buffer) < UX_MEMORY_TLSF_BLOCK_SIZE_MIN)
+            int_aligned_buffer = (int_memory_buffer + UX_MEMORY_TLSF_BLOCK_SIZE_MIN + memory_alignment) & ~((ALIGN_TYPE)memory_alignment);
+
+        /* Split the block, the space before stays free.  */
+        split_ptr = UX_UCHAR_POINTER_SUB((UCHAR *)int_aligned_buffer, UX_MEMORY_BLOCK_HEADER_SIZE);
+        UX_MEMORY_TLSF_BLOCK_NEXT(split_ptr) = UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr);
+        UX_MEMORY_TLSF_BLOCK_PREVIOUS(split_ptr) = block_ptr;
+        UX_MEMORY_TLSF_BLOCK_PREVIOUS(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr)) = split_ptr;
+        UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr) = split_ptr;
+        _ux_utility_memory_tlsf_block_insert(pool_ptr, block_ptr);
+
+        /* Increase the total fragment counter.  */
+        pool_ptr -> ux_byte_pool_fragments++;
+
+        /* Continue with the aligned block.  */
+        block_ptr = split_ptr;
+    }
+
+    /* Determine if we need to split the space after the block.  */
+    if (UX_UCHAR_POINTER_DIF(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr), block_ptr) - block_size >= UX_MEMORY_TLSF_BLOCK_SIZE_MIN)
+    {
+
+        /* Split the block, the space after is free.  */
+        split_ptr = UX_UCHAR_POINTER_ADD(block_ptr, block_size);
+        UX_MEMORY_TLSF_BLOCK_NEXT(split_ptr) = UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr);
+        UX_MEMORY_TLSF_BLOCK_PREVIOUS(split_ptr) = block_ptr;
+        UX_MEMORY_TLSF_BLOCK_PREVIOUS(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr)) = split_ptr;
+        UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr) = split_ptr;
+        _ux_utility_memory_tlsf_block_insert(pool_ptr, split_ptr);
+
+        /* Increase the total fragment counter.  */
+        pool_ptr -> ux_byte_pool_fragments++;
+    }
+
+    /* Mark the block as allocated.  */
+    UX_MEMORY_TLSF_BLOCK_OWNER(block_ptr) = (ALIGN_TYPE)pool_ptr;
+
+    /* Reduce the number of available bytes in the pool.  */
+    pool_ptr -> ux_byte_pool_available -= UX_UCHAR_POINTER_DIF(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr), block_ptr);
+
+    /* Return the memory buffer for the caller.  */
+    return(UX_UCHAR_POINTER_ADD(block_ptr, UX_MEMORY_BLOCK_HEADER_SIZE));
+}
+#endif
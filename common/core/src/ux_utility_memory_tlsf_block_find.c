@@ -0,0 +1,127 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_block_find                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds a free block that is large enough for the       */
+/*    requested block size and removes it from TLSF free lists.           */
+/*                                                                        */
+/*    The requested size is rounded up to the next size class, so that    */
+/*    any block of the list found is large enough (good fit). The lists   */
+/*    are located by bitmaps with bounded number of steps.                */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    block_size                            Size of block (with header)   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to the free block found, UX_NULL if not found               */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_fls           Find most significant bit     */
+/*    _ux_utility_memory_tlsf_mapping       Map size to list indexes      */
+/*    _ux_utility_memory_tlsf_block_remove  Remove block from list        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UCHAR  *_ux_utility_memory_tlsf_block_find(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG block_size)
+{
+
+UCHAR               *block_ptr;
+ULONG               round_size;
+ULONG               bitmap;
+UINT                fl;
+UINT                sl;
+
+
+    /* Round up the size to the next size class.  */
+    if (block_size >= UX_MEMORY_TLSF_SMALL_BLOCK_SIZE)
+    {
+        round_size = (1ul << (_ux_utility_memory_tlsf_fls(block_size) - UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+        if (block_size + round_size < block_size)
+            return(UX_NULL);
+        block_size += round_size;
+    }
+
+    /* Too large, no list for it.  */
+    if ((block_size >> UX_MEMORY_TLSF_FL_INDEX_MAX) != 0)
+        return(UX_NULL);
+
+    /* Get the list indexes.  */
+    _ux_utility_memory_tlsf_mapping(block_size, &fl, &sl);
+
+    /* Search for a non-empty list in the same first level range.  */
+    bitmap = pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] & (~0ul << sl);
+    if (bitmap == 0)
+    {
+
+        /* Search for a non-empty first level range that is larger.  */
+        bitmap = pool_ptr -> ux_byte_pool_tlsf_fl_bitmap & (~0ul << (fl + 1));
+        if (bitmap == 0)
+            return(UX_NULL);
+
+        /* Get the first non-empty list in that range.  */
+        fl = _ux_utility_memory_tlsf_fls(bitmap & (~bitmap + 1));
+        bitmap = pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl];
+    }
+    sl = _ux_utility_memory_tlsf_fls(bitmap & (~bitmap + 1));
+
+    /* Take the block from the list.  */
+    block_ptr = pool_ptr -> ux_byte_pool_tlsf_blocks[fl][sl];
+    _ux_utility_memory_tlsf_block_remove(pool_ptr, block_ptr);
+
+    /* Return the block found.  */
+    return(block_ptr);
+}
+#endif
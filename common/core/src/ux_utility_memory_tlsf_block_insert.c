@@ -0,0 +1,98 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_block_insert                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function marks a block as free and inserts it at the head of   */
+/*    the TLSF free list matching its size.                               */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    block_ptr                             Pointer to block              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping       Map size to list indexes      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_block_insert(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr)
+{
+
+UCHAR               *head_ptr;
+UINT                fl;
+UINT                sl;
+
+
+    /* Find the list for the block size.  */
+    _ux_utility_memory_tlsf_mapping(UX_UCHAR_POINTER_DIF(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr), block_ptr), &fl, &sl);
+
+    /* Mark the block free.  */
+    UX_MEMORY_TLSF_BLOCK_OWNER(block_ptr) = UX_BYTE_BLOCK_FREE;
+
+    /* Link the block to the head of the list.  */
+    head_ptr = pool_ptr -> ux_byte_pool_tlsf_blocks[fl][sl];
+    UX_MEMORY_TLSF_BLOCK_FREE_NEXT(block_ptr) = head_ptr;
+    UX_MEMORY_TLSF_BLOCK_FREE_PREVIOUS(block_ptr) = UX_NULL;
+    if (head_ptr != UX_NULL)
+        UX_MEMORY_TLSF_BLOCK_FREE_PREVIOUS(head_ptr) = block_ptr;
+    pool_ptr -> ux_byte_pool_tlsf_blocks[fl][sl] = block_ptr;
+
+    /* The list is not empty.  */
+    pool_ptr -> ux_byte_pool_tlsf_fl_bitmap |= (1ul << fl);
+    pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] |= (1ul << sl);
+}
+#endif
@@ -0,0 +1,104 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_block_remove                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes a free block from the TLSF free list matching */
+/*    its size. The block is still marked as free.                        */
+/*                                                                        */
+/*    Note the caller must hold the protection of the memory pool.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    block_ptr                             Pointer to block              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping       Map size to list indexes      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_block_remove(UX_MEMORY_BYTE_POOL *pool_ptr, UCHAR *block_ptr)
+{
+
+UCHAR               *next_ptr;
+UCHAR               *previous_ptr;
+UINT                fl;
+UINT                sl;
+
+
+    /* Unlink the block from its neighbors in list.  */
+    next_ptr = UX_MEMORY_TLSF_BLOCK_FREE_NEXT(block_ptr);
+    previous_ptr = UX_MEMORY_TLSF_BLOCK_FREE_PREVIOUS(block_ptr);
+    if (next_ptr != UX_NULL)
+        UX_MEMORY_TLSF_BLOCK_FREE_PREVIOUS(next_ptr) = previous_ptr;
+    if (previous_ptr != UX_NULL)
+    {
+        UX_MEMORY_TLSF_BLOCK_FREE_NEXT(previous_ptr) = next_ptr;
+        return;
+    }
+
+    /* The block is the list head, update the list.  */
+    _ux_utility_memory_tlsf_mapping(UX_UCHAR_POINTER_DIF(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr), block_ptr), &fl, &sl);
+    pool_ptr -> ux_byte_pool_tlsf_blocks[fl][sl] = next_ptr;
+
+    /* If the list is empty, update the bitmaps.  */
+    if (next_ptr == UX_NULL)
+    {
+        pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] &= ~(1ul << sl);
+        if (pool_ptr -> ux_byte_pool_tlsf_sl_bitmap[fl] == 0)
+            pool_ptr -> ux_byte_pool_tlsf_fl_bitmap &= ~(1ul << fl);
+    }
+}
+#endif
@@ -0,0 +1,109 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_create                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds the initial blocks of a TLSF byte pool. The    */
+/*    pool memory is split into one large free block and a small          */
+/*    allocated block at the end of the pool that is there just for the   */
+/*    algorithm. The free block is inserted into the TLSF free lists.     */
+/*                                                                        */
+/*    The pool start and size must be set and the pool lists must be      */
+/*    cleared before calling this function.                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_block_insert  Insert block to list          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_create   Create memory byte pool       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_create(UX_MEMORY_BYTE_POOL *pool_ptr)
+{
+
+UCHAR               *first_ptr;
+UCHAR               *last_ptr;
+ALIGN_TYPE          int_block;
+
+
+    /* The first block is placed so that its memory buffer is aligned.  */
+    int_block = (ALIGN_TYPE)UX_UCHAR_POINTER_ADD(pool_ptr -> ux_byte_pool_start, UX_MEMORY_BLOCK_HEADER_SIZE);
+    int_block = (int_block + UX_ALIGN_MIN) & ~((ALIGN_TYPE)UX_ALIGN_MIN);
+    first_ptr = UX_UCHAR_POINTER_SUB((UCHAR *)int_block, UX_MEMORY_BLOCK_HEADER_SIZE);
+
+    /* The last block is placed at end of pool, keeping the alignment of blocks.  */
+    last_ptr = UX_UCHAR_POINTER_ADD(first_ptr,
+                    (pool_ptr -> ux_byte_pool_size - UX_UCHAR_POINTER_DIF(first_ptr, pool_ptr -> ux_byte_pool_start) - UX_MEMORY_BLOCK_HEADER_SIZE) &
+                    ~((ULONG)UX_ALIGN_MIN));
+
+    /* Build the last block, allocated and linked to the first block.  */
+    UX_MEMORY_TLSF_BLOCK_NEXT(last_ptr) = first_ptr;
+    UX_MEMORY_TLSF_BLOCK_OWNER(last_ptr) = (ALIGN_TYPE)pool_ptr;
+    UX_MEMORY_TLSF_BLOCK_PREVIOUS(last_ptr) = first_ptr;
+
+    /* Build the first block, there is no block before it.  */
+    UX_MEMORY_TLSF_BLOCK_NEXT(first_ptr) = last_ptr;
+    UX_MEMORY_TLSF_BLOCK_PREVIOUS(first_ptr) = UX_NULL;
+
+    /* Be sure to count the free block's header in the available bytes count.  */
+    pool_ptr -> ux_byte_pool_available = UX_UCHAR_POINTER_DIF(last_ptr, first_ptr);
+    pool_ptr -> ux_byte_pool_fragments = ((UINT) 2);
+    pool_ptr -> ux_byte_pool_search = first_ptr;
+
+    /* Make the first block available.  */
+    _ux_utility_memory_tlsf_block_insert(pool_ptr, first_ptr);
+}
+#endif
@@ -0,0 +1,113 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_fls                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the index of the most significant bit set in  */
+/*    a value, in a fixed number of steps. It is used by the TLSF byte    */
+/*    pool to find size classes and non-empty free lists.                 */
+/*                                                                        */
+/*    The port may define UX_MEMORY_TLSF_FLS to use a count leading zeros */
+/*    instruction instead.                                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    value                                 Value to scan (not zero)      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Index of most significant bit set (0 based)                         */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_utility_memory_tlsf_fls(ULONG value)
+{
+
+#ifdef UX_MEMORY_TLSF_FLS
+
+    /* Use the port implementation.  */
+    return(UX_MEMORY_TLSF_FLS(value));
+#else
+UINT                bit;
+
+
+    /* Binary search of the most significant bit in 32-bit value.  */
+    bit = 0;
+    if (value & 0xFFFF0000u)
+    {
+        value >>= 16;
+        bit += 16;
+    }
+    if (value & 0xFF00u)
+    {
+        value >>= 8;
+        bit += 8;
+    }
+    if (value & 0xF0u)
+    {
+        value >>= 4;
+        bit += 4;
+    }
+    if (value & 0xCu)
+    {
+        value >>= 2;
+        bit += 2;
+    }
+    if (value & 0x2u)
+        bit += 1;
+
+    /* Return the bit index.  */
+    return(bit);
+#endif
+}
+#endif
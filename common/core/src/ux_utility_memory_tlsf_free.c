@@ -0,0 +1,115 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_free                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns a block carved by                             */
+/*    _ux_utility_memory_tlsf_allocate to its TLSF byte pool, in bounded  */
+/*    time. The block is merged with the adjacent free blocks before it   */
+/*    is inserted into the free lists, so no two free blocks are          */
+/*    adjacent.                                                           */
+/*                                                                        */
+/*    No check is done on the block and no statistics are updated. Note   */
+/*    the caller must hold the protection of the memory pool.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pointer to pool control block */
+/*    memory                                Pointer to memory block       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_block_remove  Remove block from list        */
+/*    _ux_utility_memory_tlsf_block_insert  Insert block to list          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_utility_memory_byte_pool_free     Free block to pool            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_free(UX_MEMORY_BYTE_POOL *pool_ptr, VOID *memory)
+{
+
+UCHAR               *block_ptr;
+UCHAR               *next_ptr;
+UCHAR               *previous_ptr;
+
+
+    /* Back off the memory pointer to pickup its header.  */
+    block_ptr = UX_UCHAR_POINTER_SUB(UX_VOID_TO_UCHAR_POINTER_CONVERT(memory), UX_MEMORY_BLOCK_HEADER_SIZE);
+
+    /* Update the number of available bytes in the pool.  */
+    pool_ptr -> ux_byte_pool_available += UX_UCHAR_POINTER_DIF(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr), block_ptr);
+
+    /* Merge with the next block if it's free.  */
+    next_ptr = UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr);
+    if (UX_MEMORY_TLSF_BLOCK_OWNER(next_ptr) == UX_BYTE_BLOCK_FREE)
+    {
+        _ux_utility_memory_tlsf_block_remove(pool_ptr, next_ptr);
+        UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr) = UX_MEMORY_TLSF_BLOCK_NEXT(next_ptr);
+        UX_MEMORY_TLSF_BLOCK_PREVIOUS(UX_MEMORY_TLSF_BLOCK_NEXT(next_ptr)) = block_ptr;
+        pool_ptr -> ux_byte_pool_fragments--;
+    }
+
+    /* Merge with the previous block if it's free.  */
+    previous_ptr = UX_MEMORY_TLSF_BLOCK_PREVIOUS(block_ptr);
+    if ((previous_ptr != UX_NULL) && (UX_MEMORY_TLSF_BLOCK_OWNER(previous_ptr) == UX_BYTE_BLOCK_FREE))
+    {
+        _ux_utility_memory_tlsf_block_remove(pool_ptr, previous_ptr);
+        UX_MEMORY_TLSF_BLOCK_NEXT(previous_ptr) = UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr);
+        UX_MEMORY_TLSF_BLOCK_PREVIOUS(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr)) = previous_ptr;
+        pool_ptr -> ux_byte_pool_fragments--;
+        block_ptr = previous_ptr;
+    }
+
+    /* Insert the free block to the list of its size.  */
+    _ux_utility_memory_tlsf_block_insert(pool_ptr, block_ptr);
+}
+#endif
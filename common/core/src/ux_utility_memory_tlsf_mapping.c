@@ -0,0 +1,109 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_mapping                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function maps a block size to the first level and second level */
+/*    indexes of the TLSF free list that keeps blocks of that size.       */
+/*                                                                        */
+/*    Small blocks (less than UX_MEMORY_TLSF_SMALL_BLOCK_SIZE) are mapped */
+/*    linearly in the first list. Blocks larger than the last size class  */
+/*    are mapped to the last list.                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    block_size                            Size of block (with header)   */
+/*    fl_index                              Pointer to first level index  */
+/*    sl_index                              Pointer to second level index */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_tlsf_fls           Find most significant bit     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_memory_tlsf_mapping(ULONG block_size, UINT *fl_index, UINT *sl_index)
+{
+
+UINT                fl;
+UINT                sl;
+
+
+    if (block_size < UX_MEMORY_TLSF_SMALL_BLOCK_SIZE)
+    {
+
+        /* Small blocks, linear mapping in first list.  */
+        fl = 0;
+        sl = (UINT)(block_size / (UX_MEMORY_TLSF_SMALL_BLOCK_SIZE / UX_MEMORY_TLSF_SL_INDEX_COUNT));
+    }
+    else
+    {
+
+        /* Power of 2 range for first level, sub range for second level.  */
+        fl = _ux_utility_memory_tlsf_fls(block_size);
+        sl = (UINT)(block_size >> (fl - UX_MEMORY_TLSF_SL_INDEX_COUNT_LOG2)) ^ UX_MEMORY_TLSF_SL_INDEX_COUNT;
+        fl = fl - (UX_MEMORY_TLSF_FL_INDEX_SHIFT - 1);
+
+        /* Huge blocks are all kept in the last list.  */
+        if (fl >= UX_MEMORY_TLSF_FL_INDEX_COUNT)
+        {
+            fl = UX_MEMORY_TLSF_FL_INDEX_COUNT - 1;
+            sl = UX_MEMORY_TLSF_SL_INDEX_COUNT - 1;
+        }
+    }
+
+    /* Return indexes.  */
+    *fl_index = fl;
+    *sl_index = sl;
+}
+#endif
@@ -0,0 +1,104 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Utility                                                             */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#if !defined(UX_STANDALONE)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_utility_mutex_on_count                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function gets a protection mutex and counts contention on it.  */
+/*    The mutex is first tried without waiting. If it is not available    */
+/*    the get is a contention, the counter is incremented with interrupts */
+/*    locked and the mutex is then waited for.                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    mutex                                 Pointer to mutex              */
+/*    contention_count                      Pointer to contention counter */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          ThreadX mutex get             */
+/*    _ux_system_error_handler              Log system error              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_utility_mutex_on_count(UX_MUTEX *mutex, ULONG *contention_count)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UINT    status;
+
+
+    /* Try to get the mutex without waiting.  */
+    status =  tx_mutex_get(mutex, TX_NO_WAIT);
+
+    /* The mutex is owned by another thread, count the contention and wait for it.  */
+    if (status == TX_NOT_AVAILABLE)
+    {
+        UX_DISABLE
+        (*contention_count) ++;
+        UX_RESTORE
+        status =  tx_mutex_get(mutex, TX_WAIT_FOREVER);
+    }
+
+    /* Check for status.  */
+    if (status != UX_SUCCESS)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_UTILITY, status);
+    }
+
+    /* Return to caller.  */
+    return;
+}
+#endif
@@ -23,7 +23,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_device_class_cdc_ecm.h                           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,10 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added packet to collect     */
+/*                                            chained data,               */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -366,6 +370,9 @@ typedef struct UX_SLAVE_CLASS_CDC_ECM_STRUCT
     NX_PACKET                               *ux_slave_class_cdc_ecm_xmit_queue_tail;
     NX_PACKET                               *ux_slave_class_cdc_ecm_receive_queue;
     NX_PACKET_POOL                          *ux_slave_class_cdc_ecm_packet_pool;
+#if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_CDC_ECM_ZERO_COPY) && !defined(NX_DISABLE_PACKET_CHAIN)
+    NX_PACKET                               *ux_slave_class_cdc_ecm_xmit_chain_packet;
+#endif
 #endif
 
 #if !defined(UX_DEVICE_STANDALONE)
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_cdc_ecm_bulkin_thread              PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -90,6 +90,10 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            reused packet to collect    */
+/*                                            chained data,               */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_cdc_ecm_bulkin_thread(ULONG cdc_ecm_class)
@@ -175,12 +179,22 @@ NX_PACKET                       *packet;
                             else
                             {
 
-                                /* Allocate a new packet for chain data collection.  */
-                                status = nx_packet_allocate(cdc_ecm -> ux_slave_class_cdc_ecm_packet_pool, &packet, 
-                                            NX_RECEIVE_PACKET, UX_MS_TO_TICK(UX_DEVICE_CLASS_CDC_ECM_PACKET_POOL_WAIT));
+                                /* Get the packet for chain data collection, it's allocated
+                                   once and kept until the link is down.  */
+                                packet = cdc_ecm -> ux_slave_class_cdc_ecm_xmit_chain_packet;
+                                if (packet == UX_NULL)
+                                {
+                                    status = nx_packet_allocate(cdc_ecm -> ux_slave_class_cdc_ecm_packet_pool, &packet, 
+                                                NX_RECEIVE_PACKET, UX_MS_TO_TICK(UX_DEVICE_CLASS_CDC_ECM_PACKET_POOL_WAIT));
+                                    if (status == UX_SUCCESS)
+                                        cdc_ecm -> ux_slave_class_cdc_ecm_xmit_chain_packet = packet;
+                                }
                                 if (status == UX_SUCCESS)
                                 {
 
+                                    /* Data starts from the beginning of the packet buffer.  */
+                                    packet -> nx_packet_prepend_ptr = packet -> nx_packet_data_start;
+
                                     /* Copy the packet to the buffer.  */
                                     status = nx_packet_data_extract_offset(current_packet, 0,
                                             packet -> nx_packet_prepend_ptr,
@@ -280,6 +294,13 @@ NX_PACKET                       *packet;
 #endif
                     }
 
+#if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_CDC_ECM_ZERO_COPY) && !defined(NX_DISABLE_PACKET_CHAIN)
+
+                    /* The chain data collection packet is kept for next use.  */
+                    if (current_packet == cdc_ecm -> ux_slave_class_cdc_ecm_xmit_chain_packet)
+                        continue;
+#endif
+
                     /* Free the packet that was just sent.  First do some housekeeping.  */
                     current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_DEVICE_CLASS_CDC_ECM_ETHERNET_SIZE; 
                     current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_DEVICE_CLASS_CDC_ECM_ETHERNET_SIZE;
@@ -317,6 +338,16 @@ NX_PACKET                       *packet;
                     nx_packet_transmit_release(current_packet); 
                 }
 
+#if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_CDC_ECM_ZERO_COPY) && !defined(NX_DISABLE_PACKET_CHAIN)
+
+                /* Free the chain data collection packet.  */
+                if (cdc_ecm -> ux_slave_class_cdc_ecm_xmit_chain_packet != UX_NULL)
+                {
+                    nx_packet_release(cdc_ecm -> ux_slave_class_cdc_ecm_xmit_chain_packet);
+                    cdc_ecm -> ux_slave_class_cdc_ecm_xmit_chain_packet = UX_NULL;
+                }
+#endif
+
                 /* Was the change in the device state caused by a disconnection?  */
                 if (device -> ux_slave_device_state != UX_DEVICE_CONFIGURED)
                 {
@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_asix.h                                PORTABLE C      */ 
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,10 @@
 /*                                            added some new definitions, */
 /*                                            refined reception handling, */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -139,6 +143,15 @@ extern   "C" {
 #define UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT
 #endif
 
+/* With host scatter-gather transfers, a chained packet is sent without copy when its
+   packets fit in the transmit segments.  */
+#if defined(UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT) && defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+#define UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT
+#ifndef UX_HOST_CLASS_ASIX_XMIT_SEGMENTS
+#define UX_HOST_CLASS_ASIX_XMIT_SEGMENTS                    4
+#endif
+#endif
+
 #define UX_HOST_CLASS_ASIX_NX_PACKET_SIZE                   sizeof(NX_PACKET)
 
 #define UX_HOST_CLASS_ASIX_NX_PAYLOAD_SIZE_ASSERT                           \
@@ -426,6 +439,10 @@ typedef struct UX_HOST_CLASS_ASIX_STRUCT
     NX_PACKET       *ux_host_class_asix_xmit_queue;
 #ifdef UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT
     UCHAR           *ux_host_class_asix_xmit_buffer;
+#endif
+#ifdef UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT
+    UX_TRANSFER_SEGMENT
+                    ux_host_class_asix_xmit_segments[UX_HOST_CLASS_ASIX_XMIT_SEGMENTS];
 #endif
     NX_PACKET       *ux_host_class_asix_receive_queue;
     UCHAR           *ux_host_class_asix_receive_buffer;
@@ -473,6 +490,9 @@ VOID  _ux_host_class_asix_reception_callback (UX_TRANSFER *transfer_request);
 VOID  _ux_host_class_asix_thread(ULONG parameter);
 VOID  _ux_host_class_asix_transmission_callback (UX_TRANSFER *transfer_request);
 UINT  _ux_host_class_asix_setup(UX_HOST_CLASS_ASIX *asix);
+#ifdef UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT
+UINT  _ux_host_class_asix_xmit_segments_set(UX_HOST_CLASS_ASIX *asix, NX_PACKET *packet, UX_TRANSFER *transfer_request);
+#endif
                                     
 /* Define Asix Class API prototypes.  */
 
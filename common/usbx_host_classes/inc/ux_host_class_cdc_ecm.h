@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_cdc_ecm.h                             PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -62,6 +62,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -155,6 +159,15 @@ extern   "C" {
 #define UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 #endif
 
+/* With host scatter-gather transfers, a chained packet is sent without copy when its
+   packets fit in the transmit segments.  */
+#if defined(UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT) && defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+#define UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS_SUPPORT
+#ifndef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS
+#define UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS                    4
+#endif
+#endif
+
 #define UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE                    14
                                                                 
 #define UX_HOST_CLASS_CDC_ECM_DEVICE_INIT_DELAY                (1 * UX_PERIODIC_RATE)
@@ -297,6 +310,10 @@ typedef struct UX_HOST_CLASS_CDC_ECM_STRUCT
     UCHAR           *ux_host_class_cdc_ecm_xmit_buffer;
     UCHAR           *ux_host_class_cdc_ecm_receive_buffer;
 #endif
+#ifdef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS_SUPPORT
+    UX_TRANSFER_SEGMENT
+                    ux_host_class_cdc_ecm_xmit_segments[UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS];
+#endif
 
     UCHAR           ux_host_class_cdc_ecm_node_id[UX_HOST_CLASS_CDC_ECM_NODE_ID_LENGTH];
     VOID            (*ux_host_class_cdc_ecm_device_status_change_callback)(struct UX_HOST_CLASS_CDC_ECM_STRUCT *cdc_ecm, 
@@ -336,6 +353,9 @@ VOID  _ux_host_class_cdc_ecm_thread(ULONG parameter);
 VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request);
 VOID  _ux_host_class_cdc_ecm_transmit_queue_clean(UX_HOST_CLASS_CDC_ECM *cdc_ecm_control);
 UINT  _ux_host_class_cdc_ecm_mac_address_get(UX_HOST_CLASS_CDC_ECM *cdc_ecm);
+#ifdef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS_SUPPORT
+UINT  _ux_host_class_cdc_ecm_xmit_segments_set(UX_HOST_CLASS_CDC_ECM *cdc_ecm, NX_PACKET *packet, UX_TRANSFER *transfer_request);
+#endif
                                     
 /* Define CDC ECM Class API prototypes.  */
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_asix_transmission_callback           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -84,6 +84,10 @@
 /*                                            fixed compile warnings,     */
 /*                                            improved 64-bit support,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_asix_transmission_callback (UX_TRANSFER *transfer_request)
@@ -128,6 +132,7 @@ ULONG                           copied;
         ((transfer_request -> ux_transfer_request_actual_length %
           transfer_request -> ux_transfer_request_packet_length) == 0))
     {
+        UX_TRANSFER_SEGMENTS_RESET(transfer_request);
         transfer_request -> ux_transfer_request_requested_length = 0;
         _ux_host_stack_transfer_request(transfer_request);
         return;
@@ -155,23 +160,42 @@ ULONG                           copied;
         /* Store the negative length of the payload in the first USHORT.  */
         _ux_utility_short_put(packet_header+ sizeof(USHORT), (USHORT)(~next_packet -> nx_packet_length));
 
+        /* Send a contiguous buffer unless the packet segments are set.  */
+        UX_TRANSFER_SEGMENTS_RESET(transfer_request);
+
 #ifdef UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT
 
         /* Check if the packets are chained.  */
         if (next_packet -> nx_packet_next)
         {
 
-            next_packet -> nx_packet_length += (ULONG)sizeof(USHORT) * 2;
-            next_packet -> nx_packet_prepend_ptr -= sizeof(USHORT) * 2;
-            nx_packet_data_extract_offset(next_packet, 0, asix -> ux_host_class_asix_xmit_buffer, next_packet -> nx_packet_length, &copied);
+#ifdef UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT
+
+            /* Send the packets of the chain as they are if possible.  */
+            if (_ux_host_class_asix_xmit_segments_set(asix, next_packet, transfer_request) == UX_SUCCESS)
+            {
+
+                /* Setup the transaction parameters.  */
+                transfer_request -> ux_transfer_request_data_pointer     =  packet_header;
+                transfer_request -> ux_transfer_request_requested_length =  next_packet -> nx_packet_length + (ULONG)sizeof(USHORT) * 2;
+            }
+            else
+#endif
+            {
+
+                /* Put packet to continuous buffer to transfer.  */
+                next_packet -> nx_packet_length += (ULONG)sizeof(USHORT) * 2;
+                next_packet -> nx_packet_prepend_ptr -= sizeof(USHORT) * 2;
+                nx_packet_data_extract_offset(next_packet, 0, asix -> ux_host_class_asix_xmit_buffer, next_packet -> nx_packet_length, &copied);
 
-            /* Setup the transaction parameters.  */
-            transfer_request -> ux_transfer_request_requested_length =  next_packet -> nx_packet_length;
-            transfer_request -> ux_transfer_request_data_pointer = asix -> ux_host_class_asix_xmit_buffer;
+                /* Setup the transaction parameters.  */
+                transfer_request -> ux_transfer_request_requested_length =  next_packet -> nx_packet_length;
+                transfer_request -> ux_transfer_request_data_pointer = asix -> ux_host_class_asix_xmit_buffer;
 
-            /* Restore packet status.  */
-            next_packet -> nx_packet_length -= (ULONG)sizeof(USHORT) * 2;
-            next_packet -> nx_packet_prepend_ptr += sizeof(USHORT) * 2;
+                /* Restore packet status.  */
+                next_packet -> nx_packet_length -= (ULONG)sizeof(USHORT) * 2;
+                next_packet -> nx_packet_prepend_ptr += sizeof(USHORT) * 2;
+            }
         }
         else
 #endif
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_asix_write                           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -85,6 +85,10 @@
 /*                                            fixed compile warnings,     */
 /*                                            improved 64-bit support,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_asix_write(VOID *asix_class, NX_PACKET *packet)
@@ -209,6 +213,9 @@ ULONG               copied;
         /* Get the pointer to the bulk out endpoint transfer request.  */
         transfer_request =  &asix -> ux_host_class_asix_bulk_out_endpoint -> ux_endpoint_transfer_request;
 
+        /* Send a contiguous buffer unless the packet segments are set.  */
+        UX_TRANSFER_SEGMENTS_RESET(transfer_request);
+
 #ifdef UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT
 
         /* Check if the packets are chained.  */
@@ -227,17 +234,33 @@ ULONG               copied;
                 }
             }
 
-            packet -> nx_packet_length = adjusted_length;
-            packet -> nx_packet_prepend_ptr -= sizeof(USHORT) * 2;
-            nx_packet_data_extract_offset(packet, 0, asix -> ux_host_class_asix_xmit_buffer, packet -> nx_packet_length, &copied);
+#ifdef UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT
 
-            /* Setup the transaction parameters.  */
-            transfer_request -> ux_transfer_request_requested_length =  packet -> nx_packet_length;
-            transfer_request -> ux_transfer_request_data_pointer = asix -> ux_host_class_asix_xmit_buffer;
+            /* Send the packets of the chain as they are if possible.  */
+            if (_ux_host_class_asix_xmit_segments_set(asix, packet, transfer_request) == UX_SUCCESS)
+            {
+
+                /* Setup the transaction parameters.  */
+                transfer_request -> ux_transfer_request_data_pointer     =  packet_header;
+                transfer_request -> ux_transfer_request_requested_length =  adjusted_length;
+            }
+            else
+#endif
+            {
+
+                /* Put packet to continuous buffer to transfer.  */
+                packet -> nx_packet_length = adjusted_length;
+                packet -> nx_packet_prepend_ptr -= sizeof(USHORT) * 2;
+                nx_packet_data_extract_offset(packet, 0, asix -> ux_host_class_asix_xmit_buffer, packet -> nx_packet_length, &copied);
 
-            /* Restore packet status.  */
-            packet -> nx_packet_length -= (ULONG)sizeof(USHORT) * 2;
-            packet -> nx_packet_prepend_ptr += sizeof(USHORT) * 2;
+                /* Setup the transaction parameters.  */
+                transfer_request -> ux_transfer_request_requested_length =  packet -> nx_packet_length;
+                transfer_request -> ux_transfer_request_data_pointer = asix -> ux_host_class_asix_xmit_buffer;
+
+                /* Restore packet status.  */
+                packet -> nx_packet_length -= (ULONG)sizeof(USHORT) * 2;
+                packet -> nx_packet_prepend_ptr += sizeof(USHORT) * 2;
+            }
         }
         else
 #endif
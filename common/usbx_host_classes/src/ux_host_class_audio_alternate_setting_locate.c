@@ -42,7 +42,7 @@ static inline UINT _ux_host_class_audio_alternate_setting_locate_2(
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_audio_alternate_setting_locate       PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -66,6 +66,8 @@ static inline UINT _ux_host_class_audio_alternate_setting_locate_2(
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -80,6 +82,10 @@ static inline UINT _ux_host_class_audio_alternate_setting_locate_2(
 /*                                            resulting in version 6.1    */
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added audio 2.0 support,    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                            resulting in version 6.1.12 */
 /**************************************************************************/
 UINT  _ux_host_class_audio_alternate_setting_locate(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_SAMPLING *audio_sampling,
@@ -139,8 +145,7 @@ UINT                                     specific_frequency_count;
         case UX_INTERFACE_DESCRIPTOR_ITEM:
 
             /* Parse the interface descriptor and make it machine independent.  */
-            _ux_utility_descriptor_parse(descriptor, _ux_system_interface_descriptor_structure,
-                                            UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *) &interface_descriptor);
+            _ux_utility_descriptor_unpack_interface(descriptor, &interface_descriptor);
 
             /* Ensure we have the correct interface for Audio streaming.  */
             if ((interface_descriptor.bInterfaceClass == UX_HOST_CLASS_AUDIO_CLASS) &&
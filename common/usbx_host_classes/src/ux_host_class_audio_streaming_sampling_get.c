@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_audio_streaming_sampling_get         PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,8 @@
 /*                                                                        */ 
 /*    _ux_host_stack_class_instance_verify  Verify instance is valid      */ 
 /*    _ux_utility_descriptor_parse          Parse the descriptor          */ 
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*    _ux_host_mutex_on                     Get mutex                     */
 /*    _ux_host_mutex_off                    Put mutex                     */
 /*                                                                        */ 
@@ -84,6 +86,10 @@
 /*                                            protect reentry with mutex, */
 /*                                            fixed error return code,    */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_audio_streaming_sampling_get(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_SAMPLING_CHARACTERISTICS *audio_sampling)
@@ -164,8 +170,7 @@ UINT                                     previous_match_found;
         case UX_INTERFACE_DESCRIPTOR_ITEM:
 
             /* Parse the interface descriptor and make it machine independent */
-            _ux_utility_descriptor_parse(descriptor, _ux_system_interface_descriptor_structure,
-                                            UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *) &interface_descriptor);
+            _ux_utility_descriptor_unpack_interface(descriptor, &interface_descriptor);
 
             /* Ensure we have the correct interface for Audio streaming.  */
             if ((interface_descriptor.bInterfaceClass == UX_HOST_CLASS_AUDIO_CLASS) &&
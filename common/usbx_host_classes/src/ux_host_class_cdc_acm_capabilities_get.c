@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_cdc_acm_capabilities_get             PORTABLE C      */
-/*                                                           6.2.1        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,7 +56,10 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_host_stack_transfer_request       Process transfer request      */
-/*    _ux_utility_descriptor_parse          Parse descriptor              */
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate memory block         */
 /*    _ux_utility_memory_free               Release memory block          */
 /*                                                                        */
@@ -75,6 +78,10 @@
 /*                                            fixed capabilities get from */
 /*                                            multiple CDC-ACM functions, */
 /*                                            resulting in version 6.2.1  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_acm_capabilities_get(UX_HOST_CLASS_CDC_ACM *cdc_acm)
@@ -121,8 +128,7 @@ ULONG                       interface_found;
     {
 
         /* The descriptor is in a packed format, parse it locally.  */
-        _ux_utility_descriptor_parse(descriptor, _ux_system_configuration_descriptor_structure,
-                                    UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *) &configuration.ux_configuration_descriptor);
+        _ux_utility_descriptor_unpack_configuration(descriptor, &configuration.ux_configuration_descriptor);
 
         /* Now we have the configuration descriptor which will tell us how many
            bytes there are in the entire descriptor.  */
@@ -190,8 +196,7 @@ ULONG                       interface_found;
                 case UX_INTERFACE_DESCRIPTOR_ITEM:
 
                     /* Parse the interface descriptor and make it machine independent.  */
-                    _ux_utility_descriptor_parse(descriptor, _ux_system_interface_descriptor_structure,
-                                                    UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *) &interface_descriptor);
+                    _ux_utility_descriptor_unpack_interface(descriptor, &interface_descriptor);
 
                     /* Ensure we have the correct interface for CDC control (current interface).  */
                     if (interface_descriptor.bInterfaceNumber ==
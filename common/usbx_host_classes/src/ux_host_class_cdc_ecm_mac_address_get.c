@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_ecm_mac_address_get              PORTABLE C      */ 
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,6 +58,8 @@
 /*    _ux_utility_memory_allocate            Allocate memory              */
 /*    _ux_utility_memory_free                Free memory                  */
 /*    _ux_utility_descriptor_parse           Parse descriptors            */
+/*    _ux_utility_descriptor_unpack_configuration                         */
+/*                                          Unpack descriptor             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -76,6 +78,10 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            checked descriptor length,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_ecm_mac_address_get(UX_HOST_CLASS_CDC_ECM *cdc_ecm)
@@ -133,8 +139,7 @@ UCHAR                                       element_hexa_lower;
     {
     
         /* Parse the descriptor so that we can read the total length.  */
-        _ux_utility_descriptor_parse(descriptor, _ux_system_configuration_descriptor_structure,
-                                                                UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *) &configuration_descriptor);
+        _ux_utility_descriptor_unpack_configuration(descriptor, &configuration_descriptor);
     
         /* We don't need this descriptor now.  */
         _ux_utility_memory_free(descriptor);
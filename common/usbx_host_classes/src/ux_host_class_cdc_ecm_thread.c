@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_ecm_thread                       PORTABLE C      */ 
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,10 @@
 /*    _ux_network_driver_packet_received    Process received packet       */
 /*    nx_packet_allocate                    Allocate NetX packet          */
 /*    nx_packet_release                     Free NetX packet              */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_steady_state_hold  Hold memory steady state off  */
+/*    _ux_utility_memory_steady_state_release                             */
+/*                                          Release steady state hold     */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -98,6 +102,10 @@
 /*                                            deprecated ECM pool option, */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            held memory steady state    */
+/*                                            off for receive buffer,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_thread(ULONG parameter)
@@ -180,9 +188,13 @@ ULONG                       packet_buffer_size;
                     {
                         if (cdc_ecm -> ux_host_class_cdc_ecm_receive_buffer == UX_NULL)
                         {
+
+                            /* The buffer is allocated once after activation, hold steady state off.  */
+                            UX_MEMORY_STEADY_STATE_HOLD();
                             cdc_ecm -> ux_host_class_cdc_ecm_receive_buffer =
                                     _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY,
                                                             UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE);
+                            UX_MEMORY_STEADY_STATE_RELEASE();
                             if (cdc_ecm -> ux_host_class_cdc_ecm_receive_buffer == UX_NULL)
                             {
 
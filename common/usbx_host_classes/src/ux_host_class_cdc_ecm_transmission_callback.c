@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_ecm_transmission_callback        PORTABLE C      */ 
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -82,6 +82,10 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request)
@@ -136,6 +140,7 @@ ULONG                           copied;
         {
 
             /* Set transfer request length to zero.  */
+            UX_TRANSFER_SEGMENTS_RESET(transfer_request);
             transfer_request -> ux_transfer_request_requested_length =  0;
 
             /* Send the transfer.  */
@@ -155,14 +160,27 @@ ULONG                           copied;
         if (next_packet != UX_NULL)
         {
 
+            /* Send a contiguous buffer unless the packet segments are set.  */
+            UX_TRANSFER_SEGMENTS_RESET(transfer_request);
+
 #ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 
             if (next_packet -> nx_packet_next != UX_NULL)
             {
 
-                /* Put packet to continuous buffer to transfer.  */
-                packet_header = cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer;
-                nx_packet_data_extract_offset(next_packet, 0, packet_header, next_packet -> nx_packet_length, &copied);
+#ifdef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS_SUPPORT
+
+                /* Send the packets of the chain as they are if possible.  */
+                if (_ux_host_class_cdc_ecm_xmit_segments_set(cdc_ecm, next_packet, transfer_request) == UX_SUCCESS)
+                    packet_header =  next_packet -> nx_packet_prepend_ptr;
+                else
+#endif
+                {
+
+                    /* Put packet to continuous buffer to transfer.  */
+                    packet_header = cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer;
+                    nx_packet_data_extract_offset(next_packet, 0, packet_header, next_packet -> nx_packet_length, &copied);
+                }
             }
             else
 #endif
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_ecm_write                        PORTABLE C      */ 
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,10 @@
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_host_semaphore_put                Release protection semaphore  */ 
 /*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_steady_state_hold  Hold memory steady state off  */
+/*    _ux_utility_memory_steady_state_release                             */
+/*                                          Release steady state hold     */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -83,6 +87,12 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather, held memory */
+/*                                            steady state off for xmit   */
+/*                                            buffer,                     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_ecm_write(VOID *cdc_ecm_class, NX_PACKET *packet)
@@ -168,6 +178,9 @@ ULONG                   copied;
             /* Get the pointer to the bulk out endpoint transfer request.  */
             transfer_request =  &cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_endpoint -> ux_endpoint_transfer_request;
 
+            /* Send a contiguous buffer unless the packet segments are set.  */
+            UX_TRANSFER_SEGMENTS_RESET(transfer_request);
+
 #ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 
             if (packet -> nx_packet_next != UX_NULL)
@@ -176,8 +189,12 @@ ULONG                   copied;
                 /* Create buffer.  */
                 if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer == UX_NULL)
                 {
+
+                    /* The buffer is allocated once after activation, hold steady state off.  */
+                    UX_MEMORY_STEADY_STATE_HOLD();
                     cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN,
                                         UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE);
+                    UX_MEMORY_STEADY_STATE_RELEASE();
                     if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer == UX_NULL)
                     {
                         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
@@ -185,9 +202,19 @@ ULONG                   copied;
                     }
                 }
 
-                /* Put packet to continuous buffer to transfer.  */
-                packet_header = cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer;
-                nx_packet_data_extract_offset(packet, 0, packet_header, packet -> nx_packet_length, &copied);
+#ifdef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS_SUPPORT
+
+                /* Send the packets of the chain as they are if possible.  */
+                if (_ux_host_class_cdc_ecm_xmit_segments_set(cdc_ecm, packet, transfer_request) == UX_SUCCESS)
+                    packet_header =  packet -> nx_packet_prepend_ptr;
+                else
+#endif
+                {
+
+                    /* Put packet to continuous buffer to transfer.  */
+                    packet_header = cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer;
+                    nx_packet_data_extract_offset(packet, 0, packet_header, packet -> nx_packet_length, &copied);
+                }
             }
             else
 #endif
@@ -0,0 +1,123 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   CDC_ECM Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_host_stack.h"
+
+
+#ifdef UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS_SUPPORT
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_host_class_cdc_ecm_xmit_segments_set            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function describes a chained NetX packet with the transmit     */
+/*    segments of the instance, so that the bulk out transfer request     */
+/*    sends the packet without copying it. Each packet of the chain but   */
+/*    the last must hold whole USB packets and the chain must fit in the  */
+/*    segments, otherwise the packet has to be copied.                    */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    cdc_ecm                               Pointer to CDC_ECM class      */
+/*    packet                                Pointer to packet to send     */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    CDC_ECM Class                                                       */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_cdc_ecm_xmit_segments_set(UX_HOST_CLASS_CDC_ECM *cdc_ecm, NX_PACKET *packet, UX_TRANSFER *transfer_request)
+{
+
+UX_TRANSFER_SEGMENT     *segment;
+ULONG                   segment_count;
+UCHAR                   *segment_data;
+ULONG                   segment_length;
+
+
+    /* Describe each packet of the chain with a segment.  */
+    segment =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_segments;
+    segment_count =  0;
+    while (packet != UX_NULL)
+    {
+
+        /* Get the data in this packet.  */
+        segment_data =  packet -> nx_packet_prepend_ptr;
+        segment_length =  (ULONG)(packet -> nx_packet_append_ptr - packet -> nx_packet_prepend_ptr);
+
+        /* Skip empty packets.  */
+        if (segment_length != 0)
+        {
+
+            /* The chain must fit in the segments, and the segment before must end on
+               a USB packet boundary.  */
+            if ((segment_count == UX_HOST_CLASS_CDC_ECM_XMIT_SEGMENTS) ||
+                ((segment_count != 0) &&
+                 (((segment - 1) -> ux_transfer_segment_length % transfer_request -> ux_transfer_request_packet_length) != 0)))
+                return(UX_ERROR);
+
+            segment -> ux_transfer_segment_data_pointer =  segment_data;
+            segment -> ux_transfer_segment_length =  segment_length;
+            segment++;
+            segment_count++;
+        }
+
+        /* Next packet in the chain.  */
+        packet =  packet -> nx_packet_next;
+    }
+
+    /* The transfer request now sends the segments.  */
+    transfer_request -> ux_transfer_request_segments =       cdc_ecm -> ux_host_class_cdc_ecm_xmit_segments;
+    transfer_request -> ux_transfer_request_segment_count =  segment_count;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
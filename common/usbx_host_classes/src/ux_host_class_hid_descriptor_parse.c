@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_descriptor_parse                 PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,8 @@
 /*                                          Get HID report descriptor     */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*    _ux_utility_memory_free               Release memory block          */ 
 /*                                                                        */ 
@@ -75,6 +77,10 @@
 /*                                            used shared device config   */
 /*                                            descriptor for enum scan,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_descriptor_parse(UX_HOST_CLASS_HID *hid)
@@ -175,10 +181,7 @@ ULONG                           current_interface;
             {
 
                 /* Parse the interface descriptor and make it machine independent.  */
-                _ux_utility_descriptor_parse(descriptor,
-                            _ux_system_interface_descriptor_structure,
-                            UX_INTERFACE_DESCRIPTOR_ENTRIES,
-                            (UCHAR *) &interface_descriptor);
+                _ux_utility_descriptor_unpack_interface(descriptor, &interface_descriptor);
 
                 /* Memorize the interface we are scanning.  */
                 current_interface = interface_descriptor.bInterfaceNumber;
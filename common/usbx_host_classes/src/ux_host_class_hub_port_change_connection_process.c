@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hub_port_change_connection_process   PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -87,6 +87,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_hub_port_change_connection_process(UX_HOST_CLASS_HUB *hub, UINT port, UINT port_status)
@@ -137,12 +140,19 @@ USHORT      local_port_change;
            not process the same change event again.  */
         _ux_host_class_hub_feature(hub, port, UX_CLEAR_FEATURE, UX_HOST_CLASS_HUB_C_PORT_CONNECTION);
 
+        /* Start the enumeration timeline.  */
+        UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_EVENT_CONNECT);
+
         /* Some devices are known to fail on the first try.  */
         for (device_enumeration_retry = 0; device_enumeration_retry < UX_HOST_CLASS_HUB_ENUMERATION_RETRY; device_enumeration_retry++)
         {
 
+            /* Record the enumeration attempt.  */
+            UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_EVENT_ATTEMPT);
+
             /* Wait for debounce.  */
             _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENUMERATION_DEBOUNCE_DELAY);
+            UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_DEBOUNCE);
 
             /* The port must be reset.  */
             status =  _ux_host_class_hub_port_reset(hub, port);
@@ -183,6 +193,7 @@ USHORT      local_port_change;
 
             /* Wait for reset recovery.  */
             _ux_utility_delay_ms(UX_HOST_CLASS_HUB_ENUMERATION_RESET_RECOVERY_DELAY);
+            UX_ENUMERATION_TIMELINE_RECORD(&_ux_system_host -> ux_system_host_enumeration_timeline, UX_ENUMERATION_PHASE_RESET);
 
             /* Perform the device creation.  */
             status =  _ux_host_stack_new_device_create(UX_DEVICE_HCD_GET(hub -> ux_host_class_hub_device),
@@ -39,7 +39,7 @@ static inline VOID _ux_host_class_hub_inst_tasks_run(UX_HOST_CLASS_HUB *hub);
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_hub_tasks_run                        PORTABLE C      */
-/*                                                           6.2.1        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -93,6 +93,9 @@ static inline VOID _ux_host_class_hub_inst_tasks_run(UX_HOST_CLASS_HUB *hub);
 /*                                            fixed compile issue if only */
 /*                                            one device is supported,    */
 /*                                            resulting in version 6.2.1  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added enumeration timeline, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hub_tasks_run(UX_HOST_CLASS *hub_class)
@@ -356,6 +359,9 @@ UINT        status;
 
                 /* Put device in enumeration list.  */
                 device -> ux_device_flags |= UX_DEVICE_FLAG_ENUM;
+
+                /* Start the enumeration timeline of the device.  */
+                UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_EVENT_CONNECT);
             }
 
             /* Try next port.  */
@@ -432,6 +438,7 @@ UINT        status;
                     hcd -> ux_hcd_entry_function(hcd, UX_HCD_CREATE_ENDPOINT, (VOID *)dev_ep0);
 
                     /* Wait a while and set address.  */
+                    UX_ENUMERATION_TIMELINE_RECORD(&device -> ux_device_enumeration_timeline, UX_ENUMERATION_PHASE_RESET);
                     device -> ux_device_enum_next_state = UX_HOST_STACK_ENUM_DEVICE_ADDR_SET;
                     device -> ux_device_enum_state = UX_HOST_STACK_ENUM_WAIT;
                     device -> ux_device_enum_wait_start = _ux_utility_time_get();
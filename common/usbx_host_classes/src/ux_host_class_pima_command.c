@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_pima_command                         PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -80,6 +80,10 @@
 /*                                            resulting in version 6.1.10 */
 /*  10-31-2023     Yajun xia                Modified comment(s),          */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            counted timeouts in         */
+/*                                            endpoint statistics,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_pima_command(UX_HOST_CLASS_PIMA *pima, UX_HOST_CLASS_PIMA_COMMAND *command,
@@ -160,6 +164,7 @@ UINT            status;
 
             /* Set the completion code.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+            UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
             /* Error trap. */
             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
@@ -254,6 +259,7 @@ UINT            status;
 
                     /* Set the completion code.  */
                     transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+                    UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
                     /* Error trap. */
                     _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
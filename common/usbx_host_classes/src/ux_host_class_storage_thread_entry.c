@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_thread_entry                 PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -73,6 +73,9 @@
 /*    _ux_host_semaphore_get                Get a semaphore               */
 /*    _ux_host_semaphore_put                Put a semaphore               */
 /*    _ux_utility_delay_ms                  Thread sleep                  */
+/*    _ux_utility_memory_steady_state_hold  Hold memory steady state off  */
+/*    _ux_utility_memory_steady_state_release                             */
+/*                                          Release steady state hold     */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -98,6 +101,10 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            internal clean up,          */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            held memory steady state    */
+/*                                            off while polling media,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_storage_thread_entry(ULONG class_address)
@@ -142,6 +149,9 @@ UCHAR                           *memory;
                 if (status != UX_SUCCESS)
                     break;
 
+                /* Polling and mounting the media allocate, hold steady state off.  */
+                UX_MEMORY_STEADY_STATE_HOLD();
+
                 /* Each LUN must be parsed and mounted.  */
                 for (lun_index = 0; lun_index <= storage -> ux_host_class_storage_max_lun; lun_index++)
                 {
@@ -404,6 +414,9 @@ UCHAR                           *memory;
                     }
                 }
 
+                /* Done with allocations for this instance.  */
+                UX_MEMORY_STEADY_STATE_RELEASE();
+
                 /* Other threads are now allowed to access this storage instance.  */
                 _ux_host_semaphore_put(&storage -> ux_host_class_storage_semaphore);
             }
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_storage_transport_bo                 PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -81,6 +81,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            counted timeouts in         */
+/*                                            endpoint statistics,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_storage_transport_bo(UX_HOST_CLASS_STORAGE *storage, UCHAR *data_pointer)
@@ -130,6 +134,7 @@ UCHAR           *get_status_response;
 
             /* Set the completion code.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+            UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
             /* Error trap.  */
             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
@@ -215,6 +220,7 @@ UCHAR           *get_status_response;
 
             /* Set the completion code.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+            UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
             /* Error trap. */
             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
@@ -286,6 +292,7 @@ UCHAR           *get_status_response;
 
             /* Set the completion code.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+            UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
             /* Error trap. */
             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_video_input_terminal_get             PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,8 @@
 /*                                                                        */ 
 /*    _ux_system_error_handler              System error log              */
 /*    _ux_utility_descriptor_parse          Parse descriptor              */ 
+/*    _ux_utility_descriptor_unpack_interface                             */
+/*                                          Unpack descriptor             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -67,6 +69,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used specialized descriptor */
+/*                                            unpacker,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_video_input_terminal_get(UX_HOST_CLASS_VIDEO *video)
@@ -118,8 +124,7 @@ ULONG                                           interface_found;
             case UX_INTERFACE_DESCRIPTOR_ITEM:
     
                 /* Parse the interface descriptor and make it machine independent.  */
-                _ux_utility_descriptor_parse(descriptor, _ux_system_interface_descriptor_structure,
-                                             UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *) &interface_descriptor);
+                _ux_utility_descriptor_unpack_interface(descriptor, &interface_descriptor);
     
                 /* Ensure we have the correct interface for Video Control.  */
                 if ((interface_descriptor.bInterfaceClass == UX_HOST_CLASS_VIDEO_CLASS) &&
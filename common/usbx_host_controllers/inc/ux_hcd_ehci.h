@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_hcd_ehci.h                                       PORTABLE C      */ 
-/*                                                           6.1.8        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,6 +54,13 @@
 /*                                            added extern "C" keyword    */
 /*                                            for compatibility with C++, */
 /*                                            resulting in version 6.1.8  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added TD list mutex,        */
+/*                                            added setup buffer in ED,   */
+/*                                            used ED and TD free lists,  */
+/*                                            added ED pending bitmap,    */
+/*                                            added bandwidth map list,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -354,6 +361,14 @@ typedef struct UX_HCD_EHCI_STRUCT
                     *ux_hcd_ehci_fsiso_td_list;
     struct UX_EHCI_HSISO_TD_STRUCT        
                     *ux_hcd_ehci_hsiso_td_list;
+    struct UX_EHCI_ED_STRUCT
+                    *ux_hcd_ehci_ed_free_list;
+    struct UX_EHCI_TD_STRUCT
+                    *ux_hcd_ehci_td_free_list;
+    struct UX_EHCI_FSISO_TD_STRUCT
+                    *ux_hcd_ehci_fsiso_td_free_list;
+    struct UX_EHCI_HSISO_TD_STRUCT
+                    *ux_hcd_ehci_hsiso_td_free_list;
     struct UX_EHCI_ED_STRUCT              
                     *ux_hcd_ehci_asynch_head_list;
     struct UX_EHCI_ED_STRUCT              
@@ -370,7 +385,10 @@ typedef struct UX_HCD_EHCI_STRUCT
                     *ux_hcd_ehci_iso_done_transfer_tail;
     struct UX_EHCI_ED_STRUCT
                     *ux_hcd_ehci_interrupt_ed_list;
+    ULONG           *ux_hcd_ehci_ed_pending_bitmap;
     UX_MUTEX        ux_hcd_ehci_periodic_mutex;
+    UX_MUTEX        ux_hcd_ehci_td_mutex;
+    ULONG           ux_hcd_ehci_td_mutex_contentions;
     UX_SEMAPHORE    ux_hcd_ehci_protect_semaphore;
     UX_SEMAPHORE    ux_hcd_ehci_doorbell_semaphore;
     ULONG           ux_hcd_ehci_frame_list_size;
@@ -424,6 +442,13 @@ typedef struct UX_EHCI_ED_STRUCT
             struct UX_ENDPOINT_STRUCT
                         *ux_ehci_ed_endpoint;               /* + 1 Dword.  */
         } INTR;
+        struct {                                            /* As control ED.  */
+            struct UX_EHCI_ED_STRUCT
+                        *ux_ehci_ed_reserved_anchor;        /* + 1 DWord.  */
+            struct UX_ENDPOINT_STRUCT
+                        *ux_ehci_ed_endpoint;               /* + 1 DWord.  */
+            UCHAR       ux_ehci_ed_setup[UX_SETUP_SIZE];    /* + 2 DWords. */
+        } CONTROL;
         struct {                                            /* Space: 7 DWord.  */
             ULONG       ux_ehci_ed_reserved[7];
         } RESERVED;
@@ -432,6 +457,13 @@ typedef struct UX_EHCI_ED_STRUCT
 } UX_EHCI_ED;
 
 
+/* Define EHCI ED pending bitmap. An ED with TDs attached has the bit of its index in the
+   ED list set, the done queue process only scans these EDs.  */
+
+#define UX_EHCI_ED_PENDING_WORD(ed_index)                   ((ed_index) >> 5)
+#define UX_EHCI_ED_PENDING_BIT(ed_index)                    (1u << ((ed_index) & 31u))
+
+
 /* Define EHCI ED bitmap.  */
 
 #define UX_EHCI_QH_TYP_ITD                                  0u
@@ -442,6 +474,7 @@ typedef struct UX_EHCI_ED_STRUCT
 #define UX_EHCI_QH_T                                        1u
 
 #define UX_EHCI_QH_STATIC                                   0x80000000u
+#define UX_EHCI_QH_CONTROL                                  0x00000002u
 #define UX_EHCI_QH_SSPLIT_SCH_FULL_7                        0x40000000u
 #define UX_EHCI_QH_SSPLIT_SCH_FULL_6                        0x20000000u
 #define UX_EHCI_QH_SSPLIT_SCH_FULL_5                        0x10000000u
@@ -791,21 +824,27 @@ typedef struct UX_EHCI_FSISO_TD_STRUCT
 /* Define EHCI function prototypes.  */
 
 void _ux_hcd_ehci_periodic_descriptor_link(VOID* prev, VOID* prev_next, VOID* next_prev, VOID* next);
-UX_EHCI_TD          *_ux_hcd_ehci_asynch_td_process(UX_EHCI_ED *ed, UX_EHCI_TD *td);
+UX_EHCI_TD          *_ux_hcd_ehci_asynch_td_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_EHCI_TD *td);
 UX_EHCI_HSISO_TD    *_ux_hcd_ehci_hsisochronous_tds_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_HSISO_TD* itd);
 UX_EHCI_FSISO_TD    *_ux_hcd_ehci_fsisochronous_tds_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_FSISO_TD* sitd);
 UINT    _ux_hcd_ehci_asynchronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_asynchronous_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
+UX_EHCI_ED          *_ux_hcd_ehci_bandwidth_map_list_get(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint, ULONG microframe_load[8], ULONG microframe_ssplit_count[8]);
 UINT    _ux_hcd_ehci_controller_disable(UX_HCD_EHCI *hcd_ehci);
 VOID    _ux_hcd_ehci_done_queue_process(UX_HCD_EHCI *hcd_ehci);
 VOID    _ux_hcd_ehci_door_bell_wait(UX_HCD_EHCI *hcd_ehci);
-UINT    _ux_hcd_ehci_ed_clean(UX_EHCI_ED *ed);
+UINT    _ux_hcd_ehci_ed_clean(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
+VOID    _ux_hcd_ehci_ed_free(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
 UX_EHCI_ED          *_ux_hcd_ehci_ed_obtain(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_ed_pending_clear(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
+VOID    _ux_hcd_ehci_ed_pending_set(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed);
 UINT    _ux_hcd_ehci_endpoint_reset(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ehci_entry(UX_HCD *hcd, UINT function, VOID *parameter);
 UINT    _ux_hcd_ehci_frame_number_get(UX_HCD_EHCI *hcd_ehci, ULONG *frame_number);
 VOID    _ux_hcd_ehci_frame_number_set(UX_HCD_EHCI *hcd_ehci, ULONG frame_number);
+VOID    _ux_hcd_ehci_fsisochronous_td_free(UX_HCD_EHCI *hcd_ehci, UX_EHCI_FSISO_TD *td);
 UX_EHCI_FSISO_TD    *_ux_hcd_ehci_fsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci);
+VOID    _ux_hcd_ehci_hsisochronous_td_free(UX_HCD_EHCI *hcd_ehci, UX_EHCI_HSISO_TD *td);
 UX_EHCI_HSISO_TD    *_ux_hcd_ehci_hsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci);
 UINT    _ux_hcd_ehci_initialize(UX_HCD *hcd);
 UINT    _ux_hcd_ehci_interrupt_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint);
@@ -827,6 +866,7 @@ UINT    _ux_hcd_ehci_power_on_port(UX_HCD_EHCI *hcd_ehci, ULONG port_index);
 VOID    _ux_hcd_ehci_power_root_hubs(UX_HCD_EHCI *hcd_ehci);
 ULONG   _ux_hcd_ehci_register_read(UX_HCD_EHCI *hcd_ehci, ULONG ehci_register);
 VOID    _ux_hcd_ehci_register_write(UX_HCD_EHCI *hcd_ehci, ULONG ehci_register, ULONG value);
+VOID    _ux_hcd_ehci_regular_td_free(UX_HCD_EHCI *hcd_ehci, UX_EHCI_TD *td);
 UX_EHCI_TD          *_ux_hcd_ehci_regular_td_obtain(UX_HCD_EHCI *hcd_ehci);
 UINT    _ux_hcd_ehci_request_bulk_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ehci_request_control_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request);
@@ -0,0 +1,172 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  COMPONENT DEFINITION                                   RELEASE        */
+/*                                                                        */
+/*    ux_hcd_ehci_model.h                                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This file contains all the header and extern functions used by the  */
+/*    software EHCI controller model. The model holds the EHCI registers  */
+/*    in memory, walks the periodic frame list and the asynchronous QH    */
+/*    ring built by the EHCI driver and executes the qTDs with the device */
+/*    simulator, so the EHCI driver runs without EHCI hardware.           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+
+#ifndef UX_HCD_EHCI_MODEL_H
+#define UX_HCD_EHCI_MODEL_H
+
+/* Determine if a C++ compiler is being used.  If so, ensure that standard
+   C is used to process the API information.  */
+
+#ifdef   __cplusplus
+
+/* Yes, C++ compiler is present.  Use standard C.  */
+extern   "C" {
+
+#endif
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+/* Define EHCI model thread constants.  */
+
+#ifndef UX_HCD_EHCI_MODEL_THREAD_STACK_SIZE
+#define UX_HCD_EHCI_MODEL_THREAD_STACK_SIZE                 UX_THREAD_STACK_SIZE
+#endif
+
+#ifndef UX_HCD_EHCI_MODEL_THREAD_PRIORITY
+#define UX_HCD_EHCI_MODEL_THREAD_PRIORITY                   UX_THREAD_PRIORITY_HCD
+#endif
+
+
+/* Define EHCI model registers. The capability registers take 16 bytes, so the
+   operational registers start at the 4th DWord.  */
+
+#define UX_HCD_EHCI_MODEL_PORTS                             1
+#define UX_HCD_EHCI_MODEL_CAP_LENGTH                        0x01000010u
+#define UX_HCD_EHCI_MODEL_HCS_PARAMS                        (EHCI_HC_RH_PPC | UX_HCD_EHCI_MODEL_PORTS)
+#define UX_HCD_EHCI_MODEL_HCOR                              0x04
+
+#define UX_HCD_EHCI_MODEL_USB_COMMAND                       (UX_HCD_EHCI_MODEL_HCOR + 0x00)
+#define UX_HCD_EHCI_MODEL_USB_STATUS                        (UX_HCD_EHCI_MODEL_HCOR + 0x01)
+#define UX_HCD_EHCI_MODEL_USB_INTERRUPT                     (UX_HCD_EHCI_MODEL_HCOR + 0x02)
+#define UX_HCD_EHCI_MODEL_FRAME_INDEX                       (UX_HCD_EHCI_MODEL_HCOR + 0x03)
+#define UX_HCD_EHCI_MODEL_FRAME_LIST_BASE_ADDRESS           (UX_HCD_EHCI_MODEL_HCOR + 0x05)
+#define UX_HCD_EHCI_MODEL_ASYNCH_LIST_ADDRESS               (UX_HCD_EHCI_MODEL_HCOR + 0x06)
+#define UX_HCD_EHCI_MODEL_CONFIG_FLAG                       (UX_HCD_EHCI_MODEL_HCOR + 0x10)
+#define UX_HCD_EHCI_MODEL_PORT_SC                           (UX_HCD_EHCI_MODEL_HCOR + 0x11)
+#define UX_HCD_EHCI_MODEL_REGISTERS                         (UX_HCD_EHCI_MODEL_PORT_SC + UX_HCD_EHCI_MODEL_PORTS)
+
+
+/* Define EHCI model register bits.  */
+
+#define UX_HCD_EHCI_MODEL_STS_CLEAR_MASK                    0x0000003Fu
+#define UX_HCD_EHCI_MODEL_FRAME_INDEX_MASK                  0x00003FFFu
+#define UX_HCD_EHCI_MODEL_FRAME_INDEX_FRAME                 8
+#define UX_HCD_EHCI_MODEL_PS_CLEAR_MASK                     (EHCI_HC_PS_CSC | EHCI_HC_PS_PEC | EHCI_HC_PS_OCC)
+#define UX_HCD_EHCI_MODEL_PS_WRITE_MASK                     (EHCI_HC_PS_SUSPEND | EHCI_HC_PS_PR | EHCI_HC_PS_PP | EHCI_HC_PS_PO | 0x007FC000u)
+
+
+/* Define EHCI model qTD constants. The current page of the qTD buffer is kept in
+   the C_Page field of the qTD token, the offset in the low bits of bp0.  */
+
+#define UX_HCD_EHCI_MODEL_TD_C_PAGE_LOC                     12u
+#define UX_HCD_EHCI_MODEL_TD_C_PAGE_MASK                    0x7u
+#define UX_HCD_EHCI_MODEL_TD_OFFSET_MASK                    0x00000FFFu
+#define UX_HCD_EHCI_MODEL_TD_PAGES                          5
+
+
+/* Define EHCI model qTD process results.  */
+
+#define UX_HCD_EHCI_MODEL_TD_NAK                            0
+#define UX_HCD_EHCI_MODEL_TD_PROGRESS                       1
+#define UX_HCD_EHCI_MODEL_TD_RETIRED                        2
+
+
+/* Define EHCI model limits. They bound the walk of the lists in memory, so a
+   corrupted link does not lock the model.  */
+
+#define UX_HCD_EHCI_MODEL_LINKS_MAX                         (UX_MAX_ED + UX_MAX_ISO_TD + 1)
+#define UX_HCD_EHCI_MODEL_TD_PASSES_MAX                     32
+
+
+/* Define the EHCI model structure. The registers must be the first field: the
+   EHCI driver register base address is the address of the model.  */
+
+typedef struct UX_HCD_EHCI_MODEL_STRUCT
+{
+
+    ULONG           ux_hcd_ehci_model_registers[UX_HCD_EHCI_MODEL_REGISTERS];
+    struct UX_HCD_STRUCT
+                    *ux_hcd_ehci_model_hcd;
+    UX_THREAD       ux_hcd_ehci_model_thread;
+    UCHAR           *ux_hcd_ehci_model_thread_stack;
+    UX_SEMAPHORE    ux_hcd_ehci_model_semaphore;
+    ULONG           ux_hcd_ehci_model_frames;
+    ULONG           ux_hcd_ehci_model_transactions;
+    ULONG           ux_hcd_ehci_model_naks;
+    ULONG           ux_hcd_ehci_model_bytes;
+    ULONG           ux_hcd_ehci_model_interrupts;
+    ULONG           ux_hcd_ehci_model_doorbells;
+} UX_HCD_EHCI_MODEL;
+
+
+/* Define EHCI model function prototypes.  */
+
+UINT    _ux_hcd_ehci_model_initialize(UX_HCD *hcd);
+VOID    _ux_hcd_ehci_model_port_reset(UX_HCD_EHCI_MODEL *hcd_ehci_model);
+ULONG   _ux_hcd_ehci_model_qh_process(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh);
+ULONG   _ux_hcd_ehci_model_register_read(UX_HCD_EHCI_MODEL *hcd_ehci_model, ULONG ehci_register);
+VOID    _ux_hcd_ehci_model_register_write(UX_HCD_EHCI_MODEL *hcd_ehci_model, ULONG ehci_register, ULONG value);
+ULONG   _ux_hcd_ehci_model_schedule(UX_HCD_EHCI_MODEL *hcd_ehci_model);
+ULONG   _ux_hcd_ehci_model_setup_process(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh, UX_EHCI_TD *td);
+VOID    _ux_hcd_ehci_model_td_data_copy(UX_EHCI_TD *td, UCHAR *data_pointer, ULONG length, ULONG direction);
+ULONG   _ux_hcd_ehci_model_td_process(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh, UX_EHCI_TD *td);
+VOID    _ux_hcd_ehci_model_td_retire(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh, UX_EHCI_TD *td, ULONG td_status);
+VOID    _ux_hcd_ehci_model_thread_entry(ULONG hcd_ehci_model_address);
+
+#define ux_hcd_ehci_model_initialize                _ux_hcd_ehci_model_initialize
+
+#endif
+
+/* Determine if a C++ compiler is being used.  If so, complete the standard
+   C conditional started above.  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,7 +25,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_hcd_ohci.h                                       PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,11 @@
 /*  07-29-2022     Yajun Xia                Modified comment(s),          */
 /*                                            fixed OHCI PRSC issue,      */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added TD list mutex,        */
+/*                                            added setup buffer in TD,   */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -265,8 +270,18 @@ typedef struct UX_HCD_OHCI_STRUCT
                     *ux_hcd_ohci_td_list;
     struct UX_OHCI_ISO_TD_STRUCT       
                     *ux_hcd_ohci_iso_td_list;
+    struct UX_OHCI_ED_STRUCT
+                    *ux_hcd_ohci_ed_free_list;
+    struct UX_OHCI_TD_STRUCT
+                    *ux_hcd_ohci_td_free_list;
+    struct UX_OHCI_ISO_TD_STRUCT
+                    *ux_hcd_ohci_iso_td_free_list;
     UX_EVENT_FLAGS_GROUP
                     ux_hcd_ohci_event_flags_group;
+#if !defined(UX_HOST_STANDALONE)
+    UX_MUTEX        ux_hcd_ohci_td_mutex;
+    ULONG           ux_hcd_ohci_td_mutex_contentions;
+#endif
 } UX_HCD_OHCI;
 
 
@@ -315,7 +330,8 @@ typedef struct UX_OHCI_TD_STRUCT
     struct UX_OHCI_TD_STRUCT              
                     *ux_ohci_td_next_td;
     UCHAR *         ux_ohci_td_be;
-    ULONG           ux_ohci_td_reserved_1[4];
+    UCHAR           ux_ohci_td_setup[UX_SETUP_SIZE];
+    ULONG           ux_ohci_td_reserved_1[2];
     struct UX_TRANSFER_STRUCT          
                     *ux_ohci_td_transfer_request;
     struct UX_OHCI_TD_STRUCT              
@@ -380,6 +396,7 @@ UINT    _ux_hcd_ohci_asynchronous_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDP
 UINT    _ux_hcd_ohci_asynchronous_endpoint_destroy(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ohci_controller_disable(UX_HCD_OHCI *hcd_ohci);
 VOID    _ux_hcd_ohci_done_queue_process(UX_HCD_OHCI *hcd_ohci);
+VOID    _ux_hcd_ohci_ed_free(UX_HCD_OHCI *hcd_ohci, UX_OHCI_ED *ed);
 UX_OHCI_ED  *_ux_hcd_ohci_ed_obtain(UX_HCD_OHCI *hcd_ohci);
 UINT    _ux_hcd_ohci_endpoint_error_clear(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ohci_endpoint_reset(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
@@ -390,9 +407,10 @@ UINT    _ux_hcd_ohci_initialize(UX_HCD *hcd);
 UINT    _ux_hcd_ohci_interrupt_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 VOID    _ux_hcd_ohci_interrupt_handler(VOID);
 UINT    _ux_hcd_ohci_isochronous_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
+VOID    _ux_hcd_ohci_isochronous_td_free(UX_HCD_OHCI *hcd_ohci, UX_OHCI_ISO_TD *td);
 UX_OHCI_ISO_TD  *_ux_hcd_ohci_isochronous_td_obtain(UX_HCD_OHCI *hcd_ohci);
 UX_OHCI_ED  *_ux_hcd_ohci_least_traffic_list_get(UX_HCD_OHCI *hcd_ohci);
-VOID    _ux_hcd_ohci_next_td_clean(UX_OHCI_TD *td);
+VOID    _ux_hcd_ohci_next_td_clean(UX_HCD_OHCI *hcd_ohci, UX_OHCI_TD *td);
 UINT    _ux_hcd_ohci_periodic_endpoint_destroy(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint);
 UINT    _ux_hcd_ohci_periodic_tree_create(UX_HCD_OHCI *hcd_ohci);
 UINT    _ux_hcd_ohci_port_disable(UX_HCD_OHCI *hcd_ohci, ULONG port_index);
@@ -406,6 +424,7 @@ UINT    _ux_hcd_ohci_power_on_port(UX_HCD_OHCI *hcd_ohci, ULONG port_index);
 VOID    _ux_hcd_ohci_power_root_hubs(UX_HCD_OHCI *hcd_ohci);
 ULONG   _ux_hcd_ohci_register_read(UX_HCD_OHCI *hcd_ohci, ULONG ohci_register);
 VOID    _ux_hcd_ohci_register_write(UX_HCD_OHCI *hcd_ohci, ULONG ohci_register, ULONG value);
+VOID    _ux_hcd_ohci_regular_td_free(UX_HCD_OHCI *hcd_ohci, UX_OHCI_TD *td);
 UX_OHCI_TD  *_ux_hcd_ohci_regular_td_obtain(UX_HCD_OHCI *hcd_ohci);
 UINT    _ux_hcd_ohci_request_bulk_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request);
 UINT    _ux_hcd_ohci_request_control_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request);
@@ -0,0 +1,175 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  COMPONENT DEFINITION                                   RELEASE        */
+/*                                                                        */
+/*    ux_hcd_ohci_model.h                                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This file contains all the header and extern functions used by the  */
+/*    software OHCI controller model. The model holds the OHCI registers  */
+/*    in memory, walks the periodic, control and bulk ED lists built by   */
+/*    the OHCI driver, executes the TDs with the device simulator and     */
+/*    writes the done queue back to the HCCA, so the OHCI driver runs     */
+/*    without OHCI hardware.                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+
+#ifndef UX_HCD_OHCI_MODEL_H
+#define UX_HCD_OHCI_MODEL_H
+
+/* Determine if a C++ compiler is being used.  If so, ensure that standard
+   C is used to process the API information.  */
+
+#ifdef   __cplusplus
+
+/* Yes, C++ compiler is present.  Use standard C.  */
+extern   "C" {
+
+#endif
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+/* Define OHCI model thread constants.  */
+
+#ifndef UX_HCD_OHCI_MODEL_THREAD_STACK_SIZE
+#define UX_HCD_OHCI_MODEL_THREAD_STACK_SIZE                 UX_THREAD_STACK_SIZE
+#endif
+
+#ifndef UX_HCD_OHCI_MODEL_THREAD_PRIORITY
+#define UX_HCD_OHCI_MODEL_THREAD_PRIORITY                   UX_THREAD_PRIORITY_HCD
+#endif
+
+
+/* Define OHCI model registers and their reset values. The root hub ports are
+   powered as a gang through the root hub status register.  */
+
+#define UX_HCD_OHCI_MODEL_PORTS                             1
+#define UX_HCD_OHCI_MODEL_REGISTERS                         (OHCI_HC_RH_PORT_STATUS + UX_HCD_OHCI_MODEL_PORTS)
+
+#define UX_HCD_OHCI_MODEL_REVISION                          0x00000010u
+#define UX_HCD_OHCI_MODEL_FM_INTERVAL                       0x00002EDFu
+#define UX_HCD_OHCI_MODEL_LS_THRESHOLD                      0x00000628u
+#define UX_HCD_OHCI_MODEL_RH_DESCRIPTOR_A                   (OHCI_HC_RH_NOCP | UX_HCD_OHCI_MODEL_PORTS)
+
+
+/* Define OHCI model register bits.  */
+
+#define UX_HCD_OHCI_MODEL_CR_HCFS_MASK                      0x000000C0u
+#define UX_HCD_OHCI_MODEL_CS_WRITE_MASK                     (OHCI_HC_CS_CLF | OHCI_HC_CS_BLF)
+#define UX_HCD_OHCI_MODEL_FM_NUMBER_MASK                    0x0000FFFFu
+#define UX_HCD_OHCI_MODEL_FM_NUMBER_MSB                     0x00008000u
+#define UX_HCD_OHCI_MODEL_HCCA_ED_MASK                      0x0000001Fu
+#define UX_HCD_OHCI_MODEL_PS_CLEAR_MASK                     (OHCI_HC_PS_CSC | OHCI_HC_PS_PESC | OHCI_HC_PS_PSSC | OHCI_HC_PS_OCIC | OHCI_HC_PS_PRSC)
+#define UX_HCD_OHCI_MODEL_PS_CPP                            0x00000200u
+#define UX_HCD_OHCI_MODEL_DONE_HEAD_INT                     0x00000001u
+
+
+/* Define OHCI model ED and TD fields. The direction comes from the TD unless
+   the ED sets it. The TD direction field is 0 for a SETUP.  */
+
+#define UX_HCD_OHCI_MODEL_ED_FA_MASK                        0x0000007Fu
+#define UX_HCD_OHCI_MODEL_ED_EN_SHIFT                       7u
+#define UX_HCD_OHCI_MODEL_ED_EN_MASK                        0x0000000Fu
+#define UX_HCD_OHCI_MODEL_ED_D_MASK                         (UX_OHCI_ED_OUT | UX_OHCI_ED_IN)
+#define UX_HCD_OHCI_MODEL_ED_HEAD_FLAGS                     (UX_OHCI_ED_HALTED | UX_OHCI_ED_TOGGLE_CARRY)
+#define UX_HCD_OHCI_MODEL_TD_DP_MASK                        (UX_OHCI_TD_OUT | UX_OHCI_TD_IN)
+#define UX_HCD_OHCI_MODEL_TD_DP_SETUP                       0x00000000u
+#define UX_HCD_OHCI_MODEL_TD_CC_MASK                        0xF0000000u
+
+
+/* Define OHCI model TD process results.  */
+
+#define UX_HCD_OHCI_MODEL_TD_NAK                            0
+#define UX_HCD_OHCI_MODEL_TD_PROGRESS                       1
+#define UX_HCD_OHCI_MODEL_TD_RETIRED                        2
+
+
+/* Define OHCI model limits. They bound the walk of the lists in memory, so a
+   corrupted link does not lock the model.  */
+
+#define UX_HCD_OHCI_MODEL_LINKS_MAX                         (UX_MAX_ED + 1)
+#define UX_HCD_OHCI_MODEL_TD_PASSES_MAX                     32
+
+
+/* Define the OHCI model structure. The registers must be the first field: the
+   OHCI driver register base address is the address of the model.  */
+
+typedef struct UX_HCD_OHCI_MODEL_STRUCT
+{
+
+    ULONG           ux_hcd_ohci_model_registers[UX_HCD_OHCI_MODEL_REGISTERS];
+    struct UX_HCD_STRUCT
+                    *ux_hcd_ohci_model_hcd;
+    struct UX_OHCI_TD_STRUCT
+                    *ux_hcd_ohci_model_done_queue;
+    UX_THREAD       ux_hcd_ohci_model_thread;
+    UCHAR           *ux_hcd_ohci_model_thread_stack;
+    UX_SEMAPHORE    ux_hcd_ohci_model_semaphore;
+    ULONG           ux_hcd_ohci_model_frames;
+    ULONG           ux_hcd_ohci_model_transactions;
+    ULONG           ux_hcd_ohci_model_naks;
+    ULONG           ux_hcd_ohci_model_bytes;
+    ULONG           ux_hcd_ohci_model_interrupts;
+    ULONG           ux_hcd_ohci_model_done_heads;
+} UX_HCD_OHCI_MODEL;
+
+
+/* Define OHCI model function prototypes.  */
+
+ULONG   _ux_hcd_ohci_model_ed_list_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, ULONG *list_filled);
+ULONG   _ux_hcd_ohci_model_ed_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed);
+UINT    _ux_hcd_ohci_model_initialize(UX_HCD *hcd);
+VOID    _ux_hcd_ohci_model_port_reset(UX_HCD_OHCI_MODEL *hcd_ohci_model);
+ULONG   _ux_hcd_ohci_model_register_read(UX_HCD_OHCI_MODEL *hcd_ohci_model, ULONG ohci_register);
+VOID    _ux_hcd_ohci_model_register_write(UX_HCD_OHCI_MODEL *hcd_ohci_model, ULONG ohci_register, ULONG value);
+ULONG   _ux_hcd_ohci_model_schedule(UX_HCD_OHCI_MODEL *hcd_ohci_model);
+ULONG   _ux_hcd_ohci_model_setup_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, UX_OHCI_TD *td);
+ULONG   _ux_hcd_ohci_model_td_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, UX_OHCI_TD *td);
+VOID    _ux_hcd_ohci_model_td_retire(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, UX_OHCI_TD *td, ULONG condition_code);
+VOID    _ux_hcd_ohci_model_thread_entry(ULONG hcd_ohci_model_address);
+
+#define ux_hcd_ohci_model_initialize                _ux_hcd_ohci_model_initialize
+
+#endif
+
+/* Determine if a C++ compiler is being used.  If so, complete the standard
+   C conditional started above.  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_asynch_td_process                      PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -47,6 +47,7 @@
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
 /*    ed                                    Pointer to ED                 */ 
 /*    td                                    Pointer to TD                 */ 
 /*                                                                        */ 
@@ -58,6 +59,7 @@
 /*                                                                        */ 
 /*    (ux_transfer_request_completion_function) Completion function       */ 
 /*    _ux_hcd_ehci_ed_clean                 Clean ED                      */ 
+/*    _ux_hcd_ehci_regular_td_free          Free TD                       */
 /*    _ux_host_semaphore_put                Put semaphore                 */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
@@ -75,9 +77,18 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            invalidation,               */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
-UX_EHCI_TD  *_ux_hcd_ehci_asynch_td_process(UX_EHCI_ED *ed, UX_EHCI_TD *td)
+UX_EHCI_TD  *_ux_hcd_ehci_asynch_td_process(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed, UX_EHCI_TD *td)
 {
 
 UX_TRANSFER     *transfer_request;
@@ -129,11 +140,18 @@ ULONG           pid;
         /* Update the transfer code.  */
         transfer_request -> ux_transfer_request_completion_code =  td_error;
         
-        /* Clean the link.  */
-        _ux_hcd_ehci_ed_clean(ed);
+        /* Clean the link, the TD that was just treated is freed with it.  */
+        _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
 
-        /* Free the TD that was just treated.  */
-        td -> ux_ehci_td_status =  UX_UNUSED;
+        /* If trace ring is enabled, insert this event into the ring.  */
+        UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                    transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+        /* Count the transfer completion in the endpoint statistics.  */
+        UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+        /* Start the next transfer queued on the endpoint.  */
+        UX_TRANSFER_QUEUE_NEXT(transfer_request);
 
         /* We may do a call back.  */
         if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
@@ -177,11 +195,21 @@ ULONG           pid;
             /* Update the transfer code.  */
             transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
         
-            /* Clean the link.  */
-            _ux_hcd_ehci_ed_clean(ed);
+            /* Clean the link, the TD that was just treated is freed with it.  */
+            _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
+
+            /* Discard cached lines of the data received.  */
+            UX_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
+
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                        transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+            /* Count the transfer completion in the endpoint statistics.  */
+            UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
 
-            /* Free the TD that was just treated.  */
-            td -> ux_ehci_td_status =  UX_UNUSED;
+            /* Start the next transfer queued on the endpoint.  */
+            UX_TRANSFER_QUEUE_NEXT(transfer_request);
 
             /* We may do a call back.  */
             if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
@@ -201,7 +229,7 @@ ULONG           pid;
     next_td =  _ux_utility_virtual_address((VOID *) td_element);
     
     /* Free the TD that was just treated.  */
-    td -> ux_ehci_td_status =  UX_UNUSED;
+    _ux_hcd_ehci_regular_td_free(hcd_ehci, td);
 
     /* This TD is now the first TD.  */
     ed -> ux_ehci_ed_first_td = next_td;
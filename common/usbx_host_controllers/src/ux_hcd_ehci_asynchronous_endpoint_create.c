@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_asynchronous_endpoint_create           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -77,6 +77,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            marked control EDs,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_asynchronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -100,8 +103,15 @@ UX_EHCI_LINK_POINTER    queue_head;
     /* Attach the ED to the endpoint container.  */
     endpoint -> ux_endpoint_ed =  (VOID *) ed;
 
-    /* Now do the opposite, attach the ED container to the physical ED.  */
-    ed -> REF_AS.INTR.ux_ehci_ed_endpoint =  endpoint;
+    /* Now do the opposite, attach the ED container to the physical ED. A control ED
+       is marked, it keeps the endpoint in its control part.  */
+    if ((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_CONTROL_ENDPOINT)
+    {
+        ed -> ux_ehci_ed_status |=  UX_EHCI_QH_CONTROL;
+        ed -> REF_AS.CONTROL.ux_ehci_ed_endpoint =  endpoint;
+    }
+    else
+        ed -> REF_AS.INTR.ux_ehci_ed_endpoint =  endpoint;
 
     /* Set the default MPS Capability info in the ED.  */
     ed -> ux_ehci_ed_cap0 =  (ULONG)endpoint -> ux_endpoint_descriptor.wMaxPacketSize << UX_EHCI_QH_MPS_LOC;
@@ -0,0 +1,126 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_bandwidth_map_list_get                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function returns a pointer to the first ED of the periodic     */
+/*    tree list of the frame the host stack bandwidth map placed the      */
+/*    endpoint in, with the micro-frame loads registered in the list.     */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    endpoint                              Pointer to endpoint           */
+/*    microframe_load                       Pointer to an array for 8     */
+/*                                          micro-frame loads             */
+/*    microframe_ssplit_count               Pointer to an array for 8     */
+/*                                          micro-frame start split count */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_EHCI_ED *                          Pointer to ED                 */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Driver                                              */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UX_EHCI_ED  *_ux_hcd_ehci_bandwidth_map_list_get(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint,
+    ULONG microframe_load[8], ULONG microframe_ssplit_count[8])
+{
+
+UX_EHCI_ED                      *ed;
+UX_EHCI_PERIODIC_LINK_POINTER   anchor;
+UINT                            frindex;
+
+
+#if !defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+    UX_PARAMETER_NOT_USED(microframe_ssplit_count);
+#endif
+
+    /* Get the ED of the beginning of the list of the endpoint frame.  */
+    /* Obtain the ED address only.  */
+    /* Obtain the virtual address from the element.  */
+    anchor.ed_ptr =  *(hcd_ehci -> ux_hcd_ehci_frame_list + UX_BANDWIDTH_MAP_FRAME(endpoint));
+    anchor.value &= UX_EHCI_LINK_ADDRESS_MASK;
+    anchor.void_ptr = _ux_utility_virtual_address(anchor.void_ptr);
+
+    /* Summary micro-frames loads of anchors.  */
+    /* Reset microframe load table.  */
+    for (frindex = 0; frindex < 8; frindex ++)
+    {
+        microframe_load[frindex] = 0;
+#if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+        microframe_ssplit_count[frindex] = 0;
+#endif
+    }
+
+    /* Scan static anchors in the list.  */
+    ed = anchor.ed_ptr;
+    while(ed -> REF_AS.ANCHOR.ux_ehci_ed_next_anchor != UX_NULL)
+    {
+        for (frindex = 0; frindex < 8; frindex ++)
+        {
+            microframe_load[frindex] += ed -> REF_AS.ANCHOR.ux_ehci_ed_microframe_load[frindex];
+#if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+            microframe_ssplit_count[frindex] += ed -> REF_AS.ANCHOR.ux_ehci_ed_microframe_ssplit_count[frindex];
+#endif
+        }
+
+        /* Next static anchor.  */
+        ed = ed -> REF_AS.ANCHOR.ux_ehci_ed_next_anchor;
+    }
+
+    /* Return the ED list of the endpoint frame.  */
+    return(anchor.ed_ptr);
+}
+#endif
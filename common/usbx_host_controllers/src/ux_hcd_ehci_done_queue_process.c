@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_done_queue_process                     PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -43,7 +43,8 @@
 /*                                                                        */
 /*    This function process the isochronous, periodic and asynchronous    */
 /*    lists in search for transfers that occurred in the past             */
-/*    (micro-)frame.                                                      */
+/*    (micro-)frame. Only the EDs with TDs attached are scanned, they are */
+/*    found in the ED pending bitmap.                                     */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -62,7 +63,6 @@
 /*    _ux_hcd_ehci_fsisochronous_tds_process                              */
 /*                                          Process full speed (split)    */
 /*                                          isochronous TDs               */
-/*    _ux_utility_virtual_address           Get virtual address           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -81,14 +81,22 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            scanned pending EDs only,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ehci_done_queue_process(UX_HCD_EHCI *hcd_ehci)
 {
 
+UX_INTERRUPT_SAVE_AREA
+
 UX_EHCI_TD                      *td;
-UX_EHCI_PERIODIC_LINK_POINTER   ed;
-UX_EHCI_ED                      *start_ed;
+UX_EHCI_ED                      *ed;
+ULONG                           pending;
+ULONG                           pending_index;
+ULONG                           ed_index;
 
 
 #if UX_MAX_ISO_TD
@@ -121,54 +129,46 @@ UX_EHCI_PERIODIC_LINK_POINTER   lp;
 #endif
 #endif
 
-    /* We scan the linked interrupt list then.  */
+    /* We scan the EDs with TDs attached then, interrupt and asynchronous ones. The EDs
+       without transfers are not visited.  */
     _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
-    ed.ed_ptr = hcd_ehci -> ux_hcd_ehci_interrupt_ed_list;
-    while(ed.ed_ptr != UX_NULL)
+    for (pending_index = 0; pending_index < _ux_system_host -> ux_system_host_max_ed; pending_index += 32)
     {
 
-        /* Retrieve the fist TD attached to this ED.  */
-        td =  ed.ed_ptr -> ux_ehci_ed_first_td;
+        /* Get the pending bits of the next 32 EDs.  */
+        pending =  hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap[UX_EHCI_ED_PENDING_WORD(pending_index)];
 
-        /* Process TD until there is no next available.  */
-        while (td != UX_NULL)
-            td =  _ux_hcd_ehci_asynch_td_process(ed.ed_ptr, td);
-        
-        /* Next ED.  */
-        ed.ed_ptr = ed.ed_ptr -> ux_ehci_ed_next_ed;
-    }
-    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+        /* Scan each ED that has its bit set.  */
+        for (ed_index = pending_index; pending != 0; ed_index++, pending >>= 1)
+        {
 
-    /* Now we can parse the asynchronous list. The head ED is always empty and
-       used as an anchor only.  */
-    start_ed =  hcd_ehci -> ux_hcd_ehci_asynch_head_list;
+            if ((pending & 1u) == 0)
+                continue;
 
-    /* Point to the next ED in the asynchronous tree.  */
-    ed.ed_ptr = start_ed -> ux_ehci_ed_queue_head;
-    ed.value &= UX_EHCI_LINK_ADDRESS_MASK;
+            ed =  hcd_ehci -> ux_hcd_ehci_ed_list + ed_index;
 
-    /* Obtain the virtual address from the element.  */
-    ed.void_ptr = _ux_utility_virtual_address(ed.void_ptr);
+            /* Count the scan in the endpoint statistics, a control ED keeps its endpoint
+               in its control part.  */
+            if (ed -> ux_ehci_ed_status & UX_EHCI_QH_CONTROL)
+                UX_ENDPOINT_STATISTICS_SCAN(ed -> REF_AS.CONTROL.ux_ehci_ed_endpoint);
+            else
+                UX_ENDPOINT_STATISTICS_SCAN(ed -> REF_AS.INTR.ux_ehci_ed_endpoint);
 
-    /* Now traverse this list until we have found a non anchor endpoint that
-       has transfers done.  */
-    while (ed.ed_ptr != start_ed)
-    {
+            /* Retrieve the fist TD attached to this ED.  */
+            td =  ed -> ux_ehci_ed_first_td;
 
-        /* Retrieve the fist TD attached to this ED.  */
-        td =  ed.ed_ptr -> ux_ehci_ed_first_td;
-        while (td != UX_NULL)
-        {
+            /* Process TD until there is no next available.  */
+            while (td != UX_NULL)
+                td =  _ux_hcd_ehci_asynch_td_process(hcd_ehci, ed, td);
 
-            td =  _ux_hcd_ehci_asynch_td_process(ed.ed_ptr, td);
+            /* The ED is not scanned any more once all its TDs are done. A transfer
+               started meanwhile has set the bit again and attached its TDs.  */
+            UX_DISABLE
+            if (ed -> ux_ehci_ed_first_td == UX_NULL)
+                hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap[UX_EHCI_ED_PENDING_WORD(ed_index)] &=  ~UX_EHCI_ED_PENDING_BIT(ed_index);
+            UX_RESTORE
         }
-
-        /* Point to the next ED in the asynchronous tree.  */
-        ed.ed_ptr = ed.ed_ptr -> ux_ehci_ed_queue_head;
-        ed.value &= UX_EHCI_LINK_ADDRESS_MASK;
-
-        /* Obtain the virtual address from the element.  */
-        ed.void_ptr = _ux_utility_virtual_address(ed.void_ptr);
     }
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
 }
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_ed_clean                               PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -42,10 +42,12 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */ 
 /*    This function cleans the tds attached to a ED in case a transfer    */ 
-/*    has to be aborted.                                                  */ 
+/*    has to be aborted or is complete. All the TDs from the first TD not */
+/*    processed yet are freed, once each.                                 */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
 /*    ed                                    Pointer to ED                 */ 
 /*                                                                        */ 
 /*  OUTPUT                                                                */ 
@@ -54,6 +56,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_regular_td_free          Free TD                       */
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -67,19 +70,23 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            freed TDs from the first TD */
+/*                                            not processed,              */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
-UINT  _ux_hcd_ehci_ed_clean(UX_EHCI_ED *ed)
+UINT  _ux_hcd_ehci_ed_clean(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed)
 {
 
 UX_EHCI_TD      *td;
 UX_EHCI_TD      *next_td;
     
 
-    /* Get the first pointer to the TD.  */   
-    td =  ed -> ux_ehci_ed_queue_element;
-    td =  (UX_EHCI_TD *) ((ULONG) td & ~UX_EHCI_QH_T);
-    td =  _ux_utility_virtual_address(td);
+    /* Get the first TD not processed yet. The controller may have moved the queue
+       element past it, but the TD still has to be freed.  */
+    td =  ed -> ux_ehci_ed_first_td;
 
     /* Mark the TD link of the endpoint as terminated.  */
     ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
@@ -93,8 +100,8 @@ UX_EHCI_TD      *next_td;
         next_td =  (UX_EHCI_TD *) ((ULONG) next_td & ~UX_EHCI_TD_T);
         next_td =  _ux_utility_virtual_address(next_td);
 
-        /* Mark the current TD as free.  */
-        td -> ux_ehci_td_status =  UX_UNUSED;
+        /* Free the current TD.  */
+        _ux_hcd_ehci_regular_td_free(hcd_ehci, td);
 
         td =  next_td;
     }
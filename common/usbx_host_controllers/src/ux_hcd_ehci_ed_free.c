@@ -0,0 +1,93 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_ed_free                                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function puts an ED back at the head of the free list of the   */
+/*    ED list, where the next ED is obtained from.                        */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_ed_pending_clear         Clear ED pending bit          */
+/*    _ux_host_mutex_off                    Release protection mutex      */
+/*    _ux_host_mutex_on_count               Get protection mutex          */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Driver                                              */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_ed_free(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed)
+{
+
+    /* The ED is not scanned for completed transfers any more.  */
+    _ux_hcd_ehci_ed_pending_clear(hcd_ehci, ed);
+
+    /* Get the mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_ehci -> ux_hcd_ehci_td_mutex, &hcd_ehci -> ux_hcd_ehci_td_mutex_contentions);
+
+    /* An ED freed twice must be put in the free list only once.  */
+    if (ed -> ux_ehci_ed_status != UX_UNUSED)
+    {
+
+        /* Mark the ED as free and put it at the head of the free list.  */
+        ed -> ux_ehci_ed_status =  UX_UNUSED;
+        ed -> ux_ehci_ed_next_ed =  hcd_ehci -> ux_hcd_ehci_ed_free_list;
+        hcd_ehci -> ux_hcd_ehci_ed_free_list =  ed;
+    }
+
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_td_mutex);
+}
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_ed_obtain                              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,6 +53,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_mutex_on_count               Get protection mutex          */
+/*    _ux_host_mutex_off                    Release protection mutex      */
 /*    _ux_utility_memory_set                Set memory block              */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -68,43 +70,43 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_EHCI_ED  *_ux_hcd_ehci_ed_obtain(UX_HCD_EHCI *hcd_ehci)
 {
 
 UX_EHCI_ED      *ed;
-ULONG           ed_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    ed =  hcd_ehci -> ux_hcd_ehci_ed_list;
-    for (ed_index = 0; ed_index < _ux_system_host -> ux_system_host_max_ed; ed_index++)
-    {
+    /* Get the mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_ehci -> ux_hcd_ehci_td_mutex, &hcd_ehci -> ux_hcd_ehci_td_mutex_contentions);
 
-        /* Check the ED status, a free ED is marked with the UNUSED flag.  */
-        if (ed -> ux_ehci_ed_status == UX_UNUSED)
-        {
+    /* Take the ED at the head of the free list.  */
+    ed =  hcd_ehci -> ux_hcd_ehci_ed_free_list;
+    if (ed != UX_NULL)
+        hcd_ehci -> ux_hcd_ehci_ed_free_list =  ed -> ux_ehci_ed_next_ed;
 
-            /* The ED may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(ed, 0, sizeof(UX_EHCI_ED)); /* Use case of memset is verified. */
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_td_mutex);
 
-            /* This ED is now marked as USED.  */
-            ed -> ux_ehci_ed_status =  UX_USED;
+    /* There is no available ED in the ED list.  */
+    if (ed == UX_NULL)
+        return(UX_NULL);
 
-            /* We initialize the type of ED and mark its TD terminator to be safe.  */
-            ed -> ux_ehci_ed_queue_head =     (UX_EHCI_ED *) UX_EHCI_QH_TYP_QH;               
-            ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
-            
-            /* Success, return ED pointer.  */
-            return(ed);
-        }
+    /* The ED may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(ed, 0, sizeof(UX_EHCI_ED)); /* Use case of memset is verified. */
 
-        /* Point to the next ED.  */
-        ed++;
-    }
+    /* This ED is now marked as USED.  */
+    ed -> ux_ehci_ed_status =  UX_USED;
 
-    /* There is no available ED in the ED list.  */
-    return(UX_NULL);
+    /* We initialize the type of ED and mark its TD terminator to be safe.  */
+    ed -> ux_ehci_ed_queue_head =     (UX_EHCI_ED *) UX_EHCI_QH_TYP_QH;
+    ed -> ux_ehci_ed_queue_element =  (UX_EHCI_TD *) UX_EHCI_TD_T;
+
+    /* Success, return ED pointer.  */
+    return(ed);
 }
 
@@ -0,0 +1,85 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_ed_pending_clear                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function clears the bit of an ED in the pending bitmap, the    */
+/*    done queue process does not scan it any more.                       */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Driver                                              */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_ed_pending_clear(UX_HCD_EHCI *hcd_ehci, UX_EHCI_ED *ed)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG           ed_index;
+
+
+    /* Get the index of the ED in the ED list.  */
+    ed_index =  (ULONG) (ed - hcd_ehci -> ux_hcd_ehci_ed_list);
+
+    /* The bitmap is shared with the done queue process.  */
+    UX_DISABLE
+    hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap[UX_EHCI_ED_PENDING_WORD(ed_index)] &=  ~UX_EHCI_ED_PENDING_BIT(ed_index);
+    UX_RESTORE
+}
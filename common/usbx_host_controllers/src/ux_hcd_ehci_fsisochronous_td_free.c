@@ -0,0 +1,97 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Driver                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_fsisochronous_td_free                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function puts a siTD back at the head of the free list of the  */
+/*    full speed isochronous TD list, where the next siTD is obtained     */
+/*    from.                                                               */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci                              Pointer to EHCI controller    */
+/*    td                                    Pointer to siTD               */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_host_mutex_off                    Release protection mutex      */
+/*    _ux_host_mutex_on_count               Get protection mutex          */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Driver                                              */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_fsisochronous_td_free(UX_HCD_EHCI *hcd_ehci, UX_EHCI_FSISO_TD *td)
+{
+#if UX_MAX_ISO_TD == 0 || !defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+
+    /* This function is not yet supported.  */
+    UX_PARAMETER_NOT_USED(hcd_ehci);
+    UX_PARAMETER_NOT_USED(td);
+#else
+
+    /* Get the mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_ehci -> ux_hcd_ehci_td_mutex, &hcd_ehci -> ux_hcd_ehci_td_mutex_contentions);
+
+    /* A siTD freed twice must be put in the free list only once.  */
+    if (td -> ux_ehci_fsiso_td_status != UX_UNUSED)
+    {
+
+        /* Mark the siTD as free and put it at the head of the free list.  */
+        td -> ux_ehci_fsiso_td_status =  UX_UNUSED;
+        td -> ux_ehci_fsiso_td_next_scan_td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list;
+        hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list =  td;
+    }
+
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_td_mutex);
+#endif
+}
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_fsisochronous_td_obtain                PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -69,6 +69,9 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_EHCI_FSISO_TD  *_ux_hcd_ehci_fsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci)
@@ -81,39 +84,34 @@ UX_EHCI_FSISO_TD  *_ux_hcd_ehci_fsisochronous_td_obtain(UX_HCD_EHCI *hcd_ehci)
 #else
 
 UX_EHCI_FSISO_TD    *td;
-ULONG               td_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_list;
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_iso_td; td_index++)
-    {
+    /* Get the mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_ehci -> ux_hcd_ehci_td_mutex, &hcd_ehci -> ux_hcd_ehci_td_mutex_contentions);
 
-        /* Check the TD status, a free TD is marked with the USED flag.  */
-        if (td -> ux_ehci_fsiso_td_status == UX_UNUSED)
-        {
+    /* Take the TD at the head of the free list.  */
+    td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list;
+    if (td != UX_NULL)
+        hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list =  td -> ux_ehci_fsiso_td_next_scan_td;
 
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_FSISO_TD)); /* Use case of memset is verified. */
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_td_mutex);
 
-            /* This TD is now marked as USED.  */
-            td -> ux_ehci_fsiso_td_status =  UX_USED;
-
-            /* Initialize the link pointer TD fields.  */
-            td -> ux_ehci_fsiso_td_next_lp.value = UX_EHCI_FSISO_T;
+    /* There is no available TD in the TD list.  */
+    if (td == UX_NULL)
+        return(UX_NULL);
 
-            /* Success, return TD pointer.  */
-            return(td);
-        }
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_FSISO_TD)); /* Use case of memset is verified. */
 
-        /* Look at next TD.  */
-        td++;
-    }
+    /* This TD is now marked as USED.  */
+    td -> ux_ehci_fsiso_td_status =  UX_USED;
 
-    /* There is no available TD in the TD list.  */
+    /* Initialize the link pointer TD fields.  */
+    td -> ux_ehci_fsiso_td_next_lp.value = UX_EHCI_FSISO_T;
 
-    /* Error, return a null.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 #endif
 }
 
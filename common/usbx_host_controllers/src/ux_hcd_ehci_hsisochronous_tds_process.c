@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_hsisochronous_tds_process              PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -80,6 +80,12 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved uframe handling,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            invalidation,               */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_EHCI_HSISO_TD* _ux_hcd_ehci_hsisochronous_tds_process(
@@ -261,6 +267,16 @@ UINT                            i;
             if (ed -> ux_ehci_hsiso_ed_transfer_head == UX_NULL)
                 ed -> ux_ehci_hsiso_ed_transfer_tail = UX_NULL;
 
+            /* Discard cached lines of the data received.  */
+            UX_TRANSFER_DATA_CACHE_INVALIDATE(transfer);
+
+            /* If trace ring is enabled, insert this event into the ring.  */
+            UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer,
+                        transfer -> ux_transfer_request_completion_code, transfer -> ux_transfer_request_actual_length)
+
+            /* Count the transfer completion in the endpoint statistics.  */
+            UX_TRANSFER_STATISTICS_COMPLETE(transfer);
+
             /* Invoke callback.  */
             if (transfer -> ux_transfer_request_completion_function)
                 transfer -> ux_transfer_request_completion_function(transfer);
@@ -59,7 +59,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_initialize                             PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -116,6 +116,11 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            created TD list mutex,      */
+/*                                            used ED and TD free lists,  */
+/*                                            added ED pending bitmap,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_initialize(UX_HCD *hcd)
@@ -127,6 +132,14 @@ UINT  _ux_hcd_ehci_initialize(UX_HCD *hcd)
 
 UX_HCD_EHCI             *hcd_ehci;
 UX_EHCI_ED              *ed;
+UX_EHCI_TD              *td;
+#if UX_MAX_ISO_TD
+UX_EHCI_HSISO_TD        *hsiso_td;
+#if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+UX_EHCI_FSISO_TD        *fsiso_td;
+#endif
+#endif
+ULONG                   list_index;
 UX_EHCI_LINK_POINTER    lp;
 ULONG                   ehci_register;
 ULONG                   port_index;
@@ -217,6 +230,15 @@ UINT                    status = UX_SUCCESS;
             status = (UX_MEMORY_INSUFFICIENT);
     }
 
+    /* Allocate the ED pending bitmap, one bit for each ED.  */
+    if (status == UX_SUCCESS)
+    {
+        hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+                        sizeof(ULONG) * (UX_EHCI_ED_PENDING_WORD(_ux_system_host -> ux_system_host_max_ed) + 1));
+        if (hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap == UX_NULL)
+            status = (UX_MEMORY_INSUFFICIENT);
+    }
+
     /* Allocate the list of tds. All tds are allocated on 32 byte memory boundary.  */
     if (status == UX_SUCCESS)
     {
@@ -252,6 +274,44 @@ UINT                    status = UX_SUCCESS;
     }
 #endif
 
+    /* Put all the EDs and TDs in their free lists, from the first one to the last one.  */
+    if (status == UX_SUCCESS)
+    {
+        for (list_index = _ux_system_host -> ux_system_host_max_ed; list_index != 0; list_index--)
+        {
+            ed =  hcd_ehci -> ux_hcd_ehci_ed_list + list_index - 1;
+            ed -> ux_ehci_ed_next_ed =  hcd_ehci -> ux_hcd_ehci_ed_free_list;
+            hcd_ehci -> ux_hcd_ehci_ed_free_list =  ed;
+        }
+        for (list_index = _ux_system_host -> ux_system_host_max_td; list_index != 0; list_index--)
+        {
+            td =  hcd_ehci -> ux_hcd_ehci_td_list + list_index - 1;
+            td -> ux_ehci_td_next_td_transfer_request =  hcd_ehci -> ux_hcd_ehci_td_free_list;
+            hcd_ehci -> ux_hcd_ehci_td_free_list =  td;
+        }
+#if UX_MAX_ISO_TD
+        for (list_index = _ux_system_host -> ux_system_host_max_iso_td; list_index != 0; list_index--)
+        {
+            hsiso_td =  hcd_ehci -> ux_hcd_ehci_hsiso_td_list + list_index - 1;
+            hsiso_td -> ux_ehci_hsiso_td_next_scan_td =  hcd_ehci -> ux_hcd_ehci_hsiso_td_free_list;
+            hcd_ehci -> ux_hcd_ehci_hsiso_td_free_list =  hsiso_td;
+#if defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
+            fsiso_td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_list + list_index - 1;
+            fsiso_td -> ux_ehci_fsiso_td_next_scan_td =  hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list;
+            hcd_ehci -> ux_hcd_ehci_fsiso_td_free_list =  fsiso_td;
+#endif
+        }
+#endif
+    }
+
+    /* Create mutex for the ED and TD free lists.  */
+    if (status == UX_SUCCESS)
+    {
+        status = _ux_host_mutex_create(&hcd_ehci -> ux_hcd_ehci_td_mutex, "ehci_td_mutex");
+        if (status != UX_SUCCESS)
+            status = (UX_MUTEX_ERROR);
+    }
+
     /* Initialize the periodic tree.  */
     if (status == UX_SUCCESS)
         status =  _ux_hcd_ehci_periodic_tree_create(hcd_ehci);
@@ -415,6 +475,8 @@ UINT                    status = UX_SUCCESS;
         _ux_utility_memory_free(hcd_ehci -> ux_hcd_ehci_frame_list);
     if (hcd_ehci -> ux_hcd_ehci_ed_list)
         _ux_utility_memory_free(hcd_ehci -> ux_hcd_ehci_ed_list);
+    if (hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap)
+        _ux_utility_memory_free(hcd_ehci -> ux_hcd_ehci_ed_pending_bitmap);
     if (hcd_ehci -> ux_hcd_ehci_td_list)
         _ux_utility_memory_free(hcd_ehci -> ux_hcd_ehci_td_list);
 #if UX_MAX_ISO_TD && defined(UX_HCD_EHCI_SPLIT_TRANSFER_ENABLE)
@@ -427,6 +489,8 @@ UINT                    status = UX_SUCCESS;
 #endif
     if (hcd_ehci -> ux_hcd_ehci_periodic_mutex.tx_mutex_id != 0)
         _ux_host_mutex_delete(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
+    if (hcd_ehci -> ux_hcd_ehci_td_mutex.tx_mutex_id != 0)
+        _ux_host_mutex_delete(&hcd_ehci -> ux_hcd_ehci_td_mutex);
     if (hcd_ehci -> ux_hcd_ehci_protect_semaphore.tx_semaphore_id != 0)
         _ux_host_semaphore_delete(&hcd_ehci -> ux_hcd_ehci_protect_semaphore);
     if (hcd_ehci -> ux_hcd_ehci_doorbell_semaphore.tx_semaphore_id != 0)
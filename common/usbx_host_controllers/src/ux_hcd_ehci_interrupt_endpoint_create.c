@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_interrupt_endpoint_create              PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -71,7 +71,9 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ehci_ed_free                  Free ED                       */
 /*    _ux_hcd_ehci_ed_obtain                Obtain an ED                  */ 
+/*    _ux_hcd_ehci_bandwidth_map_list_get   Get bandwidth map list        */
 /*    _ux_hcd_ehci_least_traffic_list_get   Get least traffic list        */ 
 /*    _ux_hcd_ehci_poll_rate_entry_get      Get anchor for poll rate      */
 /*    _ux_utility_physical_address          Get physical address          */ 
@@ -106,6 +108,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed split transfer issue, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            used bandwidth map list,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_interrupt_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -256,8 +262,18 @@ UINT                            i;
     /* We are now updating the periodic list.  */
     _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+    /* Get the list of the frame the bandwidth map placed the endpoint in, the
+       micro-frame scan starts from the micro-frame placed in the map.  */
+    ed_list =  _ux_hcd_ehci_bandwidth_map_list_get(hcd_ehci, endpoint, microframe_load, microframe_ssplit_count);
+    i =  UX_BANDWIDTH_MAP_MICROFRAME(endpoint);
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list =  _ux_hcd_ehci_least_traffic_list_get(hcd_ehci, microframe_load, microframe_ssplit_count);
+    i =  0;
+#endif
 
     /* Now we need to scan the list of eds from the lowest load entry until we reach the 
        appropriate interval node. The depth index is the interval EHCI value and the 
@@ -272,7 +288,7 @@ UINT                            i;
 
     /* Go through the transaction loads for start
        index of micro-frame.  */
-    for (i = 0; i < interval; i ++)
+    for (; i < interval; i ++)
     {
 
         /* Skip if load too much.  */
@@ -302,7 +318,7 @@ UINT                            i;
     if (i >= interval)
     {
         _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
-        ed -> ux_ehci_ed_status = UX_UNUSED;
+        _ux_hcd_ehci_ed_free(hcd_ehci, ed);
         return(UX_NO_BANDWIDTH_AVAILABLE);
     }
 
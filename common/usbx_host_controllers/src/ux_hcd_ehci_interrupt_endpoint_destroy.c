@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_interrupt_endpoint_destroy             PORTABLE C      */
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_hcd_ehci_door_bell_wait           Setup doorbell wait           */
+/*    _ux_hcd_ehci_ed_free                  Free ED                       */
 /*    _ux_utility_physical_address          Get physical address          */
 /*    _ux_host_mutex_on                     Get mutex                     */
 /*    _ux_host_mutex_off                    Put mutex                     */
@@ -81,6 +82,9 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_interrupt_endpoint_destroy(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -198,7 +202,7 @@ ULONG                         max_packet_size;
     _ux_hcd_ehci_door_bell_wait(hcd_ehci);
 
     /* Now we can safely make the ED free.  */
-    ed -> ux_ehci_ed_status =  UX_UNUSED;
+    _ux_hcd_ehci_ed_free(hcd_ehci, ed);
 
     /* Return successful completion.  */
     return(UX_SUCCESS);
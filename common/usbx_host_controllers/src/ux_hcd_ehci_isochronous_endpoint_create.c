@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_ehci_isochronous_endpoint_create            PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,9 +54,11 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_hcd_ehci_hsisochronous_td_free    Free iTD                      */
 /*    _ux_utility_memory_allocate           Allocate memory               */
 /*    _ux_utility_memory_free               Free memory                   */
 /*    _ux_hcd_ehci_hsisochronous_td_obtain  Obtain a TD                   */
+/*    _ux_hcd_ehci_bandwidth_map_list_get   Get bandwidth map list        */
 /*    _ux_hcd_ehci_least_traffic_list_get   Get least traffic list        */
 /*    _ux_hcd_ehci_poll_rate_entry_get      Get anchor for poll rate      */
 /*    _ux_utility_physical_address          Get physical address          */
@@ -91,6 +93,10 @@
 /*                                            fixed split transfer issue, */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            used bandwidth map list,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_isochronous_endpoint_create(UX_HCD_EHCI *hcd_ehci, UX_ENDPOINT *endpoint)
@@ -245,7 +251,10 @@ UINT                            status;
         if (status != UX_SUCCESS)
         {
             for (i = 0; i < ed -> ux_ehci_hsiso_ed_nb_tds; i ++)
-                ed -> ux_ehci_hsiso_ed_fr_td[i] -> ux_ehci_hsiso_td_status = UX_UNUSED;
+            {
+                if (ed -> ux_ehci_hsiso_ed_fr_td[i] != UX_NULL)
+                    _ux_hcd_ehci_hsisochronous_td_free(hcd_ehci, ed -> ux_ehci_hsiso_ed_fr_td[i]);
+            }
             _ux_utility_memory_free(ed);
             return(status);
         }
@@ -336,8 +345,18 @@ UINT                            status;
     /* Lock the periodic list to update.  */
     _ux_host_mutex_on(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+    /* Get the list of the frame the bandwidth map placed the endpoint in, the
+       micro-frame scan starts from the micro-frame placed in the map.  */
+    ed_list = _ux_hcd_ehci_bandwidth_map_list_get(hcd_ehci, endpoint, microframe_load, microframe_ssplit_count);
+    microframe_i = UX_BANDWIDTH_MAP_MICROFRAME(endpoint);
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list = _ux_hcd_ehci_least_traffic_list_get(hcd_ehci, microframe_load, microframe_ssplit_count);
+    microframe_i = 0;
+#endif
 
     /* Now we need to scan the list of EDs from the lowest load entry until we reach the
        appropriate interval node. The depth index is the interval EHCI value and the
@@ -349,7 +368,7 @@ UINT                            status;
 
     /* Go through the transaction loads for for start
        index of micro-frame.  */
-    for (microframe_i = 0; microframe_i < interval; microframe_i ++)
+    for (; microframe_i < interval; microframe_i ++)
     {
 
         /* Skip if load too much.  */
@@ -380,7 +399,7 @@ UINT                            status;
     {
         _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_periodic_mutex);
         for (i = 0; i < ed -> ux_ehci_hsiso_ed_nb_tds; i ++)
-            ed -> ux_ehci_hsiso_ed_fr_td[i] -> ux_ehci_hsiso_td_status = UX_UNUSED;
+            _ux_hcd_ehci_hsisochronous_td_free(hcd_ehci, ed -> ux_ehci_hsiso_ed_fr_td[i]);
         _ux_utility_memory_free(ed);
         return(UX_NO_BANDWIDTH_AVAILABLE);
     }
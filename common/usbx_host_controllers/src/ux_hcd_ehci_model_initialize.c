@@ -0,0 +1,158 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_initialize                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function initializes the software EHCI controller model and    */
+/*    then the EHCI driver on top of it. The model takes the place of the */
+/*    EHCI registers: the driver register base address is the model, its  */
+/*    thread executes the schedule the driver builds in memory with the   */
+/*    device simulator.                                                   */
+/*                                                                        */
+/*    It is registered as the HCD initialization function instead of      */
+/*    _ux_hcd_ehci_initialize.                                            */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to the host controller*/
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_initialize               Initialize EHCI driver        */
+/*    _ux_hcd_ehci_model_register_write     Write model register          */
+/*    _ux_host_semaphore_create             Create semaphore              */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
+/*    _ux_host_thread_create                Create thread                 */
+/*    _ux_host_thread_delete                Delete thread                 */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Stack                                                          */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_ehci_model_initialize(UX_HCD *hcd)
+{
+
+UX_HCD_EHCI_MODEL       *hcd_ehci_model;
+UINT                    status;
+
+
+    /* Allocate memory for the EHCI model instance.  */
+    hcd_ehci_model =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HCD_EHCI_MODEL));
+    if (hcd_ehci_model == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Keep the HCD the model serves.  */
+    hcd_ehci_model -> ux_hcd_ehci_model_hcd =  hcd;
+
+    /* Set the capability registers: the operational registers offset, the interface
+       version and the number of ports, with port power control.  */
+    hcd_ehci_model -> ux_hcd_ehci_model_registers[EHCI_HCCR_CAP_LENGTH] =  UX_HCD_EHCI_MODEL_CAP_LENGTH;
+    hcd_ehci_model -> ux_hcd_ehci_model_registers[EHCI_HCCR_HCS_PARAMS] =  UX_HCD_EHCI_MODEL_HCS_PARAMS;
+
+    /* Create the semaphore the model thread waits on between passes.  */
+    status =  _ux_host_semaphore_create(&hcd_ehci_model -> ux_hcd_ehci_model_semaphore, "ux_hcd_ehci_model_semaphore", 0);
+    if (status != UX_SUCCESS)
+    {
+        _ux_utility_memory_free(hcd_ehci_model);
+        return(UX_SEMAPHORE_ERROR);
+    }
+
+    /* The operational registers start from their reset values.  */
+    _ux_hcd_ehci_model_register_write(hcd_ehci_model, UX_HCD_EHCI_MODEL_USB_COMMAND, EHCI_HC_IO_HCRESET);
+
+    /* Allocate the model thread stack.  */
+    hcd_ehci_model -> ux_hcd_ehci_model_thread_stack =
+            _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_HCD_EHCI_MODEL_THREAD_STACK_SIZE);
+    if (hcd_ehci_model -> ux_hcd_ehci_model_thread_stack == UX_NULL)
+    {
+        _ux_host_semaphore_delete(&hcd_ehci_model -> ux_hcd_ehci_model_semaphore);
+        _ux_utility_memory_free(hcd_ehci_model);
+        return(UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* Create the model thread. It runs the schedule while the controller is running.  */
+    status =  _ux_host_thread_create(&hcd_ehci_model -> ux_hcd_ehci_model_thread, "ux_hcd_ehci_model_thread",
+                _ux_hcd_ehci_model_thread_entry, (ULONG) (ALIGN_TYPE) hcd_ehci_model,
+                hcd_ehci_model -> ux_hcd_ehci_model_thread_stack, UX_HCD_EHCI_MODEL_THREAD_STACK_SIZE,
+                UX_HCD_EHCI_MODEL_THREAD_PRIORITY, UX_HCD_EHCI_MODEL_THREAD_PRIORITY,
+                UX_NO_TIME_SLICE, UX_AUTO_START);
+    if (status != UX_SUCCESS)
+    {
+        _ux_utility_memory_free(hcd_ehci_model -> ux_hcd_ehci_model_thread_stack);
+        _ux_host_semaphore_delete(&hcd_ehci_model -> ux_hcd_ehci_model_semaphore);
+        _ux_utility_memory_free(hcd_ehci_model);
+        return(UX_THREAD_ERROR);
+    }
+
+    UX_THREAD_EXTENSION_PTR_SET(&(hcd_ehci_model -> ux_hcd_ehci_model_thread), hcd_ehci_model)
+
+    /* The registers of the model are the registers the driver accesses.  */
+    hcd -> ux_hcd_io =  (ULONG) (ALIGN_TYPE) hcd_ehci_model;
+
+    /* Initialize the EHCI driver on the model.  */
+    status =  _ux_hcd_ehci_initialize(hcd);
+    if (status != UX_SUCCESS)
+    {
+        _ux_host_thread_delete(&hcd_ehci_model -> ux_hcd_ehci_model_thread);
+        _ux_utility_memory_free(hcd_ehci_model -> ux_hcd_ehci_model_thread_stack);
+        _ux_host_semaphore_delete(&hcd_ehci_model -> ux_hcd_ehci_model_semaphore);
+        _ux_utility_memory_free(hcd_ehci_model);
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
@@ -0,0 +1,113 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_port_reset                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function resets the simulated device attached to the port of   */
+/*    the software EHCI controller model, at the end of the port reset.   */
+/*    The device is connected at high speed when it has a high speed      */
+/*    framework.                                                          */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_dcd_sim_slave_initialize_complete Complete device initialization*/
+/*    _ux_device_stack_disconnect           Disconnect device             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_model_port_reset(UX_HCD_EHCI_MODEL *hcd_ehci_model)
+{
+
+UX_SLAVE_DEVICE     *device;
+
+
+    UX_PARAMETER_NOT_USED(hcd_ehci_model);
+
+    /* There may be no device side.  */
+    if (_ux_system_slave == UX_NULL)
+        return;
+
+    /* The EHCI port is a high speed port.  */
+    if (_ux_system_slave -> ux_system_slave_device_framework_length_high_speed != 0)
+        _ux_system_slave -> ux_system_slave_speed =  UX_HIGH_SPEED_DEVICE;
+
+    /* Get a pointer to the device.  */
+    device =  &_ux_system_slave -> ux_system_slave_device;
+
+    /* Is this a connection?  */
+    if (device -> ux_slave_device_state == UX_DEVICE_RESET)
+
+        /* Complete the device initialization.  */
+        _ux_dcd_sim_slave_initialize_complete();
+
+    else
+    {
+
+        /* The device goes back to the default state.  */
+        _ux_device_stack_disconnect();
+        _ux_dcd_sim_slave_initialize_complete();
+    }
+
+    /* In either case, mark the device as default/attached now.  */
+    device -> ux_slave_device_state =  UX_DEVICE_ATTACHED;
+}
+#endif
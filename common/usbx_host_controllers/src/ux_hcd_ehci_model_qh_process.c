@@ -0,0 +1,113 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_qh_process                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes the qTDs of a QH in the software EHCI        */
+/*    controller model. It stops when the queue is empty or halted, when  */
+/*    the device NAKs, or when a qTD moved data but is not complete yet.  */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*    qh                                    Pointer to QH                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if a transfer progressed                                    */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_td_process         Execute qTD                   */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ehci_model_qh_process(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh)
+{
+
+UX_EHCI_TD              *td;
+UX_EHCI_LINK_POINTER    lp;
+ULONG                   result;
+ULONG                   progress;
+ULONG                   passes;
+
+
+    progress =  UX_FALSE;
+    for (passes = 0; passes < UX_HCD_EHCI_MODEL_TD_PASSES_MAX; passes ++)
+    {
+
+        /* Is there a qTD in the queue?  */
+        lp.td_ptr =  qh -> ux_ehci_ed_queue_element;
+        if (lp.value & UX_EHCI_TD_T)
+            break;
+
+        /* A qTD not active here is halted, the driver cleans the queue.  */
+        td =  _ux_utility_virtual_address(lp.void_ptr);
+        if ((td -> ux_ehci_td_control & UX_EHCI_TD_ACTIVE) == 0)
+            break;
+
+        /* Execute the qTD.  */
+        result =  _ux_hcd_ehci_model_td_process(hcd_ehci_model, qh, td);
+        if (result == UX_HCD_EHCI_MODEL_TD_NAK)
+            break;
+        progress =  UX_TRUE;
+
+        /* The device must queue more data for this qTD.  */
+        if (result == UX_HCD_EHCI_MODEL_TD_PROGRESS)
+            break;
+    }
+
+    /* Return if a transfer progressed.  */
+    return(progress);
+}
+#endif
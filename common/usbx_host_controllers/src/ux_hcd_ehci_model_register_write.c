@@ -0,0 +1,180 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_register_write                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function writes a register of the software EHCI controller     */
+/*    model and applies the side effects the controller has on the write: */
+/*    host controller reset, run/stop and schedule enable status, write 1 */
+/*    to clear status bits and the port reset sequence. A write to the    */
+/*    command or port registers wakes up the model thread.                */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*    ehci_register                         Register to write             */
+/*    value                                 Value to write                */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_port_reset         Reset device on port          */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Driver                                              */
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_model_register_write(UX_HCD_EHCI_MODEL *hcd_ehci_model, ULONG ehci_register, ULONG value)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG       *registers;
+ULONG       status;
+ULONG       port_reset_done;
+
+
+    /* Writes to registers the model does not implement are ignored.  */
+    if (ehci_register >= UX_HCD_EHCI_MODEL_REGISTERS)
+        return;
+
+    /* Get the registers of the model.  */
+    registers =  hcd_ehci_model -> ux_hcd_ehci_model_registers;
+    port_reset_done =  UX_FALSE;
+
+    UX_DISABLE
+
+    switch (ehci_register)
+    {
+
+    case UX_HCD_EHCI_MODEL_USB_COMMAND:
+
+        /* The host controller reset sets the operational registers to their default values.
+           The device stays attached to the port.  */
+        if (value & EHCI_HC_IO_HCRESET)
+        {
+            _ux_utility_memory_set(&registers[UX_HCD_EHCI_MODEL_HCOR], 0,
+                        (UX_HCD_EHCI_MODEL_REGISTERS - UX_HCD_EHCI_MODEL_HCOR) * sizeof(ULONG)); /* Use case of memset is verified. */
+            registers[UX_HCD_EHCI_MODEL_USB_STATUS] =  EHCI_HC_STS_HC_HALTED;
+            registers[UX_HCD_EHCI_MODEL_PORT_SC] =  EHCI_HC_PS_CCS | EHCI_HC_PS_CSC;
+            break;
+        }
+
+        /* The status reflects the run/stop and the schedule enable bits.  */
+        status =  registers[UX_HCD_EHCI_MODEL_USB_STATUS];
+        status &= ~(EHCI_HC_STS_HC_HALTED | EHCI_HC_STS_PSS | EHCI_HC_STS_ASS);
+        if ((value & EHCI_HC_IO_RS) == 0)
+            status |=  EHCI_HC_STS_HC_HALTED;
+        if (value & EHCI_HC_IO_PSE)
+            status |=  EHCI_HC_STS_PSS;
+        if (value & EHCI_HC_IO_ASE)
+            status |=  EHCI_HC_STS_ASS;
+        registers[UX_HCD_EHCI_MODEL_USB_STATUS] =  status;
+        registers[UX_HCD_EHCI_MODEL_USB_COMMAND] =  value;
+        break;
+
+    case UX_HCD_EHCI_MODEL_USB_STATUS:
+
+        /* The interrupt status bits are cleared by writing 1.  */
+        registers[UX_HCD_EHCI_MODEL_USB_STATUS] &= ~(value & UX_HCD_EHCI_MODEL_STS_CLEAR_MASK);
+        break;
+
+    case UX_HCD_EHCI_MODEL_FRAME_INDEX:
+
+        registers[UX_HCD_EHCI_MODEL_FRAME_INDEX] =  value & UX_HCD_EHCI_MODEL_FRAME_INDEX_MASK;
+        break;
+
+    case UX_HCD_EHCI_MODEL_PORT_SC:
+
+        /* The change bits are cleared by writing 1, the port can only be disabled by software.  */
+        status =  registers[UX_HCD_EHCI_MODEL_PORT_SC];
+        status &= ~(value & UX_HCD_EHCI_MODEL_PS_CLEAR_MASK);
+        if ((value & EHCI_HC_PS_PE) == 0)
+            status &= ~EHCI_HC_PS_PE;
+
+        /* Starting the reset disables the port, ending it with the device connected
+           enables the port and resets the device.  */
+        if ((value & EHCI_HC_PS_PR) && ((status & EHCI_HC_PS_PR) == 0))
+            status &= ~EHCI_HC_PS_PE;
+        else if (((value & EHCI_HC_PS_PR) == 0) && (status & EHCI_HC_PS_PR) && (status & EHCI_HC_PS_CCS))
+        {
+            status |=  EHCI_HC_PS_PE;
+            port_reset_done =  UX_TRUE;
+        }
+
+        /* Update the bits the software controls.  */
+        status &= ~UX_HCD_EHCI_MODEL_PS_WRITE_MASK;
+        status |=  value & UX_HCD_EHCI_MODEL_PS_WRITE_MASK;
+        registers[UX_HCD_EHCI_MODEL_PORT_SC] =  status;
+        break;
+
+    default:
+
+        registers[ehci_register] =  value;
+        break;
+    }
+
+    UX_RESTORE
+
+    /* The device sees the reset at the end of the port reset.  */
+    if (port_reset_done)
+        _ux_hcd_ehci_model_port_reset(hcd_ehci_model);
+
+    /* Let the model thread see the new command or port state.  */
+    if ((ehci_register == UX_HCD_EHCI_MODEL_USB_COMMAND) || (ehci_register == UX_HCD_EHCI_MODEL_PORT_SC))
+        _ux_host_semaphore_put(&hcd_ehci_model -> ux_hcd_ehci_model_semaphore);
+}
+#endif
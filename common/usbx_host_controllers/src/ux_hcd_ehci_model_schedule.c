@@ -0,0 +1,204 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_schedule                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes one pass of the schedule in the software     */
+/*    EHCI controller model. A pass is one frame: the frame index moves   */
+/*    by 8 micro-frames, the QHs linked in the current periodic frame list*/
+/*    entry are executed and then the QHs of the asynchronous ring. The   */
+/*    doorbell is answered at the end of the pass, and the EHCI interrupt */
+/*    handler is called if an enabled interrupt is pending.               */
+/*                                                                        */
+/*    Isochronous iTDs and siTDs are skipped, they are not modeled.       */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if a transfer progressed                                    */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_interrupt_handler        EHCI interrupt handler        */
+/*    _ux_hcd_ehci_model_qh_process         Execute QH                    */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ehci_model_schedule(UX_HCD_EHCI_MODEL *hcd_ehci_model)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG                   *registers;
+ULONG                   *frame_list;
+UX_EHCI_ED              *qh;
+UX_EHCI_ED              *asynch_head;
+UX_EHCI_LINK_POINTER    lp;
+ULONG                   command;
+ULONG                   frame_list_size;
+ULONG                   frame_index;
+ULONG                   progress;
+ULONG                   links;
+
+
+    /* Get the registers of the model.  */
+    registers =  hcd_ehci_model -> ux_hcd_ehci_model_registers;
+    command =  registers[UX_HCD_EHCI_MODEL_USB_COMMAND];
+    progress =  UX_FALSE;
+
+    /* A pass is one frame.  */
+    UX_DISABLE
+    frame_index =  registers[UX_HCD_EHCI_MODEL_FRAME_INDEX] + UX_HCD_EHCI_MODEL_FRAME_INDEX_FRAME;
+    frame_index &= UX_HCD_EHCI_MODEL_FRAME_INDEX_MASK;
+    registers[UX_HCD_EHCI_MODEL_FRAME_INDEX] =  frame_index;
+    UX_RESTORE
+    hcd_ehci_model -> ux_hcd_ehci_model_frames ++;
+
+    /* Execute the periodic schedule of the frame.  */
+    if (command & EHCI_HC_IO_PSE)
+    {
+
+        /* Get the size of the frame list.  */
+        frame_list_size =  1024u >> ((command & EHCI_HC_IO_FRAME_SIZE_128) >> 2);
+        if (command & EHCI_HC_IO_FRAME_SIZE_64)
+            frame_list_size >>= 4;
+
+        /* Get the entry of the frame.  */
+        lp.value =  registers[UX_HCD_EHCI_MODEL_FRAME_LIST_BASE_ADDRESS];
+        frame_list =  _ux_utility_virtual_address(lp.void_ptr);
+        lp.value =  frame_list[(frame_index >> 3) & (frame_list_size - 1)];
+
+        /* Walk the links of the frame.  */
+        for (links = 0; (links < UX_HCD_EHCI_MODEL_LINKS_MAX) && ((lp.value & UX_EHCI_T) == 0); links ++)
+        {
+
+            switch (lp.value & UX_EHCI_TYP_MASK)
+            {
+
+            case UX_EHCI_TYP_QH:
+
+                /* Execute the QH and go on with the QH it links to.  */
+                lp.value &=  UX_EHCI_LP_MASK;
+                qh =  _ux_utility_virtual_address(lp.void_ptr);
+                if (_ux_hcd_ehci_model_qh_process(hcd_ehci_model, qh))
+                    progress =  UX_TRUE;
+                lp.ed_ptr =  qh -> ux_ehci_ed_queue_head;
+                break;
+
+            case UX_EHCI_TYP_ITD:
+            case UX_EHCI_TYP_SITD:
+
+                /* Isochronous descriptors are not executed, their link is their first DWord.  */
+                lp.value &=  UX_EHCI_LP_MASK;
+                lp.u32_ptr =  _ux_utility_virtual_address(lp.void_ptr);
+                lp.value =  *lp.u32_ptr;
+                break;
+
+            default:
+
+                /* Frame span traversal nodes end the frame.  */
+                lp.value =  UX_EHCI_T;
+                break;
+            }
+        }
+    }
+
+    /* Execute the asynchronous schedule, once round the ring.  */
+    if (command & EHCI_HC_IO_ASE)
+    {
+
+        lp.value =  registers[UX_HCD_EHCI_MODEL_ASYNCH_LIST_ADDRESS] & UX_EHCI_LP_MASK;
+        asynch_head =  _ux_utility_virtual_address(lp.void_ptr);
+        qh =  asynch_head;
+        for (links = 0; links < UX_HCD_EHCI_MODEL_LINKS_MAX; links ++)
+        {
+
+            /* Execute the QH.  */
+            if (_ux_hcd_ehci_model_qh_process(hcd_ehci_model, qh))
+                progress =  UX_TRUE;
+
+            /* Next QH of the ring, stop when back to the head.  */
+            lp.ed_ptr =  qh -> ux_ehci_ed_queue_head;
+            if (lp.value & UX_EHCI_T)
+                break;
+            lp.value &=  UX_EHCI_LP_MASK;
+            qh =  _ux_utility_virtual_address(lp.void_ptr);
+            if (qh == asynch_head)
+                break;
+        }
+    }
+
+    /* The QHs unlinked before the doorbell are no longer in use after the pass.  */
+    if (command & EHCI_HC_IO_IAAD)
+    {
+        UX_DISABLE
+        registers[UX_HCD_EHCI_MODEL_USB_COMMAND] &= ~EHCI_HC_IO_IAAD;
+        registers[UX_HCD_EHCI_MODEL_USB_STATUS] |=  EHCI_HC_STS_IAA;
+        UX_RESTORE
+        hcd_ehci_model -> ux_hcd_ehci_model_doorbells ++;
+    }
+
+    /* Raise the interrupt if an enabled interrupt is pending.  */
+    if (registers[UX_HCD_EHCI_MODEL_USB_STATUS] & registers[UX_HCD_EHCI_MODEL_USB_INTERRUPT] & UX_HCD_EHCI_MODEL_STS_CLEAR_MASK)
+    {
+        hcd_ehci_model -> ux_hcd_ehci_model_interrupts ++;
+        _ux_hcd_ehci_interrupt_handler();
+    }
+
+    /* Return if a transfer progressed.  */
+    return(progress);
+}
+#endif
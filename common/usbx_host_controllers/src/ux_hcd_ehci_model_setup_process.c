@@ -0,0 +1,193 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_setup_process                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes a SETUP qTD with the device simulator in     */
+/*    the software EHCI controller model. The setup packet goes to the    */
+/*    control endpoint of the device. If the request has an OUT data      */
+/*    stage, the data of the qTDs that follow is passed to the device     */
+/*    before the request is processed, like the host simulator does.      */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*    qh                                    Pointer to QH                 */
+/*    td                                    Pointer to SETUP qTD          */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_HCD_EHCI_MODEL_TD_NAK or _RETIRED                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_device_stack_control_request_processProcess control request     */
+/*    _ux_hcd_ehci_model_td_data_copy       Copy qTD data                 */
+/*    _ux_hcd_ehci_model_td_retire          Retire qTD                    */
+/*    _ux_system_error_handler              Log error                     */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ehci_model_setup_process(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh, UX_EHCI_TD *td)
+{
+
+UX_SLAVE_DCD            *dcd;
+UX_DCD_SIM_SLAVE        *dcd_sim_slave;
+UX_DCD_SIM_SLAVE_ED     *slave_ed;
+UX_SLAVE_TRANSFER       *slave_transfer_request;
+UX_EHCI_TD              *data_td;
+UX_EHCI_LINK_POINTER    lp;
+ULONG                   transaction_length;
+ULONG                   td_length;
+ULONG                   device_address;
+
+
+    /* The device does not answer until it is ready.  */
+    if (_ux_system_slave == UX_NULL)
+        return(UX_HCD_EHCI_MODEL_TD_NAK);
+    dcd =  &_ux_system_slave -> ux_system_slave_dcd;
+    if (dcd -> ux_slave_dcd_status != UX_DCD_STATUS_OPERATIONAL)
+        return(UX_HCD_EHCI_MODEL_TD_NAK);
+
+    /* Get the control endpoint of the device.  */
+    dcd_sim_slave =  (UX_DCD_SIM_SLAVE *) dcd -> ux_slave_dcd_controller_hardware;
+    slave_ed =  &dcd_sim_slave -> ux_dcd_sim_slave_ed[0];
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_USED) == 0)
+    {
+        _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, td, UX_EHCI_TD_HALTED | UX_EHCI_TD_TRANSACTION_ERROR);
+        return(UX_HCD_EHCI_MODEL_TD_RETIRED);
+    }
+    slave_transfer_request =  &slave_ed -> ux_sim_slave_ed_endpoint -> ux_slave_endpoint_transfer_request;
+
+    /* For control transfer, stall is for protocol error and it's cleared any time when SETUP is received.  */
+    slave_ed -> ux_sim_slave_ed_status &= ~(ULONG)UX_DCD_SIM_SLAVE_ED_STATUS_STALLED;
+
+    /* Reset actual data length (not including SETUP received) so far.  */
+    slave_transfer_request -> ux_slave_transfer_request_actual_length =  0;
+
+    /* Move the setup packet from the qTD to the device, the SETUP stage never fails.  */
+    _ux_hcd_ehci_model_td_data_copy(td, slave_transfer_request -> ux_slave_transfer_request_setup,
+                                    UX_SETUP_SIZE, UX_EHCI_PID_SETUP);
+    td -> ux_ehci_td_control &= ~((ULONG)UX_EHCI_TD_LG_MASK << UX_EHCI_TD_LG_LOC);
+    hcd_ehci_model -> ux_hcd_ehci_model_bytes +=  UX_SETUP_SIZE;
+    _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, td, 0);
+
+    /* Check if the transaction is OUT from the host and there is data payload.  */
+    transaction_length =  _ux_utility_short_get(slave_transfer_request -> ux_slave_transfer_request_setup + UX_SETUP_LENGTH);
+    if (((*slave_transfer_request -> ux_slave_transfer_request_setup & UX_REQUEST_IN) == 0) && (transaction_length != 0))
+    {
+
+        /* Avoid buffer overflow.  */
+        if (transaction_length > UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH)
+        {
+
+            /* Error trap.  */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_DCD, UX_TRANSFER_BUFFER_OVERFLOW);
+            transaction_length =  UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH;
+        }
+
+        /* The data goes to the beginning of the control buffer.  */
+        slave_transfer_request -> ux_slave_transfer_request_requested_length =  transaction_length;
+        slave_transfer_request -> ux_slave_transfer_request_current_data_pointer =  slave_transfer_request -> ux_slave_transfer_request_data_pointer;
+
+        /* It may take multiple qTDs to send all the data.  */
+        lp.td_ptr =  qh -> ux_ehci_ed_queue_element;
+        while ((transaction_length != 0) && ((lp.value & UX_EHCI_TD_T) == 0))
+        {
+
+            /* The data stage qTDs follow the SETUP qTD.  */
+            data_td =  _ux_utility_virtual_address(lp.void_ptr);
+            if (((data_td -> ux_ehci_td_control & UX_EHCI_TD_ACTIVE) == 0) ||
+                ((data_td -> ux_ehci_td_control & UX_EHCI_PID_MASK) != UX_EHCI_PID_OUT))
+                break;
+
+            /* Copy the data of the qTD into the device buffer.  */
+            td_length =  (data_td -> ux_ehci_td_control >> UX_EHCI_TD_LG_LOC) & UX_EHCI_TD_LG_MASK;
+            td_length =  UX_MIN(td_length, transaction_length);
+            _ux_hcd_ehci_model_td_data_copy(data_td, slave_transfer_request -> ux_slave_transfer_request_current_data_pointer,
+                                            td_length, UX_EHCI_PID_OUT);
+            slave_transfer_request -> ux_slave_transfer_request_current_data_pointer +=  td_length;
+            slave_transfer_request -> ux_slave_transfer_request_actual_length +=  td_length;
+            transaction_length -=  td_length;
+            hcd_ehci_model -> ux_hcd_ehci_model_bytes +=  td_length;
+
+            /* The qTD is done.  */
+            data_td -> ux_ehci_td_control -=  td_length << UX_EHCI_TD_LG_LOC;
+            _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, data_td, 0);
+            lp.td_ptr =  qh -> ux_ehci_ed_queue_element;
+        }
+    }
+
+    /* Is this meant for the device itself? Before the device is addressed its address
+       may be invalid, the request is for the device then.  */
+    device_address =  qh -> ux_ehci_ed_cap0 & UX_EHCI_DEVICE_ADDRESS_MASK;
+    if ((dcd_sim_slave -> ux_dcd_sim_slave_dcd_control_request_process_hub == UX_NULL) ||
+        (_ux_system_slave -> ux_system_slave_device.ux_slave_device_state == UX_DEVICE_RESET) ||
+        (_ux_system_slave -> ux_system_slave_device.ux_slave_device_state == UX_DEVICE_ATTACHED) ||
+        (device_address == dcd -> ux_slave_dcd_device_address))
+
+        /* Pass the transfer to the regular device stack.  */
+        _ux_device_stack_control_request_process(slave_transfer_request);
+
+    else
+
+        /* This control transfer is meant for a device on the hub.  */
+        dcd_sim_slave -> ux_dcd_sim_slave_dcd_control_request_process_hub(slave_transfer_request);
+
+    /* The SETUP qTD is retired.  */
+    return(UX_HCD_EHCI_MODEL_TD_RETIRED);
+}
+#endif
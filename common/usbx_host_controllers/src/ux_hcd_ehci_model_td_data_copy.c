@@ -0,0 +1,134 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_td_data_copy                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function copies data to or from the buffer pages of a qTD in   */
+/*    the software EHCI controller model. The copy starts at the current  */
+/*    page and offset of the qTD, both are updated after the copy like    */
+/*    the controller updates them in the qTD.                             */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    td                                    Pointer to qTD                */
+/*    data_pointer                          Pointer to data               */
+/*    length                                Length to copy                */
+/*    direction                             Direction of the copy         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_model_td_data_copy(UX_EHCI_TD *td, UCHAR *data_pointer, ULONG length, ULONG direction)
+{
+
+VOID                *pages[UX_HCD_EHCI_MODEL_TD_PAGES];
+UX_EHCI_POINTER     bp;
+UCHAR               *buffer;
+ULONG               page;
+ULONG               offset;
+ULONG               copy_length;
+
+
+    /* Get the buffer pages of the qTD.  */
+    pages[0] =  td -> ux_ehci_td_bp0;
+    pages[1] =  td -> ux_ehci_td_bp1;
+    pages[2] =  td -> ux_ehci_td_bp2;
+    pages[3] =  td -> ux_ehci_td_bp3;
+    pages[4] =  td -> ux_ehci_td_bp4;
+
+    /* Get the current page and the current offset.  */
+    page =  (td -> ux_ehci_td_control >> UX_HCD_EHCI_MODEL_TD_C_PAGE_LOC) & UX_HCD_EHCI_MODEL_TD_C_PAGE_MASK;
+    bp.void_ptr =  pages[0];
+    offset =  bp.value & UX_HCD_EHCI_MODEL_TD_OFFSET_MASK;
+
+    while ((length != 0) && (page < UX_HCD_EHCI_MODEL_TD_PAGES))
+    {
+
+        /* Get the buffer address in the current page.  */
+        bp.void_ptr =  pages[page];
+        bp.value &=  UX_EHCI_BP_MASK;
+        buffer =  (UCHAR *) _ux_utility_virtual_address(bp.void_ptr) + offset;
+
+        /* Copy up to the end of the page.  */
+        copy_length =  UX_MIN(length, UX_EHCI_PAGE_SIZE - offset);
+        if (direction == UX_EHCI_PID_IN)
+            _ux_utility_memory_copy(buffer, data_pointer, copy_length); /* Use case of memcpy is verified. */
+        else
+            _ux_utility_memory_copy(data_pointer, buffer, copy_length); /* Use case of memcpy is verified. */
+        data_pointer +=  copy_length;
+        length -=  copy_length;
+
+        /* Move on in the page, or to the next page.  */
+        offset +=  copy_length;
+        if (offset == UX_EHCI_PAGE_SIZE)
+        {
+            offset =  0;
+            page ++;
+        }
+    }
+
+    /* Update the current offset and the current page.  */
+    bp.void_ptr =  td -> ux_ehci_td_bp0;
+    bp.value =  (bp.value & UX_EHCI_BP_MASK) | offset;
+    td -> ux_ehci_td_bp0 =  bp.void_ptr;
+    td -> ux_ehci_td_control &= ~(UX_HCD_EHCI_MODEL_TD_C_PAGE_MASK << UX_HCD_EHCI_MODEL_TD_C_PAGE_LOC);
+    td -> ux_ehci_td_control |=  page << UX_HCD_EHCI_MODEL_TD_C_PAGE_LOC;
+}
+#endif
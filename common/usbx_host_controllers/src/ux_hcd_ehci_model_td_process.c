@@ -0,0 +1,249 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_td_process                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes an IN or OUT qTD with the device simulator   */
+/*    in the software EHCI controller model. The data moves between the   */
+/*    qTD buffer pages and the device transfer request the way the host   */
+/*    simulator moves it. A qTD without data on the control endpoint is   */
+/*    the status stage. A SETUP qTD is passed to                          */
+/*    _ux_hcd_ehci_model_setup_process.                                   */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*    qh                                    Pointer to QH                 */
+/*    td                                    Pointer to qTD                */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_HCD_EHCI_MODEL_TD_NAK, _PROGRESS or _RETIRED                     */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_device_semaphore_put              Put semaphore                 */
+/*    _ux_hcd_ehci_model_setup_process      Execute SETUP qTD             */
+/*    _ux_hcd_ehci_model_td_data_copy       Copy qTD data                 */
+/*    _ux_hcd_ehci_model_td_retire          Retire qTD                    */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ehci_model_td_process(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh, UX_EHCI_TD *td)
+{
+
+UX_SLAVE_DCD            *dcd;
+UX_DCD_SIM_SLAVE        *dcd_sim_slave;
+UX_DCD_SIM_SLAVE_ED     *slave_ed;
+UX_SLAVE_ENDPOINT       *slave_endpoint;
+UX_SLAVE_TRANSFER       *slave_transfer_request;
+ULONG                   pid;
+ULONG                   endpoint_index;
+ULONG                   td_length;
+ULONG                   slave_transfer_remaining;
+ULONG                   transaction_length;
+UCHAR                   wake_host;
+UCHAR                   wake_slave;
+
+
+    /* The SETUP stage is handled apart.  */
+    pid =  td -> ux_ehci_td_control & UX_EHCI_PID_MASK;
+    if (pid == UX_EHCI_PID_SETUP)
+        return(_ux_hcd_ehci_model_setup_process(hcd_ehci_model, qh, td));
+
+    /* The device does not answer until it is ready.  */
+    if (_ux_system_slave == UX_NULL)
+        return(UX_HCD_EHCI_MODEL_TD_NAK);
+    dcd =  &_ux_system_slave -> ux_system_slave_dcd;
+    if (dcd -> ux_slave_dcd_status != UX_DCD_STATUS_OPERATIONAL)
+        return(UX_HCD_EHCI_MODEL_TD_NAK);
+
+    /* Get the endpoint as seen from the device side.  */
+    endpoint_index =  (qh -> ux_ehci_ed_cap0 & UX_EHCI_ENDPT_MASK) >> UX_EHCI_ENDPT_SHIFT;
+    dcd_sim_slave =  (UX_DCD_SIM_SLAVE *) dcd -> ux_slave_dcd_controller_hardware;
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    slave_ed =  ((endpoint_index != 0) && (pid == UX_EHCI_PID_IN)) ?
+                    &dcd_sim_slave -> ux_dcd_sim_slave_ed_in[endpoint_index] :
+                    &dcd_sim_slave -> ux_dcd_sim_slave_ed[endpoint_index];
+#else
+    slave_ed =  &dcd_sim_slave -> ux_dcd_sim_slave_ed[endpoint_index];
+#endif
+
+    /* No answer from an endpoint the device does not have.  */
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_USED) == 0)
+    {
+        _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, td, UX_EHCI_TD_HALTED | UX_EHCI_TD_TRANSACTION_ERROR);
+        return(UX_HCD_EHCI_MODEL_TD_RETIRED);
+    }
+
+    /* The device stalls the transaction.  */
+    if (slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_STALLED)
+    {
+        _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, td, UX_EHCI_TD_HALTED);
+        return(UX_HCD_EHCI_MODEL_TD_RETIRED);
+    }
+
+    /* Get the length left in the qTD.  */
+    td_length =  (td -> ux_ehci_td_control >> UX_EHCI_TD_LG_LOC) & UX_EHCI_TD_LG_MASK;
+
+    /* The status stage of a control transfer has no data, the request was
+       processed with the SETUP stage.  */
+    if ((endpoint_index == 0) && (td_length == 0))
+    {
+        _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, td, 0);
+        return(UX_HCD_EHCI_MODEL_TD_RETIRED);
+    }
+
+    /* The device NAKs until it has a transfer ready.  */
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER) == 0)
+    {
+        hcd_ehci_model -> ux_hcd_ehci_model_naks ++;
+        return(UX_HCD_EHCI_MODEL_TD_NAK);
+    }
+
+    /* Get the transfer request of the device.  */
+    slave_endpoint =  slave_ed -> ux_sim_slave_ed_endpoint;
+    slave_transfer_request =  &slave_endpoint -> ux_slave_endpoint_transfer_request;
+
+    /* If the device sends a NULL packet, nothing remains.  */
+    slave_transfer_remaining =  0;
+    if (slave_transfer_request -> ux_slave_transfer_request_requested_length != 0)
+        slave_transfer_remaining =  slave_transfer_request -> ux_slave_transfer_request_requested_length -
+                                    slave_transfer_request -> ux_slave_transfer_request_actual_length;
+
+    /* Get the transaction length to be transferred. It could be a ZLP condition.  */
+    transaction_length =  UX_MIN(slave_transfer_remaining, td_length);
+    if (transaction_length)
+        _ux_hcd_ehci_model_td_data_copy(td, slave_transfer_request -> ux_slave_transfer_request_current_data_pointer,
+                                        transaction_length, pid);
+
+    /* Update the device transfer request.  */
+    slave_transfer_request -> ux_slave_transfer_request_current_data_pointer +=  transaction_length;
+    slave_transfer_request -> ux_slave_transfer_request_actual_length +=  transaction_length;
+
+    /* Update the length left in the qTD.  */
+    td_length -=  transaction_length;
+    td -> ux_ehci_td_control &= ~((ULONG)UX_EHCI_TD_LG_MASK << UX_EHCI_TD_LG_LOC);
+    td -> ux_ehci_td_control |=  td_length << UX_EHCI_TD_LG_LOC;
+    hcd_ehci_model -> ux_hcd_ehci_model_bytes +=  transaction_length;
+
+    /* Reset wake booleans.  */
+    wake_host =  UX_FALSE;
+    wake_slave =  UX_FALSE;
+
+    if (slave_endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize == 0)
+    {
+
+        /* Only for tests with no max packet size on the control endpoint.  */
+        wake_host =  UX_TRUE;
+        wake_slave =  UX_TRUE;
+    }
+    else if ((transaction_length == 0) ||
+             (transaction_length % slave_endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize))
+    {
+
+        /* Host got ZLP or short packet.  */
+        wake_host =  UX_TRUE;
+        wake_slave =  UX_TRUE;
+    }
+    else
+    {
+
+        /* Is the qTD completed?  */
+        if (td_length == 0)
+            wake_host =  UX_TRUE;
+
+        /* Is the slaves's transfer completed?  */
+        if (slave_transfer_request -> ux_slave_transfer_request_actual_length ==
+            slave_transfer_request -> ux_slave_transfer_request_requested_length)
+        {
+            if (slave_transfer_request -> ux_slave_transfer_request_requested_length == 0 ||
+                slave_transfer_request -> ux_slave_transfer_request_force_zlp == 0)
+                wake_slave =  UX_TRUE;
+            else
+                slave_transfer_request -> ux_slave_transfer_request_force_zlp =  0;
+        }
+    }
+
+    if (wake_slave == UX_TRUE)
+    {
+
+        /* Set the completion code to no error.  */
+        slave_transfer_request -> ux_slave_transfer_request_completion_code =  UX_SUCCESS;
+
+        /* Set the transfer status to COMPLETED.  */
+        slave_transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
+
+        /* Is this not the control endpoint?  */
+        if (slave_ed -> ux_sim_slave_ed_index != 0)
+        {
+
+            /* Clear pending flag and set done flag.  */
+            slave_ed -> ux_sim_slave_ed_status &= ~(ULONG)UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
+            slave_ed -> ux_sim_slave_ed_status |=  UX_DCD_SIM_SLAVE_ED_STATUS_DONE;
+
+            /* Wake up the slave side.  */
+            _ux_device_semaphore_put(&slave_transfer_request -> ux_slave_transfer_request_semaphore);
+        }
+    }
+
+    /* The qTD is not complete until the host has all its data.  */
+    if (wake_host == UX_FALSE)
+        return(UX_HCD_EHCI_MODEL_TD_PROGRESS);
+
+    /* The qTD is complete, possibly short.  */
+    _ux_hcd_ehci_model_td_retire(hcd_ehci_model, qh, td, 0);
+    return(UX_HCD_EHCI_MODEL_TD_RETIRED);
+}
+#endif
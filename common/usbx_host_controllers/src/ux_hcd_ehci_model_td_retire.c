@@ -0,0 +1,122 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_td_retire                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function retires a qTD in the software EHCI controller model.  */
+/*    The QH queue advances to the next qTD, or to the alternate qTD on a */
+/*    short packet. A halted qTD stops the queue and raises the error     */
+/*    interrupt, a qTD with IOC raises the transfer interrupt. The qTD is */
+/*    made inactive last, so the driver sees the queue advanced.          */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model                        Pointer to EHCI model         */
+/*    qh                                    Pointer to QH                 */
+/*    td                                    Pointer to qTD                */
+/*    td_status                             Error status bits             */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_physical_address          Get physical address          */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    EHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_model_td_retire(UX_HCD_EHCI_MODEL *hcd_ehci_model, UX_EHCI_ED *qh, UX_EHCI_TD *td, ULONG td_status)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_EHCI_LINK_POINTER    lp;
+ULONG                   status;
+
+
+    /* The qTD is the current one of the QH.  */
+    qh -> ux_ehci_ed_current_td =  _ux_utility_physical_address(td);
+
+    if (td_status & UX_EHCI_TD_HALTED)
+
+        /* The queue stops on the halted qTD.  */
+        status =  EHCI_HC_STS_USB_ERR_INT;
+
+    else
+    {
+
+        /* The queue goes on with the next qTD, or with the alternate qTD on a short packet.  */
+        lp.td_ptr =  td -> ux_ehci_td_link_pointer;
+        if ((td -> ux_ehci_td_control & ((ULONG)UX_EHCI_TD_LG_MASK << UX_EHCI_TD_LG_LOC)) != 0)
+        {
+            lp.td_ptr =  td -> ux_ehci_td_alternate_link_pointer;
+            if (lp.value & UX_EHCI_TD_T)
+                lp.td_ptr =  td -> ux_ehci_td_link_pointer;
+        }
+        qh -> ux_ehci_ed_queue_element =  lp.td_ptr;
+
+        /* Interrupt on complete.  */
+        status =  (td -> ux_ehci_td_control & UX_EHCI_TD_IOC) ? EHCI_HC_STS_USB_INT : 0;
+    }
+
+    /* The qTD is done.  */
+    td -> ux_ehci_td_control &= ~UX_EHCI_TD_ACTIVE;
+    td -> ux_ehci_td_control |=  td_status;
+    hcd_ehci_model -> ux_hcd_ehci_model_transactions ++;
+
+    /* Set the interrupt status.  */
+    UX_DISABLE
+    hcd_ehci_model -> ux_hcd_ehci_model_registers[UX_HCD_EHCI_MODEL_USB_STATUS] |=  status;
+    UX_RESTORE
+}
+#endif
@@ -0,0 +1,104 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   EHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_thread_entry                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function is the entry of the software EHCI controller model    */
+/*    thread. While the controller runs, the thread executes a pass of the*/
+/*    schedule. After a pass without progress it waits for a register     */
+/*    write or the next tick, like the bus would go on with the next      */
+/*    frame.                                                              */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ehci_model_address                Address of EHCI model         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ehci_model_schedule           Execute schedule              */
+/*    _ux_host_semaphore_get                Get semaphore                 */
+/*    _ux_utility_thread_relinquish         Relinquish thread             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    ThreadX                                                             */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ehci_model_thread_entry(ULONG hcd_ehci_model_address)
+{
+
+UX_HCD_EHCI_MODEL       *hcd_ehci_model;
+ULONG                   progress;
+
+
+    /* Get the EHCI model instance.  */
+    UX_THREAD_EXTENSION_PTR_GET(hcd_ehci_model, UX_HCD_EHCI_MODEL, hcd_ehci_model_address)
+
+    /* Loop forever.  */
+    while (1)
+    {
+
+        /* Execute the schedule while the controller runs.  */
+        progress =  UX_FALSE;
+        if (hcd_ehci_model -> ux_hcd_ehci_model_registers[UX_HCD_EHCI_MODEL_USB_COMMAND] & EHCI_HC_IO_RS)
+            progress =  _ux_hcd_ehci_model_schedule(hcd_ehci_model);
+
+        /* Let the device and the driver serve the transfers that moved, or wait
+           for the next frame.  */
+        if (progress)
+            _ux_utility_thread_relinquish();
+        else
+            _ux_host_semaphore_get(&hcd_ehci_model -> ux_hcd_ehci_model_semaphore, UX_MS_TO_TICK_NON_ZERO(1));
+    }
+}
+#endif
@@ -26,6 +26,7 @@
 
 #include "ux_api.h"
 #include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
 #include "ux_host_stack.h"
 
 
@@ -34,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_register_write                         PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -68,13 +69,24 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added software controller   */
+/*                                            model,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ehci_register_write(UX_HCD_EHCI *hcd_ehci, ULONG ehci_register, ULONG value)
 {
 
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+    /* The registers are in the software controller model.  */
+    _ux_hcd_ehci_model_register_write((UX_HCD_EHCI_MODEL *) hcd_ehci -> ux_hcd_ehci_base, ehci_register, value);
+#else
+
     /* Write to the specified EHCI register.  */    
     *(hcd_ehci -> ux_hcd_ehci_base + ehci_register) =  value;
+#endif
 
     /* Return to caller.  */
     return;
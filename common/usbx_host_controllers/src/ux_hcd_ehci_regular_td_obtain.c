@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_regular_td_obtain                      PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,7 +54,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_utility_memory_set                Set memory block              */ 
-/*    _ux_host_mutex_on                     Get protection mutex          */
+/*    _ux_host_mutex_on_count               Get protection mutex          */
 /*    _ux_host_mutex_off                    Release protection mutex      */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -73,56 +73,46 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used TD list mutex,         */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_EHCI_TD  *_ux_hcd_ehci_regular_td_obtain(UX_HCD_EHCI *hcd_ehci)
 {
 
 UX_EHCI_TD      *td;
-ULONG           td_index;
 ULONG           td_element;
 
 
     /* Get the mutex as this is a critical section.  */
-    _ux_host_mutex_on(&_ux_system -> ux_system_mutex);
+    _ux_host_mutex_on_count(&hcd_ehci -> ux_hcd_ehci_td_mutex, &hcd_ehci -> ux_hcd_ehci_td_mutex_contentions);
 
-    /* Start the search from the beginning of the list.  */
-    td =  hcd_ehci -> ux_hcd_ehci_td_list;
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_td; td_index++)
-    {
+    /* Take the TD at the head of the free list.  */
+    td =  hcd_ehci -> ux_hcd_ehci_td_free_list;
+    if (td != UX_NULL)
+        hcd_ehci -> ux_hcd_ehci_td_free_list =  td -> ux_ehci_td_next_td_transfer_request;
 
-        /* Check the TD status, a free TD is marked with the USED flag.  */
-        if (td -> ux_ehci_td_status == UX_UNUSED)
-        {
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ehci -> ux_hcd_ehci_td_mutex);
 
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_TD)); /* Use case of memset is verified. */
-
-            /* This TD is now marked as USED.  */
-            td -> ux_ehci_td_status =  UX_USED;
-
-            /* Initialize the link pointer and alternate TD fields.  */
-            td_element =  UX_EHCI_TD_T;
-            td -> ux_ehci_td_link_pointer =  (UX_EHCI_TD *) td_element;
-            td -> ux_ehci_td_alternate_link_pointer =  (UX_EHCI_TD *) td_element;
-            
-            /* Release the protection.  */
-            _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
-
-            /* Success, return TD pointer.  */
-            return(td);
-        }
+    /* There is no available TD in the TD list.  */
+    if (td == UX_NULL)
+        return(UX_NULL);
 
-        /* Look at next TD.  */
-        td++;
-    }
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_EHCI_TD)); /* Use case of memset is verified. */
 
-    /* There is no available TD in the TD list.  */
+    /* This TD is now marked as USED.  */
+    td -> ux_ehci_td_status =  UX_USED;
 
-    /* Release protection.  */
-    _ux_host_mutex_off(&_ux_system -> ux_system_mutex);
+    /* Initialize the link pointer and alternate TD fields.  */
+    td_element =  UX_EHCI_TD_T;
+    td -> ux_ehci_td_link_pointer =  (UX_EHCI_TD *) td_element;
+    td -> ux_ehci_td_alternate_link_pointer =  (UX_EHCI_TD *) td_element;
 
-    /* Error, return a null.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 }
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_bulk_transfer                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -71,6 +71,10 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_bulk_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request)
@@ -85,6 +89,10 @@ ULONG           pid;
 ULONG           td_component;
 UINT            status;
 ULONG           zlp_flag;
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+UX_TRANSFER_SEGMENT *segment;
+ULONG           segment_count;
+#endif
 
 
     /* Get the pointer to the Endpoint.  */
@@ -110,6 +118,15 @@ ULONG           zlp_flag;
        in the endpoint descriptor). EHCI data payload has a maximum size of 16K.  */
     transfer_request_payload_length =  transfer_request -> ux_transfer_request_requested_length;
     data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+    /* A scatter-gather transfer starts with its first segment.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_count =  transfer_request -> ux_transfer_request_segment_count;
+    if (segment_count != 0)
+        transfer_request_payload_length =  segment -> ux_transfer_segment_length;
+#endif
     
     /* Check for ZLP condition.  */
     if (transfer_request_payload_length == 0)
@@ -149,6 +166,18 @@ ULONG           zlp_flag;
         /* Adjust the data payload length and the data payload pointer.  */
         transfer_request_payload_length -=  bulk_packet_payload_length;
         data_pointer +=  bulk_packet_payload_length;
+
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+        /* At the end of a segment, go on with the next one.  */
+        if ((transfer_request_payload_length == 0) && (segment_count > 1))
+        {
+            segment++;
+            segment_count--;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            transfer_request_payload_length =  segment -> ux_transfer_segment_length;
+        }
+#endif
     }        
 
     /* Set the IOC bit in the last TD.  */
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_request_control_transfer               PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,8 +64,6 @@
 /*    _ux_hcd_ehci_ed_clean                 Clean TDs                     */ 
 /*    _ux_hcd_ehci_request_transfer_add     Add transfer to ED            */ 
 /*    _ux_host_stack_transfer_request_abort Abort transfer request        */ 
-/*    _ux_utility_memory_allocate           Allocate memory block         */ 
-/*    _ux_utility_memory_free               Release memory block          */ 
 /*    _ux_host_semaphore_get                Get semaphore                 */ 
 /*    _ux_utility_short_put                 Write a 16-bit value          */ 
 /*                                                                        */ 
@@ -88,6 +86,13 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used setup buffer in ED     */
+/*                                            instead of allocating,      */
+/*                                            counted timeouts in         */
+/*                                            endpoint statistics,        */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ehci_request_control_transfer(UX_HCD_EHCI *hcd_ehci, UX_TRANSFER *transfer_request)
@@ -109,10 +114,10 @@ UINT            pid;
     /* Now get the physical ED attached to this endpoint.  */
     ed =  endpoint -> ux_endpoint_ed;
 
-    /* Build the SETUP packet (phase 1 of the control transfer).  */
-    setup_request =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_SETUP_SIZE);
-    if (setup_request == UX_NULL)
-        return(UX_MEMORY_INSUFFICIENT);
+    /* Build the SETUP packet (phase 1 of the control transfer), in the cache
+       safe ED memory since there is only one control transfer on the endpoint
+       at a time.  */
+    setup_request =  ed -> REF_AS.CONTROL.ux_ehci_ed_setup;
 
     *setup_request =                            (UCHAR)transfer_request -> ux_transfer_request_function;
     *(setup_request + UX_SETUP_REQUEST_TYPE) =  (UCHAR)transfer_request -> ux_transfer_request_type;
@@ -156,7 +161,7 @@ UINT            pid;
     {
 
         /* We need to clean the tds attached if any.  */
-        _ux_hcd_ehci_ed_clean(ed);
+        _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
         return(status);
     }
 
@@ -179,7 +184,7 @@ UINT            pid;
         {
 
             /* We need to clean the tds attached if any.  */
-            _ux_hcd_ehci_ed_clean(ed);
+            _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
             return(status);
         }
     }        
@@ -197,7 +202,7 @@ UINT            pid;
     {
 
         /* We need to clean the tds attached if any.  */
-        _ux_hcd_ehci_ed_clean(ed);
+        _ux_hcd_ehci_ed_clean(hcd_ehci, ed);
         return(status);
     }
 
@@ -225,6 +230,7 @@ UINT            pid;
         
         /* There was an error, return to the caller.  */
         transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+        UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
         /* Error trap. */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_TRANSFER_TIMEOUT);
@@ -234,9 +240,6 @@ UINT            pid;
         
     }            
 
-    /* Free the resources.  */
-    _ux_utility_memory_free(setup_request);
-
     /* Return completion status.  */
     return(transfer_request -> ux_transfer_request_completion_code);           
 }
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ehci_transfer_request_process               PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -75,11 +75,27 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ehci_transfer_request_process(UX_TRANSFER *transfer_request)
 {
 
+    /* If trace ring is enabled, insert this event into the ring.  */
+    UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+
+    /* Count the transfer completion in the endpoint statistics.  */
+    UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+    /* Start the next transfer queued on the endpoint.  */
+    UX_TRANSFER_QUEUE_NEXT(transfer_request);
+
     /* Check if there is a function for the transfer completion.  */ 
     if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
     
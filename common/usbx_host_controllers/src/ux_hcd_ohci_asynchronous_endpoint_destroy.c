@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_asynchronous_endpoint_destroy          PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,8 +55,10 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_ed_free                  Free ED                       */
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*    _ux_utility_delay_ms                  Delay ms                      */ 
 /*                                                                        */ 
@@ -76,6 +78,9 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed an addressing issue,  */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_asynchronous_endpoint_destroy(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint)
@@ -186,19 +191,19 @@ ULONG           ohci_register;
         /* Update the head TD with the next TD.  */
         ed -> ux_ohci_ed_head_td =  head_td -> ux_ohci_td_next_td;
 
-        /* Mark the current head TD as free.  */
-        head_td -> ux_ohci_td_status =  UX_UNUSED;
+        /* Free the current head TD.  */
+        _ux_hcd_ohci_regular_td_free(hcd_ohci, head_td);
 
         /* Now the new head TD is the next TD in the chain.  */
         head_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_head_td);
     }
 
     /* We need to free the dummy TD that was attached to the ED.  */
-    tail_td -> ux_ohci_td_status =  UX_UNUSED;
+    _ux_hcd_ohci_regular_td_free(hcd_ohci, tail_td);
 
 
     /* Now we can safely make the ED free.  */
-    ed -> ux_ohci_ed_status =  UX_UNUSED;
+    _ux_hcd_ohci_ed_free(hcd_ohci, ed);
 
     /* Return successful completion.  */
     return(UX_SUCCESS);         
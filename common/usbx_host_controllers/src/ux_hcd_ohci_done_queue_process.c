@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_done_queue_process                     PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_isochronous_td_free      Free isochronous TD           */
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    (ux_transfer_request_completion_function)                           */ 
 /*                                          Transfer completion function  */ 
 /*    _ux_hcd_ohci_endpoint_error_clear     Clear endpoint error          */ 
@@ -85,6 +87,15 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed an addressing issue,  */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added data cache            */
+/*                                            invalidation,               */
+/*                                            added trace ring events,    */
+/*                                            added endpoint statistics,  */
+/*                                            added endpoint transfer     */
+/*                                            queue,                      */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ohci_done_queue_process(UX_HCD_OHCI *hcd_ohci)
@@ -164,6 +175,11 @@ ULONG               current_frame;
                 {
 
                     transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
+                    UX_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
+                    UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                                transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                    UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+                    UX_TRANSFER_QUEUE_NEXT(transfer_request);
                     if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                         transfer_request -> ux_transfer_request_completion_function(transfer_request);
                     _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -190,7 +206,12 @@ ULONG               current_frame;
 
                 /* Either this is a non control endpoint or it is the status phase and we are done */
                 transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
+                UX_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+                UX_TRANSFER_QUEUE_NEXT(transfer_request);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -203,16 +224,23 @@ ULONG               current_frame;
                 /* A stall condition happens when the device refuses the requested command or when a 
                    parameter in the command is wrong. We retire the transfer_request and mark the error.  */
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_STALLED;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+                /* We need to reset the error bit in the ED.  */
+                _ux_hcd_ohci_endpoint_reset(hcd_ohci, endpoint);
+
+                /* The ED is clean, start the next transfer queued on the endpoint before
+                   the class is notified, a transfer it submits again is queued after.  */
+                UX_TRANSFER_QUEUE_NEXT(transfer_request);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
 
                 /* If trace is enabled, insert this event into the trace buffer.  */
                 UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_STALLED, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
-
-                /* We need to reset the error bit in the ED.  */
-                _ux_hcd_ohci_endpoint_reset(hcd_ohci, endpoint);
                 break;
 
 
@@ -222,16 +250,23 @@ ULONG               current_frame;
                    happens at the first GET_DESCRIPTOR after the port is enabled. This error has to be 
                    picked up by the enumeration module to reset the port and retry the command.  */ 
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_NO_ANSWER;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+                /* We need to reset the error bit in the ED */
+                _ux_hcd_ohci_endpoint_reset(hcd_ohci, endpoint);
+
+                /* The ED is clean, start the next transfer queued on the endpoint before
+                   the class is notified, a transfer it submits again is queued after.  */
+                UX_TRANSFER_QUEUE_NEXT(transfer_request);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
 
                 /* If trace is enabled, insert this event into the trace buffer.  */
                 UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_NO_ANSWER, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
-
-                /* We need to reset the error bit in the ED */
-                _ux_hcd_ohci_endpoint_reset(hcd_ohci, endpoint);
                 break;
 
                 
@@ -240,16 +275,23 @@ ULONG               current_frame;
                 /* Any other errors default to this section. The command has been repeated 3 times 
                    and there is still a problem. The endpoint probably should be reset.   */
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_ERROR;
-                _ux_hcd_ohci_next_td_clean(td);
+                _ux_hcd_ohci_next_td_clean(hcd_ohci, td);
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
+
+                /* We need to reset the error bit in the ED.  */
+                _ux_hcd_ohci_endpoint_reset(hcd_ohci, endpoint);
+
+                /* The ED is clean, start the next transfer queued on the endpoint before
+                   the class is notified, a transfer it submits again is queued after.  */
+                UX_TRANSFER_QUEUE_NEXT(transfer_request);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
                 _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
 
                 /* If trace is enabled, insert this event into the trace buffer.  */
                 UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_ERROR, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
-
-                /* We need to reset the error bit in the ED.  */
-                _ux_hcd_ohci_endpoint_reset(hcd_ohci, endpoint);
                 break;
             }
             break;
@@ -294,6 +336,10 @@ ULONG               current_frame;
                 {
 
                         transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
+                        UX_TRANSFER_DATA_CACHE_INVALIDATE(transfer_request);
+                        UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                                    transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                        UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
                         if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                             transfer_request -> ux_transfer_request_completion_function(transfer_request);
                         _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
@@ -306,6 +352,9 @@ ULONG               current_frame;
                 /* In this case, we have missed the frame for the isoch transfer.  */
                 _ux_hcd_ohci_frame_number_get(hcd_ohci, &current_frame);
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_MISSED_FRAME;
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
 
@@ -320,6 +369,9 @@ ULONG               current_frame;
 
                 /* Some other error happened, in isoch transfer, there is not much we can do.  */
                 transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_ERROR;
+                UX_TRACE_RING_HOST_TRANSFER_INSERT(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, transfer_request,
+                            transfer_request -> ux_transfer_request_completion_code, transfer_request -> ux_transfer_request_actual_length)
+                UX_TRANSFER_STATISTICS_COMPLETE(transfer_request);
                 if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
                     transfer_request -> ux_transfer_request_completion_function(transfer_request);
 
@@ -331,11 +383,17 @@ ULONG               current_frame;
             }
         }                
 
-        /* Free the TD that was just treated.  */
-        td -> ux_ohci_td_status =  UX_UNUSED;
+        /* Get the next TD before the TD that was just treated is freed.  */
+        next_td =  _ux_utility_virtual_address(td -> ux_ohci_td_next_td);
+
+        /* Free the TD that was just treated, isochronous TDs have their own list.  */
+        if (((endpoint -> ux_endpoint_descriptor.bmAttributes) & UX_MASK_ENDPOINT_TYPE) == UX_ISOCHRONOUS_ENDPOINT)
+            _ux_hcd_ohci_isochronous_td_free(hcd_ohci, (UX_OHCI_ISO_TD *) td);
+        else
+            _ux_hcd_ohci_regular_td_free(hcd_ohci, td);
 
         /* And continue the TD loop.  */
-        td =  _ux_utility_virtual_address(td -> ux_ohci_td_next_td);
+        td =  next_td;
     }
 
     /* The OHCI controller is now ready to receive the next done queue. We need to 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_ed_obtain                              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,6 +53,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_mutex_on_count               Get protection mutex          */
+/*    _ux_host_mutex_off                    Release protection mutex      */
 /*    _ux_utility_memory_set                Set memory block              */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -68,39 +70,39 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_OHCI_ED  *_ux_hcd_ohci_ed_obtain(UX_HCD_OHCI *hcd_ohci)
 {
 
 UX_OHCI_ED      *ed;
-ULONG           ed_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    ed =  hcd_ohci -> ux_hcd_ohci_ed_list;
-    for (ed_index = 0; ed_index < _ux_system_host -> ux_system_host_max_ed; ed_index++)
-    {
+    /* Get the mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_ohci -> ux_hcd_ohci_td_mutex, &hcd_ohci -> ux_hcd_ohci_td_mutex_contentions);
 
-        /* Check the ED status, a free ED is marked with the UNUSED flag.  */
-        if (ed -> ux_ohci_ed_status == UX_UNUSED)
-        {
+    /* Take the ED at the head of the free list.  */
+    ed =  hcd_ohci -> ux_hcd_ohci_ed_free_list;
+    if (ed != UX_NULL)
+        hcd_ohci -> ux_hcd_ohci_ed_free_list =  ed -> ux_ohci_ed_next_ed;
 
-            /* The ED may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(ed, 0, sizeof(UX_OHCI_ED)); /* Use case of memset is verified. */
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ohci -> ux_hcd_ohci_td_mutex);
 
-            /* This ED is now marked as USED.  */
-            ed -> ux_ohci_ed_status =  UX_USED;
+    /* There is no available ED in the ED list.  */
+    if (ed == UX_NULL)
+        return(UX_NULL);
 
-            /* Success, return the ED pointer.  */
-            return(ed);
-        }
- 
-        /* Point to the next ED.  */
-        ed++;
-    }
+    /* The ED may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(ed, 0, sizeof(UX_OHCI_ED)); /* Use case of memset is verified. */
 
-    /* There is no available ED in the ED list, return a NULL.  */
-    return(UX_NULL);
+    /* This ED is now marked as USED.  */
+    ed -> ux_ohci_ed_status =  UX_USED;
+
+    /* Success, return ED pointer.  */
+    return(ed);
 }
 
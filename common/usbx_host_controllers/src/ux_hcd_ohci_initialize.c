@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_initialize                             PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,7 @@
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
+/*    _ux_host_mutex_create                 Create mutex                  */
 /*    _ux_host_mutex_on                     Get mutex protection          */ 
 /*    _ux_host_mutex_off                    Release mutex protection      */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
@@ -87,6 +88,10 @@
 /*  07-29-2022     Yajun Xia                Modified comment(s),          */
 /*                                            fixed OHCI PRSC issue,      */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            created TD list mutex,      */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_initialize(UX_HCD *hcd)
@@ -95,6 +100,10 @@ UINT  _ux_hcd_ohci_initialize(UX_HCD *hcd)
 UX_HCD_OHCI     *hcd_ohci;
 ULONG           ohci_register;
 UINT            index_loop;
+ULONG           list_index;
+UX_OHCI_ED      *ed;
+UX_OHCI_TD      *td;
+UX_OHCI_ISO_TD  *iso_td;
 UINT            status;
 
 
@@ -127,6 +136,11 @@ UINT            status;
     /* Set the state of the controller to HALTED first.  */
     hcd -> ux_hcd_status =  UX_HCD_STATUS_HALTED;
 
+    /* Create the mutex protecting the TD list.  */
+    status =  _ux_host_mutex_create(&hcd_ohci -> ux_hcd_ohci_td_mutex, "ux_hcd_ohci_td_mutex");
+    if (status != UX_SUCCESS)
+        return(UX_MUTEX_ERROR);
+
     /* get an DMA safe address for the HCCA. This block of memory is to be aligned
        on 256 bytes.  */
     hcd_ohci -> ux_hcd_ohci_hcca =  _ux_utility_memory_allocate(UX_ALIGN_256, UX_CACHE_SAFE_MEMORY, sizeof(UX_HCD_OHCI_HCCA));
@@ -148,6 +162,26 @@ UINT            status;
     if (hcd_ohci -> ux_hcd_ohci_td_list == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
+    /* Put all the EDs and TDs in their free lists, from the first one to the last one.  */
+    for (list_index = _ux_system_host -> ux_system_host_max_ed; list_index != 0; list_index--)
+    {
+        ed =  hcd_ohci -> ux_hcd_ohci_ed_list + list_index - 1;
+        ed -> ux_ohci_ed_next_ed =  hcd_ohci -> ux_hcd_ohci_ed_free_list;
+        hcd_ohci -> ux_hcd_ohci_ed_free_list =  ed;
+    }
+    for (list_index = _ux_system_host -> ux_system_host_max_td; list_index != 0; list_index--)
+    {
+        td =  hcd_ohci -> ux_hcd_ohci_td_list + list_index - 1;
+        td -> ux_ohci_td_next_td_transfer_request =  hcd_ohci -> ux_hcd_ohci_td_free_list;
+        hcd_ohci -> ux_hcd_ohci_td_free_list =  td;
+    }
+    for (list_index = _ux_system_host -> ux_system_host_max_iso_td; list_index != 0; list_index--)
+    {
+        iso_td =  hcd_ohci -> ux_hcd_ohci_iso_td_list + list_index - 1;
+        iso_td -> ux_ohci_iso_td_next_td_transfer_request =  (UX_OHCI_TD *) hcd_ohci -> ux_hcd_ohci_iso_td_free_list;
+        hcd_ohci -> ux_hcd_ohci_iso_td_free_list =  iso_td;
+    }
+
     /* Initialize the periodic tree.  */
     status =  _ux_hcd_ohci_periodic_tree_create(hcd_ohci);
     if (status != UX_SUCCESS)
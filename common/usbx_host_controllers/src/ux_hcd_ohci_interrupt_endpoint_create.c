@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_interrupt_endpoint_create              PORTABLE C      */ 
-/*                                                           6.1.6        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -71,6 +71,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_ed_free                  Free ED                       */
 /*    _ux_hcd_ohci_ed_obtain                Obtain OHCI ED                */ 
 /*    _ux_hcd_ohci_least_traffic_list_get   Get least traffic list        */ 
 /*    _ux_hcd_ohci_regular_td_obtain        Obtain OHCI regular TD        */ 
@@ -93,6 +94,10 @@
 /*  04-02-2021     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            filled max transfer length, */
 /*                                            resulting in version 6.1.6  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            used bandwidth map list,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_interrupt_endpoint_create(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint)
@@ -119,7 +124,7 @@ UINT            interval_ohci;
     if (td == UX_NULL)
     {
     
-        ed -> ux_ohci_ed_status =  UX_UNUSED;
+        _ux_hcd_ohci_ed_free(hcd_ohci, ed);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -148,8 +153,15 @@ UINT            interval_ohci;
     ed -> ux_ohci_ed_tail_td =  _ux_utility_physical_address(td);
     ed -> ux_ohci_ed_head_td =  _ux_utility_physical_address(td);
 
+#if defined(UX_ENABLE_BANDWIDTH_MAP)
+
+    /* Get the list of the frame the host stack placed the endpoint in.  */
+    ed_list =  _ux_utility_virtual_address(hcd_ohci -> ux_hcd_ohci_hcca -> ux_hcd_ohci_hcca_ed[UX_BANDWIDTH_MAP_FRAME(endpoint)]);
+#else
+
     /* Get the list index with the least traffic.  */
     ed_list =  _ux_hcd_ohci_least_traffic_list_get(hcd_ohci);
+#endif
     
     /* Get the interval for the endpoint and match it to a OHCI list. We match anything that 
        is > 32ms to the 32ms interval list. The 32ms list is list 0, 16ms list is 1 ...
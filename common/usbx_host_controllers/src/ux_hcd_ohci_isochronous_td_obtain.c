@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_isochronous_td_obtain                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,6 +53,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_mutex_on_count               Get protection mutex          */
+/*    _ux_host_mutex_off                    Release protection mutex      */
 /*    _ux_utility_memory_set                Set memory block              */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -68,39 +70,39 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UX_OHCI_ISO_TD  *_ux_hcd_ohci_isochronous_td_obtain(UX_HCD_OHCI *hcd_ohci)
 {
 
 UX_OHCI_ISO_TD      *td;
-ULONG               td_index;
 
 
-    /* Start the search from the beginning of the list.  */
-    td =  hcd_ohci -> ux_hcd_ohci_iso_td_list;
-    for (td_index = 0; td_index < _ux_system_host -> ux_system_host_max_iso_td; td_index++)
-    {
+    /* Get the mutex as this is a critical section.  */
+    _ux_host_mutex_on_count(&hcd_ohci -> ux_hcd_ohci_td_mutex, &hcd_ohci -> ux_hcd_ohci_td_mutex_contentions);
 
-        /* Check the TD status, a free TD is marked with the UNUSED flag.  */
-        if (td -> ux_ohci_iso_td_status == UX_UNUSED)
-        {
+    /* Take the TD at the head of the free list.  */
+    td =  hcd_ohci -> ux_hcd_ohci_iso_td_free_list;
+    if (td != UX_NULL)
+        hcd_ohci -> ux_hcd_ohci_iso_td_free_list =  (UX_OHCI_ISO_TD *) td -> ux_ohci_iso_td_next_td_transfer_request;
 
-            /* The TD may have been used, so we reset all fields.  */
-            _ux_utility_memory_set(td, 0, sizeof(UX_OHCI_ISO_TD)); /* Use case of memset is verified. */
+    /* Release the protection.  */
+    _ux_host_mutex_off(&hcd_ohci -> ux_hcd_ohci_td_mutex);
 
-            /* This TD is now marked as USED.  */
-            td -> ux_ohci_iso_td_status =  UX_USED;
+    /* There is no available TD in the isochronous TD list.  */
+    if (td == UX_NULL)
+        return(UX_NULL);
 
-            /* Success, return the TD pointer.  */
-            return(td);
-        }
+    /* The TD may have been used, so we reset all fields.  */
+    _ux_utility_memory_set(td, 0, sizeof(UX_OHCI_ISO_TD)); /* Use case of memset is verified. */
 
-        /* Move to next TD.  */
-        td++;
-    }
+    /* This TD is now marked as USED.  */
+    td -> ux_ohci_iso_td_status =  UX_USED;
 
-    /* There is no available TD in the TD list.  */
-    return(UX_NULL);
+    /* Success, return TD pointer.  */
+    return(td);
 }
 
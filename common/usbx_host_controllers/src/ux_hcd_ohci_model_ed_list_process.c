@@ -0,0 +1,115 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_ed_list_process                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes a list of EDs of the software OHCI           */
+/*    controller model, from the ED given to the end of the list. Skipped */
+/*    EDs, which include the static EDs of the periodic tree, and         */
+/*    isochronous EDs are passed over.                                    */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ed                                    Pointer to first ED of list   */
+/*    list_filled                           Set if the list has TDs       */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if a transfer progressed                                    */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_ed_process         Execute ED                    */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ohci_model_ed_list_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, ULONG *list_filled)
+{
+
+UX_OHCI_TD      *head_td;
+ULONG           head_flags;
+ULONG           progress;
+ULONG           links;
+
+
+    progress =  UX_FALSE;
+    *list_filled =  UX_FALSE;
+    for (links = 0; (links < UX_HCD_OHCI_MODEL_LINKS_MAX) && (ed != UX_NULL); links ++)
+    {
+
+        /* Skipped and isochronous EDs are not executed.  */
+        if ((ed -> ux_ohci_ed_dw0 & (UX_OHCI_ED_SKIP | UX_OHCI_ED_ISOCHRONOUS)) == 0)
+        {
+
+            /* The ED has TDs if it is not halted and its head is not its tail.  */
+            head_flags =  (ULONG) ((ALIGN_TYPE) ed -> ux_ohci_ed_head_td & UX_HCD_OHCI_MODEL_ED_HEAD_FLAGS);
+            head_td =  (UX_OHCI_TD *) ((UCHAR *) ed -> ux_ohci_ed_head_td - head_flags);
+            if (((head_flags & UX_OHCI_ED_HALTED) == 0) && (head_td != ed -> ux_ohci_ed_tail_td))
+            {
+
+                /* Execute the ED.  */
+                *list_filled =  UX_TRUE;
+                if (_ux_hcd_ohci_model_ed_process(hcd_ohci_model, ed))
+                    progress =  UX_TRUE;
+            }
+        }
+
+        /* Next ED of the list.  */
+        ed =  _ux_utility_virtual_address(ed -> ux_ohci_ed_next_ed);
+    }
+
+    /* Return if a transfer progressed.  */
+    return(progress);
+}
+#endif
@@ -0,0 +1,114 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_ed_process                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes the TDs of an ED of the software OHCI        */
+/*    controller model, until the ED is halted, is empty, or its device   */
+/*    endpoint needs more time.                                           */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ed                                    Pointer to ED                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if a transfer progressed                                    */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_td_process         Execute TD                    */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ohci_model_ed_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed)
+{
+
+UX_OHCI_TD      *td;
+ULONG           head_flags;
+ULONG           result;
+ULONG           progress;
+ULONG           passes;
+
+
+    progress =  UX_FALSE;
+    for (passes = 0; passes < UX_HCD_OHCI_MODEL_TD_PASSES_MAX; passes ++)
+    {
+
+        /* Stop on a halted or skipped ED, the driver cleans it.  */
+        head_flags =  (ULONG) ((ALIGN_TYPE) ed -> ux_ohci_ed_head_td & UX_HCD_OHCI_MODEL_ED_HEAD_FLAGS);
+        if ((head_flags & UX_OHCI_ED_HALTED) || (ed -> ux_ohci_ed_dw0 & UX_OHCI_ED_SKIP))
+            break;
+
+        /* Is there a TD before the tail?  */
+        td =  (UX_OHCI_TD *) ((UCHAR *) ed -> ux_ohci_ed_head_td - head_flags);
+        if (td == ed -> ux_ohci_ed_tail_td)
+            break;
+
+        /* Execute the TD.  */
+        td =  _ux_utility_virtual_address(td);
+        result =  _ux_hcd_ohci_model_td_process(hcd_ohci_model, ed, td);
+        if (result == UX_HCD_OHCI_MODEL_TD_NAK)
+            break;
+        progress =  UX_TRUE;
+
+        /* The device must queue more data for this TD.  */
+        if (result == UX_HCD_OHCI_MODEL_TD_PROGRESS)
+            break;
+    }
+
+    /* Return if a transfer progressed.  */
+    return(progress);
+}
+#endif
@@ -0,0 +1,153 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_initialize                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function initializes the software OHCI controller model and    */
+/*    then the OHCI driver on top of it. The model takes the place of the */
+/*    OHCI registers: the driver register base address is the model, its  */
+/*    thread executes the ED lists the driver builds in memory with the   */
+/*    device simulator.                                                   */
+/*                                                                        */
+/*    It is registered as the HCD initialization function instead of      */
+/*    _ux_hcd_ohci_initialize.                                            */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd                                   Pointer to the host controller*/
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Completion Status                                                   */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_initialize               Initialize OHCI driver        */
+/*    _ux_hcd_ohci_model_register_write     Write model register          */
+/*    _ux_host_semaphore_create             Create semaphore              */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
+/*    _ux_host_thread_create                Create thread                 */
+/*    _ux_host_thread_delete                Delete thread                 */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Free memory block             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    Host Stack                                                          */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_hcd_ohci_model_initialize(UX_HCD *hcd)
+{
+
+UX_HCD_OHCI_MODEL       *hcd_ohci_model;
+UINT                    status;
+
+
+    /* Allocate memory for the OHCI model instance.  */
+    hcd_ohci_model =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HCD_OHCI_MODEL));
+    if (hcd_ohci_model == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Keep the HCD the model serves.  */
+    hcd_ohci_model -> ux_hcd_ohci_model_hcd =  hcd;
+
+    /* Create the semaphore the model thread waits on between frames.  */
+    status =  _ux_host_semaphore_create(&hcd_ohci_model -> ux_hcd_ohci_model_semaphore, "ux_hcd_ohci_model_semaphore", 0);
+    if (status != UX_SUCCESS)
+    {
+        _ux_utility_memory_free(hcd_ohci_model);
+        return(UX_SEMAPHORE_ERROR);
+    }
+
+    /* The registers start from their reset values.  */
+    _ux_hcd_ohci_model_register_write(hcd_ohci_model, OHCI_HC_COMMAND_STATUS, OHCI_HC_CS_HCR);
+
+    /* Allocate the model thread stack.  */
+    hcd_ohci_model -> ux_hcd_ohci_model_thread_stack =
+            _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_HCD_OHCI_MODEL_THREAD_STACK_SIZE);
+    if (hcd_ohci_model -> ux_hcd_ohci_model_thread_stack == UX_NULL)
+    {
+        _ux_host_semaphore_delete(&hcd_ohci_model -> ux_hcd_ohci_model_semaphore);
+        _ux_utility_memory_free(hcd_ohci_model);
+        return(UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* Create the model thread. It runs the frames while the controller is operational.  */
+    status =  _ux_host_thread_create(&hcd_ohci_model -> ux_hcd_ohci_model_thread, "ux_hcd_ohci_model_thread",
+                _ux_hcd_ohci_model_thread_entry, (ULONG) (ALIGN_TYPE) hcd_ohci_model,
+                hcd_ohci_model -> ux_hcd_ohci_model_thread_stack, UX_HCD_OHCI_MODEL_THREAD_STACK_SIZE,
+                UX_HCD_OHCI_MODEL_THREAD_PRIORITY, UX_HCD_OHCI_MODEL_THREAD_PRIORITY,
+                UX_NO_TIME_SLICE, UX_AUTO_START);
+    if (status != UX_SUCCESS)
+    {
+        _ux_utility_memory_free(hcd_ohci_model -> ux_hcd_ohci_model_thread_stack);
+        _ux_host_semaphore_delete(&hcd_ohci_model -> ux_hcd_ohci_model_semaphore);
+        _ux_utility_memory_free(hcd_ohci_model);
+        return(UX_THREAD_ERROR);
+    }
+
+    UX_THREAD_EXTENSION_PTR_SET(&(hcd_ohci_model -> ux_hcd_ohci_model_thread), hcd_ohci_model)
+
+    /* The registers of the model are the registers the driver accesses.  */
+    hcd -> ux_hcd_io =  (ULONG) (ALIGN_TYPE) hcd_ohci_model;
+
+    /* Initialize the OHCI driver on the model.  */
+    status =  _ux_hcd_ohci_initialize(hcd);
+    if (status != UX_SUCCESS)
+    {
+        _ux_host_thread_delete(&hcd_ohci_model -> ux_hcd_ohci_model_thread);
+        _ux_utility_memory_free(hcd_ohci_model -> ux_hcd_ohci_model_thread_stack);
+        _ux_host_semaphore_delete(&hcd_ohci_model -> ux_hcd_ohci_model_semaphore);
+        _ux_utility_memory_free(hcd_ohci_model);
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
@@ -0,0 +1,111 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_port_reset                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function resets the simulated device attached to the port of   */
+/*    the software OHCI controller model. The device is connected at full */
+/*    speed.                                                              */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_dcd_sim_slave_initialize_complete Complete device initialization*/
+/*    _ux_device_stack_disconnect           Disconnect device             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ohci_model_port_reset(UX_HCD_OHCI_MODEL *hcd_ohci_model)
+{
+
+UX_SLAVE_DEVICE     *device;
+
+
+    UX_PARAMETER_NOT_USED(hcd_ohci_model);
+
+    /* There may be no device side.  */
+    if (_ux_system_slave == UX_NULL)
+        return;
+
+    /* The OHCI port is a full speed port.  */
+    _ux_system_slave -> ux_system_slave_speed =  UX_FULL_SPEED_DEVICE;
+
+    /* Get a pointer to the device.  */
+    device =  &_ux_system_slave -> ux_system_slave_device;
+
+    /* Is this a connection?  */
+    if (device -> ux_slave_device_state == UX_DEVICE_RESET)
+
+        /* Complete the device initialization.  */
+        _ux_dcd_sim_slave_initialize_complete();
+
+    else
+    {
+
+        /* The device goes back to the default state.  */
+        _ux_device_stack_disconnect();
+        _ux_dcd_sim_slave_initialize_complete();
+    }
+
+    /* In either case, mark the device as default/attached now.  */
+    device -> ux_slave_device_state =  UX_DEVICE_ATTACHED;
+}
+#endif
@@ -0,0 +1,89 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_register_read                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function reads a register of the software OHCI controller      */
+/*    model. The interrupt enable and disable registers both read the     */
+/*    interrupt enable mask.                                              */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ohci_register                         Register to read              */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    Register value                                                      */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Driver                                              */
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ohci_model_register_read(UX_HCD_OHCI_MODEL *hcd_ohci_model, ULONG ohci_register)
+{
+
+    /* Registers the model does not implement read as zero.  */
+    if (ohci_register >= UX_HCD_OHCI_MODEL_REGISTERS)
+        return(0);
+
+    /* The interrupt enable mask is kept in the enable register.  */
+    if (ohci_register == OHCI_HC_INTERRUPT_DISABLE)
+        ohci_register =  OHCI_HC_INTERRUPT_ENABLE;
+
+    /* Read the register.  */
+    return(hcd_ohci_model -> ux_hcd_ohci_model_registers[ohci_register]);
+}
+#endif
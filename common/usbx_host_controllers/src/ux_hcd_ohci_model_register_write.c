@@ -0,0 +1,236 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_register_write                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function writes a register of the software OHCI controller     */
+/*    model and applies the side effects the controller has on the write: */
+/*    host controller reset, list filled bits, write 1 to clear status    */
+/*    bits, interrupt enable and disable, root hub power and the port     */
+/*    commands. A change on a root hub port raises the root hub status    */
+/*    change interrupt. A write to the control, command, interrupt enable */
+/*    or root hub registers wakes up the model thread.                    */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ohci_register                         Register to write             */
+/*    value                                 Value to write                */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_port_reset         Reset device on port          */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Driver                                              */
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ohci_model_register_write(UX_HCD_OHCI_MODEL *hcd_ohci_model, ULONG ohci_register, ULONG value)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG       *registers;
+ULONG       port_status;
+ULONG       port_index;
+ULONG       port_change;
+ULONG       port_reset_done;
+ULONG       thread_wakeup;
+
+
+    /* Writes to registers the model does not implement are ignored.  */
+    if (ohci_register >= UX_HCD_OHCI_MODEL_REGISTERS)
+        return;
+
+    /* Get the registers of the model.  */
+    registers =  hcd_ohci_model -> ux_hcd_ohci_model_registers;
+    port_change =  0;
+    port_reset_done =  UX_FALSE;
+    thread_wakeup =  UX_TRUE;
+
+    UX_DISABLE
+
+    switch (ohci_register)
+    {
+
+    case OHCI_HC_COMMAND_STATUS:
+
+        /* The host controller reset sets the registers to their default values and
+           completes at once. The root hub ports are not powered.  */
+        if (value & OHCI_HC_CS_HCR)
+        {
+            _ux_utility_memory_set(registers, 0, UX_HCD_OHCI_MODEL_REGISTERS * sizeof(ULONG)); /* Use case of memset is verified. */
+            registers[OHCI_HC_REVISION] =  UX_HCD_OHCI_MODEL_REVISION;
+            registers[OHCI_HC_FM_INTERVAL] =  UX_HCD_OHCI_MODEL_FM_INTERVAL;
+            registers[OHCI_HC_LS_THRESHOLD] =  UX_HCD_OHCI_MODEL_LS_THRESHOLD;
+            registers[OHCI_HC_RH_DESCRIPTOR_A] =  UX_HCD_OHCI_MODEL_RH_DESCRIPTOR_A;
+            hcd_ohci_model -> ux_hcd_ohci_model_done_queue =  UX_NULL;
+            break;
+        }
+
+        /* The list filled bits are set by writing 1.  */
+        registers[OHCI_HC_COMMAND_STATUS] |=  value & UX_HCD_OHCI_MODEL_CS_WRITE_MASK;
+        break;
+
+    case OHCI_HC_INTERRUPT_STATUS:
+
+        /* The interrupt status bits are cleared by writing 1.  */
+        registers[OHCI_HC_INTERRUPT_STATUS] &= ~value;
+        thread_wakeup =  UX_FALSE;
+        break;
+
+    case OHCI_HC_INTERRUPT_ENABLE:
+
+        /* Interrupts are enabled by writing 1 in the enable register. An interrupt
+           already pending is raised by the model thread.  */
+        registers[OHCI_HC_INTERRUPT_ENABLE] |=  value;
+        break;
+
+    case OHCI_HC_INTERRUPT_DISABLE:
+
+        /* Interrupts are disabled by writing 1 in the disable register.  */
+        registers[OHCI_HC_INTERRUPT_ENABLE] &= ~value;
+        thread_wakeup =  UX_FALSE;
+        break;
+
+    case OHCI_HC_REVISION:
+    case OHCI_HC_DONE_HEAD:
+    case OHCI_HC_FM_REMAINING:
+    case OHCI_HC_FM_NUMBER:
+    case OHCI_HC_RH_DESCRIPTOR_A:
+
+        /* These registers are read only.  */
+        thread_wakeup =  UX_FALSE;
+        break;
+
+    case OHCI_HC_RH_STATUS:
+
+        /* Setting the global power powers the ports on, the device is seen connected.
+           Clearing the global power powers the ports off.  */
+        for (port_index = 0; port_index < UX_HCD_OHCI_MODEL_PORTS; port_index++)
+        {
+            port_status =  registers[OHCI_HC_RH_PORT_STATUS + port_index];
+            if ((value & OHCI_HC_RS_LPSC) && ((port_status & OHCI_HC_PS_PPS) == 0))
+                port_status =  OHCI_HC_PS_PPS | OHCI_HC_PS_CCS | OHCI_HC_PS_CSC;
+            else if (value & OHCI_HC_RS_LPS)
+                port_status =  0;
+            port_change |=  port_status & ~registers[OHCI_HC_RH_PORT_STATUS + port_index];
+            registers[OHCI_HC_RH_PORT_STATUS + port_index] =  port_status;
+        }
+        break;
+
+    default:
+
+        /* Registers below the root hub ports hold the value written.  */
+        if (ohci_register < OHCI_HC_RH_PORT_STATUS)
+        {
+            registers[ohci_register] =  value;
+            if (ohci_register != OHCI_HC_CONTROL)
+                thread_wakeup =  UX_FALSE;
+            break;
+        }
+
+        /* The port status bits written 1 are port commands, the change bits are
+           cleared by writing 1.  */
+        port_status =  registers[ohci_register];
+        port_status &= ~(value & UX_HCD_OHCI_MODEL_PS_CLEAR_MASK);
+        if (value & OHCI_HC_PS_PPS)
+            port_status |=  OHCI_HC_PS_PPS;
+        if (value & UX_HCD_OHCI_MODEL_PS_CPP)
+            port_status &= ~(OHCI_HC_PS_PPS | OHCI_HC_PS_PES | OHCI_HC_PS_PSS);
+
+        /* The other commands need a device on a powered port.  */
+        if ((port_status & OHCI_HC_PS_CCS) && (port_status & OHCI_HC_PS_PPS))
+        {
+
+            if (value & OHCI_HC_PS_CPE)
+                port_status &= ~OHCI_HC_PS_PES;
+            if (value & OHCI_HC_PS_PES)
+                port_status |=  OHCI_HC_PS_PES;
+            if (value & OHCI_HC_PS_PSS)
+                port_status |=  OHCI_HC_PS_PSS;
+            if ((value & OHCI_HC_PS_POCI) && (port_status & OHCI_HC_PS_PSS))
+                port_status = (port_status & ~OHCI_HC_PS_PSS) | OHCI_HC_PS_PSSC;
+
+            /* The port reset completes at once, it enables the port and resets the device.  */
+            if (value & OHCI_HC_PS_PRS)
+            {
+                port_status &= ~OHCI_HC_PS_PSS;
+                port_status |=  OHCI_HC_PS_PES | OHCI_HC_PS_PRSC;
+                port_reset_done =  UX_TRUE;
+            }
+        }
+        port_change |=  port_status & ~registers[ohci_register];
+        registers[ohci_register] =  port_status;
+        break;
+    }
+
+    /* A change bit set on a port is a root hub status change.  */
+    if (port_change & UX_HCD_OHCI_MODEL_PS_CLEAR_MASK)
+        registers[OHCI_HC_INTERRUPT_STATUS] |=  OHCI_HC_INT_RHSC;
+
+    UX_RESTORE
+
+    /* The device sees the reset of the port.  */
+    if (port_reset_done)
+        _ux_hcd_ohci_model_port_reset(hcd_ohci_model);
+
+    /* Let the model thread see the new control, list or root hub state.  */
+    if (thread_wakeup)
+        _ux_host_semaphore_put(&hcd_ohci_model -> ux_hcd_ohci_model_semaphore);
+}
+#endif
@@ -0,0 +1,193 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_schedule                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes a frame of the software OHCI controller      */
+/*    model. It updates the frame number in the HCCA, executes the        */
+/*    periodic list of the frame and the control and bulk lists that are  */
+/*    filled, writes the done queue back to the HCCA once the driver has  */
+/*    taken the previous one and raises the OHCI interrupt if an enabled  */
+/*    interrupt is pending. Isochronous EDs are not executed.             */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_TRUE if a transfer progressed                                    */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_interrupt_handler        OHCI interrupt handler        */
+/*    _ux_hcd_ohci_model_ed_list_process    Execute ED list               */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ohci_model_schedule(UX_HCD_OHCI_MODEL *hcd_ohci_model)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG               *registers;
+UX_HCD_OHCI_HCCA    *hcca;
+UX_OHCI_ED          *ed;
+UCHAR               *done_head;
+ULONG               control;
+ULONG               frame_number;
+ULONG               list_filled;
+ULONG               interrupt_pending;
+ULONG               progress;
+
+
+    /* Get the registers of the model.  */
+    registers =  hcd_ohci_model -> ux_hcd_ohci_model_registers;
+    control =  registers[OHCI_HC_CONTROL];
+    progress =  UX_FALSE;
+
+    /* The frame needs the HCCA.  */
+    hcca =  _ux_utility_virtual_address((VOID *) (ALIGN_TYPE) registers[OHCI_HC_HCCA]);
+    if (hcca == UX_NULL)
+        return(UX_FALSE);
+
+    /* A pass is one frame, the frame number goes to the HCCA when the frame starts.  */
+    UX_DISABLE
+    frame_number =  (registers[OHCI_HC_FM_NUMBER] + 1) & UX_HCD_OHCI_MODEL_FM_NUMBER_MASK;
+    registers[OHCI_HC_FM_NUMBER] =  frame_number;
+    registers[OHCI_HC_INTERRUPT_STATUS] |=  OHCI_HC_INT_SF;
+    if ((frame_number & (UX_HCD_OHCI_MODEL_FM_NUMBER_MSB - 1)) == 0)
+        registers[OHCI_HC_INTERRUPT_STATUS] |=  OHCI_HC_INT_FNO;
+    UX_RESTORE
+    hcca -> ux_hcd_ohci_hcca_frame_number =  (USHORT) frame_number;
+    hcd_ohci_model -> ux_hcd_ohci_model_frames ++;
+
+    /* Execute the periodic list of the frame.  */
+    if (control & OHCI_HC_CR_PLE)
+    {
+        ed =  _ux_utility_virtual_address(hcca -> ux_hcd_ohci_hcca_ed[frame_number & UX_HCD_OHCI_MODEL_HCCA_ED_MASK]);
+        if (_ux_hcd_ohci_model_ed_list_process(hcd_ohci_model, ed, &list_filled))
+            progress =  UX_TRUE;
+    }
+
+    /* Execute the control list if it is filled. The filled bit is cleared when the
+       list starts and set again if an ED of the list has TDs.  */
+    if ((control & OHCI_HC_CR_CLE) && (registers[OHCI_HC_COMMAND_STATUS] & OHCI_HC_CS_CLF))
+    {
+        UX_DISABLE
+        registers[OHCI_HC_COMMAND_STATUS] &= ~OHCI_HC_CS_CLF;
+        UX_RESTORE
+        ed =  _ux_utility_virtual_address((VOID *) (ALIGN_TYPE) registers[OHCI_HC_CONTROL_HEAD_ED]);
+        if (_ux_hcd_ohci_model_ed_list_process(hcd_ohci_model, ed, &list_filled))
+            progress =  UX_TRUE;
+        if (list_filled)
+        {
+            UX_DISABLE
+            registers[OHCI_HC_COMMAND_STATUS] |=  OHCI_HC_CS_CLF;
+            UX_RESTORE
+        }
+    }
+
+    /* Execute the bulk list the same way.  */
+    if ((control & OHCI_HC_CR_BLE) && (registers[OHCI_HC_COMMAND_STATUS] & OHCI_HC_CS_BLF))
+    {
+        UX_DISABLE
+        registers[OHCI_HC_COMMAND_STATUS] &= ~OHCI_HC_CS_BLF;
+        UX_RESTORE
+        ed =  _ux_utility_virtual_address((VOID *) (ALIGN_TYPE) registers[OHCI_HC_BULK_HEAD_ED]);
+        if (_ux_hcd_ohci_model_ed_list_process(hcd_ohci_model, ed, &list_filled))
+            progress =  UX_TRUE;
+        if (list_filled)
+        {
+            UX_DISABLE
+            registers[OHCI_HC_COMMAND_STATUS] |=  OHCI_HC_CS_BLF;
+            UX_RESTORE
+        }
+    }
+
+    UX_DISABLE
+
+    /* The done queue is written back to the HCCA at the end of the frame, when the
+       driver has acknowledged the previous one. The LSB of the done head tells the
+       driver other enabled interrupts are pending.  */
+    if ((hcd_ohci_model -> ux_hcd_ohci_model_done_queue != UX_NULL) &&
+        ((registers[OHCI_HC_INTERRUPT_STATUS] & OHCI_HC_INT_WDH) == 0))
+    {
+        done_head =  (UCHAR *) hcd_ohci_model -> ux_hcd_ohci_model_done_queue;
+        if (registers[OHCI_HC_INTERRUPT_STATUS] & registers[OHCI_HC_INTERRUPT_ENABLE] & ~(OHCI_HC_INT_WDH | OHCI_HC_INT_MIE))
+            done_head +=  UX_HCD_OHCI_MODEL_DONE_HEAD_INT;
+        hcca -> ux_hcd_ohci_hcca_done_head =  (UX_OHCI_TD *) done_head;
+        hcd_ohci_model -> ux_hcd_ohci_model_done_queue =  UX_NULL;
+        registers[OHCI_HC_INTERRUPT_STATUS] |=  OHCI_HC_INT_WDH;
+        hcd_ohci_model -> ux_hcd_ohci_model_done_heads ++;
+    }
+
+    /* Is an enabled interrupt pending?  */
+    interrupt_pending =  UX_FALSE;
+    if ((registers[OHCI_HC_INTERRUPT_ENABLE] & OHCI_HC_INT_MIE) &&
+        (registers[OHCI_HC_INTERRUPT_STATUS] & registers[OHCI_HC_INTERRUPT_ENABLE] & ~OHCI_HC_INT_MIE))
+        interrupt_pending =  UX_TRUE;
+
+    UX_RESTORE
+
+    /* Raise the interrupt.  */
+    if (interrupt_pending)
+    {
+        hcd_ohci_model -> ux_hcd_ohci_model_interrupts ++;
+        _ux_hcd_ohci_interrupt_handler();
+    }
+
+    /* Return if a transfer progressed.  */
+    return(progress);
+}
+#endif
@@ -0,0 +1,192 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_setup_process                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes a SETUP TD of the software OHCI controller   */
+/*    model. The setup packet goes to the control endpoint of the device, */
+/*    with the data of the OUT data stage TDs that follow, then the device*/
+/*    stack processes the request.                                        */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ed                                    Pointer to ED                 */
+/*    td                                    Pointer to SETUP TD           */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_HCD_OHCI_MODEL_TD_NAK or _RETIRED                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_device_stack_control_request_processProcess control request     */
+/*    _ux_hcd_ohci_model_td_retire          Retire TD                     */
+/*    _ux_system_error_handler              Log system error              */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_short_get                 Get 16-bit value              */
+/*    _ux_utility_virtual_address           Get virtual address           */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ohci_model_setup_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, UX_OHCI_TD *td)
+{
+
+UX_SLAVE_DCD            *dcd;
+UX_DCD_SIM_SLAVE        *dcd_sim_slave;
+UX_DCD_SIM_SLAVE_ED     *slave_ed;
+UX_SLAVE_TRANSFER       *slave_transfer_request;
+UX_OHCI_TD              *data_td;
+ULONG                   head_flags;
+ULONG                   transaction_length;
+ULONG                   td_length;
+ULONG                   device_address;
+
+
+    /* The device does not answer until it is ready.  */
+    if (_ux_system_slave == UX_NULL)
+        return(UX_HCD_OHCI_MODEL_TD_NAK);
+    dcd =  &_ux_system_slave -> ux_system_slave_dcd;
+    if (dcd -> ux_slave_dcd_status != UX_DCD_STATUS_OPERATIONAL)
+        return(UX_HCD_OHCI_MODEL_TD_NAK);
+
+    /* Get the control endpoint of the device.  */
+    dcd_sim_slave =  (UX_DCD_SIM_SLAVE *) dcd -> ux_slave_dcd_controller_hardware;
+    slave_ed =  &dcd_sim_slave -> ux_dcd_sim_slave_ed[0];
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_USED) == 0)
+    {
+        _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, td, UX_OHCI_ERROR_DEVICE_NOT_RESPONDING);
+        return(UX_HCD_OHCI_MODEL_TD_RETIRED);
+    }
+    slave_transfer_request =  &slave_ed -> ux_sim_slave_ed_endpoint -> ux_slave_endpoint_transfer_request;
+
+    /* For control transfer, stall is for protocol error and it's cleared any time when SETUP is received.  */
+    slave_ed -> ux_sim_slave_ed_status &= ~(ULONG)UX_DCD_SIM_SLAVE_ED_STATUS_STALLED;
+
+    /* Reset actual data length (not including SETUP received) so far.  */
+    slave_transfer_request -> ux_slave_transfer_request_actual_length =  0;
+
+    /* Move the setup packet from the TD to the device, the SETUP stage never fails.  */
+    _ux_utility_memory_copy(slave_transfer_request -> ux_slave_transfer_request_setup, td -> ux_ohci_td_cbp,
+                            UX_SETUP_SIZE); /* Use case of memcpy is verified. */
+    hcd_ohci_model -> ux_hcd_ohci_model_bytes +=  UX_SETUP_SIZE;
+    _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, td, UX_OHCI_NO_ERROR);
+
+    /* Check if the transaction is OUT from the host and there is data payload.  */
+    transaction_length =  _ux_utility_short_get(slave_transfer_request -> ux_slave_transfer_request_setup + UX_SETUP_LENGTH);
+    if (((*slave_transfer_request -> ux_slave_transfer_request_setup & UX_REQUEST_IN) == 0) && (transaction_length != 0))
+    {
+
+        /* Avoid buffer overflow.  */
+        if (transaction_length > UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH)
+        {
+
+            /* Error trap.  */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_DCD, UX_TRANSFER_BUFFER_OVERFLOW);
+            transaction_length =  UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH;
+        }
+
+        /* The data goes to the beginning of the control buffer.  */
+        slave_transfer_request -> ux_slave_transfer_request_requested_length =  transaction_length;
+        slave_transfer_request -> ux_slave_transfer_request_current_data_pointer =  slave_transfer_request -> ux_slave_transfer_request_data_pointer;
+
+        /* It may take multiple TDs to send all the data, they follow the SETUP TD.  */
+        while (transaction_length != 0)
+        {
+
+            /* The next TD is the head of the ED, stop at the tail.  */
+            head_flags =  (ULONG) ((ALIGN_TYPE) ed -> ux_ohci_ed_head_td & UX_HCD_OHCI_MODEL_ED_HEAD_FLAGS);
+            data_td =  (UX_OHCI_TD *) ((UCHAR *) ed -> ux_ohci_ed_head_td - head_flags);
+            if (data_td == ed -> ux_ohci_ed_tail_td)
+                break;
+            data_td =  _ux_utility_virtual_address(data_td);
+            if (((data_td -> ux_ohci_td_dw0 & UX_HCD_OHCI_MODEL_TD_DP_MASK) != UX_OHCI_TD_OUT) ||
+                (data_td -> ux_ohci_td_cbp == UX_NULL))
+                break;
+
+            /* Copy the data of the TD into the device buffer.  */
+            td_length =  (ULONG) (data_td -> ux_ohci_td_be - data_td -> ux_ohci_td_cbp + 1);
+            td_length =  UX_MIN(td_length, transaction_length);
+            _ux_utility_memory_copy(slave_transfer_request -> ux_slave_transfer_request_current_data_pointer, data_td -> ux_ohci_td_cbp,
+                                    td_length); /* Use case of memcpy is verified. */
+            slave_transfer_request -> ux_slave_transfer_request_current_data_pointer +=  td_length;
+            slave_transfer_request -> ux_slave_transfer_request_actual_length +=  td_length;
+            transaction_length -=  td_length;
+            hcd_ohci_model -> ux_hcd_ohci_model_bytes +=  td_length;
+
+            /* The TD is done.  */
+            _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, data_td, UX_OHCI_NO_ERROR);
+        }
+    }
+
+    /* Is this meant for the device itself? Before the device is addressed its address
+       may be invalid, the request is for the device then.  */
+    device_address =  ed -> ux_ohci_ed_dw0 & UX_HCD_OHCI_MODEL_ED_FA_MASK;
+    if ((dcd_sim_slave -> ux_dcd_sim_slave_dcd_control_request_process_hub == UX_NULL) ||
+        (_ux_system_slave -> ux_system_slave_device.ux_slave_device_state == UX_DEVICE_RESET) ||
+        (_ux_system_slave -> ux_system_slave_device.ux_slave_device_state == UX_DEVICE_ATTACHED) ||
+        (device_address == dcd -> ux_slave_dcd_device_address))
+
+        /* Pass the transfer to the regular device stack.  */
+        _ux_device_stack_control_request_process(slave_transfer_request);
+
+    else
+
+        /* This control transfer is meant for a device on the hub.  */
+        dcd_sim_slave -> ux_dcd_sim_slave_dcd_control_request_process_hub(slave_transfer_request);
+
+    /* The SETUP TD is retired.  */
+    return(UX_HCD_OHCI_MODEL_TD_RETIRED);
+}
+#endif
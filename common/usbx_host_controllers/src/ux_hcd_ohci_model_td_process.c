@@ -0,0 +1,267 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_td_process                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function executes a TD of the software OHCI controller model   */
+/*    with the device simulator. It moves the data between the TD buffer  */
+/*    and the transfer request of the device endpoint, following the same */
+/*    rules as the host simulator. The TD is retired when the host has all*/
+/*    its data or gets a short packet, a short packet is an underrun      */
+/*    unless the TD allows buffer rounding.                               */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ed                                    Pointer to ED                 */
+/*    td                                    Pointer to TD                 */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    UX_HCD_OHCI_MODEL_TD_NAK, _PROGRESS or _RETIRED                     */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_device_semaphore_put              Put semaphore                 */
+/*    _ux_hcd_ohci_model_setup_process      Execute SETUP TD              */
+/*    _ux_hcd_ohci_model_td_retire          Retire TD                     */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_hcd_ohci_model_td_process(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, UX_OHCI_TD *td)
+{
+
+UX_SLAVE_DCD            *dcd;
+UX_DCD_SIM_SLAVE        *dcd_sim_slave;
+UX_DCD_SIM_SLAVE_ED     *slave_ed;
+UX_SLAVE_ENDPOINT       *slave_endpoint;
+UX_SLAVE_TRANSFER       *slave_transfer_request;
+ULONG                   direction;
+ULONG                   endpoint_index;
+ULONG                   td_length;
+ULONG                   slave_transfer_remaining;
+ULONG                   transaction_length;
+ULONG                   condition_code;
+UCHAR                   wake_host;
+UCHAR                   wake_slave;
+
+
+    /* Get the direction from the TD, unless the ED sets it.  */
+    direction =  td -> ux_ohci_td_dw0 & UX_HCD_OHCI_MODEL_TD_DP_MASK;
+    if ((ed -> ux_ohci_ed_dw0 & UX_HCD_OHCI_MODEL_ED_D_MASK) == UX_OHCI_ED_OUT)
+        direction =  UX_OHCI_TD_OUT;
+    else if ((ed -> ux_ohci_ed_dw0 & UX_HCD_OHCI_MODEL_ED_D_MASK) == UX_OHCI_ED_IN)
+        direction =  UX_OHCI_TD_IN;
+
+    /* The SETUP stage is handled apart.  */
+    if (direction == UX_HCD_OHCI_MODEL_TD_DP_SETUP)
+        return(_ux_hcd_ohci_model_setup_process(hcd_ohci_model, ed, td));
+
+    /* The device does not answer until it is ready.  */
+    if (_ux_system_slave == UX_NULL)
+        return(UX_HCD_OHCI_MODEL_TD_NAK);
+    dcd =  &_ux_system_slave -> ux_system_slave_dcd;
+    if (dcd -> ux_slave_dcd_status != UX_DCD_STATUS_OPERATIONAL)
+        return(UX_HCD_OHCI_MODEL_TD_NAK);
+
+    /* Get the endpoint as seen from the device side.  */
+    endpoint_index =  (ed -> ux_ohci_ed_dw0 >> UX_HCD_OHCI_MODEL_ED_EN_SHIFT) & UX_HCD_OHCI_MODEL_ED_EN_MASK;
+    dcd_sim_slave =  (UX_DCD_SIM_SLAVE *) dcd -> ux_slave_dcd_controller_hardware;
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    slave_ed =  ((endpoint_index != 0) && (direction == UX_OHCI_TD_IN)) ?
+                    &dcd_sim_slave -> ux_dcd_sim_slave_ed_in[endpoint_index] :
+                    &dcd_sim_slave -> ux_dcd_sim_slave_ed[endpoint_index];
+#else
+    slave_ed =  &dcd_sim_slave -> ux_dcd_sim_slave_ed[endpoint_index];
+#endif
+
+    /* No answer from an endpoint the device does not have.  */
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_USED) == 0)
+    {
+        _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, td, UX_OHCI_ERROR_DEVICE_NOT_RESPONDING);
+        return(UX_HCD_OHCI_MODEL_TD_RETIRED);
+    }
+
+    /* The device stalls the transaction.  */
+    if (slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_STALLED)
+    {
+        _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, td, UX_OHCI_ERROR_STALL);
+        return(UX_HCD_OHCI_MODEL_TD_RETIRED);
+    }
+
+    /* Get the length left in the TD, from the current buffer pointer to the buffer end.  */
+    td_length =  0;
+    if (td -> ux_ohci_td_cbp != UX_NULL)
+        td_length =  (ULONG) (td -> ux_ohci_td_be - td -> ux_ohci_td_cbp + 1);
+
+    /* The status stage of a control transfer has no data, the request was
+       processed with the SETUP stage.  */
+    if ((endpoint_index == 0) && (td_length == 0))
+    {
+        _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, td, UX_OHCI_NO_ERROR);
+        return(UX_HCD_OHCI_MODEL_TD_RETIRED);
+    }
+
+    /* The device NAKs until it has a transfer ready.  */
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER) == 0)
+    {
+        hcd_ohci_model -> ux_hcd_ohci_model_naks ++;
+        return(UX_HCD_OHCI_MODEL_TD_NAK);
+    }
+
+    /* Get the transfer request of the device.  */
+    slave_endpoint =  slave_ed -> ux_sim_slave_ed_endpoint;
+    slave_transfer_request =  &slave_endpoint -> ux_slave_endpoint_transfer_request;
+
+    /* If the device sends a NULL packet, nothing remains.  */
+    slave_transfer_remaining =  0;
+    if (slave_transfer_request -> ux_slave_transfer_request_requested_length != 0)
+        slave_transfer_remaining =  slave_transfer_request -> ux_slave_transfer_request_requested_length -
+                                    slave_transfer_request -> ux_slave_transfer_request_actual_length;
+
+    /* Get the transaction length to be transferred. It could be a ZLP condition.  */
+    transaction_length =  UX_MIN(slave_transfer_remaining, td_length);
+    if (transaction_length)
+    {
+
+        /* Move the data and the current buffer pointer of the TD.  */
+        if (direction == UX_OHCI_TD_IN)
+            _ux_utility_memory_copy(td -> ux_ohci_td_cbp, slave_transfer_request -> ux_slave_transfer_request_current_data_pointer,
+                                    transaction_length); /* Use case of memcpy is verified. */
+        else
+            _ux_utility_memory_copy(slave_transfer_request -> ux_slave_transfer_request_current_data_pointer, td -> ux_ohci_td_cbp,
+                                    transaction_length); /* Use case of memcpy is verified. */
+        td -> ux_ohci_td_cbp +=  transaction_length;
+    }
+
+    /* Update the device transfer request.  */
+    slave_transfer_request -> ux_slave_transfer_request_current_data_pointer +=  transaction_length;
+    slave_transfer_request -> ux_slave_transfer_request_actual_length +=  transaction_length;
+    td_length -=  transaction_length;
+    hcd_ohci_model -> ux_hcd_ohci_model_bytes +=  transaction_length;
+
+    /* Reset wake booleans.  */
+    wake_host =  UX_FALSE;
+    wake_slave =  UX_FALSE;
+
+    if (slave_endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize == 0)
+    {
+
+        /* Only for tests with no max packet size on the control endpoint.  */
+        wake_host =  UX_TRUE;
+        wake_slave =  UX_TRUE;
+    }
+    else if ((transaction_length == 0) ||
+             (transaction_length % slave_endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize))
+    {
+
+        /* Host got ZLP or short packet.  */
+        wake_host =  UX_TRUE;
+        wake_slave =  UX_TRUE;
+    }
+    else
+    {
+
+        /* Is the TD completed?  */
+        if (td_length == 0)
+            wake_host =  UX_TRUE;
+
+        /* Is the slaves's transfer completed?  */
+        if (slave_transfer_request -> ux_slave_transfer_request_actual_length ==
+            slave_transfer_request -> ux_slave_transfer_request_requested_length)
+        {
+            if (slave_transfer_request -> ux_slave_transfer_request_requested_length == 0 ||
+                slave_transfer_request -> ux_slave_transfer_request_force_zlp == 0)
+                wake_slave =  UX_TRUE;
+            else
+                slave_transfer_request -> ux_slave_transfer_request_force_zlp =  0;
+        }
+    }
+
+    if (wake_slave == UX_TRUE)
+    {
+
+        /* Set the completion code to no error.  */
+        slave_transfer_request -> ux_slave_transfer_request_completion_code =  UX_SUCCESS;
+
+        /* Set the transfer status to COMPLETED.  */
+        slave_transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
+
+        /* Is this not the control endpoint?  */
+        if (slave_ed -> ux_sim_slave_ed_index != 0)
+        {
+
+            /* Clear pending flag and set done flag.  */
+            slave_ed -> ux_sim_slave_ed_status &= ~(ULONG)UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
+            slave_ed -> ux_sim_slave_ed_status |=  UX_DCD_SIM_SLAVE_ED_STATUS_DONE;
+
+            /* Wake up the slave side.  */
+            _ux_device_semaphore_put(&slave_transfer_request -> ux_slave_transfer_request_semaphore);
+        }
+    }
+
+    /* The TD is not complete until the host has all its data.  */
+    if (wake_host == UX_FALSE)
+        return(UX_HCD_OHCI_MODEL_TD_PROGRESS);
+
+    /* The TD is complete. A short packet is a data underrun, unless the TD
+       allows buffer rounding.  */
+    condition_code =  UX_OHCI_NO_ERROR;
+    if ((td_length != 0) && ((td -> ux_ohci_td_dw0 & UX_OHCI_TD_R) == 0))
+        condition_code =  UX_OHCI_ERROR_DATA_UNDERRUN;
+    _ux_hcd_ohci_model_td_retire(hcd_ohci_model, ed, td, condition_code);
+    return(UX_HCD_OHCI_MODEL_TD_RETIRED);
+}
+#endif
@@ -0,0 +1,103 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_td_retire                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function retires a TD of the software OHCI controller model.   */
+/*    The completion code is written to the TD, the head of the ED moves  */
+/*    to the next TD or the ED halts on an error, and the TD is queued on */
+/*    the done queue of the model.                                        */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model                        Pointer to OHCI model         */
+/*    ed                                    Pointer to ED                 */
+/*    td                                    Pointer to TD                 */
+/*    condition_code                        TD completion code            */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_utility_physical_address          Get physical address          */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    OHCI Controller Model                                               */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ohci_model_td_retire(UX_HCD_OHCI_MODEL *hcd_ohci_model, UX_OHCI_ED *ed, UX_OHCI_TD *td, ULONG condition_code)
+{
+
+ULONG       head_flags;
+
+
+    /* The current buffer pointer is cleared when the TD completes without error,
+       else it points to the first byte not transferred.  */
+    if (condition_code == UX_OHCI_NO_ERROR)
+        td -> ux_ohci_td_cbp =  UX_NULL;
+
+    /* Set the completion code of the TD.  */
+    td -> ux_ohci_td_dw0 &= ~UX_HCD_OHCI_MODEL_TD_CC_MASK;
+    td -> ux_ohci_td_dw0 |=  condition_code << UX_OHCI_TD_CC;
+
+    /* The ED goes on with the next TD and keeps the toggle carry, an error halts it.  */
+    head_flags =  (ULONG) ((ALIGN_TYPE) ed -> ux_ohci_ed_head_td & UX_OHCI_ED_TOGGLE_CARRY);
+    if (condition_code != UX_OHCI_NO_ERROR)
+        head_flags |=  UX_OHCI_ED_HALTED;
+    ed -> ux_ohci_ed_head_td =  (UX_OHCI_TD *) ((UCHAR *) td -> ux_ohci_td_next_td + head_flags);
+
+    /* Put the TD at the head of the done queue, the done queue is in reverse order.  */
+    td -> ux_ohci_td_next_td =  hcd_ohci_model -> ux_hcd_ohci_model_done_queue;
+    hcd_ohci_model -> ux_hcd_ohci_model_done_queue =  _ux_utility_physical_address(td);
+    hcd_ohci_model -> ux_hcd_ohci_model_transactions ++;
+}
+#endif
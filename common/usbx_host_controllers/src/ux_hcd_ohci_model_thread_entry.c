@@ -0,0 +1,103 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation 
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ * 
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */ 
+/** USBX Component                                                        */ 
+/**                                                                       */
+/**   OHCI Controller Model                                               */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+/**************************************************************************/ 
+/*                                                                        */ 
+/*  FUNCTION                                               RELEASE        */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_thread_entry                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */ 
+/*    This function is the entry of the software OHCI controller model    */
+/*    thread. A pass of the thread is a frame. The thread runs frames     */
+/*    while the controller is operational, back to back while transfers   */
+/*    progress, else once per tick or when the driver writes a register.  */
+/*                                                                        */ 
+/*  INPUT                                                                 */ 
+/*                                                                        */ 
+/*    hcd_ohci_model_address                Address of OHCI model         */
+/*                                                                        */ 
+/*  OUTPUT                                                                */ 
+/*                                                                        */ 
+/*    None                                                                */
+/*                                                                        */ 
+/*  CALLS                                                                 */ 
+/*                                                                        */ 
+/*    _ux_hcd_ohci_model_schedule           Execute a frame               */
+/*    _ux_host_semaphore_get                Get semaphore                 */
+/*    _ux_utility_thread_relinquish         Relinquish thread             */
+/*                                                                        */ 
+/*  CALLED BY                                                             */ 
+/*                                                                        */ 
+/*    ThreadX                                                             */
+/*                                                                        */ 
+/*  RELEASE HISTORY                                                       */ 
+/*                                                                        */ 
+/*    DATE              NAME                      DESCRIPTION             */ 
+/*                                                                        */ 
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_hcd_ohci_model_thread_entry(ULONG hcd_ohci_model_address)
+{
+
+UX_HCD_OHCI_MODEL       *hcd_ohci_model;
+ULONG                   progress;
+
+
+    /* Get the OHCI model instance.  */
+    UX_THREAD_EXTENSION_PTR_GET(hcd_ohci_model, UX_HCD_OHCI_MODEL, hcd_ohci_model_address)
+
+    /* Loop forever.  */
+    while (1)
+    {
+
+        /* Execute a frame while the controller is operational.  */
+        progress =  UX_FALSE;
+        if ((hcd_ohci_model -> ux_hcd_ohci_model_registers[OHCI_HC_CONTROL] & UX_HCD_OHCI_MODEL_CR_HCFS_MASK) == OHCI_HC_CR_OPERATIONAL)
+            progress =  _ux_hcd_ohci_model_schedule(hcd_ohci_model);
+
+        /* Let the device and the driver serve the transfers that moved, or wait
+           for the next frame.  */
+        if (progress)
+            _ux_utility_thread_relinquish();
+        else
+            _ux_host_semaphore_get(&hcd_ohci_model -> ux_hcd_ohci_model_semaphore, UX_MS_TO_TICK_NON_ZERO(1));
+    }
+}
+#endif
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_next_td_clean                          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -46,6 +46,7 @@
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
+/*    hcd_ohci                              Pointer to OHCI controller    */
 /*    td                                    Pointer to OHCI TD            */ 
 /*                                                                        */ 
 /*  OUTPUT                                                                */ 
@@ -54,6 +55,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
 /*                                                                        */ 
@@ -70,9 +72,12 @@
 /*                                            fixed physical and virtual  */
 /*                                            address conversion,         */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
-VOID  _ux_hcd_ohci_next_td_clean(UX_OHCI_TD *td)
+VOID  _ux_hcd_ohci_next_td_clean(UX_HCD_OHCI *hcd_ohci, UX_OHCI_TD *td)
 {
 
 UX_OHCI_ED      *ed;
@@ -100,12 +105,12 @@ ULONG           value_carry;
     while (head_td != tail_td)
     {
 
-        /* Mark the current head_td as free.  */
-        head_td -> ux_ohci_td_status =  UX_UNUSED;
-
         /* Update the head TD with the next TD.  */
         ed -> ux_ohci_ed_head_td =  head_td -> ux_ohci_td_next_td;
 
+        /* Free the current head_td.  */
+        _ux_hcd_ohci_regular_td_free(hcd_ohci, head_td);
+
         /* Now the new head_td is the next TD in the chain.  */
         head_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_head_td);
     }
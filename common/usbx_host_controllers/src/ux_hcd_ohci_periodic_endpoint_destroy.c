@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_periodic_endpoint_destroy              PORTABLE C      */ 
-/*                                                           6.1.2        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,6 +54,9 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_ed_free                  Free ED                       */
+/*    _ux_hcd_ohci_isochronous_td_free      Free isochronous TD           */
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    _ux_utility_delay_ms                  Delay ms                      */ 
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
@@ -72,6 +75,9 @@
 /*  11-09-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.1.2  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_periodic_endpoint_destroy(UX_HCD_OHCI *hcd_ohci, UX_ENDPOINT *endpoint)
@@ -85,8 +91,6 @@ UX_OHCI_TD      *head_td;
 ULONG           value_td;
 
 
-    UX_PARAMETER_NOT_USED(hcd_ohci);
-
     /* From the endpoint container fetch the OHCI ED descriptor.  */
     ed =  (UX_OHCI_ED*) endpoint -> ux_endpoint_ed;
 
@@ -143,18 +147,24 @@ ULONG           value_td;
         /* Update the head TD with the next TD.  */
         ed -> ux_ohci_ed_head_td =  head_td -> ux_ohci_td_next_td;
 
-        /* Mark the current head TD as free.  */
-        head_td -> ux_ohci_td_status =  UX_UNUSED;
+        /* Free the current head TD, isochronous TDs have their own list.  */
+        if (ed -> ux_ohci_ed_dw0 & UX_OHCI_ED_ISOCHRONOUS)
+            _ux_hcd_ohci_isochronous_td_free(hcd_ohci, (UX_OHCI_ISO_TD *) head_td);
+        else
+            _ux_hcd_ohci_regular_td_free(hcd_ohci, head_td);
 
         /* Now the new head TD is the next TD in the chain.  */
         head_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_head_td);
     }
 
     /* We need to free the dummy TD that was attached to the ED.  */
-    tail_td -> ux_ohci_td_status =  UX_UNUSED;
+    if (ed -> ux_ohci_ed_dw0 & UX_OHCI_ED_ISOCHRONOUS)
+        _ux_hcd_ohci_isochronous_td_free(hcd_ohci, (UX_OHCI_ISO_TD *) tail_td);
+    else
+        _ux_hcd_ohci_regular_td_free(hcd_ohci, tail_td);
 
     /* Now we can safely make the ED free.  */
-    ed -> ux_ohci_ed_status =  UX_UNUSED;
+    _ux_hcd_ohci_ed_free(hcd_ohci, ed);
 
     /* Return success.  */
     return(UX_SUCCESS);         
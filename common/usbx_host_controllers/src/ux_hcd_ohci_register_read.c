@@ -26,6 +26,7 @@
 
 #include "ux_api.h"
 #include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
 #include "ux_host_stack.h"
 
 
@@ -34,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_register_read                          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,12 +68,23 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added software controller   */
+/*                                            model,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 ULONG  _ux_hcd_ohci_register_read(UX_HCD_OHCI *hcd_ohci, ULONG ohci_register)
 {
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+    /* The registers are in the software controller model.  */
+    return(_ux_hcd_ohci_model_register_read((UX_HCD_OHCI_MODEL *) hcd_ohci -> ux_hcd_ohci_hcor, ohci_register));
+#else
     
     /* Return the value.  */
     return(*(hcd_ohci -> ux_hcd_ohci_hcor + ohci_register));
+#endif
 }
 
@@ -26,6 +26,7 @@
 
 #include "ux_api.h"
 #include "ux_hcd_ohci.h"
+#include "ux_hcd_ohci_model.h"
 #include "ux_host_stack.h"
 
 
@@ -34,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_register_write                         PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -68,13 +69,24 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added software controller   */
+/*                                            model,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_hcd_ohci_register_write(UX_HCD_OHCI *hcd_ohci, ULONG ohci_register, ULONG value)
 {
+
+#if defined(UX_HCD_OHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+    /* The registers are in the software controller model.  */
+    _ux_hcd_ohci_model_register_write((UX_HCD_OHCI_MODEL *) hcd_ohci -> ux_hcd_ohci_hcor, ohci_register, value);
+#else
     
     /* Write to the register.  */
     *(hcd_ohci -> ux_hcd_ohci_hcor + ohci_register) =  value;
+#endif
 
     /* Return to caller.  */
     return;
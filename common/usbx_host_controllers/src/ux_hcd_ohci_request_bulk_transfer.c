@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_request_bulk_transfer                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,7 @@
 /*                                                                        */ 
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    _ux_hcd_ohci_regular_td_obtain        Get regular TD                */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
@@ -75,6 +76,11 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added transfer              */
+/*                                            scatter-gather,             */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_request_bulk_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -92,6 +98,10 @@ ULONG           bulk_packet_payload_length;
 UCHAR *         data_pointer;
 ULONG           ohci_register;
 ULONG           zlp_flag;
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+UX_TRANSFER_SEGMENT *segment;
+ULONG           segment_count;
+#endif
     
 
     /* Get the pointer to the Endpoint.  */
@@ -113,6 +123,15 @@ ULONG           zlp_flag;
        the endpoint descriptor). OHCI data payload has a maximum size of 4K.  */
     transfer_request_payload_length =  transfer_request -> ux_transfer_request_requested_length;
     data_pointer =  transfer_request -> ux_transfer_request_data_pointer;
+
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+    /* A scatter-gather transfer starts with its first segment.  */
+    segment =  transfer_request -> ux_transfer_request_segments;
+    segment_count =  transfer_request -> ux_transfer_request_segment_count;
+    if (segment_count != 0)
+        transfer_request_payload_length =  segment -> ux_transfer_segment_length;
+#endif
     
     /* Check for ZLP condition.  */
     if (transfer_request_payload_length == 0)
@@ -164,6 +183,18 @@ ULONG           zlp_flag;
         transfer_request_payload_length -=  bulk_packet_payload_length;
         data_pointer +=  bulk_packet_payload_length;
 
+#if defined(UX_HOST_TRANSFER_SCATTER_GATHER)
+
+        /* At the end of a segment, go on with the next one.  */
+        if ((transfer_request_payload_length == 0) && (segment_count > 1))
+        {
+            segment++;
+            segment_count--;
+            data_pointer =  segment -> ux_transfer_segment_data_pointer;
+            transfer_request_payload_length =  segment -> ux_transfer_segment_length;
+        }
+#endif
+
         /* Check if there will be another transaction.  */
         if (transfer_request_payload_length != 0)
         {
@@ -183,7 +214,7 @@ ULONG           zlp_flag;
                     {
 
                         next_data_td =  _ux_utility_virtual_address(data_td -> ux_ohci_td_next_td);
-                        data_td -> ux_ohci_td_status =  UX_UNUSED;
+                        _ux_hcd_ohci_regular_td_free(hcd_ohci, data_td);
                         data_td =  next_data_td;
                     }
                 }
@@ -217,7 +248,7 @@ ULONG           zlp_flag;
             {
 
                 next_data_td =  _ux_utility_virtual_address(data_td -> ux_ohci_td_next_td);
-                data_td -> ux_ohci_td_status =  UX_UNUSED;
+                _ux_hcd_ohci_regular_td_free(hcd_ohci, data_td);
                 data_td =  next_data_td;
             }
         }
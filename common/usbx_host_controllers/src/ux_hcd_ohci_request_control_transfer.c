@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_request_control_transfer               PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,10 +63,9 @@
 /*                                                                        */ 
 /*    _ux_hcd_ohci_register_read            Read OHCI register            */ 
 /*    _ux_hcd_ohci_register_write           Write OHCI register           */ 
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    _ux_hcd_ohci_regular_td_obtain        Get regular TD                */ 
 /*    _ux_host_stack_transfer_request_abort Abort transfer request        */ 
-/*    _ux_utility_memory_allocate           Allocate memory block         */ 
-/*    _ux_utility_memory_free               Release memory block          */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_host_semaphore_get                Get semaphore                 */ 
 /*    _ux_utility_short_put                 Write 16-bit value            */ 
@@ -90,6 +89,13 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used setup buffer in TD     */
+/*                                            instead of allocating,      */
+/*                                            counted timeouts in         */
+/*                                            endpoint statistics,        */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_request_control_transfer(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -115,10 +121,12 @@ UINT            status;
     /* Now get the physical ED attached to this endpoint.  */
     ed =  endpoint -> ux_endpoint_ed;
 
-    /* Build the SETUP packet (phase 1 of the control transfer).  */
-    setup_request =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_SETUP_SIZE);
-    if (setup_request == UX_NULL)
-        return(UX_MEMORY_INSUFFICIENT);
+    /* Use the TD pointer by ed -> tail for our setup TD and chain from this one on.  */
+    setup_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_tail_td);
+
+    /* Build the SETUP packet (phase 1 of the control transfer), in the cache
+       safe setup TD memory.  */
+    setup_request =  setup_td -> ux_ohci_td_setup;
 
     *setup_request =                            (UCHAR)transfer_request -> ux_transfer_request_function;
     *(setup_request + UX_SETUP_REQUEST_TYPE) =  (UCHAR)transfer_request -> ux_transfer_request_type;
@@ -136,8 +144,7 @@ UINT            status;
     if (device -> ux_device_speed == UX_LOW_SPEED_DEVICE)
         ed -> ux_ohci_ed_dw0 |=  UX_OHCI_ED_LOW_SPEED;
 
-    /* Use the TD pointer by ed -> tail for our setup TD and chain from this one on.  */
-    setup_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_tail_td);
+    /* Program the setup TD.  */
     setup_td -> ux_ohci_td_dw0 =  UX_OHCI_TD_DEFAULT_DW0 | UX_OHCI_TD_DATA0 | UX_OHCI_TD_R;
     setup_td -> ux_ohci_td_cbp =  _ux_utility_physical_address(setup_request);
     setup_td -> ux_ohci_td_be =   setup_td -> ux_ohci_td_cbp + UX_SETUP_SIZE - 1;
@@ -159,7 +166,6 @@ UINT            status;
         if (data_td == UX_NULL)
         {
 
-            _ux_utility_memory_free(setup_request);
             return(UX_NO_TD_AVAILABLE);
         }
 
@@ -195,9 +201,8 @@ UINT            status;
     if (status_td == UX_NULL)
     {
 
-        _ux_utility_memory_free(setup_request);
         if (data_td != UX_NULL)
-            data_td -> ux_ohci_td_status =  UX_UNUSED;
+            _ux_hcd_ohci_regular_td_free(hcd_ohci, data_td);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -230,10 +235,9 @@ UINT            status;
     if (tail_td == UX_NULL)
     {
 
-        _ux_utility_memory_free(setup_request);
         if (data_td != UX_NULL)
-            data_td -> ux_ohci_td_status =  UX_UNUSED;
-        status_td -> ux_ohci_td_status =  UX_UNUSED;
+            _ux_hcd_ohci_regular_td_free(hcd_ohci, data_td);
+        _ux_hcd_ohci_regular_td_free(hcd_ohci, status_td);
         return(UX_NO_TD_AVAILABLE);
     }
 
@@ -263,6 +267,7 @@ UINT            status;
         
         /* There was an error, return to the caller.  */
         transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+        UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
 
         /* Error trap. */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HCD, UX_TRANSFER_TIMEOUT);
@@ -272,9 +277,6 @@ UINT            status;
         
     }            
 
-    /* Free the resources.  */
-    _ux_utility_memory_free(setup_request);
-
     /* Return the completion status.  */
     return(transfer_request -> ux_transfer_request_completion_code);           
 }
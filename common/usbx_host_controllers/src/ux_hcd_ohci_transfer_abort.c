@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_hcd_ohci_transfer_abort                         PORTABLE C      */ 
-/*                                                           6.1.2        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_hcd_ohci_isochronous_td_free      Free isochronous TD           */
+/*    _ux_hcd_ohci_regular_td_free          Free TD                       */
 /*    _ux_utility_delay_ms                  Delay                         */ 
 /*    _ux_utility_physical_address          Get physical address          */ 
 /*    _ux_utility_virtual_address           Get virtual address           */ 
@@ -75,6 +77,9 @@
 /*  11-09-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed compile warnings,     */
 /*                                            resulting in version 6.1.2  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used ED and TD free lists,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_ohci_transfer_abort(UX_HCD_OHCI *hcd_ohci, UX_TRANSFER *transfer_request)
@@ -88,8 +93,6 @@ ULONG           value_td;
 ULONG           value_carry;
 
 
-    UX_PARAMETER_NOT_USED(hcd_ohci);
-
     /* Get the pointer to the endpoint associated with the transfer request.  */
     endpoint =  (UX_ENDPOINT *) transfer_request -> ux_transfer_request_endpoint;
     
@@ -133,8 +136,11 @@ ULONG           value_carry;
         /* Update the head TD with the next TD.  */
         ed -> ux_ohci_ed_head_td =  head_td -> ux_ohci_td_next_td;
 
-        /* Mark the current head TD as free.  */
-        head_td -> ux_ohci_td_status =  UX_UNUSED;
+        /* Free the current head TD, isochronous TDs have their own list.  */
+        if (ed -> ux_ohci_ed_dw0 & UX_OHCI_ED_ISOCHRONOUS)
+            _ux_hcd_ohci_isochronous_td_free(hcd_ohci, (UX_OHCI_ISO_TD *) head_td);
+        else
+            _ux_hcd_ohci_regular_td_free(hcd_ohci, head_td);
 
         /* Now the new head TD is the next TD in the chain.  */
         head_td =  _ux_utility_virtual_address(ed -> ux_ohci_ed_head_td);
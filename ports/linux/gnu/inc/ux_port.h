@@ -25,7 +25,7 @@
 /*  PORT SPECIFIC C INFORMATION                            RELEASE        */ 
 /*                                                                        */ 
 /*    ux_port.h                                           Linux/GNU       */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*                                                                        */
 /*  AUTHOR                                                                */
 /*                                                                        */
@@ -49,6 +49,15 @@
 /*                                            added basic types guards,   */
 /*                                            improved SLONG typedef,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added memory copy, set and  */
+/*                                            compare override example,   */
+/*                                            added data cache            */
+/*                                            maintenance counters,       */
+/*                                            added endpoint statistics,  */
+/*                                            added enumeration timeline  */
+/*                                            timestamp,                  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -245,6 +254,86 @@ ULONG   outpl(ULONG,ULONG);
 #endif
 
 
+/* Define optimized memory copy, set and compare, the word access version in USBX core is
+   used if they are not defined. The C library versions can be used, e.g.:
+#define UX_MEMORY_COPY(dst,src,len)     memmove((dst),(src),(len))
+#define UX_MEMORY_SET(dst,val,len)      memset((dst),(val),(len))
+#define UX_MEMORY_COMPARE(src,dst,len)  memcmp((src),(dst),(len))
+   Note string.h must be included for them.  */
+
+
+/* Define data cache maintenance. There is no data cache to maintain for the Linux
+   simulation, the operations are counted so the cache maintenance done by USBX can be
+   checked. Buffers that do not start on a cache line are counted as unaligned.  */
+
+#if defined(UX_ENABLE_DATA_CACHE_MAINTENANCE)
+
+typedef struct UX_PORT_DATA_CACHE_STATISTICS_STRUCT
+{
+
+    ULONG           ux_port_data_cache_clean_count;
+    ULONG           ux_port_data_cache_clean_bytes;
+    ULONG           ux_port_data_cache_invalidate_count;
+    ULONG           ux_port_data_cache_invalidate_bytes;
+    ULONG           ux_port_data_cache_unaligned_count;
+    VOID            *ux_port_data_cache_clean_last;
+    VOID            *ux_port_data_cache_invalidate_last;
+} UX_PORT_DATA_CACHE_STATISTICS;
+
+extern UX_PORT_DATA_CACHE_STATISTICS    _ux_port_data_cache_statistics;
+
+VOID    _ux_port_data_cache_clean(VOID *address, ULONG length);
+VOID    _ux_port_data_cache_invalidate(VOID *address, ULONG length);
+
+#define UX_DATA_CACHE_CLEAN(address,length)         _ux_port_data_cache_clean((VOID *)(address), (ULONG)(length))
+#define UX_DATA_CACHE_INVALIDATE(address,length)    _ux_port_data_cache_invalidate((VOID *)(address), (ULONG)(length))
+#endif
+
+
+/* Define the timestamp of trace ring events, endpoint statistics and enumeration timelines,
+   in microseconds from the monotonic clock.  */
+
+#if defined(UX_ENABLE_TRACE_RING) || defined(UX_ENABLE_ENDPOINT_STATISTICS) || \
+    defined(UX_ENABLE_ENUMERATION_TIMELINE)
+ULONG   _ux_port_timestamp_get(VOID);
+#endif
+
+
+/* Define the trace ring index reservation and timestamp. The index is reserved with an atomic
+   increment.  */
+
+#if defined(UX_ENABLE_TRACE_RING)
+#define UX_TRACE_RING_INDEX_RESERVE(index_ptr)      __atomic_fetch_add((index_ptr), 1, __ATOMIC_RELAXED)
+#define UX_TRACE_RING_TIMESTAMP_GET()               _ux_port_timestamp_get()
+#define UX_TRACE_RING_TIMESTAMP_FREQUENCY           1000000
+#endif
+
+
+/* Define the endpoint statistics latency timestamp and the bit length used to select the
+   latency histogram bin.  */
+
+#if defined(UX_ENABLE_ENDPOINT_STATISTICS)
+#define UX_ENDPOINT_STATISTICS_TIMESTAMP_GET()      _ux_port_timestamp_get()
+#define UX_ENDPOINT_STATISTICS_TIMESTAMP_FREQUENCY  1000000
+#define UX_ENDPOINT_STATISTICS_BIT_LENGTH(value)    ((value) ? (ULONG)(32 - __builtin_clz((unsigned int)(value))) : 0)
+#endif
+
+
+/* Define the enumeration timeline timestamp.  */
+
+#if defined(UX_ENABLE_ENUMERATION_TIMELINE)
+#define UX_ENUMERATION_TIMELINE_TIMESTAMP_GET()     _ux_port_timestamp_get()
+#define UX_ENUMERATION_TIMELINE_TIMESTAMP_FREQUENCY 1000000
+#endif
+
+
+/* Define the debug log record reservation with an atomic increment.  */
+
+#if defined(UX_ENABLE_DEBUG_LOG)
+#define UX_DEBUG_LOG_INDEX_RESERVE(index_ptr)       __atomic_fetch_add((index_ptr), 1, __ATOMIC_RELAXED)
+#endif
+
+
 /* Define interrupt lockout constructs to protect the memory allocation/release which could happen
    under ISR in the device stack.  */
 
@@ -0,0 +1,157 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Port Specific                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+
+
+#if defined(UX_ENABLE_DATA_CACHE_MAINTENANCE)
+
+/* Define the data cache maintenance statistics.  */
+
+UX_PORT_DATA_CACHE_STATISTICS   _ux_port_data_cache_statistics;
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_port_data_cache_clean                           Linux/GNU       */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function cleans (writes back) the data cache lines of a        */
+/*    buffer before a controller reads or writes it. There is no data     */
+/*    cache in the simulation, the operation is counted.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    address                               Buffer address                */
+/*    length                                Buffer length in bytes        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_port_data_cache_clean(VOID *address, ULONG length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Transfers are started from different threads.  */
+    UX_DISABLE
+
+    /* Count the operation.  */
+    _ux_port_data_cache_statistics.ux_port_data_cache_clean_count ++;
+    _ux_port_data_cache_statistics.ux_port_data_cache_clean_bytes +=  length;
+    _ux_port_data_cache_statistics.ux_port_data_cache_clean_last =  address;
+    if (((ALIGN_TYPE)address) & UX_CACHE_LINE_ALIGN)
+        _ux_port_data_cache_statistics.ux_port_data_cache_unaligned_count ++;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_port_data_cache_invalidate                      Linux/GNU       */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function invalidates the data cache lines of a buffer after a  */
+/*    controller has written it. There is no data cache in the            */
+/*    simulation, the operation is counted.                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    address                               Buffer address                */
+/*    length                                Buffer length in bytes        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_port_data_cache_invalidate(VOID *address, ULONG length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Transfers are completed from different threads.  */
+    UX_DISABLE
+
+    /* Count the operation.  */
+    _ux_port_data_cache_statistics.ux_port_data_cache_invalidate_count ++;
+    _ux_port_data_cache_statistics.ux_port_data_cache_invalidate_bytes +=  length;
+    _ux_port_data_cache_statistics.ux_port_data_cache_invalidate_last =  address;
+    if (((ALIGN_TYPE)address) & UX_CACHE_LINE_ALIGN)
+        _ux_port_data_cache_statistics.ux_port_data_cache_unaligned_count ++;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
@@ -0,0 +1,89 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Port Specific                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+/* The monotonic clock is a POSIX extension.  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <time.h>
+#include "ux_api.h"
+
+
+#if defined(UX_ENABLE_TRACE_RING) || defined(UX_ENABLE_ENDPOINT_STATISTICS) || \
+    defined(UX_ENABLE_ENUMERATION_TIMELINE)
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_port_timestamp_get                              Linux/GNU       */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the timestamp of trace ring events, endpoint  */
+/*    statistics and enumeration timelines, in microseconds from the      */
+/*    monotonic clock. It wraps after about 71 minutes.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Timestamp                                                           */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    clock_gettime                         Get monotonic time            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _ux_trace_ring_insert                 Insert trace ring event       */
+/*    USBX Components                                                     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_port_timestamp_get(VOID)
+{
+
+struct timespec     now;
+
+
+    /* Get the monotonic time, the timestamp keeps the low 32 bits.  */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return((ULONG)((ULONG64)now.tv_sec * 1000000u + (ULONG64)now.tv_nsec / 1000u) & 0xFFFFFFFFu);
+}
+#endif
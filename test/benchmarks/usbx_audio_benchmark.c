@@ -0,0 +1,734 @@
+/* This benchmark measures the sustained audio streaming rate between the simulated host and device.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_audio.h"
+#include "ux_benchmark.h"
+
+
+/* Define constants.  */
+
+#define UX_DEMO_STACK_SIZE                  4096
+#define UX_DEMO_MEMORY_SIZE                 (128*1024)
+
+
+/* Define benchmark constants, one packet is 1ms of 48kHz 16-bit stereo.  */
+
+#define UX_BENCHMARK_AUDIO_PACKETS          256
+#define UX_BENCHMARK_AUDIO_PACKET_SIZE      192
+#define UX_BENCHMARK_AUDIO_MAX_PACKET_SIZE  256
+#define UX_BENCHMARK_AUDIO_REQUESTS         4
+#define UX_BENCHMARK_AUDIO_FRAMES           8
+
+
+/* Define local/extern function prototypes.  */
+
+static TX_THREAD                                tx_demo_thread_host_simulation;
+static TX_THREAD                                tx_demo_thread_slave_simulation;
+static TX_THREAD                                tx_demo_thread_bus_simulation;
+static void                                     tx_demo_thread_host_simulation_entry(ULONG);
+static void                                     tx_demo_thread_slave_simulation_entry(ULONG);
+static void                                     tx_demo_thread_bus_simulation_entry(ULONG);
+
+
+/* Define global data structures.  */
+
+static UX_HOST_CLASS_AUDIO                      *host_audio_tx;
+static UX_HOST_CLASS_AUDIO                      *host_audio_rx;
+static UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST     audio_transfer[UX_BENCHMARK_AUDIO_REQUESTS];
+static UCHAR                                    host_audio_buffer[UX_BENCHMARK_AUDIO_REQUESTS][UX_BENCHMARK_AUDIO_MAX_PACKET_SIZE];
+static TX_SEMAPHORE                             host_request_semaphore;
+static ULONG                                    host_request_errors;
+static ULONG                                    host_bytes;
+
+static UX_DEVICE_CLASS_AUDIO                    *slave_audio;
+static UX_DEVICE_CLASS_AUDIO_PARAMETER          slave_audio_parameter;
+static UX_DEVICE_CLASS_AUDIO_STREAM_PARAMETER   slave_audio_stream_parameter[2];
+static UX_DEVICE_CLASS_AUDIO_STREAM             *slave_audio_tx_stream;
+static UX_DEVICE_CLASS_AUDIO_STREAM             *slave_audio_rx_stream;
+static UCHAR                                    slave_audio_frame[UX_BENCHMARK_AUDIO_PACKET_SIZE];
+static ULONG                                    slave_frames_received;
+static TX_SEMAPHORE                             device_start_semaphore;
+
+
+#define D3(d) ((UCHAR)((d) >> 24))
+#define D2(d) ((UCHAR)((d) >> 16))
+#define D1(d) ((UCHAR)((d) >> 8))
+#define D0(d) ((UCHAR)((d) >> 0))
+
+static unsigned char device_framework_full_speed[] = {
+
+/* --------------------------------------- Device Descriptor */
+/* 0  bLength, bDescriptorType                               */ 18,   0x01,
+/* 2  bcdUSB                                                 */ D0(0x200),D1(0x200),
+/* 4  bDeviceClass, bDeviceSubClass, bDeviceProtocol         */ 0x00, 0x00, 0x00,
+/* 7  bMaxPacketSize0                                        */ 0x08,
+/* 8  idVendor, idProduct                                    */ 0x84, 0x84, 0x01, 0x00,
+/* 12 bcdDevice                                              */ D0(0x100),D1(0x100),
+/* 14 iManufacturer, iProduct, iSerialNumber                 */ 0,    0,    0,
+/* 17 bNumConfigurations                                     */ 1,
+
+/* -------------------------------- Configuration Descriptor *//* 9+8+88+52*2=209 */
+/* 0 bLength, bDescriptorType                                */ 9,    0x02,
+/* 2 wTotalLength                                            */ D0(209),D1(209),
+/* 4 bNumInterfaces, bConfigurationValue                     */ 3,    1,
+/* 6 iConfiguration                                          */ 0,
+/* 7 bmAttributes, bMaxPower                                 */ 0x80, 50,
+
+/* ------------------------ Interface Association Descriptor */
+/* 0 bLength, bDescriptorType                                */ 8,    0x0B,
+/* 2 bFirstInterface, bInterfaceCount                        */ 0,    3,
+/* 4 bFunctionClass, bFunctionSubClass, bFunctionProtocol    */ 0x01, 0x01, 0x00,
+/* 7 iFunction                                               */ 0,
+
+/* ------------------------------------ Interface Descriptor *//* 0 Control (9+72+7=88) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 0,    0,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x01, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ---------------- Audio 1.0 AC Interface Header Descriptor *//* (10+12*2+10*2+9*2=72) */
+/* 0 bLength, bDescriptorType, bDescriptorSubtype            */ 10,            0x24, 0x01,
+/* 3 bcdADC                                                  */ 0x00,          0x01,
+/* 5 wTotalLength, bInCollection                             */ D0(72),D1(72), 2,
+/* 8 baInterfaceNr(1) ... baInterfaceNr(n)                   */ 1,             2,
+/* ------------------- Audio 1.0 AC Input Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 12,   0x24,                 0x02,
+/* 3  bTerminalID, wTerminalType                              */ 0x01, D0(0x0201),D1(0x0201),
+/* 6  bAssocTerminal,                                         */ 0x00,
+/* 7  bNrChannels, wChannelConfig                             */ 0x02, D0(0),D1(0),
+/* 10 iChannelNames, iTerminal                                */ 0,    0,
+/* --------------------- Audio 1.0 AC Feature Unit Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 10,   0x24, 0x06,
+/* 3  bUnitID, bSourceID                                      */ 0x02, 0x01,
+/* 5  bControlSize                                            */ 1,
+/* 6  bmaControls(0) ... bmaControls(...) ...                 */ 0x00, 0x00, 0x00,
+/* .  iFeature                                                */ 0,
+/* ------------------ Audio 1.0 AC Output Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 9,    0x24,                 0x03,
+/* 3  bTerminalID, wTerminalType                              */ 0x03, D0(0x0101),D1(0x0101),
+/* 6  bAssocTerminal, bSourceID                               */ 0x00, 0x02,
+/* 8  iTerminal                                               */ 0,
+/* ------------------- Audio 1.0 AC Input Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 12,   0x24,                 0x02,
+/* 3  bTerminalID, wTerminalType                              */ 0x04, D0(0x0101),D1(0x0101),
+/* 6  bAssocTerminal,                                         */ 0x00,
+/* 7  bNrChannels, wChannelConfig                             */ 0x02, D0(0),D1(0),
+/* 10 iChannelNames, iTerminal                                */ 0,    0,
+/* --------------------- Audio 1.0 AC Feature Unit Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 10,   0x24, 0x06,
+/* 3  bUnitID, bSourceID                                      */ 0x05, 0x04,
+/* 5  bControlSize                                            */ 1,
+/* 6  bmaControls(0) ... bmaControls(...) ...                 */ 0x00, 0x00, 0x00,
+/* .  iFeature                                                */ 0,
+/* ------------------ Audio 1.0 AC Output Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 9,    0x24,                 0x03,
+/* 3  bTerminalID, wTerminalType                              */ 0x06, D0(0x0301),D1(0x0301),
+/* 6  bAssocTerminal, bSourceID                               */ 0x00, 0x05,
+/* 8  iTerminal                                               */ 0,
+/* --------------------- Audio 1.0 AC INT Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 7,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x83,            0x03,
+/* 4  wMaxPacketSize, bInterval                               */ D0(8),D1(8),     1,
+
+/* ------------------------------------ Interface Descriptor *//* 1 Stream IN (9+9+7+11+9+7=52) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------------------ Interface Descriptor */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    1,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------ Audio 1.0 AS Interface Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,    0x24, 0x01,
+/* 3  bTerminalLink                                           */ 0x03,
+/* 4  bDelay, wFormatTag                                      */ 0x00, D0(0x0001),D1(0x0001),
+/* -------------------------- Audio AS Format Type Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 11,   0x24, 0x02,
+/* 3  bFormatType, bNrChannels, bSubframeSize, bBitResolution */ 0x01, 0x02, 0x02, 16,
+/* 7  bSamFreqType (n), tSamFreq[1] ... tSamFreq[n]           */ 1,    D0(48000),D1(48000),D2(48000),
+/* --------------------- Audio 1.0 AS ISO Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 9,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x81,            0x01,
+/* 4  wMaxPacketSize, bInterval, bRefresh, bSynchAddress      */ D0(256),D1(256), 1,    0, 0,
+/* ---------- Audio 1.0 AS ISO Audio Data Endpoint Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,                0x25, 0x01,
+/* 3  bmAttributes                                            */ 0x00,
+/* 5  bLockDelayUnits, wLockDelay                             */ 0x00, D0(0),D1(0),
+
+/* ------------------------------------ Interface Descriptor *//* 2 Stream OUT (9+9+7+11+9+7=52) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 2,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------------------ Interface Descriptor */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 2,    1,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------ Audio 1.0 AS Interface Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,    0x24, 0x01,
+/* 3  bTerminalLink                                           */ 0x04,
+/* 4  bDelay, wFormatTag                                      */ 0x00, D0(0x0001),D1(0x0001),
+/* -------------------------- Audio AS Format Type Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 11,   0x24, 0x02,
+/* 3  bFormatType, bNrChannels, bSubframeSize, bBitResolution */ 0x01, 0x02, 0x02, 16,
+/* 7  bSamFreqType (n), tSamFreq[1] ... tSamFreq[n]           */ 1,    D0(48000),D1(48000),D2(48000),
+/* --------------------- Audio 1.0 AS ISO Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 9,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x02,            0x01,
+/* 4  wMaxPacketSize, bInterval, bRefresh, bSynchAddress      */ D0(256),D1(256), 1,    0, 0,
+/* ---------- Audio 1.0 AS ISO Audio Data Endpoint Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,                0x25, 0x01,
+/* 3  bmAttributes                                            */ 0x00,
+/* 5  bLockDelayUnits, wLockDelay                             */ 0x00, D0(0),D1(0),
+};
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED sizeof(device_framework_full_speed)
+
+static unsigned char device_framework_high_speed[] = {
+/* --------------------------------------- Device Descriptor */
+/* 0  bLength, bDescriptorType                               */ 18,   0x01,
+/* 2  bcdUSB                                                 */ D0(0x200),D1(0x200),
+/* 4  bDeviceClass, bDeviceSubClass, bDeviceProtocol         */ 0x00, 0x00, 0x00,
+/* 7  bMaxPacketSize0                                        */ 8,
+/* 8  idVendor, idProduct                                    */ 0x84, 0x84, 0x01, 0x00,
+/* 12 bcdDevice                                              */ D0(0x100),D1(0x100),
+/* 14 iManufacturer, iProduct, iSerialNumber                 */ 0,    0,    0,
+/* 17 bNumConfigurations                                     */ 1,
+
+/* ----------------------------- Device Qualifier Descriptor */
+/* 0 bLength, bDescriptorType                                */ 10,                 0x06,
+/* 2 bcdUSB                                                  */ D0(0x200),D1(0x200),
+/* 4 bDeviceClass, bDeviceSubClass, bDeviceProtocol          */ 0x00,               0x00, 0x00,
+/* 7 bMaxPacketSize0                                         */ 8,
+/* 8 bNumConfigurations                                      */ 1,
+/* 9 bReserved                                               */ 0,
+
+/* -------------------------------- Configuration Descriptor *//* 9+8+88+52*2=209 */
+/* 0 bLength, bDescriptorType                                */ 9,    0x02,
+/* 2 wTotalLength                                            */ D0(209),D1(209),
+/* 4 bNumInterfaces, bConfigurationValue                     */ 3,    1,
+/* 6 iConfiguration                                          */ 0,
+/* 7 bmAttributes, bMaxPower                                 */ 0x80, 50,
+
+/* ------------------------ Interface Association Descriptor */
+/* 0 bLength, bDescriptorType                                */ 8,    0x0B,
+/* 2 bFirstInterface, bInterfaceCount                        */ 0,    3,
+/* 4 bFunctionClass, bFunctionSubClass, bFunctionProtocol    */ 0x01, 0x01, 0x00,
+/* 7 iFunction                                               */ 0,
+
+/* ------------------------------------ Interface Descriptor *//* 0 Control (9+72+7=88) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 0,    0,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x01, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ---------------- Audio 1.0 AC Interface Header Descriptor *//* (10+12*2+10*2+9*2=72) */
+/* 0 bLength, bDescriptorType, bDescriptorSubtype            */ 10,            0x24, 0x01,
+/* 3 bcdADC                                                  */ 0x00,          0x01,
+/* 5 wTotalLength, bInCollection                             */ D0(72),D1(72), 2,
+/* 8 baInterfaceNr(1) ... baInterfaceNr(n)                   */ 1,             2,
+/* ------------------- Audio 1.0 AC Input Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 12,   0x24,                 0x02,
+/* 3  bTerminalID, wTerminalType                              */ 0x01, D0(0x0201),D1(0x0201),
+/* 6  bAssocTerminal,                                         */ 0x00,
+/* 7  bNrChannels, wChannelConfig                             */ 0x02, D0(0),D1(0),
+/* 10 iChannelNames, iTerminal                                */ 0,    0,
+/* --------------------- Audio 1.0 AC Feature Unit Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 10,   0x24, 0x06,
+/* 3  bUnitID, bSourceID                                      */ 0x02, 0x01,
+/* 5  bControlSize                                            */ 1,
+/* 6  bmaControls(0) ... bmaControls(...) ...                 */ 0x00, 0x00, 0x00,
+/* .  iFeature                                                */ 0,
+/* ------------------ Audio 1.0 AC Output Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 9,    0x24,                 0x03,
+/* 3  bTerminalID, wTerminalType                              */ 0x03, D0(0x0101),D1(0x0101),
+/* 6  bAssocTerminal, bSourceID                               */ 0x00, 0x02,
+/* 8  iTerminal                                               */ 0,
+/* ------------------- Audio 1.0 AC Input Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 12,   0x24,                 0x02,
+/* 3  bTerminalID, wTerminalType                              */ 0x04, D0(0x0101),D1(0x0101),
+/* 6  bAssocTerminal,                                         */ 0x00,
+/* 7  bNrChannels, wChannelConfig                             */ 0x02, D0(0),D1(0),
+/* 10 iChannelNames, iTerminal                                */ 0,    0,
+/* --------------------- Audio 1.0 AC Feature Unit Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 10,   0x24, 0x06,
+/* 3  bUnitID, bSourceID                                      */ 0x05, 0x04,
+/* 5  bControlSize                                            */ 1,
+/* 6  bmaControls(0) ... bmaControls(...) ...                 */ 0x00, 0x00, 0x00,
+/* .  iFeature                                                */ 0,
+/* ------------------ Audio 1.0 AC Output Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 9,    0x24,                 0x03,
+/* 3  bTerminalID, wTerminalType                              */ 0x06, D0(0x0301),D1(0x0301),
+/* 6  bAssocTerminal, bSourceID                               */ 0x00, 0x05,
+/* 8  iTerminal                                               */ 0,
+/* --------------------- Audio 1.0 AC INT Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 7,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x83,            0x03,
+/* 4  wMaxPacketSize, bInterval                               */ D0(8),D1(8),     4,
+
+/* ------------------------------------ Interface Descriptor *//* 1 Stream IN (9+9+7+11+9+7=52) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------------------ Interface Descriptor */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    1,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------ Audio 1.0 AS Interface Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,    0x24, 0x01,
+/* 3  bTerminalLink                                           */ 0x03,
+/* 4  bDelay, wFormatTag                                      */ 0x00, D0(0x0001),D1(0x0001),
+/* -------------------------- Audio AS Format Type Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 11,   0x24, 0x02,
+/* 3  bFormatType, bNrChannels, bSubframeSize, bBitResolution */ 0x01, 0x02, 0x02, 16,
+/* 7  bSamFreqType (n), tSamFreq[1] ... tSamFreq[n]           */ 1,    D0(48000),D1(48000),D2(48000),
+/* --------------------- Audio 1.0 AS ISO Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 9,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x81,            0x01,
+/* 4  wMaxPacketSize, bInterval, bRefresh, bSynchAddress      */ D0(256),D1(256), 4,    0, 0,
+/* ---------- Audio 1.0 AS ISO Audio Data Endpoint Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,                0x25, 0x01,
+/* 3  bmAttributes                                            */ 0x00,
+/* 5  bLockDelayUnits, wLockDelay                             */ 0x00, D0(0),D1(0),
+
+/* ------------------------------------ Interface Descriptor *//* 2 Stream OUT (9+9+7+11+9+7=52) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 2,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------------------ Interface Descriptor */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 2,    1,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x00,
+/* 8 iInterface                                              */ 0,
+/* ------------------------ Audio 1.0 AS Interface Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,    0x24, 0x01,
+/* 3  bTerminalLink                                           */ 0x04,
+/* 4  bDelay, wFormatTag                                      */ 0x00, D0(0x0001),D1(0x0001),
+/* -------------------------- Audio AS Format Type Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 11,   0x24, 0x02,
+/* 3  bFormatType, bNrChannels, bSubframeSize, bBitResolution */ 0x01, 0x02, 0x02, 16,
+/* 7  bSamFreqType (n), tSamFreq[1] ... tSamFreq[n]           */ 1,    D0(48000),D1(48000),D2(48000),
+/* --------------------- Audio 1.0 AS ISO Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 9,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x02,            0x01,
+/* 4  wMaxPacketSize, bInterval, bRefresh, bSynchAddress      */ D0(256),D1(256), 4,    0, 0,
+/* ---------- Audio 1.0 AS ISO Audio Data Endpoint Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 7,                0x25, 0x01,
+/* 3  bmAttributes                                            */ 0x00,
+/* 5  bLockDelayUnits, wLockDelay                             */ 0x00, D0(0),D1(0),
+};
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED sizeof(device_framework_high_speed)
+
+static unsigned char string_framework[] = {
+
+/* Manufacturer string descriptor : Index 1 - "Express Logic" */
+    0x09, 0x04, 0x01, 0x0c,
+    0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+    0x6f, 0x67, 0x69, 0x63,
+
+/* Product string descriptor : Index 2 - "EL Composite device" */
+    0x09, 0x04, 0x02, 0x13,
+    0x45, 0x4c, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+    0x73, 0x69, 0x74, 0x65, 0x20, 0x64, 0x65, 0x76,
+    0x69, 0x63, 0x65,
+
+/* Serial Number string descriptor : Index 3 - "0001" */
+    0x09, 0x04, 0x03, 0x04,
+    0x30, 0x30, 0x30, 0x31
+};
+#define STRING_FRAMEWORK_LENGTH sizeof(string_framework)
+
+
+/* Multiple languages are supported on the device, to add
+    a language besides English, the Unicode language code must
+    be appended to the language_id_framework array and the length
+    adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+/* English. */
+    0x09, 0x04
+};
+#define LANGUAGE_ID_FRAMEWORK_LENGTH sizeof(language_id_framework)
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID  slave_audio_activate(VOID *audio_instance)
+{
+    slave_audio = (UX_DEVICE_CLASS_AUDIO *)audio_instance;
+    ux_device_class_audio_stream_get(slave_audio, 0, &slave_audio_tx_stream);
+    ux_device_class_audio_stream_get(slave_audio, 1, &slave_audio_rx_stream);
+}
+
+
+static VOID  slave_audio_deactivate(VOID *audio_instance)
+{
+    if ((VOID *)slave_audio == audio_instance)
+    {
+        slave_audio = UX_NULL;
+        slave_audio_tx_stream = UX_NULL;
+        slave_audio_rx_stream = UX_NULL;
+    }
+}
+
+
+static VOID  slave_audio_tx_done(UX_DEVICE_CLASS_AUDIO_STREAM *stream, ULONG length)
+{
+
+    /* Keep the device side queue full.  */
+    ux_device_class_audio_frame_write(stream, slave_audio_frame, UX_BENCHMARK_AUDIO_PACKET_SIZE);
+}
+
+
+static VOID  slave_audio_rx_done(UX_DEVICE_CLASS_AUDIO_STREAM *stream, ULONG length)
+{
+
+    /* Consume the frame at once.  */
+    slave_frames_received++;
+    ux_device_class_audio_read_frame_free(stream);
+}
+
+
+static UINT  test_host_change_function(ULONG event, UX_HOST_CLASS *cls, VOID *inst)
+{
+
+UX_HOST_CLASS_AUDIO *audio = (UX_HOST_CLASS_AUDIO *) inst;
+
+
+    switch(event)
+    {
+
+        case UX_DEVICE_INSERTION:
+
+            if (ux_host_class_audio_subclass_get(audio) == UX_HOST_CLASS_AUDIO_SUBCLASS_CONTROL)
+                break;
+            if (ux_host_class_audio_type_get(audio) == UX_HOST_CLASS_AUDIO_INPUT)
+                host_audio_rx = audio;
+            else
+                host_audio_tx = audio;
+            break;
+
+        case UX_DEVICE_REMOVAL:
+
+            if (audio == host_audio_rx)
+                host_audio_rx = UX_NULL;
+            if (audio == host_audio_tx)
+                host_audio_tx = UX_NULL;
+            break;
+
+        default:
+            break;
+    }
+    return(UX_SUCCESS);
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running Audio Streaming Sustain Benchmark........................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 3);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(test_host_change_function);
+    status |= ux_host_stack_class_register(_ux_system_host_class_audio_name, ux_host_class_audio_entry);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX.  */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Stream 0 sends to the host, stream 1 receives from the host.  */
+    ux_utility_memory_set(&slave_audio_parameter, 0, sizeof(slave_audio_parameter));
+    ux_utility_memory_set(slave_audio_stream_parameter, 0, sizeof(slave_audio_stream_parameter));
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_thread_entry = ux_device_class_audio_write_thread_entry;
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_callbacks.ux_device_class_audio_stream_frame_done = slave_audio_tx_done;
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_max_frame_buffer_size = UX_BENCHMARK_AUDIO_MAX_PACKET_SIZE;
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_max_frame_buffer_nb   = UX_BENCHMARK_AUDIO_FRAMES;
+    slave_audio_stream_parameter[1].ux_device_class_audio_stream_parameter_thread_entry = ux_device_class_audio_read_thread_entry;
+    slave_audio_stream_parameter[1].ux_device_class_audio_stream_parameter_callbacks.ux_device_class_audio_stream_frame_done = slave_audio_rx_done;
+    slave_audio_stream_parameter[1].ux_device_class_audio_stream_parameter_max_frame_buffer_size = UX_BENCHMARK_AUDIO_MAX_PACKET_SIZE;
+    slave_audio_stream_parameter[1].ux_device_class_audio_stream_parameter_max_frame_buffer_nb   = UX_BENCHMARK_AUDIO_FRAMES;
+    slave_audio_parameter.ux_device_class_audio_parameter_streams = slave_audio_stream_parameter;
+    slave_audio_parameter.ux_device_class_audio_parameter_streams_nb = 2;
+    slave_audio_parameter.ux_device_class_audio_parameter_callbacks.ux_slave_class_audio_instance_activate   = slave_audio_activate;
+    slave_audio_parameter.ux_device_class_audio_parameter_callbacks.ux_slave_class_audio_instance_deactivate = slave_audio_deactivate;
+#if defined(UX_DEVICE_CLASS_AUDIO_INTERRUPT_SUPPORT)
+    slave_audio_parameter.ux_device_class_audio_parameter_status_queue_size = 2;
+    slave_audio_parameter.ux_device_class_audio_parameter_status_size = 6;
+#endif
+
+    /* Initialize the device Audio class. This class owns interfaces starting with 0.  */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_audio_name, ux_device_class_audio_entry,
+                                             1, 0, &slave_audio_parameter);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system.  */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize, 0, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the semaphores for the requests in flight and to start the device side.  */
+    status =  tx_semaphore_create(&host_request_semaphore, "host requests", UX_BENCHMARK_AUDIO_REQUESTS);
+    status |= tx_semaphore_create(&device_start_semaphore, "device start", 0);
+
+    /* Create the main host simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main device simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the thread moving isochronous packets, one per frame.  */
+    status |= tx_thread_create(&tx_demo_thread_bus_simulation, "tx demo bus simulation", tx_demo_thread_bus_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE * 2, UX_DEMO_STACK_SIZE,
+            19, 19, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static VOID  audio_request_completion(UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST *transfer)
+{
+
+    /* Free the request slot.  */
+    if (transfer -> ux_host_class_audio_transfer_request_completion_code != UX_SUCCESS)
+        host_request_errors++;
+    host_bytes +=  transfer -> ux_host_class_audio_transfer_request_actual_length;
+    tx_semaphore_put(&host_request_semaphore);
+}
+
+
+static UINT  audio_benchmark_run(UX_HOST_CLASS_AUDIO *audio, CHAR *test_name)
+{
+
+UINT                                    status;
+UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST    *transfer;
+ULONG                                   i;
+
+
+    host_request_errors =  0;
+    host_bytes =  0;
+
+    ux_benchmark_start();
+
+    /* Keep the requests queued back to back, the stream must not starve.  */
+    for (i = 0; i < UX_BENCHMARK_AUDIO_PACKETS; i++)
+    {
+        if (tx_semaphore_get(&host_request_semaphore, UX_PERIODIC_RATE) != TX_SUCCESS)
+        {
+            printf("ERROR #%d: %s packet %ld not completed\n", __LINE__, test_name, i);
+            return(UX_ERROR);
+        }
+
+        transfer =  &audio_transfer[i % UX_BENCHMARK_AUDIO_REQUESTS];
+        ux_utility_memory_set(transfer, 0, sizeof(UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST));
+        transfer -> ux_host_class_audio_transfer_request_completion_function =  audio_request_completion;
+        transfer -> ux_host_class_audio_transfer_request_class_instance =  audio;
+        transfer -> ux_host_class_audio_transfer_request_data_pointer =  host_audio_buffer[i % UX_BENCHMARK_AUDIO_REQUESTS];
+        if (audio == host_audio_tx)
+        {
+            transfer -> ux_host_class_audio_transfer_request_requested_length =  UX_BENCHMARK_AUDIO_PACKET_SIZE;
+            transfer -> ux_host_class_audio_transfer_request_packet_size =  UX_BENCHMARK_AUDIO_PACKET_SIZE;
+            status =  ux_host_class_audio_write(audio, transfer);
+        }
+        else
+        {
+            transfer -> ux_host_class_audio_transfer_request_requested_length =  UX_BENCHMARK_AUDIO_MAX_PACKET_SIZE;
+            transfer -> ux_host_class_audio_transfer_request_packet_size =  UX_BENCHMARK_AUDIO_MAX_PACKET_SIZE;
+            status =  ux_host_class_audio_read(audio, transfer);
+        }
+        if (status != UX_SUCCESS)
+        {
+            printf("ERROR #%d: %s packet %ld status 0x%x\n", __LINE__, test_name, i, status);
+            return(status);
+        }
+    }
+
+    /* Drain the requests in flight.  */
+    for (i = 0; i < UX_BENCHMARK_AUDIO_REQUESTS; i++)
+    {
+        if (tx_semaphore_get(&host_request_semaphore, UX_PERIODIC_RATE) != TX_SUCCESS)
+        {
+            printf("ERROR #%d: %s not drained\n", __LINE__, test_name);
+            return(UX_ERROR);
+        }
+    }
+    if (host_request_errors)
+    {
+        printf("ERROR #%d: %s %ld request errors\n", __LINE__, test_name, host_request_errors);
+        return(UX_ERROR);
+    }
+
+    ux_benchmark_record(test_name, "packet_size", UX_BENCHMARK_AUDIO_PACKET_SIZE,
+                        UX_BENCHMARK_AUDIO_PACKETS, host_bytes);
+
+    /* Release the slots for the next run.  */
+    for (i = 0; i < UX_BENCHMARK_AUDIO_REQUESTS; i++)
+        tx_semaphore_put(&host_request_semaphore);
+    return(UX_SUCCESS);
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                            status;
+UX_HOST_CLASS_AUDIO_SAMPLING    sampling;
+
+
+    /* Wait for both streams on both sides.  */
+    while (host_audio_tx == UX_NULL || host_audio_rx == UX_NULL ||
+           slave_audio_tx_stream == UX_NULL || slave_audio_rx_stream == UX_NULL)
+        tx_thread_sleep(1);
+
+    /* Select the streaming alternate settings.  */
+    sampling.ux_host_class_audio_sampling_channels =   2;
+    sampling.ux_host_class_audio_sampling_frequency =  48000;
+    sampling.ux_host_class_audio_sampling_resolution = 16;
+    status =  ux_host_class_audio_streaming_sampling_set(host_audio_tx, &sampling);
+    status |= ux_host_class_audio_streaming_sampling_set(host_audio_rx, &sampling);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Let the device start its streams.  */
+    tx_semaphore_put(&device_start_semaphore);
+    while (slave_audio_tx_stream -> ux_device_class_audio_stream_transfer_pos -> ux_device_class_audio_frame_length == 0)
+        tx_thread_sleep(1);
+
+    if (ux_benchmark_open("audio") != UX_SUCCESS)
+        test_control_return(1);
+
+    if (audio_benchmark_run(host_audio_tx, "iso_out_sustain") != UX_SUCCESS ||
+        audio_benchmark_run(host_audio_rx, "iso_in_sustain") != UX_SUCCESS)
+    {
+        ux_benchmark_close();
+        test_control_return(1);
+    }
+
+    /* The device must have taken all that was sent.  */
+    if (slave_frames_received < UX_BENCHMARK_AUDIO_PACKETS ||
+        slave_audio_rx_stream -> ux_device_class_audio_stream_buffer_error_count)
+    {
+        printf("ERROR #%d: device received %ld frames, %ld errors\n", __LINE__, slave_frames_received,
+               slave_audio_rx_stream -> ux_device_class_audio_stream_buffer_error_count);
+        ux_benchmark_close();
+        test_control_return(1);
+    }
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+ULONG       i;
+
+
+    /* Wait for the host to select the streaming interfaces.  */
+    tx_semaphore_get(&device_start_semaphore, TX_WAIT_FOREVER);
+    while (slave_audio_tx_stream -> ux_device_class_audio_stream_endpoint == UX_NULL ||
+           slave_audio_rx_stream -> ux_device_class_audio_stream_endpoint == UX_NULL)
+        tx_thread_sleep(1);
+
+    /* Prefill the frames to send, then start both directions.  */
+    for (i = 0; i < UX_BENCHMARK_AUDIO_FRAMES - 1; i++)
+        ux_device_class_audio_frame_write(slave_audio_tx_stream, slave_audio_frame, UX_BENCHMARK_AUDIO_PACKET_SIZE);
+    ux_device_class_audio_transmission_start(slave_audio_tx_stream);
+    ux_device_class_audio_reception_start(slave_audio_rx_stream);
+
+    while(1)
+        tx_thread_sleep(UX_PERIODIC_RATE);
+}
+
+
+static void  tx_demo_thread_bus_simulation_entry(ULONG arg)
+{
+
+    while(1)
+    {
+        ux_benchmark_isochronous_exchange();
+        tx_thread_sleep(1);
+    }
+}
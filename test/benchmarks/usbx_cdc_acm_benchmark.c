@@ -0,0 +1,518 @@
+/* This benchmark measures the CDC-ACM byte streaming throughput between the simulated host and device.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_device_class_cdc_acm.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_cdc_acm.h"
+#include "ux_benchmark.h"
+
+
+/* Define constants.  */
+
+#define UX_DEMO_STACK_SIZE                  4096
+#define UX_DEMO_MEMORY_SIZE                 (128*1024)
+
+
+/* Define benchmark constants.  */
+
+#define UX_BENCHMARK_CDC_ACM_WRITES         32
+#define UX_BENCHMARK_CDC_ACM_BUFFER_SIZE    4096
+#define UX_BENCHMARK_CDC_ACM_DEVICE_READ    1
+#define UX_BENCHMARK_CDC_ACM_DEVICE_WRITE   2
+
+static ULONG                               write_sizes[] = { 64, 512, 4096 };
+
+
+/* Define local/extern function prototypes.  */
+
+static TX_THREAD                           tx_demo_thread_host_simulation;
+static TX_THREAD                           tx_demo_thread_slave_simulation;
+static void                                tx_demo_thread_host_simulation_entry(ULONG);
+static void                                tx_demo_thread_slave_simulation_entry(ULONG);
+static VOID                                demo_cdc_instance_activate(VOID  *cdc_instance);
+static VOID                                demo_cdc_instance_deactivate(VOID *cdc_instance);
+
+
+/* Define global data structures.  */
+
+static UX_HOST_CLASS_CDC_ACM               *cdc_acm_host_data;
+static UX_SLAVE_CLASS_CDC_ACM              *cdc_acm_slave;
+static UX_SLAVE_CLASS_CDC_ACM_PARAMETER    parameter;
+static UCHAR                               host_buffer[UX_BENCHMARK_CDC_ACM_BUFFER_SIZE];
+static UCHAR                               slave_buffer[UX_BENCHMARK_CDC_ACM_BUFFER_SIZE];
+
+static TX_SEMAPHORE                        device_start_semaphore;
+static TX_SEMAPHORE                        device_done_semaphore;
+static ULONG                               device_operation;
+static ULONG                               device_write_size;
+static ULONG                               error_counter;
+
+/* Define device framework.  */
+
+#define             DEVICE_FRAMEWORK_LENGTH_FULL_SPEED      (93 + 7)
+#define             DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED      (103 + 7)
+#define             STRING_FRAMEWORK_LENGTH                 47
+#define             LANGUAGE_ID_FRAMEWORK_LENGTH            2
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes
+       0x02 bDeviceClass:    CDC class code
+       0x00 bDeviceSubclass: CDC class sub code
+       0x00 bDeviceProtocol: CDC Device protocol
+
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    0x12, 0x01, 0x10, 0x01,
+    0xEF, 0x02, 0x01,
+    0x08,
+    0x84, 0x84, 0x00, 0x00,
+    0x00, 0x01,
+    0x01, 0x02, 03,
+    0x01,
+
+    /* Configuration 1 descriptor 9 bytes */
+    0x09, 0x02, 0x52, 0x00,
+    0x02, 0x01, 0x00,
+    0x40, 0x00,
+
+    /* Interface association descriptor. 8 bytes.  */
+    0x08, 0x0b, 0x00, 0x02, 0x02, 0x02, 0x00, 0x00,
+
+    /* Communication Class Interface Descriptor Requirement. 9 bytes.   */
+    0x09, 0x04, 0x00,
+    0x00,
+    0x02,
+    0x02, 0x02, 0x01,
+    0x00,
+
+    /* Header Functional Descriptor 5 bytes */
+    0x05, 0x24, 0x00,
+    0x10, 0x01,
+
+    /* ACM Functional Descriptor 4 bytes */
+    0x04, 0x24, 0x02,
+    0x0f,
+
+    /* Union Functional Descriptor 5 bytes */
+    0x05, 0x24, 0x06,
+    0x00,                          /* Master interface */
+    0x01,                          /* Slave interface  */
+
+    /* Call Management Functional Descriptor 5 bytes */
+    0x05, 0x24, 0x01,
+    0x03,
+    0x01,                          /* Data interface   */
+
+    /* Endpoint 0x04 descriptor 7 bytes */
+    0x07, 0x05, 0x04,
+    0x03,
+    0x08, 0x00,
+    15,
+
+    /* Endpoint 0x83 descriptor 7 bytes */
+    0x07, 0x05, 0x83,
+    0x03,
+    0x08, 0x00,
+    0xFF,
+
+    /* Data Class Interface Descriptor Requirement 9 bytes */
+    0x09, 0x04, 0x01,
+    0x00,
+    0x02,
+    0x0A, 0x00, 0x00,
+    0x00,
+
+    /* Endpoint 0x02 descriptor 7 bytes */
+    0x07, 0x05, 0x02,
+    0x02,
+    0x40, 0x00,
+    0x00,
+
+    /* Endpoint 0x81 descriptor 7 bytes */
+    0x07, 0x05, 0x81,
+    0x02,
+    0x40, 0x00,
+    0x00,
+
+};
+
+static unsigned char device_framework_high_speed[] = {
+
+    /* Device descriptor
+       0x02 bDeviceClass:    CDC class code
+       0x00 bDeviceSubclass: CDC class sub code
+       0x00 bDeviceProtocol: CDC Device protocol
+
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    0x12, 0x01, 0x00, 0x02,
+    0xEF, 0x02, 0x01,
+    0x40,
+    0x84, 0x84, 0x00, 0x00,
+    0x00, 0x01,
+    0x01, 0x02, 03,
+    0x01,
+
+    /* Device qualifier descriptor */
+    0x0a, 0x06, 0x00, 0x02,
+    0x02, 0x00, 0x00,
+    0x40,
+    0x01,
+    0x00,
+
+    /* Configuration 1 descriptor */
+    0x09, 0x02, 0x52, 0x00,
+    0x02, 0x01, 0x00,
+    0x40, 0x00,
+
+    /* Interface association descriptor. */
+    0x08, 0x0b, 0x00, 0x02, 0x02, 0x02, 0x00, 0x00,
+
+    /* Communication Class Interface Descriptor Requirement */
+    0x09, 0x04, 0x00,
+    0x00,
+    0x02,
+    0x02, 0x02, 0x01,
+    0x00,
+
+    /* Header Functional Descriptor */
+    0x05, 0x24, 0x00,
+    0x10, 0x01,
+
+    /* ACM Functional Descriptor */
+    0x04, 0x24, 0x02,
+    0x0f,
+
+    /* Union Functional Descriptor */
+    0x05, 0x24, 0x06,
+    0x00,
+    0x01,
+
+    /* Call Management Functional Descriptor */
+    0x05, 0x24, 0x01,
+    0x00,
+    0x01,
+
+    /* Endpoint 0x04 descriptor */
+    0x07, 0x05, 0x04,
+    0x03,
+    0x08, 0x00,
+    10,
+
+    /* Endpoint 0x83 descriptor */
+    0x07, 0x05, 0x83,
+    0x03,
+    0x08, 0x00,
+    10,
+
+    /* Data Class Interface Descriptor Requirement */
+    0x09, 0x04, 0x01,
+    0x00,
+    0x02,
+    0x0A, 0x00, 0x00,
+    0x00,
+
+    /* Endpoint 0x02 descriptor */
+    0x07, 0x05, 0x02,
+    0x02,
+    0x40, 0x00,
+    0x00,
+
+    /* Endpoint 0x81 descriptor */
+    0x07, 0x05, 0x81,
+    0x02,
+    0x40, 0x00,
+    0x00,
+
+};
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "Express Logic" */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 - "EL Composite device" */
+        0x09, 0x04, 0x02, 0x13,
+        0x45, 0x4c, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+        0x73, 0x69, 0x74, 0x65, 0x20, 0x64, 0x65, 0x76,
+        0x69, 0x63, 0x65,
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_cdc_acm_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running CDC-ACM Streaming Throughput Benchmark...................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_cdc_acm_name, ux_host_class_cdc_acm_entry);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX.  */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Set the parameters for callback when insertion/extraction of a CDC device.  */
+    parameter.ux_slave_class_cdc_acm_instance_activate   =  demo_cdc_instance_activate;
+    parameter.ux_slave_class_cdc_acm_instance_deactivate =  demo_cdc_instance_deactivate;
+    parameter.ux_slave_class_cdc_acm_parameter_change    =  UX_NULL;
+
+    /* Initialize the device cdc class. This class owns both interfaces starting with 0.  */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_cdc_acm_name, ux_device_class_cdc_acm_entry,
+                                             1, 0, &parameter);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system.  */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize, 0, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the semaphores to start and end the device side of a run.  */
+    status =  tx_semaphore_create(&device_start_semaphore, "device start", 0);
+    status |= tx_semaphore_create(&device_done_semaphore, "device done", 0);
+
+    /* Create the main host simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main device simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static UINT  cdc_acm_benchmark_run(ULONG operation, ULONG write_size)
+{
+
+UINT            status;
+ULONG           actual_length;
+ULONG           i;
+
+
+    /* Let the device side know what to expect.  */
+    device_operation =  operation;
+    device_write_size =  write_size;
+    tx_semaphore_put(&device_start_semaphore);
+
+    ux_benchmark_start();
+
+    for (i = 0; i < UX_BENCHMARK_CDC_ACM_WRITES; i++)
+    {
+
+        /* The host writes what the device reads and reads what the device writes.  */
+        if (operation == UX_BENCHMARK_CDC_ACM_DEVICE_READ)
+            status =  ux_host_class_cdc_acm_write(cdc_acm_host_data, host_buffer, write_size, &actual_length);
+        else
+            status =  ux_host_class_cdc_acm_read(cdc_acm_host_data, host_buffer, write_size, &actual_length);
+        if ((status != UX_SUCCESS) || (actual_length != write_size))
+        {
+            printf("ERROR #%d: write %ld status 0x%x, length %ld\n", __LINE__, i, status, actual_length);
+            return(UX_ERROR);
+        }
+    }
+
+    /* Wait for the device side to complete.  */
+    if (tx_semaphore_get(&device_done_semaphore, 10 * UX_PERIODIC_RATE) != TX_SUCCESS || error_counter)
+    {
+        printf("ERROR #%d: device side not done\n", __LINE__);
+        return(UX_ERROR);
+    }
+
+    ux_benchmark_record(operation == UX_BENCHMARK_CDC_ACM_DEVICE_READ ? "host_to_device" : "device_to_host",
+                        "write_size", write_size, UX_BENCHMARK_CDC_ACM_WRITES,
+                        (ULONG64)write_size * UX_BENCHMARK_CDC_ACM_WRITES);
+    return(UX_SUCCESS);
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                    status;
+UX_HOST_CLASS           *class;
+UX_HOST_CLASS_CDC_ACM   *cdc_acm_host;
+UINT                    i;
+
+
+    /* Find the main cdc_acm container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_cdc_acm_name, &class);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Wait for the data interface instance to be live, it is one of the two instances.  */
+    i =  0;
+    while (cdc_acm_host_data == UX_NULL)
+    {
+        tx_thread_sleep(1);
+        status =  ux_host_stack_class_instance_get(class, i, (VOID **) &cdc_acm_host);
+        i ^=  1;
+        if ((status == UX_SUCCESS) &&
+            (cdc_acm_host -> ux_host_class_cdc_acm_state == UX_HOST_CLASS_INSTANCE_LIVE) &&
+            (cdc_acm_host -> ux_host_class_cdc_acm_interface -> ux_interface_descriptor.bInterfaceClass == UX_HOST_CLASS_CDC_DATA_CLASS))
+            cdc_acm_host_data =  cdc_acm_host;
+    }
+
+    /* Wait for the device side too.  */
+    while (cdc_acm_slave == UX_NULL)
+        tx_thread_sleep(1);
+
+    if (ux_benchmark_open("cdc_acm") != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Host to device then device to host, for each write size.  */
+    for (i = 0; i < sizeof(write_sizes) / sizeof(write_sizes[0]); i++)
+    {
+        if (cdc_acm_benchmark_run(UX_BENCHMARK_CDC_ACM_DEVICE_READ, write_sizes[i]) != UX_SUCCESS ||
+            cdc_acm_benchmark_run(UX_BENCHMARK_CDC_ACM_DEVICE_WRITE, write_sizes[i]) != UX_SUCCESS)
+        {
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+    }
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+ULONG   i;
+
+
+    while(1)
+    {
+
+        /* Wait for the host to start a run.  */
+        tx_semaphore_get(&device_start_semaphore, TX_WAIT_FOREVER);
+
+        for (i = 0; i < UX_BENCHMARK_CDC_ACM_WRITES; i++)
+        {
+
+            if (cdc_acm_slave == UX_NULL)
+            {
+                error_counter++;
+                break;
+            }
+
+            if (device_operation == UX_BENCHMARK_CDC_ACM_DEVICE_READ)
+                status =  ux_device_class_cdc_acm_read(cdc_acm_slave, slave_buffer, device_write_size, &actual_length);
+            else
+                status =  ux_device_class_cdc_acm_write(cdc_acm_slave, slave_buffer, device_write_size, &actual_length);
+            if ((status != UX_SUCCESS) || (actual_length != device_write_size))
+            {
+                printf("ERROR #%d: write %ld status 0x%x, length %ld\n", __LINE__, i, status, actual_length);
+                error_counter++;
+                break;
+            }
+        }
+
+        tx_semaphore_put(&device_done_semaphore);
+    }
+}
+
+
+static VOID  demo_cdc_instance_activate(VOID *cdc_instance)
+{
+
+    /* Save the CDC instance.  */
+    cdc_acm_slave = (UX_SLAVE_CLASS_CDC_ACM *) cdc_instance;
+}
+
+
+static VOID  demo_cdc_instance_deactivate(VOID *cdc_instance)
+{
+
+    /* Reset the CDC instance.  */
+    cdc_acm_slave = UX_NULL;
+}
@@ -0,0 +1,604 @@
+/* This benchmark measures the CDC-ECM packet rate between the simulated host and device.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "nx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_network_driver.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_device_class_cdc_ecm.h"
+#include "ux_benchmark.h"
+
+
+/* Define constants.  */
+
+#define UX_DEMO_STACK_SIZE                  (4*1024)
+#define UX_DEMO_MEMORY_SIZE                 (128*1024)
+#define DEMO_IP_THREAD_STACK_SIZE           (8*1024)
+#define HOST_IP_ADDRESS                     IP_ADDRESS(192,168,1,176)
+#define HOST_SOCKET_PORT_UDP                45054
+#define DEVICE_IP_ADDRESS                   IP_ADDRESS(192,168,1,175)
+#define DEVICE_SOCKET_PORT_UDP              45055
+#define PACKET_PAYLOAD                      1600
+#define PACKET_POOL_SIZE                    (PACKET_PAYLOAD*200)
+#define ARP_MEMORY_SIZE                     1024
+
+
+/* Define benchmark constants.  */
+
+#define UX_BENCHMARK_CDC_ECM_PACKETS        200
+#define UX_BENCHMARK_CDC_ECM_BURST          10
+#define UX_BENCHMARK_CDC_ECM_MAX_PAYLOAD    1400
+#define UX_BENCHMARK_CDC_ECM_DEVICE_READ    1
+#define UX_BENCHMARK_CDC_ECM_DEVICE_WRITE   2
+
+static ULONG                                payload_sizes[] = { 64, 512, 1400 };
+
+
+/* Define local/extern function prototypes.  */
+
+static TX_THREAD                            tx_demo_thread_host_simulation;
+static TX_THREAD                            tx_demo_thread_slave_simulation;
+static void                                 tx_demo_thread_host_simulation_entry(ULONG);
+static void                                 tx_demo_thread_slave_simulation_entry(ULONG);
+static VOID                                 demo_cdc_ecm_instance_activate(VOID  *cdc_ecm_instance);
+static VOID                                 demo_cdc_ecm_instance_deactivate(VOID *cdc_ecm_instance);
+
+
+/* Define global data structures.  */
+
+static UX_HOST_CLASS_CDC_ECM                *cdc_ecm_host;
+static UX_SLAVE_CLASS_CDC_ECM               *cdc_ecm_slave;
+static UX_SLAVE_CLASS_CDC_ECM_PARAMETER     parameter;
+
+static NX_IP                                nx_ip_host;
+static NX_PACKET_POOL                       packet_pool_host;
+static NX_UDP_SOCKET                        udp_socket_host;
+static CHAR                                 *packet_pool_memory_host;
+static CHAR                                 ip_thread_stack_host[DEMO_IP_THREAD_STACK_SIZE];
+static CHAR                                 arp_memory_host[ARP_MEMORY_SIZE];
+
+static NX_IP                                nx_ip_device;
+static NX_PACKET_POOL                       packet_pool_device;
+static NX_UDP_SOCKET                        udp_socket_device;
+static CHAR                                 *packet_pool_memory_device;
+static CHAR                                 ip_thread_stack_device[DEMO_IP_THREAD_STACK_SIZE];
+static CHAR                                 arp_memory_device[ARP_MEMORY_SIZE];
+
+static UCHAR                                payload_buffer[UX_BENCHMARK_CDC_ECM_MAX_PAYLOAD];
+
+static TX_SEMAPHORE                         device_start_semaphore;
+static TX_SEMAPHORE                         device_done_semaphore;
+static TX_SEMAPHORE                         device_burst_semaphore;
+static TX_SEMAPHORE                         host_burst_semaphore;
+static UCHAR                                device_initialized;
+static ULONG                                device_operation;
+static ULONG                                device_payload_size;
+static ULONG                                error_counter;
+
+/* Define device framework.  */
+
+static unsigned char device_framework[] = {
+
+    /* Device Descriptor */
+    0x12, /* bLength */
+    0x01, /* bDescriptorType */
+    0x10, 0x01, /* bcdUSB */
+    0xef, /* bDeviceClass - Depends on bDeviceSubClass */
+    0x02, /* bDeviceSubClass - Depends on bDeviceProtocol */
+    0x01, /* bDeviceProtocol - There's an IAD */
+    0x40, /* bMaxPacketSize0 */
+    0x70, 0x07, /* idVendor */
+    0x42, 0x10, /* idProduct */
+    0x00, 0x01, /* bcdDevice */
+    0x01, /* iManufacturer */
+    0x02, /* iProduct */
+    0x03, /* iSerialNumber */
+    0x01, /* bNumConfigurations */
+
+    /* Configuration Descriptor */
+    0x09, /* bLength */
+    0x02, /* bDescriptorType */
+    0x58, 0x00, /* wTotalLength */
+    0x02, /* bNumInterfaces */
+    0x01, /* bConfigurationValue */
+    0x00, /* iConfiguration */
+    0xc0, /* bmAttributes - Self-powered */
+    0x00, /* bMaxPower */
+
+    /* Interface Association Descriptor */
+    0x08, /* bLength */
+    0x0b, /* bDescriptorType */
+    0x00, /* bFirstInterface */
+    0x02, /* bInterfaceCount */
+    0x02, /* bFunctionClass - CDC - Communication */
+    0x06, /* bFunctionSubClass - ECM */
+    0x00, /* bFunctionProtocol - No class specific protocol required */
+    0x00, /* iFunction */
+
+    /* Interface Descriptor */
+    0x09, /* bLength */
+    0x04, /* bDescriptorType */
+    0x00, /* bInterfaceNumber */
+    0x00, /* bAlternateSetting */
+    0x01, /* bNumEndpoints */
+    0x02, /* bInterfaceClass - CDC - Communication */
+    0x06, /* bInterfaceSubClass - ECM */
+    0x00, /* bInterfaceProtocol - No class specific protocol required */
+    0x00, /* iInterface */
+
+    /* CDC Header Functional Descriptor */
+    0x05, /* bLength */
+    0x24, /* bDescriptorType */
+    0x00, /* bDescriptorSubType */
+    0x10, 0x01, /* bcdCDC */
+
+    /* CDC ECM Functional Descriptor */
+    0x0d, /* bLength */
+    0x24, /* bDescriptorType */
+    0x0f, /* bDescriptorSubType */
+    0x04, /* iMACAddress */
+    0x00, 0x00, 0x00, 0x00, /* bmEthernetStatistics */
+    0xea, 0x05, /* wMaxSegmentSize */
+    0x00, 0x00, /* wNumberMCFilters */
+    0x00, /* bNumberPowerFilters */
+
+    /* CDC Union Functional Descriptor */
+    0x05, /* bLength */
+    0x24, /* bDescriptorType */
+    0x06, /* bDescriptorSubType */
+    0x00, /* bmMasterInterface */
+    0x01, /* bmSlaveInterface0 */
+
+    /* Endpoint Descriptor */
+    0x07, /* bLength */
+    0x05, /* bDescriptorType */
+    0x83, /* bEndpointAddress */
+    0x03, /* bmAttributes - Interrupt */
+    0x08, 0x00, /* wMaxPacketSize */
+    0x08, /* bInterval */
+
+    /* Interface Descriptor */
+    0x09, /* bLength */
+    0x04, /* bDescriptorType */
+    0x01, /* bInterfaceNumber */
+    0x00, /* bAlternateSetting */
+    0x00, /* bNumEndpoints */
+    0x0a, /* bInterfaceClass - CDC - Data */
+    0x00, /* bInterfaceSubClass - Should be 0x00 */
+    0x00, /* bInterfaceProtocol - No class specific protocol required */
+    0x00, /* iInterface */
+
+    /* Interface Descriptor */
+    0x09, /* bLength */
+    0x04, /* bDescriptorType */
+    0x01, /* bInterfaceNumber */
+    0x01, /* bAlternateSetting */
+    0x02, /* bNumEndpoints */
+    0x0a, /* bInterfaceClass - CDC - Data */
+    0x00, /* bInterfaceSubClass - Should be 0x00 */
+    0x00, /* bInterfaceProtocol - No class specific protocol required */
+    0x00, /* iInterface */
+
+    /* Endpoint Descriptor */
+    0x07, /* bLength */
+    0x05, /* bDescriptorType */
+    0x02, /* bEndpointAddress */
+    0x02, /* bmAttributes - Bulk */
+    0x40, 0x00, /* wMaxPacketSize */
+    0x00, /* bInterval */
+
+    /* Endpoint Descriptor */
+    0x07, /* bLength */
+    0x05, /* bDescriptorType */
+    0x81, /* bEndpointAddress */
+    0x02, /* bmAttributes - Bulk */
+    0x40, 0x00, /* wMaxPacketSize */
+    0x00, /* bInterval */
+
+};
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "Express Logic" */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72, 0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 - "EL CDCECM Device" */
+        0x09, 0x04, 0x02, 0x10,
+        0x45, 0x4c, 0x20, 0x43, 0x44, 0x43, 0x45, 0x43,
+        0x4d, 0x20, 0x44, 0x65, 0x76, 0x69, 0x63, 0x65,
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31,
+
+    /* MAC Address string descriptor : Index 4 - "001E5841B879" */
+        0x09, 0x04, 0x04, 0x0C,
+        0x30, 0x30, 0x31, 0x45, 0x35, 0x38,
+        0x34, 0x31, 0x42, 0x38, 0x37, 0x39,
+
+};
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_cdc_ecm_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running CDC-ECM Packet Rate Benchmark............................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    memory_pointer += UX_DEMO_MEMORY_SIZE;
+
+    /* Perform the initialization of the network driver.  */
+    status |= ux_network_driver_init();
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Each side has its own packet pool.  */
+    packet_pool_memory_host = memory_pointer;
+    memory_pointer += PACKET_POOL_SIZE;
+    packet_pool_memory_device = memory_pointer;
+
+    /* Create the semaphores to start and end the device side of a run, and to pace the bursts.  */
+    status =  tx_semaphore_create(&device_start_semaphore, "device start", 0);
+    status |= tx_semaphore_create(&device_done_semaphore, "device done", 0);
+    status |= tx_semaphore_create(&device_burst_semaphore, "device burst", 0);
+    status |= tx_semaphore_create(&host_burst_semaphore, "host burst", 0);
+
+    /* Create the main host simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main device simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static UINT  cdc_ecm_benchmark_send(NX_UDP_SOCKET *udp_socket, NX_PACKET_POOL *packet_pool,
+                                    ULONG ip_address, UINT port, ULONG payload_size)
+{
+
+UINT        status;
+NX_PACKET   *packet;
+
+
+    status =  nx_packet_allocate(packet_pool, &packet, NX_UDP_PACKET, UX_PERIODIC_RATE);
+    if (status != NX_SUCCESS)
+        return(status);
+
+    status =  nx_packet_data_append(packet, payload_buffer, payload_size, packet_pool, UX_PERIODIC_RATE);
+    if (status == NX_SUCCESS)
+        status =  nx_udp_socket_send(udp_socket, packet, ip_address, port);
+
+    /* The packet is ours until it is sent.  */
+    if (status != NX_SUCCESS)
+        nx_packet_release(packet);
+    return(status);
+}
+
+
+static UINT  cdc_ecm_benchmark_receive(NX_UDP_SOCKET *udp_socket, ULONG payload_size)
+{
+
+UINT        status;
+NX_PACKET   *packet;
+
+
+    status =  nx_udp_socket_receive(udp_socket, &packet, 10 * UX_PERIODIC_RATE);
+    if (status != NX_SUCCESS)
+        return(status);
+
+    if (packet -> nx_packet_length != payload_size)
+        status =  UX_ERROR;
+
+    nx_packet_release(packet);
+    return(status);
+}
+
+
+static UINT  cdc_ecm_benchmark_run(ULONG operation, ULONG payload_size)
+{
+
+UINT            status;
+ULONG           i;
+
+
+    /* Let the device side know what to expect.  */
+    device_operation =  operation;
+    device_payload_size =  payload_size;
+    tx_semaphore_put(&device_start_semaphore);
+
+    ux_benchmark_start();
+
+    for (i = 0; i < UX_BENCHMARK_CDC_ECM_PACKETS; i++)
+    {
+
+        /* The host sends what the device receives and receives what the device sends.  */
+        if (operation == UX_BENCHMARK_CDC_ECM_DEVICE_READ)
+            status =  cdc_ecm_benchmark_send(&udp_socket_host, &packet_pool_host,
+                                             DEVICE_IP_ADDRESS, DEVICE_SOCKET_PORT_UDP, payload_size);
+        else
+            status =  cdc_ecm_benchmark_receive(&udp_socket_host, payload_size);
+        if (status != NX_SUCCESS)
+        {
+            printf("ERROR #%d: packet %ld status 0x%x\n", __LINE__, i, status);
+            return(UX_ERROR);
+        }
+
+        /* UDP drops what the receiving socket can not queue, go burst by burst.  */
+        if (((i + 1) % UX_BENCHMARK_CDC_ECM_BURST) == 0)
+        {
+            if (operation == UX_BENCHMARK_CDC_ECM_DEVICE_WRITE)
+                tx_semaphore_put(&host_burst_semaphore);
+            else if (tx_semaphore_get(&device_burst_semaphore, 10 * UX_PERIODIC_RATE) != TX_SUCCESS)
+            {
+                printf("ERROR #%d: packet %ld not received\n", __LINE__, i);
+                return(UX_ERROR);
+            }
+        }
+    }
+
+    /* Wait for the device side to complete.  */
+    if (tx_semaphore_get(&device_done_semaphore, 10 * UX_PERIODIC_RATE) != TX_SUCCESS || error_counter)
+    {
+        printf("ERROR #%d: device side not done\n", __LINE__);
+        return(UX_ERROR);
+    }
+
+    ux_benchmark_record(operation == UX_BENCHMARK_CDC_ECM_DEVICE_READ ? "udp_host_to_device" : "udp_device_to_host",
+                        "payload_size", payload_size, UX_BENCHMARK_CDC_ECM_PACKETS,
+                        (ULONG64)payload_size * UX_BENCHMARK_CDC_ECM_PACKETS);
+    return(UX_SUCCESS);
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                    status;
+UX_HOST_CLASS           *class;
+UINT                    i;
+
+
+    /* Wait for the device side to be ready before it can be enumerated.  */
+    while (device_initialized == UX_FALSE)
+        tx_thread_sleep(1);
+
+    /* Create the host IP instance, with ARP and UDP.  */
+    status =  nx_packet_pool_create(&packet_pool_host, "NetX Host Packet Pool", PACKET_PAYLOAD,
+                                    packet_pool_memory_host, PACKET_POOL_SIZE);
+    status |= nx_ip_create(&nx_ip_host, "NetX Host Thread", HOST_IP_ADDRESS, 0xFF000000UL,
+                           &packet_pool_host, _ux_network_driver_entry, ip_thread_stack_host, DEMO_IP_THREAD_STACK_SIZE, 1);
+    status |= nx_arp_enable(&nx_ip_host, (void *)arp_memory_host, ARP_MEMORY_SIZE);
+    status |= nx_arp_static_entry_create(&nx_ip_host, DEVICE_IP_ADDRESS, 0x0000001E, 0x80032CD8);
+    status |= nx_udp_enable(&nx_ip_host);
+    status |= nx_udp_socket_create(&nx_ip_host, &udp_socket_host, "USB HOST UDP SOCKET", NX_IP_NORMAL, NX_DONT_FRAGMENT, 20, 20);
+    status |= nx_udp_socket_bind(&udp_socket_host, HOST_SOCKET_PORT_UDP, NX_NO_WAIT);
+    if (status != NX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_cdc_ecm_name, ux_host_class_cdc_ecm_entry);
+
+    /* Register all the USB host controllers available in this system.  */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize, 0, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Find the cdc_ecm container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_cdc_ecm_name, &class);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Wait for the instance to be live.  */
+    do
+    {
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &cdc_ecm_host);
+        tx_thread_sleep(1);
+    } while (status != UX_SUCCESS);
+    while (cdc_ecm_host -> ux_host_class_cdc_ecm_state != UX_HOST_CLASS_INSTANCE_LIVE)
+        tx_thread_sleep(1);
+
+    /* Wait for the link to be up on both sides.  */
+    while (cdc_ecm_host -> ux_host_class_cdc_ecm_link_state != UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP)
+        tx_thread_sleep(1);
+    while (cdc_ecm_slave == UX_NULL ||
+           cdc_ecm_slave -> ux_slave_class_cdc_ecm_link_state != UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_UP)
+        tx_thread_sleep(1);
+
+    if (ux_benchmark_open("cdc_ecm") != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Host to device then device to host, for each payload size.  */
+    for (i = 0; i < sizeof(payload_sizes) / sizeof(payload_sizes[0]); i++)
+    {
+        if (cdc_ecm_benchmark_run(UX_BENCHMARK_CDC_ECM_DEVICE_READ, payload_sizes[i]) != UX_SUCCESS ||
+            cdc_ecm_benchmark_run(UX_BENCHMARK_CDC_ECM_DEVICE_WRITE, payload_sizes[i]) != UX_SUCCESS)
+        {
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+    }
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   i;
+
+
+    /* Create the device IP instance, with ARP and UDP.  */
+    status =  nx_packet_pool_create(&packet_pool_device, "NetX Device Packet Pool", PACKET_PAYLOAD,
+                                    packet_pool_memory_device, PACKET_POOL_SIZE);
+    status |= nx_ip_create(&nx_ip_device, "NetX Device Thread", DEVICE_IP_ADDRESS, 0xFF000000UL,
+                           &packet_pool_device, _ux_network_driver_entry, ip_thread_stack_device, DEMO_IP_THREAD_STACK_SIZE, 1);
+    status |= nx_arp_enable(&nx_ip_device, (void *)arp_memory_device, ARP_MEMORY_SIZE);
+    status |= nx_arp_static_entry_create(&nx_ip_device, HOST_IP_ADDRESS, 0x0000001E, 0x5841B878);
+    status |= nx_udp_enable(&nx_ip_device);
+    status |= nx_udp_socket_create(&nx_ip_device, &udp_socket_device, "USB DEVICE UDP SOCKET", NX_IP_NORMAL, NX_DONT_FRAGMENT, 20, 20);
+    status |= nx_udp_socket_bind(&udp_socket_device, DEVICE_SOCKET_PORT_UDP, NX_NO_WAIT);
+    if (status != NX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX.  */
+    status =  ux_device_stack_initialize(device_framework, sizeof(device_framework),
+                                         device_framework, sizeof(device_framework),
+                                         string_framework, sizeof(string_framework),
+                                         language_id_framework, sizeof(language_id_framework), UX_NULL);
+
+    /* Set the parameters for callback when insertion/extraction of a CDC-ECM device.  */
+    parameter.ux_slave_class_cdc_ecm_instance_activate   =  demo_cdc_ecm_instance_activate;
+    parameter.ux_slave_class_cdc_ecm_instance_deactivate =  demo_cdc_ecm_instance_deactivate;
+
+    /* Define the local and remote node IDs.  */
+    parameter.ux_slave_class_cdc_ecm_parameter_local_node_id[0] = 0x00;
+    parameter.ux_slave_class_cdc_ecm_parameter_local_node_id[1] = 0x1e;
+    parameter.ux_slave_class_cdc_ecm_parameter_local_node_id[2] = 0x58;
+    parameter.ux_slave_class_cdc_ecm_parameter_local_node_id[3] = 0x41;
+    parameter.ux_slave_class_cdc_ecm_parameter_local_node_id[4] = 0xb8;
+    parameter.ux_slave_class_cdc_ecm_parameter_local_node_id[5] = 0x78;
+    parameter.ux_slave_class_cdc_ecm_parameter_remote_node_id[0] = 0x00;
+    parameter.ux_slave_class_cdc_ecm_parameter_remote_node_id[1] = 0x1e;
+    parameter.ux_slave_class_cdc_ecm_parameter_remote_node_id[2] = 0x58;
+    parameter.ux_slave_class_cdc_ecm_parameter_remote_node_id[3] = 0x41;
+    parameter.ux_slave_class_cdc_ecm_parameter_remote_node_id[4] = 0xb8;
+    parameter.ux_slave_class_cdc_ecm_parameter_remote_node_id[5] = 0x79;
+
+    /* Initialize the device cdc_ecm class. This class owns both interfaces.  */
+    status |= ux_device_stack_class_register(_ux_system_slave_class_cdc_ecm_name, ux_device_class_cdc_ecm_entry,
+                                             1, 0, &parameter);
+
+    /* Initialize the simulated device controller.  */
+    status |= _ux_dcd_sim_slave_initialize();
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    device_initialized =  UX_TRUE;
+
+    while(1)
+    {
+
+        /* Wait for the host to start a run.  */
+        tx_semaphore_get(&device_start_semaphore, TX_WAIT_FOREVER);
+
+        for (i = 0; i < UX_BENCHMARK_CDC_ECM_PACKETS; i++)
+        {
+
+            if (device_operation == UX_BENCHMARK_CDC_ECM_DEVICE_READ)
+                status =  cdc_ecm_benchmark_receive(&udp_socket_device, device_payload_size);
+            else
+                status =  cdc_ecm_benchmark_send(&udp_socket_device, &packet_pool_device,
+                                                 HOST_IP_ADDRESS, HOST_SOCKET_PORT_UDP, device_payload_size);
+            if (status != NX_SUCCESS)
+            {
+                printf("ERROR #%d: packet %ld status 0x%x\n", __LINE__, i, status);
+                error_counter++;
+                break;
+            }
+
+            /* Pace the bursts with the host.  */
+            if (((i + 1) % UX_BENCHMARK_CDC_ECM_BURST) == 0)
+            {
+                if (device_operation == UX_BENCHMARK_CDC_ECM_DEVICE_READ)
+                    tx_semaphore_put(&device_burst_semaphore);
+                else if (tx_semaphore_get(&host_burst_semaphore, 10 * UX_PERIODIC_RATE) != TX_SUCCESS)
+                {
+                    error_counter++;
+                    break;
+                }
+            }
+        }
+
+        tx_semaphore_put(&device_done_semaphore);
+    }
+}
+
+
+static VOID  demo_cdc_ecm_instance_activate(VOID *cdc_ecm_instance)
+{
+
+    /* Save the CDC-ECM instance.  */
+    cdc_ecm_slave = (UX_SLAVE_CLASS_CDC_ECM *) cdc_ecm_instance;
+}
+
+
+static VOID  demo_cdc_ecm_instance_deactivate(VOID *cdc_ecm_instance)
+{
+
+    /* Reset the CDC-ECM instance.  */
+    cdc_ecm_slave = UX_NULL;
+}
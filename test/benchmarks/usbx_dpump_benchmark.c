@@ -0,0 +1,392 @@
+/* This benchmark measures the dpump bulk throughput between the simulated host and device.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+#include "ux_benchmark.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_MEMORY_SIZE     (64*1024)
+
+
+/* Define benchmark constants.  */
+
+#define UX_BENCHMARK_DPUMP_TRANSFERS        64
+#define UX_BENCHMARK_DPUMP_BUFFER_SIZE      (16*1024)
+#define UX_BENCHMARK_DPUMP_DEVICE_READ      1
+#define UX_BENCHMARK_DPUMP_DEVICE_WRITE     2
+
+static ULONG                           transfer_sizes[] = { 64, 512, 4096, 16384 };
+
+
+/* Define USBX demo global variables.  */
+
+static unsigned char                   host_buffer[UX_BENCHMARK_DPUMP_BUFFER_SIZE];
+static unsigned char                   slave_buffer[UX_BENCHMARK_DPUMP_BUFFER_SIZE];
+
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static TX_SEMAPHORE                    device_start_semaphore;
+static TX_SEMAPHORE                    device_done_semaphore;
+static ULONG                           device_operation;
+static ULONG                           device_transfer_size;
+static ULONG                           device_transfers;
+static ULONG                           error_counter;
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+    };
+
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+
+UINT                       _ux_host_class_dpump_entry(UX_HOST_CLASS_COMMAND *command);
+UINT                       _ux_host_class_dpump_write(UX_HOST_CLASS_DPUMP *dpump, UCHAR * data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+UINT                       _ux_host_class_dpump_read (UX_HOST_CLASS_DPUMP *dpump, UCHAR *data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_dpump_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running DPUMP Bulk Throughput Benchmark............................. ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                             1, 0, &parameter);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the semaphores to start and end the device side of a run.  */
+    status =  tx_semaphore_create(&device_start_semaphore, "device start", 0);
+    status |= tx_semaphore_create(&device_done_semaphore, "device done", 0);
+
+    /* Create the main host simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main device simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static UINT  dpump_benchmark_run(ULONG operation, ULONG transfer_size)
+{
+
+UINT            status;
+ULONG           actual_length;
+ULONG           i;
+
+
+    /* Let the device side know what to expect.  */
+    device_operation =  operation;
+    device_transfer_size =  transfer_size;
+    device_transfers =  UX_BENCHMARK_DPUMP_TRANSFERS;
+    tx_semaphore_put(&device_start_semaphore);
+
+    ux_benchmark_start();
+
+    for (i = 0; i < UX_BENCHMARK_DPUMP_TRANSFERS; i++)
+    {
+
+        /* The host writes what the device reads and reads what the device writes.  */
+        if (operation == UX_BENCHMARK_DPUMP_DEVICE_READ)
+            status =  _ux_host_class_dpump_write(dpump, host_buffer, transfer_size, &actual_length);
+        else
+            status =  _ux_host_class_dpump_read(dpump, host_buffer, transfer_size, &actual_length);
+        if ((status != UX_SUCCESS) || (actual_length != transfer_size))
+        {
+            printf("ERROR #%d: transfer %ld status 0x%x, length %ld\n", __LINE__, i, status, actual_length);
+            return(UX_ERROR);
+        }
+    }
+
+    /* Wait for the device side to complete.  */
+    if (tx_semaphore_get(&device_done_semaphore, 10 * UX_PERIODIC_RATE) != TX_SUCCESS || error_counter)
+    {
+        printf("ERROR #%d: device side not done\n", __LINE__);
+        return(UX_ERROR);
+    }
+
+    ux_benchmark_record(operation == UX_BENCHMARK_DPUMP_DEVICE_READ ? "bulk_out" : "bulk_in",
+                        "transfer_size", transfer_size, UX_BENCHMARK_DPUMP_TRANSFERS,
+                        (ULONG64)transfer_size * UX_BENCHMARK_DPUMP_TRANSFERS);
+    return(UX_SUCCESS);
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT            status;
+UX_HOST_CLASS   *class;
+UINT            i;
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+        tx_thread_relinquish();
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE)
+        tx_thread_relinquish();
+
+    /* Wait for the device side too.  */
+    while (dpump_slave == UX_NULL)
+        tx_thread_relinquish();
+
+    if (ux_benchmark_open("dpump") != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Host to device then device to host, for each transfer size.  */
+    for (i = 0; i < sizeof(transfer_sizes) / sizeof(transfer_sizes[0]); i++)
+    {
+        if (dpump_benchmark_run(UX_BENCHMARK_DPUMP_DEVICE_READ, transfer_sizes[i]) != UX_SUCCESS ||
+            dpump_benchmark_run(UX_BENCHMARK_DPUMP_DEVICE_WRITE, transfer_sizes[i]) != UX_SUCCESS)
+        {
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+    }
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+ULONG   i;
+
+
+    while(1)
+    {
+
+        /* Wait for the host to start a run.  */
+        tx_semaphore_get(&device_start_semaphore, TX_WAIT_FOREVER);
+
+        for (i = 0; i < device_transfers; i++)
+        {
+
+            if (dpump_slave == UX_NULL)
+            {
+                error_counter++;
+                break;
+            }
+
+            if (device_operation == UX_BENCHMARK_DPUMP_DEVICE_READ)
+                status =  _ux_device_class_dpump_read(dpump_slave, slave_buffer, device_transfer_size, &actual_length);
+            else
+                status =  _ux_device_class_dpump_write(dpump_slave, slave_buffer, device_transfer_size, &actual_length);
+            if ((status != UX_SUCCESS) || (actual_length != device_transfer_size))
+            {
+                printf("ERROR #%d: transfer %ld status 0x%x, length %ld\n", __LINE__, i, status, actual_length);
+                error_counter++;
+                break;
+            }
+        }
+
+        tx_semaphore_put(&device_done_semaphore);
+    }
+}
+
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
@@ -0,0 +1,401 @@
+/* This benchmark measures the HID interrupt report rate between the simulated host and device.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_class_hid_mouse.h"
+#include "ux_device_class_hid.h"
+#include "ux_device_stack.h"
+#include "ux_benchmark.h"
+
+
+#define LSB(x)                              (x & 0xff)
+#define MSB(x)                              ((x & 0xff00) >> 8)
+
+
+/* Define constants.  */
+
+#define UX_DEMO_STACK_SIZE                  4096
+#define UX_DEMO_MEMORY_SIZE                 (96*1024)
+
+
+/* Define benchmark constants.  */
+
+#define UX_BENCHMARK_HID_REPORTS            256
+#define UX_BENCHMARK_HID_REPORT_LENGTH      4
+
+
+/* Define local/extern function prototypes.  */
+
+static TX_THREAD                            tx_demo_thread_host_simulation;
+static TX_THREAD                            tx_demo_thread_slave_simulation;
+static void                                 tx_demo_thread_host_simulation_entry(ULONG);
+static void                                 tx_demo_thread_slave_simulation_entry(ULONG);
+static UINT                                 demo_thread_hid_callback(UX_SLAVE_CLASS_HID *hid, UX_SLAVE_CLASS_HID_EVENT *event);
+static VOID                                 demo_hid_report_callback(UX_HOST_CLASS_HID_REPORT_CALLBACK *callback);
+
+
+/* Define global data structures.  */
+
+static UX_HOST_CLASS_HID                    *hid;
+static UX_HOST_CLASS_HID_REPORT_CALLBACK    report_callback;
+static UCHAR                                report_buffer[64];
+static UX_SLAVE_CLASS_HID_PARAMETER         hid_parameter;
+
+static TX_SEMAPHORE                         device_start_semaphore;
+static ULONG                                reports_received;
+static ULONG                                report_errors;
+static ULONG                                report_expected;
+
+
+static UCHAR hid_mouse_report[] = {
+
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x02,                    // USAGE (Mouse)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x09, 0x01,                    //   USAGE (Pointer)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x05, 0x09,                    //     USAGE_PAGE (Button)
+    0x19, 0x01,                    //     USAGE_MINIMUM (Button 1)
+    0x29, 0x03,                    //     USAGE_MAXIMUM (Button 3)
+    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
+    0x75, 0x01,                    //     REPORT_SIZE (1)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x09, 0x30,                    //     USAGE (X)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x15, 0x81,                    //     LOGICAL_MINIMUM (-127)
+    0x25, 0x7f,                    //     LOGICAL_MAXIMUM (127)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0x09, 0x38,                    //     USAGE (Mouse Wheel)
+    0x15, 0x81,                    //     LOGICAL_MINIMUM (-127)
+    0x25, 0x7f,                    //     LOGICAL_MAXIMUM (127)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0xc0,                          //   END_COLLECTION
+    0xc0                           // END_COLLECTION
+};
+#define HID_MOUSE_REPORT_LENGTH (sizeof(hid_mouse_report)/sizeof(hid_mouse_report[0]))
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_MOUSE_REPORT_LENGTH),
+        MSB(HID_MOUSE_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x01
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_MOUSE_REPORT_LENGTH),
+        MSB(HID_MOUSE_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x01
+
+    };
+
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hid_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running HID Report Rate Benchmark................................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    status |= ux_host_class_hid_client_register(_ux_system_host_class_hid_client_mouse_name, ux_host_class_hid_mouse_entry);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX.  */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters for a mouse.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_mouse_report;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_MOUSE_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+
+    /* Initialize the device hid class. The class is connected with interface 0.  */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                             1, 0, (VOID *)&hid_parameter);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system.  */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize, 0, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the semaphore to start the device side.  */
+    status =  tx_semaphore_create(&device_start_semaphore, "device start", 0);
+
+    /* Create the main host simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main device simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                        status;
+UX_HOST_CLASS               *class;
+UX_HOST_CLASS_HID_CLIENT    *hid_client;
+ULONG                       start_ticks;
+
+
+    /* Find the main HID container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_hid_name, &class);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Wait for the HID instance and its mouse client to be live.  */
+    do
+    {
+        tx_thread_sleep(1);
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &hid);
+    } while ((status != UX_SUCCESS) || (hid -> ux_host_class_hid_state != UX_HOST_CLASS_INSTANCE_LIVE) ||
+             (hid -> ux_host_class_hid_client == UX_NULL));
+    hid_client =  hid -> ux_host_class_hid_client;
+    while (hid_client -> ux_host_class_hid_client_local_instance == UX_NULL)
+        tx_thread_sleep(1);
+
+    /* Take the raw reports directly, the mouse decoding is not measured.  */
+    report_callback.ux_host_class_hid_report_callback_id =         0;
+    report_callback.ux_host_class_hid_report_callback_function =   demo_hid_report_callback;
+    report_callback.ux_host_class_hid_report_callback_buffer =     report_buffer;
+    report_callback.ux_host_class_hid_report_callback_flags =      UX_HOST_CLASS_HID_REPORT_RAW;
+    report_callback.ux_host_class_hid_report_callback_length =     sizeof(report_buffer);
+    status =  ux_host_class_hid_report_callback_register(hid, &report_callback);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    if (ux_benchmark_open("hid") != UX_SUCCESS)
+        test_control_return(1);
+
+    /* The device queues the reports as fast as it can, the rate is how fast they arrive.  */
+    ux_benchmark_start();
+    start_ticks =  tx_time_get();
+    tx_semaphore_put(&device_start_semaphore);
+    while (reports_received < UX_BENCHMARK_HID_REPORTS && report_errors == 0)
+    {
+        if (tx_time_get() - start_ticks > UX_BENCHMARK_HID_REPORTS * UX_PERIODIC_RATE)
+            break;
+        tx_thread_sleep(1);
+    }
+    if (reports_received < UX_BENCHMARK_HID_REPORTS || report_errors != 0)
+    {
+        printf("ERROR #%d: %ld reports, %ld errors\n", __LINE__, reports_received, report_errors);
+        ux_benchmark_close();
+        test_control_return(1);
+    }
+    ux_benchmark_record("interrupt_in_reports", "report_length", UX_BENCHMARK_HID_REPORT_LENGTH,
+                        reports_received, (ULONG64)reports_received * UX_BENCHMARK_HID_REPORT_LENGTH);
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static VOID  demo_hid_report_callback(UX_HOST_CLASS_HID_REPORT_CALLBACK *callback)
+{
+
+ULONG       value;
+
+
+    /* Reports carry a sequence number, none should be lost.  */
+    value =  _ux_utility_long_get(callback -> ux_host_class_hid_report_callback_buffer);
+    if (value != report_expected)
+        report_errors++;
+    report_expected =  value + 1;
+    reports_received++;
+}
+
+
+static UINT  demo_thread_hid_callback(UX_SLAVE_CLASS_HID *hid_instance, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UX_SLAVE_DEVICE                 *device;
+UX_SLAVE_CLASS_HID              *hid_slave;
+UX_SLAVE_CLASS_HID_EVENT        hid_event;
+UINT                            status;
+ULONG                           i;
+
+
+    /* Wait for the host to start.  */
+    tx_semaphore_get(&device_start_semaphore, TX_WAIT_FOREVER);
+
+    device =  &_ux_system_slave -> ux_system_slave_device;
+    hid_slave =  device -> ux_slave_device_first_interface -> ux_slave_interface_class_instance;
+
+    ux_utility_memory_set(&hid_event, 0, sizeof(UX_SLAVE_CLASS_HID_EVENT));
+    hid_event.ux_device_class_hid_event_length =  UX_BENCHMARK_HID_REPORT_LENGTH;
+
+    for (i = 0; i < UX_BENCHMARK_HID_REPORTS; i++)
+    {
+
+        /* Retry while the event queue is full.  */
+        _ux_utility_long_put(hid_event.ux_device_class_hid_event_buffer, i);
+        while ((status = ux_device_class_hid_event_set(hid_slave, &hid_event)) == UX_ERROR)
+            tx_thread_sleep(1);
+        if (status != UX_SUCCESS)
+        {
+            printf("ERROR #%d: report %ld status 0x%x\n", __LINE__, i, status);
+            report_errors++;
+            break;
+        }
+    }
+}
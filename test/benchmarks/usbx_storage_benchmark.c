@@ -0,0 +1,370 @@
+/* This benchmark measures the storage sequential throughput and random IOPS between the simulated host and device.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_device_class_storage.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_storage.h"
+#include "ux_benchmark.h"
+
+
+/* Define constants.  */
+
+#define UX_DEMO_STACK_SIZE                  4096
+#define UX_DEMO_MEMORY_SIZE                 (256*1024)
+#define UX_RAM_DISK_SIZE                    (1024 * 1024)
+#define UX_RAM_DISK_BLOCK_LENGTH            512
+#define UX_RAM_DISK_LAST_LBA                ((UX_RAM_DISK_SIZE / UX_RAM_DISK_BLOCK_LENGTH) - 1)
+
+
+/* Define benchmark constants.  */
+
+#define UX_BENCHMARK_STORAGE_SEQUENTIAL_OPERATIONS  32
+#define UX_BENCHMARK_STORAGE_RANDOM_OPERATIONS      128
+#define UX_BENCHMARK_STORAGE_MAX_SECTORS            64
+
+static ULONG                        sequential_sectors[] = { 1, 8, 64 };
+
+
+/* Define local/extern function prototypes.  */
+
+static TX_THREAD                    tx_demo_thread_host_simulation;
+static void                         tx_demo_thread_host_simulation_entry(ULONG);
+static UINT                         demo_media_read(VOID *storage, ULONG lun, UCHAR * data_pointer, ULONG number_blocks, ULONG lba, ULONG *media_status);
+static UINT                         demo_media_write(VOID *storage, ULONG lun, UCHAR * data_pointer, ULONG number_blocks, ULONG lba, ULONG *media_status);
+static UINT                         demo_media_status(VOID *storage, ULONG lun, ULONG media_id, ULONG *media_status);
+
+
+/* Define global data structures.  */
+
+static UX_HOST_CLASS_STORAGE        *storage;
+static UX_SLAVE_CLASS_STORAGE_PARAMETER storage_parameter;
+static UCHAR                        ram_disk_memory[UX_RAM_DISK_SIZE];
+static UCHAR                        host_buffer[UX_BENCHMARK_STORAGE_MAX_SECTORS * UX_RAM_DISK_BLOCK_LENGTH];
+static ULONG                        random_seed;
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x08, 0x06, 0x50,
+        0x00,
+
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x02, 0x02, 0x40, 0x00, 0x00
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x81, 0x07, 0x00, 0x00, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x08, 0x06, 0x50,
+        0x00,
+
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x00, 0x02, 0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x02, 0x02, 0x00, 0x02, 0x00
+    };
+
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0a,
+        0x46, 0x6c, 0x61, 0x73, 0x68, 0x20, 0x44, 0x69,
+        0x73, 0x6b,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_storage_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running Storage Throughput Benchmark................................ ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + UX_DEMO_STACK_SIZE;
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_storage_name, ux_host_class_storage_entry);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX.  */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* One RAM disk LUN.  */
+    storage_parameter.ux_slave_class_storage_parameter_number_lun = 1;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_last_lba        =  UX_RAM_DISK_LAST_LBA;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_block_length    =  UX_RAM_DISK_BLOCK_LENGTH;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_type            =  0;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_removable_flag  =  0x80;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_read            =  demo_media_read;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_write           =  demo_media_write;
+    storage_parameter.ux_slave_class_storage_parameter_lun[0].ux_slave_class_storage_media_status          =  demo_media_status;
+
+    /* Initialize the device storage class. The class is connected with interface 0 on configuration 1.  */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_storage_name, ux_device_class_storage_entry,
+                                             1, 0, (VOID *)&storage_parameter);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system.  */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize, 0, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static ULONG  storage_benchmark_lba(ULONG sectors)
+{
+
+    /* Linear congruential generator, the sequence is the same for all runs.  */
+    random_seed =  random_seed * 1103515245 + 12345;
+    return(((random_seed >> 8) & 0xFFFFFF) % (UX_RAM_DISK_LAST_LBA + 1 - sectors));
+}
+
+
+static UINT  storage_benchmark_run(CHAR *test_name, UINT write, UINT random, ULONG sectors, ULONG operations)
+{
+
+UINT            status;
+ULONG           lba;
+ULONG           i;
+
+
+    ux_benchmark_start();
+
+    lba =  0;
+    random_seed =  1;
+    for (i = 0; i < operations; i++)
+    {
+
+        /* Sequential runs wrap at the end of the disk.  */
+        if (random)
+            lba =  storage_benchmark_lba(sectors);
+        else if (lba + sectors > UX_RAM_DISK_LAST_LBA + 1)
+            lba =  0;
+
+        status =  ux_host_class_storage_lock(storage, UX_WAIT_FOREVER);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        storage -> ux_host_class_storage_lun =  0;
+        if (write)
+            status =  _ux_host_class_storage_media_write(storage, lba, sectors, host_buffer);
+        else
+            status =  _ux_host_class_storage_media_read(storage, lba, sectors, host_buffer);
+
+        ux_host_class_storage_unlock(storage);
+        if (status != UX_SUCCESS)
+        {
+            printf("ERROR #%d: %s %ld sectors at %ld, status 0x%x\n", __LINE__, test_name, sectors, lba, status);
+            return(status);
+        }
+
+        if (!random)
+            lba +=  sectors;
+    }
+
+    ux_benchmark_record(test_name, "sectors", sectors, operations,
+                        (ULONG64)operations * sectors * UX_RAM_DISK_BLOCK_LENGTH);
+    return(UX_SUCCESS);
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT            status;
+UX_HOST_CLASS   *class;
+UINT            i;
+
+
+    /* Find the main storage container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_storage_name, &class);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Wait for the storage instance to be live, the blank RAM disk is not mounted.  */
+    do
+    {
+        tx_thread_sleep(1);
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &storage);
+    } while ((status != UX_SUCCESS) || (storage -> ux_host_class_storage_state != UX_HOST_CLASS_INSTANCE_LIVE));
+
+    if (storage -> ux_host_class_storage_sector_size != UX_RAM_DISK_BLOCK_LENGTH)
+    {
+        printf("ERROR #%d: sector size %ld\n", __LINE__, storage -> ux_host_class_storage_sector_size);
+        test_control_return(1);
+    }
+
+    if (ux_benchmark_open("storage") != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Sequential throughput for each request size, then single sector IOPS.  */
+    for (i = 0; i < sizeof(sequential_sectors) / sizeof(sequential_sectors[0]); i++)
+    {
+        status  = storage_benchmark_run("sequential_write", UX_TRUE, UX_FALSE, sequential_sectors[i], UX_BENCHMARK_STORAGE_SEQUENTIAL_OPERATIONS);
+        status |= storage_benchmark_run("sequential_read", UX_FALSE, UX_FALSE, sequential_sectors[i], UX_BENCHMARK_STORAGE_SEQUENTIAL_OPERATIONS);
+        if (status != UX_SUCCESS)
+        {
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+    }
+    status  = storage_benchmark_run("random_write", UX_TRUE, UX_TRUE, 1, UX_BENCHMARK_STORAGE_RANDOM_OPERATIONS);
+    status |= storage_benchmark_run("random_read", UX_FALSE, UX_TRUE, 1, UX_BENCHMARK_STORAGE_RANDOM_OPERATIONS);
+    if (status != UX_SUCCESS)
+    {
+        ux_benchmark_close();
+        test_control_return(1);
+    }
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static UINT  demo_media_read(VOID *storage_instance, ULONG lun, UCHAR * data_pointer, ULONG number_blocks, ULONG lba, ULONG *media_status)
+{
+
+    /* The RAM disk is plain memory.  */
+    _ux_utility_memory_copy(data_pointer, ram_disk_memory + lba * UX_RAM_DISK_BLOCK_LENGTH,
+                            number_blocks * UX_RAM_DISK_BLOCK_LENGTH); /* Use case of memcpy is verified. */
+    *media_status =  0;
+    return(UX_SUCCESS);
+}
+
+
+static UINT  demo_media_write(VOID *storage_instance, ULONG lun, UCHAR * data_pointer, ULONG number_blocks, ULONG lba, ULONG *media_status)
+{
+
+    /* The RAM disk is plain memory.  */
+    _ux_utility_memory_copy(ram_disk_memory + lba * UX_RAM_DISK_BLOCK_LENGTH, data_pointer,
+                            number_blocks * UX_RAM_DISK_BLOCK_LENGTH); /* Use case of memcpy is verified. */
+    *media_status =  0;
+    return(UX_SUCCESS);
+}
+
+
+static UINT  demo_media_status(VOID *storage_instance, ULONG lun, ULONG media_id, ULONG *media_status)
+{
+
+    /* The RAM disk never changes.  */
+    *media_status =  0;
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,569 @@
+/* This benchmark measures the sustained video streaming rate from the simulated device to the host.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_device_class_video.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_video.h"
+#include "ux_benchmark.h"
+
+
+/* Define constants.  */
+
+#define UX_DEMO_STACK_SIZE                  4096
+#define UX_DEMO_MEMORY_SIZE                 (128*1024)
+
+
+/* Define benchmark constants.  */
+
+#define UX_BENCHMARK_VIDEO_PAYLOADS         256
+#define UX_BENCHMARK_VIDEO_PAYLOAD_SIZE     512
+#define UX_BENCHMARK_VIDEO_REQUESTS         4
+#define UX_BENCHMARK_VIDEO_PAYLOAD_BUFFERS  8
+
+
+/* Define local/extern function prototypes.  */
+
+static TX_THREAD                                tx_demo_thread_host_simulation;
+static TX_THREAD                                tx_demo_thread_slave_simulation;
+static TX_THREAD                                tx_demo_thread_bus_simulation;
+static void                                     tx_demo_thread_host_simulation_entry(ULONG);
+static void                                     tx_demo_thread_slave_simulation_entry(ULONG);
+static void                                     tx_demo_thread_bus_simulation_entry(ULONG);
+
+
+/* Define global data structures.  */
+
+static UX_HOST_CLASS_VIDEO                      *host_video;
+static UCHAR                                    host_video_buffer[UX_BENCHMARK_VIDEO_REQUESTS][UX_BENCHMARK_VIDEO_PAYLOAD_SIZE];
+static TX_SEMAPHORE                             host_request_semaphore;
+static ULONG                                    host_request_errors;
+static ULONG                                    host_bytes;
+
+static UX_DEVICE_CLASS_VIDEO                    *slave_video;
+static UX_DEVICE_CLASS_VIDEO_PARAMETER          slave_video_parameter;
+static UX_DEVICE_CLASS_VIDEO_STREAM_PARAMETER   slave_video_stream_parameter;
+static UX_DEVICE_CLASS_VIDEO_STREAM             *slave_video_tx_stream;
+static UCHAR                                    slave_video_probe[UX_HOST_CLASS_VIDEO_PROBE_COMMIT_LENGTH];
+static TX_SEMAPHORE                             device_start_semaphore;
+
+
+#define W(d)    UX_DW0(d), UX_DW1(d)
+#define DW(d)   UX_DW0(d), UX_DW1(d), UX_DW2(d), UX_DW3(d)
+
+#define _DEVICE_DESCRIPTOR()                                                                        \
+/* --------------------------------------- Device Descriptor */                                     \
+/* 0  bLength, bDescriptorType                               */ 18,   0x01,                         \
+/* 2  bcdUSB                                                 */ UX_DW0(0x200),UX_DW1(0x200),        \
+/* 4  bDeviceClass, bDeviceSubClass, bDeviceProtocol         */ 0x00, 0x00, 0x00,                   \
+/* 7  bMaxPacketSize0                                        */ 0x08,                               \
+/* 8  idVendor, idProduct                                    */ 0x84, 0x84, 0x01, 0x00,             \
+/* 12 bcdDevice                                              */ UX_DW0(0x100),UX_DW1(0x100),        \
+/* 14 iManufacturer, iProduct, iSerialNumber                 */ 0,    0,    0,                      \
+/* 17 bNumConfigurations                                     */ 1,
+
+#define _DEVICE_QUALIFIER_DESCRIPTOR()                                                              \
+/* ----------------------------- Device Qualifier Descriptor */                                     \
+/* 0 bLength, bDescriptorType                                */ 10,                 0x06,           \
+/* 2 bcdUSB                                                  */ UX_DW0(0x200),UX_DW1(0x200),        \
+/* 4 bDeviceClass, bDeviceSubClass, bDeviceProtocol          */ 0x00,               0x00, 0x00,     \
+/* 7 bMaxPacketSize0                                         */ 8,                                  \
+/* 8 bNumConfigurations                                      */ 1,                                  \
+/* 9 bReserved                                               */ 0,
+
+#define _CONFIGURE_DESCRIPTOR(total_len,n_ifc,cfg_v)                                                \
+/* -------------------------------- Configuration Descriptor */                                     \
+/* 0 bLength, bDescriptorType                                */ 9,    0x02,                         \
+/* 2 wTotalLength                                            */ UX_DW0(total_len),UX_DW1(total_len),\
+/* 4 bNumInterfaces, bConfigurationValue                     */ (n_ifc), (cfg_v),                   \
+/* 6 iConfiguration                                          */ 0,                                  \
+/* 7 bmAttributes, bMaxPower                                 */ 0x80, 50,
+
+#define _IAD_DESCRIPTOR(ifc_0,ifc_cnt,cls,sub,protocol)                                             \
+/* ------------------------ Interface Association Descriptor */                                     \
+/* 0 bLength, bDescriptorType                                */ 8,    0x0B,                         \
+/* 2 bFirstInterface, bInterfaceCount                        */ (ifc_0), (ifc_cnt),                 \
+/* 4 bFunctionClass, bFunctionSubClass, bFunctionProtocol    */ (cls), (sub), (protocol),           \
+/* 7 iFunction                                               */ 0,
+
+#define _INTERFACE_DESCRIPTOR(ifc,alt,n_ep,cls,sub,protocol)                                        \
+/* ------------------------------------ Interface Descriptor */                                     \
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,                         \
+/* 2 bInterfaceNumber, bAlternateSetting                     */ (ifc), (alt),                       \
+/* 4 bNumEndpoints                                           */ (n_ep),                             \
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ (cls), (sub), (protocol),           \
+/* 8 iInterface                                              */ 0,
+
+#define _ENDPOINT_DESCRIPTOR(addr,attr,pkt_siz,interval)                                            \
+/* ------------------------------------- Endpoint Descriptor */                                     \
+/* 0  bLength, bDescriptorType                                */ 7,               0x05,             \
+/* 2  bEndpointAddress, bmAttributes                          */ (addr),          (attr),           \
+/* 4  wMaxPacketSize, bInterval                               */ UX_DW0(pkt_siz),UX_DW1(pkt_siz),(interval),
+
+#define _VC_DESCRIPTORS_LEN (13+17+9)
+#define _VC_DESCRIPTORS()                                                                           \
+    /*--------------------------- Class VC Interface Descriptor (VC_HEADER).  */                    \
+    13, 0x24, 0x01, W(0x150),                                                                       \
+    W(_VC_DESCRIPTORS_LEN), /* wTotalLength.  */                                                    \
+    DW(6000000),  /* dwClockFrequency.  */                                                          \
+    1, /* bInCollection.  */                                                                        \
+    1, /* BaInterfaceNr(1).  */                                                                     \
+    /*--------------------------- Input Terminal (VC_INPUT_TERMINAL, Camera)  */                    \
+    17, 0x24, 0x02,                                                                                 \
+    0x01, /* bTerminalID, ITT_CAMERA  */                                                            \
+    W(0x201), /* wTerminalType  */                                                                  \
+    0x00, 0x00, W(0), W(0), W(0),                                                                   \
+    0x02, W(0), /* bControlSize, bmControls  */                                                     \
+    /*---------------------------- Output Terminal (VC_OUTPUT_TERMINAL, USB)  */                    \
+    9, 0x24, 0x03,                                                                                  \
+    0x02, /* bTerminalID  */                                                                        \
+    W(0x0101), /* wTerminalType, TT_STREAMING  */                                                   \
+    0x00, 0x01/* bSourceID  */, 0x00,
+
+#define _VS_IN_DESCRIPTORS_LEN (14+11+38)
+#define _VS_IN_DESCRIPTORS()                                                                        \
+    /*------------------------- Class VS Header Descriptor (VS_INPUT_HEADER)  */                    \
+    14, 0x24, 0x01,                                                                                 \
+    0X01, /* bNumFormats  */                                                                        \
+    W(_VS_IN_DESCRIPTORS_LEN), /* wTotalLength  */                                                  \
+    0x81, /* bEndpointAddress  */                                                                   \
+    0x00,                                                                                           \
+    0x02, /* bTerminalLink  */                                                                      \
+    0x00, /* bStillCaptureMethod  */                                                                \
+    0x00, 0x00, /* bTriggerSupport, bTriggerUsage  */                                               \
+    0x01, 0x00, /* bControlSize, bmaControls  */                                                    \
+    /*------------------------------- VS Format Descriptor (VS_FORMAT_MJPEG)  */                    \
+    11, 0x24, 0x06,                                                                                 \
+    0x01, /* bFormatIndex  */                                                                       \
+    0x01, /* bNumFrameDescriptors  */                                                               \
+    0x01, /* bmFlags  */                                                                            \
+    0x01, /* bDefaultFrameIndex  */                                                                 \
+    0x00, 0x00, 0x00, 0x00,                                                                         \
+    /*--------------------------------- VS Frame Descriptor (VS_FRAME_MJPEG)  */                    \
+    38, 0x24, 0x07,                                                                                 \
+    0x01, /* bFrameIndex  */                                                                        \
+    0x03, /* bmCapabilities  */                                                                     \
+    W(176), W(144), /* wWidth, wHeight  */                                                          \
+    DW(912384), DW(912384), /* dwMinBitRate, dwMaxBitRate  */                                       \
+    DW(38016), /* dwMaxVideoFrameBufSize  */                                                        \
+    DW(666666), /* dwDefaultFrameInterval  */                                                       \
+    0x00, /* bFrameIntervalType  */                                                                 \
+    DW(666666), DW(666666), DW(0), /* dwMinFrameInterval, dwMaxFrameInterval, dwFrameIntervalStep  */
+
+#define _CONFIGURE_DESCRIPTORS_LEN (9+ 8+ 9+_VC_DESCRIPTORS_LEN+ 9+_VS_IN_DESCRIPTORS_LEN+9+7)
+
+static unsigned char device_framework_full_speed[] = {
+    _DEVICE_DESCRIPTOR()
+     _CONFIGURE_DESCRIPTOR(_CONFIGURE_DESCRIPTORS_LEN,2,1)
+      _IAD_DESCRIPTOR(0,2,0x0E,0x03,0x00)
+
+       _INTERFACE_DESCRIPTOR(0,0,0,0x0E,0x01,0x00)
+        _VC_DESCRIPTORS()
+
+       _INTERFACE_DESCRIPTOR(1,0,0,0x0E,0x02,0x00)
+        _VS_IN_DESCRIPTORS()
+        _INTERFACE_DESCRIPTOR(1,1,1,0x0E,0x02,0x00)
+        _ENDPOINT_DESCRIPTOR(0x81,0x05,UX_BENCHMARK_VIDEO_PAYLOAD_SIZE,0x01)
+};
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED sizeof(device_framework_full_speed)
+
+static unsigned char device_framework_high_speed[] = {
+    _DEVICE_DESCRIPTOR()
+     _DEVICE_QUALIFIER_DESCRIPTOR()
+     _CONFIGURE_DESCRIPTOR(_CONFIGURE_DESCRIPTORS_LEN,2,1)
+      _IAD_DESCRIPTOR(0,2,0x0E,0x03,0x00)
+
+       _INTERFACE_DESCRIPTOR(0,0,0,0x0E,0x01,0x00)
+        _VC_DESCRIPTORS()
+
+       _INTERFACE_DESCRIPTOR(1,0,0,0x0E,0x02,0x00)
+        _VS_IN_DESCRIPTORS()
+        _INTERFACE_DESCRIPTOR(1,1,1,0x0E,0x02,0x00)
+        _ENDPOINT_DESCRIPTOR(0x81,0x05,UX_BENCHMARK_VIDEO_PAYLOAD_SIZE,0x01)
+};
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED sizeof(device_framework_high_speed)
+
+static unsigned char string_framework[] = {
+
+/* Manufacturer string descriptor : Index 1 - "Express Logic" */
+    0x09, 0x04, 0x01, 0x0c,
+    0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+    0x6f, 0x67, 0x69, 0x63,
+
+/* Product string descriptor : Index 2 - "EL Composite device" */
+    0x09, 0x04, 0x02, 0x13,
+    0x45, 0x4c, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+    0x73, 0x69, 0x74, 0x65, 0x20, 0x64, 0x65, 0x76,
+    0x69, 0x63, 0x65,
+
+/* Serial Number string descriptor : Index 3 - "0001" */
+    0x09, 0x04, 0x03, 0x04,
+    0x30, 0x30, 0x30, 0x31
+};
+#define STRING_FRAMEWORK_LENGTH sizeof(string_framework)
+
+
+/* Multiple languages are supported on the device, to add
+    a language besides English, the Unicode language code must
+    be appended to the language_id_framework array and the length
+    adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+/* English. */
+    0x09, 0x04
+};
+#define LANGUAGE_ID_FRAMEWORK_LENGTH sizeof(language_id_framework)
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID  slave_video_activate(VOID *video_instance)
+{
+    slave_video = (UX_DEVICE_CLASS_VIDEO *)video_instance;
+    ux_device_class_video_stream_get(slave_video, 0, &slave_video_tx_stream);
+}
+
+
+static VOID  slave_video_deactivate(VOID *video_instance)
+{
+    if ((VOID *)slave_video == video_instance)
+    {
+        slave_video = UX_NULL;
+        slave_video_tx_stream = UX_NULL;
+    }
+}
+
+
+static UINT  slave_video_vc_request(UX_DEVICE_CLASS_VIDEO *video, UX_SLAVE_TRANSFER *transfer)
+{
+
+    /* No unit or terminal controls.  */
+    return(UX_ERROR);
+}
+
+
+static UINT  slave_video_vs_request(UX_DEVICE_CLASS_VIDEO_STREAM *stream, UX_SLAVE_TRANSFER *transfer)
+{
+
+UCHAR       request;
+UCHAR       control;
+ULONG       length;
+
+
+    request =  transfer -> ux_slave_transfer_request_setup[UX_SETUP_REQUEST];
+    control =  transfer -> ux_slave_transfer_request_setup[UX_SETUP_VALUE + 1];
+    length =   _ux_utility_short_get(transfer -> ux_slave_transfer_request_setup + UX_SETUP_LENGTH);
+
+    if (control != UX_DEVICE_CLASS_VIDEO_VS_PROBE_CONTROL && control != UX_DEVICE_CLASS_VIDEO_VS_COMMIT_CONTROL)
+        return(UX_ERROR);
+
+    /* Probe and commit always settle on the single format and frame, at the full payload size.  */
+    if (request == UX_DEVICE_CLASS_VIDEO_SET_CUR)
+        return(UX_SUCCESS);
+
+    ux_utility_memory_set(slave_video_probe, 0, sizeof(slave_video_probe));
+    slave_video_probe[UX_DEVICE_CLASS_VIDEO_PROBE_COMMIT_CONTROL_FORMAT_INDEX_OFFSET] = 1;
+    slave_video_probe[UX_DEVICE_CLASS_VIDEO_PROBE_COMMIT_CONTROL_FRAME_INDEX_OFFSET] = 1;
+    _ux_utility_long_put(slave_video_probe + UX_DEVICE_CLASS_VIDEO_PROBE_COMMIT_CONTROL_FRAME_INTERVAL_OFFSET, 666666);
+    _ux_utility_long_put(slave_video_probe + UX_DEVICE_CLASS_VIDEO_PROBE_COMMIT_CONTROL_MAX_VIDEO_FRAME_SIZE_OFFSET, 38016);
+    _ux_utility_long_put(slave_video_probe + UX_DEVICE_CLASS_VIDEO_PROBE_COMMIT_CONTROL_MAX_PAYLOAD_TRANSFER_SIZE_OFFSET,
+                         UX_BENCHMARK_VIDEO_PAYLOAD_SIZE);
+    length =  UX_MIN(length, sizeof(slave_video_probe));
+    ux_utility_memory_copy(transfer -> ux_slave_transfer_request_data_pointer, slave_video_probe, length);
+    return(ux_device_stack_transfer_request(transfer, length, length));
+}
+
+
+static VOID  slave_video_payload_write(UX_DEVICE_CLASS_VIDEO_STREAM *stream)
+{
+
+UCHAR       *payload;
+ULONG       length;
+
+
+    if (ux_device_class_video_write_payload_get(stream, &payload, &length) != UX_SUCCESS)
+        return;
+
+    /* Two bytes payload header, the rest is image data.  */
+    payload[0] =  2;
+    payload[1] =  0x80;
+    ux_device_class_video_write_payload_commit(stream, UX_BENCHMARK_VIDEO_PAYLOAD_SIZE);
+}
+
+
+static VOID  slave_video_tx_done(UX_DEVICE_CLASS_VIDEO_STREAM *stream, ULONG length)
+{
+
+    /* Keep the device side queue full.  */
+    slave_video_payload_write(stream);
+}
+
+
+static UINT  test_host_change_function(ULONG event, UX_HOST_CLASS *cls, VOID *inst)
+{
+
+UX_HOST_CLASS_VIDEO *video = (UX_HOST_CLASS_VIDEO *) inst;
+
+
+    switch(event)
+    {
+
+        case UX_DEVICE_INSERTION:
+
+            host_video = video;
+            break;
+
+        case UX_DEVICE_REMOVAL:
+
+            if (video == host_video)
+                host_video = UX_NULL;
+            break;
+
+        default:
+            break;
+    }
+    return(UX_SUCCESS);
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_video_benchmark_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running Video Streaming Sustain Benchmark........................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 3);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(test_host_change_function);
+    status |= ux_host_stack_class_register(_ux_system_host_class_video_name, ux_host_class_video_entry);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX.  */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* A single stream sends to the host.  */
+    ux_utility_memory_set(&slave_video_parameter, 0, sizeof(slave_video_parameter));
+    ux_utility_memory_set(&slave_video_stream_parameter, 0, sizeof(slave_video_stream_parameter));
+#if defined(UX_DEVICE_STANDALONE)
+    slave_video_stream_parameter.ux_device_class_video_stream_parameter_task_function = ux_device_class_video_write_task_function;
+#else
+    slave_video_stream_parameter.ux_device_class_video_stream_parameter_thread_entry = ux_device_class_video_write_thread_entry;
+#endif
+    slave_video_stream_parameter.ux_device_class_video_stream_parameter_callbacks.ux_device_class_video_stream_payload_done = slave_video_tx_done;
+    slave_video_stream_parameter.ux_device_class_video_stream_parameter_callbacks.ux_device_class_video_stream_request = slave_video_vs_request;
+    slave_video_stream_parameter.ux_device_class_video_stream_parameter_max_payload_buffer_size = UX_BENCHMARK_VIDEO_PAYLOAD_SIZE;
+    slave_video_stream_parameter.ux_device_class_video_stream_parameter_max_payload_buffer_nb   = UX_BENCHMARK_VIDEO_PAYLOAD_BUFFERS;
+    slave_video_parameter.ux_device_class_video_parameter_streams = &slave_video_stream_parameter;
+    slave_video_parameter.ux_device_class_video_parameter_streams_nb = 1;
+    slave_video_parameter.ux_device_class_video_parameter_callbacks.ux_slave_class_video_instance_activate   = slave_video_activate;
+    slave_video_parameter.ux_device_class_video_parameter_callbacks.ux_slave_class_video_instance_deactivate = slave_video_deactivate;
+    slave_video_parameter.ux_device_class_video_parameter_callbacks.ux_device_class_video_request = slave_video_vc_request;
+
+    /* Initialize the device Video class. This class owns interfaces starting with 0.  */
+    status =  ux_device_stack_class_register(_ux_system_device_class_video_name, ux_device_class_video_entry,
+                                             1, 0, &slave_video_parameter);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system.  */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize, 0, 0);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the semaphores for the requests in flight and to start the device side.  */
+    status =  tx_semaphore_create(&host_request_semaphore, "host requests", UX_BENCHMARK_VIDEO_REQUESTS);
+    status |= tx_semaphore_create(&device_start_semaphore, "device start", 0);
+
+    /* Create the main host simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main device simulation thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the thread moving isochronous packets, one per frame.  */
+    status |= tx_thread_create(&tx_demo_thread_bus_simulation, "tx demo bus simulation", tx_demo_thread_bus_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE * 2, UX_DEMO_STACK_SIZE,
+            19, 19, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static VOID  video_request_completion(UX_TRANSFER *transfer)
+{
+
+    /* Free the request slot.  */
+    if (transfer -> ux_transfer_request_completion_code != UX_SUCCESS)
+        host_request_errors++;
+    host_bytes +=  transfer -> ux_transfer_request_actual_length;
+    tx_semaphore_put(&host_request_semaphore);
+}
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT        status;
+ULONG       i;
+
+
+    /* Wait for the streaming interface on both sides.  */
+    while (host_video == UX_NULL || slave_video_tx_stream == UX_NULL)
+        tx_thread_sleep(1);
+
+    /* Negotiate the stream and select the streaming alternate setting.  */
+    status =  ux_host_class_video_frame_parameters_set(host_video, UX_HOST_CLASS_VIDEO_VS_FORMAT_MJPEG, 176, 144, 666666);
+    if (status == UX_SUCCESS)
+        status =  ux_host_class_video_start(host_video);
+    if (status != UX_SUCCESS)
+    {
+        printf("ERROR #%d: start status 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    ux_host_class_video_transfer_callback_set(host_video, video_request_completion);
+
+    /* Let the device start its stream.  */
+    tx_semaphore_put(&device_start_semaphore);
+
+    if (ux_benchmark_open("video") != UX_SUCCESS)
+        test_control_return(1);
+
+    host_request_errors =  0;
+    host_bytes =  0;
+
+    ux_benchmark_start();
+
+    /* Keep the payload buffers queued back to back, the stream must not starve.  */
+    for (i = 0; i < UX_BENCHMARK_VIDEO_PAYLOADS; i++)
+    {
+        if (tx_semaphore_get(&host_request_semaphore, UX_PERIODIC_RATE) != TX_SUCCESS)
+        {
+            printf("ERROR #%d: payload %ld not completed\n", __LINE__, i);
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+
+        status =  ux_host_class_video_transfer_buffer_add(host_video, host_video_buffer[i % UX_BENCHMARK_VIDEO_REQUESTS]);
+        if (status != UX_SUCCESS)
+        {
+            printf("ERROR #%d: payload %ld status 0x%x\n", __LINE__, i, status);
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+    }
+
+    /* Drain the requests in flight.  */
+    for (i = 0; i < UX_BENCHMARK_VIDEO_REQUESTS; i++)
+    {
+        if (tx_semaphore_get(&host_request_semaphore, UX_PERIODIC_RATE) != TX_SUCCESS)
+        {
+            printf("ERROR #%d: not drained\n", __LINE__);
+            ux_benchmark_close();
+            test_control_return(1);
+        }
+    }
+    if (host_request_errors || host_bytes != UX_BENCHMARK_VIDEO_PAYLOADS * UX_BENCHMARK_VIDEO_PAYLOAD_SIZE)
+    {
+        printf("ERROR #%d: %ld request errors, %ld bytes\n", __LINE__, host_request_errors, host_bytes);
+        ux_benchmark_close();
+        test_control_return(1);
+    }
+
+    ux_benchmark_record("iso_in_sustain", "payload_size", UX_BENCHMARK_VIDEO_PAYLOAD_SIZE,
+                        UX_BENCHMARK_VIDEO_PAYLOADS, host_bytes);
+
+    if (ux_benchmark_close() != UX_SUCCESS)
+        test_control_return(1);
+
+    /* Successful benchmark.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+ULONG       i;
+
+
+    /* Wait for the host to select the streaming interface.  */
+    tx_semaphore_get(&device_start_semaphore, TX_WAIT_FOREVER);
+    while (slave_video_tx_stream -> ux_device_class_video_stream_endpoint == UX_NULL)
+        tx_thread_sleep(1);
+
+    /* Prefill the payloads to send, then start the stream.  */
+    for (i = 0; i < UX_BENCHMARK_VIDEO_PAYLOAD_BUFFERS - 1; i++)
+        slave_video_payload_write(slave_video_tx_stream);
+    ux_device_class_video_transmission_start(slave_video_tx_stream);
+
+    while(1)
+        tx_thread_sleep(UX_PERIODIC_RATE);
+}
+
+
+static void  tx_demo_thread_bus_simulation_entry(ULONG arg)
+{
+
+    while(1)
+    {
+        ux_benchmark_isochronous_exchange();
+        tx_thread_sleep(1);
+    }
+}
@@ -0,0 +1,225 @@
+/* USBX benchmark result recording.  */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_hcd_sim_host.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_benchmark.h"
+
+
+static FILE             *ux_benchmark_file;
+static CHAR             *ux_benchmark_name;
+static ULONG            ux_benchmark_results;
+static struct timespec  ux_benchmark_start_time;
+static ULONG            ux_benchmark_start_ticks;
+
+
+UINT  ux_benchmark_open(CHAR *benchmark_name)
+{
+
+CHAR    path[UX_BENCHMARK_PATH_LENGTH];
+CHAR    *directory;
+
+
+    /* Results go to the output directory, if given.  */
+    directory =  getenv(UX_BENCHMARK_OUTPUT_ENV);
+    if (directory != UX_NULL && directory[0] != 0)
+        snprintf(path, sizeof(path), "%s/%s.json", directory, benchmark_name);
+    else
+        snprintf(path, sizeof(path), "%s.json", benchmark_name);
+
+    ux_benchmark_file =  fopen(path, "w");
+    if (ux_benchmark_file == UX_NULL)
+    {
+        printf("ERROR: can not create %s\n", path);
+        return(UX_ERROR);
+    }
+
+    ux_benchmark_name =  benchmark_name;
+    ux_benchmark_results =  0;
+
+    fprintf(ux_benchmark_file, "{\n");
+    fprintf(ux_benchmark_file, "  \"benchmark\": \"%s\",\n", benchmark_name);
+    fprintf(ux_benchmark_file, "  \"version\": \"%s\",\n", _ux_version_id);
+    fprintf(ux_benchmark_file, "  \"ticks_per_second\": %lu,\n", (unsigned long)UX_PERIODIC_RATE);
+    fprintf(ux_benchmark_file, "  \"results\": [");
+    return(UX_SUCCESS);
+}
+
+
+VOID  ux_benchmark_start(VOID)
+{
+
+    /* Take both clocks, wall time gives the rates.  */
+    ux_benchmark_start_ticks =  tx_time_get();
+    clock_gettime(CLOCK_MONOTONIC, &ux_benchmark_start_time);
+}
+
+
+VOID  ux_benchmark_record(CHAR *test_name, CHAR *parameter_name, ULONG parameter,
+                          ULONG operations, ULONG64 bytes)
+{
+
+struct timespec now;
+ULONG           ticks;
+double          elapsed_us;
+double          operations_per_second;
+double          megabytes_per_second;
+
+
+    /* Stop the clocks.  */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    ticks =  tx_time_get() - ux_benchmark_start_ticks;
+
+    elapsed_us =  (double)(now.tv_sec - ux_benchmark_start_time.tv_sec) * 1000000.0 +
+                  (double)(now.tv_nsec - ux_benchmark_start_time.tv_nsec) / 1000.0;
+    if (elapsed_us < 1.0)
+        elapsed_us =  1.0;
+
+    operations_per_second =  (double)operations * 1000000.0 / elapsed_us;
+    megabytes_per_second =   (double)bytes / elapsed_us;
+
+    printf("\n    %-24s %-14s %6lu: %10.1f op/s %10.3f MB/s (%lu ticks)",
+           test_name, parameter_name, (unsigned long)parameter,
+           operations_per_second, megabytes_per_second, (unsigned long)ticks);
+
+    if (ux_benchmark_file == UX_NULL)
+        return;
+
+    fprintf(ux_benchmark_file, "%s\n    {", ux_benchmark_results ? "," : "");
+    fprintf(ux_benchmark_file, " \"test\": \"%s\", \"parameter\": \"%s\", \"value\": %lu,",
+            test_name, parameter_name, (unsigned long)parameter);
+    fprintf(ux_benchmark_file, " \"operations\": %lu, \"bytes\": %llu,",
+            (unsigned long)operations, (unsigned long long)bytes);
+    fprintf(ux_benchmark_file, " \"elapsed_us\": %.0f, \"ticks\": %lu,",
+            elapsed_us, (unsigned long)ticks);
+    fprintf(ux_benchmark_file, " \"operations_per_second\": %.3f, \"megabytes_per_second\": %.6f }",
+            operations_per_second, megabytes_per_second);
+    ux_benchmark_results++;
+}
+
+
+UINT  ux_benchmark_close(VOID)
+{
+
+    if (ux_benchmark_file == UX_NULL)
+        return(UX_ERROR);
+
+    fprintf(ux_benchmark_file, "\n  ]\n}\n");
+    fclose(ux_benchmark_file);
+    ux_benchmark_file =  UX_NULL;
+
+    printf("\n    %lu results in %s.json\n", ux_benchmark_results, ux_benchmark_name);
+    return(UX_SUCCESS);
+}
+
+
+static VOID  ux_benchmark_isochronous_packet(UX_HCD_SIM_HOST_ED *ed, UX_DCD_SIM_SLAVE *dcd_sim_slave)
+{
+
+UX_HCD_SIM_HOST_ISO_TD  *td;
+UX_ENDPOINT             *endpoint;
+UX_TRANSFER             *transfer_request;
+UX_DCD_SIM_SLAVE_ED     *slave_ed;
+UX_SLAVE_TRANSFER       *slave_transfer_request;
+ULONG                   endpoint_index;
+ULONG                   length;
+
+
+    /* Nothing queued on this endpoint.  */
+    if (ed -> ux_sim_host_ed_head_td == ed -> ux_sim_host_ed_tail_td)
+        return;
+
+    td =  (UX_HCD_SIM_HOST_ISO_TD *) ((void *) ed -> ux_sim_host_ed_head_td);
+    transfer_request =  td -> ux_sim_host_iso_td_transfer_request;
+    endpoint =  transfer_request -> ux_transfer_request_endpoint;
+    endpoint_index =  endpoint -> ux_endpoint_descriptor.bEndpointAddress & ~(ULONG)UX_ENDPOINT_DIRECTION;
+
+    /* Get the endpoint as seen from the device side.  */
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    slave_ed = (endpoint -> ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) ?
+                &dcd_sim_slave -> ux_dcd_sim_slave_ed_in[endpoint_index] :
+                &dcd_sim_slave -> ux_dcd_sim_slave_ed[endpoint_index];
+#else
+    slave_ed =  &dcd_sim_slave -> ux_dcd_sim_slave_ed[endpoint_index];
+#endif
+
+    /* The device must have a transfer pending, the packet waits for it otherwise.  */
+    if ((slave_ed -> ux_sim_slave_ed_status & UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER) == 0)
+        return;
+    slave_transfer_request =  &slave_ed -> ux_sim_slave_ed_endpoint -> ux_slave_endpoint_transfer_request;
+
+    /* Move one packet.  */
+    length =  UX_MIN(td -> ux_sim_host_iso_td_length,
+                     slave_transfer_request -> ux_slave_transfer_request_requested_length);
+    if (td -> ux_sim_host_iso_td_direction == UX_HCD_SIM_HOST_TD_OUT)
+        _ux_utility_memory_copy(slave_transfer_request -> ux_slave_transfer_request_current_data_pointer,
+                                td -> ux_sim_host_iso_td_buffer, length); /* Use case of memcpy is verified. */
+    else
+        _ux_utility_memory_copy(td -> ux_sim_host_iso_td_buffer,
+                                slave_transfer_request -> ux_slave_transfer_request_current_data_pointer, length); /* Use case of memcpy is verified. */
+    transfer_request -> ux_transfer_request_actual_length +=  length;
+    slave_transfer_request -> ux_slave_transfer_request_actual_length =  length;
+
+    /* Complete the device side, one packet per transfer.  */
+    slave_transfer_request -> ux_slave_transfer_request_completion_code =  UX_SUCCESS;
+    slave_transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
+    slave_ed -> ux_sim_slave_ed_status &= ~(ULONG)UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
+    slave_ed -> ux_sim_slave_ed_status |= UX_DCD_SIM_SLAVE_ED_STATUS_DONE;
+    _ux_device_semaphore_put(&slave_transfer_request -> ux_slave_transfer_request_semaphore);
+
+    /* Retire the TD.  */
+    ed -> ux_sim_host_ed_head_td =  (UX_HCD_SIM_HOST_TD *) ((void *) td -> ux_sim_host_iso_td_next_td);
+    td -> ux_sim_host_iso_td_status =  UX_UNUSED;
+
+    /* Complete the host side after the last TD of the request.  */
+    if (ed -> ux_sim_host_ed_head_td == ed -> ux_sim_host_ed_tail_td ||
+        td -> ux_sim_host_iso_td_next_td -> ux_sim_host_iso_td_transfer_request != transfer_request)
+    {
+        transfer_request -> ux_transfer_request_completion_code =  UX_SUCCESS;
+        transfer_request -> ux_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
+        if (transfer_request -> ux_transfer_request_completion_function != UX_NULL)
+            transfer_request -> ux_transfer_request_completion_function(transfer_request);
+        _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
+    }
+}
+
+
+VOID  ux_benchmark_isochronous_exchange(VOID)
+{
+
+UX_HCD                  *hcd;
+UX_HCD_SIM_HOST         *hcd_sim_host;
+UX_DCD_SIM_SLAVE        *dcd_sim_slave;
+UX_HCD_SIM_HOST_ED      *ed;
+UX_INTERRUPT_SAVE_AREA
+
+
+    /* Both simulated controllers must be running.  */
+    if (_ux_system_host == UX_NULL || _ux_system_slave == UX_NULL)
+        return;
+    hcd =  &_ux_system_host -> ux_system_host_hcd_array[0];
+    if (hcd -> ux_hcd_status != UX_HCD_STATUS_OPERATIONAL ||
+        _ux_system_slave -> ux_system_slave_dcd.ux_slave_dcd_status != UX_DCD_STATUS_OPERATIONAL)
+        return;
+    hcd_sim_host =  (UX_HCD_SIM_HOST *) hcd -> ux_hcd_controller_hardware;
+    dcd_sim_slave =  (UX_DCD_SIM_SLAVE *) _ux_system_slave -> ux_system_slave_dcd.ux_slave_dcd_controller_hardware;
+
+    /* The class threads queue and complete requests, keep the lists still.  */
+    UX_DISABLE
+
+    ed =  hcd_sim_host -> ux_hcd_sim_host_iso_head_ed;
+    while (ed != UX_NULL)
+    {
+        ux_benchmark_isochronous_packet(ed, dcd_sim_slave);
+        ed =  ed -> ux_sim_host_ed_next_ed;
+    }
+
+    UX_RESTORE
+}
@@ -0,0 +1,41 @@
+/* USBX benchmark result recording.  */
+
+#ifndef _UX_BENCHMARK_H
+#define _UX_BENCHMARK_H
+
+#include "ux_api.h"
+
+/* Each benchmark program writes one JSON document named <benchmark>.json, in
+   the directory given by USBX_BENCHMARK_OUTPUT or in current directory.
+
+   {
+     "benchmark": "dpump",
+     "version": "...",
+     "ticks_per_second": 100,
+     "results": [
+       { "test": "bulk_out", "parameter": "transfer_size", "value": 512,
+         "operations": 64, "bytes": 32768, "elapsed_us": 640000, "ticks": 64,
+         "operations_per_second": 100.0, "megabytes_per_second": 0.05 }
+     ]
+   }
+
+   Rates are computed from host wall clock time, ticks are the RTOS timer
+   ticks elapsed in the same interval. The simulated controllers progress on
+   timer ticks so both should be compared between releases.  */
+
+#define UX_BENCHMARK_OUTPUT_ENV             "USBX_BENCHMARK_OUTPUT"
+#define UX_BENCHMARK_PATH_LENGTH            256
+
+UINT    ux_benchmark_open(CHAR *benchmark_name);
+VOID    ux_benchmark_start(VOID);
+VOID    ux_benchmark_record(CHAR *test_name, CHAR *parameter_name, ULONG parameter,
+                            ULONG operations, ULONG64 bytes);
+UINT    ux_benchmark_close(VOID);
+
+/* The host simulator does not schedule isochronous transfers (regression
+   tests complete them with hooks). Streaming benchmarks call this once per
+   frame to move one packet on each isochronous endpoint that has a host TD
+   and a device transfer request pending.  */
+VOID    ux_benchmark_isochronous_exchange(VOID);
+
+#endif
@@ -0,0 +1,696 @@
+/* This test is designed to test that the EHCI driver returns each qTD to the free list
+   once: when a transfer completes with IOC and when it ends in error, the TDs cleaned
+   from the ED must all be back in the free list and none of them twice.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+#include "ux_hcd_ehci.h"
+#include "ux_hcd_ehci_model.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_BUFFER_SIZE     2048
+#define UX_DEMO_RUN             1
+#define UX_DEMO_MEMORY_SIZE     (256*1024)
+
+
+/* Define the counters used in the demo application...  */
+
+static ULONG                           thread_0_counter;
+static ULONG                           thread_1_counter;
+static ULONG                           error_counter;
+
+
+/* Define USBX demo global variables.  */
+
+static UCHAR                           *host_out_buffer;
+static UCHAR                           *host_in_buffer;
+static unsigned char                   slave_buffer[UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+
+static UX_HOST_CLASS                   *class_driver;
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static UINT                             expected_error;
+
+#define UX_TEST_TRANSFERS                       20
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+#endif
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+#endif
+    };
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides English, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+
+#if defined(UX_HOST_STANDALONE)
+static UINT                tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p);
+#else
+#define                     tx_demo_host_change_function UX_NULL
+#endif
+
+UINT                       _ux_host_class_dpump_entry(UX_HOST_CLASS_COMMAND *command);
+UINT                       ux_hcd_sim_initialize(UX_HCD *hcd);
+UINT                       _ux_host_class_dpump_write(UX_HOST_CLASS_DPUMP *dpump, UCHAR * data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+UINT                       _ux_host_class_dpump_read (UX_HOST_CLASS_DPUMP *dpump, UCHAR *data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+static void                tx_demo_round_trips(UINT count);
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+static ULONG               test_td_free_list_length(UX_HCD_EHCI *hcd_ehci);
+static ULONG               test_td_unused_count(UX_HCD_EHCI *hcd_ehci);
+#endif
+
+
+/* Define the ISR dispatch.  */
+
+extern VOID    (*test_isr_dispatch)(void);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define the ISR dispatch routine.  */
+
+static void    test_isr(void)
+{
+
+    /* For further expansion of interrupt-level testing.  */
+}
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    if (expected_error == 0 || error_code != expected_error)
+    {
+        /* Failed test.  */
+        printf("Error on line %d, system_level: %d, system_context: %d, error code: %x\n", __LINE__, system_level, system_context, error_code);
+        // test_control_return(1);
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hcd_ehci_td_free_list_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running EHCI TD Free List Test...................................... ");
+
+#if !defined(UX_HCD_EHCI_MODEL_ENABLE) || defined(UX_HOST_STANDALONE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(tx_demo_host_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the host class drivers for this USBX implementation.  */
+    status =  ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+     status =  ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                               1, 0, &parameter);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+
+    /* Register the EHCI driver on the EHCI controller model.  */
+    status =  ux_host_stack_hcd_register((UCHAR *)"ux_hcd_ehci_model", ux_hcd_ehci_model_initialize, 0, 0);
+#endif
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main demo thread.  */
+    status =  tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static void  tx_demo_round_trips(UINT count)
+{
+
+UINT                            status;
+ULONG                           actual_length;
+UINT                            i;
+
+
+    for (i = 0; i < count; i++)
+    {
+
+        /* Increment thread counter.  */
+        thread_0_counter++;
+
+        /* Write to the host Data Pump Bulk out endpoint.  */
+        _ux_utility_memory_set(host_out_buffer, (UCHAR)('A' + (i & 0xf)), UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        status =  _ux_host_class_dpump_write (dpump, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+
+        /* Read from the Data Pump Bulk in endpoint.  */
+        status =  _ux_host_class_dpump_read (dpump, host_in_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+        UX_TEST_ASSERT(_ux_utility_memory_compare(host_in_buffer, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE) == UX_SUCCESS);
+    }
+}
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+static ULONG  test_td_free_list_length(UX_HCD_EHCI *hcd_ehci)
+{
+
+UX_EHCI_TD      *td;
+ULONG           length;
+
+
+    /* A TD put twice in the list links to itself, the walk is bounded by the pool size.  */
+    length = 0;
+    td = hcd_ehci -> ux_hcd_ehci_td_free_list;
+    while ((td != UX_NULL) && (length <= _ux_system_host -> ux_system_host_max_td))
+    {
+        UX_TEST_ASSERT(td -> ux_ehci_td_status == UX_UNUSED);
+        length ++;
+        td = td -> ux_ehci_td_next_td_transfer_request;
+    }
+    return(length);
+}
+
+static ULONG  test_td_unused_count(UX_HCD_EHCI *hcd_ehci)
+{
+
+ULONG           i;
+ULONG           count;
+
+
+    count = 0;
+    for (i = 0; i < _ux_system_host -> ux_system_host_max_td; i ++)
+    {
+        if (hcd_ehci -> ux_hcd_ehci_td_list[i].ux_ehci_td_status == UX_UNUSED)
+            count ++;
+    }
+    return(count);
+}
+#endif
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                            status;
+UX_HOST_CLASS                   *class;
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+UX_HCD                          *hcd;
+UX_HCD_EHCI                     *hcd_ehci;
+UX_TRANSFER                     *transfer_request;
+ULONG                           free_tds;
+#endif
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE)
+    {
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    }
+
+    /* Allocate the host buffers.  */
+    host_out_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    host_in_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    UX_TEST_ASSERT(host_out_buffer != UX_NULL);
+    UX_TEST_ASSERT(host_in_buffer != UX_NULL);
+
+#if defined(UX_HCD_EHCI_MODEL_ENABLE) && !defined(UX_HOST_STANDALONE)
+    hcd = &_ux_system_host -> ux_system_host_hcd_array[0];
+    hcd_ehci = (UX_HCD_EHCI *) hcd -> ux_hcd_controller_hardware;
+    UX_TEST_ASSERT(hcd -> ux_hcd_controller_type == UX_EHCI_CONTROLLER);
+
+    /* Once enumerated, no TD is left attached to the EDs.  */
+    free_tds = test_td_free_list_length(hcd_ehci);
+    UX_TEST_ASSERT(free_tds == test_td_unused_count(hcd_ehci));
+    UX_TEST_ASSERT(free_tds == _ux_system_host -> ux_system_host_max_td);
+
+    /* Bulk round trips complete with IOC, their TDs go back to the free list once.  */
+    tx_demo_round_trips(UX_TEST_TRANSFERS);
+    UX_TEST_ASSERT(test_td_free_list_length(hcd_ehci) == free_tds);
+    UX_TEST_ASSERT(test_td_unused_count(hcd_ehci) == free_tds);
+
+    /* A request not supported by the device stalls the data phase: the setup TD is
+       retired first, the data TD ends in error and is cleaned with the status TD.  */
+    transfer_request = &dpump -> ux_host_class_dpump_device -> ux_device_control_endpoint.ux_endpoint_transfer_request;
+    transfer_request -> ux_transfer_request_data_pointer =      host_in_buffer;
+    transfer_request -> ux_transfer_request_requested_length =  0x09;
+    transfer_request -> ux_transfer_request_function =          UX_GET_DESCRIPTOR;
+    transfer_request -> ux_transfer_request_type =              UX_REQUEST_IN | UX_REQUEST_TYPE_CLASS | UX_REQUEST_TARGET_DEVICE;
+    transfer_request -> ux_transfer_request_value =             0xffff << 8;
+    transfer_request -> ux_transfer_request_index =             0x02;
+    expected_error = UX_TRANSFER_STALLED;
+    status = ux_host_stack_transfer_request(transfer_request);
+    expected_error = 0;
+    UX_TEST_ASSERT(status == UX_TRANSFER_STALLED);
+    UX_TEST_ASSERT(test_td_free_list_length(hcd_ehci) == free_tds);
+    UX_TEST_ASSERT(test_td_unused_count(hcd_ehci) == free_tds);
+
+    /* The TDs obtained after the error come from a sane free list.  */
+    tx_demo_round_trips(UX_TEST_TRANSFERS);
+    UX_TEST_ASSERT(test_td_free_list_length(hcd_ehci) == free_tds);
+    UX_TEST_ASSERT(test_td_unused_count(hcd_ehci) == free_tds);
+#endif
+
+    _ux_utility_memory_free(host_in_buffer);
+    _ux_utility_memory_free(host_out_buffer);
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+#if defined(UX_DEVICE_STANDALONE)
+#define DPUMP_DEVICE_STATE_READ     UX_STATE_STEP
+#define DPUMP_DEVICE_STATE_WRITE    UX_STATE_STEP + 1
+UINT    dpump_device_state = UX_STATE_RESET;
+#endif
+
+
+    while(1)
+    {
+#if defined(UX_DEVICE_STANDALONE)
+
+        /* Run device tasks.  */
+        ux_system_tasks_run();
+
+        /* DPUMP echo state machine.  */
+        switch(dpump_device_state)
+        {
+        case UX_STATE_RESET:
+            if (dpump_slave != UX_NULL)
+
+                /* Start reading.  */
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+
+        case DPUMP_DEVICE_STATE_READ:
+
+            /* Read from the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_read_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: read status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+            {
+                if (actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+                {
+                    printf("ERROR #%d: read length %ld\n", __LINE__, actual_length);
+                    error_counter ++;
+                    return;
+                }
+
+                dpump_device_state = DPUMP_DEVICE_STATE_WRITE;
+            }
+            break;
+
+        case DPUMP_DEVICE_STATE_WRITE:
+
+            /* Now write to the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_write_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: write status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+        
+        default:
+            dpump_device_state = UX_STATE_RESET;
+        }
+
+        /* Increment thread counter.  */
+        thread_1_counter++;
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+
+#else
+        /* Ensure the dpump class on the device is still alive.  */
+        while (dpump_slave != UX_NULL)
+        {
+
+            /* Increment thread counter.  */
+            thread_1_counter++;
+
+            /* Read from the device data pump.  */
+            status =  _ux_device_class_dpump_read(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: read status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+
+            /* Now write to the device data pump.  */
+            status =  _ux_device_class_dpump_write(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: write status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+        }
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+#endif
+    }
+}
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
+
+#if defined(UX_HOST_STANDALONE)
+static UINT  tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p)
+{
+    if (e == UX_STANDALONE_WAIT_BACKGROUND_TASK)
+    {
+        tx_thread_relinquish();
+    }
+}
+#endif
@@ -0,0 +1,544 @@
+/* This test is designed to test the ASIX host transmission of chained packets.
+
+   A chain whose packets end on USB packet boundaries is sent through the segments of the
+   bulk OUT transfer request, the others are copied to the transmit buffer. The first packet
+   is armed by the write, the second by the transmission callback.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_device_class_dummy.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_asix.h"
+
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+#include "ux_test_utility_sim.h"
+
+/* Define constants.  */
+#define                             UX_DEMO_STACK_SIZE  1024
+#define                             UX_DEMO_MEMORY_SIZE     (64*1024)
+#define                             UX_DEMO_FRAME_SIZE      512
+
+#define                             UX_TEST_PACKET_PAYLOAD  256
+#define                             UX_TEST_PACKET_COUNT    8
+#define                             UX_TEST_PACKET_POOL_SIZE ((sizeof(NX_PACKET) + UX_TEST_PACKET_PAYLOAD) * UX_TEST_PACKET_COUNT)
+
+/* Define local/extern function prototypes.  */
+static TX_THREAD                           tx_test_thread_host_simulation;
+static TX_THREAD                           tx_test_thread_slave_simulation;
+static VOID                                tx_test_thread_host_simulation_entry(ULONG);
+static VOID                                tx_test_thread_slave_simulation_entry(ULONG);
+
+/* Define global data structures.  */
+static UCHAR                        usbx_memory[UX_DEMO_MEMORY_SIZE + (UX_DEMO_STACK_SIZE * 4)];
+
+static UX_DEVICE                    *device = UX_NULL;
+
+static UX_HOST_CLASS_ASIX           *host_asix = UX_NULL;
+
+static ULONG                        host_device_insertion_counter = 0;
+static ULONG                        host_device_removal_counter = 0;
+
+static ULONG                        error_callback_counter = 0;
+
+static UX_DEVICE_CLASS_DUMMY                *device_dummy = UX_NULL;
+static UX_DEVICE_CLASS_DUMMY_PARAMETER      device_dummy_parameter;
+
+static NX_PACKET_POOL               packet_pool;
+static ULONG                        packet_pool_memory[UX_TEST_PACKET_POOL_SIZE / sizeof(ULONG)];
+
+static UCHAR                        device_bulk_out_address;
+static volatile ULONG               device_read_request;
+static volatile ULONG               device_read_done;
+static UINT                         device_read_status;
+static ULONG                        device_frame_length;
+static UCHAR                        device_frame[UX_DEMO_FRAME_SIZE];
+
+
+/* Define device framework.  */
+
+#define _W0(w)      ( (w)       & 0xFF)
+#define _W1(w)      (((w) >> 8) & 0xFF)
+
+#define _CONFIGURATION_DESCRIPTOR(total_len, n_ifc, cfg_val)                    \
+    0x09, 0x02, _W0(total_len), _W1(total_len), (n_ifc), (cfg_val),             \
+    0x00, 0xc0, 0x32,
+
+#define _INTERFACE_DESCRIPTOR(ifc_n, alt, n_ep, cls, sub, protocol)             \
+    0x09, 0x04, (ifc_n), (alt), (n_ep), (cls), (sub), (protocol), 0x00,
+
+#define _ENDPOINT_DESCRIPTOR(addr, attr, pktsize, interval)                     \
+    0x07, 0x05, (addr), (attr), _W0(pktsize), _W1(pktsize), (interval),
+
+#define _CFG_TOTAL_LEN (9+9+7+7+7+7)
+
+#define             STRING_FRAMEWORK_LENGTH                 47
+#define             LANGUAGE_ID_FRAMEWORK_LENGTH            2
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes
+       0xEF bDeviceClass:    Composite class code
+       0x02 bDeviceSubclass: class sub code
+       0x00 bDeviceProtocol: Device protocol
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    0x12, 0x01, 0x10, 0x02,
+    0x00, 0x00, 0x00,
+    0x40,
+    0x95, 0x0B,
+    0x2B, 0x77,
+    0x00, 0x02,
+    0x01, 0x02, 0x03,
+    0x01,
+
+    _CONFIGURATION_DESCRIPTOR(_CFG_TOTAL_LEN, 1, 1)
+    _INTERFACE_DESCRIPTOR(0, 0, 4, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x81, 0x03, 16, 0x0B)
+    _ENDPOINT_DESCRIPTOR(0x82, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x03, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x05, 0x02, 64, 0x00)
+};
+
+#define             DEVICE_FRAMEWORK_LENGTH_FULL_SPEED      sizeof(device_framework_full_speed)
+#define             DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED      sizeof(device_framework_full_speed)
+#define             device_framework_high_speed             device_framework_full_speed
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "AzureRTOS" */
+    0x09, 0x04, 0x01, 9,
+        'A','z','u','r','e','R','T','O','S',
+
+    /* Product string descriptor : Index 2 - "Test device" */
+    0x09, 0x04, 0x02, 14,
+        'T','e','s','t',' ',' ',' ',' ','d','e','v','i','c','e',
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+    0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+};
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+};
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static UINT test_slave_change_function(ULONG change)
+{
+    return 0;
+}
+
+static UINT test_host_change_function(ULONG event, UX_HOST_CLASS *cls, VOID *inst)
+{
+
+UX_HOST_CLASS_ASIX *asix_inst = (UX_HOST_CLASS_ASIX *) inst;
+
+    switch(event)
+    {
+
+    case UX_DEVICE_INSERTION:
+        host_device_insertion_counter ++;
+        host_asix = asix_inst;
+        break;
+
+    case UX_DEVICE_REMOVAL:
+        host_device_removal_counter ++;
+        if (host_asix == asix_inst)
+            host_asix = UX_NULL;
+        break;
+
+    case UX_DEVICE_CONNECTION:
+        device = (UX_DEVICE *)inst;
+        break;
+
+    case UX_DEVICE_DISCONNECTION:
+        if ((VOID *)device == inst)
+            device = UX_NULL;
+        break;
+
+    default:
+        break;
+    }
+    return 0;
+}
+
+static VOID    test_dummy_instance_activate(VOID *dummy_instance)
+{
+    if (device_dummy == UX_NULL)
+        device_dummy = (UX_DEVICE_CLASS_DUMMY *)dummy_instance;
+}
+static VOID    test_dummy_instance_deactivate(VOID *dummy_instance)
+{
+    if ((VOID*)device_dummy == dummy_instance)
+        device_dummy = UX_NULL;
+}
+static VOID    test_dummy_control_request(UX_DEVICE_CLASS_DUMMY *dummy_instance, UX_SLAVE_TRANSFER *transfer_request)
+{
+ULONG cmd_type = transfer_request -> ux_slave_transfer_request_setup[0] |
+            (transfer_request -> ux_slave_transfer_request_setup[1] << 8);
+UCHAR *cmd_buf = transfer_request -> ux_slave_transfer_request_data_pointer;
+
+    if (device_dummy == dummy_instance)
+    {
+
+        switch(cmd_type)
+        {
+        case 0x19c0: /* READ_PHY_ID: return 2 bytes  */
+        case 0x07c0: /* READ_PHY_REG: return 2 bytes  */
+            cmd_buf[0] = 0x01;
+            cmd_buf[1] = 0x00;
+            ux_device_stack_transfer_request(transfer_request, 2, 2);
+            break;
+
+        case 0x13c0: /* READ_NODE_ID: return 6 bytes  */
+            cmd_buf[0] = 0x01;
+            cmd_buf[1] = 0x02;
+            cmd_buf[2] = 0x03;
+            cmd_buf[3] = 0x04;
+            cmd_buf[4] = 0x05;
+            cmd_buf[5] = 0x06;
+            ux_device_stack_transfer_request(transfer_request, 6, 6);
+            break;
+
+        default:
+            /* Write requests have no data.  */
+            break;
+        }
+    }
+}
+
+static VOID test_ux_error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    error_callback_counter ++;
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_host_class_asix_xmit_segments_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                    status;
+CHAR *                  stack_pointer;
+CHAR *                  memory_pointer;
+
+
+    printf("Running Host ASIX chained packets transmit Test..................... ");
+
+#if !defined(UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT) || defined(UX_HOST_STANDALONE)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Reset error generations */
+    ux_test_utility_sim_sem_error_generation_stop();
+    ux_test_utility_sim_mutex_error_generation_stop();
+    ux_test_utility_sim_sem_get_error_generation_stop();
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 4);
+
+    /* Initialize USBX Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_system_initialize failed 0x%x\n", status);
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(test_ux_error_callback);
+
+    /* Create the packets pool to send from.  */
+    nx_system_initialize();
+    status = nx_packet_pool_create(&packet_pool, "ASIX xmit pool", UX_TEST_PACKET_PAYLOAD,
+                                   packet_pool_memory, sizeof(packet_pool_memory));
+    UX_TEST_ASSERT_MESSAGE(status == NX_SUCCESS, "nx_packet_pool_create failed 0x%x\n", status);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(test_host_change_function);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_initialize failed 0x%x\n", status);
+
+    /* Register ASIX class.  */
+    status =  ux_host_stack_class_register(_ux_system_host_class_asix_name, _ux_host_class_asix_entry);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_class_register failed 0x%x\n", status);
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,
+                                       test_slave_change_function);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_device_stack_initialize failed 0x%x\n", status);
+
+    /* Set the parameters for callback when insertion/extraction of a dummy device.  */
+    _ux_utility_memory_set(&device_dummy_parameter, 0, sizeof(device_dummy_parameter));
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_instance_activate   = test_dummy_instance_activate;
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_instance_deactivate = test_dummy_instance_deactivate;
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_control_request =     test_dummy_control_request;
+    /* Initialize the device dummy class, it answers the ASIX vendor requests.  */
+    status  = ux_device_stack_class_register(_ux_device_class_dummy_name,
+                                             _ux_device_class_dummy_entry,
+                                             1, 0, &device_dummy_parameter);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_device_stack_class_register failed 0x%x\n", status);
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_test_dcd_sim_slave_initialize();
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "_ux_test_dcd_sim_slave_initialize failed 0x%x\n", status);
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_test_hcd_sim_host_initialize,0,0);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_hcd_register failed 0x%x\n", status);
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_test_thread_host_simulation, "tx test host simulation", tx_test_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_ASSERT_MESSAGE(status == TX_SUCCESS, "tx_thread_create failed 0x%x\n", status);
+
+    /* Create the main slave simulation  thread.  */
+    stack_pointer += UX_DEMO_STACK_SIZE;
+    status =  tx_thread_create(&tx_test_thread_slave_simulation, "tx test slave simulation", tx_test_thread_slave_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_ASSERT_MESSAGE(status == TX_SUCCESS, "tx_thread_create failed 0x%x\n", status);
+
+}
+
+static UINT _test_check_host_connection_success(VOID)
+{
+    if (device_dummy && host_asix)
+        return(UX_SUCCESS);
+    return(UX_ERROR);
+}
+
+#if defined(UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT) && !defined(UX_HOST_STANDALONE)
+static UINT _test_check_device_read_done(VOID)
+{
+    if (device_read_done == device_read_request)
+        return(UX_SUCCESS);
+    return(UX_ERROR);
+}
+
+static ULONG packet_pool_available_initial;
+static UINT _test_check_packets_released(VOID)
+{
+    if (packet_pool.nx_packet_pool_available == packet_pool_available_initial)
+        return(UX_SUCCESS);
+    return(UX_ERROR);
+}
+
+/* Build a chain of two packets filled with a pattern starting from seed.  */
+static NX_PACKET *test_chain_build(ULONG first_length, ULONG second_length, UCHAR seed)
+{
+
+UINT        status;
+NX_PACKET   *first;
+NX_PACKET   *second;
+ULONG       i;
+
+
+    /* The first packet keeps room for the ASIX header.  */
+    status = nx_packet_allocate(&packet_pool, &first, NX_PHYSICAL_HEADER, NX_NO_WAIT);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+    status = nx_packet_allocate(&packet_pool, &second, 0, NX_NO_WAIT);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+
+    for (i = 0; i < first_length; i ++)
+        first -> nx_packet_prepend_ptr[i] = (UCHAR)(seed + i);
+    first -> nx_packet_append_ptr = first -> nx_packet_prepend_ptr + first_length;
+    for (i = 0; i < second_length; i ++)
+        second -> nx_packet_prepend_ptr[i] = (UCHAR)(seed + first_length + i);
+    second -> nx_packet_append_ptr = second -> nx_packet_prepend_ptr + second_length;
+
+    first -> nx_packet_next = second;
+    first -> nx_packet_last = second;
+    first -> nx_packet_length = first_length + second_length;
+    return(first);
+}
+
+/* Check the bulk OUT transfer request sends the chain, through its segments or copied.  */
+static VOID test_chain_armed_check(NX_PACKET *packet, UINT segments)
+{
+
+UX_TRANSFER     *transfer_request;
+ULONG           length;
+
+
+    transfer_request = &host_asix -> ux_host_class_asix_bulk_out_endpoint -> ux_endpoint_transfer_request;
+    length = packet -> nx_packet_length + sizeof(USHORT) * 2;
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_user_specific == packet);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_requested_length == length);
+
+    if (segments)
+    {
+
+        /* The first segment is the header and the first packet, the second one the next packet.  */
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segment_count == 2);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segments == host_asix -> ux_host_class_asix_xmit_segments);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segments[0].ux_transfer_segment_data_pointer ==
+                       packet -> nx_packet_prepend_ptr - sizeof(USHORT) * 2);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segments[0].ux_transfer_segment_length ==
+                       (ULONG)(packet -> nx_packet_append_ptr - packet -> nx_packet_prepend_ptr) + sizeof(USHORT) * 2);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segments[1].ux_transfer_segment_data_pointer ==
+                       packet -> nx_packet_next -> nx_packet_prepend_ptr);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segments[1].ux_transfer_segment_length ==
+                       (ULONG)(packet -> nx_packet_next -> nx_packet_append_ptr - packet -> nx_packet_next -> nx_packet_prepend_ptr));
+    }
+    else
+    {
+
+        /* The chain is copied to the transmit buffer.  */
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_segment_count == 0);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer == host_asix -> ux_host_class_asix_xmit_buffer);
+    }
+}
+
+/* Let the device read one frame and check it carries the chain.  */
+static VOID test_frame_receive_check(ULONG length, UCHAR seed)
+{
+
+UINT        status;
+ULONG       i;
+
+
+    device_read_request ++;
+    status = ux_test_sleep_break_on_success(1000, _test_check_device_read_done);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(device_read_status == UX_SUCCESS);
+
+    UX_TEST_ASSERT(device_frame_length == length + sizeof(USHORT) * 2);
+    UX_TEST_ASSERT(_ux_utility_short_get(device_frame) == (USHORT)length);
+    UX_TEST_ASSERT(_ux_utility_short_get(device_frame + sizeof(USHORT)) == (USHORT)~length);
+    for (i = 0; i < length; i ++)
+        UX_TEST_ASSERT(device_frame[sizeof(USHORT) * 2 + i] == (UCHAR)(seed + i));
+}
+
+/* Send two chains, the first armed by the write and the second by the transmission callback.  */
+static VOID test_chains_send(ULONG first_length, ULONG second_length, UINT segments)
+{
+
+UINT        status;
+NX_PACKET   *packet_0;
+NX_PACKET   *packet_1;
+ULONG       length;
+
+
+    /* Frames of whole USB packets would be followed by a ZLP.  */
+    length = first_length + second_length;
+    UX_TEST_ASSERT(((length + sizeof(USHORT) * 2) % 64) != 0);
+
+    packet_pool_available_initial = packet_pool.nx_packet_pool_available;
+    packet_0 = test_chain_build(first_length, second_length, 0x10);
+    packet_1 = test_chain_build(first_length, second_length, 0x80);
+
+    /* The first chain is armed, the second one is queued.  */
+    status = _ux_host_class_asix_write(host_asix, packet_0);
+    UX_TEST_CHECK_SUCCESS(status);
+    test_chain_armed_check(packet_0, segments);
+    status = _ux_host_class_asix_write(host_asix, packet_1);
+    UX_TEST_CHECK_SUCCESS(status);
+    UX_TEST_ASSERT(host_asix -> ux_host_class_asix_xmit_queue == packet_0);
+    UX_TEST_ASSERT(packet_0 -> nx_packet_queue_next == packet_1);
+
+    /* The first frame is received, the callback arms the second chain.  */
+    test_frame_receive_check(length, 0x10);
+    UX_TEST_ASSERT(host_asix -> ux_host_class_asix_xmit_queue == packet_1);
+    test_chain_armed_check(packet_1, segments);
+
+    /* The second frame is received, the chains are released.  */
+    test_frame_receive_check(length, 0x80);
+    status = ux_test_sleep_break_on_success(1000, _test_check_packets_released);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(host_asix -> ux_host_class_asix_xmit_queue == UX_NULL);
+}
+#endif
+
+void  tx_test_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                                                status;
+
+
+    stepinfo("\n");
+    stepinfo(">>>>>>>>>>>>>>>> Test connect\n");
+    ux_test_dcd_sim_slave_connect(UX_FULL_SPEED_DEVICE);
+    ux_test_hcd_sim_host_connect(UX_FULL_SPEED_DEVICE);
+    status = ux_test_sleep_break_on_success(10000, _test_check_host_connection_success);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(host_device_insertion_counter == 1);
+
+#if defined(UX_HOST_CLASS_ASIX_XMIT_SEGMENTS_SUPPORT) && !defined(UX_HOST_STANDALONE)
+
+    /* The device reads from the endpoint the host sends to.  */
+    device_bulk_out_address = host_asix -> ux_host_class_asix_bulk_out_endpoint -> ux_endpoint_descriptor.bEndpointAddress;
+    UX_TEST_ASSERT(host_asix -> ux_host_class_asix_bulk_out_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_packet_length == 64);
+
+    /* The interrupt endpoint is not answered, set the link up.  */
+    host_asix -> ux_host_class_asix_link_state = UX_HOST_CLASS_ASIX_LINK_STATE_UP;
+
+    stepinfo(">>>>>>>>>>>>>>>> Test chains sent through segments\n");
+
+    /* Header and first packet are 2 USB packets.  */
+    test_chains_send(124, 100, UX_TRUE);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test chains copied\n");
+
+    /* Header and first packet end inside a USB packet.  */
+    test_chains_send(100, 100, UX_FALSE);
+#endif
+
+    /* Finally disconnect the device. */
+    ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    status  = ux_device_stack_class_unregister(_ux_device_class_dummy_name, _ux_device_class_dummy_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+
+}
+
+void  tx_test_thread_slave_simulation_entry(ULONG arg)
+{
+
+    while(1)
+    {
+
+        /* Read a frame when the host thread asks for it.  */
+        if (device_read_done != device_read_request)
+        {
+            device_read_status = _ux_device_class_dummy_transfer(device_dummy, device_bulk_out_address,
+                                            device_frame, sizeof(device_frame), &device_frame_length);
+            device_read_done ++;
+            continue;
+        }
+
+        tx_thread_sleep(1);
+    }
+}
@@ -0,0 +1,813 @@
+/* This test is designed to test the endpoint statistics: transfers counted on host and device
+   endpoints, latency histogram, errors and aborts, walkers and cost of a transfer.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_BUFFER_SIZE     2048
+#define UX_DEMO_RUN             1
+#define UX_DEMO_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the demo application...  */
+
+static ULONG                           thread_0_counter;
+static ULONG                           thread_1_counter;
+static ULONG                           error_counter;
+
+
+/* Define USBX demo global variables.  */
+
+static UCHAR                           *host_out_buffer;
+static UCHAR                           *host_in_buffer;
+static unsigned char                   slave_buffer[UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+
+static UX_HOST_CLASS                   *class_driver;
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static UINT                             expected_error;
+
+#ifdef UX_ENABLE_ENDPOINT_STATISTICS
+#define UX_TEST_TRANSFERS                       1000000
+
+/* Endpoints found by the walkers.  */
+static ULONG                           walk_count;
+static ULONG                           walk_stop;
+static ULONG                           walk_errors;
+static UX_ENDPOINT                     *walk_host_endpoints[8];
+static UX_SLAVE_ENDPOINT               *walk_device_endpoints[8];
+#endif
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+#endif
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+#endif
+    };
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides English, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+
+#if defined(UX_HOST_STANDALONE)
+static UINT                tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p);
+#else
+#define                     tx_demo_host_change_function UX_NULL
+#endif
+
+UINT                       _ux_host_class_dpump_entry(UX_HOST_CLASS_COMMAND *command);
+UINT                       ux_hcd_sim_initialize(UX_HCD *hcd);
+UINT                       _ux_host_class_dpump_write(UX_HOST_CLASS_DPUMP *dpump, UCHAR * data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+UINT                       _ux_host_class_dpump_read (UX_HOST_CLASS_DPUMP *dpump, UCHAR *data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+
+
+/* Define the ISR dispatch.  */
+
+extern VOID    (*test_isr_dispatch)(void);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define the ISR dispatch routine.  */
+
+static void    test_isr(void)
+{
+
+    /* For further expansion of interrupt-level testing.  */
+}
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    if (expected_error == 0 || error_code != expected_error)
+    {
+        /* Failed test.  */
+        printf("Error on line %d, system_level: %d, system_context: %d, error code: %x\n", __LINE__, system_level, system_context, error_code);
+        // test_control_return(1);
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_endpoint_statistics_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running Endpoint Statistics Test.................................... ");
+
+#ifndef UX_ENABLE_ENDPOINT_STATISTICS
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(tx_demo_host_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the host class drivers for this USBX implementation.  */
+    status =  ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+     status =  ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                               1, 0, &parameter);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main demo thread.  */
+    status =  tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+#ifdef UX_ENABLE_ENDPOINT_STATISTICS
+
+/* Record the host endpoints walked, stop at a count if set.  */
+static UINT ux_test_host_walk(UX_DEVICE *device, UX_ENDPOINT *endpoint, VOID *parameter)
+{
+UX_ENDPOINT_STATISTICS  statistics;
+
+    if (parameter != (VOID *)&walk_count || endpoint -> ux_endpoint_device != device)
+        walk_errors ++;
+    if (walk_count < 8)
+        walk_host_endpoints[walk_count] = endpoint;
+    walk_count ++;
+
+    /* Transfers are all successful.  */
+    if (ux_host_stack_endpoint_statistics_get(endpoint, &statistics) != UX_SUCCESS ||
+        statistics.ux_endpoint_statistics_errors != 0)
+        walk_errors ++;
+    if (walk_count == walk_stop)
+        return(UX_ERROR);
+    return(UX_SUCCESS);
+}
+
+/* Record the device endpoints walked.  */
+static UINT ux_test_device_walk(UX_SLAVE_ENDPOINT *endpoint, VOID *parameter)
+{
+
+    if (parameter != (VOID *)&walk_count)
+        walk_errors ++;
+    if (walk_count < 8)
+        walk_device_endpoints[walk_count] = endpoint;
+    walk_count ++;
+    return(UX_SUCCESS);
+}
+
+/* Clear the statistics of the endpoints walked.  */
+static UINT ux_test_host_reset(UX_DEVICE *device, UX_ENDPOINT *endpoint, VOID *parameter)
+{
+    return(ux_host_stack_endpoint_statistics_reset(endpoint));
+}
+
+static UINT ux_test_device_reset(UX_SLAVE_ENDPOINT *endpoint, VOID *parameter)
+{
+    return(ux_device_stack_endpoint_statistics_reset(endpoint));
+}
+
+/* Sum the latency histogram.  */
+static ULONG ux_test_latency_sum(UX_ENDPOINT_STATISTICS *statistics)
+{
+ULONG       i;
+ULONG       sum = 0;
+
+    for (i = 0; i < UX_ENDPOINT_STATISTICS_LATENCY_BINS; i ++)
+        sum += statistics -> ux_endpoint_statistics_latency[i];
+    return(sum);
+}
+#endif
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                            status;
+UX_HOST_CLASS                   *class;
+#ifdef UX_ENABLE_ENDPOINT_STATISTICS
+ULONG                           actual_length;
+UINT                            i;
+UX_ENDPOINT                     *endpoint_out;
+UX_ENDPOINT                     *endpoint_in;
+UX_SLAVE_ENDPOINT               *slave_endpoint_out;
+UX_ENDPOINT_STATISTICS          statistics;
+UX_TRANSFER                     *transfer_request;
+UX_ENDPOINT                     endpoint;
+UX_TRANSFER                     transfer;
+clock_t                         start;
+double                          elapsed;
+#endif
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE)
+    {
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    }
+
+#ifdef UX_ENABLE_ENDPOINT_STATISTICS
+
+    /* Check parameters.  */
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_get(UX_NULL, &statistics) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_reset(UX_NULL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_walk(UX_NULL, UX_NULL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_get(UX_NULL, &statistics) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_reset(UX_NULL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_walk(UX_NULL, UX_NULL) == UX_INVALID_PARAMETER);
+
+    /* The host walker visits the control endpoint, then the interface endpoints.  */
+    endpoint_out = dpump -> ux_host_class_dpump_bulk_out_endpoint;
+    endpoint_in = dpump -> ux_host_class_dpump_bulk_in_endpoint;
+    walk_count = 0;
+    walk_stop = 0;
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_walk(ux_test_host_walk, &walk_count) == UX_SUCCESS);
+    UX_TEST_ASSERT(walk_errors == 0);
+    UX_TEST_ASSERT(walk_count == 3);
+    UX_TEST_ASSERT(walk_host_endpoints[0] == &dpump -> ux_host_class_dpump_device -> ux_device_control_endpoint);
+    UX_TEST_ASSERT(walk_host_endpoints[1] == endpoint_out || walk_host_endpoints[2] == endpoint_out);
+    UX_TEST_ASSERT(walk_host_endpoints[1] == endpoint_in || walk_host_endpoints[2] == endpoint_in);
+
+    /* Enumeration requests are counted on the control endpoint.  */
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_get(walk_host_endpoints[0], &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests >= 4);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed == statistics.ux_endpoint_statistics_requests);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_bytes > 0);
+    UX_TEST_ASSERT(ux_test_latency_sum(&statistics) == statistics.ux_endpoint_statistics_completed);
+
+    /* The walk stops on the status returned.  */
+    walk_count = 0;
+    walk_stop = 2;
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_walk(ux_test_host_walk, &walk_count) == UX_ERROR);
+    UX_TEST_ASSERT(walk_count == 2);
+
+    /* The device walker visits the control endpoint, then the interface endpoints.  */
+    walk_count = 0;
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_walk(ux_test_device_walk, &walk_count) == UX_SUCCESS);
+    UX_TEST_ASSERT(walk_errors == 0);
+    UX_TEST_ASSERT(walk_count == 3);
+    UX_TEST_ASSERT(walk_device_endpoints[0] == &_ux_system_slave -> ux_system_slave_device.ux_slave_device_control_endpoint);
+    slave_endpoint_out = dpump_slave -> ux_slave_class_dpump_bulkout_endpoint;
+    UX_TEST_ASSERT(walk_device_endpoints[1] == slave_endpoint_out || walk_device_endpoints[2] == slave_endpoint_out);
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_get(walk_device_endpoints[0], &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed > 0);
+
+    /* Clear all the statistics.  */
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_walk(ux_test_host_reset, UX_NULL) == UX_SUCCESS);
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_walk(ux_test_device_reset, UX_NULL) == UX_SUCCESS);
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_get(endpoint_out, &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests == 0);
+    UX_TEST_ASSERT(ux_test_latency_sum(&statistics) == 0);
+
+    /* Allocate the host buffers.  */
+    host_out_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    host_in_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    UX_TEST_ASSERT(host_out_buffer != UX_NULL);
+    UX_TEST_ASSERT(host_in_buffer != UX_NULL);
+
+    /* Perform this test sequence 10 times.  */
+    for (i = 0; i < 10; i++)
+    {
+
+        /* Increment thread counter.  */
+        thread_0_counter++;
+
+        /* Write to the host Data Pump Bulk out endpoint.  */
+        _ux_utility_memory_set(host_out_buffer, (UCHAR)('A' + i), UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        status =  _ux_host_class_dpump_write (dpump, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+
+#if defined(UX_HOST_STANDALONE)
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+#endif
+
+        /* Read from the Data Pump Bulk in endpoint.  */
+        status =  _ux_host_class_dpump_read (dpump, host_in_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+        UX_TEST_ASSERT(_ux_utility_memory_compare(host_in_buffer, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE) == UX_SUCCESS);
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+    }
+
+    /* Transfers and bytes are counted on both bulk endpoints.  */
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_get(endpoint_out, &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests == 10);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed == 10);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_bytes == 10 * UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_errors == 0);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_aborts == 0);
+    UX_TEST_ASSERT(ux_test_latency_sum(&statistics) == 10);
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_get(endpoint_in, &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests == 10);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed == 10);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_bytes == 10 * UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    UX_TEST_ASSERT(ux_test_latency_sum(&statistics) == 10);
+
+    /* The device has received the data. A read was pending when the statistics were
+       cleared, the next read may be pending.  */
+    UX_TEST_ASSERT(ux_device_stack_endpoint_statistics_get(slave_endpoint_out, &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed == 10);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_bytes == 10 * UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests >= 9);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests <= 10);
+
+    /* Latencies are counted in bins of their bit length, errors by code.  */
+    _ux_utility_memory_set(&statistics, 0, sizeof(statistics));
+    _ux_utility_endpoint_statistics_update(&statistics, UX_SUCCESS, 8, UX_ENDPOINT_STATISTICS_TIMESTAMP_GET() - 1000);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_latency[10] + statistics.ux_endpoint_statistics_latency[11] == 1);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_latency_max >= 1000);
+    _ux_utility_endpoint_statistics_update(&statistics, UX_SUCCESS, 8, UX_ENDPOINT_STATISTICS_TIMESTAMP_GET() - 0x40000000);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_latency[UX_ENDPOINT_STATISTICS_LATENCY_BINS - 1] == 1);
+    _ux_utility_endpoint_statistics_update(&statistics, UX_TRANSFER_STALLED, 0, UX_ENDPOINT_STATISTICS_TIMESTAMP_GET());
+    _ux_utility_endpoint_statistics_update(&statistics, UX_TRANSFER_ERROR, 0, UX_ENDPOINT_STATISTICS_TIMESTAMP_GET());
+    _ux_utility_endpoint_statistics_update(&statistics, UX_TRANSFER_TIMEOUT, 0, UX_ENDPOINT_STATISTICS_TIMESTAMP_GET());
+    _ux_utility_endpoint_statistics_update(&statistics, UX_TRANSFER_STATUS_ABORT, 4, UX_ENDPOINT_STATISTICS_TIMESTAMP_GET());
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed == 6);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_bytes == 20);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_errors == 3);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_aborts == 1);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_error_codes[UX_TRANSFER_STALLED - 0x20] == 1);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_error_codes[UX_TRANSFER_ERROR - 0x20] == 1);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_error_codes[0] == 1);
+    UX_TEST_ASSERT(ux_test_latency_sum(&statistics) == 6);
+
+#if !defined(UX_HOST_STANDALONE)
+
+    /* A pending transfer aborted is counted, the device is not sending.  */
+    transfer_request = &endpoint_in -> ux_endpoint_transfer_request;
+    transfer_request -> ux_transfer_request_data_pointer = host_in_buffer;
+    transfer_request -> ux_transfer_request_requested_length = UX_HOST_CLASS_DPUMP_PACKET_SIZE;
+    UX_TEST_ASSERT(ux_host_stack_transfer_request(transfer_request) == UX_SUCCESS);
+    UX_TEST_ASSERT(ux_host_stack_transfer_request_abort(transfer_request) == UX_SUCCESS);
+    UX_TRANSFER_STATISTICS_TIMEOUT(transfer_request);
+    UX_TEST_ASSERT(ux_host_stack_endpoint_statistics_get(endpoint_in, &statistics) == UX_SUCCESS);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_requests == 11);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_completed == 11);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_aborts == 1);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_timeouts == 1);
+    UX_TEST_ASSERT(statistics.ux_endpoint_statistics_errors == 0);
+#endif
+
+    /* Print cost of a transfer, not checked since it depends on host load.  */
+    _ux_utility_memory_set(&endpoint, 0, sizeof(endpoint));
+    _ux_utility_memory_set(&transfer, 0, sizeof(transfer));
+    transfer.ux_transfer_request_endpoint = &endpoint;
+    transfer.ux_transfer_request_actual_length = 64;
+    start = clock();
+    for (i = 0; i < UX_TEST_TRANSFERS; i ++)
+    {
+        UX_TRANSFER_STATISTICS_SUBMIT(&transfer);
+        UX_TRANSFER_STATISTICS_COMPLETE(&transfer);
+    }
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    UX_TEST_ASSERT(endpoint.ux_endpoint_statistics.ux_endpoint_statistics_completed == UX_TEST_TRANSFERS);
+    printf("%.1fns/transfer ", elapsed * 1e9 / UX_TEST_TRANSFERS);
+
+    _ux_utility_memory_free(host_in_buffer);
+    _ux_utility_memory_free(host_out_buffer);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+#if defined(UX_DEVICE_STANDALONE)
+#define DPUMP_DEVICE_STATE_READ     UX_STATE_STEP
+#define DPUMP_DEVICE_STATE_WRITE    UX_STATE_STEP + 1
+UINT    dpump_device_state = UX_STATE_RESET;
+#endif
+
+
+    while(1)
+    {
+#if defined(UX_DEVICE_STANDALONE)
+
+        /* Run device tasks.  */
+        ux_system_tasks_run();
+
+        /* DPUMP echo state machine.  */
+        switch(dpump_device_state)
+        {
+        case UX_STATE_RESET:
+            if (dpump_slave != UX_NULL)
+
+                /* Start reading.  */
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+
+        case DPUMP_DEVICE_STATE_READ:
+
+            /* Read from the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_read_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: read status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+            {
+                if (actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+                {
+                    printf("ERROR #%d: read length %ld\n", __LINE__, actual_length);
+                    error_counter ++;
+                    return;
+                }
+
+                dpump_device_state = DPUMP_DEVICE_STATE_WRITE;
+            }
+            break;
+
+        case DPUMP_DEVICE_STATE_WRITE:
+
+            /* Now write to the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_write_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: write status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+        
+        default:
+            dpump_device_state = UX_STATE_RESET;
+        }
+
+        /* Increment thread counter.  */
+        thread_1_counter++;
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+
+#else
+        /* Ensure the dpump class on the device is still alive.  */
+        while (dpump_slave != UX_NULL)
+        {
+
+            /* Increment thread counter.  */
+            thread_1_counter++;
+
+            /* Read from the device data pump.  */
+            status =  _ux_device_class_dpump_read(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: read status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+
+            /* Now write to the device data pump.  */
+            status =  _ux_device_class_dpump_write(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: write status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+        }
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+#endif
+    }
+}
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
+
+#if defined(UX_HOST_STANDALONE)
+static UINT  tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p)
+{
+    if (e == UX_STANDALONE_WAIT_BACKGROUND_TASK)
+    {
+        tx_thread_relinquish();
+    }
+}
+#endif
@@ -0,0 +1,741 @@
+/* This test is designed to test the bandwidth map: periodic endpoints placed in the
+   micro-frames of the periodic schedule, TT budgets of full speed endpoints behind a
+   high speed hub and the ED lists of the simulator the endpoints are linked to.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_sim_host.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_BUFFER_SIZE     2048
+#define UX_DEMO_RUN             1
+#define UX_DEMO_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the demo application...  */
+
+static ULONG                           thread_0_counter;
+static ULONG                           thread_1_counter;
+static ULONG                           error_counter;
+
+
+/* Define USBX demo global variables.  */
+
+static unsigned char                   slave_buffer[UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+
+static UX_HOST_CLASS                   *class_driver;
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static UINT                             expected_error;
+
+#ifdef UX_ENABLE_BANDWIDTH_MAP
+
+/* Bandwidth of the endpoints tested on a 2.0 controller: maximum packet size with bit
+   stuffing and the protocol overhead.  */
+#define UX_TEST_BUS_BUDGET                      6000
+#define UX_TEST_HS_ISO_COUNT                    8
+#define UX_TEST_HS_ISO_COST                     ((1024 * 7 + 5) / 6 + 38)
+#define UX_TEST_HS_ISO_MULT_COST                (UX_TEST_HS_ISO_COST * 3)
+#define UX_TEST_FS_INT_COUNT                    32
+#define UX_TEST_FS_INT_COST                     ((8 * 7 + 5) / 6 + 13)
+#define UX_TEST_FS_INT_FRAME_LOAD               (UX_TEST_FS_INT_COST * UX_TEST_FS_INT_COUNT / 8)
+#define UX_TEST_FS_ISO_COST                     ((512 * 7 + 5) / 6 + 9)
+#define UX_TEST_SIM_INT_COUNT                   4
+
+/* Fake controller and devices: a high speed device on the root port and a full speed
+   device behind a high speed hub.  */
+static UX_HCD                          bandwidth_hcd;
+static UX_DEVICE                       hub_device;
+static UX_DEVICE                       hs_device;
+static UX_DEVICE                       fs_device;
+static UX_ENDPOINT                     hs_iso[UX_TEST_HS_ISO_COUNT];
+static UX_ENDPOINT                     hs_iso_mult[2];
+static UX_ENDPOINT                     fs_int[UX_TEST_FS_INT_COUNT];
+static UX_ENDPOINT                     fs_iso[2];
+static UX_ENDPOINT                     sim_int[UX_TEST_SIM_INT_COUNT];
+static USHORT                          map[UX_BANDWIDTH_MAP_SLOTS];
+static USHORT                          tt_map[UX_BANDWIDTH_MAP_FRAMES];
+#endif
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+#endif
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+#endif
+    };
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides English, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+static UINT                tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p);
+
+UINT                       _ux_host_class_dpump_entry(UX_HOST_CLASS_COMMAND *command);
+UINT                       ux_hcd_sim_initialize(UX_HCD *hcd);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+
+
+/* Define the ISR dispatch.  */
+
+extern VOID    (*test_isr_dispatch)(void);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define the ISR dispatch routine.  */
+
+static void    test_isr(void)
+{
+
+    /* For further expansion of interrupt-level testing.  */
+}
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    if (expected_error == 0 || error_code != expected_error)
+    {
+        /* Failed test.  */
+        printf("Error on line %d, system_level: %d, system_context: %d, error code: %x\n", __LINE__, system_level, system_context, error_code);
+        // test_control_return(1);
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_host_stack_bandwidth_map_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running Host Stack Bandwidth Map Test............................... ");
+
+#ifndef UX_ENABLE_BANDWIDTH_MAP
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(tx_demo_host_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the host class drivers for this USBX implementation.  */
+    status =  ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+     status =  ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                               1, 0, &parameter);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main demo thread.  */
+    status =  tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+
+#ifdef UX_ENABLE_BANDWIDTH_MAP
+static VOID  test_endpoint_set(UX_ENDPOINT *endpoint, UX_DEVICE *device, UCHAR address,
+                               UCHAR type, USHORT max_packet_size, UCHAR interval)
+{
+
+    /* Describe the endpoint, it is not placed in the map yet.  */
+    endpoint -> ux_endpoint_device =  device;
+    endpoint -> ux_endpoint_descriptor.bEndpointAddress =  address;
+    endpoint -> ux_endpoint_descriptor.bmAttributes =  type;
+    endpoint -> ux_endpoint_descriptor.wMaxPacketSize =  max_packet_size;
+    endpoint -> ux_endpoint_descriptor.bInterval =  interval;
+    endpoint -> ux_endpoint_bandwidth_slot =  0;
+}
+#endif
+
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                            status;
+UX_HOST_CLASS                   *class;
+#ifdef UX_ENABLE_BANDWIDTH_MAP
+UX_DEVICE                       *device;
+UX_HCD                          *hcd;
+UX_HCD_SIM_HOST                 *hcd_sim_host;
+UX_HCD_SIM_HOST_ED              *ed;
+ULONG                           i;
+ULONG                           load;
+ULONG                           load_max;
+#endif
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE)
+    {
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    }
+
+#ifdef UX_ENABLE_BANDWIDTH_MAP
+
+    /* Fake a 2.0 controller, the full speed device is on the hub port of the TT.  */
+    bandwidth_hcd.ux_hcd_version = 0x200;
+    bandwidth_hcd.ux_hcd_available_bandwidth = UX_TEST_BUS_BUDGET;
+    hub_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    hub_device.ux_device_hub_tt[0].ux_hub_tt_port_mapping = UX_TT_MASK;
+    hs_device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    fs_device.ux_device_speed = UX_FULL_SPEED_DEVICE;
+    fs_device.ux_device_parent = &hub_device;
+    fs_device.ux_device_port_location = 1;
+
+    /* Check parameters.  */
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(UX_NULL, map) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(&bandwidth_hcd, UX_NULL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(UX_NULL, 0, tt_map) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(&hub_device, UX_MAX_TT, tt_map) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(&hub_device, 0, UX_NULL) == UX_INVALID_PARAMETER);
+
+    /* High speed isochronous endpoints of 1ms are spread over the micro-frames, the
+       controller budget taken as a whole would only fit 4 of them.  */
+    UX_TEST_ASSERT(UX_TEST_HS_ISO_COST * 5 > UX_TEST_BUS_BUDGET);
+    for (i = 0; i < UX_TEST_HS_ISO_COUNT; i ++)
+    {
+        test_endpoint_set(&hs_iso[i], &hs_device, 0x81, UX_ISOCHRONOUS_ENDPOINT, 1024, 4);
+        UX_TEST_ASSERT(_ux_host_stack_bandwidth_check(&bandwidth_hcd, &hs_iso[i]) == UX_SUCCESS);
+        UX_TEST_ASSERT(hs_iso[i].ux_endpoint_bandwidth_slot == i);
+        _ux_host_stack_bandwidth_claim(&bandwidth_hcd, &hs_iso[i]);
+        UX_TEST_ASSERT(hs_iso[i].ux_endpoint_bandwidth_slot == (i | UX_BANDWIDTH_MAP_CLAIMED));
+    }
+
+    /* Full speed interrupt endpoints of 8ms behind the TT are spread over the frames,
+       their data come back in the complete-splits of micro-frames 2 to 4.  */
+    for (i = 0; i < UX_TEST_FS_INT_COUNT; i ++)
+    {
+        test_endpoint_set(&fs_int[i], &fs_device, 0x81, UX_INTERRUPT_ENDPOINT, 8, 8);
+        UX_TEST_ASSERT(_ux_host_stack_bandwidth_check(&bandwidth_hcd, &fs_int[i]) == UX_SUCCESS);
+        UX_TEST_ASSERT(UX_BANDWIDTH_MAP_FRAME(&fs_int[i]) == i % 8);
+        UX_TEST_ASSERT(UX_BANDWIDTH_MAP_MICROFRAME(&fs_int[i]) == 0);
+        _ux_host_stack_bandwidth_claim(&bandwidth_hcd, &fs_int[i]);
+    }
+
+    /* Check the loads of the bus and of the TT.  */
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(&bandwidth_hcd, map) == UX_SUCCESS);
+    load_max = 0;
+    for (i = 0; i < UX_BANDWIDTH_MAP_SLOTS; i ++)
+    {
+        load = UX_TEST_HS_ISO_COST;
+        if ((i % 8) >= 2 && (i % 8) <= 4)
+            load += UX_TEST_FS_INT_FRAME_LOAD;
+        UX_TEST_ASSERT(map[i] == load);
+        if (load > load_max)
+            load_max = load;
+    }
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(&hub_device, 0, tt_map) == UX_SUCCESS);
+    for (i = 0; i < UX_BANDWIDTH_MAP_FRAMES; i ++)
+        UX_TEST_ASSERT(tt_map[i] == UX_TEST_FS_INT_FRAME_LOAD);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(&hub_device, 1, tt_map) == UX_SUCCESS);
+    for (i = 0; i < UX_BANDWIDTH_MAP_FRAMES; i ++)
+        UX_TEST_ASSERT(tt_map[i] == 0);
+
+    /* A high speed isochronous endpoint of 3 transactions each micro-frame fits once
+       in the busiest micro-frame.  */
+    UX_TEST_ASSERT(load_max + UX_TEST_HS_ISO_MULT_COST <= UX_TEST_BUS_BUDGET);
+    UX_TEST_ASSERT(load_max + UX_TEST_HS_ISO_MULT_COST * 2 > UX_TEST_BUS_BUDGET);
+    test_endpoint_set(&hs_iso_mult[0], &hs_device, 0x82, UX_ISOCHRONOUS_ENDPOINT, 0x1400, 1);
+    UX_TEST_ASSERT(_ux_host_stack_bandwidth_check(&bandwidth_hcd, &hs_iso_mult[0]) == UX_SUCCESS);
+    _ux_host_stack_bandwidth_claim(&bandwidth_hcd, &hs_iso_mult[0]);
+    test_endpoint_set(&hs_iso_mult[1], &hs_device, 0x83, UX_ISOCHRONOUS_ENDPOINT, 0x1400, 1);
+    expected_error = UX_NO_BANDWIDTH_AVAILABLE;
+    UX_TEST_ASSERT(_ux_host_stack_bandwidth_check(&bandwidth_hcd, &hs_iso_mult[1]) == UX_NO_BANDWIDTH_AVAILABLE);
+    expected_error = 0;
+
+    /* A full speed isochronous endpoint takes most of the TT frames, a second one does
+       not fit in the TT though the micro-frame it would start in has room.  */
+    test_endpoint_set(&fs_iso[0], &fs_device, 0x02, UX_ISOCHRONOUS_ENDPOINT, 512, 1);
+    UX_TEST_ASSERT(_ux_host_stack_bandwidth_check(&bandwidth_hcd, &fs_iso[0]) == UX_SUCCESS);
+    UX_TEST_ASSERT(fs_iso[0].ux_endpoint_bandwidth_slot == 0);
+    _ux_host_stack_bandwidth_claim(&bandwidth_hcd, &fs_iso[0]);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(&hub_device, 0, tt_map) == UX_SUCCESS);
+    for (i = 0; i < UX_BANDWIDTH_MAP_FRAMES; i ++)
+        UX_TEST_ASSERT(tt_map[i] == UX_TEST_FS_INT_FRAME_LOAD + UX_TEST_FS_ISO_COST);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(&bandwidth_hcd, map) == UX_SUCCESS);
+    i = tt_map[0] / UX_BANDWIDTH_MAP_SPLIT_BYTES;
+    UX_TEST_ASSERT(map[i] + UX_TEST_FS_ISO_COST <= UX_TEST_BUS_BUDGET);
+    UX_TEST_ASSERT((ULONG)(tt_map[0] + UX_TEST_FS_ISO_COST) > UX_MAX_BYTES_PER_FRAME_FS);
+    test_endpoint_set(&fs_iso[1], &fs_device, 0x03, UX_ISOCHRONOUS_ENDPOINT, 512, 1);
+    expected_error = UX_NO_BANDWIDTH_AVAILABLE;
+    UX_TEST_ASSERT(_ux_host_stack_bandwidth_check(&bandwidth_hcd, &fs_iso[1]) == UX_NO_BANDWIDTH_AVAILABLE);
+    expected_error = 0;
+
+    /* Release everything, endpoints not claimed are not released.  */
+    for (i = 0; i < UX_TEST_HS_ISO_COUNT; i ++)
+        _ux_host_stack_bandwidth_release(&bandwidth_hcd, &hs_iso[i]);
+    for (i = 0; i < UX_TEST_FS_INT_COUNT; i ++)
+        _ux_host_stack_bandwidth_release(&bandwidth_hcd, &fs_int[i]);
+    for (i = 0; i < 2; i ++)
+    {
+        _ux_host_stack_bandwidth_release(&bandwidth_hcd, &hs_iso_mult[i]);
+        _ux_host_stack_bandwidth_release(&bandwidth_hcd, &fs_iso[i]);
+    }
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(&bandwidth_hcd, map) == UX_SUCCESS);
+    for (i = 0; i < UX_BANDWIDTH_MAP_SLOTS; i ++)
+        UX_TEST_ASSERT(map[i] == 0);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_tt_map_get(&hub_device, 0, tt_map) == UX_SUCCESS);
+    for (i = 0; i < UX_BANDWIDTH_MAP_FRAMES; i ++)
+        UX_TEST_ASSERT(tt_map[i] == 0);
+
+    /* On the simulator, interrupt endpoints of 32ms are linked to the static ED of the
+       list of the frame they are placed in.  */
+    device = dpump -> ux_host_class_dpump_device;
+    hcd = UX_DEVICE_HCD_GET(device);
+    hcd_sim_host = (UX_HCD_SIM_HOST *)hcd -> ux_hcd_controller_hardware;
+    for (i = 0; i < UX_TEST_SIM_INT_COUNT; i ++)
+    {
+        test_endpoint_set(&sim_int[i], device, (UCHAR)(0x83 + i), UX_INTERRUPT_ENDPOINT, 64, 32);
+        UX_TEST_ASSERT(_ux_host_stack_endpoint_instance_create(&sim_int[i]) == UX_SUCCESS);
+        UX_TEST_ASSERT(sim_int[i].ux_endpoint_bandwidth_slot & UX_BANDWIDTH_MAP_CLAIMED);
+        ed = (UX_HCD_SIM_HOST_ED *)sim_int[i].ux_endpoint_ed;
+        UX_TEST_ASSERT(ed -> ux_sim_host_ed_previous_ed ==
+                       hcd_sim_host -> ux_hcd_sim_host_interrupt_ed_list[UX_BANDWIDTH_MAP_FRAME(&sim_int[i])]);
+    }
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(hcd, map) == UX_SUCCESS);
+    for (i = 0; i < UX_TEST_SIM_INT_COUNT; i ++)
+        UX_TEST_ASSERT(map[sim_int[i].ux_endpoint_bandwidth_slot & UX_BANDWIDTH_MAP_SLOT_MASK] != 0);
+
+    /* Deleting the endpoints frees the map.  */
+    for (i = 0; i < UX_TEST_SIM_INT_COUNT; i ++)
+        _ux_host_stack_endpoint_instance_delete(&sim_int[i]);
+    UX_TEST_ASSERT(ux_host_stack_bandwidth_map_get(hcd, map) == UX_SUCCESS);
+    for (i = 0; i < UX_BANDWIDTH_MAP_SLOTS; i ++)
+        UX_TEST_ASSERT(map[i] == 0);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+#if defined(UX_DEVICE_STANDALONE)
+#define DPUMP_DEVICE_STATE_READ     UX_STATE_STEP
+#define DPUMP_DEVICE_STATE_WRITE    UX_STATE_STEP + 1
+UINT    dpump_device_state = UX_STATE_RESET;
+#endif
+
+
+    while(1)
+    {
+#if defined(UX_DEVICE_STANDALONE)
+
+        /* Run device tasks.  */
+        ux_system_tasks_run();
+
+        /* DPUMP echo state machine.  */
+        switch(dpump_device_state)
+        {
+        case UX_STATE_RESET:
+            if (dpump_slave != UX_NULL)
+
+                /* Start reading.  */
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+
+        case DPUMP_DEVICE_STATE_READ:
+
+            /* Read from the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_read_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: read status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+            {
+                if (actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+                {
+                    printf("ERROR #%d: read length %ld\n", __LINE__, actual_length);
+                    error_counter ++;
+                    return;
+                }
+
+                dpump_device_state = DPUMP_DEVICE_STATE_WRITE;
+            }
+            break;
+
+        case DPUMP_DEVICE_STATE_WRITE:
+
+            /* Now write to the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_write_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: write status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+        
+        default:
+            dpump_device_state = UX_STATE_RESET;
+        }
+
+        /* Increment thread counter.  */
+        thread_1_counter++;
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+
+#else
+        /* Ensure the dpump class on the device is still alive.  */
+        while (dpump_slave != UX_NULL)
+        {
+
+            /* Increment thread counter.  */
+            thread_1_counter++;
+
+            /* Read from the device data pump.  */
+            status =  _ux_device_class_dpump_read(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: read status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+
+            /* Now write to the device data pump.  */
+            status =  _ux_device_class_dpump_write(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: write status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+        }
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+#endif
+    }
+}
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
+
+static UINT  tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p)
+{
+
+#if defined(UX_HOST_STANDALONE)
+    if (e == UX_STANDALONE_WAIT_BACKGROUND_TASK)
+    {
+        tx_thread_relinquish();
+    }
+#endif
+
+    return(UX_SUCCESS);
+}
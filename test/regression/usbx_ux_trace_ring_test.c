@@ -0,0 +1,846 @@
+/* This test is designed to test the trace ring: events recorded during enumeration and data
+   transfers, category filters, ring overwrite, dump format and cost of an event.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_BUFFER_SIZE     2048
+#define UX_DEMO_RUN             1
+#define UX_DEMO_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the demo application...  */
+
+static ULONG                           thread_0_counter;
+static ULONG                           thread_1_counter;
+static ULONG                           error_counter;
+
+
+/* Define USBX demo global variables.  */
+
+static UCHAR                           *host_out_buffer;
+static UCHAR                           *host_in_buffer;
+static unsigned char                   slave_buffer[UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+
+static UX_HOST_CLASS                   *class_driver;
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static UINT                             expected_error;
+
+#ifdef UX_ENABLE_TRACE_RING
+#define UX_TEST_RING_ENTRIES                    512
+#define UX_TEST_DUMP_LENGTH                     (UX_TRACE_RING_DUMP_HEADER_LENGTH + UX_TEST_RING_ENTRIES * UX_TRACE_RING_DUMP_ENTRY_LENGTH)
+#define UX_TEST_INSERTS                         1000000
+
+static UX_TRACE_RING_ENTRY             trace_ring_buffer[UX_TEST_RING_ENTRIES * UX_TRACE_RING_CORE_NUM + 3];
+static UCHAR                           trace_dump[UX_TEST_DUMP_LENGTH];
+
+/* Decoded dump.  */
+typedef struct UX_TEST_EVENT_STRUCT
+{
+    ULONG       sequence;
+    ULONG       timestamp;
+    ULONG       event_id;
+    ULONG       info_1;
+    ULONG       info_2;
+    ULONG       info_3;
+} UX_TEST_EVENT;
+
+static UX_TEST_EVENT                   trace_events[UX_TEST_RING_ENTRIES];
+static ULONG                           trace_events_count;
+static ULONG                           trace_events_lost;
+#endif
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+#endif
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+#endif
+    };
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides English, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+
+#if defined(UX_HOST_STANDALONE)
+static UINT                tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p);
+#else
+#define                     tx_demo_host_change_function UX_NULL
+#endif
+
+UINT                       _ux_host_class_dpump_entry(UX_HOST_CLASS_COMMAND *command);
+UINT                       ux_hcd_sim_initialize(UX_HCD *hcd);
+UINT                       _ux_host_class_dpump_write(UX_HOST_CLASS_DPUMP *dpump, UCHAR * data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+UINT                       _ux_host_class_dpump_read (UX_HOST_CLASS_DPUMP *dpump, UCHAR *data_pointer,
+                                    ULONG requested_length, ULONG *actual_length);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+
+
+/* Define the ISR dispatch.  */
+
+extern VOID    (*test_isr_dispatch)(void);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+/* Define the ISR dispatch routine.  */
+
+static void    test_isr(void)
+{
+
+    /* For further expansion of interrupt-level testing.  */
+}
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    if (expected_error == 0 || error_code != expected_error)
+    {
+        /* Failed test.  */
+        printf("Error on line %d, system_level: %d, system_context: %d, error code: %x\n", __LINE__, system_level, system_context, error_code);
+        // test_control_return(1);
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_trace_ring_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running Trace Ring Test............................................. ");
+
+#ifndef UX_ENABLE_TRACE_RING
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+#ifdef UX_ENABLE_TRACE_RING
+
+    /* Check parameters.  */
+    UX_TEST_ASSERT(ux_trace_ring_filter_set(UX_TRACE_RING_ALL) == UX_FUNCTION_NOT_SUPPORTED);
+    UX_TEST_ASSERT(ux_trace_ring_enable((UCHAR *)trace_ring_buffer + 1, sizeof(trace_ring_buffer) - 1, UX_TRACE_RING_ALL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_trace_ring_enable(trace_ring_buffer, sizeof(UX_TRACE_RING_ENTRY) * UX_TRACE_RING_CORE_NUM, UX_TRACE_RING_ALL) == UX_MEMORY_INSUFFICIENT);
+
+    /* Enable the trace ring before the initialization, all the events are recorded.  */
+    UX_TEST_ASSERT(ux_trace_ring_enable(trace_ring_buffer, sizeof(trace_ring_buffer), UX_TRACE_RING_ALL) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_trace_ring.ux_trace_ring_entries == UX_TEST_RING_ENTRIES);
+#endif
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(tx_demo_host_change_function);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the host class drivers for this USBX implementation.  */
+    status =  ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+     status =  ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                               1, 0, &parameter);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main demo thread.  */
+    status =  tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+#ifdef UX_ENABLE_TRACE_RING
+
+/* Dump the trace ring and decode the entries.  */
+static UINT ux_test_trace_ring_decode(VOID)
+{
+UINT            status;
+ULONG           length;
+ULONG           i;
+UCHAR           *entry;
+
+    status = ux_trace_ring_dump(trace_dump, sizeof(trace_dump), &length);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Check the header.  */
+    if (_ux_utility_long_get(trace_dump) != UX_TRACE_RING_DUMP_MAGIC ||
+        _ux_utility_short_get(trace_dump + 4) != UX_TRACE_RING_DUMP_VERSION ||
+        _ux_utility_short_get(trace_dump + 6) != UX_TRACE_RING_DUMP_HEADER_LENGTH ||
+        _ux_utility_short_get(trace_dump + 8) != UX_TRACE_RING_CORE_NUM ||
+        _ux_utility_short_get(trace_dump + 10) != UX_TRACE_RING_DUMP_ENTRY_LENGTH ||
+        _ux_utility_long_get(trace_dump + 12) != UX_TRACE_RING_TIMESTAMP_FREQUENCY ||
+        _ux_utility_long_get(trace_dump + 16) != _ux_trace_ring.ux_trace_ring_filter ||
+        _ux_utility_long_get(trace_dump + 20) != _ux_trace_ring.ux_trace_ring_entries)
+        return(UX_ERROR);
+    trace_events_count = _ux_utility_long_get(trace_dump + 24);
+    trace_events_lost = _ux_utility_long_get(trace_dump + 28);
+    if (length != UX_TRACE_RING_DUMP_HEADER_LENGTH + trace_events_count * UX_TRACE_RING_DUMP_ENTRY_LENGTH)
+        return(UX_ERROR);
+
+    /* Decode the entries, sequences are contiguous on a single core.  */
+    for (i = 0; i < trace_events_count; i ++)
+    {
+        entry = trace_dump + UX_TRACE_RING_DUMP_HEADER_LENGTH + i * UX_TRACE_RING_DUMP_ENTRY_LENGTH;
+        trace_events[i].sequence = _ux_utility_long_get(entry);
+        trace_events[i].timestamp = _ux_utility_long_get(entry + 4);
+        trace_events[i].event_id = _ux_utility_short_get(entry + 8);
+        trace_events[i].info_1 = _ux_utility_long_get(entry + 12);
+        trace_events[i].info_2 = _ux_utility_long_get(entry + 16);
+        trace_events[i].info_3 = _ux_utility_long_get(entry + 20);
+        if (entry[10] != 0 || entry[11] != 0)
+            return(UX_ERROR);
+        if (i > 0 && trace_events[i].sequence != trace_events[i - 1].sequence + 1)
+            return(UX_ERROR);
+    }
+    if (trace_events_count > 0 && trace_events[0].sequence != trace_events_lost + 1)
+        return(UX_ERROR);
+
+    return(UX_SUCCESS);
+}
+
+/* Find the next decoded event, starting from an index.  */
+static UX_TEST_EVENT *ux_test_trace_ring_find(ULONG event_id, ULONG *index)
+{
+ULONG           i;
+
+    for (i = *index; i < trace_events_count; i ++)
+    {
+        if (trace_events[i].event_id == event_id)
+        {
+            *index = i + 1;
+            return(&trace_events[i]);
+        }
+    }
+    return(UX_NULL);
+}
+#endif
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                            status;
+UX_HOST_CLASS                   *class;
+#ifdef UX_ENABLE_TRACE_RING
+ULONG                           actual_length;
+ULONG                           i;
+ULONG                           count;
+ULONG                           address;
+UX_TEST_EVENT                   *event;
+clock_t                         start;
+double                          elapsed;
+#endif
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE)
+    {
+
+#if defined(UX_HOST_STANDALONE)
+        ux_system_tasks_run();
+#endif
+        tx_thread_relinquish();
+
+    }
+
+#ifdef UX_ENABLE_TRACE_RING
+
+    /* Check the enumeration events.  */
+    UX_TEST_ASSERT(ux_test_trace_ring_decode() == UX_SUCCESS);
+    UX_TEST_ASSERT(trace_events_lost == 0);
+    address = dpump -> ux_host_class_dpump_device -> ux_device_address;
+    i = 0;
+    event = ux_test_trace_ring_find(UX_TRACE_RING_HOST_DEVICE_CONNECT, &i);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == 0);
+    event = ux_test_trace_ring_find(UX_TRACE_RING_HOST_DEVICE_ADDRESS_SET, &i);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == address);
+    count = 0;
+    event = ux_test_trace_ring_find(UX_TRACE_RING_DEVICE_ADDRESS_SET, &count);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == address);
+    event = ux_test_trace_ring_find(UX_TRACE_RING_HOST_DEVICE_DESCRIPTOR_READ, &i);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == address);
+    UX_TEST_ASSERT(event -> info_2 == dpump -> ux_host_class_dpump_device -> ux_device_descriptor.idVendor);
+    UX_TEST_ASSERT(event -> info_3 == dpump -> ux_host_class_dpump_device -> ux_device_descriptor.idProduct);
+    event = ux_test_trace_ring_find(UX_TRACE_RING_HOST_CONFIGURATION_SET, &i);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == address);
+    UX_TEST_ASSERT(event -> info_2 == 1);
+    count = 0;
+    event = ux_test_trace_ring_find(UX_TRACE_RING_DEVICE_CONFIGURATION_SET, &count);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == 1);
+    event = ux_test_trace_ring_find(UX_TRACE_RING_DEVICE_CLASS_ACTIVATE, &count);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_1 == 0);
+    UX_TEST_ASSERT(event -> info_2 == 0x99);
+    UX_TEST_ASSERT(event -> info_3 == UX_SUCCESS);
+    i = 0;
+    event = ux_test_trace_ring_find(UX_TRACE_RING_HOST_CLASS_INSTANCE_CREATE, &i);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_2 == (ULONG)(((ALIGN_TYPE)dpump) & 0xFFFFFFFFUL));
+
+    /* Control transfers of enumeration are recorded with completion.  */
+    i = 0;
+    UX_TEST_ASSERT(ux_test_trace_ring_find(UX_TRACE_RING_HOST_TRANSFER_SUBMIT, &i) != UX_NULL);
+    i = 0;
+    event = ux_test_trace_ring_find(UX_TRACE_RING_HOST_TRANSFER_COMPLETE, &i);
+    UX_TEST_ASSERT(event != UX_NULL);
+    UX_TEST_ASSERT(event -> info_2 == UX_SUCCESS);
+    i = 0;
+    UX_TEST_ASSERT(ux_test_trace_ring_find(UX_TRACE_RING_DEVICE_TRANSFER_SUBMIT, &i) != UX_NULL);
+    i = 0;
+    UX_TEST_ASSERT(ux_test_trace_ring_find(UX_TRACE_RING_DEVICE_TRANSFER_COMPLETE, &i) != UX_NULL);
+
+    /* Allocate the host buffers.  */
+    host_out_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    host_in_buffer = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    UX_TEST_ASSERT(host_out_buffer != UX_NULL);
+    UX_TEST_ASSERT(host_in_buffer != UX_NULL);
+
+    /* Only record transfers, restart the ring.  */
+    UX_TEST_ASSERT(ux_trace_ring_enable(trace_ring_buffer, sizeof(trace_ring_buffer), UX_TRACE_RING_TRANSFER) == UX_SUCCESS);
+
+    /* Perform this test sequence 10 times.  */
+    for (i = 0; i < 10; i++)
+    {
+
+        /* Increment thread counter.  */
+        thread_0_counter++;
+
+        /* Write to the host Data Pump Bulk out endpoint.  */
+        _ux_utility_memory_set(host_out_buffer, (UCHAR)('A' + i), UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        status =  _ux_host_class_dpump_write (dpump, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+
+#if defined(UX_HOST_STANDALONE)
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+#endif
+
+        /* Read from the Data Pump Bulk in endpoint.  */
+        status =  _ux_host_class_dpump_read (dpump, host_in_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+        UX_TEST_ASSERT(_ux_utility_memory_compare(host_in_buffer, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE) == UX_SUCCESS);
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+    }
+
+    /* Only transfer events are recorded, with endpoints and lengths.  */
+    UX_TEST_ASSERT(ux_test_trace_ring_decode() == UX_SUCCESS);
+    UX_TEST_ASSERT(trace_events_lost == 0);
+    count = 0;
+    for (i = 0; i < trace_events_count; i ++)
+    {
+        event = &trace_events[i];
+        UX_TEST_ASSERT(UX_TRACE_RING_EVENT_CATEGORY(event -> event_id) == UX_TRACE_RING_TRANSFER);
+        if (event -> event_id == UX_TRACE_RING_HOST_TRANSFER_COMPLETE)
+        {
+            UX_TEST_ASSERT(event -> info_1 == ((address << 8) | 0x01) || event -> info_1 == ((address << 8) | 0x82));
+            UX_TEST_ASSERT(event -> info_2 == UX_SUCCESS);
+            UX_TEST_ASSERT(event -> info_3 == UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+            count ++;
+        }
+        if (event -> event_id == UX_TRACE_RING_HOST_TRANSFER_SUBMIT)
+        {
+            UX_TEST_ASSERT(event -> info_2 == UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        }
+        if (i > 0)
+            UX_TEST_ASSERT((LONG)(event -> timestamp - trace_events[i - 1].timestamp) >= 0);
+    }
+    UX_TEST_ASSERT(count == 20);
+
+    /* No event is recorded without category.  */
+    UX_TEST_ASSERT(ux_trace_ring_filter_set(0) == UX_SUCCESS);
+    count = _ux_trace_ring.ux_trace_ring_cores[0].ux_trace_ring_core_index;
+    _ux_utility_memory_set(host_out_buffer, 'Z', UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    status =  _ux_host_class_dpump_write (dpump, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+#if defined(UX_HOST_STANDALONE)
+    tx_thread_relinquish();
+#endif
+    status =  _ux_host_class_dpump_read (dpump, host_in_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_trace_ring.ux_trace_ring_cores[0].ux_trace_ring_core_index == count);
+
+    /* Errors are recorded with their context.  */
+    UX_TEST_ASSERT(ux_trace_ring_filter_set(UX_TRACE_RING_ERRORS) == UX_SUCCESS);
+    expected_error = UX_MEMORY_INSUFFICIENT;
+    _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
+    expected_error = 0;
+    UX_TEST_ASSERT(ux_test_trace_ring_decode() == UX_SUCCESS);
+    event = &trace_events[trace_events_count - 1];
+    UX_TEST_ASSERT(event -> event_id == UX_TRACE_RING_ERROR);
+    UX_TEST_ASSERT(event -> info_1 == UX_SYSTEM_LEVEL_THREAD);
+    UX_TEST_ASSERT(event -> info_2 == UX_SYSTEM_CONTEXT_CLASS);
+    UX_TEST_ASSERT(event -> info_3 == UX_MEMORY_INSUFFICIENT);
+
+    /* The oldest entries are overwritten, lost entries are reported.  */
+    UX_TEST_ASSERT(ux_trace_ring_enable(trace_ring_buffer, sizeof(UX_TRACE_RING_ENTRY) * 11 * UX_TRACE_RING_CORE_NUM, UX_TRACE_RING_ALL) == UX_SUCCESS);
+    UX_TEST_ASSERT(_ux_trace_ring.ux_trace_ring_entries == 8);
+    for (i = 0; i < 20; i ++)
+        _ux_trace_ring_insert(UX_TRACE_RING_ERROR, i, 0, 0);
+    UX_TEST_ASSERT(ux_test_trace_ring_decode() == UX_SUCCESS);
+    UX_TEST_ASSERT(trace_events_count == 8);
+    UX_TEST_ASSERT(trace_events_lost == 12);
+    for (i = 0; i < 8; i ++)
+        UX_TEST_ASSERT(trace_events[i].info_1 == 12 + i);
+
+    /* Dump length is returned without buffer.  */
+    UX_TEST_ASSERT(ux_trace_ring_dump(UX_NULL, 0, &actual_length) == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(actual_length == UX_TRACE_RING_DUMP_HEADER_LENGTH + 8 * UX_TRACE_RING_CORE_NUM * UX_TRACE_RING_DUMP_ENTRY_LENGTH);
+    UX_TEST_ASSERT(ux_trace_ring_dump(trace_dump, UX_TRACE_RING_DUMP_HEADER_LENGTH, &actual_length) == UX_MEMORY_INSUFFICIENT);
+
+    /* Print cost of an event, not checked since it depends on host load.  */
+    start = clock();
+    for (i = 0; i < UX_TEST_INSERTS; i ++)
+        UX_TRACE_RING_INSERT(UX_TRACE_RING_ERROR, i, 0, 0)
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%.1fns/event ", elapsed * 1e9 / UX_TEST_INSERTS);
+
+    /* Disable the trace ring.  */
+    UX_TEST_ASSERT(ux_trace_ring_enable(UX_NULL, 0, 0) == UX_SUCCESS);
+    UX_TEST_ASSERT(ux_trace_ring_filter_set(UX_TRACE_RING_ALL) == UX_FUNCTION_NOT_SUPPORTED);
+
+    _ux_utility_memory_free(host_in_buffer);
+    _ux_utility_memory_free(host_out_buffer);
+#endif
+
+    /* Sleep for a tick to make sure everything is complete.  */
+    tx_thread_sleep(1);
+
+    /* Check for errors from other threads.  */
+    if (error_counter)
+    {
+
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+#if defined(UX_DEVICE_STANDALONE)
+#define DPUMP_DEVICE_STATE_READ     UX_STATE_STEP
+#define DPUMP_DEVICE_STATE_WRITE    UX_STATE_STEP + 1
+UINT    dpump_device_state = UX_STATE_RESET;
+#endif
+
+
+    while(1)
+    {
+#if defined(UX_DEVICE_STANDALONE)
+
+        /* Run device tasks.  */
+        ux_system_tasks_run();
+
+        /* DPUMP echo state machine.  */
+        switch(dpump_device_state)
+        {
+        case UX_STATE_RESET:
+            if (dpump_slave != UX_NULL)
+
+                /* Start reading.  */
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+
+        case DPUMP_DEVICE_STATE_READ:
+
+            /* Read from the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_read_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: read status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+            {
+                if (actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+                {
+                    printf("ERROR #%d: read length %ld\n", __LINE__, actual_length);
+                    error_counter ++;
+                    return;
+                }
+
+                dpump_device_state = DPUMP_DEVICE_STATE_WRITE;
+            }
+            break;
+
+        case DPUMP_DEVICE_STATE_WRITE:
+
+            /* Now write to the device data pump.  */
+            if (dpump_slave == UX_NULL)
+            {
+                dpump_device_state = UX_STATE_RESET;
+                break;
+            }
+            status = ux_device_class_dpump_write_run(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            if (status < UX_STATE_NEXT)
+            {
+                printf("ERROR #%d: write status 0x%x\n", __LINE__, status);
+                error_counter ++;
+                return;
+            }
+
+            if (status == UX_STATE_NEXT)
+                dpump_device_state = DPUMP_DEVICE_STATE_READ;
+            break;
+        
+        default:
+            dpump_device_state = UX_STATE_RESET;
+        }
+
+        /* Increment thread counter.  */
+        thread_1_counter++;
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+
+#else
+        /* Ensure the dpump class on the device is still alive.  */
+        while (dpump_slave != UX_NULL)
+        {
+
+            /* Increment thread counter.  */
+            thread_1_counter++;
+
+            /* Read from the device data pump.  */
+            status =  _ux_device_class_dpump_read(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: read status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+
+            /* Now write to the device data pump.  */
+            status =  _ux_device_class_dpump_write(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+
+            /* Verify that the status and the amount of data is correct.  */
+            if ((status != UX_SUCCESS) || actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+            {
+                printf("ERROR #%d.%ld: write status 0x%x, length %ld\n", __LINE__, thread_1_counter, status, actual_length);
+
+                /* Increment error counter.  */
+                error_counter++;
+
+                /* Return from thread.  */
+                return;
+            }
+        }
+
+        /* Relinquish to other thread.  */
+        tx_thread_relinquish();
+#endif
+    }
+}
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
+
+#if defined(UX_HOST_STANDALONE)
+static UINT  tx_demo_host_change_function(ULONG e, UX_HOST_CLASS *c, VOID *p)
+{
+    if (e == UX_STANDALONE_WAIT_BACKGROUND_TASK)
+    {
+        tx_thread_relinquish();
+    }
+}
+#endif
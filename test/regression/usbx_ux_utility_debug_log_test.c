@@ -0,0 +1,337 @@
+/* This test is designed to test the binary debug log: records logged by UX_DEBUG_LOG, the dump
+   image with its string table, ring overwrite and the debug callback.
+   Cost of a log is printed, it is not checked since it depends on host load.  */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_LOGS            1000000
+#define UX_TEST_STRINGS_MAX     16
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static ULONG                           callback_count;
+static UCHAR                           *callback_message;
+static ULONG                           callback_code;
+
+
+/* Define USBX test global variables.  */
+
+#ifdef UX_ENABLE_DEBUG_LOG
+static UCHAR                           debug_dump[UX_DEBUG_LOG_SIZE * 2];
+
+/* Decoded dump.  */
+typedef struct UX_TEST_RECORD_STRUCT
+{
+    ULONG       sequence;
+    ULONG       timestamp;
+    ULONG       location;
+    ULONG       message;
+    ULONG       code;
+    ULONG       parameter_1;
+    ULONG       parameter_2;
+} UX_TEST_RECORD;
+
+static UX_TEST_RECORD                  debug_records[UX_DEBUG_LOG_SIZE / UX_DEBUG_LOG_DUMP_RECORD_LENGTH];
+static ULONG                           debug_records_count;
+static ULONG                           debug_records_lost;
+static UCHAR                           *debug_strings[UX_TEST_STRINGS_MAX];
+static ULONG                           debug_strings_length[UX_TEST_STRINGS_MAX];
+static ULONG                           debug_strings_count;
+
+/* Same content as the location string, at another address.  */
+static UCHAR                           location_copy[] = "ux_test_location";
+#endif
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Failed test.  */
+    printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+    test_control_return(1);
+}
+
+static VOID debug_callback(UCHAR *debug_message, ULONG debug_code)
+{
+
+    callback_count ++;
+    callback_message = debug_message;
+    callback_code = debug_code;
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_debug_log_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_debug_log Test................................... ");
+
+#ifndef UX_ENABLE_DEBUG_LOG
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#ifdef UX_ENABLE_DEBUG_LOG
+
+/* Dump the debug log and decode the records and strings.  */
+static UINT ux_test_debug_log_decode(VOID)
+{
+UINT            status;
+ULONG           length;
+ULONG           strings_length;
+ULONG           i;
+UCHAR           *record;
+UCHAR           *string;
+
+    status = ux_utility_debug_log_dump(debug_dump, sizeof(debug_dump), &length);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Check the header.  */
+    if (_ux_utility_long_get(debug_dump) != UX_DEBUG_LOG_DUMP_MAGIC ||
+        _ux_utility_short_get(debug_dump + 4) != UX_DEBUG_LOG_DUMP_VERSION ||
+        _ux_utility_short_get(debug_dump + 6) != UX_DEBUG_LOG_DUMP_HEADER_LENGTH ||
+        _ux_utility_short_get(debug_dump + 8) != UX_DEBUG_LOG_DUMP_RECORD_LENGTH ||
+        _ux_utility_long_get(debug_dump + 12) != UX_DEBUG_LOG_TIMESTAMP_FREQUENCY ||
+        _ux_utility_long_get(debug_dump + 16) != _ux_system -> ux_system_debug_log_records)
+        return(UX_ERROR);
+    debug_strings_count = _ux_utility_short_get(debug_dump + 10);
+    debug_records_count = _ux_utility_long_get(debug_dump + 20);
+    debug_records_lost = _ux_utility_long_get(debug_dump + 24);
+    strings_length = _ux_utility_long_get(debug_dump + 28);
+    if (length != UX_DEBUG_LOG_DUMP_HEADER_LENGTH + debug_records_count * UX_DEBUG_LOG_DUMP_RECORD_LENGTH + strings_length)
+        return(UX_ERROR);
+    if (debug_strings_count > UX_TEST_STRINGS_MAX)
+        return(UX_ERROR);
+
+    /* Decode the records, sequences are contiguous.  */
+    for (i = 0; i < debug_records_count; i ++)
+    {
+        record = debug_dump + UX_DEBUG_LOG_DUMP_HEADER_LENGTH + i * UX_DEBUG_LOG_DUMP_RECORD_LENGTH;
+        debug_records[i].sequence = _ux_utility_long_get(record);
+        debug_records[i].timestamp = _ux_utility_long_get(record + 4);
+        debug_records[i].location = _ux_utility_short_get(record + 8);
+        debug_records[i].message = _ux_utility_short_get(record + 10);
+        debug_records[i].code = _ux_utility_long_get(record + 12);
+        debug_records[i].parameter_1 = _ux_utility_long_get(record + 16);
+        debug_records[i].parameter_2 = _ux_utility_long_get(record + 20);
+        if (debug_records[i].location >= debug_strings_count || debug_records[i].message >= debug_strings_count)
+            return(UX_ERROR);
+        if (i > 0 && debug_records[i].sequence != debug_records[i - 1].sequence + 1)
+            return(UX_ERROR);
+    }
+    if (debug_records_count > 0 && debug_records[0].sequence != debug_records_lost + 1)
+        return(UX_ERROR);
+
+    /* Decode the string table.  */
+    string = debug_dump + UX_DEBUG_LOG_DUMP_HEADER_LENGTH + debug_records_count * UX_DEBUG_LOG_DUMP_RECORD_LENGTH;
+    for (i = 0; i < debug_strings_count; i ++)
+    {
+        debug_strings_length[i] = _ux_utility_short_get(string);
+        debug_strings[i] = string + 2;
+        string += 2 + debug_strings_length[i];
+    }
+    if (string != debug_dump + length)
+        return(UX_ERROR);
+
+    return(UX_SUCCESS);
+}
+
+/* Check a decoded string.  */
+static UINT ux_test_debug_log_string_check(ULONG id, char *string)
+{
+ULONG           length = (ULONG)strlen(string);
+
+    if (length > UX_DEBUG_LOG_STRING_LENGTH_MAX)
+        length = UX_DEBUG_LOG_STRING_LENGTH_MAX;
+    if (debug_strings_length[id] != length)
+        return(UX_ERROR);
+    return(_ux_utility_memory_compare(debug_strings[id], string, length));
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#ifdef UX_ENABLE_DEBUG_LOG
+ULONG           records;
+ULONG           logged;
+ULONG           actual_length;
+ULONG           i;
+clock_t         start;
+double          elapsed;
+char            long_message[UX_DEBUG_LOG_STRING_LENGTH_MAX + 16];
+
+
+    /* The log is a ring of records.  */
+    records = _ux_system -> ux_system_debug_log_records;
+    UX_TEST_ASSERT(records != 0);
+    UX_TEST_ASSERT((records & (records - 1)) == 0);
+    UX_TEST_ASSERT(records * sizeof(UX_DEBUG_LOG_RECORD) <= UX_DEBUG_LOG_SIZE);
+    UX_TEST_ASSERT(records * 2 * sizeof(UX_DEBUG_LOG_RECORD) > UX_DEBUG_LOG_SIZE);
+
+    /* Empty log.  */
+    UX_TEST_ASSERT(ux_test_debug_log_decode() == UX_SUCCESS);
+    UX_TEST_ASSERT(debug_records_count == 0);
+    UX_TEST_ASSERT(debug_strings_count == 0);
+
+    /* Log messages, the callback gets the message and code.  */
+    _ux_utility_debug_callback_register(debug_callback);
+    for (i = 0; i < 10; i ++)
+    {
+        UX_DEBUG_LOG("ux_test_location", (i & 1) ? "odd message" : "even message", i, i * 2, 0x12345678)
+        UX_TEST_ASSERT(callback_count == i + 1);
+        UX_TEST_ASSERT(callback_code == i);
+        UX_TEST_ASSERT(_ux_system -> ux_system_debug_code == i);
+    }
+    UX_TEST_ASSERT(_ux_utility_memory_compare(callback_message, "odd message", 12) == UX_SUCCESS);
+    _ux_utility_debug_callback_register(UX_NULL);
+
+    /* Strings with the same content are in the table once.  */
+    UX_DEBUG_LOG(location_copy, "even message", 10, 0, 0)
+
+    /* Strings are truncated.  */
+    _ux_utility_memory_set(long_message, 'L', sizeof(long_message) - 1);
+    long_message[sizeof(long_message) - 1] = 0;
+    UX_DEBUG_LOG("ux_test_location", long_message, 11, 0, 0)
+
+    /* Records are formatted off target.  */
+    UX_TEST_ASSERT(ux_test_debug_log_decode() == UX_SUCCESS);
+    UX_TEST_ASSERT(debug_records_count == 12);
+    UX_TEST_ASSERT(debug_records_lost == 0);
+    UX_TEST_ASSERT(debug_strings_count == 4);
+    for (i = 0; i < 12; i ++)
+    {
+        UX_TEST_ASSERT(debug_records[i].sequence == i + 1);
+        UX_TEST_ASSERT(debug_records[i].code == i);
+        UX_TEST_ASSERT(ux_test_debug_log_string_check(debug_records[i].location, "ux_test_location") == UX_SUCCESS);
+        if (i == 11)
+        {
+            UX_TEST_ASSERT(ux_test_debug_log_string_check(debug_records[i].message, long_message) == UX_SUCCESS);
+        }
+        else
+        {
+            UX_TEST_ASSERT(ux_test_debug_log_string_check(debug_records[i].message, (i & 1) ? "odd message" : "even message") == UX_SUCCESS);
+        }
+        if (i < 10)
+        {
+            UX_TEST_ASSERT(debug_records[i].parameter_1 == i * 2);
+            UX_TEST_ASSERT(debug_records[i].parameter_2 == 0x12345678);
+        }
+        if (i > 0)
+            UX_TEST_ASSERT((LONG)(debug_records[i].timestamp - debug_records[i - 1].timestamp) >= 0);
+    }
+
+    /* The oldest records are overwritten, lost records are reported.  */
+    for (i = 0; i < records + 20; i ++)
+        UX_DEBUG_LOG("ux_test_overwrite", "overwrite", i, 0, 0)
+    logged = 12 + records + 20;
+    UX_TEST_ASSERT(ux_test_debug_log_decode() == UX_SUCCESS);
+    UX_TEST_ASSERT(debug_records_count == records);
+    UX_TEST_ASSERT(debug_records_lost == logged - records);
+    UX_TEST_ASSERT(debug_strings_count == 2);
+    for (i = 0; i < records; i ++)
+        UX_TEST_ASSERT(debug_records[i].code == 20 + i);
+
+    /* Maximum length is returned without buffer or with a buffer too small.  */
+    UX_TEST_ASSERT(ux_utility_debug_log_dump(UX_NULL, 0, &actual_length) == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(actual_length >= UX_DEBUG_LOG_DUMP_HEADER_LENGTH + records * UX_DEBUG_LOG_DUMP_RECORD_LENGTH);
+    UX_TEST_ASSERT(ux_utility_debug_log_dump(debug_dump, UX_DEBUG_LOG_DUMP_HEADER_LENGTH, &actual_length) == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(ux_utility_debug_log_dump(debug_dump, UX_DEBUG_LOG_DUMP_HEADER_LENGTH + records * UX_DEBUG_LOG_DUMP_RECORD_LENGTH, &actual_length) == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(ux_utility_debug_log_dump(debug_dump, sizeof(debug_dump), UX_NULL) == UX_INVALID_PARAMETER);
+
+    /* Print cost of a log.  */
+    start = clock();
+    for (i = 0; i < UX_TEST_LOGS; i ++)
+        UX_DEBUG_LOG("ux_test_cost", "cost", i, i, i)
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%.1fns/log ", elapsed * 1e9 / UX_TEST_LOGS);
+    UX_TEST_ASSERT(_ux_system -> ux_system_debug_count == logged + UX_TEST_LOGS);
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,414 @@
+/* This test is designed to verify and benchmark the ux_utility_descriptor_unpack_... functions.
+
+   A large composite configuration descriptor is walked as the host enumeration does. Each
+   standard descriptor is unpacked by the specialized unpacker and by the descriptor structure
+   interpreter (_ux_utility_descriptor_parse), and all fields are compared. Then the walk time
+   of both is measured and the speedup is printed.
+   Timing is not checked, since it depends on host load.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_FUNCTIONS       24
+#define UX_TEST_WALKS           20000
+
+#define     LSB(x) ( (x) & 0x00ff)
+#define     MSB(x) (((x) & 0xff00) >> 8)
+
+/* Configuration descriptor 9 bytes.  */
+#define CFG_DESC(wTotalLength, bNumInterfaces, bConfigurationValue)\
+    0x09, 0x02, LSB(wTotalLength), MSB(wTotalLength),\
+    (bNumInterfaces), (bConfigurationValue), 0x00,\
+    0xC0, 0xFA,
+#define CFG_DESC_LEN 9
+
+/* Function: IAD, control interface with class specific and interrupt endpoint,
+   data interface with zero bandwidth and active alternate settings.  */
+#define FUNC_DESC(ifc, ep)\
+    0x08, 0x0B, (ifc), 0x02, 0x02, 0x02, 0x00, 0x00,\
+    0x09, 0x04, (ifc), 0x00, 0x01, 0x02, 0x02, 0x01, 0x00,\
+    0x05, 0x24, 0x00, 0x10, 0x01,\
+    0x05, 0x24, 0x01, 0x03, (ifc) + 1,\
+    0x07, 0x05, 0x80 | (ep), 0x03, LSB(8), MSB(8), 0x10,\
+    0x09, 0x04, (ifc) + 1, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,\
+    0x09, 0x04, (ifc) + 1, 0x01, 0x02, 0x0A, 0x00, 0x00, 0x00,\
+    0x07, 0x05, (ep) + 1, 0x02, LSB(512), MSB(512), 0x00,\
+    0x07, 0x05, 0x80 | ((ep) + 1), 0x02, LSB(512), MSB(512), 0x00,
+#define FUNC_DESC_LEN (8 + 9 + 5 + 5 + 7 + 9 + 9 + 7 + 7)
+
+#define FUNC_DESC_2(ifc, ep)    FUNC_DESC(ifc, ep) FUNC_DESC((ifc) + 2, (ep) + 2)
+#define FUNC_DESC_4(ifc, ep)    FUNC_DESC_2(ifc, ep) FUNC_DESC_2((ifc) + 4, (ep) + 4)
+#define FUNC_DESC_8(ifc, ep)    FUNC_DESC_4(ifc, ep) FUNC_DESC_4((ifc) + 8, (ep) + 8)
+
+#define CFG_DESC_ALL_LEN (CFG_DESC_LEN + FUNC_DESC_LEN * UX_TEST_FUNCTIONS)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static UCHAR device_descriptor[] = {
+
+    /* Device descriptor 18 bytes */
+    0x12, 0x01, 0x00, 0x02, 0xEF, 0x02, 0x01, 0x40,
+    0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+    0x03, 0x01,
+};
+
+static UCHAR configuration_descriptor[] = {
+
+    CFG_DESC(CFG_DESC_ALL_LEN, UX_TEST_FUNCTIONS * 2, 1)
+    FUNC_DESC_8(0, 1)
+    FUNC_DESC_8(16, 1)
+    FUNC_DESC_8(32, 1)
+};
+
+static ULONG                           walk_counts[UX_ENDPOINT_DESCRIPTOR_ITEM + 1];
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_descriptor_unpack_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_descriptor_unpack Benchmark...................... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+/* Compare a field unpacked by both ways, and with the raw descriptor.  */
+#define UX_TEST_FIELD_COMPARE(name, size, offset)                               \
+    if (unpacked.name != parsed.name ||                                         \
+        unpacked.name != UX_DESCRIPTOR_FIELD_GET_##size(raw + (offset)))        \
+    {                                                                           \
+        printf("ERROR #%d: %s at %ld\n", __LINE__, #name, (long)(raw - configuration_descriptor));\
+        errors ++;                                                              \
+    }
+
+static ULONG ux_test_verify(void)
+{
+UCHAR                                   *raw;
+ULONG                                   errors = 0;
+UX_DEVICE_DESCRIPTOR                    unpacked_device, parsed_device;
+UX_CONFIGURATION_DESCRIPTOR             unpacked_configuration, parsed_configuration;
+UX_INTERFACE_ASSOCIATION_DESCRIPTOR     unpacked_iad, parsed_iad;
+UX_INTERFACE_DESCRIPTOR                 unpacked_interface, parsed_interface;
+UX_ENDPOINT_DESCRIPTOR                  unpacked_endpoint, parsed_endpoint;
+
+    /* Device descriptor.  */
+    raw = device_descriptor;
+    _ux_utility_memory_set(&unpacked_device, 0x5A, sizeof(unpacked_device));
+    _ux_utility_memory_set(&parsed_device, 0, sizeof(parsed_device));
+    _ux_utility_descriptor_unpack_device(raw, &unpacked_device);
+    _ux_utility_descriptor_parse(raw, _ux_system_device_descriptor_structure,
+                        UX_DEVICE_DESCRIPTOR_ENTRIES, (UCHAR *) &parsed_device);
+    {
+#define unpacked unpacked_device
+#define parsed parsed_device
+        UX_DEVICE_DESCRIPTOR_FIELDS(UX_TEST_FIELD_COMPARE)
+#undef unpacked
+#undef parsed
+    }
+
+    /* Walk the configuration descriptor.  */
+    raw = configuration_descriptor;
+    while (raw < configuration_descriptor + sizeof(configuration_descriptor))
+    {
+        if (raw[1] <= UX_ENDPOINT_DESCRIPTOR_ITEM || raw[1] == UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ITEM)
+            walk_counts[raw[1] == UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ITEM ? 0 : raw[1]] ++;
+
+        switch (raw[1])
+        {
+        case UX_CONFIGURATION_DESCRIPTOR_ITEM:
+
+            /* MaxPower is a ULONG field filled from one byte by the interpreter.  */
+            _ux_utility_memory_set(&unpacked_configuration, 0x5A, sizeof(unpacked_configuration));
+            _ux_utility_memory_set(&parsed_configuration, 0, sizeof(parsed_configuration));
+            _ux_utility_descriptor_unpack_configuration(raw, &unpacked_configuration);
+            _ux_utility_descriptor_parse(raw, _ux_system_configuration_descriptor_structure,
+                        UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *) &parsed_configuration);
+            parsed_configuration.MaxPower &= 0xFF;
+#if defined(UX_DISABLE_DESCRIPTOR_UNPACK)
+            unpacked_configuration.MaxPower &= 0xFF;
+#endif
+            {
+#define unpacked unpacked_configuration
+#define parsed parsed_configuration
+                UX_CONFIGURATION_DESCRIPTOR_FIELDS(UX_TEST_FIELD_COMPARE)
+#undef unpacked
+#undef parsed
+            }
+            break;
+
+        case UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ITEM:
+
+            _ux_utility_memory_set(&unpacked_iad, 0x5A, sizeof(unpacked_iad));
+            _ux_utility_memory_set(&parsed_iad, 0, sizeof(parsed_iad));
+            _ux_utility_descriptor_unpack_interface_association(raw, &unpacked_iad);
+            _ux_utility_descriptor_parse(raw, _ux_system_interface_association_descriptor_structure,
+                        UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES, (UCHAR *) &parsed_iad);
+            {
+#define unpacked unpacked_iad
+#define parsed parsed_iad
+                UX_INTERFACE_ASSOCIATION_DESCRIPTOR_FIELDS(UX_TEST_FIELD_COMPARE)
+#undef unpacked
+#undef parsed
+            }
+            break;
+
+        case UX_INTERFACE_DESCRIPTOR_ITEM:
+
+            _ux_utility_memory_set(&unpacked_interface, 0x5A, sizeof(unpacked_interface));
+            _ux_utility_memory_set(&parsed_interface, 0, sizeof(parsed_interface));
+            _ux_utility_descriptor_unpack_interface(raw, &unpacked_interface);
+            _ux_utility_descriptor_parse(raw, _ux_system_interface_descriptor_structure,
+                        UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *) &parsed_interface);
+            {
+#define unpacked unpacked_interface
+#define parsed parsed_interface
+                UX_INTERFACE_DESCRIPTOR_FIELDS(UX_TEST_FIELD_COMPARE)
+#undef unpacked
+#undef parsed
+            }
+            break;
+
+        case UX_ENDPOINT_DESCRIPTOR_ITEM:
+
+            _ux_utility_memory_set(&unpacked_endpoint, 0x5A, sizeof(unpacked_endpoint));
+            _ux_utility_memory_set(&parsed_endpoint, 0, sizeof(parsed_endpoint));
+            _ux_utility_descriptor_unpack_endpoint(raw, &unpacked_endpoint);
+            _ux_utility_descriptor_parse(raw, _ux_system_endpoint_descriptor_structure,
+                        UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *) &parsed_endpoint);
+            {
+#define unpacked unpacked_endpoint
+#define parsed parsed_endpoint
+                UX_ENDPOINT_DESCRIPTOR_FIELDS(UX_TEST_FIELD_COMPARE)
+#undef unpacked
+#undef parsed
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        raw += raw[0];
+    }
+
+    /* All the descriptors must have been walked.  */
+    if (raw != configuration_descriptor + sizeof(configuration_descriptor) ||
+        walk_counts[0] != UX_TEST_FUNCTIONS ||
+        walk_counts[UX_INTERFACE_DESCRIPTOR_ITEM] != UX_TEST_FUNCTIONS * 3 ||
+        walk_counts[UX_ENDPOINT_DESCRIPTOR_ITEM] != UX_TEST_FUNCTIONS * 3)
+    {
+        printf("ERROR #%d: walk end %ld, %ld IADs, %ld interfaces, %ld endpoints\n", __LINE__,
+                (long)(raw - configuration_descriptor), walk_counts[0],
+                walk_counts[UX_INTERFACE_DESCRIPTOR_ITEM], walk_counts[UX_ENDPOINT_DESCRIPTOR_ITEM]);
+        errors ++;
+    }
+
+    return(errors);
+}
+
+/* Walk the configuration descriptor like the host enumeration, either with the specialized
+   unpackers or with the interpreter.  */
+static ULONG ux_test_walk(UINT use_interpreter)
+{
+UCHAR                                   *raw = configuration_descriptor;
+ULONG                                   sum = 0;
+UX_CONFIGURATION_DESCRIPTOR             configuration;
+UX_INTERFACE_ASSOCIATION_DESCRIPTOR     iad;
+UX_INTERFACE_DESCRIPTOR                 interface_descriptor;
+UX_ENDPOINT_DESCRIPTOR                  endpoint;
+
+    while (raw < configuration_descriptor + sizeof(configuration_descriptor))
+    {
+        switch (raw[1])
+        {
+        case UX_CONFIGURATION_DESCRIPTOR_ITEM:
+            if (use_interpreter)
+                _ux_utility_descriptor_parse(raw, _ux_system_configuration_descriptor_structure,
+                        UX_CONFIGURATION_DESCRIPTOR_ENTRIES, (UCHAR *) &configuration);
+            else
+                _ux_utility_descriptor_unpack_configuration(raw, &configuration);
+            sum += configuration.wTotalLength;
+            break;
+
+        case UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ITEM:
+            if (use_interpreter)
+                _ux_utility_descriptor_parse(raw, _ux_system_interface_association_descriptor_structure,
+                        UX_INTERFACE_ASSOCIATION_DESCRIPTOR_ENTRIES, (UCHAR *) &iad);
+            else
+                _ux_utility_descriptor_unpack_interface_association(raw, &iad);
+            sum += iad.bInterfaceCount;
+            break;
+
+        case UX_INTERFACE_DESCRIPTOR_ITEM:
+            if (use_interpreter)
+                _ux_utility_descriptor_parse(raw, _ux_system_interface_descriptor_structure,
+                        UX_INTERFACE_DESCRIPTOR_ENTRIES, (UCHAR *) &interface_descriptor);
+            else
+                _ux_utility_descriptor_unpack_interface(raw, &interface_descriptor);
+            sum += interface_descriptor.bNumEndpoints;
+            break;
+
+        case UX_ENDPOINT_DESCRIPTOR_ITEM:
+            if (use_interpreter)
+                _ux_utility_descriptor_parse(raw, _ux_system_endpoint_descriptor_structure,
+                        UX_ENDPOINT_DESCRIPTOR_ENTRIES, (UCHAR *) &endpoint);
+            else
+                _ux_utility_descriptor_unpack_endpoint(raw, &endpoint);
+            sum += endpoint.wMaxPacketSize;
+            break;
+
+        default:
+            break;
+        }
+
+        raw += raw[0];
+    }
+
+    return(sum);
+}
+
+static double ux_test_time(clock_t start)
+{
+    return((double)(clock() - start) / CLOCKS_PER_SEC);
+}
+
+static ULONG ux_test_benchmark(void)
+{
+ULONG       n;
+ULONG       sum_parse = 0, sum_unpack = 0;
+clock_t     start;
+double      t_parse, t_unpack;
+
+    start = clock();
+    for (n = 0; n < UX_TEST_WALKS; n ++)
+        sum_parse += ux_test_walk(UX_TRUE);
+    t_parse = ux_test_time(start);
+    start = clock();
+    for (n = 0; n < UX_TEST_WALKS; n ++)
+        sum_unpack += ux_test_walk(UX_FALSE);
+    t_unpack = ux_test_time(start);
+
+    printf("%lu bytes configuration descriptor, %d walks: parse %.3fs, unpack %.3fs, x%.2f\n",
+            (ULONG)sizeof(configuration_descriptor), UX_TEST_WALKS, t_parse, t_unpack,
+            t_unpack > 0 ? t_parse / t_unpack : 0);
+
+    /* Both walks must see the same values.  */
+    return(sum_parse != sum_unpack);
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+    /* Results must be the same as the interpreter.  */
+    UX_TEST_ASSERT(ux_test_verify() == 0);
+
+    /* Print speedup against the interpreter.  */
+    printf("\n");
+#if defined(UX_DISABLE_DESCRIPTOR_UNPACK)
+    printf("specialized unpackers are disabled, the interpreter is used\n");
+#endif
+    UX_TEST_ASSERT(ux_test_benchmark() == 0);
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,253 @@
+/* This test is designed to test the ux_utility_memory_arena_....  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (256*1024)
+#define UX_TEST_BLOCKS          64
+#define UX_TEST_CYCLES          100
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static UCHAR                           *blocks[UX_TEST_BLOCKS];
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_arena_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_arena Test................................ ");
+
+#ifndef UX_ENABLE_MEMORY_ARENA
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#ifdef UX_ENABLE_MEMORY_ARENA
+static ALIGN_TYPE ux_test_block_owner(UCHAR *memory)
+{
+ALIGN_TYPE *owner_ptr;
+
+    owner_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(memory - UX_MEMORY_BLOCK_HEADER_SIZE + sizeof(UCHAR *));
+    return(*owner_ptr);
+}
+
+static VOID ux_test_device_objects_allocate(ULONG n)
+{
+ULONG       i;
+
+    for (i = 0; i < n; i ++)
+    {
+        blocks[i] = _ux_utility_memory_allocate((i & 3) ? UX_NO_ALIGN : UX_ALIGN_64,
+                                                (i & 1) ? UX_CACHE_SAFE_MEMORY : UX_REGULAR_MEMORY,
+                                                (i * 53) % 400 + 1);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+    }
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#ifdef UX_ENABLE_MEMORY_ARENA
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+UX_MEMORY_ARENA         *arena_ptr;
+ULONG                   available;
+UINT                    fragments;
+ULONG                   size;
+ULONG                   i, j;
+UCHAR                   *temp;
+
+
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    available = pool_ptr -> ux_byte_pool_available;
+
+    /* Create and select an arena.  */
+    arena_ptr = _ux_utility_memory_arena_create();
+    UX_TEST_ASSERT(arena_ptr != UX_NULL);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available < available);
+    UX_TEST_ASSERT(_ux_utility_memory_arena_select(arena_ptr) == UX_NULL);
+
+    /* Objects are taken from the arena, cleared and aligned.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        size = (i * 53) % 400 + 1;
+        blocks[i] = _ux_utility_memory_allocate((i & 3) ? UX_NO_ALIGN : UX_ALIGN_64, UX_REGULAR_MEMORY, size);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+        UX_TEST_ASSERT(ux_test_block_owner(blocks[i]) == UX_BYTE_BLOCK_ARENA);
+        UX_TEST_ASSERT(((ALIGN_TYPE)blocks[i] & ((i & 3) ? UX_ALIGN_MIN : UX_ALIGN_64)) == 0);
+        for (j = 0; j < size; j ++)
+            UX_TEST_ASSERT(blocks[i][j] == 0);
+        _ux_utility_memory_set(blocks[i], 0x5A, size);
+    }
+    UX_TEST_ASSERT(arena_ptr -> ux_memory_arena_objects == UX_TEST_BLOCKS);
+
+    /* Objects larger than a chunk are in the arena too.  */
+    temp = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_MEMORY_ARENA_CHUNK_SIZE * 2);
+    UX_TEST_ASSERT(temp != UX_NULL);
+    UX_TEST_ASSERT(ux_test_block_owner(temp) == UX_BYTE_BLOCK_ARENA);
+    _ux_utility_memory_free(temp);
+
+    /* Space of the last object is reused.  */
+    temp = blocks[UX_TEST_BLOCKS - 1];
+    _ux_utility_memory_free(temp);
+    blocks[UX_TEST_BLOCKS - 1] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 8);
+    UX_TEST_ASSERT(blocks[UX_TEST_BLOCKS - 1] == temp);
+
+    /* Double free of arena object is trapped.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    _ux_utility_memory_free(blocks[0]);
+    _ux_utility_memory_free(blocks[0]);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    error_callback_ignore = UX_FALSE;
+    blocks[0] = UX_NULL;
+
+    /* Deselected, memory is from the pool.  */
+    UX_TEST_ASSERT(_ux_utility_memory_arena_select(UX_NULL) == arena_ptr);
+    temp = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+    UX_TEST_ASSERT(temp != UX_NULL);
+    UX_TEST_ASSERT(ux_test_block_owner(temp) != UX_BYTE_BLOCK_ARENA);
+    _ux_utility_memory_free(temp);
+
+    /* Arena deleted with objects, it's released when the last one is freed.  */
+    for (i = 1; i < UX_TEST_BLOCKS / 2; i ++)
+        _ux_utility_memory_free(blocks[i]);
+    _ux_utility_memory_arena_delete(arena_ptr);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available < available);
+    for (i = UX_TEST_BLOCKS / 2; i < UX_TEST_BLOCKS; i ++)
+        _ux_utility_memory_free(blocks[i]);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+#ifdef UX_ENABLE_MEMORY_STATISTICS
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_alloc_count == 0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_alloc_total == 0);
+#endif
+
+    /* Plug/unplug loop, the pool is left as it was found (the first loop
+       may split free blocks that are not merged on free).  */
+    for (i = 0; i < UX_TEST_CYCLES; i ++)
+    {
+        arena_ptr = _ux_utility_memory_arena_create();
+        UX_TEST_ASSERT(arena_ptr != UX_NULL);
+        _ux_utility_memory_arena_select(arena_ptr);
+        ux_test_device_objects_allocate(UX_TEST_BLOCKS);
+        _ux_utility_memory_arena_select(UX_NULL);
+
+        /* Allocation in between, not from the arena.  */
+        temp = _ux_utility_memory_allocate(UX_ALIGN_64, UX_REGULAR_MEMORY, 100 + i);
+        UX_TEST_ASSERT(temp != UX_NULL);
+
+        for (j = 0; j < UX_TEST_BLOCKS; j ++)
+            _ux_utility_memory_free(blocks[(j * 7) % UX_TEST_BLOCKS]);
+        _ux_utility_memory_arena_delete(arena_ptr);
+        _ux_utility_memory_free(temp);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+        if (i == 0)
+            fragments = pool_ptr -> ux_byte_pool_fragments;
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == fragments);
+    }
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,319 @@
+/* This test is designed to verify and benchmark the word access of ux_utility_memory_copy/set/compare.
+
+   Results are compared to a byte-at-a-time reference for sizes from 8 bytes to 64 KB, with
+   aligned and misaligned buffers. Then the time of the reference loop and of the USBX
+   functions is measured for each size and the speedup is printed in one line per size.
+   Timing is not checked, since it depends on host load.  */
+
+#include <stdio.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+#define UX_TEST_BUFFER_SIZE     (64*1024 + 64)
+#define UX_TEST_BYTES_PER_SIZE  (8*1024*1024)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static ALIGN_TYPE                      buffer_source[UX_TEST_BUFFER_SIZE / sizeof(ALIGN_TYPE)];
+static ALIGN_TYPE                      buffer_destination[UX_TEST_BUFFER_SIZE / sizeof(ALIGN_TYPE)];
+static ALIGN_TYPE                      buffer_reference[UX_TEST_BUFFER_SIZE / sizeof(ALIGN_TYPE)];
+
+static const ULONG                     test_sizes[] = {8, 16, 64, 256, 1024, 4096, 16384, 65536};
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_copy_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory copy/set/compare Benchmark................ ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+/* Byte-at-a-time references, like the USBX functions were before word access.
+   Accesses are volatile so the host compiler does not turn them into library calls
+   or vector loops, which most embedded targets do not have.  */
+static VOID ux_test_byte_copy(UCHAR *destination, UCHAR *source, ULONG length)
+{
+volatile UCHAR  *dst = destination;
+
+    while(length--)
+        *dst++ = *source++;
+}
+
+static VOID ux_test_byte_set(UCHAR *destination, UCHAR value, ULONG length)
+{
+volatile UCHAR  *dst = destination;
+
+    while(length--)
+        *dst++ = value;
+}
+
+static UINT ux_test_byte_compare(UCHAR *source, UCHAR *destination, ULONG length)
+{
+volatile UCHAR  *dst = destination;
+
+    while(length--)
+    {
+        if (*dst++ != *source++)
+            return(UX_ERROR);
+    }
+    return(UX_SUCCESS);
+}
+
+static VOID ux_test_pattern(UCHAR *buffer, ULONG length, ULONG seed)
+{
+ULONG       i;
+
+    for (i = 0; i < length; i ++)
+        buffer[i] = (UCHAR)((i * 7) + seed);
+}
+
+static ULONG ux_test_verify(void)
+{
+UCHAR       *source = (UCHAR *)buffer_source;
+UCHAR       *destination = (UCHAR *)buffer_destination;
+UCHAR       *reference = (UCHAR *)buffer_reference;
+ULONG       size;
+ULONG       i;
+ULONG       src_offset;
+ULONG       dst_offset;
+ULONG       errors = 0;
+
+    for (i = 0; i < sizeof(test_sizes) / sizeof(test_sizes[0]); i ++)
+    {
+        for (src_offset = 0; src_offset < sizeof(ALIGN_TYPE); src_offset ++)
+        {
+            for (dst_offset = 0; dst_offset < sizeof(ALIGN_TYPE); dst_offset ++)
+            {
+
+                /* Sizes around the tested size.  */
+                for (size = test_sizes[i] - 1; size <= test_sizes[i] + 1; size ++)
+                {
+
+                    /* Copy.  */
+                    ux_test_pattern(source, UX_TEST_BUFFER_SIZE, size);
+                    ux_test_pattern(destination, UX_TEST_BUFFER_SIZE, 0x55);
+                    ux_test_pattern(reference, UX_TEST_BUFFER_SIZE, 0x55);
+                    _ux_utility_memory_copy(destination + dst_offset, source + src_offset, size);
+                    ux_test_byte_copy(reference + dst_offset, source + src_offset, size);
+                    if (ux_test_byte_compare(destination, reference, UX_TEST_BUFFER_SIZE) != UX_SUCCESS)
+                        errors ++;
+
+                    /* Compare equal blocks, then a difference at start, middle and end.  */
+                    if (_ux_utility_memory_compare(destination + dst_offset, source + src_offset, size) != UX_SUCCESS)
+                        errors ++;
+                    destination[dst_offset] ^= 0x80;
+                    if (_ux_utility_memory_compare(destination + dst_offset, source + src_offset, size) == UX_SUCCESS)
+                        errors ++;
+                    destination[dst_offset] ^= 0x80;
+                    destination[dst_offset + size / 2] ^= 0x01;
+                    if (_ux_utility_memory_compare(source + src_offset, destination + dst_offset, size) == UX_SUCCESS)
+                        errors ++;
+                    destination[dst_offset + size / 2] ^= 0x01;
+                    destination[dst_offset + size - 1] ^= 0x10;
+                    if (_ux_utility_memory_compare(destination + dst_offset, source + src_offset, size) == UX_SUCCESS)
+                        errors ++;
+
+                    /* Set.  */
+                    ux_test_pattern(destination, UX_TEST_BUFFER_SIZE, 0x33);
+                    ux_test_pattern(reference, UX_TEST_BUFFER_SIZE, 0x33);
+                    _ux_utility_memory_set(destination + dst_offset, (UCHAR)(0xA5 + src_offset), size);
+                    ux_test_byte_set(reference + dst_offset, (UCHAR)(0xA5 + src_offset), size);
+                    if (ux_test_byte_compare(destination, reference, UX_TEST_BUFFER_SIZE) != UX_SUCCESS)
+                        errors ++;
+                }
+            }
+
+            /* Overlapped copy to lower address, e.g. buffer data shift.  */
+            size = test_sizes[i];
+            ux_test_pattern(destination, UX_TEST_BUFFER_SIZE, 0x11);
+            ux_test_pattern(reference, UX_TEST_BUFFER_SIZE, 0x11);
+            _ux_utility_memory_copy(destination + 1, destination + 1 + src_offset + sizeof(ALIGN_TYPE), size);
+            ux_test_byte_copy(reference + 1, reference + 1 + src_offset + sizeof(ALIGN_TYPE), size);
+            if (ux_test_byte_compare(destination, reference, UX_TEST_BUFFER_SIZE) != UX_SUCCESS)
+                errors ++;
+        }
+    }
+
+    return(errors);
+}
+
+static double ux_test_time(clock_t start)
+{
+    return((double)(clock() - start) / CLOCKS_PER_SEC);
+}
+
+static VOID ux_test_benchmark(ULONG misalign)
+{
+UCHAR       *source = (UCHAR *)buffer_source + misalign;
+UCHAR       *destination = (UCHAR *)buffer_destination + misalign;
+ULONG       size;
+ULONG       loops;
+ULONG       i, n;
+clock_t     start;
+double      t_byte, t_ux;
+double      copy_gain, set_gain, compare_gain;
+volatile UINT status;
+
+    printf("%-8s %10s %10s %10s\n", misalign ? "misalign" : "aligned", "copy x", "set x", "compare x");
+    for (i = 0; i < sizeof(test_sizes) / sizeof(test_sizes[0]); i ++)
+    {
+        size = test_sizes[i];
+        loops = UX_TEST_BYTES_PER_SIZE / size;
+
+        /* Copy.  */
+        start = clock();
+        for (n = 0; n < loops; n ++)
+            ux_test_byte_copy(destination, source, size);
+        t_byte = ux_test_time(start);
+        start = clock();
+        for (n = 0; n < loops; n ++)
+            _ux_utility_memory_copy(destination, source, size);
+        t_ux = ux_test_time(start);
+        copy_gain = t_ux > 0 ? t_byte / t_ux : 0;
+
+        /* Set.  */
+        start = clock();
+        for (n = 0; n < loops; n ++)
+            ux_test_byte_set(destination, (UCHAR)n, size);
+        t_byte = ux_test_time(start);
+        start = clock();
+        for (n = 0; n < loops; n ++)
+            _ux_utility_memory_set(destination, (UCHAR)n, size);
+        t_ux = ux_test_time(start);
+        set_gain = t_ux > 0 ? t_byte / t_ux : 0;
+
+        /* Compare (equal blocks, so all bytes are compared).  */
+        _ux_utility_memory_copy(destination, source, size);
+        start = clock();
+        for (n = 0; n < loops; n ++)
+            status = ux_test_byte_compare(destination, source, size);
+        t_byte = ux_test_time(start);
+        start = clock();
+        for (n = 0; n < loops; n ++)
+            status = _ux_utility_memory_compare(destination, source, size);
+        t_ux = ux_test_time(start);
+        compare_gain = t_ux > 0 ? t_byte / t_ux : 0;
+        (void)status;
+
+        printf("%8lu %10.2f %10.2f %10.2f\n", size, copy_gain, set_gain, compare_gain);
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+    /* Results must be the same as byte access.  */
+    UX_TEST_ASSERT(ux_test_verify() == 0);
+
+    /* Print speedup against byte access.  */
+    printf("\n");
+#if defined(UX_MEMORY_COPY) || defined(UX_MEMORY_SET) || defined(UX_MEMORY_COMPARE)
+    printf("port memory copy/set/compare overrides are used\n");
+#endif
+    ux_test_benchmark(0);
+    ux_test_benchmark(1);
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,425 @@
+/* This test is designed to benchmark the fragmentation of the byte pool under hot-plug churn.
+
+   Devices are connected and disconnected at random on a number of ports. On connection,
+   a set of blocks like the one enumeration and class activation allocate is taken from
+   the pool (device, descriptors, interfaces, endpoints, class instance, aligned transfer
+   buffers). On disconnection, all blocks of the device are released.
+
+   After each disconnection the pool is walked to get the largest free block and the
+   number of free blocks, and the report of ux_utility_memory_fragmentation_get is
+   checked against the walk: free blocks are merged on free, so no free block is next
+   to another one. The results are printed in one line, so that runs with different
+   allocator builds (e.g. memory_management_build_coverage and
+   memory_tlsf_build_coverage) can be compared.
+
+   Before the churn, blocks of all sizes are allocated from the pool: their buffers must
+   be aligned, with no fragment left before them, and the report must count all blocks
+   of the pool once the search pointer has moved.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (96*1024)
+
+#define UX_TEST_PORTS           6
+#define UX_TEST_DEVICE_BLOCKS   24
+#define UX_TEST_CYCLES          4000
+#define UX_TEST_ALIGN_BLOCKS    16
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static VOID                            *port_blocks[UX_TEST_PORTS][UX_TEST_DEVICE_BLOCKS];
+static UCHAR                           port_connected[UX_TEST_PORTS];
+static ULONG                           random_seed = 0x1234567;
+static VOID                            *align_blocks[UX_TEST_ALIGN_BLOCKS];
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_fragmentation_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory fragmentation (hot-plug churn) Test....... ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static ULONG ux_test_random(ULONG range)
+{
+    random_seed = random_seed * 1103515245ul + 12345ul;
+    return(((random_seed >> 16) & 0x7FFFul) % range);
+}
+
+/* Walk the pool, adjacent free blocks are counted as one.  */
+static VOID ux_test_pool_walk(UX_MEMORY_BYTE_POOL *pool_ptr, ULONG *largest_free, ULONG *free_blocks, ULONG *blocks)
+{
+UCHAR       *block_ptr;
+UCHAR       *next_ptr;
+ALIGN_TYPE  owner;
+ULONG       free_size = 0;
+
+    block_ptr = pool_ptr -> ux_byte_pool_start;
+#ifdef UX_ENABLE_MEMORY_TLSF
+    block_ptr = (UCHAR *)((((ALIGN_TYPE)block_ptr + UX_MEMORY_BLOCK_HEADER_SIZE + UX_ALIGN_MIN) & ~((ALIGN_TYPE)UX_ALIGN_MIN)) - UX_MEMORY_BLOCK_HEADER_SIZE);
+#endif
+    *largest_free = 0;
+    *free_blocks = 0;
+    *blocks = 0;
+    while (1)
+    {
+        (*blocks) ++;
+        next_ptr = *((UCHAR **)(VOID *)block_ptr);
+        if (next_ptr <= block_ptr)
+            break;
+        owner = *((ALIGN_TYPE *)(VOID *)(block_ptr + sizeof(UCHAR *)));
+        if (owner == UX_BYTE_BLOCK_FREE)
+        {
+            if (free_size == 0)
+                (*free_blocks) ++;
+            free_size += (ULONG)(next_ptr - block_ptr);
+            if (free_size > *largest_free)
+                *largest_free = free_size;
+        }
+        else
+            free_size = 0;
+        block_ptr = next_ptr;
+    }
+}
+
+/* Check the fragmentation report against the pool walk.  */
+static ULONG ux_test_fragmentation_check(ULONG memory_cache_flag, UX_MEMORY_BYTE_POOL *pool_ptr, UX_MEMORY_FRAGMENTATION *fragmentation)
+{
+ULONG       largest_free;
+ULONG       free_blocks;
+ULONG       blocks;
+ULONG       histogram_blocks = 0;
+UINT        bin;
+
+    if (ux_utility_memory_fragmentation_get(memory_cache_flag, fragmentation) != UX_SUCCESS)
+        return(1);
+    ux_test_pool_walk(pool_ptr, &largest_free, &free_blocks, &blocks);
+    for (bin = 0; bin < UX_MEMORY_FRAGMENTATION_BIN_NUM; bin ++)
+        histogram_blocks += fragmentation -> ux_memory_fragmentation_histogram[bin];
+
+    /* No free block is next to another one, headers are not in the report.  */
+    if ((fragmentation -> ux_memory_fragmentation_blocks != blocks) ||
+        (fragmentation -> ux_memory_fragmentation_blocks != pool_ptr -> ux_byte_pool_fragments) ||
+        (fragmentation -> ux_memory_fragmentation_free_blocks != free_blocks) ||
+        (histogram_blocks != free_blocks) ||
+        (fragmentation -> ux_memory_fragmentation_largest + UX_MEMORY_BLOCK_HEADER_SIZE != largest_free) ||
+        (fragmentation -> ux_memory_fragmentation_available + free_blocks * UX_MEMORY_BLOCK_HEADER_SIZE != pool_ptr -> ux_byte_pool_available) ||
+        (fragmentation -> ux_memory_fragmentation_percent > 100))
+    {
+        printf("ERROR #%d: report %lu/%lu/%lu/%lu, walk %lu/%lu/%lu, available %lu\n", __LINE__,
+                fragmentation -> ux_memory_fragmentation_blocks,
+                fragmentation -> ux_memory_fragmentation_free_blocks, fragmentation -> ux_memory_fragmentation_largest,
+                fragmentation -> ux_memory_fragmentation_available, blocks, free_blocks, largest_free,
+                pool_ptr -> ux_byte_pool_available);
+        return(1);
+    }
+    return(0);
+}
+
+static UINT ux_test_device_connect(UINT port)
+{
+UINT        i;
+UINT        n = 0;
+UINT        n_interfaces;
+UINT        n_endpoints;
+ULONG       size;
+
+    /* Device instance and device descriptor.  */
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 640);
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 18);
+
+    /* Configuration descriptor buffer and configuration instance.  */
+    size = 32 + ux_test_random(480);
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, size);
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 96);
+
+    /* Interfaces and endpoints.  */
+    n_interfaces = 1 + ux_test_random(3);
+    for (i = 0; i < n_interfaces; i ++)
+    {
+        port_blocks[port][n++] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 120);
+        n_endpoints = 1 + ux_test_random(3);
+        while (n_endpoints --)
+            port_blocks[port][n++] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 160);
+    }
+
+    /* String descriptors, freed during enumeration in real stack, kept here.  */
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 2 + ux_test_random(254));
+
+    /* Class instance and transfer buffers.  */
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 256 + ux_test_random(1800));
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_ALIGN_64, UX_CACHE_SAFE_MEMORY, 64 + ux_test_random(4032));
+    port_blocks[port][n++] = _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, 512 << ux_test_random(3));
+
+    /* Check results.  */
+    for (i = 0; i < n; i ++)
+    {
+        if (port_blocks[port][i] == UX_NULL)
+            return(1);
+    }
+    return(0);
+}
+
+static VOID ux_test_device_disconnect(UINT port)
+{
+UINT        i;
+
+    /* Free in allocation order, like instances cleanup does.  */
+    for (i = 0; i < UX_TEST_DEVICE_BLOCKS; i ++)
+    {
+        if (port_blocks[port][i] != UX_NULL)
+            _ux_utility_memory_free(port_blocks[port][i]);
+        port_blocks[port][i] = UX_NULL;
+    }
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+ULONG                   available;
+ULONG                   available_min;
+ULONG                   largest_free;
+ULONG                   largest_free_min;
+ULONG                   largest_free_sum;
+ULONG                   free_blocks;
+ULONG                   blocks;
+ULONG                   fragments;
+ULONG                   free_blocks_max;
+ULONG                   free_blocks_sum;
+ULONG                   failures;
+ULONG                   samples;
+ULONG                   cycle;
+ULONG                   percent_max;
+UINT                    port;
+UINT                    bin;
+UINT                    i;
+UX_MEMORY_FRAGMENTATION fragmentation;
+UX_MEMORY_FRAGMENTATION fragmentation_max;
+
+
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    available = pool_ptr -> ux_byte_pool_available;
+    available_min = available;
+    largest_free_min = available;
+    largest_free_sum = 0;
+    free_blocks_max = 0;
+    free_blocks_sum = 0;
+    failures = 0;
+    samples = 0;
+    percent_max = 0;
+
+    /* Buffers are aligned, each block is split from the free block with no fragment before it.  */
+    fragments = pool_ptr -> ux_byte_pool_fragments;
+    for (i = 0; i < UX_TEST_ALIGN_BLOCKS; i ++)
+    {
+        align_blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 1 + i * 5);
+        UX_TEST_ASSERT(align_blocks[i] != UX_NULL);
+        UX_TEST_ASSERT(((ALIGN_TYPE)align_blocks[i] & UX_ALIGN_MIN) == 0);
+    }
+#if !defined(UX_ENABLE_MEMORY_TLSF) && !defined(UX_ENABLE_MEMORY_SLAB)
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == fragments + UX_TEST_ALIGN_BLOCKS);
+    for (i = 1; i < UX_TEST_ALIGN_BLOCKS; i ++)
+        UX_TEST_ASSERT((UCHAR *)align_blocks[i] == (UCHAR *)align_blocks[i - 1] + UX_MEMORY_BLOCK_HEADER_SIZE +
+                       (((1 + (i - 1) * 5) + UX_ALIGN_MIN) & ~((ULONG)UX_ALIGN_MIN)));
+
+    /* The search pointer has moved, all blocks are still reported.  */
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_search != pool_ptr -> ux_byte_pool_start);
+    UX_TEST_ASSERT(ux_test_fragmentation_check(UX_REGULAR_MEMORY, pool_ptr, &fragmentation) == 0);
+    UX_TEST_ASSERT(fragmentation.ux_memory_fragmentation_blocks == fragments + UX_TEST_ALIGN_BLOCKS);
+#endif
+    for (i = 0; i < UX_TEST_ALIGN_BLOCKS; i ++)
+        _ux_utility_memory_free(align_blocks[i]);
+
+    /* Empty slab pages are kept, release them before checking the pool.  */
+    UX_TEST_ASSERT(ux_utility_memory_slab_trim(UX_REGULAR_MEMORY) == UX_SUCCESS);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == fragments);
+
+    /* Allocation failures are counted, not errors.  */
+    error_callback_ignore = UX_TRUE;
+
+    for (cycle = 0; cycle < UX_TEST_CYCLES; cycle ++)
+    {
+        port = (UINT)ux_test_random(UX_TEST_PORTS);
+        if (port_connected[port])
+        {
+
+            ux_test_device_disconnect(port);
+            port_connected[port] = UX_FALSE;
+
+            /* Sample pool state.  */
+            ux_test_pool_walk(pool_ptr, &largest_free, &free_blocks, &blocks);
+            if (largest_free < largest_free_min)
+                largest_free_min = largest_free;
+            if (free_blocks > free_blocks_max)
+                free_blocks_max = free_blocks;
+            largest_free_sum += largest_free;
+            free_blocks_sum += free_blocks;
+            samples ++;
+
+            /* Check the report of both pools.  */
+            UX_TEST_ASSERT(ux_test_fragmentation_check(UX_REGULAR_MEMORY, pool_ptr, &fragmentation) == 0);
+            if (fragmentation.ux_memory_fragmentation_percent >= percent_max)
+            {
+                percent_max = fragmentation.ux_memory_fragmentation_percent;
+                fragmentation_max = fragmentation;
+            }
+            UX_TEST_ASSERT(ux_test_fragmentation_check(UX_CACHE_SAFE_MEMORY,
+                    _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE], &fragmentation) == 0);
+        }
+        else
+        {
+
+            if (ux_test_device_connect(port) != 0)
+            {
+
+                /* Not enough memory, the device is not connected.  */
+                failures ++;
+                ux_test_device_disconnect(port);
+                continue;
+            }
+            port_connected[port] = UX_TRUE;
+            if (pool_ptr -> ux_byte_pool_available < available_min)
+                available_min = pool_ptr -> ux_byte_pool_available;
+        }
+    }
+
+    /* Disconnect all.  */
+    for (port = 0; port < UX_TEST_PORTS; port ++)
+        ux_test_device_disconnect(port);
+    error_callback_ignore = UX_FALSE;
+
+    /* Print results.  */
+    printf("\n");
+#if defined(UX_ENABLE_MEMORY_TLSF)
+    printf("engine: tlsf");
+#else
+    printf("engine: first-fit");
+#endif
+#if defined(UX_ENABLE_MEMORY_SLAB)
+    printf("+slab");
+#endif
+    printf(", pool: %lu, cycles: %lu, failures: %lu, min available: %lu\n",
+            available, (ULONG)UX_TEST_CYCLES, failures, available_min);
+    printf("largest free block: min %lu, avg %lu; free blocks: max %lu, avg %lu\n",
+            largest_free_min, samples ? largest_free_sum / samples : 0,
+            free_blocks_max, samples ? free_blocks_sum / samples : 0);
+    printf("fragmentation: max %lu%%, free blocks by size (from %u bytes):", percent_max, UX_MEMORY_FRAGMENTATION_BIN_SIZE_MIN);
+    for (bin = 0; bin < UX_MEMORY_FRAGMENTATION_BIN_NUM; bin ++)
+        printf(" %lu", fragmentation_max.ux_memory_fragmentation_histogram[bin]);
+    printf("\n");
+
+    /* All memory must be back, once empty slab pages are released.  */
+    UX_TEST_ASSERT(ux_utility_memory_slab_trim(UX_REGULAR_MEMORY) == UX_SUCCESS);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    ux_test_pool_walk(pool_ptr, &largest_free, &free_blocks, &blocks);
+    UX_TEST_ASSERT(free_blocks == 1);
+    UX_TEST_ASSERT(largest_free == available);
+    UX_TEST_ASSERT(ux_test_fragmentation_check(UX_REGULAR_MEMORY, pool_ptr, &fragmentation) == 0);
+    UX_TEST_ASSERT(fragmentation.ux_memory_fragmentation_free_blocks == 1);
+    UX_TEST_ASSERT(fragmentation.ux_memory_fragmentation_percent == 0);
+    UX_TEST_ASSERT(ux_utility_memory_fragmentation_get(3, &fragmentation) == UX_INVALID_PARAMETER);
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,211 @@
+/* This test is designed to test the byte pool mutex and its contention counter.
+
+   The test thread owns the regular pool mutex and resumes a higher priority thread
+   which allocates memory. The allocating thread must wait for the mutex and the
+   contention must be counted once. Allocations without contention must not be counted.
+
+   Before that, the pool mutex gets and puts of the memory functions are logged by the
+   memory allocation log hooks, which check that each put is paired with one get.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+#include "ux_test_utility_sim.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static VOID                            *allocated_memory;
+static ULONG                           allocate_done;
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static TX_THREAD           ux_test_thread_simulation_1;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+static void                ux_test_thread_simulation_1_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_pool_lock_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory pool lock Test............................ ");
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Log the pool mutex gets and puts, from the pool mutex creation.  */
+    ux_test_utility_sim_mem_alloc_log_enable(UX_TRUE);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the allocating thread, started by the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_1, "test allocate", ux_test_thread_simulation_1_entry, 0,
+            stack_pointer + UX_TEST_STACK_SIZE, UX_TEST_STACK_SIZE,
+            10, 10, 1, TX_DONT_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static void  ux_test_thread_simulation_1_entry(ULONG arg)
+{
+
+    /* Allocate while the pool is locked by the simulation thread.  */
+    allocated_memory = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 64);
+    allocate_done = 1;
+}
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+VOID                    *memory;
+UX_MEMORY_FRAGMENTATION fragmentation;
+#ifdef UX_ENABLE_MEMORY_PROFILER
+ULONG                   length;
+#endif
+
+
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    pool_ptr -> ux_byte_pool_mutex_contentions = 0;
+
+    /* No contention on allocate and free from a single thread.  */
+    memory = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 64);
+    UX_TEST_ASSERT(memory != UX_NULL);
+    _ux_utility_memory_free(memory);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_mutex_contentions == 0);
+
+    /* Other functions locking the pool get the mutex the same way, each put is paired.  */
+    UX_TEST_ASSERT(ux_test_memory_is_freed(memory));
+    UX_TEST_ASSERT(ux_utility_memory_fragmentation_get(UX_REGULAR_MEMORY, &fragmentation) == UX_SUCCESS);
+    UX_TEST_ASSERT(ux_utility_memory_slab_trim(UX_REGULAR_MEMORY) == UX_SUCCESS);
+#ifdef UX_ENABLE_MEMORY_PROFILER
+    UX_TEST_ASSERT(ux_utility_memory_profiler_snapshot(UX_NULL, 0, &length) == UX_MEMORY_INSUFFICIENT);
+#endif
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_mutex_contentions == 0);
+
+    /* Nested and contended gets are not paired with puts, stop logging.  */
+    ux_test_utility_sim_mem_alloc_log_enable(UX_FALSE);
+
+    /* No contention on nested get by the owner.  */
+    _ux_utility_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+    _ux_utility_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+    _ux_utility_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+    _ux_utility_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_mutex_contentions == 0);
+
+    /* Own the pool, the allocating thread must wait, its contention is counted before.  */
+    _ux_utility_mutex_on_count(&pool_ptr -> ux_byte_pool_mutex, &pool_ptr -> ux_byte_pool_mutex_contentions);
+    tx_thread_resume(&ux_test_thread_simulation_1);
+    UX_TEST_ASSERT(allocate_done == 0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_mutex_contentions == 1);
+
+    /* Release the pool, the allocating thread is preempting.  */
+    _ux_utility_mutex_off(&pool_ptr -> ux_byte_pool_mutex);
+    UX_TEST_ASSERT(allocate_done == 1);
+    UX_TEST_ASSERT(allocated_memory != UX_NULL);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_mutex_contentions == 1);
+
+    /* Free is not contended.  */
+    _ux_utility_memory_free(allocated_memory);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_mutex_contentions == 1);
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
@@ -0,0 +1,302 @@
+/* This test is designed to test the ux_utility_memory_profiler_....  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (256*1024)
+#define UX_TEST_SNAPSHOT_SIZE   (16*1024)
+#define UX_TEST_ADDRESS         5
+#ifdef UX_ENABLE_MEMORY_PROFILER
+#define UX_TEST_BLOCKS          (UX_MEMORY_PROFILER_BLOCK_NUM + 4)
+#endif
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+static UCHAR                           *blocks[UX_TEST_BLOCKS];
+static UCHAR                           snapshot[UX_TEST_SNAPSHOT_SIZE];
+static UCHAR                           test_owner_name[] = "test";
+#endif
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_profiler_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_profiler Test............................. ");
+
+#ifndef UX_ENABLE_MEMORY_PROFILER
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#ifdef UX_ENABLE_MEMORY_PROFILER
+static UX_MEMORY_PROFILER_BLOCK *ux_test_profiler_block_find(UX_MEMORY_PROFILER *profiler_ptr, VOID *memory)
+{
+ULONG       i;
+
+    for (i = 0; i < UX_MEMORY_PROFILER_BLOCK_NUM; i ++)
+    {
+        if (profiler_ptr -> ux_memory_profiler_blocks[i].ux_memory_profiler_block_memory == memory)
+            return(&profiler_ptr -> ux_memory_profiler_blocks[i]);
+    }
+    return(UX_NULL);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#ifdef UX_ENABLE_MEMORY_PROFILER
+UINT                        status;
+UX_MEMORY_BYTE_POOL         *pool_ptr;
+UX_MEMORY_PROFILER          *profiler_ptr;
+UX_MEMORY_PROFILER_BLOCK    *block_ptr;
+UX_MEMORY_PROFILER_TAG      *tag_ptr;
+UX_MEMORY_PROFILER_OWNER    previous_owner;
+UCHAR                       *record_ptr;
+ULONG                       length;
+ULONG                       actual_length;
+ULONG                       blocks_count;
+ULONG                       bytes;
+ULONG                       max_bytes;
+ULONG                       tags_count;
+UINT                        name_length;
+ALIGN_TYPE                  memory;
+ULONG                       i;
+
+
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    profiler_ptr = pool_ptr -> ux_byte_pool_profiler;
+    UX_TEST_ASSERT(profiler_ptr != UX_NULL);
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_tags_count == 1);
+    blocks_count = profiler_ptr -> ux_memory_profiler_blocks_count;
+    bytes = profiler_ptr -> ux_memory_profiler_bytes;
+
+    /* Allocate with no owner, tag 0 is used.  */
+    blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 100);
+    UX_TEST_ASSERT(blocks[0] != UX_NULL);
+    block_ptr = ux_test_profiler_block_find(profiler_ptr, blocks[0]);
+    UX_TEST_ASSERT(block_ptr != UX_NULL);
+    UX_TEST_ASSERT(block_ptr -> ux_memory_profiler_block_tag == 0);
+    UX_TEST_ASSERT(block_ptr -> ux_memory_profiler_block_size_requested == 100);
+    UX_TEST_ASSERT(block_ptr -> ux_memory_profiler_block_size >= 100 + UX_MEMORY_BLOCK_HEADER_SIZE);
+#if defined(__GNUC__)
+    UX_TEST_ASSERT(block_ptr -> ux_memory_profiler_block_caller != 0);
+#endif
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_blocks_count == blocks_count + 1);
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_bytes == bytes + block_ptr -> ux_memory_profiler_block_size);
+
+    /* Allocate with an owner, a new tag is added.  */
+    _ux_utility_memory_profiler_owner_set(test_owner_name, UX_TEST_ADDRESS, &previous_owner);
+    blocks[1] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 200);
+    blocks[2] = _ux_utility_memory_allocate(UX_ALIGN_64, UX_REGULAR_MEMORY, 300);
+    _ux_utility_memory_profiler_owner_restore(&previous_owner);
+    UX_TEST_ASSERT(blocks[1] != UX_NULL && blocks[2] != UX_NULL);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_profiler_owner.ux_memory_profiler_owner_name == UX_NULL);
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_tags_count == 2);
+    tag_ptr = &profiler_ptr -> ux_memory_profiler_tags[1];
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_name == test_owner_name);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_address == UX_TEST_ADDRESS);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_blocks == 2);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_alloc_count == 2);
+    block_ptr = ux_test_profiler_block_find(profiler_ptr, blocks[2]);
+    UX_TEST_ASSERT(block_ptr != UX_NULL);
+    UX_TEST_ASSERT(block_ptr -> ux_memory_profiler_block_tag == 1);
+
+    /* Allocate after restore, tag 0 is used.  */
+    blocks[3] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 10);
+    UX_TEST_ASSERT(blocks[3] != UX_NULL);
+    block_ptr = ux_test_profiler_block_find(profiler_ptr, blocks[3]);
+    UX_TEST_ASSERT(block_ptr != UX_NULL);
+    UX_TEST_ASSERT(block_ptr -> ux_memory_profiler_block_tag == 0);
+
+    /* Free, bytes drop and peak is kept.  */
+    max_bytes = tag_ptr -> ux_memory_profiler_tag_max_bytes;
+    bytes = tag_ptr -> ux_memory_profiler_tag_bytes;
+    UX_TEST_ASSERT(max_bytes == bytes);
+    _ux_utility_memory_free(blocks[1]);
+    UX_TEST_ASSERT(ux_test_profiler_block_find(profiler_ptr, blocks[1]) == UX_NULL);
+    blocks[1] = UX_NULL;
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_blocks == 1);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_bytes < bytes);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_max_bytes == max_bytes);
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_blocks_count == blocks_count + 3);
+
+    /* Snapshot length only.  */
+    status = _ux_utility_memory_profiler_snapshot(UX_NULL, 0, &length);
+    UX_TEST_ASSERT(status == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(length == UX_MEMORY_PROFILER_SNAPSHOT_HEADER_LENGTH +
+                             UX_MEMORY_PROFILER_SNAPSHOT_POOL_LENGTH +
+                             2 * UX_MEMORY_PROFILER_SNAPSHOT_TAG_LENGTH +
+                             (blocks_count + 3) * UX_MEMORY_PROFILER_SNAPSHOT_BLOCK_LENGTH);
+    status = _ux_utility_memory_profiler_snapshot(snapshot, length - 1, &actual_length);
+    UX_TEST_ASSERT(status == UX_MEMORY_INSUFFICIENT);
+    UX_TEST_ASSERT(actual_length == length);
+
+    /* Snapshot.  */
+    status = _ux_utility_memory_profiler_snapshot(snapshot, sizeof(snapshot), &actual_length);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(actual_length == length);
+    UX_TEST_ASSERT(_ux_utility_long_get(snapshot) == UX_MEMORY_PROFILER_SNAPSHOT_MAGIC);
+    UX_TEST_ASSERT(_ux_utility_short_get(snapshot + 4) == UX_MEMORY_PROFILER_SNAPSHOT_VERSION);
+    UX_TEST_ASSERT(_ux_utility_short_get(snapshot + 6) == 1);
+    record_ptr = snapshot + UX_MEMORY_PROFILER_SNAPSHOT_HEADER_LENGTH;
+    UX_TEST_ASSERT(record_ptr[0] == UX_MEMORY_BYTE_POOL_REGULAR);
+    tags_count = _ux_utility_short_get(record_ptr + 2);
+    UX_TEST_ASSERT(tags_count == 2);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 4) == blocks_count + 3);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 8) == pool_ptr -> ux_byte_pool_size);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 20) == profiler_ptr -> ux_memory_profiler_bytes);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 24) == profiler_ptr -> ux_memory_profiler_max_bytes);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 28) == 0);
+    record_ptr += UX_MEMORY_PROFILER_SNAPSHOT_POOL_LENGTH + UX_MEMORY_PROFILER_SNAPSHOT_TAG_LENGTH;
+    UX_TEST_ASSERT(ux_utility_string_length_check(record_ptr, &name_length, UX_MEMORY_PROFILER_TAG_NAME_LENGTH) == UX_SUCCESS);
+    UX_TEST_ASSERT(name_length == sizeof(test_owner_name) - 1);
+    UX_TEST_ASSERT(_ux_utility_memory_compare(record_ptr, test_owner_name, name_length) == UX_SUCCESS);
+    record_ptr += UX_MEMORY_PROFILER_TAG_NAME_LENGTH;
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr) == UX_TEST_ADDRESS);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 4) == 1);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 8) == tag_ptr -> ux_memory_profiler_tag_bytes);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 12) == max_bytes);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 16) == 2);
+    record_ptr += UX_MEMORY_PROFILER_SNAPSHOT_TAG_LENGTH - UX_MEMORY_PROFILER_TAG_NAME_LENGTH;
+    for (i = 0; i < blocks_count + 3; i ++)
+    {
+        memory = _ux_utility_long_get(record_ptr + 20);
+        memory = ((memory << 16) << 16) | _ux_utility_long_get(record_ptr + 16);
+        if (memory == (ALIGN_TYPE)blocks[2])
+            break;
+        record_ptr += UX_MEMORY_PROFILER_SNAPSHOT_BLOCK_LENGTH;
+    }
+    UX_TEST_ASSERT(i < blocks_count + 3);
+    UX_TEST_ASSERT(_ux_utility_short_get(record_ptr) == 1);
+    UX_TEST_ASSERT(_ux_utility_long_get(record_ptr + 4) == 300);
+
+    /* Free all.  */
+    for (i = 0; i < 4; i ++)
+    {
+        if (blocks[i])
+            _ux_utility_memory_free(blocks[i]);
+        blocks[i] = UX_NULL;
+    }
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_blocks_count == blocks_count);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_blocks == 0);
+    UX_TEST_ASSERT(tag_ptr -> ux_memory_profiler_tag_bytes == 0);
+
+    /* Block table overflow, blocks are counted as lost.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 16);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+    }
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_blocks_count == UX_MEMORY_PROFILER_BLOCK_NUM);
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_blocks_lost == UX_TEST_BLOCKS - UX_MEMORY_PROFILER_BLOCK_NUM + blocks_count);
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+        _ux_utility_memory_free(blocks[i]);
+    UX_TEST_ASSERT(profiler_ptr -> ux_memory_profiler_blocks_count == blocks_count);
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
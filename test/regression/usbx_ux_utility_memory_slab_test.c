@@ -0,0 +1,294 @@
+/* This test is designed to test the ux_utility_memory_slab_....  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (256*1024)
+#define UX_TEST_BLOCKS          128
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static UCHAR                           *blocks[UX_TEST_BLOCKS];
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_slab_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_slab Test................................. ");
+
+#ifndef UX_ENABLE_MEMORY_SLAB
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#ifdef UX_ENABLE_MEMORY_SLAB
+static ALIGN_TYPE ux_test_block_owner(UCHAR *memory)
+{
+ALIGN_TYPE *owner_ptr;
+
+    owner_ptr = UX_UCHAR_TO_ALIGN_TYPE_POINTER_CONVERT(memory - UX_MEMORY_BLOCK_HEADER_SIZE + sizeof(UCHAR *));
+    return(*owner_ptr);
+}
+
+static ULONG ux_test_slab_pages_count(UX_MEMORY_SLAB *slab_ptr)
+{
+UX_MEMORY_SLAB_PAGE *page_ptr;
+ULONG               count = 0;
+
+    for (page_ptr = slab_ptr -> ux_memory_slab_pages; page_ptr != UX_NULL; page_ptr = page_ptr -> ux_memory_slab_page_next)
+        count ++;
+    return(count);
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#ifdef UX_ENABLE_MEMORY_SLAB
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+ULONG                   available;
+ULONG                   size;
+ULONG                   fragments;
+ULONG                   i, j;
+UCHAR                   *temp;
+
+
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    available = pool_ptr -> ux_byte_pool_available;
+
+    /* Size classes are setup.  */
+    for (i = 0; i < UX_MEMORY_SLAB_CLASS_NUM; i ++)
+    {
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_pool == pool_ptr);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_object_size == (UX_MEMORY_SLAB_SIZE_MIN << i));
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_page_objects >= 1);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_pages == UX_NULL);
+    }
+
+    /* Small blocks are taken from slabs, cleared and aligned.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        size = (i * 13) % (UX_MEMORY_SLAB_SIZE_MIN << (UX_MEMORY_SLAB_CLASS_NUM - 1)) + 1;
+        blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, size);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+        UX_TEST_ASSERT(((ALIGN_TYPE)blocks[i] & UX_ALIGN_MIN) == 0);
+        UX_TEST_ASSERT(ux_test_block_owner(blocks[i]) == UX_BYTE_BLOCK_SLAB);
+        for (j = 0; j < size; j ++)
+            UX_TEST_ASSERT(blocks[i][j] == 0);
+        _ux_utility_memory_set(blocks[i], 0x5A, size);
+    }
+
+    /* Free in mixed order, only the kept empty pages are not returned to the pool.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i += 2)
+        _ux_utility_memory_free(blocks[i]);
+    for (i = 1; i < UX_TEST_BLOCKS; i += 2)
+        _ux_utility_memory_free(blocks[UX_TEST_BLOCKS - i]);
+    for (i = 0; i < UX_MEMORY_SLAB_CLASS_NUM; i ++)
+    {
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_pages_empty <= UX_MEMORY_SLAB_EMPTY_PAGES_MAX);
+        UX_TEST_ASSERT(ux_test_slab_pages_count(&pool_ptr -> ux_byte_pool_slab[i]) ==
+                       pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_pages_empty);
+    }
+
+    /* Trim returns all pages to the pool.  */
+    UX_TEST_ASSERT(ux_utility_memory_slab_trim(3) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(ux_utility_memory_slab_trim(UX_REGULAR_MEMORY) == UX_SUCCESS);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    for (i = 0; i < UX_MEMORY_SLAB_CLASS_NUM; i ++)
+    {
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_pages == UX_NULL);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[i].ux_memory_slab_pages_empty == 0);
+    }
+#ifdef UX_ENABLE_MEMORY_STATISTICS
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_alloc_count == 0);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_alloc_total == 0);
+#endif
+
+    /* Freed objects are reused before new pages are carved.  */
+    blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+    blocks[1] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+    UX_TEST_ASSERT(blocks[0] != UX_NULL && blocks[1] != UX_NULL);
+    temp = blocks[1];
+    _ux_utility_memory_free(blocks[1]);
+    blocks[1] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 30);
+    UX_TEST_ASSERT(blocks[1] == temp);
+
+    /* Large and aligned blocks are taken from the byte pool.  */
+    blocks[2] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, (UX_MEMORY_SLAB_SIZE_MIN << (UX_MEMORY_SLAB_CLASS_NUM - 1)) + 1);
+    UX_TEST_ASSERT(blocks[2] != UX_NULL);
+    UX_TEST_ASSERT(ux_test_block_owner(blocks[2]) == (ALIGN_TYPE)pool_ptr);
+    blocks[3] = _ux_utility_memory_allocate(UX_ALIGN_64, UX_REGULAR_MEMORY, 20);
+    UX_TEST_ASSERT(blocks[3] != UX_NULL);
+    UX_TEST_ASSERT(((ALIGN_TYPE)blocks[3] & UX_ALIGN_64) == 0);
+    UX_TEST_ASSERT(ux_test_block_owner(blocks[3]) == (ALIGN_TYPE)pool_ptr);
+    for (i = 0; i < 4; i ++)
+        _ux_utility_memory_free(blocks[i]);
+    ux_utility_memory_slab_trim(UX_REGULAR_MEMORY);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Allocate/free ping-pong on an empty class does not touch the byte pool after the first page.  */
+    temp = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+    UX_TEST_ASSERT(temp != UX_NULL);
+    _ux_utility_memory_free(temp);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages_empty == 1);
+    size = pool_ptr -> ux_byte_pool_available;
+    fragments = pool_ptr -> ux_byte_pool_fragments;
+    for (i = 0; i < 100; i ++)
+    {
+        blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+        UX_TEST_ASSERT(blocks[0] == temp);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages_empty == 0);
+        _ux_utility_memory_free(blocks[0]);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == size);
+        UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == fragments);
+    }
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages_empty == 1);
+
+    /* Empty pages beyond the kept ones are released.  */
+    j = pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_page_objects * 2;
+    UX_TEST_ASSERT(j <= UX_TEST_BLOCKS);
+    for (i = 0; i < j; i ++)
+    {
+        blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+    }
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages_empty == 0);
+    for (i = 0; i < j; i ++)
+        _ux_utility_memory_free(blocks[i]);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages_empty == UX_MEMORY_SLAB_EMPTY_PAGES_MAX);
+    UX_TEST_ASSERT(ux_test_slab_pages_count(&pool_ptr -> ux_byte_pool_slab[0]) == UX_MEMORY_SLAB_EMPTY_PAGES_MAX);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == size);
+
+    /* Kept empty pages are released when the byte pool is exhausted.  */
+    error_callback_ignore = UX_TRUE;
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        blocks[i] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_MEMORY_SLAB_PAGE_SIZE);
+        if (blocks[i] == UX_NULL)
+            break;
+    }
+    error_callback_ignore = UX_FALSE;
+    UX_TEST_ASSERT(i < UX_TEST_BLOCKS);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages == UX_NULL);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_slab[0].ux_memory_slab_pages_empty == 0);
+    while (i > 0)
+        _ux_utility_memory_free(blocks[-- i]);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+
+    /* Double free of slab object is trapped.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 20);
+    UX_TEST_ASSERT(blocks[0] != UX_NULL);
+    _ux_utility_memory_free(blocks[0]);
+    _ux_utility_memory_free(blocks[0]);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    ux_utility_memory_slab_trim(UX_REGULAR_MEMORY);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    error_callback_ignore = UX_FALSE;
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
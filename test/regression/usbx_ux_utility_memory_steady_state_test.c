@@ -0,0 +1,224 @@
+/* This test is designed to test the ux_utility_memory_steady_state_....  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (64*1024)
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+static UINT                            error_callback_context;
+static UINT                            error_callback_code;
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+    error_callback_context = system_context;
+    error_callback_code = error_code;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_steady_state_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_steady_state Test......................... ");
+
+#ifndef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#ifdef UX_ENABLE_MEMORY_STEADY_STATE_CHECK
+UCHAR                       *block_0;
+UCHAR                       *block_1;
+
+
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == 0);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_allocations == 0);
+
+    /* Allocate out of steady state, nothing is reported.  */
+    block_0 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 64);
+    UX_TEST_ASSERT(block_0 != UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 0);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_allocations == 0);
+
+    /* Allocate in steady state, memory is still served but reported.  */
+    ux_utility_memory_steady_state_enter(UX_MEMORY_STEADY_STATE_APPLICATION);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == UX_MEMORY_STEADY_STATE_APPLICATION);
+    error_callback_ignore = UX_TRUE;
+    block_1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 32);
+    error_callback_ignore = UX_FALSE;
+    UX_TEST_ASSERT(block_1 != UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+    UX_TEST_ASSERT(error_callback_context == UX_SYSTEM_CONTEXT_UTILITY);
+    UX_TEST_ASSERT(error_callback_code == UX_MEMORY_STEADY_STATE_ALLOCATION);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_allocations == 1);
+#if defined(__GNUC__)
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_caller != 0);
+#endif
+
+    /* Free in steady state, nothing is reported.  */
+    _ux_utility_memory_free(block_1);
+    UX_TEST_ASSERT(error_callback_counter == 1);
+
+    /* Steady state is kept until all owners exit.  */
+    ux_utility_memory_steady_state_enter(UX_MEMORY_STEADY_STATE_DEVICE);
+    ux_utility_memory_steady_state_exit(UX_MEMORY_STEADY_STATE_APPLICATION);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == UX_MEMORY_STEADY_STATE_DEVICE);
+    error_callback_ignore = UX_TRUE;
+    block_1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY, 32);
+    error_callback_ignore = UX_FALSE;
+    UX_TEST_ASSERT(block_1 != UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 2);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_allocations == 2);
+    _ux_utility_memory_free(block_1);
+
+    /* Allocate after exit, nothing is reported.  */
+    ux_utility_memory_steady_state_exit(UX_MEMORY_STEADY_STATE_DEVICE);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == 0);
+    block_1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 32);
+    UX_TEST_ASSERT(block_1 != UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 2);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_allocations == 2);
+    _ux_utility_memory_free(block_1);
+
+    /* Allocate while a class holds steady state off, nothing is reported.  */
+    ux_utility_memory_steady_state_enter(UX_MEMORY_STEADY_STATE_HOST);
+    ux_utility_memory_steady_state_hold();
+    ux_utility_memory_steady_state_hold();
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == 0);
+    block_1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 32);
+    UX_TEST_ASSERT(block_1 != UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 2);
+    _ux_utility_memory_free(block_1);
+
+    /* Enter while held is pending, steady state is back on the last release.  */
+    ux_utility_memory_steady_state_enter(UX_MEMORY_STEADY_STATE_DEVICE);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == 0);
+    ux_utility_memory_steady_state_release();
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == 0);
+    ux_utility_memory_steady_state_release();
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state ==
+                            (UX_MEMORY_STEADY_STATE_HOST | UX_MEMORY_STEADY_STATE_DEVICE));
+    error_callback_ignore = UX_TRUE;
+    block_1 = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 32);
+    error_callback_ignore = UX_FALSE;
+    UX_TEST_ASSERT(block_1 != UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 3);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_allocations == 3);
+    _ux_utility_memory_free(block_1);
+
+    /* Exit while held drops the pending owner, release does not enter it.  */
+    ux_utility_memory_steady_state_hold();
+    ux_utility_memory_steady_state_exit(UX_MEMORY_STEADY_STATE_HOST);
+    ux_utility_memory_steady_state_release();
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == UX_MEMORY_STEADY_STATE_DEVICE);
+    ux_utility_memory_steady_state_exit(UX_MEMORY_STEADY_STATE_DEVICE);
+
+    /* Unbalanced release is ignored.  */
+    ux_utility_memory_steady_state_release();
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state == 0);
+    UX_TEST_ASSERT(_ux_system -> ux_system_memory_steady_state_holds == 0);
+
+    _ux_utility_memory_free(block_0);
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
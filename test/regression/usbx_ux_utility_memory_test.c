@@ -400,6 +400,10 @@ const ULONG                      aligns[] = {
             ux_test_utility_sim_mem_free_all_flagged(UX_REGULAR_MEMORY);
             ux_test_utility_sim_mem_free_all_flagged(UX_CACHE_SAFE_MEMORY);
 
+            /* Release empty slab pages kept in pools. */
+            ux_utility_memory_slab_trim(UX_REGULAR_MEMORY);
+            ux_utility_memory_slab_trim(UX_CACHE_SAFE_MEMORY);
+
             rpool_free[1] = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available;
             cpool_free[1] = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] -> ux_byte_pool_available;
 
@@ -464,6 +468,10 @@ const ULONG                      aligns[] = {
                     }
 
                     ux_utility_memory_free(ptr);
+
+                    /* Release empty slab pages kept in pools. */
+                    ux_utility_memory_slab_trim(UX_REGULAR_MEMORY);
+                    ux_utility_memory_slab_trim(UX_CACHE_SAFE_MEMORY);
                 }
 
                 /* Save pool level. */
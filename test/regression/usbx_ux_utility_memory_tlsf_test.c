@@ -0,0 +1,224 @@
+/* This test is designed to test the ux_utility_memory_tlsf_....  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_test.h"
+
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE      4096
+#define UX_TEST_MEMORY_SIZE     (512*1024)
+#define UX_TEST_BLOCKS          128
+
+
+/* Define the counters used in the test application...  */
+
+static ULONG                           error_counter;
+
+static UCHAR                           error_callback_ignore = UX_FALSE;
+static ULONG                           error_callback_counter;
+
+
+/* Define USBX test global variables.  */
+
+static UCHAR                           *blocks[UX_TEST_BLOCKS];
+
+
+/* Define prototypes.  */
+
+static TX_THREAD           ux_test_thread_simulation_0;
+static void                ux_test_thread_simulation_0_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    error_callback_counter ++;
+
+    if (!error_callback_ignore)
+    {
+        {
+            /* Failed test.  */
+            printf("Error #%d, system_level: %d, system_context: %d, error_code: 0x%x\n", __LINE__, system_level, system_context, error_code);
+            test_control_return(1);
+        }
+    }
+}
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_ux_utility_memory_tlsf_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+
+    /* Inform user.  */
+    printf("Running ux_utility_memory_tlsf Test................................. ");
+
+#ifndef UX_ENABLE_MEMORY_TLSF
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_TEST_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_TEST_MEMORY_SIZE, UX_NULL, 0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* Create the simulation thread.  */
+    status =  tx_thread_create(&ux_test_thread_simulation_0, "test simulation", ux_test_thread_simulation_0_entry, 0,
+            stack_pointer, UX_TEST_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#ifdef UX_ENABLE_MEMORY_TLSF
+static ULONG ux_test_block_size(UCHAR *memory)
+{
+UCHAR       *block_ptr = memory - UX_MEMORY_BLOCK_HEADER_SIZE;
+
+    return((ULONG)(UX_MEMORY_TLSF_BLOCK_NEXT(block_ptr) - block_ptr));
+}
+#endif
+
+static void  ux_test_thread_simulation_0_entry(ULONG arg)
+{
+#ifdef UX_ENABLE_MEMORY_TLSF
+UX_MEMORY_BYTE_POOL     *pool_ptr;
+ULONG                   available;
+ULONG                   size;
+ULONG                   size_requested;
+ULONG                   alignment;
+UINT                    fl, sl, fl_last, sl_last;
+ULONG                   i;
+
+
+    pool_ptr = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    available = pool_ptr -> ux_byte_pool_available;
+
+    /* Bit scan.  */
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(1) == 0);
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(0x80) == 7);
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(0x12345) == 16);
+    UX_TEST_ASSERT(_ux_utility_memory_tlsf_fls(0x80000000u) == 31);
+
+    /* Size classes are ordered.  */
+    fl_last = 0;
+    sl_last = 0;
+    for (size = UX_MEMORY_TLSF_BLOCK_SIZE_MIN; size < (1ul << UX_MEMORY_TLSF_FL_INDEX_MAX); size += (size >> 4) + UX_ALIGN_MIN + 1)
+    {
+        _ux_utility_memory_tlsf_mapping(size, &fl, &sl);
+        UX_TEST_ASSERT(fl < UX_MEMORY_TLSF_FL_INDEX_COUNT);
+        UX_TEST_ASSERT(sl < UX_MEMORY_TLSF_SL_INDEX_COUNT);
+        UX_TEST_ASSERT((fl > fl_last) || (fl == fl_last && sl >= sl_last));
+        fl_last = fl;
+        sl_last = sl;
+    }
+
+    /* Initially there is one free block.  */
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == 2);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_tlsf_fl_bitmap != 0);
+
+    /* Allocate blocks of different sizes and alignments.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i ++)
+    {
+        alignment = (i & 3) == 0 ? UX_ALIGN_512 : (i & 3) == 1 ? UX_ALIGN_64 : UX_NO_ALIGN;
+        size_requested = 1 + (i * 37) % 700;
+#ifdef UX_ENABLE_MEMORY_SLAB
+
+        /* Keep blocks out of slabs.  */
+        size_requested += UX_MEMORY_SLAB_SIZE_MIN << (UX_MEMORY_SLAB_CLASS_NUM - 1);
+#endif
+        size = pool_ptr -> ux_byte_pool_available;
+        blocks[i] = _ux_utility_memory_allocate(alignment, UX_REGULAR_MEMORY, size_requested);
+        UX_TEST_ASSERT(blocks[i] != UX_NULL);
+        UX_TEST_ASSERT(((ALIGN_TYPE)blocks[i] & (alignment | UX_ALIGN_MIN)) == 0);
+
+        /* No padding lost: the space before aligned block is still available.  */
+        UX_TEST_ASSERT(size - pool_ptr -> ux_byte_pool_available == ux_test_block_size(blocks[i]));
+        UX_TEST_ASSERT(ux_test_block_size(blocks[i]) < size_requested + UX_MEMORY_BLOCK_HEADER_SIZE + UX_MEMORY_TLSF_BLOCK_SIZE_MIN);
+    }
+
+    /* Free every other block, then the others, free blocks are merged.  */
+    for (i = 0; i < UX_TEST_BLOCKS; i += 2)
+        _ux_utility_memory_free(blocks[i]);
+    for (i = 1; i < UX_TEST_BLOCKS; i += 2)
+        _ux_utility_memory_free(blocks[i]);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == 2);
+
+    /* Merged space can be allocated in one block (requests are rounded up to
+       the size class, so the whole pool is not used here).  */
+    blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, available / 2);
+    UX_TEST_ASSERT(blocks[0] != UX_NULL);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == 3);
+    _ux_utility_memory_free(blocks[0]);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_fragments == 2);
+
+    /* Too large requests fail.  */
+    error_callback_ignore = UX_TRUE;
+    error_callback_counter = 0;
+    blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, available);
+    UX_TEST_ASSERT(blocks[0] == UX_NULL);
+    blocks[0] = _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, 0xFFFFFFF0u);
+    UX_TEST_ASSERT(blocks[0] == UX_NULL);
+    UX_TEST_ASSERT(error_callback_counter == 2);
+    error_callback_ignore = UX_FALSE;
+    UX_TEST_ASSERT(pool_ptr -> ux_byte_pool_available == available);
+#endif
+
+    /* Check for errors.  */
+    if (error_counter)
+    {
+
+        /* Test error.  */
+        printf("ERROR #%d: total %ld errors\n", __LINE__, error_counter);
+        test_control_return(1);
+    }
+    else
+    {
+
+        /* Successful test.  */
+        printf("SUCCESS!\n");
+        test_control_return(0);
+    }
+}
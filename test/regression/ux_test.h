@@ -382,10 +382,16 @@ typedef struct UX_TEST_GENERIC_CD
     VOID *parameter;
 } UX_TEST_GENERIC_CD;
 
-typedef struct UX_MEMORY_BLOCK_STRUCT
+/* Block header fields, the size is the one of the header rounded up to alignment.  */
+typedef union UX_MEMORY_BLOCK_STRUCT
 {
-    struct UX_MEMORY_BLOCK_STRUCT *ux_memory_block_next;
-    UX_MEMORY_BYTE_POOL           *ux_memory_byte_pool;
+    struct
+    {
+        union UX_MEMORY_BLOCK_STRUCT  *ux_memory_block_next;
+        UX_MEMORY_BYTE_POOL           *ux_memory_byte_pool;
+        union UX_MEMORY_BLOCK_STRUCT  *ux_memory_block_previous;
+    };
+    UCHAR                         ux_memory_block_header[UX_MEMORY_BLOCK_HEADER_SIZE];
 } UX_MEMORY_BLOCK;
 
 UINT ux_test_list_action_compare(UX_TEST_ACTION *list_item, UX_TEST_ACTION *action);
@@ -523,7 +529,8 @@ UCHAR               *temp_ptr;
 ALIGN_TYPE          *free_ptr;
 int                 is_free = 0;
     UX_TEST_ASSERT(memory);
-    _ux_system_mutex_on(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_on_count(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex,
+                              &_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex_contentions);
     work_ptr =  UX_VOID_TO_UCHAR_POINTER_CONVERT(memory);
     {
         work_ptr =  UX_UCHAR_POINTER_SUB(work_ptr, UX_MEMORY_BLOCK_HEADER_SIZE);
@@ -532,7 +539,7 @@ int                 is_free = 0;
         if ((*free_ptr) == UX_BYTE_BLOCK_FREE)
             is_free = 1;
     }
-    _ux_system_mutex_off(&_ux_system -> ux_system_mutex);
+    _ux_system_mutex_off(&_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_mutex);
     return(is_free);
 }
 #define ux_test_regular_memory_free() _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available
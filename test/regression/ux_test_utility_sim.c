@@ -81,7 +81,7 @@ static void ux_system_mutex_put_callback(UX_TEST_ACTION *action, VOID *params);
 static UX_TEST_ACTION ux_system_mutex_hooks[4] = {
     {
         .usbx_function = UX_TEST_OVERRIDE_TX_MUTEX_CREATE,
-        .name_ptr = "ux_system_mutex",
+        .name_ptr = "ux_byte_pool_regular_mutex",
         .mutex_ptr = UX_NULL, /* Don't care. */
         .inherit = TX_NO_INHERIT,
         .do_after = UX_TRUE,
@@ -90,7 +90,7 @@ static UX_TEST_ACTION ux_system_mutex_hooks[4] = {
     {
         .usbx_function = UX_TEST_OVERRIDE_TX_MUTEX_GET,
         .mutex_ptr = UX_NULL, /* Replaced on creation callback. */
-        .wait_option = TX_WAIT_FOREVER,
+        .wait_option = TX_NO_WAIT, /* All pool mutex gets try first, see _ux_utility_mutex_on_count, the wait after contention is not counted. */
         .do_after = UX_FALSE,
         .action_func = ux_system_mutex_get_callback,
     },
@@ -199,6 +199,9 @@ UX_MEMORY_BYTE_POOL *pool_ptr;
     /* Since we're going to generate at least one error, we need to ignore it. */
     ux_test_ignore_all_errors();
 
+    /* Empty slab pages kept in the pool are released, so that they are allocated too. */
+    ux_utility_memory_slab_trim(memory_cache_flag);
+
     /* Adjust level if invalid. */
     if (target_fail_level == 0)
         target_fail_level++;
@@ -0,0 +1,198 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+/* This is a host tool to format a USBX debug log dump, the content of the
+   buffer filled by ux_utility_debug_log_dump when UX_ENABLE_DEBUG_LOG is
+   defined.
+
+   Build:
+     gcc -O2 -o ux_debug_log_decode ux_debug_log_decode.c
+
+   Usage:
+     ux_debug_log_decode [-r] dump.bin
+
+   Each record is printed as the former text log of USBX: time, location,
+   message, code and parameters in hexadecimal. The time is in seconds from
+   the first record, with -r the raw timestamp is printed instead. Records
+   that were overwritten before the dump are reported as lost.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Dump format, see UX_DEBUG_LOG_DUMP_* in ux_api.h.  */
+
+#define DUMP_MAGIC                      0x4C445855UL
+#define DUMP_VERSION                    1
+#define DUMP_HEADER_LENGTH              32
+#define DUMP_RECORD_LENGTH              24
+#define DUMP_STRING_NONE                0xFFFF
+
+
+typedef struct STRING_STRUCT
+{
+    const unsigned char *text;
+    unsigned            length;
+} STRING;
+
+
+static unsigned short get16(const unsigned char *p)
+{
+    return (unsigned short)(p[0] | (p[1] << 8));
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) |
+           ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+static void string_print(const STRING *strings, unsigned strings_count, unsigned id)
+{
+    if (id == DUMP_STRING_NONE)
+        printf("(null)");
+    else if (id >= strings_count)
+        printf("(invalid string %u)", id);
+    else
+        printf("%.*s", (int)strings[id].length, (const char *)strings[id].text);
+}
+
+int main(int argc, char **argv)
+{
+FILE                *file;
+unsigned char       *data;
+const unsigned char *p;
+size_t              length;
+size_t              offset;
+long                file_length;
+unsigned            header_length;
+unsigned            record_length;
+unsigned            strings_count;
+unsigned long       frequency;
+unsigned long       records_count;
+unsigned long       lost;
+unsigned long       timestamp;
+unsigned long long  time = 0;
+unsigned long       previous = 0;
+unsigned long       i;
+STRING              *strings;
+int                 raw = 0;
+int                 arg = 1;
+
+    if (arg < argc && strcmp(argv[arg], "-r") == 0)
+    {
+        raw = 1;
+        arg ++;
+    }
+    if (arg != argc - 1)
+    {
+        fprintf(stderr, "usage: %s [-r] dump.bin\n", argv[0]);
+        return 2;
+    }
+
+    file = fopen(argv[arg], "rb");
+    if (file == NULL)
+    {
+        perror(argv[arg]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    file_length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_length < DUMP_HEADER_LENGTH)
+    {
+        fprintf(stderr, "%s: not a debug log dump\n", argv[arg]);
+        fclose(file);
+        return 1;
+    }
+    length = (size_t)file_length;
+    data = malloc(length);
+    if (data == NULL || fread(data, 1, length, file) != length)
+    {
+        fprintf(stderr, "%s: read error\n", argv[arg]);
+        fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    header_length = get16(data + 6);
+    record_length = get16(data + 8);
+    if (get32(data) != DUMP_MAGIC || get16(data + 4) != DUMP_VERSION ||
+        header_length < DUMP_HEADER_LENGTH || record_length < DUMP_RECORD_LENGTH)
+    {
+        fprintf(stderr, "%s: not a debug log dump version %u\n", argv[arg], DUMP_VERSION);
+        free(data);
+        return 1;
+    }
+    strings_count = get16(data + 10);
+    frequency = get32(data + 12);
+    records_count = get32(data + 20);
+    lost = get32(data + 24);
+    offset = header_length + records_count * record_length;
+    if (offset + get32(data + 28) > length)
+    {
+        fprintf(stderr, "%s: truncated, %lu records expected\n", argv[arg], records_count);
+        free(data);
+        return 1;
+    }
+
+    /* String table follows the records.  */
+    strings = calloc(strings_count + 1, sizeof(STRING));
+    if (strings == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        free(data);
+        return 1;
+    }
+    for (i = 0; i < strings_count; i ++)
+    {
+        if (offset + 2 > length || offset + 2 + get16(data + offset) > length)
+        {
+            fprintf(stderr, "%s: truncated string table\n", argv[arg]);
+            free(strings);
+            free(data);
+            return 1;
+        }
+        strings[i].length = get16(data + offset);
+        strings[i].text = data + offset + 2;
+        offset += 2 + strings[i].length;
+    }
+
+    printf("%lu records per log, timestamp %lu Hz\n", get32(data + 16), frequency);
+    printf("%lu records, %lu lost, %u strings\n\n", records_count, lost, strings_count);
+
+    for (i = 0; i < records_count; i ++)
+    {
+        p = data + header_length + i * record_length;
+        timestamp = get32(p + 4);
+
+        /* Unwrap the 32-bit timestamp.  */
+        if (i > 0)
+            time += (timestamp - previous) & 0xFFFFFFFFUL;
+        previous = timestamp;
+
+        if (i > 0 && get32(p) != get32(p - record_length) + 1)
+            printf("%lu records lost\n", (get32(p) - get32(p - record_length) - 1) & 0xFFFFFFFFUL);
+
+        if (raw)
+            printf("At time : %08lX,", timestamp);
+        else
+            printf("At time : %12.6f,", frequency ? (double)time / frequency : 0.0);
+        string_print(strings, strings_count, get16(p + 8));
+        printf(",");
+        string_print(strings, strings_count, get16(p + 10));
+        printf(",0x%08lX,0x%08lX,0x%08lX.\n", get32(p + 12), get32(p + 16), get32(p + 20));
+    }
+
+    free(strings);
+    free(data);
+    return 0;
+}
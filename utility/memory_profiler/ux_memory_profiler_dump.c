@@ -0,0 +1,344 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+/* This is a host tool to decode a USBX memory profiler snapshot, the content
+   of the buffer filled by ux_utility_memory_profiler_snapshot when
+   UX_ENABLE_MEMORY_PROFILER is defined.
+
+   Build:
+     gcc -O2 -o ux_memory_profiler_dump ux_memory_profiler_dump.c
+
+   Usage:
+     ux_memory_profiler_dump [-b] snapshot.bin
+
+   For each pool, the usage, peak and tags sorted by live bytes are printed,
+   then the live blocks are grouped by tag and caller address. With -b each
+   live block is printed. Caller addresses are the return addresses of
+   _ux_utility_memory_allocate, they can be resolved with the target image:
+     addr2line -f -e firmware.elf 0x080012ab  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Snapshot format, see UX_MEMORY_PROFILER_SNAPSHOT_* in ux_api.h.  */
+
+#define SNAPSHOT_MAGIC                  0x504D5855UL
+#define SNAPSHOT_VERSION                1
+#define SNAPSHOT_HEADER_LENGTH          8
+#define SNAPSHOT_POOL_LENGTH            32
+#define SNAPSHOT_TAG_NAME_LENGTH        32
+#define SNAPSHOT_TAG_LENGTH             (SNAPSHOT_TAG_NAME_LENGTH + 20)
+#define SNAPSHOT_BLOCK_LENGTH           32
+
+
+typedef struct TAG_STRUCT
+{
+    char                name[SNAPSHOT_TAG_NAME_LENGTH];
+    unsigned long       address;
+    unsigned long       blocks;
+    unsigned long       bytes;
+    unsigned long       max_bytes;
+    unsigned long       alloc_count;
+} TAG;
+
+typedef struct BLOCK_STRUCT
+{
+    unsigned            tag;
+    unsigned long       requested;
+    unsigned long       size;
+    unsigned long long  memory;
+    unsigned long long  caller;
+} BLOCK;
+
+typedef struct GROUP_STRUCT
+{
+    unsigned            tag;
+    unsigned long long  caller;
+    unsigned long       blocks;
+    unsigned long       requested;
+    unsigned long       bytes;
+} GROUP;
+
+
+static const char *pool_names[] = { "regular", "cache safe" };
+static TAG        *sort_tags;
+
+
+static unsigned short get16(const unsigned char *p)
+{
+    return (unsigned short)(p[0] | (p[1] << 8));
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) |
+           ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+static unsigned long long get64(const unsigned char *p)
+{
+    return (unsigned long long)get32(p) | ((unsigned long long)get32(p + 4) << 32);
+}
+
+static int tag_compare(const void *a, const void *b)
+{
+const TAG *ta = &sort_tags[*(const unsigned *)a];
+const TAG *tb = &sort_tags[*(const unsigned *)b];
+
+    if (ta -> bytes != tb -> bytes)
+        return (ta -> bytes < tb -> bytes) ? 1 : -1;
+    if (ta -> max_bytes != tb -> max_bytes)
+        return (ta -> max_bytes < tb -> max_bytes) ? 1 : -1;
+    return (*(const unsigned *)a < *(const unsigned *)b) ? -1 : 1;
+}
+
+static int group_compare(const void *a, const void *b)
+{
+const GROUP *ga = (const GROUP *)a;
+const GROUP *gb = (const GROUP *)b;
+
+    if (ga -> bytes != gb -> bytes)
+        return (ga -> bytes < gb -> bytes) ? 1 : -1;
+    if (ga -> tag != gb -> tag)
+        return (ga -> tag < gb -> tag) ? -1 : 1;
+    if (ga -> caller != gb -> caller)
+        return (ga -> caller < gb -> caller) ? -1 : 1;
+    return 0;
+}
+
+static int block_compare(const void *a, const void *b)
+{
+const BLOCK *ba = (const BLOCK *)a;
+const BLOCK *bb = (const BLOCK *)b;
+
+    if (ba -> memory != bb -> memory)
+        return (ba -> memory < bb -> memory) ? -1 : 1;
+    return 0;
+}
+
+static const char *tag_name(const TAG *tags, unsigned tags_count, unsigned tag, char *buffer, size_t length)
+{
+    if (tag == 0)
+        return "(no owner)";
+    if (tag >= tags_count)
+        return "(invalid)";
+    snprintf(buffer, length, "%s@%lu", tags[tag].name, tags[tag].address);
+    return buffer;
+}
+
+static int pool_dump(const unsigned char *data, size_t length, size_t *offset, int all_blocks)
+{
+const unsigned char *p;
+unsigned            pool_index;
+unsigned            tags_count;
+unsigned long       blocks_count;
+unsigned long       pool_size;
+unsigned long       available;
+TAG                 *tags;
+BLOCK               *blocks;
+GROUP               *groups;
+unsigned            *order;
+unsigned long       groups_count;
+unsigned long       i, j;
+char                name[SNAPSHOT_TAG_NAME_LENGTH + 16];
+
+    if (*offset + SNAPSHOT_POOL_LENGTH > length)
+    {
+        fprintf(stderr, "truncated pool header at offset %zu\n", *offset);
+        return -1;
+    }
+    p = data + *offset;
+    pool_index = p[0];
+    tags_count = get16(p + 2);
+    blocks_count = get32(p + 4);
+    pool_size = get32(p + 8);
+    available = get32(p + 12);
+    *offset += SNAPSHOT_POOL_LENGTH;
+    if (*offset + tags_count * SNAPSHOT_TAG_LENGTH + blocks_count * SNAPSHOT_BLOCK_LENGTH > length)
+    {
+        fprintf(stderr, "truncated pool %u records\n", pool_index);
+        return -1;
+    }
+
+    printf("Pool %u (%s)\n", pool_index, pool_index < 2 ? pool_names[pool_index] : "unknown");
+    printf("  size %lu, used %lu, available %lu, fragments %lu\n",
+           pool_size, pool_size - available, available, get32(p + 16));
+    printf("  profiled: live %lu bytes in %lu blocks, peak %lu bytes, blocks not recorded %lu\n",
+           get32(p + 20), blocks_count, get32(p + 24), get32(p + 28));
+
+    tags = calloc(tags_count + 1, sizeof(TAG));
+    order = calloc(tags_count + 1, sizeof(unsigned));
+    blocks = calloc(blocks_count + 1, sizeof(BLOCK));
+    groups = calloc(blocks_count + 1, sizeof(GROUP));
+    if (!tags || !order || !blocks || !groups)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    /* Tags.  */
+    for (i = 0; i < tags_count; i ++)
+    {
+        p = data + *offset;
+        memcpy(tags[i].name, p, SNAPSHOT_TAG_NAME_LENGTH);
+        tags[i].name[SNAPSHOT_TAG_NAME_LENGTH - 1] = 0;
+        p += SNAPSHOT_TAG_NAME_LENGTH;
+        tags[i].address = get32(p);
+        tags[i].blocks = get32(p + 4);
+        tags[i].bytes = get32(p + 8);
+        tags[i].max_bytes = get32(p + 12);
+        tags[i].alloc_count = get32(p + 16);
+        order[i] = (unsigned)i;
+        *offset += SNAPSHOT_TAG_LENGTH;
+    }
+
+    /* Blocks.  */
+    for (i = 0; i < blocks_count; i ++)
+    {
+        p = data + *offset;
+        blocks[i].tag = get16(p);
+        blocks[i].requested = get32(p + 4);
+        blocks[i].size = get32(p + 8);
+        blocks[i].memory = get64(p + 16);
+        blocks[i].caller = get64(p + 24);
+        *offset += SNAPSHOT_BLOCK_LENGTH;
+    }
+
+    /* Tags sorted by live bytes.  */
+    sort_tags = tags;
+    qsort(order, tags_count, sizeof(unsigned), tag_compare);
+    printf("\n  %-40s %8s %10s %10s %10s\n", "tag", "blocks", "bytes", "peak", "allocs");
+    for (i = 0; i < tags_count; i ++)
+    {
+        j = order[i];
+        printf("  %-40s %8lu %10lu %10lu %10lu\n",
+               tag_name(tags, tags_count, (unsigned)j, name, sizeof(name)),
+               tags[j].blocks, tags[j].bytes, tags[j].max_bytes, tags[j].alloc_count);
+    }
+
+    /* Live blocks grouped by tag and caller.  */
+    groups_count = 0;
+    for (i = 0; i < blocks_count; i ++)
+    {
+        for (j = 0; j < groups_count; j ++)
+        {
+            if (groups[j].tag == blocks[i].tag && groups[j].caller == blocks[i].caller)
+                break;
+        }
+        if (j == groups_count)
+        {
+            groups[j].tag = blocks[i].tag;
+            groups[j].caller = blocks[i].caller;
+            groups_count ++;
+        }
+        groups[j].blocks ++;
+        groups[j].requested += blocks[i].requested;
+        groups[j].bytes += blocks[i].size;
+    }
+    qsort(groups, groups_count, sizeof(GROUP), group_compare);
+    printf("\n  %-40s %18s %8s %10s %10s\n", "tag", "caller", "blocks", "requested", "bytes");
+    for (i = 0; i < groups_count; i ++)
+    {
+        printf("  %-40s 0x%016llx %8lu %10lu %10lu\n",
+               tag_name(tags, tags_count, groups[i].tag, name, sizeof(name)),
+               groups[i].caller, groups[i].blocks, groups[i].requested, groups[i].bytes);
+    }
+
+    /* All live blocks by address.  */
+    if (all_blocks)
+    {
+        qsort(blocks, blocks_count, sizeof(BLOCK), block_compare);
+        printf("\n  %-18s %10s %10s %-18s %s\n", "memory", "requested", "bytes", "caller", "tag");
+        for (i = 0; i < blocks_count; i ++)
+        {
+            printf("  0x%016llx %10lu %10lu 0x%016llx %s\n",
+                   blocks[i].memory, blocks[i].requested, blocks[i].size, blocks[i].caller,
+                   tag_name(tags, tags_count, blocks[i].tag, name, sizeof(name)));
+        }
+    }
+    printf("\n");
+
+    free(groups);
+    free(blocks);
+    free(order);
+    free(tags);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+FILE                *file;
+unsigned char       *data;
+size_t              length;
+size_t              offset;
+long                file_length;
+unsigned            pools;
+unsigned            i;
+int                 all_blocks = 0;
+int                 arg = 1;
+
+    if (arg < argc && strcmp(argv[arg], "-b") == 0)
+    {
+        all_blocks = 1;
+        arg ++;
+    }
+    if (arg != argc - 1)
+    {
+        fprintf(stderr, "usage: %s [-b] snapshot.bin\n", argv[0]);
+        return 2;
+    }
+
+    file = fopen(argv[arg], "rb");
+    if (file == NULL)
+    {
+        perror(argv[arg]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    file_length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_length < SNAPSHOT_HEADER_LENGTH)
+    {
+        fprintf(stderr, "%s: not a memory profiler snapshot\n", argv[arg]);
+        fclose(file);
+        return 1;
+    }
+    length = (size_t)file_length;
+    data = malloc(length);
+    if (data == NULL || fread(data, 1, length, file) != length)
+    {
+        fprintf(stderr, "%s: read error\n", argv[arg]);
+        fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    if (get32(data) != SNAPSHOT_MAGIC || get16(data + 4) != SNAPSHOT_VERSION)
+    {
+        fprintf(stderr, "%s: not a memory profiler snapshot version %u\n", argv[arg], SNAPSHOT_VERSION);
+        free(data);
+        return 1;
+    }
+    pools = get16(data + 6);
+    offset = SNAPSHOT_HEADER_LENGTH;
+    for (i = 0; i < pools; i ++)
+    {
+        if (pool_dump(data, length, &offset, all_blocks) != 0)
+        {
+            free(data);
+            return 1;
+        }
+    }
+
+    free(data);
+    return 0;
+}
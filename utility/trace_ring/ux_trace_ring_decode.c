@@ -0,0 +1,275 @@
+/***************************************************************************
+ * Copyright (c) 2024 Microsoft Corporation
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the MIT License which is available at
+ * https://opensource.org/licenses/MIT.
+ *
+ * SPDX-License-Identifier: MIT
+ **************************************************************************/
+
+/* This is a host tool to decode a USBX trace ring dump, the content of the
+   buffer filled by ux_trace_ring_dump when UX_ENABLE_TRACE_RING is defined.
+
+   Build:
+     gcc -O2 -o ux_trace_ring_decode ux_trace_ring_decode.c
+
+   Usage:
+     ux_trace_ring_decode [-r] dump.bin
+
+   Entries of all cores are ordered by time, the 32-bit timestamps are
+   unwrapped per core. Each line shows the time from the first entry in
+   microseconds, the core, the sequence number, the event and its
+   information. With -r raw timestamps are printed instead. Entries that
+   were overwritten before the dump are reported as lost.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Dump format, see UX_TRACE_RING_DUMP_* in ux_api.h.  */
+
+#define DUMP_MAGIC                      0x52545855UL
+#define DUMP_VERSION                    1
+#define DUMP_HEADER_LENGTH              32
+#define DUMP_ENTRY_LENGTH               24
+
+
+typedef struct ENTRY_STRUCT
+{
+    unsigned long       sequence;
+    unsigned long       timestamp;
+    unsigned long long  time;
+    unsigned            event;
+    unsigned            core;
+    unsigned long       info[3];
+} ENTRY;
+
+typedef struct EVENT_NAME_STRUCT
+{
+    unsigned            event;
+    const char          *name;
+    const char          *format;
+} EVENT_NAME;
+
+
+/* Event names and information, see UX_TRACE_RING_* in ux_api.h.  */
+
+static const EVENT_NAME event_names[] = {
+    { 0x0101, "host_transfer_submit",       "device %lu endpoint 0x%02lx, length %lu" },
+    { 0x0102, "host_transfer_complete",     "device %lu endpoint 0x%02lx, status 0x%lx, length %lu" },
+    { 0x0103, "device_transfer_submit",     "endpoint 0x%02lx, length %lu, host length %lu" },
+    { 0x0104, "device_transfer_complete",   "endpoint 0x%02lx, status 0x%lx, length %lu" },
+    { 0x0201, "host_device_connect",        "parent %lu, port %lu, speed %lu" },
+    { 0x0202, "host_device_address_set",    "address %lu" },
+    { 0x0203, "host_device_descriptor_read","device %lu, VID 0x%04lx, PID 0x%04lx" },
+    { 0x0204, "host_configuration_set",     "device %lu, configuration %lu" },
+    { 0x0205, "host_device_remove",         "device %lu, port %lu" },
+    { 0x0206, "device_address_set",         "address %lu" },
+    { 0x0207, "device_configuration_set",   "configuration %lu" },
+    { 0x0208, "device_disconnect",          "state %lu" },
+    { 0x0401, "host_class_instance_create", "class %lu, instance 0x%08lx" },
+    { 0x0402, "host_class_instance_destroy","class %lu, instance 0x%08lx" },
+    { 0x0403, "device_class_activate",      "interface %lu, class 0x%02lx, status 0x%lx" },
+    { 0x0404, "device_class_deactivate",    "interface %lu, class 0x%02lx" },
+    { 0x0801, "error",                      "level %lu, context %lu, code 0x%lx" },
+};
+
+
+static unsigned short get16(const unsigned char *p)
+{
+    return (unsigned short)(p[0] | (p[1] << 8));
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) |
+           ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+static int entry_compare(const void *a, const void *b)
+{
+const ENTRY *ea = (const ENTRY *)a;
+const ENTRY *eb = (const ENTRY *)b;
+
+    if (ea -> time != eb -> time)
+        return (ea -> time < eb -> time) ? -1 : 1;
+    if (ea -> core != eb -> core)
+        return (ea -> core < eb -> core) ? -1 : 1;
+    if (ea -> sequence != eb -> sequence)
+        return (ea -> sequence < eb -> sequence) ? -1 : 1;
+    return 0;
+}
+
+static int core_compare(const void *a, const void *b)
+{
+const ENTRY *ea = (const ENTRY *)a;
+const ENTRY *eb = (const ENTRY *)b;
+
+    if (ea -> core != eb -> core)
+        return (ea -> core < eb -> core) ? -1 : 1;
+    if (ea -> sequence != eb -> sequence)
+        return (ea -> sequence < eb -> sequence) ? -1 : 1;
+    return 0;
+}
+
+static void entry_print(const ENTRY *entry, unsigned long long start, unsigned long frequency, int raw)
+{
+const EVENT_NAME    *name = NULL;
+unsigned            i;
+char                info[128];
+
+    for (i = 0; i < sizeof(event_names) / sizeof(event_names[0]); i ++)
+    {
+        if (event_names[i].event == entry -> event)
+        {
+            name = &event_names[i];
+            break;
+        }
+    }
+
+    if (name == NULL)
+        snprintf(info, sizeof(info), "0x%08lx 0x%08lx 0x%08lx", entry -> info[0], entry -> info[1], entry -> info[2]);
+
+    /* Host transfer endpoints are packed with the device address.  */
+    else if (entry -> event == 0x0101)
+        snprintf(info, sizeof(info), name -> format, entry -> info[0] >> 8, entry -> info[0] & 0xFF, entry -> info[1]);
+    else if (entry -> event == 0x0102)
+        snprintf(info, sizeof(info), name -> format, entry -> info[0] >> 8, entry -> info[0] & 0xFF,
+                 entry -> info[1], entry -> info[2]);
+    else
+        snprintf(info, sizeof(info), name -> format, entry -> info[0], entry -> info[1], entry -> info[2]);
+
+    if (raw)
+        printf("%10lu", entry -> timestamp);
+    else
+        printf("%14.3f", frequency ? (double)(entry -> time - start) * 1e6 / frequency : 0.0);
+    printf(" %2u %8lu  ", entry -> core, entry -> sequence);
+    if (name != NULL)
+        printf("%-28s %s\n", name -> name, info);
+    else
+        printf("event_0x%04x                 %s\n", entry -> event, info);
+}
+
+int main(int argc, char **argv)
+{
+FILE                *file;
+unsigned char       *data;
+const unsigned char *p;
+size_t              length;
+long                file_length;
+unsigned            cores;
+unsigned long       frequency;
+unsigned long       entries_count;
+unsigned long       lost;
+unsigned long       i;
+unsigned long long  start;
+ENTRY               *entries;
+int                 raw = 0;
+int                 arg = 1;
+
+    if (arg < argc && strcmp(argv[arg], "-r") == 0)
+    {
+        raw = 1;
+        arg ++;
+    }
+    if (arg != argc - 1)
+    {
+        fprintf(stderr, "usage: %s [-r] dump.bin\n", argv[0]);
+        return 2;
+    }
+
+    file = fopen(argv[arg], "rb");
+    if (file == NULL)
+    {
+        perror(argv[arg]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    file_length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_length < DUMP_HEADER_LENGTH)
+    {
+        fprintf(stderr, "%s: not a trace ring dump\n", argv[arg]);
+        fclose(file);
+        return 1;
+    }
+    length = (size_t)file_length;
+    data = malloc(length);
+    if (data == NULL || fread(data, 1, length, file) != length)
+    {
+        fprintf(stderr, "%s: read error\n", argv[arg]);
+        fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    if (get32(data) != DUMP_MAGIC || get16(data + 4) != DUMP_VERSION ||
+        get16(data + 6) < DUMP_HEADER_LENGTH || get16(data + 10) < DUMP_ENTRY_LENGTH)
+    {
+        fprintf(stderr, "%s: not a trace ring dump version %u\n", argv[arg], DUMP_VERSION);
+        free(data);
+        return 1;
+    }
+    cores = get16(data + 8);
+    frequency = get32(data + 12);
+    entries_count = get32(data + 24);
+    lost = get32(data + 28);
+    if (get16(data + 6) + entries_count * get16(data + 10) > length)
+    {
+        fprintf(stderr, "%s: truncated, %lu entries expected\n", argv[arg], entries_count);
+        free(data);
+        return 1;
+    }
+
+    printf("%u core(s), %lu entries per core, filter 0x%02lx, timestamp %lu Hz\n",
+           cores, get32(data + 20), get32(data + 16), frequency);
+    printf("%lu entries, %lu lost\n\n", entries_count, lost);
+
+    entries = calloc(entries_count + 1, sizeof(ENTRY));
+    if (entries == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        free(data);
+        return 1;
+    }
+    for (i = 0; i < entries_count; i ++)
+    {
+        p = data + get16(data + 6) + i * get16(data + 10);
+        entries[i].sequence = get32(p);
+        entries[i].timestamp = get32(p + 4);
+        entries[i].event = get16(p + 8);
+        entries[i].core = p[10];
+        entries[i].info[0] = get32(p + 12);
+        entries[i].info[1] = get32(p + 16);
+        entries[i].info[2] = get32(p + 20);
+    }
+
+    /* Unwrap the timestamps of each core in sequence order.  */
+    qsort(entries, entries_count, sizeof(ENTRY), core_compare);
+    for (i = 0; i < entries_count; i ++)
+    {
+        if (i == 0 || entries[i].core != entries[i - 1].core)
+            entries[i].time = entries[i].timestamp;
+        else
+        {
+            entries[i].time = entries[i - 1].time +
+                              ((entries[i].timestamp - entries[i - 1].timestamp) & 0xFFFFFFFFUL);
+            if (entries[i].sequence != entries[i - 1].sequence + 1)
+                printf("core %u: %lu entries lost before sequence %lu\n", entries[i].core,
+                       entries[i].sequence - entries[i - 1].sequence - 1, entries[i].sequence);
+        }
+    }
+
+    /* Merge the cores by time.  */
+    qsort(entries, entries_count, sizeof(ENTRY), entry_compare);
+    start = entries_count ? entries[0].time : 0;
+    printf("%14s %2s %8s  %-28s %s\n", raw ? "timestamp" : "time (us)", "c", "sequence", "event", "information");
+    for (i = 0; i < entries_count; i ++)
+        entry_print(&entries[i], start, frequency, raw);
+
+    free(entries);
+    free(data);
+    return 0;
+}